@@ -1,14 +1,20 @@
 // __________ BENCHMARK FRAMEWORK & LIBRARY  __________
 
 #include "benchmark.hpp"
+
+// Eigen is only used for comparison, benchmarks still build without it
+#if __has_include("thirdparty/Eigen/Sparse")
+#define BENCHMARK_MVL_HAS_EIGEN
 #include "thirdparty/Eigen/Sparse"
 #include "thirdparty/Eigen/src/Core/Map.h"
 #include "thirdparty/Eigen/src/Core/Matrix.h"
 #include "thirdparty/Eigen/src/SparseCore/SparseMatrix.h"
 #include "thirdparty/Eigen/src/SparseCore/SparseUtil.h"
+#endif
 
 #include <array>
 #include <cstddef>
+#include <fstream>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -408,6 +414,7 @@ void benchmark_matmul() {
     benchmark("dd_matnul_ikj_ii_kk_blocked<32, 32>", [&] { C = dd_matnul_ikj_ii_kk_blocked<32, 32>(A, B); });
     control_sums.emplace_back("dd_matnul_ikj_ii_kk_blocked<32, 32>", C.sum());
 
+#ifdef BENCHMARK_MVL_HAS_EIGEN
     // Copy data into Eigen matrices
     Eigen::MatrixXd A_eigen(N_i, N_k), B_eigen(N_k, N_j), C_eigen;
     A.for_each([&](double elem, std::size_t i, std::size_t j) { A_eigen(i, j) = elem; });
@@ -415,6 +422,7 @@ void benchmark_matmul() {
 
     benchmark("Eigen::Map<>::operator*", [&] { C_eigen = A_eigen * B_eigen; });
     control_sums.emplace_back("Eigen::MatrixXd::operator*", C_eigen.sum());
+#endif
 
     // Print control sums to verify matmul correctness
     table::create({50, 20});
@@ -570,25 +578,415 @@ void benchmark_indexation() {
     DO_NOT_OPTIMIZE_AWAY(sum);
 }
 
+// ================================
+// --- Size-swept suite helpers ---
+// ================================
+
+// Sizes are picked so that the working set of a single N x N matrix of doubles fits into
+// L1 (32 KiB), L2 (~1 MiB) or only into DRAM (128 MiB)
+struct SweepSize {
+    const char* label;
+    std::size_t N;
+};
+
+constexpr std::array<SweepSize, 3> dense_sweep = {
+    SweepSize{"small", 64},
+    SweepSize{"L2", 360},
+    SweepSize{"DRAM", 4096},
+};
+
+// Same idea for sparse matrices with 8 non-zeros per row, here N is the number of rows
+constexpr std::array<SweepSize, 3> sparse_sweep = {
+    SweepSize{"small", 128},
+    SweepSize{"L2", 5'000},
+    SweepSize{"DRAM", 1'000'000},
+};
+
+// nanobench only measures time, bandwidth & arithmetic throughput are derived from
+// the amount of useful work done by a single run of the benchmark
+struct ThroughputRecord {
+    std::string group;
+    std::string name;
+    double      bytes;
+    double      flops;
+    double      seconds;
+};
+
+inline std::vector<ThroughputRecord> throughput_records;
+inline std::string                   throughput_group;
+
+void begin_group(std::string title) {
+    throughput_group = std::move(title);
+    bench.minEpochIterations(1).timeUnit(1us, "us").title(throughput_group).relative(true).warmup(2);
+}
+
+template <class Func>
+void benchmark_throughput(const std::string& name, double bytes, double flops, Func lambda) {
+    benchmark(name.c_str(), lambda);
+
+    const double seconds = bench.results().back().median(ankerl::nanobench::Result::Measure::elapsed);
+    throughput_records.push_back({throughput_group, name, bytes, flops, seconds});
+}
+
+void print_throughput() {
+    table::create({60, 14, 14});
+    table::set_formats({table::DEFAULT(), table::FIXED(2), table::FIXED(2)});
+
+    log::println();
+    table::hline();
+    table::cell("Benchmark", "GB/s", "GFLOP/s");
+    table::hline();
+    for (const auto& record : throughput_records) {
+        if (record.group != throughput_group) continue;
+        const double gbs    = record.bytes / record.seconds * 1e-9;
+        const double gflops = record.flops / record.seconds * 1e-9;
+        if (record.flops > 0) table::cell(record.name, gbs, gflops);
+        else table::cell(record.name, gbs, "-");
+    }
+    table::hline();
+}
+
+// Machine-readable results so regressions can be tracked between runs:
+//    - raw nanobench measurements as JSON
+//    - derived bandwidth & throughput as CSV
+void save_results(const std::string& json_path, const std::string& csv_path) {
+    std::ofstream json_file(json_path);
+    ankerl::nanobench::render(ankerl::nanobench::templates::json(), bench, json_file);
+
+    std::ofstream csv_file(csv_path);
+    csv_file << "group,name,bytes,flops,seconds,GB/s,GFLOP/s\n";
+    for (const auto& record : throughput_records)
+        csv_file << '"' << record.group << "\",\"" << record.name << "\"," << record.bytes << ',' << record.flops
+                 << ',' << record.seconds << ',' << record.bytes / record.seconds * 1e-9 << ','
+                 << record.flops / record.seconds * 1e-9 << '\n';
+
+    log::println("\nResults saved to '", json_path, "' and '", csv_path, "'.");
+}
+
+// ===============================
+// --- Strided view benchmarks ---
+// ===============================
+
+void benchmark_views() {
+    for (const auto& [label, N] : dense_sweep) {
+        DenseMat            A(N, N, [] { return datagen::rand_double(); });
+        std::vector<double> raw(A.begin(), A.end());
+
+        const std::size_t half = N / 2, interior = N - 2;
+
+        begin_group(log::stringify("Strided views (", label, ", ", N, "x", N, ")"));
+
+        double sum = 0;
+
+        benchmark_throughput("raw pointer loop", 8. * N * N, 1. * N * N,
+                             [&] { sum += sum_raw_ptr(raw.data(), raw.size()); });
+
+        benchmark_throughput("Matrix::sum()", 8. * N * N, 1. * N * N, [&] { sum += A.sum(); });
+
+        benchmark_throughput("MatrixView::sum()", 8. * N * N, 1. * N * N, [&] {
+            mvl::ConstMatrixView<double> view(N, N, raw.data());
+            sum += view.sum();
+        });
+
+        benchmark_throughput("block() full size, sum()", 8. * N * N, 1. * N * N,
+                             [&] { sum += A.block(0, 0, N, N).sum(); });
+
+        benchmark_throughput("block() interior, sum()", 8. * interior * interior, 1. * interior * interior,
+                             [&] { sum += A.block(1, 1, interior, interior).sum(); });
+
+        benchmark_throughput("StridedMatrixView every other column, sum()", 8. * N * half, 1. * N * half, [&] {
+            mvl::ConstStridedMatrixView<double> view(N, half, 0, 2, raw.data());
+            sum += view.sum();
+        });
+
+        benchmark_throughput("StridedMatrixView every other column, for_each()", 8. * N * half, 1. * N * half, [&] {
+            mvl::ConstStridedMatrixView<double> view(N, half, 0, 2, raw.data());
+            view.for_each([&](double elem) { sum += elem; });
+        });
+
+        benchmark_throughput("column view, sum()", 8. * N, 1. * N, [&] { sum += A.col(half).sum(); });
+
+#ifdef BENCHMARK_MVL_HAS_EIGEN
+        const Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> A_eigen(
+            raw.data(), N, N);
+
+        benchmark_throughput("Eigen::Map<>::sum()", 8. * N * N, 1. * N * N, [&] { sum += A_eigen.sum(); });
+
+        benchmark_throughput("Eigen::Map<>::block().sum() interior", 8. * interior * interior,
+                             1. * interior * interior, [&] { sum += A_eigen.block(1, 1, interior, interior).sum(); });
+#endif
+
+        DO_NOT_OPTIMIZE_AWAY(sum);
+        print_throughput();
+    }
+}
+
+// ============================================
+// --- Sparse access & insertion benchmarks ---
+// ============================================
+
+// Block-structured pattern typical for discretizations: each 4x4 block row has 2 dense 4x4 blocks
+// in random block columns, which gives 8 non-zeros per row and a pattern that suits all formats
+std::size_t rand_index(std::size_t max) { return random::UniformIntDistribution<std::size_t>{0, max}(datagen::gen); }
+
+std::vector<mvl::SparseEntry2D<double>> make_sparse_triplets(std::size_t N) {
+    constexpr std::size_t block = 4;
+
+    const std::size_t block_count = N / block;
+
+    std::vector<mvl::SparseEntry2D<double>> triplets;
+    triplets.reserve(N * 2 * block);
+
+    for (std::size_t bi = 0; bi < block_count; ++bi) {
+        const std::size_t bj_1 = rand_index(block_count - 1);
+        const std::size_t bj_2 = (bj_1 + 1 + rand_index(block_count - 2)) % block_count;
+
+        for (const std::size_t bj : {bj_1, bj_2})
+            for (std::size_t i = 0; i < block; ++i)
+                for (std::size_t j = 0; j < block; ++j)
+                    triplets.push_back({bi * block + i, bj * block + j, datagen::rand_double()});
+    }
+
+    // Shuffle so that construction has to do the sorting
+    for (std::size_t k = triplets.size(); k > 1; --k) std::swap(triplets[k - 1], triplets[rand_index(k - 1)]);
+
+    return triplets;
+}
+
+void benchmark_sparse() {
+    for (const auto& [label, N] : sparse_sweep) {
+        const auto triplets = make_sparse_triplets(N);
+        const auto nnz      = static_cast<double>(triplets.size());
+
+        const SparseMat                  A(N, N, std::vector(triplets));
+        const mvl::CSRMatrix<double>     A_csr(A);
+        const mvl::BSRMatrix<double, 4> A_bsr(A);
+
+        std::vector<double> x(N), y(N);
+        for (auto& e : x) e = datagen::rand_double();
+
+        // 1% of new entries, duplicates are fine since insertion doesn't check for them
+        std::vector<mvl::SparseEntry2D<double>> inserted(std::max<std::size_t>(triplets.size() / 100, 1));
+        for (auto& e : inserted) e = {rand_index(N - 1), rand_index(N - 1), 1.};
+
+        const double triplet_bytes = sizeof(mvl::SparseEntry2D<double>);
+        const double spmv_bytes    = nnz * (sizeof(double) + sizeof(std::size_t)) + 2. * sizeof(double) * N;
+
+        log::println("\n\n====== BENCHMARKING ON: sparse matrices (", label, ") ======\n");
+        log::println("N                 -> ", N);
+        log::println("Non-zeros         -> ", triplets.size());
+        log::println("Data memory usage -> ", math::memory_size<mvl::SparseEntry2D<double>>(triplets.size()), " MiB");
+
+        // Access
+        begin_group(log::stringify("Sparse access (", label, ", ", N, "x", N, ", nnz = ", triplets.size(), ")"));
+
+        double sum = 0;
+
+        benchmark_throughput("SparseMatrix::sum()", nnz * triplet_bytes, nnz, [&] { sum += A.sum(); });
+
+        benchmark_throughput("SparseMatrix::for_each() SpMV", nnz * triplet_bytes + 2. * sizeof(double) * N, 2. * nnz,
+                             [&] {
+                                 std::fill(y.begin(), y.end(), 0.);
+                                 A.for_each([&](double elem, std::size_t i, std::size_t j) { y[i] += elem * x[j]; });
+                                 sum += y[0];
+                             });
+
+        benchmark_throughput("CSRMatrix::for_each() SpMV", spmv_bytes, 2. * nnz, [&] {
+            std::fill(y.begin(), y.end(), 0.);
+            A_csr.for_each([&](double elem, std::size_t i, std::size_t j) { y[i] += elem * x[j]; });
+            sum += y[0];
+        });
+
+        benchmark_throughput("spmv(BSRMatrix<4>)", nnz * sizeof(double) + nnz / 16. * sizeof(std::size_t) +
+                                                       2. * sizeof(double) * N,
+                             2. * nnz, [&] {
+                                 mvl::spmv(A_bsr, x, y);
+                                 sum += y[0];
+                             });
+
+#ifdef BENCHMARK_MVL_HAS_EIGEN
+        Eigen::SparseMatrix<double, Eigen::RowMajor> A_eigen(N, N);
+        {
+            std::vector<Eigen::Triplet<double>> eigen_triplets;
+            for (const auto& e : triplets) eigen_triplets.emplace_back(e.i, e.j, e.value);
+            A_eigen.setFromTriplets(eigen_triplets.begin(), eigen_triplets.end());
+        }
+        const Eigen::Map<const Eigen::VectorXd> x_eigen(x.data(), N);
+        Eigen::VectorXd                         y_eigen(N);
+
+        benchmark_throughput("Eigen::SparseMatrix<RowMajor> SpMV", spmv_bytes, 2. * nnz, [&] {
+            y_eigen.noalias() = A_eigen * x_eigen;
+            sum += y_eigen[0];
+        });
+#endif
+
+        DO_NOT_OPTIMIZE_AWAY(sum);
+        print_throughput();
+
+        // Insertion
+        begin_group(log::stringify("Sparse insertion (", label, ", ", N, "x", N, ", nnz = ", triplets.size(), ")"));
+
+        benchmark_throughput("SparseMatrix(triplets) from shuffled", nnz * triplet_bytes, 0, [&] {
+            SparseMat B(N, N, std::vector(triplets));
+            DO_NOT_OPTIMIZE_AWAY(B);
+        });
+
+        benchmark_throughput("SparseMatrixBuilder::add() + build()", nnz * triplet_bytes, 0, [&] {
+            mvl::SparseMatrixBuilder<double> builder(N, N);
+            builder.reserve(triplets.size());
+            for (const auto& e : triplets) builder.add(e.i, e.j, e.value);
+            SparseMat B = builder.build();
+            DO_NOT_OPTIMIZE_AWAY(B);
+        });
+
+        benchmark_throughput("SparseMatrix copy (baseline for insertion)", nnz * triplet_bytes, 0, [&] {
+            SparseMat B = A;
+            DO_NOT_OPTIMIZE_AWAY(B);
+        });
+
+        benchmark_throughput("SparseMatrix copy + insert_triplets() 1%", (nnz + inserted.size()) * triplet_bytes, 0,
+                             [&] {
+                                 SparseMat B = A;
+                                 B.insert_triplets(inserted);
+                                 DO_NOT_OPTIMIZE_AWAY(B);
+                             });
+
+        benchmark_throughput("CSRMatrix(SparseMatrix)", nnz * triplet_bytes, 0, [&] {
+            mvl::CSRMatrix<double> B(A);
+            DO_NOT_OPTIMIZE_AWAY(B);
+        });
+
+        benchmark_throughput("BSRMatrix<4>(SparseMatrix)", nnz * triplet_bytes, 0, [&] {
+            mvl::BSRMatrix<double, 4> B(A);
+            DO_NOT_OPTIMIZE_AWAY(B);
+        });
+
+#ifdef BENCHMARK_MVL_HAS_EIGEN
+        benchmark_throughput("Eigen::SparseMatrix::setFromTriplets()", nnz * triplet_bytes, 0, [&] {
+            std::vector<Eigen::Triplet<double>> eigen_triplets;
+            eigen_triplets.reserve(triplets.size());
+            for (const auto& e : triplets) eigen_triplets.emplace_back(e.i, e.j, e.value);
+            Eigen::SparseMatrix<double, Eigen::RowMajor> B(N, N);
+            B.setFromTriplets(eigen_triplets.begin(), eigen_triplets.end());
+            DO_NOT_OPTIMIZE_AWAY(B);
+        });
+#endif
+
+        print_throughput();
+    }
+}
+
+// =============================================
+// --- Elementwise operator chain benchmarks ---
+// =============================================
+
+void benchmark_operator_chains() {
+    for (const auto& [label, N] : dense_sweep) {
+        const DenseMat A(N, N, [] { return datagen::rand_double(); });
+        const DenseMat B(N, N, [] { return datagen::rand_double(); });
+        const DenseMat C(N, N, [] { return datagen::rand_double(); });
+        DenseMat       R(N, N);
+
+        // Ideal traffic of a fused loop is reading every operand once and writing the result once
+        const double elements = 1. * N * N;
+        const auto   traffic  = [&](std::size_t operands) { return 8. * elements * (operands + 1); };
+
+        begin_group(log::stringify("Operator chains (", label, ", ", N, "x", N, ")"));
+
+        benchmark_throughput("R = A + B", traffic(2), elements, [&] { R = A + B; });
+
+        benchmark_throughput("R = A + B (hand-written loop)", traffic(2), elements, [&] {
+            for (std::size_t idx = 0; idx < R.size(); ++idx) R[idx] = A[idx] + B[idx];
+        });
+
+        benchmark_throughput("R = A + B - C + A", traffic(3), 3. * elements, [&] { R = A + B - C + A; });
+
+        benchmark_throughput("R = A + B - C + A (hand-written loop)", traffic(3), 3. * elements, [&] {
+            for (std::size_t idx = 0; idx < R.size(); ++idx) R[idx] = A[idx] + B[idx] - C[idx] + A[idx];
+        });
+
+        benchmark_throughput("R = A; R += B; R -= C; R += A", traffic(3), 3. * elements, [&] {
+            R = A;
+            R += B;
+            R -= C;
+            R += A;
+        });
+
+        benchmark_throughput("R = elementwise_product(A, B) + C", traffic(3), 2. * elements,
+                             [&] { R = mvl::elementwise_product(A, B) + C; });
+
+        benchmark_throughput("R = -A", traffic(1), elements, [&] { R = -A; });
+
+#ifdef BENCHMARK_MVL_HAS_EIGEN
+        using EigenMap = Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+        const EigenMap A_eigen(A.data(), N, N), B_eigen(B.data(), N, N), C_eigen(C.data(), N, N);
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> R_eigen(N, N);
+
+        benchmark_throughput("Eigen R = A + B - C + A", traffic(3), 3. * elements,
+                             [&] { R_eigen = A_eigen + B_eigen - C_eigen + A_eigen; });
+#endif
+
+        DO_NOT_OPTIMIZE_AWAY(R);
+        print_throughput();
+    }
+}
+
+// ==================================
+// --- Format exporter benchmarks ---
+// ==================================
+
+// Bandwidth is measured in terms of the produced text
+template <class Exporter>
+void benchmark_exporter(const char* name, const DenseMat& A, Exporter exporter) {
+    const double text_size = static_cast<double>(exporter(A).size());
+    benchmark_throughput(name, text_size, 0, [&] { DO_NOT_OPTIMIZE_AWAY(exporter(A)); });
+}
+
+void benchmark_exporters() {
+    // Human-readable formats only display matrices up to 30x30, larger ones are replaced with a short message
+    {
+        const DenseMat A(30, 30, [] { return datagen::rand_double(); });
+
+        begin_group("Human-readable formats (30x30)");
+
+        benchmark_exporter("format::as_vector()", A, [](const DenseMat& M) { return mvl::format::as_vector(M); });
+        benchmark_exporter("format::as_matrix()", A, [](const DenseMat& M) { return mvl::format::as_matrix(M); });
+        benchmark_exporter("format::as_dictionary()", A,
+                           [](const DenseMat& M) { return mvl::format::as_dictionary(M); });
+
+        print_throughput();
+    }
+
+    // Export formats are dominated by float stringification, full DRAM-sized matrices would take minutes
+    // to format, so the last size is capped to a 1024x1024 matrix (~20 MiB of text)
+    for (auto [label, N] : dense_sweep) {
+        N = std::min<std::size_t>(N, 1024);
+
+        const DenseMat A(N, N, [] { return datagen::rand_double(); });
+
+        begin_group(log::stringify("Export formats (", label, ", ", N, "x", N, ")"));
+
+        benchmark_exporter("format::as_raw()", A, [](const DenseMat& M) { return mvl::format::as_raw(M); });
+        benchmark_exporter("format::as_csv()", A, [](const DenseMat& M) { return mvl::format::as_csv(M); });
+        benchmark_exporter("format::as_json()", A, [](const DenseMat& M) { return mvl::format::as_json(M); });
+        benchmark_exporter("format::as_mathematica()", A,
+                           [](const DenseMat& M) { return mvl::format::as_mathematica(M); });
+        benchmark_exporter("format::as_latex()", A, [](const DenseMat& M) { return mvl::format::as_latex(M); });
+
+        print_throughput();
+    }
+}
+
 int main() {
+    benchmark_views();
+    benchmark_sparse();
+    benchmark_operator_chains();
+    benchmark_exporters();
+
+    save_results("benchmark_mvl.json", "benchmark_mvl_throughput.csv");
+
     //benchmark_stringify();
-    
-    
-    DenseMat A(3, 4, [] { return random::rand_double(-0.1, 0.1); });
-    
-    // Human-readable formats
-    log::println(mvl::format::as_vector(A));
-    log::println(mvl::format::as_dictionary(A));
-    log::println(mvl::format::as_matrix(A));
-    
-    // Export formats
-    log::println(mvl::format::as_raw(A));
-    log::println(mvl::format::as_csv(A));
-    log::println(mvl::format::as_json(A));
-    log::println(mvl::format::as_mathematica(A));
-    log::println(mvl::format::as_latex(A));
-    
     //benchmark_matmul();
     //benchmark_indexation();
     // benchmark_simd_unrolling();
-}
\ No newline at end of file
+}
@@ -1,15 +1,18 @@
 // __________ BENCHMARK FRAMEWORK & LIBRARY  __________
 
 #include "benchmark.hpp"
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
 #include <limits>
+#include <numeric>
 #include <random>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -81,6 +84,8 @@ void benchmark_prngs() {
     benchmark_prng<random::generators::ChaCha8>("ChaCha8");
     benchmark_prng<random::generators::ChaCha12>("ChaCha12");
     benchmark_prng<random::generators::ChaCha20>("ChaCha20");
+    benchmark_prng<random::generators::Philox4x32>("Philox4x32");
+    benchmark_prng<random::generators::Threefry2x64>("Threefry2x64");
 }
 
 // ===============================
@@ -330,10 +335,328 @@ void benchmark_distributions() {
     benchmark_distributions_for_prng<random::generators::ChaCha20>("ChaCha20");
 }
 
+// =======================
+// --- Bulk generation ---
+// =======================
+
+// Bulk 'fill()' vs a loop of single invocations, multi-lane generators are benchmarked for each lane width,
+// ChaCha for each number of blocks computed at once. Throughput is reported per generated value.
+
+template <class Generator>
+void benchmark_prng_loop(const char* name) {
+    Generator gen{rand_seed};
+
+    std::vector<typename Generator::result_type> data(data_size);
+
+    benchmark(name, [&] {
+        for (auto& e : data) e = gen();
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+template <class Generator>
+void benchmark_prng_fill(const char* name) {
+    Generator gen{rand_seed};
+
+    std::vector<typename Generator::result_type> data(data_size);
+
+    benchmark(name, [&] {
+        random::fill(gen, data.begin(), data.end());
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+template <std::size_t blocks, class Generator>
+void benchmark_chacha_fill(const char* name) {
+    Generator gen{rand_seed};
+
+    std::vector<typename Generator::result_type> data(data_size);
+
+    benchmark(name, [&] {
+        gen.template fill<blocks>(data.begin(), data.end());
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+template <class Generator, class Distribution>
+void benchmark_distribution_loop(const char* name, Distribution dist) {
+    Generator gen{rand_seed};
+
+    std::vector<typename Distribution::result_type> data(data_size);
+
+    benchmark(name, [&] {
+        for (auto& e : data) e = dist(gen);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+template <class Generator, class Distribution>
+void benchmark_distribution_fill(const char* name, Distribution dist) {
+    Generator gen{rand_seed};
+
+    std::vector<typename Distribution::result_type> data(data_size);
+
+    benchmark(name, [&] {
+        dist.fill(gen, data.begin(), data.end());
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+void benchmark_bulk_generation() {
+    using namespace random::generators;
+
+    log::println("\n\n====== BENCHMARKING: Bulk generation ======\n");
+    log::println("N -> ", data_size);
+
+    bench.timeUnit(1ns, "ns").batch(data_size).unit("value").minEpochIterations(5).warmup(10).relative(true);
+
+    bench.title("64-bit Xoshiro lanes");
+    benchmark_prng_loop<Xoshiro256PP>("Xoshiro256++    (x1, loop)");
+    benchmark_prng_fill<Xoshiro256PP>("Xoshiro256++    (x1, fill)");
+    benchmark_prng_fill<Xoshiro256PPLanes<2>>("Xoshiro256++    (x2, fill)");
+    benchmark_prng_fill<Xoshiro256PPx4>("Xoshiro256++    (x4, fill)");
+    benchmark_prng_fill<Xoshiro256PPx8>("Xoshiro256++    (x8, fill)");
+    benchmark_prng_loop<Xoshiro256PPx8>("Xoshiro256++    (x8, loop)");
+
+    bench.title("32-bit Xoshiro lanes");
+    benchmark_prng_loop<Xoshiro128PP>("Xoshiro128++    (x1, loop)");
+    benchmark_prng_fill<Xoshiro128PPx4>("Xoshiro128++    (x4, fill)");
+    benchmark_prng_fill<Xoshiro128PPx8>("Xoshiro128++    (x8, fill)");
+    benchmark_prng_fill<Xoshiro128PPLanes<16>>("Xoshiro128++    (x16, fill)");
+
+    bench.title("ChaCha blocks");
+    benchmark_prng_loop<ChaCha8>("ChaCha8         (x1, loop)");
+    benchmark_chacha_fill<1, ChaCha8>("ChaCha8         (x1, fill)");
+    benchmark_chacha_fill<4, ChaCha8>("ChaCha8         (x4, fill)");
+    benchmark_chacha_fill<8, ChaCha8>("ChaCha8         (x8, fill)");
+    benchmark_prng_loop<ChaCha20>("ChaCha20        (x1, loop)");
+    benchmark_chacha_fill<8, ChaCha20>("ChaCha20        (x8, fill)");
+
+    bench.title("Uniform int distribution");
+    const random::UniformIntDistribution<int> int_dist{-1000, 1000};
+    benchmark_distribution_loop<std::mt19937>("std::mt19937    (x1, loop)", std::uniform_int_distribution{-1000, 1000});
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++    (x1, loop)", int_dist);
+    benchmark_distribution_fill<Xoshiro256PP>("Xoshiro256++    (x1, fill)", int_dist);
+    benchmark_distribution_fill<Xoshiro256PPx4>("Xoshiro256++    (x4, fill)", int_dist);
+    benchmark_distribution_fill<Xoshiro256PPx8>("Xoshiro256++    (x8, fill)", int_dist);
+
+    bench.title("Uniform real distribution");
+    const random::UniformRealDistribution<double> real_dist{-1., 1.};
+    benchmark_distribution_loop<std::mt19937>("std::mt19937    (x1, loop)", std::uniform_real_distribution{-1., 1.});
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++    (x1, loop)", real_dist);
+    benchmark_distribution_fill<Xoshiro256PP>("Xoshiro256++    (x1, fill)", real_dist);
+    benchmark_distribution_fill<Xoshiro256PPx4>("Xoshiro256++    (x4, fill)", real_dist);
+    benchmark_distribution_fill<Xoshiro256PPx8>("Xoshiro256++    (x8, fill)", real_dist);
+
+    bench.title("Normal distribution");
+    const random::NormalDistribution<double> normal_dist{0., 1.};
+    benchmark_distribution_loop<std::mt19937>("std::mt19937    (x1, loop)", std::normal_distribution{0., 1.});
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++ std(x1, loop)", std::normal_distribution{0., 1.});
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++    (x1, loop)", normal_dist);
+    benchmark_distribution_fill<Xoshiro256PP>("Xoshiro256++    (x1, fill)", normal_dist);
+    benchmark_distribution_fill<Xoshiro256PPx8>("Xoshiro256++    (x8, fill)", normal_dist);
+
+    bench.title("Exponential distribution");
+    const random::ExponentialDistribution<double> exponential_dist{1.};
+    benchmark_distribution_loop<std::mt19937>("std::mt19937    (x1, loop)", std::exponential_distribution{1.});
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++ std(x1, loop)", std::exponential_distribution{1.});
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++    (x1, loop)", exponential_dist);
+    benchmark_distribution_fill<Xoshiro256PP>("Xoshiro256++    (x1, fill)", exponential_dist);
+    benchmark_distribution_fill<Xoshiro256PPx8>("Xoshiro256++    (x8, fill)", exponential_dist);
+}
+
+// =============================
+// --- Discrete distribution ---
+// =============================
+
+// Weighted choice from a large number of categories, 'std::discrete_distribution' does a binary search
+// over cumulative probabilities while alias table takes O(1) per sample.
+
+void benchmark_discrete_distribution() {
+    using namespace random::generators;
+
+    constexpr std::size_t categories = 1'000'000;
+
+    log::println("\n\n====== BENCHMARKING: Discrete distribution ======\n");
+    log::println("N          -> ", data_size);
+    log::println("categories -> ", categories);
+
+    std::vector<double> weights(categories);
+    random::UniformRealDistribution<double>{0., 1.}.fill(random::default_generator, weights.begin(), weights.end());
+
+    bench.timeUnit(1ns, "ns").batch(data_size).unit("value").minEpochIterations(5).warmup(10).relative(true);
+
+    bench.title("Sampling");
+    const std::discrete_distribution<int>   std_dist(weights.begin(), weights.end());
+    const random::DiscreteDistribution<int> alias_dist(weights.begin(), weights.end());
+    benchmark_distribution_loop<std::mt19937>("std::mt19937    (x1, loop)", std_dist);
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++ std(x1, loop)", std_dist);
+    benchmark_distribution_loop<Xoshiro256PP>("Xoshiro256++    (x1, loop)", alias_dist);
+    benchmark_distribution_fill<Xoshiro256PPx8>("Xoshiro256++    (x8, fill)", alias_dist);
+
+    bench.title("Construction").batch(categories).unit("category");
+    benchmark("std::discrete_distribution<>", [&] {
+        std::discrete_distribution<int> dist(weights.begin(), weights.end());
+        DO_NOT_OPTIMIZE_AWAY(dist);
+    });
+    benchmark("random::DiscreteDistribution<>", [&] {
+        random::DiscreteDistribution<int> dist(weights.begin(), weights.end());
+        DO_NOT_OPTIMIZE_AWAY(dist);
+    });
+    random::DiscreteDistribution<int> rebuilt_dist(weights.begin(), weights.end());
+    benchmark("random::DiscreteDistribution<>::rebuild()", [&] {
+        rebuilt_dist.set_weight(0, weights[0]);
+        rebuilt_dist.rebuild();
+        DO_NOT_OPTIMIZE_AWAY(rebuilt_dist);
+    });
+}
+
+// ===========================
+// --- Parallel generation ---
+// ===========================
+
+// Block-wise generation that doesn't depend on the thread count vs a sequential fill
+
+void benchmark_parallel_fill() {
+    using namespace random::generators;
+
+    constexpr std::size_t size = 8 * data_size;
+
+    log::println("\n\n====== BENCHMARKING: Parallel generation ======\n");
+    log::println("N       -> ", size);
+    log::println("threads -> ", std::thread::hardware_concurrency());
+
+    std::vector<double> data(size);
+
+    bench.timeUnit(1ns, "ns").batch(size).unit("value").minEpochIterations(2).warmup(2).relative(true);
+
+    const auto benchmark_distribution = [&](const char* title, const auto& dist) {
+        bench.title(title);
+        benchmark("Xoshiro256++ (sequential fill)", [&] {
+            Xoshiro256PP gen{rand_seed};
+            dist.fill(gen, data.begin(), data.end());
+            DO_NOT_OPTIMIZE_AWAY(data.data());
+        });
+        benchmark("Philox4x32   (parallel_fill(), 1 thread)", [&] {
+            random::parallel_fill(data.begin(), data.end(), dist, rand_seed, 1);
+            DO_NOT_OPTIMIZE_AWAY(data.data());
+        });
+        benchmark("Philox4x32   (parallel_fill())", [&] {
+            random::parallel_fill(data.begin(), data.end(), dist, rand_seed);
+            DO_NOT_OPTIMIZE_AWAY(data.data());
+        });
+    };
+
+    benchmark_distribution("Uniform real distribution", random::UniformRealDistribution<double>{-1., 1.});
+    benchmark_distribution("Normal distribution", random::NormalDistribution<double>{0., 1.});
+}
+
+// ================
+// --- Sampling ---
+// ================
+
+void benchmark_sampling() {
+    using namespace random::generators;
+
+    constexpr std::size_t n = data_size, k = 1000;
+
+    log::println("\n\n====== BENCHMARKING: Sampling ======\n");
+    log::println("N -> ", n);
+    log::println("k -> ", k);
+
+    std::vector<std::uint32_t> data(n), sample(k);
+    std::iota(data.begin(), data.end(), 0);
+
+    bench.timeUnit(1ns, "ns").batch(n).unit("element").minEpochIterations(5).warmup(2).relative(true);
+
+    bench.title("Shuffle");
+    benchmark("std::shuffle()    (std::mt19937)", [&, gen = std::mt19937{rand_seed}]() mutable {
+        std::shuffle(data.begin(), data.end(), gen);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+    benchmark("std::shuffle()    (Xoshiro256++)", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        std::shuffle(data.begin(), data.end(), gen);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+    benchmark("random::shuffle() (Xoshiro256++)", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        random::shuffle(data.begin(), data.end(), gen);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+    benchmark("random::parallel_shuffle()", [&] {
+        random::parallel_shuffle(data.begin(), data.end(), rand_seed);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+
+    bench.title("Sampling k of N").batch(k).unit("sample");
+    benchmark("std::sample()    (Xoshiro256++)", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        std::sample(data.begin(), data.end(), sample.begin(), k, gen);
+        DO_NOT_OPTIMIZE_AWAY(sample.data());
+    });
+    benchmark("random::sample() (Xoshiro256++)", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        random::sample(data.begin(), data.end(), sample.begin(), k, gen);
+        DO_NOT_OPTIMIZE_AWAY(sample.data());
+    });
+
+    bench.title("Reservoir sampling k of N").batch(n).unit("element");
+    benchmark("random::ReservoirSampler<>", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        random::ReservoirSampler<std::uint32_t> sampler(k);
+        for (const auto& e : data) sampler.push(e, gen);
+        DO_NOT_OPTIMIZE_AWAY(sampler);
+    });
+    benchmark("random::WeightedReservoirSampler<>", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        random::WeightedReservoirSampler<std::uint32_t> sampler(k);
+        for (const auto& e : data) sampler.push(e, 1. + (e & 7), gen);
+        DO_NOT_OPTIMIZE_AWAY(sampler);
+    });
+}
+
+// ===============================
+// --- Quasi-random sequences ---
+// ===============================
+
+void benchmark_quasi_random() {
+    using namespace random::generators;
+
+    constexpr std::size_t d = 8, n = 100'000;
+
+    log::println("\n\n====== BENCHMARKING: Quasi-random sequences ======\n");
+    log::println("Dimensions -> ", d);
+    log::println("Points     -> ", n);
+
+    std::vector<double> points(n * d);
+
+    bench.timeUnit(1ns, "ns").batch(n).unit("point").minEpochIterations(5).warmup(2).relative(true);
+
+    bench.title("Points in [0, 1)^8");
+    benchmark("Xoshiro256++ (random points)", [&, gen = Xoshiro256PP{rand_seed}]() mutable {
+        for (auto& e : points) e = random::generate_canonical<double>(gen);
+        DO_NOT_OPTIMIZE_AWAY(points.data());
+    });
+    benchmark("SobolSequence<>", [&, sequence = random::SobolSequence<>(d)]() mutable {
+        sequence.seek(0);
+        sequence.fill(points.begin(), points.end());
+        DO_NOT_OPTIMIZE_AWAY(points.data());
+    });
+    benchmark("HaltonSequence<>", [&, sequence = random::HaltonSequence<>(d)]() mutable {
+        sequence.seek(0);
+        sequence.fill(points.begin(), points.end());
+        DO_NOT_OPTIMIZE_AWAY(points.data());
+    });
+    benchmark("RSequence<>", [&, sequence = random::RSequence<>(d)]() mutable {
+        sequence.seek(0);
+        sequence.fill(points.begin(), points.end());
+        DO_NOT_OPTIMIZE_AWAY(points.data());
+    });
+}
 
 int main() {
 
     benchmark_prngs();
+    benchmark_bulk_generation();
+    benchmark_discrete_distribution();
+    benchmark_parallel_fill();
+    benchmark_sampling();
+    benchmark_quasi_random();
     //benchmark_distributions();
 
     return 0;
@@ -0,0 +1,235 @@
+// __________ BENCHMARK FRAMEWORK & LIBRARY  __________
+
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// _____________ BENCHMARK IMPLEMENTATION _____________
+
+// ==========================
+// --- Splitting by delim ---
+// ==========================
+
+constexpr std::size_t line_count = 200'000;
+
+// Log-like text, each line has a handful of fields separated by ' ', with occasional tabs & repeated spaces
+std::string generate_log_text() {
+    random::generators::Xoshiro256PP gen{15};
+
+    constexpr std::string_view levels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+    constexpr std::string_view words[]  = {"request",  "served", "cache", "miss", "connection",
+                                           "accepted", "closed", "retry", "user", "timeout"};
+
+    std::string text;
+    for (std::size_t i = 0; i < line_count; ++i) {
+        text += std::to_string(1'700'000'000 + i);
+        text += ' ';
+        text += levels[gen() % 4];
+        text += (gen() % 8) ? " " : "\t ";
+        for (std::size_t w = 0, count = 3 + gen() % 6; w < count; ++w) {
+            text += words[gen() % 10];
+            text += ' ';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+void benchmark_split() {
+    const std::string text = generate_log_text();
+
+    log::println("\n\n====== BENCHMARKING: Splitting by delimiter ======\n");
+    log::println("Text size -> ", text.size() / (1 << 20), " MiB");
+
+    bench.timeUnit(1ms, "ms").minEpochIterations(5).warmup(2).relative(true);
+
+    bench.title("Split text into words");
+    benchmark("stre::split_by_delimiter()", [&] {
+        const auto tokens = stre::split_by_delimiter(text, " ");
+        DO_NOT_OPTIMIZE_AWAY(tokens.data());
+    });
+    benchmark("stre::split_view() (substring)", [&] {
+        std::size_t size = 0;
+        for (auto token : stre::split_view(text, " ")) size += token.size();
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+    benchmark("stre::split_view() (char)", [&] {
+        std::size_t size = 0;
+        for (auto token : stre::split_view(text, ' ')) size += token.size();
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+    benchmark("stre::for_each_token() (char)", [&] {
+        std::size_t size = 0;
+        stre::for_each_token(text, ' ', [&](std::string_view token) { size += token.size(); });
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+    benchmark("stre::split_into() (char, reused strings)", [&, tokens = std::vector<std::string>{}]() mutable {
+        stre::split_into(text, ' ', tokens);
+        DO_NOT_OPTIMIZE_AWAY(tokens.data());
+    });
+    benchmark("stre::split_into() (char, reused views)", [&, tokens = std::vector<std::string_view>{}]() mutable {
+        stre::split_into(text, ' ', tokens);
+        DO_NOT_OPTIMIZE_AWAY(tokens.data());
+    });
+
+    const stre::CharSet whitespace(" \t\n");
+
+    bench.title("Split text into words (any whitespace)");
+    benchmark("stre::split_view() (set)", [&] {
+        std::size_t size = 0;
+        for (auto token : stre::split_view(text, whitespace)) size += token.size();
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+    benchmark("stre::split_into() (set, reused views)", [&, tokens = std::vector<std::string_view>{}]() mutable {
+        stre::split_into(text, whitespace, tokens);
+        DO_NOT_OPTIMIZE_AWAY(tokens.data());
+    });
+
+    bench.title("Split text into lines");
+    benchmark("stre::split_by_delimiter()", [&] {
+        const auto tokens = stre::split_by_delimiter(text, "\n");
+        DO_NOT_OPTIMIZE_AWAY(tokens.data());
+    });
+    benchmark("stre::split_view() (substring)", [&] {
+        std::size_t count = 0;
+        for (auto token : stre::split_view(text, "\n")) count += !token.empty();
+        DO_NOT_OPTIMIZE_AWAY(count);
+    });
+    benchmark("stre::split_view() (char)", [&] {
+        std::size_t count = 0;
+        for (auto token : stre::split_view(text, '\n')) count += !token.empty();
+        DO_NOT_OPTIMIZE_AWAY(count);
+    });
+}
+
+// =====================================
+// --- Case, trimming & char classes ---
+// =====================================
+
+void benchmark_case_conversion() {
+    const std::string text = generate_log_text();
+
+    log::println("\n\n====== BENCHMARKING: Case conversion ======\n");
+    log::println("Text size -> ", text.size() / (1 << 20), " MiB");
+
+    bench.timeUnit(1ms, "ms").minEpochIterations(5).warmup(2).relative(true);
+
+    bench.title("Convert text to lowercase (copy)");
+    benchmark("stre::to_lower()", [&] {
+        const auto res = stre::to_lower(text);
+        DO_NOT_OPTIMIZE_AWAY(res.data());
+    });
+    benchmark("stre::to_lower_ascii()", [&] {
+        const auto res = stre::to_lower_ascii(text);
+        DO_NOT_OPTIMIZE_AWAY(res.data());
+    });
+
+    bench.title("Convert text to uppercase (in place)");
+    benchmark("stre::to_upper()", [&, buffer = text]() mutable {
+        buffer = stre::to_upper(std::move(buffer));
+        DO_NOT_OPTIMIZE_AWAY(buffer.data());
+    });
+    benchmark("stre::to_upper_ascii()", [&, buffer = text]() mutable {
+        buffer = stre::to_upper_ascii(std::move(buffer));
+        DO_NOT_OPTIMIZE_AWAY(buffer.data());
+    });
+}
+
+void benchmark_trimming() {
+    constexpr std::size_t string_count = 100'000;
+
+    // Strings with a varying amount of whitespace padding on both sides
+    random::generators::Xoshiro256PP gen{15};
+
+    std::vector<std::string> strings(string_count);
+    for (auto& str : strings) {
+        str += std::string(gen() % 64, ' ');
+        str += (gen() % 2) ? "\t" : "";
+        str += "some text that needs trimming";
+        str += std::string(gen() % 64, ' ');
+        str += (gen() % 2) ? "\r\n" : "\n";
+    }
+
+    log::println("\n\n====== BENCHMARKING: Trimming ======\n");
+    log::println("Strings -> ", string_count);
+
+    bench.timeUnit(1us, "us").minEpochIterations(5).warmup(2).relative(true);
+
+    bench.title("Trim spaces");
+    benchmark("stre::trim()", [&] {
+        std::size_t size = 0;
+        for (const auto& str : strings) size += stre::trim(str).size();
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+    benchmark("stre::trim_view()", [&] {
+        std::size_t size = 0;
+        for (const auto& str : strings) size += stre::trim_view(str).size();
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+
+    const stre::CharSet whitespace(" \t\r\n");
+
+    bench.title("Trim whitespace");
+    benchmark("std::string_view::find_first/last_not_of()", [&] {
+        std::size_t size = 0;
+        for (std::string_view str : strings) {
+            str.remove_prefix(std::min(str.find_first_not_of(" \t\r\n"), str.size()));
+            str.remove_suffix(str.size() - (str.find_last_not_of(" \t\r\n") + 1));
+            size += str.size();
+        }
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+    benchmark("stre::trim_view() (set)", [&] {
+        std::size_t size = 0;
+        for (const auto& str : strings) size += stre::trim_view(str, whitespace).size();
+        DO_NOT_OPTIMIZE_AWAY(size);
+    });
+}
+
+void benchmark_scanning() {
+    const std::string text = generate_log_text();
+
+    log::println("\n\n====== BENCHMARKING: Character class scanning ======\n");
+    log::println("Text size -> ", text.size() / (1 << 20), " MiB");
+
+    bench.timeUnit(1ms, "ms").minEpochIterations(5).warmup(2).relative(true);
+
+    // Looking for chars that are rare in the text, which means we scan through long runs of characters
+    const std::string_view rare = "\t=";
+    const stre::CharSet    small_set(rare);
+    const stre::CharSet    large_set("\t=#@$%");
+
+    bench.title("Count occurrences of '\\t' & '='");
+    benchmark("std::string_view::find_first_of()", [&] {
+        std::size_t count = 0;
+        for (std::size_t pos = 0; (pos = std::string_view(text).find_first_of(rare, pos)) != std::string_view::npos;)
+            ++count, ++pos;
+        DO_NOT_OPTIMIZE_AWAY(count);
+    });
+    benchmark("stre::find_first_of() (SWAR)", [&] {
+        std::size_t count = 0;
+        for (std::size_t pos = 0; (pos = stre::find_first_of(text, small_set, pos)) != std::string_view::npos;)
+            ++count, ++pos;
+        DO_NOT_OPTIMIZE_AWAY(count);
+    });
+    benchmark("stre::find_first_of() (lookup table)", [&] {
+        std::size_t count = 0;
+        for (std::size_t pos = 0; (pos = stre::find_first_of(text, large_set, pos)) != std::string_view::npos;)
+            ++count, ++pos;
+        DO_NOT_OPTIMIZE_AWAY(count);
+    });
+}
+
+int main() {
+
+    benchmark_split();
+    benchmark_case_conversion();
+    benchmark_trimming();
+    benchmark_scanning();
+
+    return 0;
+}
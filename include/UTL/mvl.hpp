@@ -15,26 +15,36 @@
 // _______________________ INCLUDES _______________________
 
 #include <algorithm>        // swap(), find(), count(), is_sorted(), min_element(),
-                            // max_element(), sort(), stable_sort(), min(), max(), remove_if(), copy()
+                            // max_element(), sort(), stable_sort(), min(), max(), remove_if(), copy(), fill_n(),
+                            // lower_bound(), inplace_merge(), find_if(), clamp()
+#include <array>            // array<>
+#include <atomic>           // atomic<>
 #include <cassert>          // assert() // Note: Perhaps temporary
 #include <charconv>         // to_chars()
-#include <cmath>            // isfinite()
+#include <cmath>            // isfinite(), abs(), round(), sqrt(), hypot(), copysign()
 #include <cstddef>          // size_t, ptrdiff_t, nullptr_t
-#include <exception>        // exception
+#include <cstdint>          // uint16_t, uint32_t, uint64_t, int8_t, int32_t
+#include <cstring>          // memcpy()
+#include <exception>        // exception, exception_ptr, current_exception(), rethrow_exception()
 #include <functional>       // reference_wrapper<>, multiplies<>
 #include <initializer_list> // initializer_list<>
 #include <iomanip>          // setw()
 #include <ios>              // right(), boolalpha(), ios::boolalpha
-#include <iterator>         // random_access_iterator_tag, reverse_iterator<>
-#include <memory>           // unique_ptr<>
+#include <iterator>         // random_access_iterator_tag, reverse_iterator<>, make_move_iterator(), prev()
+#include <limits>           // numeric_limits<>
+#include <memory>           // unique_ptr<>, make_unique<>()
+#include <mutex>            // mutex, lock_guard<>
 #include <numeric>          // accumulate()
 #include <ostream>          // ostream
+#include <random>           // seed_seq
 #include <sstream>          // ostringstream
-#include <stdexcept>        // out_of_range, invalid_argument
+#include <stdexcept>        // out_of_range, invalid_argument, runtime_error
 #include <string>           // string
 #include <string_view>      // string_view<>
+#include <thread>           // thread, this_thread::get_id()
 #include <type_traits>      // conditional_t<>, enable_if_t<>, void_t<>, true_type, false_type, remove_reference_t<>
-#include <utility>          // move()
+#include <unordered_set>    // unordered_set<>
+#include <utility>          // move(), pair<>, exchange()
 #include <vector>           // vector<>
 
 // ____________________ DEVELOPER DOCS ____________________
@@ -385,11 +395,6 @@ struct default_stringifier {
 template <class FuncType, class Signature>
 using _has_signature_enable_if = std::enable_if_t<std::is_convertible_v<FuncType, std::function<Signature>>, bool>;
 
-template <class T>
-[[nodiscard]] std::unique_ptr<T[]> _make_unique_ptr_array(size_t size) {
-    return std::unique_ptr<T[]>(new T[size]);
-}
-
 // Marker for uncreachable code
 [[noreturn]] inline void _unreachable() {
 // (Implementation from https://en.cppreference.com/w/cpp/utility/unreachable)
@@ -403,6 +408,343 @@ template <class T>
 #endif
 }
 
+// ==============================
+// --- Parallelization helper ---
+// ==============================
+
+// Modules are supposed to stay independent, so we can't reuse 'utl::parallel' here. Instead heavier algorithms
+// use a minimal "parallel for" with static chunking over 'std::thread' (a stripped-down analogue of
+// 'parallel::for_loop()'). Each thread gets a single contiguous range of indices, which keeps the mapping between
+// threads and memory the same across calls (good for cache reuse and NUMA first-touch).
+//
+// Spawning threads costs ~tens of microseconds, which is why every algorithm passes a 'min_grain' that prevents
+// splitting work into chunks too small to benefit from it. Exceptions thrown by the workers are rethrown
+// in the calling thread after all workers are joined.
+
+[[nodiscard]] inline std::size_t _max_thread_count() noexcept {
+    const std::size_t detected_threads = std::thread::hardware_concurrency();
+    return detected_threads ? detected_threads : 1;
+}
+
+template <class Func>
+void _parallel_for(std::size_t count, std::size_t min_grain, Func&& func) {
+    // 'func(low, high)' gets called for a set of contiguous ranges covering [0, count)
+    const std::size_t max_chunks   = count / std::max<std::size_t>(min_grain, 1);
+    const std::size_t thread_count = std::min(_max_thread_count(), max_chunks);
+
+    if (thread_count <= 1) {
+        if (count) func(std::size_t(0), count);
+        return;
+    }
+
+    const std::size_t chunk_size = count / thread_count;
+    const std::size_t remainder  = count % thread_count;
+    const auto        chunk_low  = [&](std::size_t t) { return t * chunk_size + std::min(t, remainder); };
+    // first 'remainder' chunks get an extra element, this keeps chunk sizes within 1 element of each other
+
+    std::vector<std::exception_ptr> exceptions(thread_count);
+    std::vector<std::thread>        workers;
+    workers.reserve(thread_count - 1);
+
+    const auto run_chunk = [&](std::size_t t) {
+        try {
+            func(chunk_low(t), chunk_low(t + 1));
+        } catch (...) { exceptions[t] = std::current_exception(); }
+    };
+
+    for (std::size_t t = 1; t < thread_count; ++t) workers.emplace_back(run_chunk, t);
+    run_chunk(0); // calling thread takes the first chunk instead of idling
+
+    for (auto& worker : workers) worker.join();
+    for (const auto& e : exceptions)
+        if (e) std::rethrow_exception(e);
+}
+
+// Minimal grain for '_parallel_for()' over items that take 'operations_per_item' operations each,
+// threads only get spawned once there is enough work to amortize their creation
+[[nodiscard]] constexpr std::size_t _min_grain(std::size_t operations_per_item) noexcept {
+    constexpr std::size_t operations_per_thread = 1 << 16;
+    return std::max<std::size_t>(1, operations_per_thread / std::max<std::size_t>(operations_per_item, 1));
+}
+
+// Tag for container constructors that initialize elements in parallel, regular constructors never spawn threads
+struct ParallelInit {};
+
+constexpr ParallelInit parallel_init{};
+
+// ===================
+// --- Buffer pool ---
+// ===================
+
+// Operators return new containers, so loops like 'for (...) C = A * B + D;' allocate and free buffers of the same
+// size over and over again. When enabled, freed tensor buffers get cached in a thread-local pool instead of being
+// returned to the allocator, and subsequent allocations of a similar size are served from it.
+//
+// Buffers sizes are rounded up to one of 4 size classes per power of 2, which bounds wasted memory by 25%, each class
+// keeps a free list of cached buffers. Pooled buffers remember their capacity in a deleter, which means they can be
+// freed from any thread: buffer gets cached by the pool of that thread (or deleted if pooling is disabled there).
+//
+// Only trivial types are pooled, since reused buffers contain leftover values, which for trivial types is
+// indistinguishable from default-initialization. Pool is opt-in, since cached buffers keep holding memory.
+
+inline thread_local bool        _buffer_pool_enabled   = false;
+inline thread_local bool        _buffer_pool_destroyed = false; // pools can outlive other thread-local objects
+inline thread_local std::size_t _buffer_pool_limit     = std::size_t(256) << 20; // max cached bytes per value type
+
+inline thread_local std::vector<void (*)()> _buffer_pool_clear_functions;
+
+// Larger allocations bypass the pool, this keeps rounded up capacity from overflowing
+constexpr std::size_t _buffer_pool_max_size = std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 2);
+
+struct _buffer_size_class {
+    std::size_t index;
+    std::size_t capacity;
+};
+
+[[nodiscard]] constexpr _buffer_size_class _get_buffer_size_class(std::size_t size) noexcept {
+    if (size <= 8) return {size, size};
+
+    std::size_t power = 4; // 2^(power - 1) < size <= 2^power
+    while ((std::size_t(1) << power) < size) ++power;
+
+    const std::size_t step     = std::size_t(1) << (power - 3);
+    const std::size_t multiple = (size + step - 1) / step; // in [5, 8]
+
+    return {9 + 4 * (power - 4) + (multiple - 5), multiple * step};
+}
+
+template <class T>
+class _buffer_pool {
+    static constexpr std::size_t class_count = _get_buffer_size_class(_buffer_pool_max_size).index + 1;
+
+    std::array<std::vector<T*>, class_count> _free_lists;
+    std::size_t                              _cached_bytes = 0;
+
+public:
+    _buffer_pool() { _buffer_pool_clear_functions.push_back([] { _buffer_pool<T>::instance().clear(); }); }
+
+    _buffer_pool(const _buffer_pool&)            = delete;
+    _buffer_pool& operator=(const _buffer_pool&) = delete;
+
+    ~_buffer_pool() {
+        this->clear();
+        _buffer_pool_destroyed = true;
+    }
+
+    [[nodiscard]] static _buffer_pool& instance() {
+        thread_local _buffer_pool pool;
+        return pool;
+    }
+
+    [[nodiscard]] T* acquire(_buffer_size_class size_class) {
+        auto& free_list = this->_free_lists[size_class.index];
+        if (free_list.empty()) return new T[size_class.capacity];
+
+        T* ptr = free_list.back();
+        free_list.pop_back();
+        this->_cached_bytes -= size_class.capacity * sizeof(T);
+        return ptr;
+    }
+
+    // Returns 'false' if the buffer wasn't cached and should be deleted by the caller
+    [[nodiscard]] bool release(T* ptr, std::size_t capacity) noexcept {
+        const std::size_t bytes = capacity * sizeof(T);
+        if (this->_cached_bytes + bytes > _buffer_pool_limit) return false;
+
+        try {
+            this->_free_lists[_get_buffer_size_class(capacity).index].push_back(ptr);
+        } catch (...) { return false; }
+
+        this->_cached_bytes += bytes;
+        return true;
+    }
+
+    void clear() noexcept {
+        for (auto& free_list : this->_free_lists) {
+            for (T* ptr : free_list) delete[] ptr;
+            free_list.clear();
+        }
+        this->_cached_bytes = 0;
+    }
+};
+
+template <class T>
+struct _pooled_array_deleter {
+    std::size_t capacity = 0; // '0' => buffer was allocated outside of the pool
+
+    void operator()(T* ptr) const noexcept {
+        if (this->capacity && _buffer_pool_enabled && !_buffer_pool_destroyed &&
+            _buffer_pool<T>::instance().release(ptr, this->capacity))
+            return;
+        delete[] ptr;
+    }
+};
+
+template <class T>
+using _unique_array = std::unique_ptr<T[], _pooled_array_deleter<T>>;
+
+template <class T>
+[[nodiscard]] _unique_array<T> _make_unique_ptr_array(std::size_t size) {
+    if constexpr (std::is_trivial_v<T>) {
+        if (_buffer_pool_enabled && !_buffer_pool_destroyed && size && size <= _buffer_pool_max_size) {
+            const auto size_class = _get_buffer_size_class(size);
+            return _unique_array<T>(_buffer_pool<T>::instance().acquire(size_class),
+                                    _pooled_array_deleter<T>{size_class.capacity});
+        }
+    }
+    return _unique_array<T>(new T[size]);
+}
+
+// --- Buffer pool API ---
+// -----------------------
+
+// Enables / disables buffer pool for the current thread
+inline void set_buffer_pool_enabled(bool enabled) noexcept { _buffer_pool_enabled = enabled; }
+
+[[nodiscard]] inline bool buffer_pool_enabled() noexcept { return _buffer_pool_enabled; }
+
+// Sets max amount of bytes cached by the current thread (per value type), buffers above the limit get deleted
+inline void set_buffer_pool_limit(std::size_t bytes) noexcept { _buffer_pool_limit = bytes; }
+
+// Frees all buffers cached by the current thread
+inline void clear_buffer_pool() noexcept {
+    if (_buffer_pool_destroyed) return;
+    for (const auto& clear : _buffer_pool_clear_functions) clear();
+}
+
+// RAII guard that enables buffer pool for the current thread within a scope
+class BufferPoolScope {
+    bool _was_enabled;
+
+public:
+    BufferPoolScope() noexcept : _was_enabled(_buffer_pool_enabled) { _buffer_pool_enabled = true; }
+
+    BufferPoolScope(const BufferPoolScope&)            = delete;
+    BufferPoolScope& operator=(const BufferPoolScope&) = delete;
+
+    ~BufferPoolScope() { _buffer_pool_enabled = this->_was_enabled; }
+};
+
+// ===============================
+// --- Reduced precision types ---
+// ===============================
+
+// Large bandwidth-bound matrices can be stored in 16-bit floats and only widened to 'float' in registers, which
+// halves the memory traffic. Both formats below are software implementations on top of 'std::uint16_t' storage,
+// arithmetic converts operands to 'float', computes and rounds the result back (round-to-nearest-even).
+//
+// Conversions are intentionally 'explicit' in one direction ('float' -> 16-bit) and implicit in the other. This
+// way mixed expressions like 'bfloat16 * float' unambiguously resolve to 'float' arithmetic, while homogeneous
+// expressions use the operators defined below and stay in the 16-bit type.
+
+[[nodiscard]] inline std::uint32_t _float_to_bits(float value) noexcept {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+[[nodiscard]] inline float _bits_to_float(std::uint32_t bits) noexcept {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 'bfloat16' is the upper half of IEEE 754 single precision: 8 exponent bits & 7 mantissa bits. It keeps the range
+// of 'float' at the cost of precision, conversions are just bit shifts.
+struct _bfloat16_format {
+    [[nodiscard]] static std::uint16_t from_float(float value) noexcept {
+        const std::uint32_t bits = _float_to_bits(value);
+        if ((bits & 0x7fffffffu) > 0x7f800000u) return static_cast<std::uint16_t>((bits >> 16) | 0x0040u); // quiet NaN
+        return static_cast<std::uint16_t>((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+    }
+
+    [[nodiscard]] static float to_float(std::uint16_t bits) noexcept {
+        return _bits_to_float(static_cast<std::uint32_t>(bits) << 16);
+    }
+};
+
+// 'float16' is IEEE 754 half precision: 5 exponent bits & 10 mantissa bits, range is '[-65504, 65504]' with
+// subnormals down to '2^-24'. Conversion has to handle rebiasing, subnormals and overflow explicitly.
+struct _float16_format {
+    [[nodiscard]] static std::uint16_t from_float(float value) noexcept {
+        const std::uint32_t bits = _float_to_bits(value);
+        const std::uint32_t sign = (bits >> 16) & 0x8000u;
+        const std::uint32_t abs  = bits & 0x7fffffffu;
+
+        if (abs >= 0x7f800000u) return static_cast<std::uint16_t>(sign | (abs > 0x7f800000u ? 0x7e00u : 0x7c00u));
+        if (abs >= 0x477ff000u) return static_cast<std::uint16_t>(sign | 0x7c00u); // rounds to infinity
+        if (abs <= 0x33000000u) return static_cast<std::uint16_t>(sign);           // rounds to zero
+
+        // Subnormal result, mantissa with an implicit bit gets shifted into place with rounding
+        if (abs < 0x38800000u) {
+            const std::uint32_t mantissa  = (abs & 0x007fffffu) | 0x00800000u;
+            const std::uint32_t shift     = 126u - (abs >> 23);
+            const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const std::uint32_t halfway   = 1u << (shift - 1u);
+            std::uint32_t       result    = mantissa >> shift;
+            if (remainder > halfway || (remainder == halfway && (result & 1u))) ++result;
+            return static_cast<std::uint16_t>(sign | result);
+        }
+
+        // Normal result, rebias exponent & round mantissa from 23 to 10 bits
+        const std::uint32_t rebiased = abs - (112u << 23);
+        return static_cast<std::uint16_t>(sign | ((rebiased + 0x0fffu + ((rebiased >> 13) & 1u)) >> 13));
+    }
+
+    [[nodiscard]] static float to_float(std::uint16_t bits) noexcept {
+        const std::uint32_t sign     = (static_cast<std::uint32_t>(bits) & 0x8000u) << 16;
+        const std::uint32_t exponent = (bits >> 10) & 0x1fu;
+        const std::uint32_t mantissa = bits & 0x03ffu;
+
+        if (exponent == 0x1fu) return _bits_to_float(sign | 0x7f800000u | (mantissa << 13)); // inf & NaN
+        if (exponent == 0) {
+            const float subnormal = static_cast<float>(mantissa) * 5.9604644775390625e-8f; // mantissa * 2^-24
+            return sign ? -subnormal : subnormal;
+        }
+        return _bits_to_float(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    }
+};
+
+template <class Format>
+class _reduced_float {
+    std::uint16_t _bits = 0;
+
+public:
+    constexpr _reduced_float() noexcept = default;
+
+    template <class U, std::enable_if_t<std::is_arithmetic_v<U>, bool> = true>
+    explicit _reduced_float(U value) noexcept : _bits(Format::from_float(static_cast<float>(value))) {}
+
+    operator float() const noexcept { return Format::to_float(this->_bits); }
+
+    [[nodiscard]] static _reduced_float from_bits(std::uint16_t bits) noexcept {
+        _reduced_float res;
+        res._bits = bits;
+        return res;
+    }
+
+    [[nodiscard]] std::uint16_t bits() const noexcept { return this->_bits; }
+
+    // - Arithmetic -
+    _reduced_float& operator+=(float other) noexcept { return *this = _reduced_float(float(*this) + other); }
+    _reduced_float& operator-=(float other) noexcept { return *this = _reduced_float(float(*this) - other); }
+    _reduced_float& operator*=(float other) noexcept { return *this = _reduced_float(float(*this) * other); }
+    _reduced_float& operator/=(float other) noexcept { return *this = _reduced_float(float(*this) / other); }
+
+    friend _reduced_float operator+(_reduced_float l, _reduced_float r) noexcept { return l += r; }
+    friend _reduced_float operator-(_reduced_float l, _reduced_float r) noexcept { return l -= r; }
+    friend _reduced_float operator*(_reduced_float l, _reduced_float r) noexcept { return l *= r; }
+    friend _reduced_float operator/(_reduced_float l, _reduced_float r) noexcept { return l /= r; }
+
+    friend _reduced_float operator+(_reduced_float x) noexcept { return x; }
+    friend _reduced_float operator-(_reduced_float x) noexcept { return from_bits(x._bits ^ 0x8000u); }
+
+    // Comparison goes through implicit conversion to 'float', which gives correct semantics for zeroes & NaNs
+};
+
+using bfloat16 = _reduced_float<_bfloat16_format>;
+using float16  = _reduced_float<_float16_format>;
+
 // =======================
 // --- Utility Classes ---
 // =======================
@@ -591,10 +933,10 @@ struct SparseEntry2D {
     constexpr static bool is_sparse_entry_2d = true;
 
     [[nodiscard]] bool operator<(const SparseEntry2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
+        return (this->i < other.i) || (this->i == other.i && this->j < other.j);
     }
     [[nodiscard]] bool operator>(const SparseEntry2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
+        return (this->i > other.i) || (this->i == other.i && this->j > other.j);
     }
 };
 
@@ -603,10 +945,10 @@ struct Index2D {
     size_t j;
 
     [[nodiscard]] bool operator<(const Index2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
+        return (this->i < other.i) || (this->i == other.i && this->j < other.j);
     }
     [[nodiscard]] bool operator>(const Index2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
+        return (this->i > other.i) || (this->i == other.i && this->j > other.j);
     }
     [[nodiscard]] bool operator==(const Index2D& other) const noexcept {
         return (this->i == other.i) && (this->j == other.j);
@@ -775,7 +1117,7 @@ template <utl_mvl_tensor_arg_defs>
 struct _2d_dense_data {
 private:
     using value_type = typename _types<T>::value_type;
-    using _data_t    = _choose_based_on_ownership<_ownership, std::unique_ptr<value_type[]>, _observer_ptr<value_type>,
+    using _data_t    = _choose_based_on_ownership<_ownership, _unique_array<value_type>, _observer_ptr<value_type>,
                                                _observer_ptr<const value_type>>;
 
 public:
@@ -796,6 +1138,15 @@ struct _2d_sparse_data {
     std::vector<triplet_type> _data;
 };
 
+// Index bounds of lazy views, declared early since tensors create lazy views of themselves
+struct _lazy_bounds {
+    std::size_t row_low;
+    std::size_t row_high;
+    std::size_t col_low;
+    std::size_t col_high;
+    bool        diagonal_only;
+};
+
 // ===================
 // --- Tensor Type ---
 // ===================
@@ -1155,13 +1506,14 @@ class GenericTensor
     utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] size_type
         _search_ij(size_type i, size_type j) const noexcept {
         // Returns this->size() if {i, j} wasn't found.
-        // Linear search for small .size() (more efficient fue to prediction and cache locality)
-        if (true) {
-            for (size_type idx = 0; idx < this->size(); ++idx)
-                if (this->_data[idx].i == i && this->_data[idx].j == j) return idx;
-            return this->size();
-        }
-        // TODO: Binary search for larger .size() (N(log2(size)) instead of N(size) asymptotically)
+        // Triplets are always kept sorted lexicographically, which allows binary search.
+        const auto less = [](const sparse_entry_type& entry, const Index2D& index) -> bool {
+            return (entry.i < index.i) || (entry.i == index.i && entry.j < index.j);
+        };
+
+        const auto it = std::lower_bound(this->_data.begin(), this->_data.end(), Index2D{i, j}, less);
+        if (it == this->_data.end() || it->i != i || it->j != j) return this->size();
+        return static_cast<size_type>(it - this->_data.begin());
     }
 
 public:
@@ -1188,12 +1540,17 @@ class GenericTensor
 
     // --- Reductions ---
     // ------------------
+    // '.for_each()' is used instead of iterators since it has a fast path for strided matrices
     utl_mvl_reqs(_has_binary_op_plus<value_type>::value) [[nodiscard]] value_type sum() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type());
+        value_type res = value_type();
+        this->for_each([&](const_reference elem) { res = std::move(res) + elem; });
+        return res;
     }
 
     utl_mvl_reqs(_has_binary_op_multiplies<value_type>::value) [[nodiscard]] value_type product() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type(), std::multiplies<value_type>());
+        value_type res = value_type(1);
+        this->for_each([&](const_reference elem) { res = std::move(res) * elem; });
+        return res;
     }
 
     utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] value_type min() const {
@@ -1255,29 +1612,77 @@ class GenericTensor
         return !this->true_for_any(inversed_predicate);
     }
 
+    // --- Iteration kernels ---
+    // -------------------------
+private:
+    // Visits elements with flat indices [low, high) in order, calling 'func(elem, idx, i, j)'.
+    //
+    // Dense & strided matrices get traversed one major line (row for RC, column for CR) at a time with plain
+    // pointer increments, this avoids 'idx -> { i, j }' division & modulo on every element. When elements of a
+    // line are contiguous (all dense matrices, blocks and rows of RC matrices, blocks and columns of CR matrices)
+    // the inner loop is a simple linear pass that compilers can vectorize. Sparse tensors just walk their triplets.
+    //
+    // Implemented as a static template so that const & non-const versions can share the code.
+    template <class Self, class Func>
+    static void _for_each_in_range(Self& tensor, size_type low, size_type high, Func&& func) {
+        if constexpr (self::params::type == Type::SPARSE) {
+            for (size_type idx = low; idx < high; ++idx)
+                func(tensor[idx], idx, tensor._data[idx].i, tensor._data[idx].j);
+        } else {
+            constexpr bool is_rc = (self::params::layout == Layout::RC);
+
+            const size_type minor_extent = tensor.extent_minor();
+            if (low >= high || minor_extent == 0) return;
+
+            const size_type minor_step = is_rc ? tensor.col_stride() : tensor.row_stride();
+            const size_type major_skip = is_rc ? tensor.row_stride() : tensor.col_stride();
+            const size_type major_step = minor_extent * minor_step + major_skip;
+            const auto      data       = tensor.data();
+
+            const auto visit = [&](auto& elem, size_type idx, size_type major, size_type minor) {
+                if constexpr (is_rc) func(elem, idx, major, minor);
+                else func(elem, idx, minor, major);
+            };
+
+            size_type major = low / minor_extent;
+            size_type minor = low % minor_extent;
+
+            for (size_type idx = low; idx < high; ++major, minor = 0) {
+                const size_type line_end = std::min(minor_extent, minor + (high - idx));
+                const auto      line     = data + major * major_step;
+
+                if (minor_step == 1) {
+                    for (size_type n = minor; n < line_end; ++n, ++idx) visit(line[n], idx, major, n);
+                } else {
+                    for (size_type n = minor; n < line_end; ++n, ++idx) visit(line[n * minor_step], idx, major, n);
+                }
+            }
+        }
+    }
+
+public:
     // --- Const algorithms ---
     // ------------------------
     template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
     const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](const_reference elem, size_type, size_type, size_type) { func(elem); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
     const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](const_reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
               utl_mvl_require(dimension == Dimension::MATRIX)>
     const self& for_each(FuncType func) const {
-        // Loop over all 2D indices using 1D loop with idx->ij conversion.
-        // This is just as fast and ensures looping only over existing elements in non-dense matrices.
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
-        }
+        // Loop over all 2D indices, for sparse matrices this ensures looping only over existing elements
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](const_reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
         return *this;
     }
 
@@ -1286,24 +1691,24 @@ class GenericTensor
     template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
               utl_mvl_require(ownership != Ownership::CONST_VIEW)>
     self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](reference elem, size_type, size_type, size_type) { func(elem); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
               utl_mvl_require(ownership != Ownership::CONST_VIEW)>
     self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
               utl_mvl_require(dimension == Dimension::MATRIX)>
     self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
-        }
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
         return *this;
     }
 
@@ -1375,6 +1780,116 @@ class GenericTensor
         return *this;
     }
 
+    // --- Parallel algorithms ---
+    // ---------------------------
+
+    // Same as regular algorithms, except the tensor gets split into contiguous chunks of elements that are
+    // processed by different threads (see notes on '_parallel_for()'). 'func' has to be safe to call concurrently.
+    // Since the split is static, repeated calls process the same elements on the same threads, which allows
+    // initializing large tensors with '.parallel_fill()' (or constructing them with 'parallel_init') to take advantage
+    // of NUMA first-touch policy.
+private:
+    constexpr static size_type _parallel_min_grain = 1 << 16;
+
+    template <class Self, class Func>
+    static void _parallel_for_each_in_range(Self& tensor, Func&& func) {
+        _parallel_for(tensor.size(), _parallel_min_grain,
+                      [&](size_type low, size_type high) { _for_each_in_range(tensor, low, high, func); });
+    }
+
+public:
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
+    const self& parallel_for_each(FuncType func) const {
+        _parallel_for_each_in_range(*this, [&](const_reference elem, size_type, size_type, size_type) { func(elem); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
+    const self& parallel_for_each(FuncType func) const {
+        _parallel_for_each_in_range(
+            *this, [&](const_reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    const self& parallel_for_each(FuncType func) const {
+        _parallel_for_each_in_range(
+            *this, [&](const_reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_for_each(FuncType func) {
+        _parallel_for_each_in_range(*this, [&](reference elem, size_type, size_type, size_type) { func(elem); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_for_each(FuncType func) {
+        _parallel_for_each_in_range(*this,
+                                    [&](reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& parallel_for_each(FuncType func) {
+        _parallel_for_each_in_range(*this,
+                                    [&](reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(elem); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& parallel_transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(elem, i); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType,
+              _has_signature_enable_if<FuncType, value_type(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& parallel_transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(elem, i, j); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) self& parallel_fill(const_reference value) {
+        const auto func_wrapper = [&](reference elem) { elem = value; };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type()> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& parallel_fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(i); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& parallel_fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(i, j); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
     // --- Sparse Subviews ---
     // -----------------------
 
@@ -1606,6 +2121,44 @@ class GenericTensor
         return this->block(0, j, this->rows(), 1);
     }
 
+    // --- Lazy Subviews ---
+    // ---------------------
+
+    // Same as '.filter()', '.diagonal()' and '.block()', but matching elements are found when the view gets
+    // iterated instead of being collected into a triplet array, see 'LazyView' for details
+
+    // - Const views -
+    template <class UnaryPredicate, utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] auto lazy_filter(UnaryPredicate predicate) const {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this)).filter(std::move(predicate));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] auto lazy_diagonal() const {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this, true));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] auto
+        lazy_block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) const {
+        return _make_lazy_view(*this, _lazy_block_bounds(*this, block_i, block_j, block_rows, block_cols));
+    }
+
+    // - Mutable views -
+    template <class UnaryPredicate,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    [[nodiscard]] auto lazy_filter(UnaryPredicate predicate) {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this)).filter(std::move(predicate));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] auto
+        lazy_diagonal() {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this, true));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] auto
+        lazy_block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) {
+        return _make_lazy_view(*this, _lazy_block_bounds(*this, block_i, block_j, block_rows, block_cols));
+    }
+
     // --- Sparse operations ---
     // -------------------------
 
@@ -1628,26 +2181,26 @@ class GenericTensor
 
     utl_mvl_reqs(dimension == Dimension::MATRIX &&
                  type == Type::SPARSE) self& insert_triplets(const std::vector<sparse_entry_type>& triplets) {
-        // Bulk-insert triplets and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
+        // Bulk-insert triplets while keeping them sorted by index. Existing triplets are already sorted,
+        // so we only need to sort the inserted ones and merge both ranges => O(N + K log K) instead of
+        // re-sorting everything on each insertion.
+        const auto old_size = static_cast<difference_type>(this->_data.size());
 
         this->_data.insert(this->_data.end(), triplets.begin(), triplets.end());
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+
+        const auto middle = this->_data.begin() + old_size;
+        if (!std::is_sorted(middle, this->_data.end())) std::sort(middle, this->_data.end());
+        std::inplace_merge(this->_data.begin(), middle, this->_data.end());
 
         return *this;
     }
 
     utl_mvl_reqs(dimension == Dimension::MATRIX &&
                  type == Type::SPARSE) self& rewrite_triplets(std::vector<sparse_entry_type>&& triplets) {
-        // Move-construct all triplets at once and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
-
+        // Move-construct all triplets at once and sort by index (unless they are already sorted,
+        // which is the case for triplets produced by other sparse matrices or 'SparseMatrixBuilder')
         this->_data = std::move(triplets);
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+        if (!std::is_sorted(this->_data.begin(), this->_data.end())) std::sort(this->_data.begin(), this->_data.end());
 
         return *this;
     }
@@ -1656,30 +2209,27 @@ class GenericTensor
                  type == Type::SPARSE) self& erase_triplets(std::vector<Index2D> indices) {
         // Erase triplets with {i, j} from 'indices' using the fact that both
         // 'indices' and triplets are sorted. We can scan through triplets once
-        // while advancing 'cursor' when 'indices[cursor]' gets deleted, which
-        // result in all necessary triplets being marked for erasure in order.
+        // while advancing 'cursor' past indices that are behind the current triplet,
+        // which result in all necessary triplets being marked for erasure in order.
         std::sort(indices.begin(), indices.end());
         std::size_t cursor = 0;
 
         const auto erase_condition = [&](const sparse_entry_type& triplet) -> bool {
+            const Index2D index{triplet.i, triplet.j};
+            while (cursor < indices.size() && indices[cursor] < index) ++cursor;
             /* Stop erasing once all target indices are handled */
             if (cursor == indices.size()) return false;
-            if (indices[cursor].i == triplet.i && indices[cursor].j == triplet.j) {
+            if (indices[cursor] == index) {
                 ++cursor;
                 return true;
             }
             return false;
         };
 
+        // 'std::remove_if()' is stable, triplets stay sorted
         const auto iter = std::remove_if(this->_data.begin(), this->_data.end(), erase_condition);
         this->_data.erase(iter, this->_data.end());
 
-        // Re-sort triplets just in case
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
-
         return *this;
     }
 
@@ -1707,17 +2257,23 @@ class GenericTensor
     // Copy-assignment
     self& operator=(const self& other) {
         // Note: copy-assignment operator CANNOT be templated, it has to be implemented with 'if constexpr'
+        if (this == &other) return *this;
+
+        // Dense containers reuse existing buffer of the same size, copying into preallocated matrices doesn't allocate
+        bool reuse_buffer = false;
+        if constexpr (self::params::type == Type::DENSE) reuse_buffer = this->_data && this->size() == other.size();
+
         this->_rows = other.rows();
         this->_cols = other.cols();
         if constexpr (self::params::type == Type::DENSE) {
-            this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+            if (!reuse_buffer) this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
             std::copy(other.begin(), other.end(), this->begin());
         }
         if constexpr (self::params::type == Type::STRIDED) {
             this->_row_stride = other.row_stride();
             this->_col_stride = other.col_stride();
-            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-            std::copy(other.begin(), other.end(), this->begin());
+            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+            other.for_each([&](const_reference elem, size_type i, size_type j) { this->operator()(i, j) = elem; });
         }
         if constexpr (self::params::type == Type::SPARSE) { this->_data = other._data; }
         return *this;
@@ -1754,12 +2310,12 @@ class GenericTensor
         this->_rows       = other.rows();
         this->_cols       = other.cols();
         this->_row_stride = other.row_stride();
-        this->_col_strude = other.col_stride();
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value_type());
+        this->_col_stride = other.col_stride();
         // Not quite sure whether swapping strides when changing layouts like this is okay,
         // but it seems to be correct
-        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_cols_stride);
+        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_col_stride);
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->fill(value_type());
         other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
         return *this;
         // copying from sparse to strided works, all elements that weren't in the sparse matrix remain
@@ -1853,6 +2409,15 @@ class GenericTensor
         this->fill(value);
     }
 
+    // Init-with-value in parallel, see notes on '.parallel_fill()'
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
+        GenericTensor(size_type rows, size_type cols, const_reference value, ParallelInit) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->parallel_fill(value);
+    }
+
     // Init-with-lambda
     template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
                                               ownership == Ownership::CONTAINER)>
@@ -1950,6 +2515,18 @@ class GenericTensor
         this->fill(value);
     }
 
+    // Init-with-value in parallel, see notes on '.parallel_fill()'
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+        GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                      const_reference value, ParallelInit) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->parallel_fill(value);
+    }
+
     // Init-with-lambda
     template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
                                               ownership == Ownership::CONTAINER)>
@@ -2111,487 +2688,3249 @@ template <class T, Checking checking = _default_checking>
 using ConstSparseMatrixView =
     GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONST_VIEW, checking, Layout::SPARSE>;
 
-// ==================
-// --- Formatters ---
-// ==================
+// ==============================
+// --- Sparse matrix assembly ---
+// ==============================
 
-namespace format {
+// Compressed sparse row format, a more compact sparse representation that stores column indices
+// and values of each row contiguously, while rows are described by offsets into these arrays:
+//
+//    row 'i' occupies [ row_offsets[i], row_offsets[i + 1] ) range of 'col_indices' and 'values'
+//
+// Unlike 'SparseMatrix' it is not a part of the 'GenericTensor' API and is intended mostly as a
+// format for interop and kernels that benefit from direct access to rows.
+template <class T>
+class CSRMatrix {
+public:
+    using self            = CSRMatrix;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
 
-// --- Implementation ---
-// ----------------------
+private:
+    size_type               _rows        = 0;
+    size_type               _cols        = 0;
+    std::vector<size_type>  _row_offsets = {0};
+    std::vector<size_type>  _col_indices;
+    std::vector<value_type> _values;
 
-// The "header" of all human-readable formats that displays
-// some meta info with tensor type and dimensions.
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    std::string buffer;
+public:
+    CSRMatrix() = default;
+
+    explicit CSRMatrix(size_type rows, size_type cols, std::vector<size_type> row_offsets,
+                       std::vector<size_type> col_indices, std::vector<value_type> values)
+        : _rows(rows), _cols(cols), _row_offsets(std::move(row_offsets)), _col_indices(std::move(col_indices)),
+          _values(std::move(values)) {
+        if (this->_row_offsets.size() != rows + 1)
+            throw std::invalid_argument(stringify("CSR row offsets should have rows + 1 (which is ", rows + 1,
+                                                  ") elements, got ", this->_row_offsets.size(), "."));
+        if (this->_col_indices.size() != this->_values.size() || this->_row_offsets.back() != this->_values.size())
+            throw std::invalid_argument("CSR column indices, values and row offsets don't match in size.");
+    }
+
+    // Conversion from any 2D tensor, dense tensors only keep their non-default-initialized elements
+    template <class Tensor, _is_tensor_enable_if<Tensor> = true>
+    explicit CSRMatrix(const Tensor& tensor) {
+        // Sparse tensors always keep their triplets sorted, other tensors have to be sorted first
+        if constexpr (std::decay_t<Tensor>::params::type == Type::SPARSE) this->_assign_from_sorted(tensor);
+        else this->_assign_from_sorted(SparseMatrix<value_type>(tensor));
+    }
+
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+    [[nodiscard]] size_type size() const noexcept { return this->_values.size(); }
+    [[nodiscard]] bool      empty() const noexcept { return this->size() == 0; }
+
+    [[nodiscard]] const std::vector<size_type>&  row_offsets() const noexcept { return this->_row_offsets; }
+    [[nodiscard]] const std::vector<size_type>&  col_indices() const noexcept { return this->_col_indices; }
+    [[nodiscard]] const std::vector<value_type>& values() const noexcept { return this->_values; }
+    [[nodiscard]] std::vector<value_type>&       values() noexcept { return this->_values; }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type i = 0; i < this->rows(); ++i)
+            for (size_type k = this->_row_offsets[i]; k < this->_row_offsets[i + 1]; ++k)
+                func(this->_values[k], i, this->_col_indices[k]);
+        return *this;
+    }
 
-    if constexpr (_type == Type::DENSE) buffer += "Dense";
-    if constexpr (_type == Type::STRIDED) buffer += "Strided";
-    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
-    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
-    if constexpr (_dimension == Dimension::MATRIX)
-        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
+    [[nodiscard]] SparseMatrix<value_type> to_sparse() const {
+        std::vector<SparseEntry2D<value_type>> triplets;
+        triplets.reserve(this->size());
+        this->for_each([&](const_reference value, size_type i, size_type j) { triplets.push_back({i, j, value}); });
+        return SparseMatrix<value_type>(this->rows(), this->cols(), std::move(triplets));
+    }
 
-    return buffer;
-}
+    // Lazy views only visit rows inside the bounds, see 'LazyView'
+    template <class UnaryPredicate>
+    [[nodiscard]] auto lazy_filter(UnaryPredicate predicate) const {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this)).filter(std::move(predicate));
+    }
 
-// Human-readable formats automatically collapse matrices
-// that are too  large to be reasonably parsed by a human
-constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+    [[nodiscard]] auto lazy_diagonal() const { return _make_lazy_view(*this, _lazy_full_bounds(*this, true)); }
 
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+    [[nodiscard]] auto lazy_block(size_type block_i, size_type block_j, size_type block_rows,
+                                  size_type block_cols) const {
+        return _make_lazy_view(*this, _lazy_block_bounds(*this, block_i, block_j, block_rows, block_cols));
+    }
+
+private:
+    template <class SortedTensor>
+    void _assign_from_sorted(const SortedTensor& tensor) {
+        this->_rows = tensor.rows();
+        this->_cols = tensor.cols();
+        this->_row_offsets.assign(this->rows() + 1, 0);
+        this->_col_indices.clear();
+        this->_values.clear();
+        this->_col_indices.reserve(tensor.size());
+        this->_values.reserve(tensor.size());
+
+        tensor.for_each([&](const_reference value, size_type i, size_type j) {
+            ++this->_row_offsets[i + 1];
+            this->_col_indices.push_back(j);
+            this->_values.push_back(value);
+        });
+
+        for (size_type i = 0; i < this->rows(); ++i) this->_row_offsets[i + 1] += this->_row_offsets[i];
+    }
+};
+
+// LSD radix sort of sparse entries by their linearized index 'i * cols + j', which is the same thing as
+// lexicographic order of { i, j }. Only as many 11-bit digits as needed to represent the largest index get
+// sorted, for a 10^6 x 10^6 matrix that is 4 passes over the data regardless of the entry count.
+//
+// Each pass is parallelized the usual way: every chunk builds a local histogram, histograms get combined
+// into per-chunk offsets (digit-major, chunk-minor, which keeps the sort stable) and then every chunk scatters
+// its entries independently.
+template <class Entry>
+void _radix_sort_sparse_entries(std::vector<Entry>& entries, std::size_t rows, std::size_t cols) {
+    constexpr std::size_t digit_bits = 11;
+    constexpr std::size_t radix      = std::size_t(1) << digit_bits;
+    constexpr std::size_t digit_mask = radix - 1;
+    constexpr std::size_t min_grain  = 1 << 16;
+
+    // Linearized index doesn't fit into 'std::size_t', fallback onto comparison sort
+    if (cols != 0 && rows > std::numeric_limits<std::size_t>::max() / cols) {
+        std::stable_sort(entries.begin(), entries.end());
+        return;
+    }
+
+    const auto key = [&](const Entry& entry) -> std::size_t { return entry.i * cols + entry.j; };
+
+    std::size_t max_key = 0;
+    for (const auto& entry : entries) max_key = std::max(max_key, key(entry));
+
+    std::size_t key_bits = 0;
+    while (key_bits < std::numeric_limits<std::size_t>::digits && (max_key >> key_bits) != 0) ++key_bits;
+
+    const std::size_t passes      = (key_bits + digit_bits - 1) / digit_bits;
+    const std::size_t size        = entries.size();
+    const std::size_t chunk_count = std::clamp<std::size_t>(size / min_grain, 1, _max_thread_count());
+    const auto        chunk_low   = [&](std::size_t c) { return size * c / chunk_count; };
+
+    std::vector<Entry>                          buffer(size);
+    std::vector<std::array<std::size_t, radix>> histograms(chunk_count);
+
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        const std::size_t shift = pass * digit_bits;
+        const auto        digit = [&](const Entry& entry) { return (key(entry) >> shift) & digit_mask; };
+
+        _parallel_for(chunk_count, 1, [&](std::size_t low, std::size_t high) {
+            for (std::size_t c = low; c < high; ++c) {
+                histograms[c].fill(0);
+                for (std::size_t idx = chunk_low(c); idx < chunk_low(c + 1); ++idx)
+                    ++histograms[c][digit(entries[idx])];
+            }
+        });
+
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < radix; ++d) {
+            for (std::size_t c = 0; c < chunk_count; ++c) {
+                const std::size_t count = histograms[c][d];
+                histograms[c][d]        = offset;
+                offset += count;
+            }
+        }
+
+        _parallel_for(chunk_count, 1, [&](std::size_t low, std::size_t high) {
+            for (std::size_t c = low; c < high; ++c)
+                for (std::size_t idx = chunk_low(c); idx < chunk_low(c + 1); ++idx)
+                    buffer[histograms[c][digit(entries[idx])]++] = std::move(entries[idx]);
+        });
+
+        std::swap(entries, buffer);
+    }
 }
 
-// Generic method to do "dense matrix print" with given delimers.
-// Cuts down on repitition since a lot of formats only differ in the delimers used.
-template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
-[[nodiscard]] std::string
-_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,      //
-                      std::string_view                                                              begin,       //
-                      std::string_view                                                              row_begin,   //
-                      std::string_view                                                              col_delimer, //
-                      std::string_view                                                              row_end,     //
-                      std::string_view                                                              row_delimer, //
-                      std::string_view                                                              end,         //
-                      Func                                                                          stringifier  //
-) {
-    if (tensor.empty()) return (std::string() += begin) += end;
+// Builder for assembling large sparse matrices from (possibly duplicate) contributions, a typical case being
+// FEM assembly where each element adds its local matrix into a global one. Contributions get accumulated
+// in per-thread buffers, which means '.add()' can be called concurrently from any number of threads without
+// contention. Once all contributions are added, '.build()' sorts them with a parallel radix sort, sums up
+// duplicates and emits a sorted sparse matrix in a single pass.
+//
+// Per-thread buffers are found through a 'thread_local' cache, so only the first '.add()' from each thread
+// has to lock a mutex. Buffers keep their capacity after '.build()', repeated assembly (like re-assembling
+// the same system every time step) doesn't allocate after the first iteration.
+template <class T>
+class SparseMatrixBuilder {
+public:
+    using self            = SparseMatrixBuilder;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+    using entry_type      = SparseEntry2D<value_type>;
 
-    Matrix<std::string> strings(tensor.rows(), tensor.cols());
+private:
+    using _buffer_type = std::vector<entry_type>;
 
-    // Stringify
-    if constexpr (type == Type::SPARSE) strings.fill("-");
-    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
-    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
-    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
+    size_type     _rows = 0;
+    size_type     _cols = 0;
+    std::uint64_t _id   = 0; // unique id, guards thread-local caches against builders reusing the same address
 
-    // Get column widths - we want matrix to format nice and aligned
-    std::vector<std::size_t> column_widths(strings.cols(), 0);
-    for (std::size_t i = 0; i < strings.rows(); ++i)
-        for (std::size_t j = 0; j < strings.cols(); ++j)
-            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
+    mutable std::mutex                                                     _mutex;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<_buffer_type>>> _buffers;
 
-    // Format with proper alignment
-    std::string buffer(begin);
-    for (std::size_t i = 0; i < strings.rows(); ++i) {
-        buffer += row_begin;
-        for (std::size_t j = 0; j < strings.cols(); ++j) {
-            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
-            buffer += strings(i, j);
-            if (j + 1 < strings.cols()) buffer += col_delimer;
+    inline static std::atomic<std::uint64_t> _id_counter{0};
+
+    [[nodiscard]] _buffer_type& _local_buffer() {
+        thread_local std::uint64_t cached_id     = 0;
+        thread_local _buffer_type* cached_buffer = nullptr;
+
+        if (cached_id == this->_id) return *cached_buffer;
+
+        const std::lock_guard lock(this->_mutex);
+
+        const auto thread_id = std::this_thread::get_id();
+        auto       it        = std::find_if(this->_buffers.begin(), this->_buffers.end(),
+                                            [&](const auto& buffer) { return buffer.first == thread_id; });
+        if (it == this->_buffers.end()) {
+            this->_buffers.emplace_back(thread_id, std::make_unique<_buffer_type>());
+            it = std::prev(this->_buffers.end());
         }
-        buffer += row_end;
-        if (i + 1 < strings.rows()) buffer += row_delimer;
+
+        cached_id     = this->_id;
+        cached_buffer = it->second.get();
+        return *cached_buffer;
     }
-    buffer += end;
 
-    return buffer;
-}
+    [[nodiscard]] std::vector<entry_type> _assemble() {
+        const std::lock_guard lock(this->_mutex);
 
-// --- Human-readable formats ---
-// ------------------------------
+        size_type total_size = 0;
+        for (const auto& buffer : this->_buffers) total_size += buffer.second->size();
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+        std::vector<entry_type> entries;
+        entries.reserve(total_size);
+        for (auto& buffer : this->_buffers) {
+            entries.insert(entries.end(), std::make_move_iterator(buffer.second->begin()),
+                           std::make_move_iterator(buffer.second->end()));
+            buffer.second->clear();
+        }
 
-    std::string buffer = _tensor_meta_string(tensor);
+        _radix_sort_sparse_entries(entries, this->rows(), this->cols());
 
-    buffer += "  { ";
-    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
-        buffer += stringifier(tensor[idx]);
-        if (idx + 1 < tensor.size()) buffer += ", ";
+        // Sum up duplicates, sort is stable so contributions from each thread get summed in the order of addition
+        if (entries.empty()) return entries;
+
+        size_type last = 0;
+        for (size_type idx = 1; idx < entries.size(); ++idx) {
+            if (entries[idx].i == entries[last].i && entries[idx].j == entries[last].j)
+                entries[last].value += entries[idx].value;
+            else entries[++last] = std::move(entries[idx]);
+        }
+        entries.resize(last + 1);
+
+        return entries;
     }
-    buffer += " }\n";
 
-    return buffer;
-}
+public:
+    explicit SparseMatrixBuilder(size_type rows, size_type cols) : _rows(rows), _cols(cols), _id(++_id_counter) {}
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                        Func                                          stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+    SparseMatrixBuilder(const self&)            = delete;
+    SparseMatrixBuilder& operator=(const self&) = delete;
 
-    std::string buffer = _tensor_meta_string(tensor);
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
 
-    if constexpr (_dimension == Dimension::MATRIX) {
-        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
-            buffer += stringify("(", i, ", ", j, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
-    } else {
-        tensor.for_each([&](const T& elem, std::size_t i) {
-            buffer += stringify("(", i, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
+    // Thread-safe
+    self& add(size_type i, size_type j, const_reference value) {
+        utl_mvl_assert(i < this->rows() && j < this->cols());
+        this->_local_buffer().push_back({i, j, value});
+        return *this;
     }
 
-    return buffer;
-}
+    // Thread-safe, reserves space in the buffer of the calling thread
+    self& reserve(size_type count) {
+        this->_local_buffer().reserve(count);
+        return *this;
+    }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+    // Not thread-safe relative to '.add()'
+    [[nodiscard]] size_type contributions() const {
+        const std::lock_guard lock(this->_mutex);
 
-    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
-}
+        size_type total_size = 0;
+        for (const auto& buffer : this->_buffers) total_size += buffer.second->size();
+        return total_size;
+    }
 
-// --- Export formats ---
-// ----------------------
+    self& clear() {
+        const std::lock_guard lock(this->_mutex);
+        for (auto& buffer : this->_buffers) buffer.second->clear();
+        return *this;
+    }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
+    // Not thread-safe relative to '.add()', builder is left empty and can be reused
+    [[nodiscard]] SparseMatrix<value_type> build() {
+        return SparseMatrix<value_type>(this->rows(), this->cols(), this->_assemble());
+        // triplets are already sorted, matrix constructor will only verify it
+    }
+
+    [[nodiscard]] CSRMatrix<value_type> build_csr() { return CSRMatrix<value_type>(this->build()); }
+};
+
+// ======================
+// --- Random tensors ---
+// ======================
+
+// Modules are supposed to stay independent, so instead of depending on 'utl::random' these functions take
+// the generator type & distribution as template parameters, any standard-compatible ones will work.
+//
+// Work is split into fixed blocks of elements (or rows for sparse matrices), every block gets a fresh copy of
+// the distribution & its own generator seeded with a hash of '{ seed, block }'. Results depend only on the seed
+// and not on the number of threads, generators with expensive seeding (like 'std::mt19937') get amortized over
+// the whole block.
+
+constexpr std::size_t _random_block_size       = 1 << 12; // elements per generator
+constexpr std::size_t _random_sparse_block_rows = 1 << 6;  // sparse rows per generator
+constexpr std::size_t _random_sparse_linear_nnz = 1 << 5;  // rows up to this size check picks with a linear scan
+
+// SplitMix64 finalizer over the block index, neighbouring blocks get unrelated seeds
+[[nodiscard]] constexpr std::uint64_t _random_block_seed(std::uint64_t seed, std::uint64_t block) noexcept {
+    std::uint64_t z = seed + (block + 1) * 0x9E3779B97F4A7C15u;
+    z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z               = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
+// Seeding through 'std::seed_seq' passes all 64 bits of the block seed to 32-bit generators as well
+template <class Gen>
+[[nodiscard]] Gen _make_block_generator(std::uint64_t seed, std::uint64_t block) {
+    const std::uint64_t block_seed = _random_block_seed(seed, block);
+    std::seed_seq       seq{static_cast<std::uint32_t>(block_seed), static_cast<std::uint32_t>(block_seed >> 32)};
+    return Gen(seq);
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
+// 'std::uniform_int_distribution<>' uses a different algorithm in every standard library, which would make sparse
+// patterns platform-dependent. Instead we take raw generator output, rejecting values of generators with a range that
+// isn't a power of 2 (like 'std::minstd_rand'), and reduce it to '[0, bound)' with rejection on the remainder.
+template <class Gen>
+[[nodiscard]] constexpr int _random_bits_per_call() noexcept {
+    constexpr auto range = static_cast<std::uint64_t>(Gen::max() - Gen::min());
+    if (range == std::numeric_limits<std::uint64_t>::max()) return 64;
+
+    int bits = 0;
+    while (bits < 63 && (std::uint64_t(2) << bits) - 1 <= range) ++bits;
+    return bits; // largest 'bits' with '2^bits - 1 <= range'
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                         Func                                          stringifier = Func()) {
-    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
+template <class Gen>
+[[nodiscard]] std::uint64_t _random_uint64(Gen& gen) {
+    constexpr int bits = _random_bits_per_call<Gen>();
+    static_assert(bits > 0, "Generator should produce at least 1 random bit per call.");
+
+    if constexpr (bits == 64) {
+        return static_cast<std::uint64_t>(gen() - Gen::min());
+    } else {
+        std::uint64_t res = 0;
+        for (int filled = 0; filled < 64; filled += bits) {
+            std::uint64_t x{};
+            do { x = static_cast<std::uint64_t>(gen() - Gen::min()); } while (x >> bits);
+            res = (res << bits) | x;
+        }
+        return res;
+    }
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
-                                 stringifier);
+template <class Gen>
+[[nodiscard]] std::uint64_t _random_index(Gen& gen, std::uint64_t bound) {
+    std::uint64_t x{}, r{};
+    do {
+        x = _random_uint64(gen);
+        r = x % bound;
+    } while (x - r > std::uint64_t(0) - bound); // 'x' fell into the last incomplete group of 'bound' values
+    return r;
 }
 
+// Fills all elements of a tensor with values of 'dist', sparse tensors refill values of their existing entries
+template <class Gen, class Tensor, class Dist, _is_tensor_enable_if<Tensor> = true>
+void fill_random(Tensor&& tensor, const Dist& dist, std::uint64_t seed) {
+    using value_type = typename std::decay_t<Tensor>::value_type;
 
-} // namespace format
+    const std::size_t size   = tensor.size();
+    const std::size_t blocks = (size + _random_block_size - 1) / _random_block_size;
 
-// ================================
-// --- Linear algebra operators ---
-// ================================
+    _parallel_for(blocks, _min_grain(_random_block_size * 8), [&](std::size_t low, std::size_t high) {
+        for (std::size_t b = low; b < high; ++b) {
+            Gen  gen        = _make_block_generator<Gen>(seed, b);
+            Dist block_dist = dist;
 
-// --- Unary operator implementation ----
-// --------------------------------------
+            const std::size_t end = std::min(size, (b + 1) * _random_block_size);
+            for (std::size_t idx = b * _random_block_size; idx < end; ++idx)
+                tensor[idx] = static_cast<value_type>(block_dist(gen));
+        }
+    });
+}
 
-template <class L, class Op,                                                    //
-          _is_tensor_enable_if<L> = true,                                       //
-          class return_type       = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_unary_op(L&& left, Op&& op) {
-    using reference = typename std::decay_t<L>::reference;
+// Random sparse matrix with given number of non-zeros in each row, 'row_nnz(i)' should be deterministic.
+// Columns of each row are chosen with Floyd's algorithm, which takes exactly 'nnz' random numbers & never produces
+// duplicates, triplets get emitted in sorted order directly into their final positions. Floyd's algorithm only needs
+// to know which columns were already picked for the current row: short rows scan their own output, longer rows use
+// a hash set, which keeps the whole thing O(nnz) regardless of the number of columns.
+template <class Gen, class Dist, class RowNnz>
+[[nodiscard]] auto _random_sparse(std::size_t rows, std::size_t cols, RowNnz row_nnz, const Dist& dist,
+                                  std::uint64_t seed) {
+    using value_type = std::decay_t<decltype(std::declval<Dist&>()(std::declval<Gen&>()))>;
+
+    std::vector<std::size_t> offsets(rows + 1, 0);
+    for (std::size_t i = 0; i < rows; ++i) offsets[i + 1] = offsets[i] + row_nnz(i);
+
+    std::vector<SparseEntry2D<value_type>> triplets(offsets.back());
+
+    const std::size_t blocks      = (rows + _random_sparse_block_rows - 1) / _random_sparse_block_rows;
+    const std::size_t row_nnz_avg = offsets.back() / std::max<std::size_t>(rows, 1);
+    const std::size_t grain       = _min_grain(_random_sparse_block_rows * (row_nnz_avg + 1));
+
+    _parallel_for(blocks, grain, [&](std::size_t low, std::size_t high) {
+        std::unordered_set<std::size_t> taken; // only used by long rows, reused between them
+
+        for (std::size_t b = low; b < high; ++b) {
+            Gen  gen        = _make_block_generator<Gen>(seed, b);
+            Dist block_dist = dist;
+
+            const std::size_t end = std::min(rows, (b + 1) * _random_sparse_block_rows);
+            for (std::size_t i = b * _random_sparse_block_rows; i < end; ++i) {
+                const auto first = triplets.begin() + offsets[i], last = triplets.begin() + offsets[i + 1];
+                const auto nnz   = static_cast<std::size_t>(last - first);
+
+                auto       out   = first;
+                const auto floyd = [&](auto&& is_taken, auto&& take) {
+                    for (std::size_t j = cols - nnz; j < cols; ++j) {
+                        const auto        t      = static_cast<std::size_t>(_random_index(gen, j + 1));
+                        const std::size_t chosen = is_taken(t) ? j : t; // 'j' can't be taken yet, picks are below
+                        take(chosen);
+                        out->i = i, out->j = chosen, ++out;
+                    }
+                };
+
+                if (nnz <= _random_sparse_linear_nnz) {
+                    const auto is_taken = [&](std::size_t t) {
+                        return std::any_of(first, out, [&](const auto& entry) { return entry.j == t; });
+                    };
+                    floyd(is_taken, [](std::size_t) {});
+                } else {
+                    taken.clear();
+                    taken.reserve(nnz);
+                    floyd([&](std::size_t t) { return taken.count(t) != 0; }, [&](std::size_t c) { taken.insert(c); });
+                }
+
+                std::sort(first, last, [](const auto& l, const auto& r) { return l.j < r.j; });
+                for (auto it = first; it != last; ++it) it->value = block_dist(gen);
+            }
+        }
+    });
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+    return SparseMatrix<value_type>(rows, cols, std::move(triplets)); // already sorted, constructor will only verify
+}
 
-    // '.for_each()' takes care of possible sparsity
-    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
+// Exactly 'round(density * rows * cols)' non-zeros spread over the rows as evenly as possible
+template <class Gen, class Dist>
+[[nodiscard]] auto random_sparse(std::size_t rows, std::size_t cols, double density, const Dist& dist,
+                                 std::uint64_t seed) {
+    if (!(0. <= density && density <= 1.))
+        throw std::invalid_argument(stringify("Sparse matrix density should be in [0, 1] range, got ", density, "."));
 
-    return res;
+    const auto total = static_cast<std::size_t>(density * double(rows) * double(cols) + 0.5);
+    // Every row gets 'total / rows' non-zeros and the first 'total % rows' rows get one more, unlike interpolating
+    // 'i * total / rows' this can't overflow
+    const std::size_t base = rows ? total / rows : 0, extra = rows ? total % rows : 0;
+
+    return _random_sparse<Gen>(rows, cols, [&](std::size_t i) { return base + (i < extra); }, dist, seed);
 }
 
-// --- Unary operator API ----
-// ---------------------------
+template <class Gen, class Dist>
+[[nodiscard]] auto random_sparse_per_row(std::size_t rows, std::size_t cols, std::size_t nnz_per_row,
+                                         const Dist& dist, std::uint64_t seed) {
+    if (nnz_per_row > cols)
+        throw std::invalid_argument(
+            stringify("Can't place ", nnz_per_row, " non-zeros into a row with ", cols, " columns."));
 
-// std <functional> has function objects for every operator possible,
-// except unary '+' for some reason, which is why we have to implement it ourselves.
-// This is the exact same thing as 'std::negate<>' but for operator '+'.
-template <class T>
-struct _unary_plus_functor {
-    constexpr T operator()(const T& lhs) const { return +lhs; }
+    return _random_sparse<Gen>(rows, cols, [&](std::size_t) { return nnz_per_row; }, dist, seed);
+}
+
+// ==================
+// --- Lazy views ---
+// ==================
+
+// Sparse subviews ('.filter()', '.diagonal()', '.block()') materialize an array of reference triplets, which takes
+// a full pass over the matrix and an allocation per call, chaining them repeats it for every step. Lazy views
+// instead store a reference to the tensor, index bounds and a predicate, matching elements are found on the fly
+// when the view gets iterated. Chained filters get combined into a single predicate, so the whole chain still
+// costs a single pass with no allocation.
+//
+// Bounds get pushed down into the traversal:
+//    - dense & strided tensors only iterate over rows & cols inside the bounds (or just the diagonal);
+//    - sparse tensors keep triplets sorted, so the first triplet of each row range can be found with a binary
+//      search, triplets outside of column bounds are skipped with another binary search to the next row;
+//    - CSR matrices jump directly to the rows inside the bounds (CSR views are always const).
+//
+// Lazy views are only valid while the underlying tensor is alive and its sparsity pattern doesn't change.
+
+struct _lazy_accept_all {
+    template <class T>
+    constexpr bool operator()(const T&, std::size_t, std::size_t) const noexcept {
+        return true;
+    }
 };
 
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left) {
-    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
+// 'func(elem, i, j)' gets called for all elements inside the bounds, indices are the indices of the tensor
+template <class Tensor, class Func, _is_tensor_enable_if<Tensor> = true>
+void _lazy_traverse(Tensor& tensor, const _lazy_bounds& bounds, Func&& func) {
+    using tensor_type = std::remove_const_t<Tensor>;
+    using size_type   = typename tensor_type::size_type;
+
+    const size_type row_high = std::min(bounds.row_high, tensor.rows());
+    const size_type col_high = std::min(bounds.col_high, tensor.cols());
+
+    if constexpr (tensor_type::params::type == Type::SPARSE) {
+        const auto& entries = tensor.entries();
+
+        // First triplet with '{ i, j } >= { row, col }' at or after 'from'
+        const auto find = [&](size_type from, size_type row, size_type col) -> size_type {
+            const auto it = std::lower_bound(entries.begin() + from, entries.end(), Index2D{row, col},
+                                             [](const auto& entry, const Index2D& index) {
+                                                 return entry.i < index.i || (entry.i == index.i && entry.j < index.j);
+                                             });
+            return static_cast<size_type>(it - entries.begin());
+        };
+
+        if (bounds.diagonal_only) {
+            const size_type low  = std::max(bounds.row_low, bounds.col_low);
+            const size_type high = std::min(row_high, col_high);
+            size_type       pos  = 0;
+            for (size_type k = low; k < high && pos < entries.size(); ++k) {
+                pos = find(pos, k, k);
+                if (pos < entries.size() && entries[pos].i == k && entries[pos].j == k) func(tensor[pos], k, k);
+            }
+            return;
+        }
+
+        size_type pos = find(0, bounds.row_low, bounds.col_low);
+        while (pos < entries.size() && entries[pos].i < row_high) {
+            const size_type i = entries[pos].i, j = entries[pos].j;
+            if (j < bounds.col_low) pos = find(pos, i, bounds.col_low);
+            else if (j >= col_high) pos = find(pos, i + 1, bounds.col_low);
+            else func(tensor[pos++], i, j);
+        }
+    } else {
+        if (bounds.diagonal_only) {
+            for (size_type k = std::max(bounds.row_low, bounds.col_low); k < std::min(row_high, col_high); ++k)
+                func(tensor(k, k), k, k);
+        } else if constexpr (tensor_type::params::layout == Layout::CR) {
+            for (size_type j = bounds.col_low; j < col_high; ++j)
+                for (size_type i = bounds.row_low; i < row_high; ++i) func(tensor(i, j), i, j);
+        } else {
+            for (size_type i = bounds.row_low; i < row_high; ++i)
+                for (size_type j = bounds.col_low; j < col_high; ++j) func(tensor(i, j), i, j);
+        }
+    }
 }
 
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left) {
-    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
+template <class T, class Func>
+void _lazy_traverse(const CSRMatrix<T>& matrix, const _lazy_bounds& bounds, Func&& func) {
+    // Columns of a row aren't required to be sorted, which is why they are scanned linearly
+    const auto& offsets = matrix.row_offsets();
+    const auto& cols    = matrix.col_indices();
+    const auto& values  = matrix.values();
+
+    const std::size_t row_high = std::min(bounds.row_high, matrix.rows());
+
+    for (std::size_t i = bounds.row_low; i < row_high; ++i) {
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            const std::size_t j      = cols[k];
+            const bool        inside = bounds.diagonal_only ? (j == i && bounds.col_low <= j && j < bounds.col_high)
+                                                            : (bounds.col_low <= j && j < bounds.col_high);
+            if (inside) func(values[k], i, j);
+        }
+    }
 }
 
-// --- Binary operator implementation ---
-// --------------------------------------
+template <class Tensor, class Predicate>
+class LazyView {
+    using _tensor_type = std::remove_const_t<Tensor>;
 
-// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
-// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
-// r-lvalues if possible to avoid allocation. Doing so would effectively change something like this:
-//    res = A + B - C - D + E
-// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
-// all others. This however introduces it's own set of challenges since instead of traditional overloading we
-// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
-//
+public:
+    using value_type      = typename _tensor_type::value_type;
+    using size_type       = typename _tensor_type::size_type;
+    using const_reference = typename _tensor_type::const_reference;
+    using reference =
+        std::conditional_t<std::is_const_v<Tensor>, const_reference, typename _tensor_type::reference>;
+
+private:
+    Tensor*      _tensor;
+    _lazy_bounds _bounds;
+    Predicate    _predicate; // takes view indices
+
+public:
+    LazyView(Tensor& tensor, const _lazy_bounds& bounds, Predicate predicate)
+        : _tensor(&tensor), _bounds(bounds), _predicate(std::move(predicate)) {}
+
+    [[nodiscard]] size_type rows() const noexcept { return this->_bounds.row_high - this->_bounds.row_low; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_bounds.col_high - this->_bounds.col_low; }
+
+    // Calls 'func(elem)' or 'func(elem, i, j)' for every matching element, indices are relative to the view
+    template <class FuncType>
+    const LazyView& for_each(FuncType&& func) const {
+        const size_type row_low = this->_bounds.row_low, col_low = this->_bounds.col_low;
+
+        _lazy_traverse(*this->_tensor, this->_bounds, [&](reference elem, size_type i, size_type j) {
+            const size_type view_i = i - row_low, view_j = j - col_low;
+            if (!this->_predicate(static_cast<const_reference>(elem), view_i, view_j)) return;
+            if constexpr (std::is_invocable_v<FuncType&, reference, size_type, size_type>) func(elem, view_i, view_j);
+            else func(elem);
+        });
+
+        return *this;
+    }
+
+    // Returns a view with combined predicate, predicate can take '(elem)' or '(elem, i, j)'
+    template <class UnaryPredicate>
+    [[nodiscard]] auto filter(UnaryPredicate predicate) const {
+        auto combined = [first = this->_predicate, second = std::move(predicate)](const_reference elem, size_type i,
+                                                                                  size_type j) -> bool {
+            if (!first(elem, i, j)) return false;
+            if constexpr (std::is_invocable_v<const UnaryPredicate&, const_reference, size_type, size_type>)
+                return second(elem, i, j);
+            else return second(elem);
+        };
+        return LazyView<Tensor, decltype(combined)>(*this->_tensor, this->_bounds, std::move(combined));
+    }
+
+    [[nodiscard]] size_type count() const {
+        size_type count = 0;
+        this->for_each([&](const_reference) { ++count; });
+        return count;
+    }
+
+    [[nodiscard]] value_type sum() const {
+        value_type sum = value_type();
+        this->for_each([&](const_reference elem) { sum += elem; });
+        return sum;
+    }
+
+    template <class T = Tensor, std::enable_if_t<!std::is_const_v<T>, bool> = true>
+    const LazyView& fill(const value_type& value) const {
+        return this->for_each([&](reference elem) { elem = value; });
+    }
+
+    // Copies matching elements into a sparse matrix
+    [[nodiscard]] SparseMatrix<value_type> to_sparse() const {
+        std::vector<SparseEntry2D<value_type>> triplets;
+        this->for_each([&](const_reference elem, size_type i, size_type j) { triplets.push_back({i, j, elem}); });
+        return SparseMatrix<value_type>(this->rows(), this->cols(), std::move(triplets));
+    }
+};
+
+template <class Tensor>
+[[nodiscard]] LazyView<Tensor, _lazy_accept_all> _make_lazy_view(Tensor& tensor, const _lazy_bounds& bounds) {
+    return LazyView<Tensor, _lazy_accept_all>(tensor, bounds, _lazy_accept_all{});
+}
+
+template <class Tensor>
+[[nodiscard]] _lazy_bounds _lazy_full_bounds(const Tensor& tensor, bool diagonal_only = false) noexcept {
+    return {0, tensor.rows(), 0, tensor.cols(), diagonal_only};
+}
+
+// Blocks are validated upfront so the view never reports more rows / cols than its traversal visits
+template <class Tensor>
+[[nodiscard]] _lazy_bounds _lazy_block_bounds(const Tensor& tensor, std::size_t block_i, std::size_t block_j,
+                                              std::size_t block_rows, std::size_t block_cols) {
+    if (block_i > tensor.rows() || block_rows > tensor.rows() - block_i)
+        throw std::out_of_range(stringify("Block rows [", block_i, ", ", block_i + block_rows,
+                                          ") exceed this->rows() (which is ", tensor.rows(), ")"));
+    if (block_j > tensor.cols() || block_cols > tensor.cols() - block_j)
+        throw std::out_of_range(stringify("Block cols [", block_j, ", ", block_j + block_cols,
+                                          ") exceed this->cols() (which is ", tensor.cols(), ")"));
+    return {block_i, block_i + block_rows, block_j, block_j + block_cols, false};
+}
+
+// ==============================
+// --- N-dimensional tensors ---
+// ==============================
+
+// Dense tensors of arbitrary rank, described by an array of extents & an array of strides (in elements):
+//
+//    element(i_0, i_1, ..., i_{N-1}) = data[i_0 * strides[0] + i_1 * strides[1] + ... + i_{N-1} * strides[N-1]]
+//
+// Containers always use compact row-major strides (last axis is contiguous), views can have arbitrary strides,
+// which is what allows slicing, sub-ranges & axis permutations to be just a matter of adjusting extents, strides
+// and the data pointer without any copies. Ownership & bounds checking follow the same 'Ownership' / 'Checking'
+// semantics as 2D tensors.
+//
+// Rank-2 tensors can be viewed as strided matrices with '.matrix_view()', this gives them access to the whole
+// 2D API including formatters.
+
+template <class T, std::size_t rank_, Ownership ownership_ = Ownership::CONTAINER,
+          Checking checking_ = _default_checking>
+class NDTensor {
+    static_assert(rank_ > 0, "Tensor rank should be positive.");
+
+public:
+    using self            = NDTensor;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using index_type      = std::array<size_type, rank_>;
+
+    constexpr static size_type rank      = rank_;
+    constexpr static Ownership ownership = ownership_;
+    constexpr static Checking  checking  = checking_;
+
+    using data_pointer = std::conditional_t<ownership == Ownership::CONST_VIEW, const_pointer, pointer>;
+    using view_type    = NDTensor<value_type, rank, Ownership::VIEW, checking>;
+    using cview_type   = NDTensor<value_type, rank, Ownership::CONST_VIEW, checking>;
+
+private:
+    index_type                _extents{};
+    index_type                _strides{};
+    _unique_array<value_type> _storage; // only used by containers
+    data_pointer              _data = nullptr;
+
+    template <class, std::size_t, Ownership, Checking>
+    friend class NDTensor;
+
+    [[nodiscard]] static index_type _compact_strides(const index_type& extents) noexcept {
+        index_type strides{};
+        size_type  stride = 1;
+        for (size_type axis = rank; axis-- > 0;) {
+            strides[axis] = stride;
+            stride *= extents[axis];
+        }
+        return strides;
+    }
+
+    static void _check_axis(size_type axis) {
+        if (axis >= rank)
+            throw std::out_of_range(stringify("axis (which is ", axis, ") >= rank (which is ", rank, ")"));
+    }
+
+    void _bound_check(const index_type& idx) const {
+        for (size_type axis = 0; axis < rank; ++axis)
+            if (idx[axis] >= this->_extents[axis])
+                throw std::out_of_range(stringify("index (which is ", idx[axis], ") along the axis ", axis,
+                                                  " >= extent (which is ", this->_extents[axis], ")"));
+    }
+
+    [[nodiscard]] size_type _offset(const index_type& idx) const noexcept {
+        size_type offset = 0;
+        for (size_type axis = 0; axis < rank; ++axis) offset += idx[axis] * this->_strides[axis];
+        return offset;
+    }
+
+    // Calls 'func(elem, idx)' for all elements in row-major index order. Outer axes are advanced like an odometer,
+    // the innermost axis is a plain pointer loop, which is contiguous for containers and most of the views.
+    template <class Self, class Func>
+    static void _for_each_impl(Self& tensor, Func&& func) {
+        if (tensor.empty()) return;
+
+        const size_type inner_extent = tensor._extents[rank - 1];
+        const size_type inner_stride = tensor._strides[rank - 1];
+
+        index_type idx{};
+        for (;;) {
+            const auto line = tensor._data + tensor._offset(idx);
+            if (inner_stride == 1) {
+                for (size_type n = 0; n < inner_extent; ++n) {
+                    idx[rank - 1] = n;
+                    func(line[n], idx);
+                }
+            } else {
+                for (size_type n = 0; n < inner_extent; ++n) {
+                    idx[rank - 1] = n;
+                    func(line[n * inner_stride], idx);
+                }
+            }
+            idx[rank - 1] = 0;
+
+            for (size_type axis = rank - 1;;) {
+                if (axis == 0) return;
+                --axis;
+                if (++idx[axis] < tensor._extents[axis]) break;
+                idx[axis] = 0;
+            }
+        }
+    }
+
+public:
+    // - Constructors -
+    NDTensor() noexcept = default;
+
+    // Containers
+    template <Ownership o = ownership, std::enable_if_t<o == Ownership::CONTAINER, bool> = true>
+    explicit NDTensor(const index_type& extents, const_reference value = value_type())
+        : _extents(extents), _strides(_compact_strides(extents)) {
+        this->_storage = _make_unique_ptr_array<value_type>(this->size());
+        this->_data    = this->_storage.get();
+        std::fill_n(this->_data, this->size(), value);
+    }
+
+    // Views
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONTAINER, bool> = true>
+    explicit NDTensor(const index_type& extents, const index_type& strides, data_pointer data)
+        : _extents(extents), _strides(strides), _data(data) {}
+
+    // Containers copy elements into a compact storage, views are shallow
+    NDTensor(const self& other) { *this = other; }
+
+    self& operator=(const self& other) {
+        if (this == &other) return *this;
+        if constexpr (ownership == Ownership::CONTAINER) {
+            this->_extents = other._extents;
+            this->_strides = _compact_strides(other._extents);
+            this->_storage = _make_unique_ptr_array<value_type>(other.size());
+            this->_data    = this->_storage.get();
+            std::copy(other._data, other._data + other.size(), this->_data);
+        } else {
+            this->_extents = other._extents;
+            this->_strides = other._strides;
+            this->_data    = other._data;
+        }
+        return *this;
+    }
+
+    // Moved-from tensor is left empty, otherwise a moved-from container would still report its old size
+    // and point into the storage that now belongs to a different tensor
+    NDTensor(self&& other) noexcept { *this = std::move(other); }
+
+    self& operator=(self&& other) noexcept {
+        if (this == &other) return *this;
+        this->_extents = std::exchange(other._extents, index_type{});
+        this->_strides = std::exchange(other._strides, index_type{});
+        this->_storage = std::move(other._storage);
+        this->_data    = std::exchange(other._data, nullptr);
+        return *this;
+    }
+
+    // Container from any tensor of the same rank (views get compacted)
+    template <Ownership other_ownership, Checking other_checking, Ownership o = ownership,
+              std::enable_if_t<o == Ownership::CONTAINER, bool> = true>
+    NDTensor(const NDTensor<value_type, rank, other_ownership, other_checking>& other)
+        : NDTensor(other.extents()) {
+        size_type i = 0;
+        other.for_each([&](const_reference elem) { this->_data[i++] = elem; });
+    }
+
+    // Const view from a mutable view
+    template <Checking other_checking, Ownership o = ownership,
+              std::enable_if_t<o == Ownership::CONST_VIEW, bool> = true>
+    NDTensor(const NDTensor<value_type, rank, Ownership::VIEW, other_checking>& other)
+        : NDTensor(other.extents(), other.strides(), other.data()) {}
+
+    // - Size & layout -
+    [[nodiscard]] const index_type& extents() const noexcept { return this->_extents; }
+    [[nodiscard]] const index_type& strides() const noexcept { return this->_strides; }
+
+    [[nodiscard]] size_type extent(size_type axis) const {
+        _check_axis(axis);
+        return this->_extents[axis];
+    }
+
+    [[nodiscard]] size_type stride(size_type axis) const {
+        _check_axis(axis);
+        return this->_strides[axis];
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        size_type size = 1;
+        for (const auto& extent : this->_extents) size *= extent;
+        return size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
+
+    [[nodiscard]] bool is_contiguous() const noexcept { return this->_strides == _compact_strides(this->_extents); }
+
+    [[nodiscard]] data_pointer  data() noexcept { return this->_data; }
+    [[nodiscard]] const_pointer data() const noexcept { return this->_data; }
+
+    // - Element access -
+    template <class... Idx, std::enable_if_t<sizeof...(Idx) == rank, bool> = true>
+    [[nodiscard]] decltype(auto) operator()(Idx... idx) {
+        return this->operator[](index_type{static_cast<size_type>(idx)...});
+    }
+
+    template <class... Idx, std::enable_if_t<sizeof...(Idx) == rank, bool> = true>
+    [[nodiscard]] const_reference operator()(Idx... idx) const {
+        return this->operator[](index_type{static_cast<size_type>(idx)...});
+    }
+
+    [[nodiscard]] std::conditional_t<ownership == Ownership::CONST_VIEW, const_reference, reference>
+    operator[](const index_type& idx) {
+        if constexpr (checking == Checking::BOUNDS) this->_bound_check(idx);
+        return this->_data[this->_offset(idx)];
+    }
+
+    [[nodiscard]] const_reference operator[](const index_type& idx) const {
+        if constexpr (checking == Checking::BOUNDS) this->_bound_check(idx);
+        return this->_data[this->_offset(idx)];
+    }
+
+    // - Views -
+    [[nodiscard]] cview_type cview() const { return cview_type(this->_extents, this->_strides, this->_data); }
+    [[nodiscard]] cview_type view() const { return this->cview(); }
+
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] view_type view() {
+        return view_type(this->_extents, this->_strides, this->_data);
+    }
+
+    // Fixes 'axis' at 'idx', which reduces the rank by one
+    template <std::size_t r = rank, std::enable_if_t<(r > 1), bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::CONST_VIEW, checking> slice(size_type axis,
+                                                                                        size_type idx) const {
+        return this->_slice<Ownership::CONST_VIEW>(axis, idx);
+    }
+
+    template <std::size_t r = rank, Ownership o = ownership,
+              std::enable_if_t<(r > 1) && o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::VIEW, checking> slice(size_type axis, size_type idx) {
+        return this->_slice<Ownership::VIEW>(axis, idx);
+    }
+
+    // Restricts 'axis' to indices '[first, first + count)', rank stays the same
+    [[nodiscard]] cview_type subrange(size_type axis, size_type first, size_type count) const {
+        return this->_subrange<Ownership::CONST_VIEW>(axis, first, count);
+    }
+
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] view_type subrange(size_type axis, size_type first, size_type count) {
+        return this->_subrange<Ownership::VIEW>(axis, first, count);
+    }
+
+    // Axis 'k' of the result is the axis 'axes[k]' of the original tensor
+    [[nodiscard]] cview_type permute(const index_type& axes) const {
+        return this->_permute<Ownership::CONST_VIEW>(axes);
+    }
+
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] view_type permute(const index_type& axes) {
+        return this->_permute<Ownership::VIEW>(axes);
+    }
+
+    // Rank-2 tensors can be viewed as 2D strided matrices, throws if strides can't be expressed in a given layout
+    template <Layout layout = Layout::RC, std::size_t r = rank, std::enable_if_t<r == 2, bool> = true>
+    [[nodiscard]] ConstStridedMatrixView<value_type, checking, layout> matrix_view() const {
+        const auto [row_stride, col_stride] = this->_matrix_strides<layout>();
+        return ConstStridedMatrixView<value_type, checking, layout>(this->_extents[0], this->_extents[1], row_stride,
+                                                                    col_stride, this->_data);
+    }
+
+    template <Layout layout = Layout::RC, std::size_t r = rank, Ownership o = ownership,
+              std::enable_if_t<r == 2 && o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] StridedMatrixView<value_type, checking, layout> matrix_view() {
+        const auto [row_stride, col_stride] = this->_matrix_strides<layout>();
+        return StridedMatrixView<value_type, checking, layout>(this->_extents[0], this->_extents[1], row_stride,
+                                                               col_stride, this->_data);
+    }
+
+    template <std::size_t r = rank, std::enable_if_t<r == 2, bool> = true>
+    [[nodiscard]] Matrix<value_type> to_matrix() const {
+        return Matrix<value_type>(this->_extents[0], this->_extents[1],
+                                  [&](size_type i, size_type j) { return this->operator()(i, j); });
+    }
+
+    // - Algorithms -
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
+    const self& for_each(FuncType func) const {
+        _for_each_impl(*this, [&](const_reference elem, const index_type&) { func(elem); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, const index_type&)> = true>
+    const self& for_each(FuncType func) const {
+        _for_each_impl(*this, func);
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true, Ownership o = ownership,
+              std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& for_each(FuncType func) {
+        _for_each_impl(*this, [&](reference elem, const index_type&) { func(elem); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, const index_type&)> = true,
+              Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& for_each(FuncType func) {
+        _for_each_impl(*this, func);
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
+              Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& transform(FuncType func) {
+        return this->for_each([&](reference elem) { elem = func(elem); });
+    }
+
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& fill(const_reference value) {
+        return this->for_each([&](reference elem) { elem = value; });
+    }
+
+    // Reduces 'axis' with a binary 'op', result has rank one less than the original tensor
+    template <class Op, std::size_t r = rank, std::enable_if_t<(r > 1), bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::CONTAINER, checking> reduce(size_type axis,
+                                                                                        const_reference init,
+                                                                                        Op&& op) const {
+        _check_axis(axis);
+
+        NDTensor<value_type, rank - 1, Ownership::CONTAINER, checking> res(_remove_axis(this->_extents, axis), init);
+
+        this->for_each([&](const_reference elem, const index_type& idx) {
+            auto& target = res._data[res._offset(_remove_axis(idx, axis))];
+            target       = op(std::move(target), elem);
+        });
+
+        return res;
+    }
+
+    template <std::size_t r = rank, std::enable_if_t<(r > 1), bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::CONTAINER, checking> sum(size_type axis) const {
+        return this->reduce(axis, value_type(), std::plus<value_type>());
+    }
+
+    [[nodiscard]] value_type sum() const {
+        value_type res = value_type();
+        this->for_each([&](const_reference elem) { res = std::move(res) + elem; });
+        return res;
+    }
+
+private:
+    template <std::size_t N>
+    [[nodiscard]] static std::array<size_type, N - 1> _remove_axis(const std::array<size_type, N>& arr,
+                                                                   size_type axis) noexcept {
+        std::array<size_type, N - 1> res{};
+        for (size_type k = 0, out = 0; k < N; ++k)
+            if (k != axis) res[out++] = arr[k];
+        return res;
+    }
+
+    template <Ownership result_ownership>
+    [[nodiscard]] NDTensor<value_type, rank - 1, result_ownership, checking> _slice(size_type axis,
+                                                                                    size_type idx) const {
+        _check_axis(axis);
+        if (idx >= this->_extents[axis])
+            throw std::out_of_range(stringify("slice index (which is ", idx, ") >= extent (which is ",
+                                              this->_extents[axis], ") along the axis ", axis));
+
+        using result_type = NDTensor<value_type, rank - 1, result_ownership, checking>;
+        return result_type(_remove_axis(this->_extents, axis), _remove_axis(this->_strides, axis),
+                           this->_data + idx * this->_strides[axis]);
+    }
+
+    template <Ownership result_ownership>
+    [[nodiscard]] NDTensor<value_type, rank, result_ownership, checking> _subrange(size_type axis, size_type first,
+                                                                                   size_type count) const {
+        _check_axis(axis);
+        // 'first + count' could wrap around, compare against the remaining extent instead
+        if (first > this->_extents[axis] || count > this->_extents[axis] - first)
+            throw std::out_of_range(stringify("subrange of ", count, " elements starting at ", first,
+                                              " exceeds extent (which is ", this->_extents[axis], ") along the axis ",
+                                              axis));
+
+        index_type extents = this->_extents;
+        extents[axis]      = count;
+
+        using result_type = NDTensor<value_type, rank, result_ownership, checking>;
+        return result_type(extents, this->_strides, this->_data + first * this->_strides[axis]);
+    }
+
+    template <Ownership result_ownership>
+    [[nodiscard]] NDTensor<value_type, rank, result_ownership, checking> _permute(const index_type& axes) const {
+        std::array<bool, rank> used{};
+        for (const auto& axis : axes) {
+            _check_axis(axis);
+            if (used[axis]) throw std::invalid_argument(stringify("axis ", axis, " appears twice in a permutation"));
+            used[axis] = true;
+        }
+
+        index_type extents{}, strides{};
+        for (size_type k = 0; k < rank; ++k) {
+            extents[k] = this->_extents[axes[k]];
+            strides[k] = this->_strides[axes[k]];
+        }
+
+        using result_type = NDTensor<value_type, rank, result_ownership, checking>;
+        return result_type(extents, strides, this->_data);
+    }
+
+    // Converts element strides into the padding-based strides of 2D strided matrices, see notes on
+    // offsets in '_unchecked_get_ij_of_idx()'
+    template <Layout layout>
+    [[nodiscard]] std::pair<size_type, size_type> _matrix_strides() const {
+        const size_type rows = this->_extents[0], cols = this->_extents[1];
+        const size_type s0 = this->_strides[0], s1 = this->_strides[1];
+
+        if constexpr (layout == Layout::RC) {
+            if (s0 >= cols * s1) return {s0 - cols * s1, s1};
+        } else {
+            if (s1 >= rows * s0) return {s0, s1 - rows * s0};
+        }
+        throw std::invalid_argument(stringify("tensor with strides { ", s0, ", ", s1, " } can't be viewed as a ",
+                                              layout == Layout::RC ? "RC" : "CR", " strided matrix"));
+    }
+};
+
+// - Typedefs -
+template <class T, std::size_t rank, Checking checking = _default_checking>
+using NDTensorView = NDTensor<T, rank, Ownership::VIEW, checking>;
+
+template <class T, std::size_t rank, Checking checking = _default_checking>
+using ConstNDTensorView = NDTensor<T, rank, Ownership::CONST_VIEW, checking>;
+
+// Contracts 'axis_a' of 'A' with 'axis_b' of 'B', result axes are the remaining axes of 'A' followed by the remaining
+// axes of 'B'. Both operands get permuted so that the contracted axis is last / first and compacted, after which
+// contraction is a regular '(I x K) * (K x J)' matrix product with contiguous inner loops, split between threads.
+template <class T, std::size_t rank_a, Ownership ownership_a, Checking checking_a, std::size_t rank_b,
+          Ownership ownership_b, Checking checking_b>
+[[nodiscard]] NDTensor<T, rank_a + rank_b - 2>
+contract(const NDTensor<T, rank_a, ownership_a, checking_a>& A, std::size_t axis_a,
+         const NDTensor<T, rank_b, ownership_b, checking_b>& B, std::size_t axis_b) {
+    static_assert(rank_a + rank_b > 2, "Contraction of two rank-1 tensors is a scalar, use a regular dot product.");
+
+    if (axis_a >= rank_a || axis_b >= rank_b)
+        throw std::out_of_range(stringify("can't contract axes ", axis_a, " & ", axis_b, " of rank-", rank_a,
+                                          " and rank-", rank_b, " tensors"));
+    if (A.extents()[axis_a] != B.extents()[axis_b])
+        throw std::invalid_argument(stringify("can't contract axes with different extents ", A.extents()[axis_a],
+                                              " & ", B.extents()[axis_b]));
+
+    std::array<std::size_t, rank_a> permutation_a{};
+    std::array<std::size_t, rank_b> permutation_b{};
+    for (std::size_t k = 0, out = 0; k < rank_a; ++k)
+        if (k != axis_a) permutation_a[out++] = k;
+    permutation_a[rank_a - 1] = axis_a;
+    permutation_b[0]          = axis_b;
+    for (std::size_t k = 0, out = 1; k < rank_b; ++k)
+        if (k != axis_b) permutation_b[out++] = k;
+
+    const NDTensor<T, rank_a> A_compact(A.permute(permutation_a));
+    const NDTensor<T, rank_b> B_compact(B.permute(permutation_b));
+
+    const std::size_t N_k = A.extents()[axis_a];
+    const std::size_t N_i = N_k ? A.size() / N_k : 0;
+    const std::size_t N_j = N_k ? B.size() / N_k : 0;
+
+    std::array<std::size_t, rank_a + rank_b - 2> extents{};
+    for (std::size_t k = 0; k < rank_a - 1; ++k) extents[k] = A_compact.extents()[k];
+    for (std::size_t k = 1; k < rank_b; ++k) extents[rank_a - 2 + k] = B_compact.extents()[k];
+
+    NDTensor<T, rank_a + rank_b - 2> res(extents);
+
+    const T* a = A_compact.data();
+    const T* b = B_compact.data();
+    T*       c = res.data();
+
+    _parallel_for(N_i, _min_grain(2 * N_k * N_j), [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i)
+            for (std::size_t k = 0; k < N_k; ++k) {
+                const T& a_ik = a[i * N_k + k];
+                for (std::size_t j = 0; j < N_j; ++j) c[i * N_j + j] += a_ik * b[k * N_j + j];
+            }
+    });
+
+    return res;
+}
+
+// ==================
+// --- Formatters ---
+// ==================
+
+namespace format {
+
+// --- Implementation ---
+// ----------------------
+
+// The "header" of all human-readable formats that displays
+// some meta info with tensor type and dimensions.
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    std::string buffer;
+
+    if constexpr (_type == Type::DENSE) buffer += "Dense";
+    if constexpr (_type == Type::STRIDED) buffer += "Strided";
+    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
+    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
+    if constexpr (_dimension == Dimension::MATRIX)
+        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
+
+    return buffer;
+}
+
+// Human-readable formats automatically collapse matrices
+// that are too  large to be reasonably parsed by a human
+constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+}
+
+// Generic method to do "dense matrix print" with given delimers.
+// Cuts down on repitition since a lot of formats only differ in the delimers used.
+template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
+[[nodiscard]] std::string
+_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,      //
+                      std::string_view                                                              begin,       //
+                      std::string_view                                                              row_begin,   //
+                      std::string_view                                                              col_delimer, //
+                      std::string_view                                                              row_end,     //
+                      std::string_view                                                              row_delimer, //
+                      std::string_view                                                              end,         //
+                      Func                                                                          stringifier  //
+) {
+    if (tensor.empty()) return (std::string() += begin) += end;
+
+    Matrix<std::string> strings(tensor.rows(), tensor.cols());
+
+    // Stringify
+    if constexpr (type == Type::SPARSE) strings.fill("-");
+    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
+    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
+    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
+
+    // Get column widths - we want matrix to format nice and aligned
+    std::vector<std::size_t> column_widths(strings.cols(), 0);
+    for (std::size_t i = 0; i < strings.rows(); ++i)
+        for (std::size_t j = 0; j < strings.cols(); ++j)
+            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
+
+    // Format with proper alignment
+    std::string buffer(begin);
+    for (std::size_t i = 0; i < strings.rows(); ++i) {
+        buffer += row_begin;
+        for (std::size_t j = 0; j < strings.cols(); ++j) {
+            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
+            buffer += strings(i, j);
+            if (j + 1 < strings.cols()) buffer += col_delimer;
+        }
+        buffer += row_end;
+        if (i + 1 < strings.rows()) buffer += row_delimer;
+    }
+    buffer += end;
+
+    return buffer;
+}
+
+// --- Human-readable formats ---
+// ------------------------------
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+
+    std::string buffer = _tensor_meta_string(tensor);
+
+    buffer += "  { ";
+    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
+        buffer += stringifier(tensor[idx]);
+        if (idx + 1 < tensor.size()) buffer += ", ";
+    }
+    buffer += " }\n";
+
+    return buffer;
+}
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                        Func                                          stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+
+    std::string buffer = _tensor_meta_string(tensor);
+
+    if constexpr (_dimension == Dimension::MATRIX) {
+        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
+            buffer += stringify("(", i, ", ", j, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
+    } else {
+        tensor.for_each([&](const T& elem, std::size_t i) {
+            buffer += stringify("(", i, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
+    }
+
+    return buffer;
+}
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+
+    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
+}
+
+// --- Export formats ---
+// ----------------------
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
+}
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
+}
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
+}
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                         Func                                          stringifier = Func()) {
+    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
+}
+
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
+                                 stringifier);
+}
+
+
+} // namespace format
+
+// ================================
+// --- Linear algebra operators ---
+// ================================
+
+// --- Unary operator implementation ----
+// --------------------------------------
+
+template <class L, class Op,                                                    //
+          _is_tensor_enable_if<L> = true,                                       //
+          class return_type       = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_unary_op(L&& left, Op&& op) {
+    using reference = typename std::decay_t<L>::reference;
+
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
+
+    // '.for_each()' takes care of possible sparsity
+    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
+
+    return res;
+}
+
+// --- Unary operator API ----
+// ---------------------------
+
+// std <functional> has function objects for every operator possible,
+// except unary '+' for some reason, which is why we have to implement it ourselves.
+// This is the exact same thing as 'std::negate<>' but for operator '+'.
+template <class T>
+struct _unary_plus_functor {
+    constexpr T operator()(const T& lhs) const { return +lhs; }
+};
+
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left) {
+    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
+}
+
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left) {
+    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
+}
+
+// --- Binary operator implementation ---
+// --------------------------------------
+
+// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
+// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
+// r-lvalues if possible to avoid allocation. Doing so would effectively change something like this:
+//    res = A + B - C - D + E
+// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
+// all others. This however introduces it's own set of challenges since instead of traditional overloading we
+// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
+//
 // So here are the key points of implementing all of this:
 //
-//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
-//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
-//       correspond to the return type.
+//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
+//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
+//       correspond to the return type.
+//
+//    2. Binary operators have following return types for different tensors:
+//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
+//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
+//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
+//       - (4) sparse + sparse => sparse      (complexity O(N)  )
+//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
+//       while argument can be anything, including views. To implement the list above efficiently there
+//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+//
+//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
+//       and specialized with operator functors froms std <functional>. All we need for individual
+//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
+//       will be performed by the 'apply_operator' method.
+//
+// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
+// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
+// user, so we leave '*' as a matrix product and declate element-wise product as a function 'elementwise_product()'
+// since no existing operators seem suitable for such overload.
+
+// (1)  dense +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
+
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
+
+    return_type res;
+
+    // Reuse r-value arguments if possible while preserving the order of operations
+    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<L>(left);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
+    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<R>(right);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
+    } else {
+        res = return_type(left.rows(), left.cols());
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+    }
+
+    return res;
+}
+
+// (2)  dense + sparse =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
+
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
+
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
+
+    // '.for_each()' to only iterate sparse elements
+    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
+
+    return res;
+}
+
+// (3) sparse +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<R>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
+
+    using reference = typename std::decay_t<R>::reference;
+    using size_type = typename std::decay_t<R>::size_type;
+
+    // Reuse r-value if possible
+    return_type res = std::forward<R>(right);
+
+    // '.for_each()' to only iterate sparse elements
+    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
+
+    return res;
+}
+
+// (4) sparse + sparse => sparse
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
+
+    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
+    using value_type   = typename std::decay_t<L>::value_type;
+
+    std::vector<sparse_entry> res_triplets;
+    res_triplets.reserve(std::max(left.size(), right.size()));
+    // not enough when matrices have different sparsity patterns, but good enough for initial guess
+
+    std::size_t i = 0, j = 0;
+
+    // Merge sparsity patterns
+    while (i < left.size() && j < right.size()) {
+        // Entry present only in lhs sparsity pattern
+        if (left._data[i] < right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
+        }
+        // Entry present only in rhs sparsity pattern
+        else if (left._data[i] > right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
+        }
+        // Entry present in both sparsity patterns
+        else {
+            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
+                                                                         std::forward<R>(right)._data[j++], op));
+        }
+    }
+    // Copy the rest of lhs (if needed)
+    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
+    // Copy the rest of rhs (if needed)
+    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
+
+    return return_type(left.rows(), left.cols(), std::move(res_triplets));
+}
+
+// --- Binary operator API ---
+// ---------------------------
+
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
+}
+
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
+}
+
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                                = typename std::decay_t<L>::value_type,
+          _has_binary_op_multiplies_enable_if<value_type> = true>
+auto elementwise_product(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
+}
+
+// --- Augmented assignment operator API ---
+// -----------------------------------------
+
+// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
+
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
+L& operator+=(L&& left, R&& right) {
+    return (left = std::move(left) + right);
+}
+
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                               = typename std::decay_t<L>::value_type,
+          _has_assignment_op_minus_enable_if<value_type> = true>
+L& operator-=(L&& left, R&& right) {
+    return (left = std::move(left) - right);
+}
+
+// --- Matrix multiplication ---
+// -----------------------------
+
+// Just like with binary operators, we run into the need to have 4 different implementations:
+//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
+//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
+//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
+//    - (4) sparse + sparse => sparse      (complexity O(N)  )
+//
+// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
+// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
+// an afterthought provided here mainly for convenience and not for actual number crunching usage.
+//
+// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
+// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
+
+// (1)  dense +  dense =>  dense
+//
+// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
+// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
+// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
+// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
+// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
+// blocking seems to be worth it.
+//
+// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
+//
+template <class Res, class L, class R>
+void _dense_matmul_accumulate(Res& res, const L& left, const R& right) {
+    // res += left * right
+    using size_type = typename std::decay_t<L>::size_type;
+
+    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
+    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
+
+    constexpr size_type block_size_kk = 32;
+
+    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
+        const size_type k_extent = std::min(N_k, kk + block_size_kk);
+        // needed for matrices that aren't a multiple of block size
+        for (size_type i = 0; i < N_i; ++i) {
+            for (size_type k = kk; k < k_extent; ++k) {
+                const auto& r = left(i, k);
+                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
+            }
+        }
+    }
+}
+
+template <class L, class R,                                                                                //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
+          class value_type                                  = typename std::decay_t<L>::value_type,        //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
+          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
+          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
+          >
+return_type operator*(const L& left, const R& right) {
+    utl_mvl_assert(left.cols() == right.rows());
+
+    return_type res(left.rows(), right.cols(), value_type{});
+    _dense_matmul_accumulate(res, left, right);
+
+    return res;
+}
+
+// (2)  dense + sparse =>  dense
+
+// TODO:
+
+// (3) sparse +  dense =>  dense
+
+// TODO:
+
+// (4) sparse + sparse => sparse
+
+// TODO:
+
+// --- Operators with preallocated output ---
+// ------------------------------------------
+
+// Operators above always return a new container. Loops that recompute results of the same shape over and over
+// (time stepping, iterative solvers) can instead write them into an existing container or a view into external
+// memory, which doesn't allocate at all. Element-wise functions allow 'dest' to be one of the arguments, since
+// every element is read before the corresponding element of 'dest' is written.
+
+template <class Dest, class Src>
+void _check_output_dimensions(const Dest& dest, const Src& src, const char* function) {
+    if (dest.rows() != src.rows() || dest.cols() != src.cols())
+        throw std::invalid_argument(stringify(function, "(): output dimensions ", dest.rows(), "x", dest.cols(),
+                                              " don't match the expected ", src.rows(), "x", src.cols(), "."));
+}
+
+// Dense & strided tensors occupy memory between their first and last element
+template <class A, class B>
+[[nodiscard]] bool _memory_overlaps(const A& a, const B& b) {
+    if (a.empty() || b.empty()) return false;
+
+    const auto* a_low  = &a(0, 0);
+    const auto* a_high = &a(a.rows() - 1, a.cols() - 1);
+    const auto* b_low  = &b(0, 0);
+    const auto* b_high = &b(b.rows() - 1, b.cols() - 1);
+
+    return !(std::less<>{}(a_high, b_low) || std::less<>{}(b_high, a_low));
+}
+
+template <class Dest, class Src, _is_tensor_enable_if<Dest> = true, _is_tensor_enable_if<Src> = true,
+          _is_nonsparse_tensor_enable_if<Dest> = true>
+Dest&& assign_into(Dest&& dest, const Src& src) {
+    using reference  = typename std::decay_t<Dest>::reference;
+    using value_type = typename std::decay_t<Dest>::value_type;
+    using size_type  = typename std::decay_t<Dest>::size_type;
+
+    _check_output_dimensions(dest, src, "assign_into");
+
+    if constexpr (std::decay_t<Src>::params::type == Type::SPARSE) {
+        dest.fill(value_type());
+        src.for_each([&](const value_type& elem, size_type i, size_type j) { dest(i, j) = elem; });
+    } else {
+        dest.for_each([&](reference elem, size_type i, size_type j) { elem = src(i, j); });
+    }
+
+    return std::forward<Dest>(dest);
+}
+
+template <class Dest, class L, class Op, _is_tensor_enable_if<Dest> = true, _is_tensor_enable_if<L> = true,
+          _is_nonsparse_tensor_enable_if<Dest> = true, _is_nonsparse_tensor_enable_if<L> = true>
+Dest&& apply_unary_op_into(Dest&& dest, const L& left, Op&& op) {
+    using reference = typename std::decay_t<Dest>::reference;
+    using size_type = typename std::decay_t<Dest>::size_type;
+
+    _check_output_dimensions(dest, left, "apply_unary_op_into");
+
+    dest.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j)); });
+
+    return std::forward<Dest>(dest);
+}
+
+template <class Dest, class L, class R, class Op, _is_tensor_enable_if<Dest> = true,
+          _are_tensors_with_same_value_type_enable_if<L, R> = true, _is_nonsparse_tensor_enable_if<Dest> = true,
+          _is_nonsparse_tensor_enable_if<L> = true, _is_nonsparse_tensor_enable_if<R> = true>
+Dest&& apply_binary_op_into(Dest&& dest, const L& left, const R& right, Op&& op) {
+    using reference = typename std::decay_t<Dest>::reference;
+    using size_type = typename std::decay_t<Dest>::size_type;
+
+    _check_output_dimensions(dest, left, "apply_binary_op_into");
+    _check_output_dimensions(dest, right, "apply_binary_op_into");
+
+    dest.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+
+    return std::forward<Dest>(dest);
+}
+
+// Matrix product can't be computed in-place, 'dest' must not overlap with the arguments
+template <class Dest, class L, class R, _is_tensor_enable_if<Dest> = true,
+          _are_tensors_with_same_value_type_enable_if<L, R> = true, _is_nonsparse_tensor_enable_if<Dest> = true,
+          _is_nonsparse_tensor_enable_if<L> = true, _is_nonsparse_tensor_enable_if<R> = true>
+Dest&& multiply_into(Dest&& dest, const L& left, const R& right) {
+    using value_type = typename std::decay_t<Dest>::value_type;
+
+    if (left.cols() != right.rows())
+        throw std::invalid_argument(stringify("multiply_into(): can't multiply ", left.rows(), "x", left.cols(),
+                                              " matrix by a ", right.rows(), "x", right.cols(), " matrix."));
+    if (dest.rows() != left.rows() || dest.cols() != right.cols())
+        throw std::invalid_argument(stringify("multiply_into(): output dimensions ", dest.rows(), "x", dest.cols(),
+                                              " don't match the expected ", left.rows(), "x", right.cols(), "."));
+    if (_memory_overlaps(dest, left) || _memory_overlaps(dest, right))
+        throw std::invalid_argument("multiply_into(): output can't overlap with the arguments.");
+
+    dest.fill(value_type{});
+    _dense_matmul_accumulate(dest, left, right);
+
+    return std::forward<Dest>(dest);
+}
+
+// ================================
+// --- Matrix-vector operations ---
+// ================================
+
+// BLAS-like level 1 & 2 kernels that write into an existing output instead of allocating a new tensor, which is
+// what iterative methods need when they do thousands of matrix-vector products per solve. Vectors can be any type
+// with contiguous '.data()' and '.size()' ('std::vector<>', 'std::array<>', single-column matrices and etc.).
+//
+// Dense & strided matrices are handled uniformly through "element steps", with 'A(i, j)' located at
+// 'A.data()[i * row_step + j * col_step]'. Depending on which step is smaller the kernels either:
+//    - compute dot products of rows with 'x' (RC-like matrices), using several independent accumulators
+//      so that compiler can vectorize the reduction without reassociating floating point math;
+//    - compute 'y += x[j] * A(:, j)' column by column (CR-like matrices), in which case each thread owns
+//      a contiguous block of 'y' so no synchronization is needed.
+
+// Aliases that keep scalar arguments from participating in template deduction,
+// otherwise 'gemv(1, A, x, 0, y)' would deduce 'value_type' as 'int' for a matrix of doubles
+template <class Tensor>
+using _value_type_t = typename std::decay_t<Tensor>::value_type;
+
+template <class Vector>
+using _vector_value_t = std::decay_t<decltype(*std::declval<Vector&>().data())>;
+
+template <class Tensor>
+[[nodiscard]] std::pair<std::size_t, std::size_t> _element_steps(const Tensor& A) noexcept {
+    if constexpr (std::decay_t<Tensor>::params::layout == Layout::RC)
+        return {A.cols() * A.col_stride() + A.row_stride(), A.col_stride()};
+    else return {A.row_stride(), A.rows() * A.row_stride() + A.col_stride()};
+}
+
+template <class T>
+[[nodiscard]] T _strided_dot(const T* a, std::size_t a_step, const T* x, std::size_t n) {
+    constexpr std::size_t lanes = 8;
+
+    std::array<T, lanes> acc{};
+    const std::size_t    n_lanes = n - n % lanes;
+
+    if (a_step == 1) {
+        for (std::size_t k = 0; k < n_lanes; k += lanes)
+            for (std::size_t l = 0; l < lanes; ++l) acc[l] += a[k + l] * x[k + l];
+    } else {
+        for (std::size_t k = 0; k < n_lanes; k += lanes)
+            for (std::size_t l = 0; l < lanes; ++l) acc[l] += a[(k + l) * a_step] * x[k + l];
+    }
+    for (std::size_t k = n_lanes; k < n; ++k) acc[0] += a[k * a_step] * x[k];
+
+    T res = T();
+    for (const auto& e : acc) res += e;
+    return res;
+}
+
+// y = alpha * A * x + beta * y, when 'beta' is zero 'y' doesn't have to be initialized
+template <class Tensor, class VectorX, class VectorY, _is_tensor_enable_if<Tensor> = true,
+          _is_nonsparse_tensor_enable_if<Tensor> = true, class value_type = typename std::decay_t<Tensor>::value_type>
+void gemv(const _value_type_t<Tensor>& alpha, const Tensor& A, const VectorX& x, const _value_type_t<Tensor>& beta,
+          VectorY& y) {
+    if (x.size() != A.cols() || y.size() != A.rows())
+        throw std::invalid_argument(stringify("Can't compute GEMV for a ", A.rows(), "x", A.cols(), " matrix, ",
+                                              x.size(), "-element 'x' and ", y.size(), "-element 'y'."));
+    if (static_cast<const void*>(x.data()) == static_cast<const void*>(y.data()) && x.size() != 0)
+        throw std::invalid_argument("GEMV can't be computed with 'x' and 'y' aliasing the same data.");
+
+    const std::size_t N_i = A.rows(), N_j = A.cols();
+    const auto [row_step, col_step] = _element_steps(A);
+
+    const value_type* a  = A.data();
+    const value_type* xp = x.data();
+    value_type*       yp = y.data();
+
+    const bool overwrite_y = (beta == value_type());
+
+    if (col_step <= row_step) {
+        _parallel_for(N_i, _min_grain(2 * N_j), [&](std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) {
+                const value_type dot = alpha * _strided_dot(a + i * row_step, col_step, xp, N_j);
+                yp[i]                = overwrite_y ? dot : dot + beta * yp[i];
+            }
+        });
+    } else {
+        _parallel_for(N_i, _min_grain(2 * N_j), [&](std::size_t low, std::size_t high) {
+            value_type* y_block = yp + low;
+            if (overwrite_y) std::fill(y_block, yp + high, value_type());
+            else
+                for (std::size_t i = 0; i < high - low; ++i) y_block[i] *= beta;
+
+            for (std::size_t j = 0; j < N_j; ++j) {
+                const value_type  s   = alpha * xp[j];
+                const value_type* col = a + j * col_step + low * row_step;
+                if (row_step == 1)
+                    for (std::size_t i = 0; i < high - low; ++i) y_block[i] += s * col[i];
+                else
+                    for (std::size_t i = 0; i < high - low; ++i) y_block[i] += s * col[i * row_step];
+            }
+        });
+    }
+}
+
+// A += alpha * x * y^T
+template <class VectorX, class VectorY, class Tensor, _is_tensor_enable_if<Tensor> = true,
+          _is_nonsparse_tensor_enable_if<Tensor> = true, class value_type = typename std::decay_t<Tensor>::value_type>
+void ger(const _value_type_t<Tensor>& alpha, const VectorX& x, const VectorY& y, Tensor&& A) {
+    static_assert(std::decay_t<Tensor>::params::ownership != Ownership::CONST_VIEW,
+                  "Rank-1 update can't be applied to a const view.");
+
+    if (x.size() != A.rows() || y.size() != A.cols())
+        throw std::invalid_argument(stringify("Can't compute rank-1 update of a ", A.rows(), "x", A.cols(),
+                                              " matrix with ", x.size(), "-element 'x' and ", y.size(),
+                                              "-element 'y'."));
+
+    const std::size_t N_i = A.rows(), N_j = A.cols();
+    const auto [row_step, col_step] = _element_steps(A);
+
+    value_type*       a  = A.data();
+    const value_type* xp = x.data();
+    const value_type* yp = y.data();
+
+    // Same as 'axpy' over each contiguous line of 'A'
+    const auto update_lines = [&](const value_type* scales, const value_type* v, std::size_t line_count,
+                                  std::size_t line_size, std::size_t line_step, std::size_t elem_step) {
+        _parallel_for(line_count, _min_grain(2 * line_size), [&](std::size_t low, std::size_t high) {
+            for (std::size_t line = low; line < high; ++line) {
+                const value_type s = alpha * scales[line];
+                value_type*      p = a + line * line_step;
+                if (elem_step == 1)
+                    for (std::size_t k = 0; k < line_size; ++k) p[k] += s * v[k];
+                else
+                    for (std::size_t k = 0; k < line_size; ++k) p[k * elem_step] += s * v[k];
+            }
+        });
+    };
+
+    if (col_step <= row_step) update_lines(xp, yp, N_i, N_j, row_step, col_step);
+    else update_lines(yp, xp, N_j, N_i, col_step, row_step);
+}
+
+// y += alpha * x
+template <class VectorX, class VectorY, class value_type = _vector_value_t<VectorY>>
+void axpy(const _vector_value_t<VectorY>& alpha, const VectorX& x, VectorY& y) {
+    if (x.size() != y.size())
+        throw std::invalid_argument(stringify("Can't compute AXPY for ", x.size(), "-element 'x' and ", y.size(),
+                                              "-element 'y'."));
+
+    const auto  xp = x.data();
+    value_type* yp = y.data();
+
+    _parallel_for(y.size(), _min_grain(2), [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) yp[i] += alpha * xp[i];
+    });
+}
+
+// ================================
+// --- Batched small matrices ---
+// ================================
+
+// Large batches of tiny matrices (3x3 rotations, 6x6 stiffness blocks and etc.) get very little out of regular
+// matrix kernels: loop overhead dominates and a single matrix doesn't have enough work to fill vector registers.
+// The usual solution (also used by batched BLAS implementations) is to interleave the batch so that the same
+// element of several consecutive matrices is stored contiguously:
 //
-//    2. Binary operators have following return types for different tensors:
-//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
-//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
-//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
-//       - (4) sparse + sparse => sparse      (complexity O(N)  )
-//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
-//       while argument can be anything, including views. To implement the list above efficiently there
-//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+//    [ A0(0,0) A1(0,0) ... A7(0,0) ][ A0(0,1) A1(0,1) ... A7(0,1) ] ... [ A8(0,0) A9(0,0) ... A15(0,0) ] ...
+//      <-------- 'lanes' -------->
+//      <------------------------ block of 'lanes' matrices ------------------------>
 //
-//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
-//       and specialized with operator functors froms std <functional>. All we need for individual
-//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
-//       will be performed by the 'apply_operator' method.
+// after which every kernel becomes a plain scalar algorithm where each "scalar" operation is a loop over 'lanes'
+// independent matrices. Such loops have a compile-time trip count, no dependencies and contiguous access, which
+// is exactly what compilers need to emit SIMD without resorting to platform-specific intrinsics. For the same
+// reason pivoting in 'batched_solve()' is done with per-lane selects rather than branches.
+
+constexpr std::size_t _default_batch_lanes = 8;
+
+template <class T, std::size_t lanes_ = _default_batch_lanes>
+class MatrixBatch {
+public:
+    using self            = MatrixBatch;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    constexpr static size_type lanes = lanes_;
+
+    static_assert(lanes > 0, "Batch should have at least one lane.");
+
+private:
+    size_type               _size = 0;
+    size_type               _rows = 0;
+    size_type               _cols = 0;
+    std::vector<value_type> _data;
+
+    [[nodiscard]] size_type _offset(size_type b, size_type i, size_type j) const noexcept {
+        return (b / lanes) * this->block_size() + (i * this->cols() + j) * lanes + b % lanes;
+    }
+
+public:
+    MatrixBatch() = default;
+
+    explicit MatrixBatch(size_type size, size_type rows, size_type cols, const_reference value = value_type())
+        : _size(size), _rows(rows), _cols(cols), _data(((size + lanes - 1) / lanes) * rows * cols * lanes, value) {}
+    // the last block gets padded up to a full number of lanes, padding is never visible through the public API
+
+    [[nodiscard]] size_type size() const noexcept { return this->_size; }
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+    [[nodiscard]] bool      empty() const noexcept { return this->size() == 0; }
+
+    [[nodiscard]] size_type blocks() const noexcept { return (this->size() + lanes - 1) / lanes; }
+    [[nodiscard]] size_type block_size() const noexcept { return this->rows() * this->cols() * lanes; }
+
+    [[nodiscard]] pointer       data() noexcept { return this->_data.data(); }
+    [[nodiscard]] const_pointer data() const noexcept { return this->_data.data(); }
+
+    [[nodiscard]] reference operator()(size_type b, size_type i, size_type j) {
+        return this->_data[this->_offset(b, i, j)];
+    }
+
+    [[nodiscard]] const_reference operator()(size_type b, size_type i, size_type j) const {
+        return this->_data[this->_offset(b, i, j)];
+    }
+
+    template <class Tensor, _is_tensor_enable_if<Tensor> = true>
+    self& set(size_type b, const Tensor& matrix) {
+        if (matrix.rows() != this->rows() || matrix.cols() != this->cols())
+            throw std::invalid_argument(stringify("Matrix of size ", matrix.rows(), "x", matrix.cols(),
+                                                  " doesn't fit into a batch of ", this->rows(), "x", this->cols(),
+                                                  " matrices."));
+        matrix.for_each([&](const value_type& elem, size_type i, size_type j) { this->operator()(b, i, j) = elem; });
+        return *this;
+    }
+
+    [[nodiscard]] Matrix<value_type> get(size_type b) const {
+        return Matrix<value_type>(this->rows(), this->cols(),
+                                  [&](size_type i, size_type j) { return this->operator()(b, i, j); });
+    }
+};
+
+template <class T, std::size_t lanes>
+void _batched_conditional_swap(T* a, T* b, const std::array<std::size_t, lanes>& pivot, std::size_t row) {
+    for (std::size_t l = 0; l < lanes; ++l) {
+        const bool swap = (pivot[l] == row);
+        const T    lo = a[l], hi = b[l];
+        a[l]          = swap ? hi : lo;
+        b[l]          = swap ? lo : hi;
+    }
+}
+
+// Gauss-Jordan elimination with partial pivoting for a block of interleaved matrices,
+// 'a' holds (n x n) systems, 'x' holds (n x m) right-hand sides and gets overwritten with the solution
+template <class T, std::size_t lanes>
+void _batched_gauss_jordan(T* a, T* x, std::size_t n, std::size_t m) {
+    const auto A = [&](std::size_t i, std::size_t j) { return a + (i * n + j) * lanes; };
+    const auto X = [&](std::size_t i, std::size_t j) { return x + (i * m + j) * lanes; };
+
+    for (std::size_t k = 0; k < n; ++k) {
+        // Every lane picks its own pivot row
+        std::array<std::size_t, lanes> pivot;
+        std::array<T, lanes>           pivot_abs;
+        for (std::size_t l = 0; l < lanes; ++l) pivot[l] = k, pivot_abs[l] = std::abs(A(k, k)[l]);
+
+        for (std::size_t r = k + 1; r < n; ++r) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                const T    value   = std::abs(A(r, k)[l]);
+                const bool greater = value > pivot_abs[l];
+                pivot_abs[l]       = greater ? value : pivot_abs[l];
+                pivot[l]           = greater ? r : pivot[l];
+            }
+        }
+
+        // Swap rows through selects, lanes that don't need a swap keep their values
+        for (std::size_t r = k + 1; r < n; ++r) {
+            if (std::find(pivot.begin(), pivot.end(), r) == pivot.end()) continue;
+            for (std::size_t c = k; c < n; ++c) _batched_conditional_swap<T, lanes>(A(k, c), A(r, c), pivot, r);
+            for (std::size_t c = 0; c < m; ++c) _batched_conditional_swap<T, lanes>(X(k, c), X(r, c), pivot, r);
+        }
+
+        // Normalize the pivot row
+        std::array<T, lanes> inv_pivot;
+        for (std::size_t l = 0; l < lanes; ++l) inv_pivot[l] = T(1) / A(k, k)[l];
+
+        for (std::size_t c = k + 1; c < n; ++c)
+            for (std::size_t l = 0; l < lanes; ++l) A(k, c)[l] *= inv_pivot[l];
+        for (std::size_t c = 0; c < m; ++c)
+            for (std::size_t l = 0; l < lanes; ++l) X(k, c)[l] *= inv_pivot[l];
+
+        // Eliminate column 'k' from all other rows
+        for (std::size_t r = 0; r < n; ++r) {
+            if (r == k) continue;
+
+            std::array<T, lanes> factor;
+            for (std::size_t l = 0; l < lanes; ++l) factor[l] = A(r, k)[l];
+
+            for (std::size_t c = k + 1; c < n; ++c)
+                for (std::size_t l = 0; l < lanes; ++l) A(r, c)[l] -= factor[l] * A(k, c)[l];
+            for (std::size_t c = 0; c < m; ++c)
+                for (std::size_t l = 0; l < lanes; ++l) X(r, c)[l] -= factor[l] * X(k, c)[l];
+        }
+    }
+}
+
+// C[b] = A[b] * B[b] for every matrix in the batch, 'C' gets resized if necessary.
+// Product can't be computed in-place, since every output element reads a whole row & column of the inputs.
+template <class T, std::size_t lanes>
+void batched_gemm(const MatrixBatch<T, lanes>& A, const MatrixBatch<T, lanes>& B, MatrixBatch<T, lanes>& C) {
+    if (&C == &A || &C == &B)
+        throw std::invalid_argument("Output batch of 'batched_gemm()' can't alias its inputs.");
+
+    if (A.size() != B.size() || A.cols() != B.rows())
+        throw std::invalid_argument(stringify("Can't multiply batches of ", A.size(), " (", A.rows(), "x", A.cols(),
+                                              ") and ", B.size(), " (", B.rows(), "x", B.cols(), ") matrices."));
+
+    if (C.size() != A.size() || C.rows() != A.rows() || C.cols() != B.cols())
+        C = MatrixBatch<T, lanes>(A.size(), A.rows(), B.cols());
+
+    const std::size_t N_i = A.rows(), N_k = A.cols(), N_j = B.cols();
+
+    const auto multiply_blocks = [&](std::size_t low, std::size_t high) {
+        for (std::size_t block = low; block < high; ++block) {
+            const T* a = A.data() + block * A.block_size();
+            const T* b = B.data() + block * B.block_size();
+            T*       c = C.data() + block * C.block_size();
+
+            for (std::size_t i = 0; i < N_i; ++i) {
+                for (std::size_t j = 0; j < N_j; ++j) {
+                    std::array<T, lanes> acc{};
+                    for (std::size_t k = 0; k < N_k; ++k) {
+                        const T* a_ik = a + (i * N_k + k) * lanes;
+                        const T* b_kj = b + (k * N_j + j) * lanes;
+                        for (std::size_t l = 0; l < lanes; ++l) acc[l] += a_ik[l] * b_kj[l];
+                    }
+                    std::copy(acc.begin(), acc.end(), c + (i * N_j + j) * lanes);
+                }
+            }
+        }
+    };
+
+    _parallel_for(A.blocks(), _min_grain(2 * N_i * N_j * N_k * lanes), multiply_blocks);
+}
+
+// Solves A[b] * X[b] = B[b] for every system in the batch, 'X' gets resized if necessary.
+// Singular systems don't throw (that would require a branch per lane), their solutions come out non-finite.
+template <class T, std::size_t lanes>
+void batched_solve(const MatrixBatch<T, lanes>& A, const MatrixBatch<T, lanes>& B, MatrixBatch<T, lanes>& X) {
+    static_assert(std::is_floating_point_v<T>, "Batched solver requires a floating point type.");
+
+    if (A.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't solve systems with non-square ", A.rows(), "x", A.cols(),
+                                              " matrices."));
+    if (A.size() != B.size() || A.rows() != B.rows())
+        throw std::invalid_argument(stringify("Batch of ", B.size(), " (", B.rows(), "x", B.cols(),
+                                              ") right-hand sides doesn't match a batch of ", A.size(), " (",
+                                              A.rows(), "x", A.cols(), ") systems."));
+
+    if (&X != &B && (X.size() != B.size() || X.rows() != B.rows() || X.cols() != B.cols()))
+        X = MatrixBatch<T, lanes>(B.size(), B.rows(), B.cols());
+
+    const std::size_t n = A.rows(), m = B.cols();
+
+    const auto solve_blocks = [&](std::size_t low, std::size_t high) {
+        std::vector<T> workspace(A.block_size());
+
+        for (std::size_t block = low; block < high; ++block) {
+            const T* a = A.data() + block * A.block_size();
+            const T* b = B.data() + block * B.block_size();
+            T*       x = X.data() + block * X.block_size();
+
+            std::copy(a, a + A.block_size(), workspace.begin());
+            if (x != b) std::copy(b, b + B.block_size(), x);
+
+            // Padding lanes of the last block get an identity matrix so they don't produce NaNs
+            for (std::size_t l = A.size() - block * lanes; l < lanes; ++l)
+                for (std::size_t i = 0; i < n; ++i)
+                    for (std::size_t j = 0; j < n; ++j) workspace[(i * n + j) * lanes + l] = T(i == j);
+
+            _batched_gauss_jordan<T, lanes>(workspace.data(), x, n, m);
+        }
+    };
+
+    _parallel_for(A.blocks(), _min_grain(n * n * (n + m) * lanes), solve_blocks);
+}
+
+// A_inv[b] = inverse(A[b]) for every matrix in the batch, 'A_inv' gets resized if necessary
+template <class T, std::size_t lanes>
+void batched_inverse(const MatrixBatch<T, lanes>& A, MatrixBatch<T, lanes>& A_inv) {
+    MatrixBatch<T, lanes> identity(A.size(), A.rows(), A.rows());
+    for (std::size_t block = 0; block < identity.blocks(); ++block)
+        for (std::size_t i = 0; i < A.rows(); ++i)
+            std::fill_n(identity.data() + block * identity.block_size() + (i * A.rows() + i) * lanes, lanes, T(1));
+
+    batched_solve(A, identity, identity); // solution overwrites the identity in-place, 'A' stays untouched
+    A_inv = std::move(identity);
+}
+
+// ============================
+// --- Block sparse matrices ---
+// ============================
+
+// Matrices coming from multi-physics discretizations (elasticity, coupled PDEs and etc.) usually consist of small
+// dense 'block_size x block_size' tiles, one per coupled pair of nodes. Storing every such scalar as a COO triplet
+// wastes 2 indices per value and scatters neighbouring values across memory. Block compressed sparse row (BSR)
+// format stores a single column index per tile and keeps tile values contiguous:
 //
-// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
-// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
-// user, so we leave '*' as a matrix product and declate element-wise product as a function 'elementwise_product()'
-// since no existing operators seem suitable for such overload.
+//    block_row_offsets = [ 0, 2, 3 ]           <- tiles of block row 'I' are [ offsets[I], offsets[I + 1] )
+//    block_col_indices = [ 0, 3, 1 ]           <- block column of each tile
+//    values            = [ T0 ][ T1 ][ T2 ]    <- 'block_size * block_size' values per tile, row-major
+//
+// Since tile size is a compile-time constant, all tile kernels below have fixed trip counts and get fully unrolled
+// & vectorized by the compiler without any platform-specific intrinsics.
+//
+// Matrix dimensions have to be divisible by the block size, this keeps the kernels free of edge cases.
 
-// (1)  dense +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+template <class T, std::size_t block_size_>
+class BSRMatrix {
+    static_assert(block_size_ > 0, "Block size should be positive.");
+
+public:
+    using self            = BSRMatrix;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+
+    constexpr static size_type block_size = block_size_;
+    constexpr static size_type block_area = block_size * block_size;
+
+private:
+    size_type               _rows              = 0;
+    size_type               _cols              = 0;
+    std::vector<size_type>  _block_row_offsets = {0};
+    std::vector<size_type>  _block_col_indices;
+    std::vector<value_type> _values;
+
+    static void _check_dimensions(size_type rows, size_type cols) {
+        if (rows % block_size != 0 || cols % block_size != 0)
+            throw std::invalid_argument(stringify("BSR matrix dimensions ", rows, "x", cols,
+                                                  " are not divisible by the block size ", block_size, "."));
+    }
+
+public:
+    BSRMatrix() = default;
+
+    explicit BSRMatrix(size_type rows, size_type cols, std::vector<size_type> block_row_offsets,
+                       std::vector<size_type> block_col_indices, std::vector<value_type> values)
+        : _rows(rows), _cols(cols), _block_row_offsets(std::move(block_row_offsets)),
+          _block_col_indices(std::move(block_col_indices)), _values(std::move(values)) {
+        _check_dimensions(rows, cols);
+        if (this->_block_row_offsets.size() != this->block_rows() + 1)
+            throw std::invalid_argument(stringify("BSR block row offsets should have block_rows + 1 (which is ",
+                                                  this->block_rows() + 1, ") elements, got ",
+                                                  this->_block_row_offsets.size(), "."));
+        if (this->_values.size() != this->_block_col_indices.size() * block_area ||
+            this->_block_row_offsets.back() != this->_block_col_indices.size())
+            throw std::invalid_argument("BSR block column indices, values and block row offsets don't match in size.");
+        for (const auto& J : this->_block_col_indices)
+            if (J >= this->block_cols())
+                throw std::out_of_range(stringify("BSR block column index ", J, " is out of range for ",
+                                                  this->block_cols(), " block columns."));
+    }
+
+    // Conversion from any 2D tensor, every tile containing at least one non-default-initialized element gets stored
+    template <class Tensor, _is_tensor_enable_if<Tensor> = true>
+    explicit BSRMatrix(const Tensor& tensor) {
+        // Sparse tensors always keep their triplets sorted, other tensors have to be converted first
+        if constexpr (std::decay_t<Tensor>::params::type == Type::SPARSE) this->_assign_from_sorted(tensor);
+        else this->_assign_from_sorted(SparseMatrix<value_type>(tensor));
+    }
+
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+    [[nodiscard]] size_type block_rows() const noexcept { return this->_rows / block_size; }
+    [[nodiscard]] size_type block_cols() const noexcept { return this->_cols / block_size; }
+    [[nodiscard]] size_type blocks() const noexcept { return this->_block_col_indices.size(); }
+    [[nodiscard]] size_type size() const noexcept { return this->_values.size(); }
+    [[nodiscard]] bool      empty() const noexcept { return this->size() == 0; }
+
+    [[nodiscard]] const std::vector<size_type>&  block_row_offsets() const noexcept { return this->_block_row_offsets; }
+    [[nodiscard]] const std::vector<size_type>&  block_col_indices() const noexcept { return this->_block_col_indices; }
+    [[nodiscard]] const std::vector<value_type>& values() const noexcept { return this->_values; }
+    [[nodiscard]] std::vector<value_type>&       values() noexcept { return this->_values; }
+
+    // Row-major 'block_size x block_size' tile number 'k'
+    [[nodiscard]] const value_type* block_data(size_type k) const noexcept {
+        return this->_values.data() + k * block_area;
+    }
+    [[nodiscard]] value_type* block_data(size_type k) noexcept { return this->_values.data() + k * block_area; }
+
+    // Iterates all stored values, including zeroes that pad the tiles
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type I = 0; I < this->block_rows(); ++I)
+            for (size_type k = this->_block_row_offsets[I]; k < this->_block_row_offsets[I + 1]; ++k) {
+                const size_type J    = this->_block_col_indices[k];
+                const auto      tile = this->block_data(k);
+                for (size_type r = 0; r < block_size; ++r)
+                    for (size_type c = 0; c < block_size; ++c)
+                        func(tile[r * block_size + c], I * block_size + r, J * block_size + c);
+            }
+        return *this;
+    }
+
+    // Only non-default-initialized values become triplets, tile padding gets dropped
+    [[nodiscard]] SparseMatrix<value_type> to_sparse() const {
+        std::vector<SparseEntry2D<value_type>> triplets;
+        triplets.reserve(this->size());
+        this->for_each([&](const_reference value, size_type i, size_type j) {
+            if (value != value_type()) triplets.push_back({i, j, value});
+        });
+        return SparseMatrix<value_type>(this->rows(), this->cols(), std::move(triplets));
+    }
+
+private:
+    template <class SortedTensor>
+    void _assign_from_sorted(const SortedTensor& tensor) {
+        _check_dimensions(tensor.rows(), tensor.cols());
+
+        this->_rows = tensor.rows();
+        this->_cols = tensor.cols();
+        this->_block_row_offsets.assign(this->block_rows() + 1, 0);
+        this->_block_col_indices.clear();
+        this->_values.clear();
+
+        // Triplets are sorted by { i, j }, which means block rows come one after another. First pass collects
+        // unique block columns of each block row as it ends, second pass scatters values into zero-initialized tiles.
+        std::vector<size_type> row_block_cols;
+        size_type              current_I = 0;
+
+        const auto finish_block_rows_until = [&](size_type I) {
+            for (; current_I < I; ++current_I) {
+                std::sort(row_block_cols.begin(), row_block_cols.end());
+                row_block_cols.erase(std::unique(row_block_cols.begin(), row_block_cols.end()), row_block_cols.end());
+                this->_block_col_indices.insert(this->_block_col_indices.end(), row_block_cols.begin(),
+                                                row_block_cols.end());
+                this->_block_row_offsets[current_I + 1] = this->_block_col_indices.size();
+                row_block_cols.clear();
+            }
+        };
+
+        tensor.for_each([&](const_reference, size_type i, size_type j) {
+            finish_block_rows_until(i / block_size);
+            row_block_cols.push_back(j / block_size);
+        });
+        finish_block_rows_until(this->block_rows());
+
+        this->_values.assign(this->blocks() * block_area, value_type());
+
+        tensor.for_each([&](const_reference value, size_type i, size_type j) {
+            const auto row_first = this->_block_col_indices.begin() + this->_block_row_offsets[i / block_size];
+            const auto row_last  = this->_block_col_indices.begin() + this->_block_row_offsets[i / block_size + 1];
+            const auto k         = static_cast<size_type>(std::lower_bound(row_first, row_last, j / block_size) -
+                                                  this->_block_col_indices.begin());
+            this->block_data(k)[(i % block_size) * block_size + j % block_size] = value;
+        });
+    }
+};
+
+// y = A * x, 'x' should have 'A.cols()' elements, 'y' gets resized to 'A.rows()' if necessary
+template <class T, std::size_t block_size>
+void spmv(const BSRMatrix<T, block_size>& A, const std::vector<T>& x, std::vector<T>& y) {
+    if (x.size() != A.cols())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " BSR matrix by a vector of ",
+                                              x.size(), " elements."));
+    if (&x == &y) throw std::invalid_argument("BSR matrix-vector product can't be computed in-place.");
+
+    y.resize(A.rows());
+
+    const auto& offsets = A.block_row_offsets();
+    const auto& indices = A.block_col_indices();
+
+    const auto multiply_block_rows = [&](std::size_t low, std::size_t high) {
+        for (std::size_t I = low; I < high; ++I) {
+            std::array<T, block_size> acc{};
+
+            for (std::size_t k = offsets[I]; k < offsets[I + 1]; ++k) {
+                const T* a = A.block_data(k);
+                const T* b = x.data() + indices[k] * block_size;
+                for (std::size_t r = 0; r < block_size; ++r)
+                    for (std::size_t c = 0; c < block_size; ++c) acc[r] += a[r * block_size + c] * b[c];
+            }
+
+            std::copy(acc.begin(), acc.end(), y.data() + I * block_size);
+        }
+    };
+
+    const std::size_t average_blocks = A.blocks() / std::max<std::size_t>(A.block_rows(), 1) + 1;
+    _parallel_for(A.block_rows(), _min_grain(2 * average_blocks * A.block_area), multiply_block_rows);
+}
+
+// Y = A * X for a dense 'X', 'Y' gets resized if necessary.
+// Each tile value multiplies a contiguous row of 'X', which turns the innermost loop into a vectorizable axpy.
+template <class T, std::size_t block_size, Checking checking_x, Checking checking_y>
+void spmm(const BSRMatrix<T, block_size>& A, const Matrix<T, checking_x>& X, Matrix<T, checking_y>& Y) {
+    if (X.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " BSR matrix by a ", X.rows(),
+                                              "x", X.cols(), " matrix."));
+    if (static_cast<const void*>(&X) == static_cast<const void*>(&Y))
+        throw std::invalid_argument("BSR matrix-matrix product can't be computed in-place.");
+
+    if (Y.rows() != A.rows() || Y.cols() != X.cols()) Y = Matrix<T, checking_y>(A.rows(), X.cols());
+
+    const std::size_t n = X.cols();
+
+    const auto& offsets = A.block_row_offsets();
+    const auto& indices = A.block_col_indices();
+
+    const auto multiply_block_rows = [&](std::size_t low, std::size_t high) {
+        for (std::size_t I = low; I < high; ++I) {
+            T* y = Y.data() + I * block_size * n;
+            std::fill_n(y, block_size * n, T());
+
+            for (std::size_t k = offsets[I]; k < offsets[I + 1]; ++k) {
+                const T* a = A.block_data(k);
+                const T* b = X.data() + indices[k] * block_size * n;
+                for (std::size_t r = 0; r < block_size; ++r)
+                    for (std::size_t c = 0; c < block_size; ++c) {
+                        const T  a_rc  = a[r * block_size + c];
+                        const T* b_row = b + c * n;
+                        T*       y_row = y + r * n;
+                        for (std::size_t j = 0; j < n; ++j) y_row[j] += a_rc * b_row[j];
+                    }
+            }
+        }
+    };
+
+    const std::size_t average_blocks = A.blocks() / std::max<std::size_t>(A.block_rows(), 1) + 1;
+    _parallel_for(A.block_rows(), _min_grain(2 * average_blocks * A.block_area * n), multiply_block_rows);
+}
+
+// ================
+// --- Stencils ---
+// ================
+
+// Stencil sweeps are computed as 'out(i, j) = sum_{a, b} w(a, b) * in(i + a - ry, j + b - rx)' where 'ry' & 'rx'
+// are kernel radii. Since such sweeps are memory-bound, the kernels below are organized around memory access:
+//
+//    1. Interior rows are computed "tap-by-tap": for each kernel weight 'w' we do 'out_row += w * shifted_in_row'
+//       over a tile of columns. This is a simple contiguous axpy that compilers vectorize, column tiles are
+//       small enough for the output tile to stay in L1 across all of the taps.
+//    2. Only the elements within kernel radius of the matrix edge go through a slow path with boundary handling.
+//    3. Row ranges get split between threads.
+//    4. Repeated sweeps use temporal blocking: matrix is split into row bands, each band gets extended with
+//       a halo of 'steps * ry' rows and all of the steps are done on that band while it's hot in cache. Halo rows
+//       get recomputed by neighbouring bands, which is cheap compared to 'steps' passes over the whole matrix.
+//       Periodic boundaries would require halo to wrap around the matrix, in that case we fall back to plain sweeps.
+
+enum class Boundary { ZERO, CLAMP, PERIODIC };
+
+// Compile-time kernel, weights are stored row-major, dimensions should be odd so that the kernel has a center
+template <class T, std::size_t rows_, std::size_t cols_ = rows_>
+struct Stencil {
+    static_assert(rows_ % 2 == 1 && cols_ % 2 == 1, "Stencil dimensions should be odd.");
+
+    std::array<T, rows_ * cols_> weights;
+
+    [[nodiscard]] constexpr static std::size_t rows() noexcept { return rows_; }
+    [[nodiscard]] constexpr static std::size_t cols() noexcept { return cols_; }
+
+    [[nodiscard]] constexpr const T& operator()(std::size_t i, std::size_t j) const { return weights[i * cols_ + j]; }
+    [[nodiscard]] constexpr T&       operator()(std::size_t i, std::size_t j) { return weights[i * cols_ + j]; }
+};
+
+// Internal kernel representation, '0' static dimensions mean the dimensions are only known at runtime.
+// Static dimensions turn all of the tap loops into fixed-count loops that get fully unrolled.
+template <class T, std::size_t static_rows, std::size_t static_cols>
+struct _stencil_kernel {
+    const T*    weights;
+    std::size_t runtime_rows;
+    std::size_t runtime_cols;
+
+    [[nodiscard]] constexpr std::size_t rows() const noexcept { return static_rows ? static_rows : runtime_rows; }
+    [[nodiscard]] constexpr std::size_t cols() const noexcept { return static_cols ? static_cols : runtime_cols; }
+    [[nodiscard]] constexpr const T&    operator()(std::size_t i, std::size_t j) const noexcept {
+        return weights[i * this->cols() + j];
+    }
+};
+
+constexpr std::size_t _stencil_tile_cols   = 512;     // output tile width used by interior sweeps
+constexpr std::size_t _stencil_cache_bytes = 1 << 20; // rough size of L2, used to select temporal band height
+
+// Maps possibly out-of-range index into '[0, size)', returns 'false' if element should be treated as zero
+[[nodiscard]] inline bool _stencil_map_index(std::ptrdiff_t& idx, std::size_t size, Boundary boundary) noexcept {
+    const auto n = static_cast<std::ptrdiff_t>(size);
+    if (idx >= 0 && idx < n) return true;
+    if (boundary == Boundary::ZERO) return false;
+    if (boundary == Boundary::CLAMP) idx = std::clamp<std::ptrdiff_t>(idx, 0, n - 1);
+    if (boundary == Boundary::PERIODIC) idx = (idx % n + n) % n;
+    return true;
+}
+
+// Computes rows '[low, high)' of a single sweep over 'rows x cols' row-major grid
+template <class T, class Kernel>
+void _stencil_sweep(const T* in, T* out, std::size_t rows, std::size_t cols, std::size_t low, std::size_t high,
+                    const Kernel& kernel, Boundary boundary) {
+    const std::size_t kr = kernel.rows(), kc = kernel.cols();
+    const std::size_t ry = kr / 2, rx = kc / 2;
+
+    const auto edge_value = [&](std::size_t i, std::size_t j) {
+        T acc = T();
+        for (std::size_t a = 0; a < kr; ++a) {
+            auto ii = static_cast<std::ptrdiff_t>(i + a) - static_cast<std::ptrdiff_t>(ry);
+            if (!_stencil_map_index(ii, rows, boundary)) continue;
+            for (std::size_t b = 0; b < kc; ++b) {
+                auto jj = static_cast<std::ptrdiff_t>(j + b) - static_cast<std::ptrdiff_t>(rx);
+                if (!_stencil_map_index(jj, cols, boundary)) continue;
+                acc += kernel(a, b) * in[static_cast<std::size_t>(ii) * cols + static_cast<std::size_t>(jj)];
+            }
+        }
+        return acc;
+    };
+
+    const bool has_interior_cols = (cols > 2 * rx);
+
+    for (std::size_t i = low; i < high; ++i) {
+        T* out_row = out + i * cols;
+
+        // Slow path, whole row is within kernel radius of the top / bottom edge
+        if (i < ry || i + ry >= rows || !has_interior_cols) {
+            for (std::size_t j = 0; j < cols; ++j) out_row[j] = edge_value(i, j);
+            continue;
+        }
+
+        // Fast path, tap-by-tap accumulation over column tiles
+        for (std::size_t j_low = rx; j_low < cols - rx; j_low += _stencil_tile_cols) {
+            const std::size_t j_high = std::min(j_low + _stencil_tile_cols, cols - rx);
+
+            std::fill(out_row + j_low, out_row + j_high, T());
+
+            for (std::size_t a = 0; a < kr; ++a) {
+                const T* in_row = in + (i + a - ry) * cols;
+                for (std::size_t b = 0; b < kc; ++b) {
+                    const T  w       = kernel(a, b);
+                    const T* shifted = in_row + b;
+                    for (std::size_t j = j_low; j < j_high; ++j) out_row[j] += w * shifted[j - rx];
+                }
+            }
+        }
+
+        // Slow path for the left & right edges
+        for (std::size_t j = 0; j < rx; ++j) out_row[j] = edge_value(i, j);
+        for (std::size_t j = cols - rx; j < cols; ++j) out_row[j] = edge_value(i, j);
+    }
+}
+
+template <class T, class Kernel>
+void _apply_stencil(const T* src, T* dst, std::size_t rows, std::size_t cols, const Kernel& kernel,
+                    Boundary boundary, std::size_t steps) {
+    if (steps == 0 || rows == 0 || cols == 0) {
+        std::copy(src, src + rows * cols, dst);
+        return;
+    }
+
+    const std::size_t ry        = kernel.rows() / 2;
+    const std::size_t halo      = steps * ry;
+    const std::size_t row_grain = _min_grain(2 * cols * kernel.rows() * kernel.cols());
+
+    // Temporal blocking is only worth it when bands fitting into cache are substantially taller than the halo
+    const std::size_t cache_rows  = std::max<std::size_t>(_stencil_cache_bytes / (2 * sizeof(T) * cols), 1);
+    const bool        use_bands   = steps > 1 && boundary != Boundary::PERIODIC && 4 * halo <= cache_rows;
+    const std::size_t thread_rows = (rows + _max_thread_count() - 1) / _max_thread_count();
+
+    // Plain sweeps, ping-pong between 'dst' and a buffer so that the last sweep ends up in 'dst'
+    if (!use_bands || cache_rows - 2 * halo >= rows) {
+        std::vector<T> buffer(steps > 1 ? rows * cols : 0);
+
+        const T* in = src;
+        for (std::size_t s = 0; s < steps; ++s) {
+            T* out = ((steps - s) % 2 == 1) ? dst : buffer.data();
+            _parallel_for(rows, row_grain, [&](std::size_t low, std::size_t high) {
+                _stencil_sweep(in, out, rows, cols, low, high, kernel, boundary);
+            });
+            in = out;
+        }
+        return;
+    }
+
+    // Temporally blocked sweeps
+    const std::size_t band_rows  = std::max(std::min(cache_rows - 2 * halo, thread_rows), halo);
+    const std::size_t band_count = (rows + band_rows - 1) / band_rows;
+
+    _parallel_for(band_count, 1, [&](std::size_t band_low, std::size_t band_high) {
+        std::vector<T> current, next;
+
+        for (std::size_t band = band_low; band < band_high; ++band) {
+            const std::size_t r_low  = band * band_rows;
+            const std::size_t r_high = std::min(r_low + band_rows, rows);
+            const std::size_t g_low  = (r_low >= halo) ? r_low - halo : 0;
+            const std::size_t g_high = std::min(r_high + halo, rows);
+            const std::size_t extent = g_high - g_low;
+
+            current.assign(src + g_low * cols, src + g_high * cols);
+            next.resize(current.size());
+
+            // Valid part of the band shrinks by 'ry' rows per step at the edges that aren't real matrix edges,
+            // real matrix edges get regular boundary handling
+            for (std::size_t s = 1; s <= steps; ++s) {
+                const std::size_t low  = (g_low == 0) ? 0 : s * ry;
+                const std::size_t high = (g_high == rows) ? extent : extent - s * ry;
+                _stencil_sweep(current.data(), next.data(), extent, cols, low, high, kernel, boundary);
+                std::swap(current, next);
+            }
+
+            std::copy(current.begin() + (r_low - g_low) * cols, current.begin() + (r_high - g_low) * cols,
+                      dst + r_low * cols);
+        }
+    });
+}
+
+template <class T, Checking checking, class Kernel>
+void _apply_stencil_to_matrix(const T* src, std::size_t rows, std::size_t cols, const Kernel& kernel,
+                              Matrix<T, checking>& dst, Boundary boundary, std::size_t steps) {
+    // Sweeps can't be done in-place, aliased source has to be copied
+    if (src == dst.data() && rows * cols > 0) {
+        const std::vector<T> src_copy(src, src + rows * cols);
+        _apply_stencil(src_copy.data(), dst.data(), rows, cols, kernel, boundary, steps);
+        return;
+    }
+    if (dst.rows() != rows || dst.cols() != cols) dst = Matrix<T, checking>(rows, cols);
+    _apply_stencil(src, dst.data(), rows, cols, kernel, boundary, steps);
+}
+
+// dst = 'stencil' applied to 'src' 'steps' times, 'dst' gets resized if necessary and can be the same as 'src'
+template <class T, std::size_t kernel_rows, std::size_t kernel_cols, Checking checking_src, Checking checking_dst>
+void apply_stencil(const Matrix<T, checking_src>& src, const Stencil<T, kernel_rows, kernel_cols>& stencil,
+                   Matrix<T, checking_dst>& dst, Boundary boundary = Boundary::ZERO, std::size_t steps = 1) {
+    const _stencil_kernel<T, kernel_rows, kernel_cols> kernel{stencil.weights.data(), kernel_rows, kernel_cols};
+    _apply_stencil_to_matrix(src.data(), src.rows(), src.cols(), kernel, dst, boundary, steps);
+}
+
+template <class T, Checking checking_src, Checking checking_kernel, Checking checking_dst>
+void apply_stencil(const Matrix<T, checking_src>& src, const Matrix<T, checking_kernel>& stencil,
+                   Matrix<T, checking_dst>& dst, Boundary boundary = Boundary::ZERO, std::size_t steps = 1) {
+    if (stencil.rows() % 2 == 0 || stencil.cols() % 2 == 0)
+        throw std::invalid_argument(stringify("Stencil dimensions should be odd, got ", stencil.rows(), "x",
+                                              stencil.cols(), "."));
+    // Kernel can alias 'dst' too, in which case it has to be preserved
+    const std::vector<T>           weights(stencil.data(), stencil.data() + stencil.size());
+    const _stencil_kernel<T, 0, 0> kernel{weights.data(), stencil.rows(), stencil.cols()};
+    _apply_stencil_to_matrix(src.data(), src.rows(), src.cols(), kernel, dst, boundary, steps);
+}
+
+// 2D convolution, same as applying a stencil with a flipped kernel
+template <class T, Checking checking_src, Checking checking_kernel, Checking checking_dst>
+void convolve(const Matrix<T, checking_src>& src, const Matrix<T, checking_kernel>& kernel,
+              Matrix<T, checking_dst>& dst, Boundary boundary = Boundary::ZERO) {
+    const Matrix<T> flipped(kernel.rows(), kernel.cols(), [&](std::size_t i, std::size_t j) {
+        return kernel(kernel.rows() - 1 - i, kernel.cols() - 1 - j);
+    });
+    apply_stencil(src, flipped, dst, boundary);
+}
+
+// ==================================
+// --- Reduced precision kernels ---
+// ==================================
+
+// Kernels below take tensors of any element type and accumulate in a "widened" type: 16-bit floats get widened
+// to 'float' and 'int8' to 'int32', other types are accumulated as-is. Since conversions happen in registers
+// right after the load, memory traffic stays proportional to the storage type.
+
+template <class T>
+struct _widened {
+    using type = T;
+};
+
+template <class Format>
+struct _widened<_reduced_float<Format>> {
+    using type = float;
+};
+
+template <>
+struct _widened<std::int8_t> {
+    using type = std::int32_t;
+};
+
+template <class T>
+using widened_t = typename _widened<T>::type;
+
+template <class L, class R>
+using _widened_product_t = decltype(std::declval<widened_t<L>>() * std::declval<widened_t<R>>());
+
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] widened_t<value_type> widened_sum(const Tensor& tensor) {
+    widened_t<value_type> res = widened_t<value_type>();
+    tensor.for_each([&](const value_type& elem) { res += static_cast<widened_t<value_type>>(elem); });
+    return res;
+}
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+// y = A * x
+template <class Tensor, class T, _is_tensor_enable_if<Tensor> = true, _is_nonsparse_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type,
+          class acc_type   = _widened_product_t<value_type, T>>
+[[nodiscard]] std::vector<acc_type> widened_gemv(const Tensor& A, const std::vector<T>& x) {
+    if (A.cols() != x.size())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " matrix by a vector of ",
+                                              x.size(), " elements."));
+
+    std::vector<acc_type> x_widened(x.size());
+    for (std::size_t k = 0; k < x.size(); ++k) x_widened[k] = static_cast<acc_type>(static_cast<widened_t<T>>(x[k]));
+
+    std::vector<acc_type> y(A.rows());
+
+    _parallel_for(A.rows(), _min_grain(2 * A.cols()), [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) {
+            acc_type acc = acc_type();
+            for (std::size_t k = 0; k < A.cols(); ++k)
+                acc += static_cast<acc_type>(static_cast<widened_t<value_type>>(A(i, k))) * x_widened[k];
+            y[i] = acc;
+        }
+    });
 
-    return_type res;
+    return y;
+}
 
-    // Reuse r-value arguments if possible while preserving the order of operations
-    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<L>(left);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
-    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<R>(right);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
-    } else {
-        res = return_type(left.rows(), left.cols());
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
-    }
+// C = A * B, blocked the same way as regular matrix multiplication. Each thread widens blocks of 'B' rows
+// into a small buffer once and reuses them for all of its rows of 'A'.
+template <class L, class R, _is_tensor_enable_if<L> = true, _is_tensor_enable_if<R> = true,
+          _is_nonsparse_tensor_enable_if<L> = true, _is_nonsparse_tensor_enable_if<R> = true,
+          class value_type_l = typename std::decay_t<L>::value_type,
+          class value_type_r = typename std::decay_t<R>::value_type,
+          class acc_type     = _widened_product_t<value_type_l, value_type_r>>
+[[nodiscard]] Matrix<acc_type> widened_gemm(const L& A, const R& B) {
+    if (A.cols() != B.rows())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " and ", B.rows(), "x",
+                                              B.cols(), " matrices."));
+
+    constexpr std::size_t block_size_kk = 32;
+
+    const std::size_t N_i = A.rows(), N_k = A.cols(), N_j = B.cols();
+
+    Matrix<acc_type> C(N_i, N_j, acc_type());
+
+    _parallel_for(N_i, _min_grain(2 * N_k * N_j), [&](std::size_t low, std::size_t high) {
+        std::vector<acc_type> panel(block_size_kk * N_j);
+
+        for (std::size_t kk = 0; kk < N_k; kk += block_size_kk) {
+            const std::size_t k_extent = std::min(N_k, kk + block_size_kk);
+
+            for (std::size_t k = kk; k < k_extent; ++k)
+                for (std::size_t j = 0; j < N_j; ++j)
+                    panel[(k - kk) * N_j + j] = static_cast<acc_type>(static_cast<widened_t<value_type_r>>(B(k, j)));
+
+            for (std::size_t i = low; i < high; ++i) {
+                acc_type* c_row = C.data() + i * N_j;
+                for (std::size_t k = kk; k < k_extent; ++k) {
+                    const acc_type  a     = static_cast<acc_type>(static_cast<widened_t<value_type_l>>(A(i, k)));
+                    const acc_type* b_row = panel.data() + (k - kk) * N_j;
+                    for (std::size_t j = 0; j < N_j; ++j) c_row[j] += a * b_row[j];
+                }
+            }
+        }
+    });
 
-    return res;
+    return C;
 }
 
-// (2)  dense + sparse =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+// Symmetric per-matrix 'int8' quantization: 'value ~ scale * q' where 'q' is in '[-127, 127]'
+struct QuantizedMatrix {
+    Matrix<std::int8_t> values;
+    float               scale = 1.f;
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+    [[nodiscard]] Matrix<float> dequantize() const {
+        return Matrix<float>(this->values.rows(), this->values.cols(), [&](std::size_t i, std::size_t j) {
+            return this->scale * static_cast<float>(this->values(i, j));
+        });
+    }
+};
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] QuantizedMatrix quantize(const Tensor& tensor) {
+    float max_abs = 0.f;
+    tensor.for_each([&](const value_type& elem) { max_abs = std::max(max_abs, std::abs(static_cast<float>(elem))); });
 
-    // '.for_each()' to only iterate sparse elements
-    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
+    QuantizedMatrix res;
+    res.scale  = (max_abs > 0.f) ? max_abs / 127.f : 1.f;
+    res.values = Matrix<std::int8_t>(tensor.rows(), tensor.cols(), std::int8_t(0));
+
+    tensor.for_each([&](const value_type& elem, std::size_t i, std::size_t j) {
+        const float q    = std::clamp(std::round(static_cast<float>(elem) / res.scale), -127.f, 127.f);
+        res.values(i, j) = static_cast<std::int8_t>(q);
+    });
 
     return res;
 }
 
-// (3) sparse +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<R>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+// y = A * x with 'int8' matrix values widened to 'float' in registers
+template <class T>
+[[nodiscard]] std::vector<float> widened_gemv(const QuantizedMatrix& A, const std::vector<T>& x) {
+    const auto y = widened_gemv(A.values, x);
 
-    using reference = typename std::decay_t<R>::reference;
-    using size_type = typename std::decay_t<R>::size_type;
+    std::vector<float> res(y.size());
+    for (std::size_t i = 0; i < y.size(); ++i) res[i] = A.scale * static_cast<float>(y[i]);
+    return res;
+}
 
-    // Reuse r-value if possible
-    return_type res = std::forward<R>(right);
+// ====================
+// --- Eigensolvers ---
+// ====================
+
+// Dense symmetric eigendecomposition follows the classic 2-stage approach:
+//    1. Householder reflections reduce 'A' to a tridiagonal 'T = Q^T A Q'. Reflection 'H = I - 2 v v^T' acts on the
+//       trailing submatrix as a symmetric rank-2 update 'A -= v w^T + w v^T' where 'w = 2 (p - (v^T p) v)' and
+//       'p = A v'. Reduction is blocked the same way as LAPACK 'sytrd()': reflectors of a panel of columns are
+//       computed with their updates kept aside as 'V' & 'W', the current column and 'p' get corrected on the fly,
+//       and the whole trailing submatrix is updated once per panel as 'A -= V W^T + W V^T'. This halves the number
+//       of passes over 'A' (one matrix-vector product per column + one update per panel instead of both for every
+//       column). Matrix-vector products and panel updates are split between threads by rows.
+//    2. Implicit QL with Wilkinson shifts diagonalizes 'T'. Each QL sweep is a chain of Givens rotations, which
+//       have to be computed sequentially, but their application to eigenvectors is independent for every row of
+//       the eigenvector matrix. Rotations of consecutive sweeps get recorded and then applied to all rows in one
+//       parallel pass once enough of them are accumulated, so threads aren't spawned for every single sweep.
+//
+// Sparse eigenvalues use the Lanczos method, which builds an orthonormal basis 'V' of a Krylov subspace together
+// with a tridiagonal projection 'T = V^T A V' using nothing but matrix-vector products. Extremal eigenvalues of
+// 'T' (Ritz values) converge to extremal eigenvalues of 'A' long before the subspace grows to the full size.
+// In finite precision Lanczos vectors lose orthogonality, which leads to spurious copies of eigenvalues. The
+// simplest robust fix is full reorthogonalization against the whole basis (done twice, "twice is enough"),
+// which costs 'O(n m)' per step but keeps the method reliable for a modest number of requested eigenpairs.
 
-    // '.for_each()' to only iterate sparse elements
-    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
+template <class T>
+struct SymmetricEigen {
+    std::vector<T> values;
+    Matrix<T>      vectors; // column 'k' is an eigenvector corresponding to 'values[k]'
+};
+
+enum class EigenTarget { LARGEST, SMALLEST, LARGEST_MAGNITUDE };
+
+constexpr std::size_t _tridiagonal_panel_size = 32;      // columns reduced before each trailing update
+constexpr std::size_t _ql_rotation_batch       = 1 << 14; // Givens rotations applied to eigenvectors at once
 
+// Diagonalizes symmetric tridiagonal matrix with diagonal 'd' and sub-diagonal 'e' ('e[i]' couples 'i' and 'i + 1')
+// by implicit QL, rotations get accumulated into the columns of 'Z'. 'd' is overwritten by eigenvalues.
+template <class T>
+void _tridiagonal_ql(std::vector<T>& d, std::vector<T>& e, Matrix<T>& Z) {
+    constexpr std::size_t max_iterations = 60;
+
+    const std::size_t n = d.size();
+    if (n == 0) return;
+    e.resize(n);
+    e[n - 1] = T(0);
+
+    // Off-diagonal elements get neglected relative to the norm of 'T', which keeps the result backward stable
+    // even for (nearly) zero eigenvalues where a purely local criterion would never be satisfied
+    T norm = T(0);
+    for (std::size_t i = 0; i < n; ++i) norm = std::max(norm, std::abs(d[i]) + std::abs(e[i]));
+    const T negligible = std::numeric_limits<T>::epsilon() * norm;
+
+    // Rotations are only needed for the eigenvectors, which makes it possible to record several sweeps and apply
+    // them together, rows of 'Z' stay in cache while the whole batch gets applied to them
+    const std::size_t                                batch_size = std::max<std::size_t>(n, _ql_rotation_batch);
+    std::vector<std::pair<T, T>>                     rotations; // (c, s) in order of application
+    std::vector<std::pair<std::size_t, std::size_t>> sweeps;    // (first column, rotation count)
+    rotations.reserve(batch_size + n);
+
+    // Rotation 'r' of a sweep acts on columns 'first - r' and 'first - r + 1', the new value of column 'first - r'
+    // is carried to the next rotation in a register. Every rotation depends on the previous one, so several rows
+    // get processed at once to have independent operations to overlap.
+    const auto apply_rotations_to_rows = [&](auto row_count, std::size_t k) {
+        constexpr std::size_t rows = decltype(row_count)::value;
+
+        std::array<T*, rows> row;
+        for (std::size_t q = 0; q < rows; ++q) row[q] = Z.data() + (k + q) * Z.cols();
+
+        const std::pair<T, T>* rotation = rotations.data();
+        for (const auto& [first, count] : sweeps) {
+            std::array<T, rows> f;
+            for (std::size_t q = 0; q < rows; ++q) f[q] = row[q][first + 1];
+            for (std::size_t r = 0; r < count; ++r, ++rotation) {
+                const auto [c, s] = *rotation;
+                for (std::size_t q = 0; q < rows; ++q) {
+                    const T g             = row[q][first - r];
+                    row[q][first - r + 1] = s * g + c * f[q];
+                    f[q]                  = c * g - s * f[q];
+                }
+            }
+            for (std::size_t q = 0; q < rows; ++q) row[q][first - count + 1] = f[q];
+        }
+    };
+
+    const auto apply_rotations = [&] {
+        _parallel_for(Z.rows(), _min_grain(6 * rotations.size()), [&](std::size_t low, std::size_t high) {
+            std::size_t k = low;
+            for (; k + 4 <= high; k += 4) apply_rotations_to_rows(std::integral_constant<std::size_t, 4>{}, k);
+            for (; k < high; ++k) apply_rotations_to_rows(std::integral_constant<std::size_t, 1>{}, k);
+        });
+        rotations.clear();
+        sweeps.clear();
+    };
+
+    for (std::size_t l = 0; l < n; ++l) {
+        for (std::size_t iteration = 0;; ++iteration) {
+            std::size_t m = l;
+            for (; m + 1 < n; ++m) {
+                if (std::abs(e[m]) <= negligible) break;
+            }
+            if (m == l) break;
+
+            if (iteration == max_iterations)
+                throw std::runtime_error("Symmetric tridiagonal QL failed to converge.");
+
+            // Wilkinson shift
+            T g = (d[l + 1] - d[l]) / (T(2) * e[l]);
+            T r = std::hypot(g, T(1));
+            g   = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+
+            T    s = T(1), c = T(1), p = T(0);
+            bool deflated = false;
+
+            const std::size_t rotations_before = rotations.size();
+            for (std::size_t i = m; i-- > l;) {
+                const T f = s * e[i];
+                const T b = c * e[i];
+                r         = std::hypot(f, g);
+                e[i + 1]  = r;
+                if (r == T(0)) { // underflow, deflate and restart
+                    d[i + 1] -= p;
+                    e[m]     = T(0);
+                    deflated = true;
+                    break;
+                }
+                s        = f / r;
+                c        = g / r;
+                g        = d[i + 1] - p;
+                r        = (d[i] - g) * s + T(2) * c * b;
+                p        = s * r;
+                d[i + 1] = g + p;
+                g        = c * r - b;
+                rotations.emplace_back(c, s);
+            }
+            sweeps.emplace_back(m - 1, rotations.size() - rotations_before);
+            if (rotations.size() >= batch_size) apply_rotations();
+
+            if (deflated) continue;
+            d[l] -= p;
+            e[l] = g;
+            e[m] = T(0);
+        }
+    }
+    apply_rotations();
+}
+
+// Sorts eigenpairs in ascending order of eigenvalues
+template <class T>
+[[nodiscard]] SymmetricEigen<T> _sorted_eigenpairs(const std::vector<T>& values, const Matrix<T>& vectors) {
+    std::vector<std::size_t> order(values.size());
+    for (std::size_t k = 0; k < order.size(); ++k) order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+
+    SymmetricEigen<T> res;
+    res.values.resize(values.size());
+    res.vectors = Matrix<T>(vectors.rows(), values.size());
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        res.values[k] = values[order[k]];
+        for (std::size_t i = 0; i < vectors.rows(); ++i) res.vectors(i, k) = vectors(i, order[k]);
+    }
     return res;
 }
 
-// (4) sparse + sparse => sparse
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+// Full eigendecomposition of a dense symmetric matrix, eigenvalues are sorted in ascending order
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] SymmetricEigen<value_type> symmetric_eigen(const Tensor& tensor) {
+    static_assert(std::is_floating_point_v<value_type>, "Eigensolver requires a floating point type.");
+    using T = value_type;
 
-    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
-    using value_type   = typename std::decay_t<L>::value_type;
+    if (tensor.rows() != tensor.cols())
+        throw std::invalid_argument(stringify("Can't compute eigendecomposition of a non-square ", tensor.rows(), "x",
+                                              tensor.cols(), " matrix."));
 
-    std::vector<sparse_entry> res_triplets;
-    res_triplets.reserve(std::max(left.size(), right.size()));
-    // not enough when matrices have different sparsity patterns, but good enough for initial guess
+    const std::size_t n = tensor.rows();
 
-    std::size_t i = 0, j = 0;
+    Matrix<T> A(n, n, T(0));
+    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { A(i, j) = elem; });
 
-    // Merge sparsity patterns
-    while (i < left.size() && j < right.size()) {
-        // Entry present only in lhs sparsity pattern
-        if (left._data[i] < right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
-        }
-        // Entry present only in rhs sparsity pattern
-        else if (left._data[i] > right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
-        }
-        // Entry present in both sparsity patterns
-        else {
-            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
-                                                                         std::forward<R>(right)._data[j++], op));
+    // 1. Blocked Householder tridiagonalization, reflector 'k' is stored in 'reflectors[k]' (acting on rows 'k + 1...')
+    std::vector<std::vector<T>> reflectors(n > 2 ? n - 2 : 0);
+    std::vector<T>              d(n), e(n), x(n), p(n);
+
+    for (std::size_t panel = 0; panel + 2 < n; panel += _tridiagonal_panel_size) {
+        const std::size_t panel_end = std::min(panel + _tridiagonal_panel_size, n - 2);
+
+        // Reflectors & their 'w' vectors of the current panel, padded with zeros to the full length 'n'.
+        // 'A' doesn't include their updates yet, the current matrix is 'A - V W^T - W V^T'.
+        std::vector<std::vector<T>> V, W;
+
+        for (std::size_t k = panel; k < panel_end; ++k) {
+            const std::size_t size = n - k - 1;
+
+            // Column 'k' of the current matrix
+            d[k] = A(k, k);
+            for (std::size_t r = k + 1; r < n; ++r) x[r] = A(r, k);
+            for (std::size_t j = 0; j < V.size(); ++j) {
+                const T v_k = V[j][k], w_k = W[j][k];
+                d[k] -= T(2) * v_k * w_k;
+                for (std::size_t r = k + 1; r < n; ++r) x[r] -= V[j][r] * w_k + W[j][r] * v_k;
+            }
+
+            T norm = T(0);
+            for (std::size_t r = k + 1; r < n; ++r) norm += x[r] * x[r];
+            norm = std::sqrt(norm);
+
+            const T alpha = (x[k + 1] > T(0)) ? -norm : norm;
+            e[k]          = alpha;
+
+            std::vector<T> v(n, T(0));
+            for (std::size_t r = k + 1; r < n; ++r) v[r] = x[r];
+            v[k + 1] -= alpha;
+
+            T v_norm = T(0);
+            for (const auto& elem : v) v_norm += elem * elem;
+            v_norm = std::sqrt(v_norm);
+
+            if (v_norm == T(0)) { // column is already reduced
+                reflectors[k].assign(size, T(0));
+                continue;
+            }
+            for (auto& elem : v) elem /= v_norm;
+
+            // p = A_sub * v, corrected by the pending updates of the panel
+            _parallel_for(size, _min_grain(2 * size), [&](std::size_t low, std::size_t high) {
+                for (std::size_t r = low; r < high; ++r)
+                    p[k + 1 + r] = _strided_dot(&A(k + 1 + r, k + 1), 1, v.data() + k + 1, size);
+            });
+            for (std::size_t j = 0; j < V.size(); ++j) {
+                const T wv = _strided_dot(W[j].data() + k + 1, 1, v.data() + k + 1, size);
+                const T vv = _strided_dot(V[j].data() + k + 1, 1, v.data() + k + 1, size);
+                for (std::size_t r = k + 1; r < n; ++r) p[r] -= V[j][r] * wv + W[j][r] * vv;
+            }
+
+            // w = 2 (p - (v^T p) v)
+            const T        vp = _strided_dot(v.data() + k + 1, 1, p.data() + k + 1, size);
+            std::vector<T> w(n, T(0));
+            for (std::size_t r = k + 1; r < n; ++r) w[r] = T(2) * (p[r] - vp * v[r]);
+
+            reflectors[k].assign(v.begin() + k + 1, v.end());
+            V.push_back(std::move(v));
+            W.push_back(std::move(w));
         }
+
+        // A_sub -= V W^T + W V^T, a single pass over the trailing submatrix for the whole panel
+        const std::size_t size = n - panel_end;
+        _parallel_for(size, _min_grain(4 * size * V.size()), [&](std::size_t low, std::size_t high) {
+            for (std::size_t r = low; r < high; ++r) {
+                T* row = &A(panel_end + r, panel_end);
+                for (std::size_t j = 0; j < V.size(); ++j) {
+                    const T  v_r = V[j][panel_end + r], w_r = W[j][panel_end + r];
+                    const T* v_j = V[j].data() + panel_end;
+                    const T* w_j = W[j].data() + panel_end;
+                    for (std::size_t c = 0; c < size; ++c) row[c] -= v_r * w_j[c] + w_r * v_j[c];
+                }
+            }
+        });
     }
-    // Copy the rest of lhs (if needed)
-    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
-    // Copy the rest of rhs (if needed)
-    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
 
-    return return_type(left.rows(), left.cols(), std::move(res_triplets));
-}
+    // Last 2x2 block is left as is by the reduction
+    if (n >= 1) d[n - 1] = A(n - 1, n - 1);
+    if (n >= 2) d[n - 2] = A(n - 2, n - 2), e[n - 2] = A(n - 1, n - 2);
 
-// --- Binary operator API ---
-// ---------------------------
+    // Q = H_0 H_1 ... H_{n-3}, accumulated backwards so that each reflector only touches the trailing rows
+    Matrix<T> Z(n, n, T(0));
+    for (std::size_t i = 0; i < n; ++i) Z(i, i) = T(1);
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
-}
+    for (std::size_t k = reflectors.size(); k-- > 0;) {
+        const auto&       v    = reflectors[k];
+        const std::size_t size = v.size();
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
-}
+        _parallel_for(n, _min_grain(4 * size), [&](std::size_t low, std::size_t high) {
+            std::vector<T> t(high - low, T(0)); // t = v^T Z_sub for columns '[low, high)'
+            for (std::size_t r = 0; r < size; ++r) {
+                const T* row = &Z(k + 1 + r, low);
+                for (std::size_t c = 0; c < high - low; ++c) t[c] += v[r] * row[c];
+            }
+            for (std::size_t r = 0; r < size; ++r) {
+                T*      row = &Z(k + 1 + r, low);
+                const T v_r = T(2) * v[r];
+                for (std::size_t c = 0; c < high - low; ++c) row[c] -= v_r * t[c];
+            }
+        });
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                                = typename std::decay_t<L>::value_type,
-          _has_binary_op_multiplies_enable_if<value_type> = true>
-auto elementwise_product(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
+    // 2. Implicit QL on the tridiagonal matrix, rotations get accumulated into 'Q'
+    _tridiagonal_ql(d, e, Z);
+
+    return _sorted_eigenpairs(d, Z);
 }
 
-// --- Augmented assignment operator API ---
-// -----------------------------------------
+// Dot products of 'w' with every vector of the 'basis', summed over fixed-size blocks of elements so that
+// the result doesn't depend on the number of threads
+template <class T>
+void _project_onto_basis(const std::vector<std::vector<T>>& basis, const std::vector<T>& w, std::vector<T>& h) {
+    constexpr std::size_t block_size = 4096;
 
-// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
+    const std::size_t n      = w.size();
+    const std::size_t m      = basis.size();
+    const std::size_t blocks = (n + block_size - 1) / block_size;
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
-L& operator+=(L&& left, R&& right) {
-    return (left = std::move(left) + right);
+    std::vector<T> partial(blocks * m, T(0));
+
+    _parallel_for(blocks, _min_grain(2 * block_size * m), [&](std::size_t low, std::size_t high) {
+        for (std::size_t b = low; b < high; ++b) {
+            const std::size_t first = b * block_size, last = std::min(first + block_size, n);
+            for (std::size_t j = 0; j < m; ++j)
+                partial[b * m + j] = _strided_dot(basis[j].data() + first, 1, w.data() + first, last - first);
+        }
+    });
+
+    h.assign(m, T(0));
+    for (std::size_t b = 0; b < blocks; ++b)
+        for (std::size_t j = 0; j < m; ++j) h[j] += partial[b * m + j];
 }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                               = typename std::decay_t<L>::value_type,
-          _has_assignment_op_minus_enable_if<value_type> = true>
-L& operator-=(L&& left, R&& right) {
-    return (left = std::move(left) - right);
+// w -= V h
+template <class T>
+void _subtract_basis_combination(const std::vector<std::vector<T>>& basis, const std::vector<T>& h,
+                                 std::vector<T>& w) {
+    _parallel_for(w.size(), _min_grain(2 * basis.size()), [&](std::size_t low, std::size_t high) {
+        for (std::size_t j = 0; j < basis.size(); ++j) {
+            const T* v = basis[j].data();
+            for (std::size_t i = low; i < high; ++i) w[i] -= h[j] * v[i];
+        }
+    });
 }
 
-// --- Matrix multiplication ---
-// -----------------------------
+// Finds 'count' extremal eigenpairs of a symmetric 'n x n' operator given by 'matvec(x, y)' which computes 'y = A x'.
+// Eigenpairs are ordered from the most extremal one. Throws if eigenpairs don't converge with Krylov subspace of
+// 'max_dimension' vectors ('0' selects a default dimension).
+template <class T, class MatVec>
+[[nodiscard]] SymmetricEigen<T> lanczos(std::size_t n, MatVec&& matvec, std::size_t count,
+                                        EigenTarget target = EigenTarget::LARGEST, T tolerance = T(1e-10),
+                                        std::size_t max_dimension = 0) {
+    static_assert(std::is_floating_point_v<T>, "Eigensolver requires a floating point type.");
+
+    if (count == 0 || count > n)
+        throw std::invalid_argument(stringify("Can't find ", count, " eigenpairs of a ", n, "x", n, " operator."));
+
+    if (max_dimension == 0) max_dimension = std::max<std::size_t>(16 * count, 128);
+    max_dimension = std::clamp<std::size_t>(max_dimension, count, n);
+
+    // Deterministic pseudo-random starting vectors, any vector with non-zero projections onto the wanted
+    // eigenvectors works, a "random" one is unlikely to be orthogonal to any of them
+    std::uint64_t state       = 0x9E3779B97F4A7C15u;
+    const auto    next_random = [&]() {
+        state += 0x9E3779B97F4A7C15u;
+        std::uint64_t z = state;
+        z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+        z               = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+        return T(z >> 11) * T(0x1.0p-53) - T(0.5);
+    };
 
-// Just like with binary operators, we run into the need to have 4 different implementations:
-//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
-//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
-//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
-//    - (4) sparse + sparse => sparse      (complexity O(N)  )
-//
-// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
-// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
-// an afterthought provided here mainly for convenience and not for actual number crunching usage.
-//
-// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
-// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
+    std::vector<std::vector<T>> basis;
+    std::vector<T>              alpha, beta; // diagonal & sub-diagonal of the projection
+    std::vector<T>              w(n), h, h_pass;
+
+    // Orthogonalizes 'v' against the basis and returns its remaining norm, 'h' accumulates the projections
+    const auto orthogonalize = [&](std::vector<T>& v) -> T {
+        h.assign(basis.size(), T(0));
+        for (int pass = 0; pass < 2; ++pass) {
+            _project_onto_basis(basis, v, h_pass);
+            _subtract_basis_combination(basis, h_pass, v);
+            for (std::size_t j = 0; j < h.size(); ++j) h[j] += h_pass[j];
+        }
+        T norm = T(0);
+        for (const auto& e : v) norm += e * e;
+        return std::sqrt(norm);
+    };
 
-// (1)  dense +  dense =>  dense
-//
-// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
-// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
-// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
-// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
-// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
-// blocking seems to be worth it.
-//
-// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
-//
-template <class L, class R,                                                                                //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
-          class value_type                                  = typename std::decay_t<L>::value_type,        //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
-          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
-          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
-          >
-return_type operator*(const L& left, const R& right) {
-    utl_mvl_assert(left.cols() == right.rows());
+    const auto restart_vector = [&]() {
+        std::vector<T> v(n);
+        for (auto& e : v) e = next_random();
+        T norm = orthogonalize(v);
+        if (norm == T(0)) throw std::runtime_error("Lanczos failed to generate a new basis vector.");
+        for (auto& e : v) e /= norm;
+        return v;
+    };
 
-    using size_type = typename std::decay_t<L>::size_type;
+    basis.reserve(max_dimension);
+    basis.push_back(restart_vector());
+
+    std::vector<T>           ritz_values;
+    Matrix<T>                ritz_vectors;
+    std::vector<std::size_t> selection;
+    T                        scale = T(0);
+
+    const auto compute_ritz_pairs = [&]() {
+        const std::size_t m = alpha.size();
+        ritz_values         = alpha;
+        std::vector<T> e(beta.begin(), beta.begin() + (m - 1));
+        ritz_vectors = Matrix<T>(m, m, T(0));
+        for (std::size_t i = 0; i < m; ++i) ritz_vectors(i, i) = T(1);
+        _tridiagonal_ql(ritz_values, e, ritz_vectors);
+
+        selection.resize(m);
+        for (std::size_t k = 0; k < m; ++k) selection[k] = k;
+        std::stable_sort(selection.begin(), selection.end(), [&](std::size_t a, std::size_t b) {
+            if (target == EigenTarget::LARGEST) return ritz_values[a] > ritz_values[b];
+            if (target == EigenTarget::SMALLEST) return ritz_values[a] < ritz_values[b];
+            return std::abs(ritz_values[a]) > std::abs(ritz_values[b]);
+        });
 
-    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
-    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
+        for (const auto& value : ritz_values) scale = std::max(scale, std::abs(value));
+    };
 
-    constexpr size_type block_size_kk = 32;
+    // Residual of a Ritz pair 'k' is '|beta_m * (last component of the k-th eigenvector of T)|'
+    const auto converged = [&](T last_beta) {
+        if (alpha.size() < count) return false;
+        for (std::size_t k = 0; k < count; ++k) {
+            const T residual = std::abs(last_beta * ritz_vectors(alpha.size() - 1, selection[k]));
+            if (residual > tolerance * std::max(scale, T(1))) return false;
+        }
+        return true;
+    };
 
-    return_type res(N_i, N_j, value_type{});
+    for (;;) {
+        const std::size_t j = basis.size() - 1;
 
-    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
-        const size_type k_extent = std::min(N_k, kk + block_size_kk);
-        // needed for matrices that aren't a multiple of block size
-        for (size_type i = 0; i < N_i; ++i) {
-            for (size_type k = kk; k < k_extent; ++k) {
-                const auto& r = left(i, k);
-                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
-            }
+        std::fill(w.begin(), w.end(), T(0));
+        matvec(basis[j], w);
+
+        // Full reorthogonalization, projection onto the last vector is the diagonal element
+        T norm = orthogonalize(w);
+        alpha.push_back(h[j]);
+
+        const bool basis_is_full = (basis.size() == max_dimension);
+        const bool check = basis_is_full || norm <= tolerance * std::max(scale, T(1)) ||
+                           (alpha.size() >= count && alpha.size() % 8 == 0);
+
+        if (check) {
+            compute_ritz_pairs();
+            // Invariant subspace was found, Ritz pairs are exact
+            if (norm <= std::numeric_limits<T>::epsilon() * std::max(scale, T(1)) * T(n)) norm = T(0);
+            if (converged(norm)) break;
+            if (basis_is_full)
+                throw std::runtime_error(stringify("Lanczos failed to converge ", count, " eigenpairs with ",
+                                                   max_dimension, " basis vectors."));
+        }
+
+        beta.push_back(norm);
+        if (norm == T(0)) basis.push_back(restart_vector()); // decoupled block of 'T'
+        else {
+            for (auto& e : w) e /= norm;
+            basis.push_back(w);
         }
     }
 
-    return res;
-}
+    // Eigenvectors are 'V s_k' for the selected Ritz vectors 's_k'
+    SymmetricEigen<T> res;
+    res.values.resize(count);
+    res.vectors = Matrix<T>(n, count, T(0));
 
-// (2)  dense + sparse =>  dense
+    for (std::size_t k = 0; k < count; ++k) {
+        res.values[k] = ritz_values[selection[k]];
+        for (std::size_t j = 0; j < alpha.size(); ++j) {
+            const T coef = ritz_vectors(j, selection[k]);
+            for (std::size_t i = 0; i < n; ++i) res.vectors(i, k) += coef * basis[j][i];
+        }
+    }
 
-// TODO:
+    return res;
+}
 
-// (3) sparse +  dense =>  dense
+// Lanczos for any 2D tensor (usually a 'SparseMatrix'), matrix-vector product goes over its stored elements
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] SymmetricEigen<value_type> lanczos(const Tensor& A, std::size_t count,
+                                                 EigenTarget target = EigenTarget::LARGEST,
+                                                 value_type tolerance = value_type(1e-10),
+                                                 std::size_t max_dimension = 0) {
+    if (A.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't compute eigenpairs of a non-square ", A.rows(), "x", A.cols(),
+                                              " matrix."));
+
+    const auto matvec = [&](const std::vector<value_type>& x, std::vector<value_type>& y) {
+        if constexpr (std::decay_t<Tensor>::params::type == Type::SPARSE)
+            A.for_each([&](const value_type& elem, std::size_t i, std::size_t j) { y[i] += elem * x[j]; });
+        else gemv(value_type(1), A, x, value_type(0), y);
+    };
 
-// TODO:
+    return lanczos<value_type>(A.rows(), matvec, count, target, tolerance, max_dimension);
+}
 
-// (4) sparse + sparse => sparse
+template <class T, std::size_t block_size>
+[[nodiscard]] SymmetricEigen<T> lanczos(const BSRMatrix<T, block_size>& A, std::size_t count,
+                                        EigenTarget target = EigenTarget::LARGEST, T tolerance = T(1e-10),
+                                        std::size_t max_dimension = 0) {
+    if (A.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't compute eigenpairs of a non-square ", A.rows(), "x", A.cols(),
+                                              " matrix."));
 
-// TODO:
+    const auto matvec = [&](const std::vector<T>& x, std::vector<T>& y) { spmv(A, x, y); };
+    return lanczos<T>(A.rows(), matvec, count, target, tolerance, max_dimension);
+}
 
 // Clear out internal macros
 #undef utl_mvl_tensor_arg_defs
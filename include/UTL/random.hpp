@@ -14,16 +14,22 @@
 
 // _______________________ INCLUDES _______________________
 
+#include <algorithm>        // min(), max(), iter_swap(), sort(), push_heap(), pop_heap()
 #include <array>            // array<>
+#include <atomic>           // atomic<>
 #include <cassert>          // assert()
 #include <chrono>           // high_resolution_clock
 #include <cstdint>          // uint64_t
+#include <exception>        // exception_ptr, current_exception(), rethrow_exception()
 #include <initializer_list> // initializer_list<>
+#include <iterator>         // distance(), next(), advance()
 #include <limits>           // numeric_limits<>::digits, numeric_limits<>::min(), numeric_limits<>::max()
 #include <mutex>            // mutex, lock_guard<>
 #include <random>           // random_device, std::uniform_int_distribution<>,
                             // std::uniform_real_distribution<>, generate_canonical<>
+#include <thread>           // this_thread::get_id(), thread::id, thread, thread::hardware_concurrency()
 #include <type_traits>      // is_integral_v<>
+#include <unordered_set>    // unordered_set<>
 #include <utility>          // declval<>()
 #include <vector>           // vector<>, hash<>
 
@@ -131,6 +137,21 @@ utl_random_define_trait(_is_seed_seq,
 // they will get pick instead of regular seeding methods for even for integer conversions. This is how standard library
 // seems to do it (based on GCC implementation) so we follow their API.
 
+utl_random_define_trait(_has_jump, std::declval<T&>().jump());
+utl_random_define_trait(_has_nonce, std::declval<T&>().set_nonce(std::declval<T&>().get_nonce()));
+utl_random_define_trait(_has_counter, std::declval<T&>().set_counter(std::declval<T&>().get_counter()));
+// used to pick a way of splitting generators into independent streams
+
+utl_random_define_trait(_has_fill, std::declval<T&>().fill(std::declval<typename T::result_type*>(),
+                                                           std::declval<typename T::result_type*>()));
+// generators with a specialized bulk generation
+
+utl_random_define_trait(_has_distribution_fill,
+                        std::declval<const T&>().fill(std::declval<std::minstd_rand&>(),
+                                                      std::declval<typename T::result_type*>(),
+                                                      std::declval<typename T::result_type*>()));
+// distributions with a bulk generation, signature of 'fill()' doesn't depend on the generator type
+
 #undef utl_random_define_trait
 
 template <class>
@@ -211,6 +232,106 @@ constexpr T _default_seed = std::numeric_limits<T>::max() / 2 + 1;
 // an "overall decent" default seed - doesn't gave too many zeroes,
 // unlikely to accidentaly match with a user-defined seed
 
+// Jump function of Xoshiro family, advances 'gen' with state 's' by a number of steps encoded in the
+// 'polynomial', this is equivalent to (but much faster than) calling 'gen()' that many times
+template <class Gen, class T>
+constexpr void _xoshiro_jump(Gen& gen, std::array<T, 4>& s, const std::array<T, 4>& polynomial) noexcept {
+    std::array<T, 4> res{};
+
+    for (const T word : polynomial) {
+        for (int b = 0; b < std::numeric_limits<T>::digits; ++b) {
+            if (word & (T(1) << b))
+                for (std::size_t i = 0; i < res.size(); ++i) res[i] ^= s[i];
+            gen();
+        }
+    }
+
+    s = res;
+}
+
+// Multi-word addition for counters & nonces stored as arrays of 32/64-bit words, least significant word first
+template <class T, std::size_t N>
+constexpr void _add_to_counter(std::array<T, N>& counter, std::uint64_t value, std::size_t first_word = 0) noexcept {
+    static_assert(std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint64_t>);
+
+    for (std::size_t i = first_word; i < N && value; ++i) {
+        if constexpr (std::is_same_v<T, std::uint64_t>) {
+            counter[i] += value;
+            value = counter[i] < value; // carry
+        } else {
+            const std::uint64_t sum = std::uint64_t(counter[i]) + (value & 0xffffffff);
+            counter[i]              = static_cast<std::uint32_t>(sum);
+            value                   = (value >> 32) + (sum >> 32);
+        }
+    }
+}
+
+// --- Constexpr math ---
+// ----------------------
+
+// 'std::exp()', 'std::log()' & 'std::sqrt()' aren't 'constexpr' and their last bit may differ between standard
+// libraries, Ziggurat tables & rare branches of distributions use these instead so generated sequences stay the
+// same on every platform. Accuracy is within a few ULP in the ranges used by distributions.
+
+constexpr double _ln2    = 0.693147180559945309417232121458176568;
+constexpr double _ln2_hi = 6.93147180369123816490e-01; // 'ln(2)' split into exact high part and a low remainder,
+constexpr double _ln2_lo = 1.90821492927058770002e-10; // 'x - k * ln(2)' stays precise for large 'k'
+
+[[nodiscard]] constexpr double _abs(double x) noexcept { return x < 0 ? -x : x; }
+
+[[nodiscard]] constexpr double _exp(double x) noexcept {
+    if (x < -745.) return 0.;
+    if (x > 709.) return std::numeric_limits<double>::infinity();
+
+    // x = k * ln(2) + r, |r| <= ln(2) / 2  =>  exp(x) = 2^k * exp(r)
+    const int    k = static_cast<int>(x / _ln2 + (x < 0 ? -0.5 : 0.5));
+    const double r = (x - k * _ln2_hi) - k * _ln2_lo;
+
+    double term = 1., sum = 1.;
+    for (int n = 1; n < 20; ++n) sum += (term *= r / n); // Taylor series, converges to full precision for |r| < 0.35
+
+    for (int i = 0; i < k; ++i) sum *= 2.;
+    for (int i = 0; i > k; --i) sum *= 0.5;
+    return sum;
+}
+
+[[nodiscard]] constexpr double _log(double x) noexcept {
+    if (x <= 0.) return -std::numeric_limits<double>::infinity();
+
+    // x = m * 2^e, m in [sqrt(2) / 2, sqrt(2))
+    int e = 0;
+    while (x > 1.4142135623730951) x *= 0.5, ++e;
+    while (x < 0.7071067811865476) x *= 2., --e;
+
+    // log(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+    const double s = (x - 1.) / (x + 1.), s2 = s * s;
+
+    double term = s, sum = 0.;
+    for (int n = 1; n < 40; n += 2, term *= s2) sum += term / n;
+
+    return 2. * sum + e * _ln2;
+}
+
+// 'log(1 + x)' that stays precise for tiny 'x', where '1 + x' would round away most (or all) of its bits.
+// Dividing by the rounded 'u - 1' cancels the rounding error of 'u' to first order (D. Goldberg, 1991).
+[[nodiscard]] constexpr double _log1p(double x) noexcept {
+    const double u = 1. + x;
+    if (u == 1.) return x;
+    return _log(u) * (x / (u - 1.));
+}
+
+[[nodiscard]] constexpr double _sqrt(double x) noexcept {
+    if (x <= 0.) return 0.;
+
+    double res = x > 1. ? x : 1.;
+    for (int i = 0; i < 1100; ++i) {
+        const double next = 0.5 * (res + x / res);
+        if (next >= res) break; // Newton iterations decrease monotonically until they converge
+        res = next;
+    }
+    return res;
+}
+
 
 // =========================
 // --- Random Generators ---
@@ -229,6 +350,9 @@ constexpr T _default_seed = std::numeric_limits<T>::max() / 2 + 1;
 
 namespace generators {
 
+template <class Scalar, std::size_t lanes, int shift, int state_rotation, int result_rotation>
+class _xoshiro_lanes; // multi-lane Xoshiro, defined at the end of the namespace, needs access to the scalar state
+
 // --- 16-bit PRNGs ---
 // --------------------
 
@@ -351,6 +475,9 @@ class Xoshiro128PP {
 private:
     std::array<result_type, 4> s{};
 
+    template <class, std::size_t, int, int, int>
+    friend class _xoshiro_lanes;
+
 public:
     constexpr explicit Xoshiro128PP(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
 
@@ -390,6 +517,18 @@ class Xoshiro128PP {
         this->s[3] = _rotl_value(this->s[3], 11);
         return result;
     }
+    // Equivalent to 2^64 calls to 'operator()', can be used to generate 2^64 non-overlapping subsequences
+    constexpr void jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
+
+    // Equivalent to 2^96 calls to 'operator()', can be used to generate 2^32 starting points,
+    // from each of which 'jump()' will generate 2^32 non-overlapping subsequences
+    constexpr void long_jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
 };
 
 // Implementation of 32-bit Romu Trio engine from paper by "Mark A. Overton",
@@ -515,6 +654,9 @@ class Xoshiro256PP {
 private:
     std::array<result_type, 4> s{};
 
+    template <class, std::size_t, int, int, int>
+    friend class _xoshiro_lanes;
+
 public:
     constexpr explicit Xoshiro256PP(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
 
@@ -557,6 +699,20 @@ class Xoshiro256PP {
         this->s[3] = _rotl_value(this->s[3], 45);
         return result;
     }
+    // Equivalent to 2^128 calls to 'operator()', can be used to generate 2^128 non-overlapping subsequences
+    constexpr void jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+                                                           0x39abdc4529b1661c};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
+
+    // Equivalent to 2^192 calls to 'operator()', can be used to generate 2^64 starting points,
+    // from each of which 'jump()' will generate 2^64 non-overlapping subsequences
+    constexpr void long_jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241,
+                                                           0x39109bb02acbe635};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
 };
 
 // Implementation of Romu DuoJr engine from paper by "Mark A. Overton",
@@ -660,6 +816,34 @@ template <std::size_t rounds>
     return state;
 }
 
+// Same rounds applied to several blocks at once, each word of the state is stored as an array over blocks
+// so every quarter-round becomes a set of element-wise operations that can be vectorized
+template <std::size_t rounds, std::size_t blocks>
+[[nodiscard]] constexpr std::array<std::array<std::uint32_t, blocks>, 16>
+_chacha_rounds_multi(const std::array<std::array<std::uint32_t, blocks>, 16>& input) noexcept {
+    auto state = input;
+
+    const auto quarter_round = [&](std::size_t a, std::size_t b, std::size_t c, std::size_t d) {
+        for (std::size_t k = 0; k < blocks; ++k) _quarter_round(state[a][k], state[b][k], state[c][k], state[d][k]);
+    };
+
+    for (std::size_t i = 0; i < rounds / 2; ++i) {
+        quarter_round(0, 4, 8, 12);
+        quarter_round(1, 5, 9, 13);
+        quarter_round(2, 6, 10, 14);
+        quarter_round(3, 7, 11, 15);
+
+        quarter_round(0, 5, 10, 15);
+        quarter_round(1, 6, 11, 12);
+        quarter_round(2, 7, 8, 13);
+        quarter_round(3, 4, 9, 14);
+    }
+
+    for (std::size_t i = 0; i < state.size(); ++i)
+        for (std::size_t k = 0; k < blocks; ++k) state[i][k] += input[i][k];
+    return state;
+}
+
 template <std::size_t rounds>
 class ChaCha {
 public:
@@ -745,12 +929,385 @@ class ChaCha {
         // Get random value from the block and advance position cursor
         return this->block[this->position++];
     }
+    // Block counter & nonce can be used to split the keystream into independent parts: generators with the same key
+    // and different nonces produce unrelated streams of 2^32 blocks, while setting the counter skips to a given block
+    [[nodiscard]] constexpr std::uint32_t get_counter() const noexcept {
+        return this->position >= 16 ? this->counter : this->counter - 1;
+    } // index of the current block, 'this->counter' always points to the next one
+
+    [[nodiscard]] constexpr std::array<std::uint32_t, 3> get_nonce() const noexcept { return this->nonce; }
+
+    constexpr void set_counter(std::uint32_t counter) noexcept {
+        this->counter  = counter;
+        this->position = 0;
+
+        this->generate_new_block();
+    } // discards the rest of the current block
+
+    constexpr void set_nonce(const std::array<std::uint32_t, 3>& nonce) noexcept {
+        this->nonce = nonce;
+        this->set_counter(0);
+    } // restarts the keystream from the first block
+
+    // Same as calling 'operator()' for each element, but computes 'blocks' keystream blocks at a time
+    template <std::size_t blocks = 8, class It>
+    void fill(It first, It last) {
+        static_assert(blocks > 0, "Block count should be positive.");
+
+        auto remaining = static_cast<std::size_t>(std::distance(first, last));
+
+        // Finish the current block
+        for (; remaining && this->position < 16; --remaining, ++first) *first = this->block[this->position++];
+
+        // Generate full groups of blocks, 'this->counter' points to the next block
+        std::array<std::array<std::uint32_t, blocks>, 16> input{};
+        for (std::size_t w = 0; w < 4; ++w) input[w].fill(this->constant[w]);
+        for (std::size_t w = 0; w < 8; ++w) input[4 + w].fill(this->key[w]);
+        for (std::size_t w = 0; w < 3; ++w) input[13 + w].fill(this->nonce[w]);
+
+        for (; remaining >= 16 * blocks; remaining -= 16 * blocks) {
+            for (std::size_t k = 0; k < blocks; ++k) input[12][k] = this->counter + static_cast<std::uint32_t>(k);
+
+            const auto output = _chacha_rounds_multi<rounds>(input);
+            for (std::size_t k = 0; k < blocks; ++k)
+                for (std::size_t w = 0; w < 16; ++w, ++first) *first = output[w][k];
+
+            this->counter += static_cast<std::uint32_t>(blocks);
+        }
+
+        // Leftover values
+        for (; remaining; --remaining, ++first) *first = (*this)();
+    }
 };
 
 using ChaCha8  = ChaCha<8>;
 using ChaCha12 = ChaCha<12>;
 using ChaCha20 = ChaCha<20>;
 
+// --- Counter-based PRNGs ---
+// ---------------------------
+
+// Implementation of Philox & Threefry counter-based PRNGs suggested by J. K. Salmon, M. A. Moraes, R. O. Dror
+// and D. E. Shaw, see https://www.thesalmons.org/john/random123/papers/random123sc11.pdf
+//                     https://github.com/DEShawResearch/random123
+//
+// Performance: Good
+// Quality:     4/5
+// State:       48 / 56 bytes
+//
+// Output is a bijection 'block = f(key, counter)' of a 128-bit counter, which means any position of the
+// sequence can be reached in O(1) by 'set_counter()' / 'discard()'. Generators with different keys or counters
+// can be created for each unit of work (like '{ seed }' + '{ 0, 0, particle_id, step }'), this makes parallel
+// computation bit-reproducible regardless of how the work gets scheduled. Both pass BigCrush with a wide margin.
+//
+// Lower counter words count blocks, 'make_stream()' offsets the upper 64 bits to get independent streams.
+
+// 32x32 -> 64 bit multiplication split into high & low halves
+[[nodiscard]] constexpr std::uint32_t _mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi) noexcept {
+    const std::uint64_t product = std::uint64_t(a) * b;
+    hi                          = static_cast<std::uint32_t>(product >> 32);
+    return static_cast<std::uint32_t>(product);
+}
+
+template <std::size_t rounds>
+[[nodiscard]] constexpr std::array<std::uint32_t, 4>
+_philox4x32_rounds(const std::array<std::uint32_t, 4>& counter, const std::array<std::uint32_t, 2>& key) noexcept {
+    constexpr std::uint32_t multiplier_0 = 0xD2511F53, multiplier_1 = 0xCD9E8D57;
+    constexpr std::uint32_t weyl_0 = 0x9E3779B9, weyl_1 = 0xBB67AE85; // key schedule, golden ratio & sqrt(3) - 1
+
+    // plain locals instead of array elements, this lets compilers keep the whole state in registers
+    std::uint32_t c_0 = counter[0], c_1 = counter[1], c_2 = counter[2], c_3 = counter[3];
+    std::uint32_t k_0 = key[0], k_1 = key[1];
+
+    for (std::size_t i = 0; i < rounds; ++i) {
+        std::uint32_t hi_0 = 0, hi_1 = 0;
+        const auto    lo_0 = _mulhilo(multiplier_0, c_0, hi_0);
+        const auto    lo_1 = _mulhilo(multiplier_1, c_2, hi_1);
+
+        c_0 = hi_1 ^ c_1 ^ k_0, c_1 = lo_1, c_2 = hi_0 ^ c_3 ^ k_1, c_3 = lo_0;
+        k_0 += weyl_0, k_1 += weyl_1;
+    }
+
+    return {c_0, c_1, c_2, c_3};
+}
+
+template <std::size_t rounds>
+[[nodiscard]] constexpr std::array<std::uint64_t, 2> _threefry2x64_rounds(std::array<std::uint64_t, 2> counter,
+                                                                         std::array<std::uint64_t, 2> key) noexcept {
+    static_assert(rounds % 4 == 0, "Threefry injects the key every 4 rounds, total number should be divisible by 4.");
+
+    const std::array<std::uint64_t, 3> schedule = {key[0], key[1], 0x1BD11BDAA9FC1A22 ^ key[0] ^ key[1]};
+
+    const auto mix = [&](int rotation) {
+        counter[0] += counter[1];
+        counter[1] = _rotl_value(counter[1], rotation);
+        counter[1] ^= counter[0];
+    };
+    const auto inject = [&](std::size_t injection) {
+        counter[0] += schedule[injection % 3];
+        counter[1] += schedule[(injection + 1) % 3] + injection;
+    };
+
+    inject(0);
+    for (std::size_t i = 0; i < rounds / 8; ++i) { // rotation constants repeat every 8 rounds
+        mix(16), mix(42), mix(12), mix(31), inject(2 * i + 1);
+        mix(16), mix(32), mix(24), mix(21), inject(2 * i + 2);
+    }
+    if constexpr (rounds % 8) mix(16), mix(42), mix(12), mix(31), inject(rounds / 4);
+
+    return counter;
+}
+
+// Common part of counter-based generators, 'Derived' provides a 'static block_type compute(counter, key)'
+template <class Derived, class T, std::size_t counter_words, std::size_t key_words, std::size_t block_size>
+class _counter_based_generator {
+public:
+    using result_type  = T;
+    using counter_type = std::array<result_type, counter_words>;
+    using key_type     = std::array<result_type, key_words>;
+
+private:
+    key_type                            key{};
+    counter_type                        counter{};  // index of the current block
+    std::array<result_type, block_size> block{};    // holds next 'block_size' random numbers
+    std::size_t                         position{}; // current position in the block
+
+    constexpr void generate_block() noexcept { this->block = Derived::compute(this->counter, this->key); }
+
+public:
+    constexpr explicit _counter_based_generator(result_type seed = _default_seed<result_type>) noexcept {
+        this->seed(seed);
+    }
+
+    constexpr explicit _counter_based_generator(const key_type& key, const counter_type& counter = {}) noexcept
+        : key(key), counter(counter) {
+        this->generate_block();
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit _counter_based_generator(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        // Use some other PRNG to setup the key
+        if constexpr (sizeof(result_type) == 4) {
+            SplitMix32 splitmix{seed};
+            for (auto& e : this->key) e = splitmix();
+        } else {
+            SplitMix64 splitmix{seed};
+            for (auto& e : this->key) e = splitmix();
+        }
+        this->set_counter({});
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        // Seed sequence allows user to introduce more entropy into the key
+        std::array<std::uint32_t, sizeof(key_type) / 4> temp{};
+        seq.generate(temp.begin(), temp.end());
+
+        if constexpr (sizeof(result_type) == 4) {
+            for (std::size_t i = 0; i < key_words; ++i) this->key[i] = temp[i];
+        } else {
+            for (std::size_t i = 0; i < key_words; ++i)
+                this->key[i] = _merge_uint32_into_uint64(temp[2 * i], temp[2 * i + 1]);
+        }
+        this->set_counter({});
+    }
+
+    constexpr result_type operator()() noexcept {
+        // Generate new block if necessary
+        if (this->position >= block_size) {
+            _add_to_counter(this->counter, 1);
+            this->generate_block();
+            this->position = 0;
+        }
+
+        // Get random value from the block and advance position cursor
+        return this->block[this->position++];
+    }
+
+    // Random access, all of these are O(1)
+    [[nodiscard]] constexpr const key_type& get_key() const noexcept { return this->key; }
+
+    [[nodiscard]] constexpr counter_type get_counter() const noexcept {
+        auto res = this->counter;
+        if (this->position >= block_size) _add_to_counter(res, 1);
+        return res;
+    } // index of the block next value comes from
+
+    constexpr void set_key(const key_type& key) noexcept {
+        this->key = key;
+        this->set_counter({});
+    } // restarts the sequence from the first block
+
+    constexpr void set_counter(const counter_type& counter) noexcept {
+        this->counter  = counter;
+        this->position = 0;
+
+        this->generate_block();
+    } // next value is the first one of the block 'counter'
+
+    constexpr void discard(unsigned long long n) noexcept {
+        std::uint64_t blocks = n / block_size;
+        this->position += n % block_size;
+        if (this->position >= block_size) this->position -= block_size, ++blocks;
+
+        if (!blocks) return;
+        _add_to_counter(this->counter, blocks);
+        this->generate_block();
+    } // same as calling 'operator()' 'n' times
+
+    // Same as calling 'operator()' for each element, but whole blocks are written directly to the output
+    template <class It>
+    void fill(It first, It last) {
+        auto remaining = static_cast<std::size_t>(std::distance(first, last));
+
+        // Finish the current block
+        for (; remaining && this->position < block_size; --remaining, ++first) *first = this->block[this->position++];
+
+        // Generate full blocks, block stored in the state stays consumed
+        for (; remaining >= block_size; remaining -= block_size) {
+            _add_to_counter(this->counter, 1);
+            for (const auto& e : Derived::compute(this->counter, this->key)) *first = e, ++first;
+        }
+
+        // Leftover values
+        for (; remaining; --remaining, ++first) *first = (*this)();
+    }
+};
+
+template <std::size_t rounds>
+class Philox4x32R : public _counter_based_generator<Philox4x32R<rounds>, std::uint32_t, 4, 2, 4> {
+public:
+    using _counter_based_generator<Philox4x32R<rounds>, std::uint32_t, 4, 2, 4>::_counter_based_generator;
+
+    [[nodiscard]] static constexpr std::array<std::uint32_t, 4> compute(const std::array<std::uint32_t, 4>& counter,
+                                                                        const std::array<std::uint32_t, 2>& key) {
+        return _philox4x32_rounds<rounds>(counter, key);
+    }
+};
+
+template <std::size_t rounds>
+class Threefry2x64R : public _counter_based_generator<Threefry2x64R<rounds>, std::uint64_t, 2, 2, 2> {
+public:
+    using _counter_based_generator<Threefry2x64R<rounds>, std::uint64_t, 2, 2, 2>::_counter_based_generator;
+
+    [[nodiscard]] static constexpr std::array<std::uint64_t, 2> compute(const std::array<std::uint64_t, 2>& counter,
+                                                                        const std::array<std::uint64_t, 2>& key) {
+        return _threefry2x64_rounds<rounds>(counter, key);
+    }
+};
+
+using Philox4x32   = Philox4x32R<10>;
+using Threefry2x64 = Threefry2x64R<20>;
+
+// --- Multi-lane PRNGs ---
+// ------------------------
+
+// Several Xoshiro generators stepped in lockstep, state is stored lane-by-lane ("structure of arrays") so each step
+// is a handful of element-wise operations over 'lanes' values, which compilers turn into SIMD instructions.
+//
+// Lane 'k' produces the same sequence as 'make_stream(Scalar{seed}, k)', values are returned interleaved
+// '{ lane_0[0], lane_1[0], ..., lane_0[1], lane_1[1], ... }'. Speedup comes from bulk generation with 'fill()',
+// single values are served from a buffer of 'lanes' values.
+//
+template <class Scalar, std::size_t lanes, int shift, int state_rotation, int result_rotation>
+class _xoshiro_lanes {
+public:
+    using result_type = typename Scalar::result_type;
+
+private:
+    using lane_array = std::array<result_type, lanes>;
+
+    std::array<lane_array, 4> s{};
+    lane_array                block{};          // holds next 'lanes' random numbers
+    std::size_t               position = lanes; // current position in the block
+
+    constexpr void seed_lanes(Scalar master) noexcept {
+        for (std::size_t k = 0; k < lanes; ++k, master.jump())
+            for (std::size_t i = 0; i < 4; ++i) this->s[i][k] = master.s[i];
+        this->position = lanes;
+    }
+
+    static constexpr void step(std::array<lane_array, 4>& state, lane_array& result) noexcept {
+        for (std::size_t k = 0; k < lanes; ++k)
+            result[k] = _rotl_value(state[0][k] + state[3][k], result_rotation) + state[0][k];
+
+        for (std::size_t k = 0; k < lanes; ++k) {
+            const result_type t = state[1][k] << shift;
+            state[2][k] ^= state[0][k];
+            state[3][k] ^= state[1][k];
+            state[1][k] ^= state[2][k];
+            state[0][k] ^= state[3][k];
+            state[2][k] ^= t;
+            state[3][k] = _rotl_value(state[3][k], state_rotation);
+        }
+    } // takes state explicitly so bulk generation can keep a local copy in registers
+
+public:
+    static_assert(lanes > 0, "Lane count should be positive.");
+
+    constexpr explicit _xoshiro_lanes(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit _xoshiro_lanes(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept { this->seed_lanes(Scalar{seed}); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->seed_lanes(Scalar{seq});
+    }
+
+    constexpr result_type operator()() noexcept {
+        if (this->position >= lanes) {
+            step(this->s, this->block);
+            this->position = 0;
+        }
+        return this->block[this->position++];
+    }
+
+    // Same as calling 'operator()' for each element
+    template <class It>
+    constexpr void fill(It first, It last) noexcept {
+        // Finish the current block
+        for (; first != last && this->position < lanes; ++first) *first = this->block[this->position++];
+
+        // Full blocks
+        auto       remaining = static_cast<std::size_t>(std::distance(first, last));
+        auto       state     = this->s;
+        lane_array result{};
+        for (; remaining >= lanes; remaining -= lanes) {
+            step(state, result);
+            for (std::size_t k = 0; k < lanes; ++k, ++first) *first = result[k];
+        }
+        this->s = state;
+
+        // Leftover values
+        for (; remaining; --remaining, ++first) *first = (*this)();
+    }
+};
+
+template <std::size_t lanes>
+using Xoshiro128PPLanes = _xoshiro_lanes<Xoshiro128PP, lanes, 9, 11, 7>;
+template <std::size_t lanes>
+using Xoshiro256PPLanes = _xoshiro_lanes<Xoshiro256PP, lanes, 17, 45, 23>;
+
+using Xoshiro128PPx4 = Xoshiro128PPLanes<4>;
+using Xoshiro128PPx8 = Xoshiro128PPLanes<8>;
+using Xoshiro256PPx4 = Xoshiro256PPLanes<4>;
+using Xoshiro256PPx8 = Xoshiro256PPLanes<8>;
+
 
 } // namespace generators
 
@@ -763,6 +1320,101 @@ using default_result_type    = default_generator_type::result_type;
 
 inline default_generator_type default_generator;
 
+// --- Parallel streams ---
+// ------------------------
+
+// Splits 'master' into independent streams, stream '0' is the 'master' itself:
+//    - Xoshiro generators advance by 'index' jumps, streams don't overlap for the first 2^128 / 2^64 values;
+//    - ChaCha generators keep the key and offset the 96-bit nonce by 'index', streams are unrelated keystreams;
+//    - counter-based generators keep the key and offset the upper 64 bits of the counter by 'index', each stream
+//      has 2^64 blocks.
+// Jumps are O(index), which is fine for a per-thread (or per-task) split.
+template <class Gen>
+[[nodiscard]] constexpr Gen make_stream(Gen master, std::uint64_t index) noexcept {
+    if constexpr (_has_jump_v<Gen>) {
+        for (; index; --index) master.jump();
+    } else if constexpr (_has_nonce_v<Gen>) {
+        if (!index) return master;
+        auto nonce = master.get_nonce();
+        _add_to_counter(nonce, index);
+        master.set_nonce(nonce);
+    } else if constexpr (_has_counter_v<Gen>) {
+        if (!index) return master;
+        auto counter = master.get_counter();
+        _add_to_counter(counter, index, counter.size() / 2);
+        master.set_counter(counter);
+    } else {
+        static_assert(_always_false_v<Gen>, "Generator doesn't support splitting into independent streams.");
+    }
+    return master;
+}
+
+// Thread-local generators: the main thread keeps using 'default_generator' directly (stream 0), other threads
+// get their own generators derived from the state 'default_generator' had at the last 'random::seed()' call.
+// Stream indices are either given out in order of the first use (after each seeding) or set explicitly with
+// 'set_thread_stream()', the latter gives reproducible per-thread sequences for a given seed.
+struct _stream_state {
+    default_generator_type     master;
+    std::atomic<std::uint64_t> epoch{1};      // incremented by each seeding, makes threads re-derive their streams
+    std::atomic<std::uint64_t> next_index{1}; // stream 0 is reserved for the main thread
+};
+
+struct _thread_stream {
+    default_generator_type  generator;
+    default_generator_type* active      = nullptr;
+    std::uint64_t           epoch       = 0; // 0 => needs to be derived on the next use
+    std::uint64_t           index       = 0;
+    bool                    fixed_index = false;
+};
+
+inline _stream_state               _streams;
+inline thread_local _thread_stream _this_thread_stream;
+inline const std::thread::id       _main_thread_id = std::this_thread::get_id();
+
+inline void _start_stream_epoch() noexcept {
+    _streams.master = default_generator;
+    _streams.next_index.store(1, std::memory_order_relaxed);
+    _streams.epoch.fetch_add(1, std::memory_order_release);
+}
+
+inline void _derive_thread_stream(_thread_stream& stream, std::uint64_t epoch) noexcept {
+    const bool is_main_thread = (std::this_thread::get_id() == _main_thread_id);
+
+    if (!stream.fixed_index)
+        stream.index = is_main_thread ? 0 : _streams.next_index.fetch_add(1, std::memory_order_relaxed);
+
+    // Only the main thread may use 'default_generator' directly, other threads asking for stream 0 get a copy
+    if (stream.index || !is_main_thread) {
+        stream.generator = make_stream(_streams.master, stream.index);
+        stream.active    = &stream.generator;
+    } else {
+        stream.active = &default_generator;
+    }
+
+    stream.epoch = epoch;
+}
+
+inline default_generator_type& thread_generator() noexcept {
+    _thread_stream&     stream = _this_thread_stream;
+    const std::uint64_t epoch  = _streams.epoch.load(std::memory_order_acquire);
+    if (stream.epoch != epoch) _derive_thread_stream(stream, epoch);
+    return *stream.active;
+}
+
+inline void set_thread_stream(std::uint64_t index) noexcept {
+    _this_thread_stream.index       = index;
+    _this_thread_stream.fixed_index = true;
+    _this_thread_stream.epoch       = 0;
+}
+
+[[nodiscard]] inline std::uint64_t thread_stream_index() noexcept {
+    thread_generator(); // ensures the index was assigned
+    return _this_thread_stream.index;
+}
+
+// --- Entropy & seeding ---
+// -------------------------
+
 inline std::seed_seq entropy_seq() {
     // Ensure thread safery of our entropy source, it should generally work fine even without
     // it, but with this we can be sure things never race
@@ -809,18 +1461,111 @@ inline std::uint32_t entropy() {
     // Also having one 'random::entropy()' is much nicer than 'random::entropy_32()' & 'random::entropy_64()'.
 }
 
-inline void seed(default_result_type random_seed) noexcept { default_generator.seed(random_seed); }
+// Seeding also resets thread-local streams, this shouldn't be done concurrently with generating values
+inline void seed(default_result_type random_seed) noexcept {
+    default_generator.seed(random_seed);
+    _start_stream_epoch();
+}
 
 inline void seed_with_entropy() {
     auto seq = entropy_seq();
     default_generator.seed(seq);
     // for some god-forsaken reason seeding sequence constructors std:: generators take only l-value sequences
+    _start_stream_epoch();
 }
 
 // =====================
 // --- Distributions ---
 // =====================
 
+// --- Bulk generation ---
+// -----------------------
+
+// Fills '[first, last)' with raw generator output, same as calling 'gen()' for each element,
+// multi-lane & ChaCha generators provide faster specialized implementations
+template <class Gen, class It>
+void fill(Gen& gen, It first, It last) {
+    if constexpr (_has_fill_v<Gen>) {
+        gen.fill(first, last);
+    } else {
+        Gen local = gen;
+        for (; first != last; ++first) *first = local();
+        gen = local;
+    } // output can alias generator state as far as the compiler knows, a local copy lets it stay in registers
+}
+
+// Generator adaptor that serves values of 'gen' from a buffer filled in bulk. Every output of a distribution
+// takes at least one value, so refilling the buffer with no more values than there are outputs left never
+// takes values that the repeated 'dist(gen)' wouldn't, distributions using this produce the exact same sequence
+// and leave 'gen' in the same state.
+template <class Gen, std::size_t capacity = 256>
+class _bulk_source {
+public:
+    using result_type = typename Gen::result_type;
+
+private:
+    Gen&                              gen;
+    std::array<result_type, capacity> buffer;
+    std::size_t                       cursor = 0;
+    std::size_t                       size   = 0;
+    std::size_t                       outputs_left;
+
+public:
+    _bulk_source(Gen& gen, std::size_t outputs) noexcept : gen(gen), outputs_left(outputs) {}
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return Gen::min(); }
+    [[nodiscard]] static constexpr result_type max() noexcept { return Gen::max(); }
+
+    result_type operator()() {
+        if (this->cursor == this->size) {
+            this->size   = std::min(capacity, this->outputs_left);
+            this->cursor = 0;
+            random::fill(this->gen, this->buffer.begin(), this->buffer.begin() + this->size);
+        }
+        return this->buffer[this->cursor++];
+    }
+
+    void next_output() noexcept { --this->outputs_left; }
+};
+
+template <class Dist, class Gen, class It>
+void _fill_with_distribution(const Dist& dist, Gen& gen, It first, It last) {
+    _bulk_source<Gen> source(gen, static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first, source.next_output()) *first = dist(source);
+}
+
+// Distributions that always take exactly one generator value per output can be applied to a buffer
+// of raw values in a separate loop, this keeps both loops simple enough to vectorize
+template <class Gen>
+struct _single_value_source {
+    using result_type = typename Gen::result_type;
+
+    result_type value;
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return Gen::min(); }
+    [[nodiscard]] static constexpr result_type max() noexcept { return Gen::max(); }
+
+    constexpr result_type operator()() const noexcept { return this->value; }
+};
+
+template <class Dist, class Gen, class It>
+void _fill_with_single_value_distribution(const Dist& dist, Gen& gen, It first, It last) {
+    constexpr std::size_t capacity = 256;
+
+    std::array<typename Gen::result_type, capacity> buffer;
+
+    for (auto remaining = static_cast<std::size_t>(std::distance(first, last)); remaining;) {
+        const std::size_t size = std::min(capacity, remaining);
+        random::fill(gen, buffer.begin(), buffer.begin() + size);
+
+        for (std::size_t i = 0; i < size; ++i, ++first) {
+            _single_value_source<Gen> source{buffer[i]};
+            *first = dist(source);
+        }
+        remaining -= size;
+    }
+}
+
 // --- Uniform int distribution ---
 // --------------------------------
 
@@ -958,6 +1703,12 @@ struct UniformIntDistribution {
         return _generate_uniform_int<result_type>(gen, p.min, p.max);
     } // for std-compatibility
 
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
+    }
+
     constexpr result_type               reset() const noexcept {} // nothing to reset, provided for std-compatibility
     [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
     constexpr void                      params(const param_type& p) noexcept { *this = UniformIntDistribution(p); }
@@ -1040,6 +1791,15 @@ constexpr T _generate_canonical_generic(Gen& gen) noexcept(noexcept(gen())) {
     return res / factor;
 }
 
+// Whether 'generate_canonical<T>()' below takes exactly one value of 'Gen', which is true for the bit-uniform
+// special cases, except for 64-bit floats made from 32-bit values
+template <class T, class Gen>
+constexpr bool _canonical_takes_single_value = (Gen::max() - Gen::min() ==
+                                                std::numeric_limits<typename Gen::result_type>::max()) &&
+                                               (sizeof(T) == 4 || sizeof(T) == 8) &&
+                                               (sizeof(typename Gen::result_type) == 8 ||
+                                                (sizeof(typename Gen::result_type) == 4 && sizeof(T) == 4));
+
 // Wrapper that adds special case optimizations for `_generate_canonical_generic<>()'
 template <class T, class Gen>
 constexpr T generate_canonical(Gen& gen) noexcept(noexcept(gen())) {
@@ -1118,6 +1878,14 @@ struct UniformRealDistribution {
         return p.min + generate_canonical<result_type>(gen) * (p.max - p.min);
     } // for std-compatibility
 
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        if constexpr (_canonical_takes_single_value<result_type, Gen>)
+            _fill_with_single_value_distribution(*this, gen, first, last);
+        else _fill_with_distribution(*this, gen, first, last);
+    }
+
     constexpr result_type reset() const noexcept {} // there is nothing to reset, provided for std-API compatibility
     constexpr param_type  params() const noexcept { return this->pars; }
     constexpr void        params(const param_type& p) noexcept { *this = UniformRealDistribution(p); }
@@ -1132,6 +1900,1487 @@ constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRe
     return lhs.a() == rhs.a() && lhs.b() == rhs.b();
 }
 
+// --- Ziggurat method ---
+// -----------------------
+
+// Ziggurat method by G. Marsaglia & W. W. Tsang in the ZIGNOR form suggested by J. A. Doornik,
+// see https://www.jstatsoft.org/article/view/v005i08
+//     https://www.doornik.com/research/ziggurat.pdf
+//
+// Area under the density 'f(x)' is covered by 'layers' horizontal layers of equal area 'v', the bottom one also
+// includes the tail past 'r'. Layer 'i' spans 'f(x[i]) <= y < f(x[i + 1])', 'x' decreases from 'x[0] = v / f(r)'
+// and 'x[1] = r' to 'x[layers] = 0'. A sample picks a random layer and a random point 'u * x[i]' inside of it,
+// which is accepted right away in ~99% of cases ('u < x[i + 1] / x[i]'), otherwise it either falls into the tail
+// or gets accepted/rejected based on 'f(x)'.
+//
+// Tables are computed at compile-time, common path takes a single 64-bit generator value: top 53 bits give 'u',
+// low bits give the layer index.
+template <std::size_t layers>
+struct _ziggurat_table {
+    std::array<double, layers + 1> x{}; // layer widths
+    std::array<double, layers + 1> f{}; // density at 'x[i]'
+    std::array<double, layers>     r{}; // x[i + 1] / x[i]
+};
+
+template <std::size_t layers, class Density, class InverseDensity>
+[[nodiscard]] constexpr _ziggurat_table<layers> _make_ziggurat_table(double r, double v, Density density,
+                                                                     InverseDensity inverse_density) noexcept {
+    _ziggurat_table<layers> table;
+
+    table.x[0]      = v / density(r);
+    table.x[1]      = r;
+    table.x[layers] = 0.;
+    for (std::size_t i = 2; i < layers; ++i) table.x[i] = inverse_density(v / table.x[i - 1] + density(table.x[i - 1]));
+
+    for (std::size_t i = 0; i <= layers; ++i) table.f[i] = density(table.x[i]);
+    for (std::size_t i = 0; i < layers; ++i) table.r[i] = table.x[i + 1] / table.x[i];
+
+    return table;
+}
+
+// Normal: f(x) = exp(-x^2 / 2) (unnormalized), 128 layers
+constexpr double _ziggurat_normal_r = 3.442619855899;
+constexpr double _ziggurat_normal_v = 9.91256303526217e-3;
+
+constexpr auto _ziggurat_normal = _make_ziggurat_table<128>(
+    _ziggurat_normal_r, _ziggurat_normal_v, [](double x) { return _exp(-0.5 * x * x); },
+    [](double y) { return _sqrt(-2. * _log(y)); });
+
+// Exponential: f(x) = exp(-x), 256 layers
+constexpr double _ziggurat_exponential_r = 7.69711747013104972;
+constexpr double _ziggurat_exponential_v = 3.949659822581572e-3;
+
+constexpr auto _ziggurat_exponential = _make_ziggurat_table<256>(
+    _ziggurat_exponential_r, _ziggurat_exponential_v, [](double x) { return _exp(-x); },
+    [](double y) { return -_log(y); });
+
+// 64 uniformly distributed bits in a platform-independent way
+template <class Gen>
+constexpr std::uint64_t _generate_uint64(Gen& gen) noexcept(noexcept(gen())) {
+    using generated_type = typename Gen::result_type;
+
+    constexpr bool prng_is_bit_uniform = (Gen::max() - Gen::min() == std::numeric_limits<generated_type>::max());
+
+    if constexpr (prng_is_bit_uniform && sizeof(generated_type) == 8) {
+        return gen();
+    } else if constexpr (prng_is_bit_uniform && sizeof(generated_type) == 4) {
+        const std::uint32_t low = gen();
+        return _merge_uint32_into_uint64(low, gen());
+    } else {
+        return _generate_uniform_int<std::uint64_t>(gen, 0, std::numeric_limits<std::uint64_t>::max());
+    }
+}
+
+// Open interval (0, 1], used to take logarithms
+template <class Gen>
+constexpr double _generate_open_canonical(Gen& gen) noexcept(noexcept(gen())) {
+    return 1. - generate_canonical<double>(gen);
+}
+
+// Standard normal variate N(0, 1)
+template <class Gen>
+constexpr double _generate_normal_ziggurat(Gen& gen) noexcept(noexcept(gen())) {
+    constexpr auto&  table = _ziggurat_normal;
+    constexpr double r     = _ziggurat_normal_r;
+
+    while (true) {
+        const std::uint64_t bits = _generate_uint64(gen);
+        const double        u    = 2. * ((bits >> 11) * 0x1.0p-53) - 1.; // [-1, 1)
+        const std::size_t   i    = bits & 0x7f;                           // [0, 128)
+
+        // Inside the rectangle
+        if (_abs(u) < table.r[i]) return u * table.x[i];
+
+        // Tail, see G. Marsaglia "Generating a variable from the tail of the normal distribution" (1964)
+        if (i == 0) {
+            double x = 0., y = 0.;
+            do {
+                x = -_log(_generate_open_canonical(gen)) / r;
+                y = -_log(_generate_open_canonical(gen));
+            } while (2. * y < x * x);
+            return u < 0. ? -(r + x) : r + x;
+        }
+
+        // Wedge
+        const double x = u * table.x[i];
+        const double y = table.f[i] + generate_canonical<double>(gen) * (table.f[i + 1] - table.f[i]);
+        if (y < _exp(-0.5 * x * x)) return x;
+    }
+}
+
+// Standard exponential variate Exp(1)
+template <class Gen>
+constexpr double _generate_exponential_ziggurat(Gen& gen) noexcept(noexcept(gen())) {
+    constexpr auto&  table = _ziggurat_exponential;
+    constexpr double r     = _ziggurat_exponential_r;
+
+    double offset = 0.; // exponential distribution is memoryless, tail is just another sample shifted by 'r'
+
+    while (true) {
+        const std::uint64_t bits = _generate_uint64(gen);
+        const double        u    = (bits >> 11) * 0x1.0p-53; // [0, 1)
+        const std::size_t   i    = bits & 0xff;              // [0, 256)
+
+        // Inside the rectangle
+        if (u < table.r[i]) return offset + u * table.x[i];
+
+        // Tail
+        if (i == 0) {
+            offset += r;
+            continue;
+        }
+
+        // Wedge
+        const double x = u * table.x[i];
+        const double y = table.f[i] + generate_canonical<double>(gen) * (table.f[i + 1] - table.f[i]);
+        if (y < _exp(-x)) return offset + x;
+    }
+}
+
+// --- Normal distribution ---
+// ---------------------------
+
+template <class T = double, _require<std::is_floating_point_v<T>> = true>
+struct NormalDistribution {
+    using result_type = T;
+
+    struct param_type {
+        result_type mean   = 0;
+        result_type stddev = 1;
+    };
+
+    constexpr NormalDistribution() = default;
+    constexpr NormalDistribution(T mean, T stddev) noexcept : pars({mean, stddev}) { assert(stddev > 0); }
+    constexpr NormalDistribution(const param_type& p) noexcept : pars(p) { assert(p.stddev > 0); }
+
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        return (*this)(gen, this->pars);
+    }
+
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
+        return p.mean + p.stddev * static_cast<result_type>(_generate_normal_ziggurat(gen));
+    } // for std-compatibility
+
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
+    }
+
+    constexpr void                      reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
+    constexpr void                      params(const param_type& p) noexcept { *this = NormalDistribution(p); }
+    [[nodiscard]] constexpr param_type  param() const noexcept { return this->pars; } // for std-compatibility
+    constexpr void                      param(const param_type& p) noexcept { this->params(p); }
+    [[nodiscard]] constexpr result_type mean() const noexcept { return this->pars.mean; }
+    [[nodiscard]] constexpr result_type stddev() const noexcept { return this->pars.stddev; }
+    [[nodiscard]] constexpr result_type min() const noexcept { return std::numeric_limits<result_type>::lowest(); }
+    [[nodiscard]] constexpr result_type max() const noexcept { return std::numeric_limits<result_type>::max(); }
+
+private:
+    param_type pars{};
+};
+
+template <class T>
+constexpr bool operator==(const NormalDistribution<T>& lhs, const NormalDistribution<T>& rhs) noexcept {
+    return lhs.mean() == rhs.mean() && lhs.stddev() == rhs.stddev();
+}
+
+// --- Exponential distribution ---
+// --------------------------------
+
+template <class T = double, _require<std::is_floating_point_v<T>> = true>
+struct ExponentialDistribution {
+    using result_type = T;
+
+    struct param_type {
+        result_type lambda = 1;
+    };
+
+    constexpr ExponentialDistribution() = default;
+    constexpr explicit ExponentialDistribution(T lambda) noexcept : pars({lambda}) { assert(lambda > 0); }
+    constexpr ExponentialDistribution(const param_type& p) noexcept : pars(p) { assert(p.lambda > 0); }
+
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        return (*this)(gen, this->pars);
+    }
+
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
+        return static_cast<result_type>(_generate_exponential_ziggurat(gen)) / p.lambda;
+    } // for std-compatibility
+
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
+    }
+
+    constexpr void                      reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
+    constexpr void                      params(const param_type& p) noexcept { *this = ExponentialDistribution(p); }
+    [[nodiscard]] constexpr param_type  param() const noexcept { return this->pars; } // for std-compatibility
+    constexpr void                      param(const param_type& p) noexcept { this->params(p); }
+    [[nodiscard]] constexpr result_type lambda() const noexcept { return this->pars.lambda; }
+    [[nodiscard]] constexpr result_type min() const noexcept { return 0; }
+    [[nodiscard]] constexpr result_type max() const noexcept { return std::numeric_limits<result_type>::max(); }
+
+private:
+    param_type pars{};
+};
+
+template <class T>
+constexpr bool operator==(const ExponentialDistribution<T>& lhs, const ExponentialDistribution<T>& rhs) noexcept {
+    return lhs.lambda() == rhs.lambda();
+}
+
+// --- Discrete distribution ---
+// -----------------------------
+
+// Alias method by A. J. Walker with the numerically stable construction by M. D. Vose,
+// see https://www.keithschwarz.com/darts-dice-coins/
+//
+// Every category 'i' gets a bucket of equal probability '1 / n' that holds either only 'i' or 'i' with probability
+// 'threshold' and its 'alias' otherwise. Buckets are built by distributing excess mass of "large" categories into
+// "small" ones in O(n), after that sampling a value takes one uniform integer and one uniform real regardless of 'n'.
+template <class T>
+struct _alias_bucket {
+    double threshold; // stored together with the alias so sampling touches a single cache line
+    T      alias;
+};
+
+template <class T = int, _require<std::is_integral_v<T>> = true>
+struct DiscreteDistribution {
+    using result_type = T;
+
+    struct param_type {
+        std::vector<double> weights;
+    };
+
+    DiscreteDistribution() : DiscreteDistribution({1.}) {}
+
+    template <class It>
+    DiscreteDistribution(It first, It last) : pars{std::vector<double>(first, last)} {
+        this->rebuild();
+    }
+
+    DiscreteDistribution(std::initializer_list<double> weights)
+        : DiscreteDistribution(weights.begin(), weights.end()) {}
+
+    DiscreteDistribution(const param_type& p) : pars(p) { this->rebuild(); }
+
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        assert(!this->outdated && "Weights were changed without a 'rebuild()'");
+
+        const auto  index  = _generate_uniform_int<std::size_t>(gen, 0, this->buckets.size() - 1);
+        const auto& bucket = this->buckets[index];
+        return generate_canonical<double>(gen) < bucket.threshold ? static_cast<result_type>(index) : bucket.alias;
+    }
+
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
+    }
+
+    // Changes a single weight, several weights can be changed before rebuilding the table once
+    void set_weight(std::size_t index, double weight) noexcept {
+        assert(index < this->pars.weights.size());
+        assert(weight >= 0);
+
+        this->pars.weights[index] = weight;
+        this->outdated            = true;
+    }
+
+    // Rebuilds the table in O(n) reusing existing storage, must be called after 'set_weight()'
+    void rebuild() {
+        const std::size_t n = this->pars.weights.size();
+
+        assert(n > 0);
+        assert(n - 1 <= static_cast<std::size_t>(std::numeric_limits<result_type>::max()));
+
+        double sum = 0;
+        for (const auto& weight : this->pars.weights) {
+            assert(weight >= 0);
+            sum += weight;
+        }
+        assert(sum > 0);
+
+        // Scaled probabilities 'n * p[i]' have an average of 1, categories below it are "small", rest are "large"
+        this->buckets.resize(n);
+
+        const double scale = n / sum;
+        for (std::size_t i = 0; i < n; ++i) this->buckets[i] = {this->pars.weights[i] * scale, static_cast<T>(i)};
+
+        // Instead of keeping worklists we sweep the table with two cursors, one for small & one for large categories.
+        // This gives the same O(n) complexity, but mostly sequential memory access, which matters for large tables.
+        const auto next = [&](std::size_t i, bool small) {
+            while (i < n && (this->buckets[i].threshold < 1.) != small) ++i;
+            return i;
+        };
+
+        std::size_t small = next(0, true), large = next(0, false), current = small;
+
+        while (current < n && large < n) {
+            this->buckets[current].alias = static_cast<result_type>(large);
+
+            // large category donates the mass missing from the small bucket and possibly becomes small itself
+            double& remaining = this->buckets[large].threshold;
+            remaining         = (remaining + this->buckets[current].threshold) - 1.;
+
+            if (remaining < 1. && large < small) { // small cursor has already passed it, fill this bucket right away
+                current = large;
+                large   = next(large + 1, false);
+                continue;
+            }
+            if (remaining < 1.) large = next(large + 1, false);
+            current = small = next(small + 1, true);
+        }
+
+        // leftover categories have probabilities of '1' up to rounding errors
+        for (std::size_t i = 0; i < n; ++i)
+            if (this->buckets[i].alias == static_cast<result_type>(i)) this->buckets[i].threshold = 1.;
+
+        this->outdated = false;
+    }
+
+    template <class It>
+    void rebuild(It first, It last) {
+        this->pars.weights.assign(first, last);
+        this->rebuild();
+    }
+
+    [[nodiscard]] std::vector<double> probabilities() const {
+        double sum = 0;
+        for (const auto& weight : this->pars.weights) sum += weight;
+
+        std::vector<double> res = this->pars.weights;
+        for (auto& e : res) e /= sum;
+        return res;
+    }
+
+    constexpr void                  reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] const param_type& params() const noexcept { return this->pars; }
+    void                            params(const param_type& p) { this->rebuild(p.weights.begin(), p.weights.end()); }
+    [[nodiscard]] std::size_t       size() const noexcept { return this->pars.weights.size(); }
+    [[nodiscard]] result_type       min() const noexcept { return 0; }
+    [[nodiscard]] result_type       max() const noexcept { return static_cast<result_type>(this->size() - 1); }
+
+private:
+    param_type                    pars;
+    std::vector<_alias_bucket<T>> buckets;
+    bool                          outdated = false;
+};
+
+template <class T>
+bool operator==(const DiscreteDistribution<T>& lhs, const DiscreteDistribution<T>& rhs) {
+    return lhs.probabilities() == rhs.probabilities();
+}
+
+// ===========================
+// --- Parallel generation ---
+// ===========================
+
+// Output is split into blocks of a fixed size, block 'b' gets generated by 'make_stream(master, b)' with a fresh
+// copy of the distribution. Values depend only on their position in the output, so any partitioning between
+// threads (or between separate 'fill_chunk()' calls) produces the same result.
+//
+// Streams have to be O(1) to derive, which leaves counter-based & ChaCha generators. Seed-based overloads use
+// 'Philox4x32' with the 64-bit seed as a key.
+//
+// Modules are supposed to stay independent, so we can't reuse 'utl::parallel' here, 'parallel_fill()' uses a minimal
+// static split over 'std::thread', while 'fill_chunk()' is a building block for other schedulers (like tasks of
+// 'utl::parallel'). Exceptions thrown by the workers are rethrown in the calling thread after all workers are joined.
+
+constexpr std::size_t _parallel_fill_block_size = 1024;
+
+template <class Gen>
+constexpr bool _has_constant_time_streams_v = _has_counter_v<Gen> || _has_nonce_v<Gen>;
+
+[[nodiscard]] constexpr generators::Philox4x32 _parallel_master(std::uint64_t seed) noexcept {
+    return generators::Philox4x32({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+}
+
+template <class Func>
+void _parallel_for(std::size_t count, std::size_t min_grain, std::size_t thread_count, Func&& func) {
+    // 'func(low, high)' gets called for a set of contiguous ranges covering [0, count)
+    if (!thread_count) thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    thread_count = std::max<std::size_t>(std::min(thread_count, count / std::max<std::size_t>(min_grain, 1)), 1);
+
+    if (thread_count == 1) {
+        if (count) func(std::size_t(0), count);
+        return;
+    }
+
+    const auto chunk_low = [&](std::size_t t) { return count * t / thread_count; };
+    // keeps chunk sizes within 1 element of each other
+
+    std::vector<std::exception_ptr> exceptions(thread_count);
+    std::vector<std::thread>        workers;
+    workers.reserve(thread_count - 1);
+
+    const auto run_chunk = [&](std::size_t t) {
+        try {
+            func(chunk_low(t), chunk_low(t + 1));
+        } catch (...) { exceptions[t] = std::current_exception(); }
+    };
+
+    for (std::size_t t = 1; t < thread_count; ++t) workers.emplace_back(run_chunk, t);
+    run_chunk(0); // calling thread takes the first chunk instead of idling
+
+    for (auto& worker : workers) worker.join();
+    for (const auto& e : exceptions)
+        if (e) std::rethrow_exception(e);
+}
+
+// Fills elements '[offset, offset + count)' of the output sequence, 'first' points to the element 'offset'
+template <class It, class Dist, class Gen>
+void _fill_blocks(It first, std::size_t offset, std::size_t count, const Dist& dist, const Gen& master) {
+    constexpr std::size_t block_size = _parallel_fill_block_size;
+
+    for (std::size_t i = offset, end = offset + count; i < end;) {
+        const std::size_t block      = i / block_size;
+        const std::size_t block_last = std::min((block + 1) * block_size, end);
+
+        Gen  gen        = make_stream(master, block);
+        Dist block_dist = dist; // standard distributions may cache values, each block starts from a clean copy
+
+        for (std::size_t skipped = block * block_size; skipped < i; ++skipped) static_cast<void>(block_dist(gen));
+
+        if constexpr (_has_distribution_fill_v<Dist>) {
+            const auto block_first = first;
+            std::advance(first, block_last - i);
+            block_dist.fill(gen, block_first, first);
+        } else {
+            for (std::size_t j = i; j < block_last; ++j, ++first) *first = block_dist(gen);
+        }
+        i = block_last;
+    }
+}
+
+template <class It, class Dist, class Gen, _require<_has_constant_time_streams_v<Gen>> = true>
+void fill_chunk(It first, It last, const Dist& dist, const Gen& master, std::size_t offset) {
+    _fill_blocks(first, offset, static_cast<std::size_t>(std::distance(first, last)), dist, master);
+}
+
+template <class It, class Dist>
+void fill_chunk(It first, It last, const Dist& dist, std::uint64_t seed, std::size_t offset) {
+    fill_chunk(first, last, dist, _parallel_master(seed), offset);
+}
+
+template <class It, class Dist, class Gen, _require<_has_constant_time_streams_v<Gen>> = true>
+void parallel_fill(It first, It last, const Dist& dist, const Gen& master, std::size_t thread_count = 0) {
+    constexpr std::size_t block_size = _parallel_fill_block_size;
+
+    const auto        count  = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t blocks = (count + block_size - 1) / block_size;
+
+    // threads get contiguous ranges of whole blocks, splitting further than a few blocks isn't worth it
+    _parallel_for(blocks, 16, thread_count, [&](std::size_t block_low, std::size_t block_high) {
+        const std::size_t low = block_low * block_size, high = std::min(block_high * block_size, count);
+        _fill_blocks(std::next(first, low), low, high - low, dist, master);
+    });
+}
+
+template <class It, class Dist>
+void parallel_fill(It first, It last, const Dist& dist, std::uint64_t seed, std::size_t thread_count = 0) {
+    parallel_fill(first, last, dist, _parallel_master(seed), thread_count);
+}
+
+// ================
+// --- Sampling ---
+// ================
+
+// --- Shuffle ---
+// ---------------
+
+// Fisher-Yates shuffle with batched random indices by N. Brackett-Rozinsky & D. Lemire,
+// see https://arxiv.org/abs/2408.06213
+//
+// Lemire's method maps a 64-bit random value 'r' to '[0, b)' as the upper half of 128-bit product 'r * b', the lower
+// half is still uniformly distributed and can be reused for the next bound. As long as the product of bounds 'P'
+// fits into 64 bits, a single generator value produces several indices, rejection is needed only if the final low
+// half is below '2^64 mod P', which is rare for 'P' much smaller than '2^64'. Sequences are the same on every
+// platform, unlike 'std::shuffle()' which is implementation-defined.
+
+// 64x64 -> 128 bit multiplication split into high & low halves
+[[nodiscard]] constexpr std::uint64_t _mulhilo(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128; // '__extension__' silences pedantic warnings about '__int128'
+
+    const uint128 product = uint128(a) * b;
+    hi                    = static_cast<std::uint64_t>(product >> 64);
+    return static_cast<std::uint64_t>(product);
+#else
+    const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+    const std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+
+    const std::uint64_t lo_lo = a_lo * b_lo, lo_hi = a_lo * b_hi, hi_lo = a_hi * b_lo, hi_hi = a_hi * b_hi;
+    const std::uint64_t cross = (lo_lo >> 32) + (lo_hi & 0xffffffff) + (hi_lo & 0xffffffff);
+
+    hi = hi_hi + (lo_hi >> 32) + (hi_lo >> 32) + (cross >> 32);
+    return a * b;
+#endif
+}
+
+constexpr std::size_t _max_index_batch = 6;
+
+// Fills 'indices[i]' with uniform values in '[0, bound - i)' for 'i < batch'
+template <std::size_t batch, class Gen>
+constexpr void _generate_index_batch(Gen& gen, std::uint64_t bound,
+                                     std::array<std::uint64_t, _max_index_batch>& indices) noexcept(noexcept(gen())) {
+    static_assert(0 < batch && batch <= _max_index_batch);
+
+    std::uint64_t product = bound;
+    for (std::size_t i = 1; i < batch; ++i) product *= bound - i;
+
+    while (true) {
+        std::uint64_t low = _generate_uint64(gen);
+        for (std::size_t i = 0; i < batch; ++i) low = _mulhilo(low, bound - i, indices[i]);
+
+        if (low >= product || low >= (0 - product) % product) return; // '(0 - P) % P' is '2^64 mod P'
+    }
+}
+
+// Swaps elements 'i - 1', 'i - 2', ..., 'i - batch' with random elements preceding them
+template <std::size_t batch, class RandomIt, class Gen>
+void _shuffle_batch(RandomIt first, std::uint64_t i, Gen& gen) {
+    std::array<std::uint64_t, _max_index_batch> indices{};
+    _generate_index_batch<batch>(gen, i, indices);
+    for (std::size_t k = 0; k < batch; ++k) std::iter_swap(first + (i - 1 - k), first + indices[k]);
+}
+
+// Uniform index in '[0, bound)'
+template <class Gen>
+constexpr std::uint64_t _uniform_index(Gen& gen, std::uint64_t bound) noexcept(noexcept(gen())) {
+    std::array<std::uint64_t, _max_index_batch> indices{};
+    _generate_index_batch<1>(gen, bound, indices);
+    return indices[0];
+}
+
+template <class RandomIt, class Gen>
+void shuffle(RandomIt first, RandomIt last, Gen& gen) {
+    auto i = static_cast<std::uint64_t>(std::distance(first, last));
+
+    // huge ranges take one generator value per index
+    for (; i > (std::uint64_t(1) << 30); --i) std::iter_swap(first + (i - 1), first + _uniform_index(gen, i));
+
+    // smaller bounds allow larger batches while keeping the product below 2^64,
+    // batch sizes are compile-time constants so the inner loops get fully unrolled
+    for (; i > (1 << 19); i -= 2) _shuffle_batch<2>(first, i, gen);
+    for (; i > (1 << 14); i -= 3) _shuffle_batch<3>(first, i, gen);
+    for (; i > (1 << 11); i -= 4) _shuffle_batch<4>(first, i, gen);
+    for (; i > (1 << 9); i -= 5) _shuffle_batch<5>(first, i, gen);
+    for (; i > 6; i -= 6) _shuffle_batch<6>(first, i, gen);
+    for (; i > 1; --i) _shuffle_batch<1>(first, i, gen);
+}
+
+// --- Sampling without replacement ---
+// ------------------------------------
+
+// Floyd's algorithm, see J. Bentley & B. Floyd "Programming pearls: a sample of brilliance" (1987).
+// Takes exactly 'k' generator calls regardless of 'n', sparse samples use a hash set to track taken indices,
+// dense samples use a bitmap.
+template <class Gen>
+std::vector<std::size_t> sample_indices(std::size_t n, std::size_t k, Gen& gen) {
+    assert(k <= n);
+
+    std::vector<std::size_t> res;
+    res.reserve(k);
+
+    const auto floyd = [&](auto&& is_taken, auto&& take) {
+        for (std::size_t j = n - k; j < n; ++j) {
+            const std::size_t t      = _uniform_index(gen, j + 1);
+            const std::size_t chosen = is_taken(t) ? j : t; // 'j' can't be taken yet, all previous picks are below it
+            take(chosen);
+            res.push_back(chosen);
+        }
+    };
+
+    if (k > n / 16) {
+        std::vector<bool> taken(n);
+        floyd([&](std::size_t i) { return bool(taken[i]); }, [&](std::size_t i) { taken[i] = true; });
+    } else {
+        std::unordered_set<std::size_t> taken;
+        taken.reserve(k);
+        floyd([&](std::size_t i) { return taken.count(i) != 0; }, [&](std::size_t i) { taken.insert(i); });
+    }
+
+    return res;
+} // each k-subset is equally likely, order of the indices isn't random
+
+template <class RandomIt, class OutIt, class Gen>
+OutIt sample(RandomIt first, RandomIt last, OutIt out, std::size_t k, Gen& gen) {
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+
+    auto indices = sample_indices(n, std::min(k, n), gen);
+    std::sort(indices.begin(), indices.end()); // preserve relative order like 'std::sample()' does
+
+    for (const auto& index : indices) *out = first[index], ++out;
+    return out;
+}
+
+// --- Reservoir sampling ---
+// --------------------------
+
+// Number of values Algorithm L skips before the next replacement, 'u' is uniform in (0, 1). For tiny 'w' the skip
+// is huge, so 'log(1 - w)' has to be computed without rounding '1 - w' to 1. Skips that don't fit (including
+// non-finite ones after 'w' underflows to 0) saturate to 'limit'.
+[[nodiscard]] constexpr std::uint64_t _reservoir_skip(double u, double w, std::uint64_t limit) noexcept {
+    const double gap = _log(u) / _log1p(-w);
+    if (!(gap >= 0. && gap < 0x1p64)) return limit; // also catches NaN
+    return std::min(static_cast<std::uint64_t>(gap), limit);
+}
+
+// Algorithm L by K.-H. Li, see https://dl.acm.org/doi/10.1145/198429.198435
+//
+// Keeps a uniform sample of 'size' values out of a stream of unknown length. Instead of drawing a random number
+// for every value it computes how many values to skip until the next replacement, which takes O(k (1 + log(n / k)))
+// generator calls in total. Logarithms use 'constexpr' implementations to stay platform-independent.
+template <class T>
+class ReservoirSampler {
+    std::size_t    size;
+    std::vector<T> reservoir;
+    std::uint64_t  seen = 0;
+    std::uint64_t  next = 0; // index of the next value that replaces something in the reservoir
+    double         w    = 1;
+
+    template <class Gen>
+    void advance_w(Gen& gen) {
+        this->w *= _exp(_log(_generate_open_canonical(gen)) / this->size);
+    }
+
+    template <class Gen>
+    void schedule_next(Gen& gen) {
+        const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() - this->seen - 1;
+        this->next                = this->seen + 1 + _reservoir_skip(_generate_open_canonical(gen), this->w, limit);
+    }
+
+public:
+    explicit ReservoirSampler(std::size_t size) : size(size) {
+        assert(size > 0);
+        this->reservoir.reserve(size);
+    }
+
+    template <class Gen>
+    void push(const T& value, Gen& gen) {
+        if (this->reservoir.size() < this->size) {
+            this->reservoir.push_back(value);
+            if (this->reservoir.size() == this->size) this->advance_w(gen), this->schedule_next(gen);
+        } else if (this->seen == this->next) {
+            this->reservoir[_uniform_index(gen, this->size)] = value;
+            this->advance_w(gen), this->schedule_next(gen);
+        }
+        ++this->seen;
+    }
+
+    [[nodiscard]] const std::vector<T>& values() const noexcept { return this->reservoir; }
+    [[nodiscard]] std::uint64_t         count() const noexcept { return this->seen; }
+};
+
+// Algorithm A-Res by P. S. Efraimidis & P. G. Spirakis, see https://doi.org/10.1016/j.ipl.2005.11.003
+//
+// Every value gets a key 'u^(1 / weight)', the sample consists of 'size' values with the largest keys, which are
+// kept in a min-heap. Keys are stored as logarithms 'log(u) / weight' to avoid underflow for large weights.
+template <class T>
+class WeightedReservoirSampler {
+    struct entry {
+        double key;
+        T      value;
+    };
+
+    std::size_t        size;
+    std::vector<entry> heap;
+    std::uint64_t      seen = 0;
+
+    static bool greater_key(const entry& lhs, const entry& rhs) noexcept { return lhs.key > rhs.key; }
+
+public:
+    explicit WeightedReservoirSampler(std::size_t size) : size(size) {
+        assert(size > 0);
+        this->heap.reserve(size);
+    }
+
+    template <class Gen>
+    void push(const T& value, double weight, Gen& gen) {
+        assert(weight >= 0);
+
+        ++this->seen;
+        if (weight == 0) return; // values with zero weight are never selected
+
+        const double key = _log(_generate_open_canonical(gen)) / weight;
+
+        if (this->heap.size() < this->size) {
+            this->heap.push_back({key, value});
+            std::push_heap(this->heap.begin(), this->heap.end(), greater_key);
+        } else if (key > this->heap.front().key) {
+            std::pop_heap(this->heap.begin(), this->heap.end(), greater_key);
+            this->heap.back() = {key, value};
+            std::push_heap(this->heap.begin(), this->heap.end(), greater_key);
+        }
+    }
+
+    [[nodiscard]] std::vector<T> values() const {
+        std::vector<T> res;
+        res.reserve(this->heap.size());
+        for (const auto& e : this->heap) res.push_back(e.value);
+        return res;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return this->seen; }
+};
+
+// --- Parallel shuffle ---
+// ------------------------
+
+// MergeShuffle by A. Bacher, O. Bodini, A. Hollender & J. Lumbroso, see https://arxiv.org/abs/1508.03167
+//
+// Blocks of the range are shuffled independently, after which neighbouring shuffled blocks get merged level by level:
+// merge takes elements from the left or right part based on random bits, once one part runs out the rest is inserted
+// with Fisher-Yates steps. Every block & merge uses its own stream derived from its position in the merge tree,
+// so the result doesn't depend on the number of threads.
+
+constexpr std::size_t _merge_shuffle_block_size = std::size_t(1) << 16;
+
+template <class RandomIt, class Gen>
+void _merge_shuffled(RandomIt first, RandomIt middle, RandomIt last, Gen& gen) {
+    RandomIt i = first, j = middle;
+
+    std::uint64_t bits      = 0;
+    std::size_t   bits_left = 0;
+
+    while (true) {
+        if (!bits_left) bits = _generate_uint64(gen), bits_left = 64;
+        const bool take_right = bits & 1;
+        bits >>= 1, --bits_left;
+
+        if (take_right) {
+            if (j == last) break;
+            std::iter_swap(i, j);
+            ++j;
+        } else if (i == j) break;
+        ++i;
+    }
+
+    for (; i != last; ++i) {
+        const auto position = static_cast<std::uint64_t>(i - first);
+        std::iter_swap(i, first + _uniform_index(gen, position + 1));
+    }
+}
+
+template <class RandomIt, class Gen>
+void _merge_shuffle(RandomIt first, RandomIt last, const Gen& master, std::size_t thread_count,
+                    std::size_t block_size) {
+    const auto        n      = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t blocks = (n + block_size - 1) / block_size;
+
+    _parallel_for(blocks, 1, thread_count, [&](std::size_t low, std::size_t high) {
+        for (std::size_t b = low; b < high; ++b) {
+            Gen gen = make_stream(master, b);
+            shuffle(first + b * block_size, first + std::min((b + 1) * block_size, n), gen);
+        }
+    });
+
+    std::uint64_t stream_offset = blocks; // merges use streams after the ones of the blocks
+    for (std::size_t width = block_size; width < n; width *= 2) {
+        const std::size_t merges = (n + 2 * width - 1) / (2 * width);
+
+        _parallel_for(merges, 1, thread_count, [&](std::size_t low, std::size_t high) {
+            for (std::size_t m = low; m < high; ++m) {
+                const std::size_t lo = m * 2 * width, mid = std::min(lo + width, n), hi = std::min(lo + 2 * width, n);
+                if (mid == hi) continue;
+
+                Gen gen = make_stream(master, stream_offset + m);
+                _merge_shuffled(first + lo, first + mid, first + hi, gen);
+            }
+        });
+
+        stream_offset += merges;
+    }
+}
+
+template <class RandomIt, class Gen, _require<_has_constant_time_streams_v<Gen>> = true>
+void parallel_shuffle(RandomIt first, RandomIt last, const Gen& master, std::size_t thread_count = 0) {
+    _merge_shuffle(first, last, master, thread_count, _merge_shuffle_block_size);
+}
+
+template <class RandomIt>
+void parallel_shuffle(RandomIt first, RandomIt last, std::uint64_t seed, std::size_t thread_count = 0) {
+    parallel_shuffle(first, last, _parallel_master(seed), thread_count);
+}
+
+// ==============================
+// --- Quasi-random sequences ---
+// ==============================
+
+// Low-discrepancy sequences fill '[0, 1)^d' much more evenly than independent random points, which makes
+// quasi-Monte Carlo integration converge close to O(1 / N) instead of O(1 / sqrt(N)) for smooth enough integrands.
+// All sequences share the same interface:
+//    > 'next(out)' writes a single 'd'-dimensional point
+//    > 'fill(first, last)' writes several points contiguously, point after point
+//    > 'seek(index)' & 'discard(n)' jump to arbitrary index, which allows splitting the sequence between threads
+//    > 'scramble(gen)' applies a randomization that preserves the low-discrepancy structure
+
+// Converts fixed-point fraction '[0, 2^64)' to '[0, 1)', rounds down to avoid producing '1'
+template <class T>
+[[nodiscard]] constexpr T _fixed_point_to_unit(std::uint64_t x) noexcept {
+    constexpr int bits = std::numeric_limits<T>::digits;
+    return static_cast<T>(x >> (64 - bits)) * (T(1) / static_cast<T>(std::uint64_t(1) << bits));
+}
+
+template <class Sequence, class OutIt>
+void _fill_points(Sequence& sequence, OutIt first, OutIt last) {
+    assert(std::distance(first, last) % sequence.dimensions() == 0);
+    while (first != last) first = sequence.next(first);
+}
+
+// --- Sobol sequence ---
+// ----------------------
+
+// Sobol sequence in base 2, see I. M. Sobol "On the distribution of points in a cube and the approximate evaluation of
+// integrals" (1967) & S. Joe, F. Y. Kuo "Constructing Sobol sequences with better two-dimensional projections" (2008).
+//
+// Dimension 'j' is defined by a primitive polynomial over GF(2) and its initial direction numbers, points are generated
+// in Gray code order where every next point is a single XOR of a direction number per dimension. Jumping to index 'n'
+// XORs direction numbers of set bits of 'gray(n)', which takes at most 32 operations per dimension.
+//
+// Default parameters use primitive polynomials in order of increasing degree (same order as the Joe-Kuo tables).
+// First 481 dimensions (all polynomials up to degree 12) take their initial direction numbers from the
+// 'new-joe-kuo-6.21201' table, which has optimized 2D projections & matches reference implementations.
+// Dimensions past the table fall back onto direction numbers drawn from a fixed-seed generator, custom tables
+// can be passed through 'SobolParameters'. Scrambling applies a random linear matrix scramble (J. Matousek 1998)
+// followed by a random digital shift, both preserve the (t, s)-net properties of the sequence.
+
+struct SobolParameters {
+    std::uint32_t              degree;       // 's' in Joe-Kuo tables
+    std::uint32_t              coefficients; // 'a' in Joe-Kuo tables, inner coefficients of the polynomial
+    std::vector<std::uint32_t> initial;      // 'm_i' in Joe-Kuo tables, 'degree' odd values with 'm_i < 2^i'
+};
+
+constexpr std::size_t _sobol_bits = 32;
+
+// Multiplication of polynomials over GF(2) modulo 'modulus' of the given degree
+[[nodiscard]] constexpr std::uint64_t _gf2_mulmod(std::uint64_t a, std::uint64_t b, std::uint64_t modulus,
+                                                  std::uint32_t degree) noexcept {
+    std::uint64_t res = 0;
+    for (; b; b >>= 1) {
+        if (b & 1) res ^= a;
+        a <<= 1;
+        if (a >> degree) a ^= modulus;
+    }
+    return res;
+}
+
+[[nodiscard]] constexpr std::uint64_t _gf2_powmod(std::uint64_t power, std::uint64_t modulus,
+                                                  std::uint32_t degree) noexcept {
+    std::uint64_t res = 1, base = 2; // 'base' is polynomial 'x'
+    for (; power; power >>= 1) {
+        if (power & 1) res = _gf2_mulmod(res, base, modulus, degree);
+        base = _gf2_mulmod(base, base, modulus, degree);
+    }
+    return res;
+}
+
+// Polynomial of degree 's' is primitive when 'x' has multiplicative order '2^s - 1' modulo it
+[[nodiscard]] constexpr bool _is_primitive_gf2(std::uint64_t polynomial, std::uint32_t degree) noexcept {
+    const std::uint64_t order = (std::uint64_t(1) << degree) - 1;
+    if (_gf2_powmod(order, polynomial, degree) != 1) return false;
+
+    std::uint64_t rest = order;
+    for (std::uint64_t q = 2; q * q <= rest; ++q) {
+        if (rest % q) continue;
+        if (_gf2_powmod(order / q, polynomial, degree) == 1) return false;
+        while (rest % q == 0) rest /= q;
+    }
+    return rest == 1 || _gf2_powmod(order / rest, polynomial, degree) != 1;
+}
+
+// Initial direction numbers 'm_i' of dimensions 2 to 481 from the 'new-joe-kuo-6.21201' table, stored back to back.
+// Polynomials aren't stored since they follow the enumeration order below, degree of each entry is known from it.
+constexpr std::size_t _joe_kuo_dimensions = 481;
+
+constexpr std::uint16_t _joe_kuo_initial[] = {
+    1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, 3, 3, 1, 3, 5, 13, 1, 1, 5, 5, 17, 1, 1, 5, 5, 5, 1, 1, 7, 11, 19, 1, 1, 5, 1, 1,
+    1, 1, 1, 3, 11, 1, 3, 5, 5, 31, 1, 3, 3, 9, 7, 49, 1, 1, 1, 15, 21, 21, 1, 3, 1, 13, 27, 49, 1, 1, 1, 15, 7, 5, 1,
+    3, 1, 15, 13, 25, 1, 1, 5, 5, 19, 61, 1, 3, 7, 11, 23, 15, 103, 1, 3, 7, 13, 13, 15, 69, 1, 1, 3, 13, 7, 35, 63, 1,
+    3, 5, 9, 1, 25, 53, 1, 3, 1, 13, 9, 35, 107, 1, 3, 1, 5, 27, 61, 31, 1, 1, 5, 11, 19, 41, 61, 1, 3, 5, 3, 3, 13, 69,
+    1, 1, 7, 13, 1, 19, 1, 1, 3, 7, 5, 13, 19, 59, 1, 1, 3, 9, 25, 29, 41, 1, 3, 5, 13, 23, 1, 55, 1, 3, 7, 3, 13, 59,
+    17, 1, 3, 1, 3, 5, 53, 69, 1, 1, 5, 5, 23, 33, 13, 1, 1, 7, 7, 1, 61, 123, 1, 1, 7, 9, 13, 61, 49, 1, 3, 3, 5, 3,
+    55, 33, 1, 3, 1, 15, 31, 13, 49, 245, 1, 3, 5, 15, 31, 59, 63, 97, 1, 3, 1, 11, 11, 11, 77, 249, 1, 3, 1, 11, 27,
+    43, 71, 9, 1, 1, 7, 15, 21, 11, 81, 45, 1, 3, 7, 3, 25, 31, 65, 79, 1, 3, 1, 1, 19, 11, 3, 205, 1, 1, 5, 9, 19, 21,
+    29, 157, 1, 3, 7, 11, 1, 33, 89, 185, 1, 3, 3, 3, 15, 9, 79, 71, 1, 3, 7, 11, 15, 39, 119, 27, 1, 1, 3, 1, 11, 31,
+    97, 225, 1, 1, 1, 3, 23, 43, 57, 177, 1, 3, 7, 7, 17, 17, 37, 71, 1, 3, 1, 5, 27, 63, 123, 213, 1, 1, 3, 5, 11, 43,
+    53, 133, 1, 3, 5, 5, 29, 17, 47, 173, 479, 1, 3, 3, 11, 3, 1, 109, 9, 69, 1, 1, 1, 5, 17, 39, 23, 5, 343, 1, 3, 1,
+    5, 25, 15, 31, 103, 499, 1, 1, 1, 11, 11, 17, 63, 105, 183, 1, 1, 5, 11, 9, 29, 97, 231, 363, 1, 1, 5, 15, 19, 45,
+    41, 7, 383, 1, 3, 7, 7, 31, 19, 83, 137, 221, 1, 1, 1, 3, 23, 15, 111, 223, 83, 1, 1, 5, 13, 31, 15, 55, 25, 161, 1,
+    1, 3, 13, 25, 47, 39, 87, 257, 1, 1, 1, 11, 21, 53, 125, 249, 293, 1, 1, 7, 11, 11, 7, 57, 79, 323, 1, 1, 5, 5, 17,
+    13, 81, 3, 131, 1, 1, 7, 13, 23, 7, 65, 251, 475, 1, 3, 5, 1, 9, 43, 3, 149, 11, 1, 1, 3, 13, 31, 13, 13, 255, 487,
+    1, 3, 3, 1, 5, 63, 89, 91, 127, 1, 1, 3, 3, 1, 19, 123, 127, 237, 1, 1, 5, 7, 23, 31, 37, 243, 289, 1, 1, 5, 11, 17,
+    53, 117, 183, 491, 1, 1, 1, 5, 1, 13, 13, 209, 345, 1, 1, 3, 15, 1, 57, 115, 7, 33, 1, 3, 1, 11, 7, 43, 81, 207,
+    175, 1, 3, 1, 1, 15, 27, 63, 255, 49, 1, 3, 5, 3, 27, 61, 105, 171, 305, 1, 1, 5, 3, 1, 3, 57, 249, 149, 1, 1, 3, 5,
+    5, 57, 15, 13, 159, 1, 1, 1, 11, 7, 11, 105, 141, 225, 1, 3, 3, 5, 27, 59, 121, 101, 271, 1, 3, 5, 9, 11, 49, 51,
+    59, 115, 1, 1, 7, 1, 23, 45, 125, 71, 419, 1, 1, 3, 5, 23, 5, 105, 109, 75, 1, 1, 7, 15, 7, 11, 67, 121, 453, 1, 3,
+    7, 3, 9, 13, 31, 27, 449, 1, 3, 1, 15, 19, 39, 39, 89, 15, 1, 1, 1, 1, 1, 33, 73, 145, 379, 1, 3, 1, 15, 15, 43, 29,
+    13, 483, 1, 1, 7, 3, 19, 27, 85, 131, 431, 1, 3, 3, 3, 5, 35, 23, 195, 349, 1, 3, 3, 7, 9, 27, 39, 59, 297, 1, 1, 3,
+    9, 11, 17, 13, 241, 157, 1, 3, 7, 15, 25, 57, 33, 189, 213, 1, 1, 7, 1, 9, 55, 73, 83, 217, 1, 3, 3, 13, 19, 27, 23,
+    113, 249, 1, 3, 5, 3, 23, 43, 3, 253, 479, 1, 1, 5, 5, 11, 5, 45, 117, 217, 1, 3, 3, 7, 29, 37, 33, 123, 147, 1, 3,
+    1, 15, 5, 5, 37, 227, 223, 459, 1, 1, 7, 5, 5, 39, 63, 255, 135, 487, 1, 3, 1, 7, 9, 7, 87, 249, 217, 599, 1, 1, 3,
+    13, 9, 47, 7, 225, 363, 247, 1, 3, 7, 13, 19, 13, 9, 67, 9, 737, 1, 3, 5, 5, 19, 59, 7, 41, 319, 677, 1, 1, 5, 3,
+    31, 63, 15, 43, 207, 789, 1, 1, 7, 9, 13, 39, 3, 47, 497, 169, 1, 3, 1, 7, 21, 17, 97, 19, 415, 905, 1, 3, 7, 1, 3,
+    31, 71, 111, 165, 127, 1, 1, 5, 11, 1, 61, 83, 119, 203, 847, 1, 3, 3, 13, 9, 61, 19, 97, 47, 35, 1, 1, 7, 7, 15,
+    29, 63, 95, 417, 469, 1, 3, 1, 9, 25, 9, 71, 57, 213, 385, 1, 3, 5, 13, 31, 47, 101, 57, 39, 341, 1, 1, 3, 3, 31,
+    57, 125, 173, 365, 551, 1, 3, 7, 1, 13, 57, 67, 157, 451, 707, 1, 1, 1, 7, 21, 13, 105, 89, 429, 965, 1, 1, 5, 9,
+    17, 51, 45, 119, 157, 141, 1, 3, 7, 7, 13, 45, 91, 9, 129, 741, 1, 3, 7, 1, 23, 57, 67, 141, 151, 571, 1, 1, 3, 11,
+    17, 47, 93, 107, 375, 157, 1, 3, 3, 5, 11, 21, 43, 51, 169, 915, 1, 1, 5, 3, 15, 55, 101, 67, 455, 625, 1, 3, 5, 9,
+    1, 23, 29, 47, 345, 595, 1, 3, 7, 7, 5, 49, 29, 155, 323, 589, 1, 3, 3, 7, 5, 41, 127, 61, 261, 717, 1, 3, 7, 7, 17,
+    23, 117, 67, 129, 1009, 1, 1, 3, 13, 11, 39, 21, 207, 123, 305, 1, 1, 3, 9, 29, 3, 95, 47, 231, 73, 1, 3, 1, 9, 1,
+    29, 117, 21, 441, 259, 1, 3, 1, 13, 21, 39, 125, 211, 439, 723, 1, 1, 7, 3, 17, 63, 115, 89, 49, 773, 1, 3, 7, 13,
+    11, 33, 101, 107, 63, 73, 1, 1, 5, 5, 13, 57, 63, 135, 437, 177, 1, 1, 3, 7, 27, 63, 93, 47, 417, 483, 1, 1, 3, 1,
+    23, 29, 1, 191, 49, 23, 1, 1, 3, 15, 25, 55, 9, 101, 219, 607, 1, 3, 1, 7, 7, 19, 51, 251, 393, 307, 1, 3, 3, 3, 25,
+    55, 17, 75, 337, 3, 1, 1, 1, 13, 25, 17, 65, 45, 479, 413, 1, 1, 7, 7, 27, 49, 99, 161, 213, 727, 1, 3, 5, 1, 23, 5,
+    43, 41, 251, 857, 1, 3, 3, 7, 11, 61, 39, 87, 383, 835, 1, 1, 3, 15, 13, 7, 29, 7, 505, 923, 1, 3, 7, 1, 5, 31, 47,
+    157, 445, 501, 1, 1, 3, 7, 1, 43, 9, 147, 115, 605, 1, 3, 3, 13, 5, 1, 119, 211, 455, 1001, 1, 1, 3, 5, 13, 19, 3,
+    243, 75, 843, 1, 3, 7, 7, 1, 19, 91, 249, 357, 589, 1, 1, 1, 9, 1, 25, 109, 197, 279, 411, 1, 3, 1, 15, 23, 57, 59,
+    135, 191, 75, 1, 1, 5, 15, 29, 21, 39, 253, 383, 349, 1, 3, 3, 5, 19, 45, 61, 151, 199, 981, 1, 3, 5, 13, 9, 61,
+    107, 141, 141, 1, 1, 3, 1, 11, 27, 25, 85, 105, 309, 979, 1, 3, 3, 11, 19, 7, 115, 223, 349, 43, 1, 1, 7, 9, 21, 39,
+    123, 21, 275, 927, 1, 1, 7, 13, 15, 41, 47, 243, 303, 437, 1, 1, 1, 7, 7, 3, 15, 99, 409, 719, 1, 3, 3, 15, 27, 49,
+    113, 123, 113, 67, 469, 1, 3, 7, 11, 3, 23, 87, 169, 119, 483, 199, 1, 1, 5, 15, 7, 17, 109, 229, 179, 213, 741, 1,
+    1, 5, 13, 11, 17, 25, 135, 403, 557, 1433, 1, 3, 1, 1, 1, 61, 67, 215, 189, 945, 1243, 1, 1, 7, 13, 17, 33, 9, 221,
+    429, 217, 1679, 1, 1, 3, 11, 27, 3, 15, 93, 93, 865, 1049, 1, 3, 7, 7, 25, 41, 121, 35, 373, 379, 1547, 1, 3, 3, 9,
+    11, 35, 45, 205, 241, 9, 59, 1, 3, 1, 7, 3, 51, 7, 177, 53, 975, 89, 1, 1, 3, 5, 27, 1, 113, 231, 299, 759, 861, 1,
+    3, 3, 15, 25, 29, 5, 255, 139, 891, 2031, 1, 3, 1, 1, 13, 9, 109, 193, 419, 95, 17, 1, 1, 7, 9, 3, 7, 29, 41, 135,
+    839, 867, 1, 1, 7, 9, 25, 49, 123, 217, 113, 909, 215, 1, 1, 7, 3, 23, 15, 43, 133, 217, 327, 901, 1, 1, 3, 3, 13,
+    53, 63, 123, 477, 711, 1387, 1, 1, 3, 15, 7, 29, 75, 119, 181, 957, 247, 1, 1, 1, 11, 27, 25, 109, 151, 267, 99,
+    1461, 1, 3, 7, 15, 5, 5, 53, 145, 11, 725, 1501, 1, 3, 7, 1, 9, 43, 71, 229, 157, 607, 1835, 1, 3, 3, 13, 25, 1, 5,
+    27, 471, 349, 127, 1, 1, 1, 1, 23, 37, 9, 221, 269, 897, 1685, 1, 1, 3, 3, 31, 29, 51, 19, 311, 553, 1969, 1, 3, 7,
+    5, 5, 55, 17, 39, 475, 671, 1529, 1, 1, 7, 1, 1, 35, 47, 27, 437, 395, 1635, 1, 1, 7, 3, 13, 23, 43, 135, 327, 139,
+    389, 1, 3, 7, 3, 9, 25, 91, 25, 429, 219, 513, 1, 1, 3, 5, 13, 29, 119, 201, 277, 157, 2043, 1, 3, 5, 3, 29, 57, 13,
+    17, 167, 739, 1031, 1, 3, 3, 5, 29, 21, 95, 27, 255, 679, 1531, 1, 3, 7, 15, 9, 5, 21, 71, 61, 961, 1201, 1, 3, 5,
+    13, 15, 57, 33, 93, 459, 867, 223, 1, 1, 1, 15, 17, 43, 127, 191, 67, 177, 1073, 1, 1, 1, 15, 23, 7, 21, 199, 75,
+    293, 1611, 1, 3, 7, 13, 15, 39, 21, 149, 65, 741, 319, 1, 3, 7, 11, 23, 13, 101, 89, 277, 519, 711, 1, 3, 7, 15, 19,
+    27, 85, 203, 441, 97, 1895, 1, 3, 1, 3, 29, 25, 21, 155, 11, 191, 197, 1, 1, 7, 5, 27, 11, 81, 101, 457, 675, 1687,
+    1, 3, 1, 5, 25, 5, 65, 193, 41, 567, 781, 1, 3, 1, 5, 11, 15, 113, 77, 411, 695, 1111, 1, 1, 3, 9, 11, 53, 119, 171,
+    55, 297, 509, 1, 1, 1, 1, 11, 39, 113, 139, 165, 347, 595, 1, 3, 7, 11, 9, 17, 101, 13, 81, 325, 1733, 1, 3, 1, 1,
+    21, 43, 115, 9, 113, 907, 645, 1, 1, 7, 3, 9, 25, 117, 197, 159, 471, 475, 1, 3, 1, 9, 11, 21, 57, 207, 485, 613,
+    1661, 1, 1, 7, 7, 27, 55, 49, 223, 89, 85, 1523, 1, 1, 5, 3, 19, 41, 45, 51, 447, 299, 1355, 1, 3, 1, 13, 1, 33,
+    117, 143, 313, 187, 1073, 1, 1, 7, 7, 5, 11, 65, 97, 377, 377, 1501, 1, 3, 1, 1, 21, 35, 95, 65, 99, 23, 1239, 1, 1,
+    5, 9, 3, 37, 95, 167, 115, 425, 867, 1, 3, 3, 13, 1, 37, 27, 189, 81, 679, 773, 1, 1, 3, 11, 1, 61, 99, 233, 429,
+    969, 49, 1, 1, 1, 7, 25, 63, 99, 165, 245, 793, 1143, 1, 1, 5, 11, 11, 43, 55, 65, 71, 283, 273, 1, 1, 5, 5, 9, 3,
+    101, 251, 355, 379, 1611, 1, 1, 1, 15, 21, 63, 85, 99, 49, 749, 1335, 1, 1, 5, 13, 27, 9, 121, 43, 255, 715, 289, 1,
+    3, 1, 5, 27, 19, 17, 223, 77, 571, 1415, 1, 1, 5, 3, 13, 59, 125, 251, 195, 551, 1737, 1, 3, 3, 15, 13, 27, 49, 105,
+    389, 971, 755, 1, 3, 5, 15, 23, 43, 35, 107, 447, 763, 253, 1, 3, 5, 11, 21, 3, 17, 39, 497, 407, 611, 1, 1, 7, 13,
+    15, 31, 113, 17, 23, 507, 1995, 1, 1, 7, 15, 3, 15, 31, 153, 423, 79, 503, 1, 1, 7, 9, 19, 25, 23, 171, 505, 923,
+    1989, 1, 1, 5, 9, 21, 27, 121, 223, 133, 87, 697, 1, 1, 5, 5, 9, 19, 107, 99, 319, 765, 1461, 1, 1, 3, 3, 19, 25, 3,
+    101, 171, 729, 187, 1, 1, 3, 1, 13, 23, 85, 93, 291, 209, 37, 1, 1, 1, 15, 25, 25, 77, 253, 333, 947, 1073, 1, 1, 3,
+    9, 17, 29, 55, 47, 255, 305, 2037, 1, 3, 3, 9, 29, 63, 9, 103, 489, 939, 1523, 1, 3, 7, 15, 7, 31, 89, 175, 369,
+    339, 595, 1, 3, 7, 13, 25, 5, 71, 207, 251, 367, 665, 1, 3, 3, 3, 21, 25, 75, 35, 31, 321, 1603, 1, 1, 1, 9, 11, 1,
+    65, 5, 11, 329, 535, 1, 1, 5, 3, 19, 13, 17, 43, 379, 485, 383, 1, 3, 5, 13, 13, 9, 85, 147, 489, 787, 1133, 1, 3,
+    1, 1, 5, 51, 37, 129, 195, 297, 1783, 1, 1, 3, 15, 19, 57, 59, 181, 455, 697, 2033, 1, 3, 7, 1, 27, 9, 65, 145, 325,
+    189, 201, 1, 3, 1, 15, 31, 23, 19, 5, 485, 581, 539, 1, 1, 7, 13, 11, 15, 65, 83, 185, 847, 831, 1, 3, 5, 7, 7, 55,
+    73, 15, 303, 511, 1905, 1, 3, 5, 9, 7, 21, 45, 15, 397, 385, 597, 1, 3, 7, 3, 23, 13, 73, 221, 511, 883, 1265, 1, 1,
+    3, 11, 1, 51, 73, 185, 33, 975, 1441, 1, 3, 3, 9, 19, 59, 21, 39, 339, 37, 143, 1, 1, 7, 1, 31, 33, 19, 167, 117,
+    635, 639, 1, 1, 1, 3, 5, 13, 59, 83, 355, 349, 1967, 1, 1, 1, 5, 19, 3, 53, 133, 97, 863, 983, 1, 3, 1, 13, 9, 41,
+    91, 105, 173, 97, 625, 1, 1, 5, 3, 7, 49, 115, 133, 71, 231, 1063, 1, 1, 7, 5, 17, 43, 47, 45, 497, 547, 757, 1, 3,
+    5, 15, 21, 61, 123, 191, 249, 31, 631, 1, 3, 7, 9, 17, 7, 11, 185, 127, 169, 1951, 1, 1, 5, 13, 11, 11, 9, 49, 29,
+    125, 791, 1, 1, 1, 15, 31, 41, 13, 167, 273, 429, 57, 1, 3, 5, 3, 27, 7, 35, 209, 65, 265, 1393, 1, 3, 1, 13, 31,
+    19, 53, 143, 135, 9, 1021, 1, 1, 7, 13, 31, 5, 115, 153, 143, 957, 623, 1, 1, 5, 11, 25, 19, 29, 31, 297, 943, 443,
+    1, 3, 3, 5, 21, 11, 127, 81, 479, 25, 699, 1, 1, 3, 11, 25, 31, 97, 19, 195, 781, 705, 1, 1, 5, 5, 31, 11, 75, 207,
+    197, 885, 2037, 1, 1, 1, 11, 9, 23, 29, 231, 307, 17, 1497, 1, 1, 5, 11, 11, 43, 111, 233, 307, 523, 1259, 1, 1, 7,
+    5, 1, 21, 107, 229, 343, 933, 217, 1, 1, 1, 11, 3, 21, 125, 131, 405, 599, 1469, 1, 3, 5, 5, 9, 39, 33, 81, 389,
+    151, 811, 1, 1, 7, 7, 7, 1, 59, 223, 265, 529, 2021, 1, 3, 1, 3, 9, 23, 85, 181, 47, 265, 49, 1, 3, 5, 11, 19, 23,
+    9, 7, 157, 299, 1983, 1, 3, 1, 5, 15, 5, 21, 105, 29, 339, 1041, 1, 1, 1, 1, 5, 33, 65, 85, 111, 705, 479, 1, 1, 1,
+    7, 9, 35, 77, 87, 151, 321, 101, 1, 1, 5, 7, 17, 1, 51, 197, 175, 811, 1229, 1, 3, 3, 15, 23, 37, 85, 185, 239, 543,
+    731, 1, 3, 1, 7, 7, 55, 111, 109, 289, 439, 243, 1, 1, 7, 11, 17, 53, 35, 217, 259, 853, 1667, 1, 3, 1, 9, 1, 63,
+    87, 17, 73, 565, 1091, 1, 1, 3, 3, 11, 41, 1, 57, 295, 263, 1029, 1, 1, 5, 1, 27, 45, 109, 161, 411, 421, 1395, 1,
+    3, 5, 11, 25, 35, 47, 191, 339, 417, 1727, 1, 1, 5, 15, 21, 1, 93, 251, 351, 217, 1767, 1, 3, 3, 11, 3, 7, 75, 155,
+    313, 211, 491, 1, 3, 3, 5, 11, 9, 101, 161, 453, 913, 1067, 1, 1, 3, 1, 15, 45, 127, 141, 163, 727, 1597, 1, 3, 3,
+    7, 1, 33, 63, 73, 73, 341, 1691, 1, 3, 5, 13, 15, 39, 53, 235, 77, 99, 949, 1, 1, 5, 13, 31, 17, 97, 13, 215, 301,
+    1927, 1, 1, 7, 1, 1, 37, 91, 93, 441, 251, 1131, 1, 3, 7, 9, 25, 5, 105, 69, 81, 943, 1459, 1, 3, 7, 11, 31, 43, 13,
+    209, 27, 1017, 501, 1, 1, 7, 15, 1, 33, 31, 233, 161, 507, 387, 1, 3, 3, 5, 5, 53, 33, 177, 503, 627, 1927, 1, 1, 7,
+    11, 7, 61, 119, 31, 457, 229, 1875, 1, 1, 5, 15, 19, 5, 53, 201, 157, 885, 1057, 1, 3, 7, 9, 1, 35, 51, 113, 249,
+    425, 1009, 1, 3, 5, 7, 21, 53, 37, 155, 119, 345, 631, 1, 3, 5, 7, 15, 31, 109, 69, 503, 595, 1879, 1, 3, 3, 1, 25,
+    35, 65, 131, 403, 705, 503, 1, 3, 7, 7, 19, 33, 11, 153, 45, 633, 499, 1, 3, 3, 5, 11, 3, 29, 93, 487, 33, 703, 1,
+    1, 3, 15, 21, 53, 107, 179, 387, 927, 1757, 1, 1, 3, 7, 21, 45, 51, 147, 175, 317, 361, 1, 1, 1, 7, 7, 13, 15, 243,
+    269, 795, 1965, 1, 1, 3, 5, 19, 33, 57, 115, 443, 537, 627, 1, 3, 3, 9, 3, 39, 25, 61, 185, 717, 1049, 1, 3, 7, 3,
+    7, 37, 107, 153, 7, 269, 1581, 1, 1, 7, 3, 7, 41, 91, 41, 145, 489, 1245, 1, 1, 5, 9, 7, 7, 105, 81, 403, 407, 283,
+    1, 1, 7, 9, 27, 55, 29, 77, 193, 963, 949, 1, 1, 5, 3, 25, 51, 107, 63, 403, 917, 815, 1, 1, 7, 3, 7, 61, 19, 51,
+    457, 599, 535, 1, 3, 7, 1, 23, 51, 105, 153, 239, 215, 1847, 1, 1, 3, 5, 27, 23, 79, 49, 495, 45, 1935, 1, 1, 1, 11,
+    11, 47, 55, 133, 495, 999, 1461, 1, 1, 3, 15, 27, 51, 93, 17, 355, 763, 1675, 1, 3, 1, 3, 1, 3, 79, 119, 499, 17,
+    995, 1, 1, 1, 1, 15, 43, 45, 17, 167, 973, 799, 1, 1, 1, 3, 27, 49, 89, 29, 483, 913, 2023, 1, 1, 3, 3, 5, 11, 75,
+    7, 41, 851, 611, 1, 3, 1, 3, 7, 57, 39, 123, 257, 283, 507, 1, 3, 3, 11, 27, 23, 113, 229, 187, 299, 133, 1, 1, 3,
+    13, 9, 63, 101, 77, 451, 169, 337, 1, 3, 7, 3, 3, 59, 45, 195, 229, 415, 409, 1, 3, 5, 3, 11, 19, 71, 93, 43, 857,
+    369, 1, 3, 7, 9, 19, 33, 115, 19, 241, 703, 247, 1, 3, 5, 11, 5, 35, 21, 155, 463, 1005, 1073, 1, 3, 7, 3, 25, 15,
+    109, 83, 93, 69, 1189, 1, 3, 5, 7, 5, 21, 93, 133, 135, 167, 903, 1, 1, 7, 7, 3, 59, 121, 161, 285, 815, 1769, 3705,
+    1, 3, 1, 1, 3, 47, 103, 171, 381, 609, 185, 373, 1, 3, 3, 15, 23, 33, 107, 131, 441, 445, 689, 2059, 1, 3, 3, 11, 7,
+    53, 101, 167, 435, 803, 1255, 3781, 1, 1, 5, 11, 15, 59, 41, 19, 135, 835, 1263, 505, 1, 1, 7, 11, 21, 49, 23, 219,
+    127, 961, 1065, 385, 1, 3, 5, 15, 7, 47, 117, 217, 45, 731, 1639, 733, 1, 1, 7, 11, 27, 57, 91, 87, 81, 35, 1269,
+    1007, 1, 1, 3, 11, 15, 37, 53, 219, 193, 937, 1899, 3733, 1, 3, 5, 3, 13, 11, 27, 19, 199, 393, 965, 2195, 1, 3, 1,
+    3, 5, 1, 37, 173, 413, 1023, 553, 409, 1, 3, 1, 7, 15, 29, 123, 95, 255, 373, 1799, 3841, 1, 3, 5, 13, 21, 57, 51,
+    17, 511, 195, 1157, 1831, 1, 1, 1, 15, 29, 19, 7, 73, 295, 519, 587, 3523, 1, 1, 5, 13, 13, 35, 115, 191, 123, 535,
+    717, 1661, 1, 3, 3, 5, 23, 21, 47, 251, 379, 921, 1119, 297, 1, 3, 3, 9, 29, 53, 121, 201, 135, 193, 523, 2943, 1,
+    1, 1, 7, 29, 45, 125, 9, 99, 867, 425, 601, 1, 3, 1, 9, 13, 15, 67, 181, 109, 293, 1305, 3079, 1, 3, 3, 9, 5, 35,
+    15, 209, 305, 87, 767, 2795, 1, 3, 3, 11, 27, 57, 113, 123, 179, 643, 149, 523, 1, 1, 3, 15, 11, 17, 67, 223, 63,
+    657, 335, 3309, 1, 1, 1, 9, 25, 29, 109, 159, 39, 513, 571, 1761, 1, 1, 3, 1, 5, 63, 75, 19, 455, 601, 123, 691, 1,
+    1, 1, 3, 21, 5, 45, 169, 377, 513, 1951, 2565, 1, 1, 3, 11, 3, 33, 119, 69, 253, 907, 805, 1449, 1, 1, 5, 13, 31,
+    15, 17, 7, 499, 61, 687, 1867, 1, 3, 7, 11, 17, 33, 73, 77, 299, 243, 641, 2345, 1, 1, 7, 11, 9, 35, 31, 235, 359,
+    647, 379, 1161, 1, 3, 3, 15, 31, 25, 5, 67, 33, 45, 437, 4067, 1, 1, 3, 11, 7, 17, 37, 87, 333, 253, 1517, 2921, 1,
+    1, 7, 15, 7, 15, 107, 189, 153, 769, 1521, 3427, 1, 3, 5, 13, 5, 61, 113, 37, 293, 393, 113, 43, 1, 1, 1, 15, 29,
+    43, 107, 31, 167, 147, 301, 1021, 1, 1, 1, 13, 3, 1, 35, 93, 195, 181, 2027, 1491, 1, 3, 3, 3, 13, 33, 77, 199, 153,
+    221, 1699, 3671, 1, 3, 5, 13, 7, 49, 123, 155, 495, 681, 819, 809, 1, 3, 5, 15, 27, 61, 117, 189, 183, 887, 617,
+    4053, 1, 1, 1, 7, 31, 59, 125, 235, 389, 369, 447, 1039, 1, 3, 5, 1, 5, 39, 115, 89, 249, 377, 431, 3747, 1, 1, 1,
+    5, 7, 47, 59, 157, 77, 445, 699, 3439, 1, 1, 3, 5, 11, 21, 19, 75, 11, 599, 1575, 735, 1, 3, 5, 3, 19, 13, 41, 69,
+    199, 143, 1761, 3215, 1, 3, 5, 7, 19, 43, 25, 41, 41, 11, 1647, 2783, 1, 3, 1, 9, 19, 45, 111, 97, 405, 399, 457,
+    3219, 1, 1, 3, 1, 23, 15, 65, 121, 59, 985, 829, 2259, 1, 1, 3, 7, 17, 13, 107, 229, 75, 551, 1299, 2363, 1, 1, 5,
+    5, 21, 57, 23, 199, 509, 139, 2007, 3875, 1, 3, 1, 11, 19, 53, 15, 229, 215, 741, 695, 823, 1, 3, 7, 1, 29, 3, 17,
+    163, 417, 559, 549, 319, 1, 3, 1, 13, 17, 9, 47, 133, 365, 7, 1937, 1071, 1, 3, 5, 7, 19, 37, 55, 163, 301, 249,
+    689, 2327, 1, 3, 5, 13, 11, 23, 61, 205, 257, 377, 615, 1457, 1, 3, 5, 1, 23, 37, 13, 75, 331, 495, 579, 3367, 1, 1,
+    1, 9, 1, 23, 49, 129, 475, 543, 883, 2531, 1, 3, 1, 5, 23, 59, 51, 35, 343, 695, 219, 369, 1, 3, 3, 1, 27, 17, 63,
+    97, 71, 507, 1929, 613, 1, 1, 5, 1, 21, 31, 11, 109, 247, 409, 1817, 2173, 1, 1, 3, 15, 23, 9, 7, 209, 301, 23, 147,
+    1691, 1, 1, 7, 5, 5, 19, 37, 229, 249, 277, 1115, 2309, 1, 1, 1, 5, 5, 63, 5, 249, 285, 431, 343, 2467, 1, 1, 1, 11,
+    7, 45, 35, 75, 505, 537, 29, 2919, 1, 3, 5, 15, 11, 39, 15, 63, 263, 9, 199, 445, 1, 3, 3, 3, 27, 63, 53, 171, 227,
+    63, 1049, 827, 1, 1, 3, 13, 7, 11, 115, 183, 179, 937, 1785, 381, 1, 3, 1, 11, 13, 15, 107, 81, 53, 295, 1785, 3757,
+    1, 3, 3, 13, 11, 5, 109, 243, 3, 505, 323, 1373, 1, 3, 3, 11, 21, 51, 17, 177, 381, 937, 1263, 3889, 1, 3, 5, 9, 27,
+    25, 85, 193, 143, 573, 1189, 2995, 1, 3, 5, 11, 13, 9, 81, 21, 159, 953, 91, 1751, 1, 1, 3, 3, 27, 61, 11, 253, 391,
+    333, 1105, 635, 1, 3, 3, 15, 9, 57, 95, 81, 419, 735, 251, 1141, 1, 1, 5, 9, 31, 39, 59, 13, 319, 807, 1241, 2433,
+    1, 3, 3, 5, 27, 13, 107, 141, 423, 937, 2027, 3233, 1, 3, 3, 9, 9, 25, 125, 23, 443, 835, 1245, 847, 1, 1, 7, 15,
+    17, 17, 83, 107, 411, 285, 847, 1571, 1, 1, 3, 13, 29, 61, 37, 81, 349, 727, 1453, 1957, 1, 3, 7, 11, 31, 13, 59,
+    77, 273, 591, 1265, 1533, 1, 1, 7, 7, 13, 17, 25, 25, 187, 329, 347, 1473, 1, 3, 7, 7, 5, 51, 37, 99, 221, 153, 503,
+    2583, 1, 3, 1, 13, 19, 27, 11, 69, 181, 479, 1183, 3229, 1, 3, 3, 13, 23, 21, 103, 147, 323, 909, 947, 315, 1, 3, 1,
+    3, 23, 1, 31, 59, 93, 513, 45, 2271, 1, 3, 5, 1, 7, 43, 109, 59, 231, 41, 1515, 2385, 1, 3, 1, 5, 31, 57, 49, 223,
+    283, 1013, 11, 701, 1, 1, 5, 1, 19, 53, 55, 31, 31, 299, 495, 693, 1, 3, 3, 9, 5, 33, 77, 253, 427, 791, 731, 1019,
+    1, 3, 7, 11, 1, 9, 119, 203, 53, 877, 1707, 3499, 1, 1, 3, 7, 13, 39, 55, 159, 423, 113, 1653, 3455, 1, 1, 3, 5, 21,
+    47, 51, 59, 55, 411, 931, 251, 1, 3, 7, 3, 31, 25, 81, 115, 405, 239, 741, 455, 1, 1, 5, 1, 31, 3, 101, 83, 479,
+    491, 1779, 2225, 1, 3, 3, 3, 9, 37, 107, 161, 203, 503, 767, 3435, 1, 3, 7, 9, 1, 27, 61, 119, 233, 39, 1375, 4089,
+    1, 1, 5, 9, 1, 31, 45, 51, 369, 587, 383, 2813, 1, 3, 7, 5, 31, 7, 49, 119, 487, 591, 1627, 53, 1, 1, 7, 1, 9, 47,
+    1, 223, 369, 711, 1603, 1917, 1, 3, 5, 3, 21, 37, 111, 17, 483, 739, 1193, 2775, 1, 3, 3, 7, 17, 11, 51, 117, 455,
+    191, 1493, 3821, 1, 1, 5, 9, 23, 39, 99, 181, 343, 485, 99, 1931, 1, 3, 1, 7, 29, 49, 31, 71, 489, 527, 1763, 2909,
+    1, 1, 5, 11, 5, 5, 73, 189, 321, 57, 1191, 3685, 1, 1, 5, 15, 13, 45, 125, 207, 371, 415, 315, 983, 1, 3, 3, 5, 25,
+    59, 33, 31, 239, 919, 1859, 2709, 1, 3, 5, 13, 27, 61, 23, 115, 61, 413, 1275, 3559, 1, 3, 7, 15, 5, 59, 101, 81,
+    47, 967, 809, 3189, 1, 1, 5, 11, 31, 15, 39, 25, 173, 505, 809, 2677, 1, 1, 5, 9, 19, 13, 95, 89, 511, 127, 1395,
+    2935, 1, 1, 5, 5, 31, 45, 9, 57, 91, 303, 1295, 3215, 1, 3, 3, 3, 19, 15, 113, 187, 217, 489, 1285, 1803, 1, 1, 3,
+    1, 13, 29, 57, 139, 255, 197, 537, 2183, 1, 3, 1, 15, 11, 7, 53, 255, 467, 9, 757, 3167, 1, 3, 3, 15, 21, 13, 9,
+    189, 359, 323, 49, 333, 1, 3, 7, 11, 7, 37, 21, 119, 401, 157, 1659, 1069, 1, 1, 5, 7, 17, 33, 115, 229, 149, 151,
+    2027, 279, 1, 1, 5, 15, 5, 49, 77, 155, 383, 385, 1985, 945, 1, 3, 7, 3, 7, 55, 85, 41, 357, 527, 1715, 1619, 1, 1,
+    3, 1, 21, 45, 115, 21, 199, 967, 1581, 3807, 1, 1, 3, 7, 21, 39, 117, 191, 169, 73, 413, 3417, 1, 1, 1, 13, 1, 31,
+    57, 195, 231, 321, 367, 1027, 1, 3, 7, 3, 11, 29, 47, 161, 71, 419, 1721, 437, 1, 1, 7, 3, 11, 9, 43, 65, 157, 1,
+    1851, 823, 1, 1, 1, 5, 21, 15, 31, 101, 293, 299, 127, 1321, 1, 1, 7, 1, 27, 1, 11, 229, 241, 705, 43, 1475, 1, 3,
+    7, 1, 5, 15, 73, 183, 193, 55, 1345, 49, 1, 3, 3, 3, 19, 3, 55, 21, 169, 663, 1675, 137, 1, 1, 1, 13, 7, 21, 69, 67,
+    373, 965, 1273, 2279, 1, 1, 7, 7, 21, 23, 17, 43, 341, 845, 465, 3355, 1, 3, 5, 5, 25, 5, 81, 101, 233, 139, 359,
+    2057, 1, 1, 3, 11, 15, 39, 55, 3, 471, 765, 1143, 3941, 1, 1, 7, 15, 9, 57, 81, 79, 215, 433, 333, 3855, 1, 1, 5, 5,
+    19, 45, 83, 31, 209, 363, 701, 1303, 1, 3, 7, 5, 1, 13, 55, 163, 435, 807, 287, 2031, 1, 3, 3, 7, 3, 3, 17, 197, 39,
+    169, 489, 1769, 1, 1, 3, 5, 29, 43, 87, 161, 289, 339, 1233, 2353, 1, 3, 3, 9, 21, 9, 77, 1, 453, 167, 1643, 2227,
+    1, 1, 7, 1, 15, 7, 67, 33, 193, 241, 1031, 2339, 1, 3, 1, 11, 1, 63, 45, 65, 265, 661, 849, 1979, 1, 3, 1, 13, 19,
+    49, 3, 11, 159, 213, 659, 2839, 1, 3, 5, 11, 9, 29, 27, 227, 253, 449, 1403, 3427, 1, 1, 3, 1, 7, 3, 77, 143, 277,
+    779, 1499, 475, 1, 1, 1, 5, 11, 23, 87, 131, 393, 849, 193, 3189, 1, 3, 5, 11, 3, 3, 89, 9, 449, 243, 1501, 1739, 1,
+    3, 1, 9, 29, 29, 113, 15, 65, 611, 135, 3687
+};
+
+[[nodiscard]] inline std::vector<SobolParameters> _default_sobol_parameters(std::size_t dimensions) {
+    std::vector<SobolParameters> res;
+    if (dimensions < 2) return res;
+    res.reserve(dimensions - 1);
+
+    generators::SplitMix64 gen{0x50b01}; // fixed seed for dimensions past the table
+    const std::uint16_t*   table = _joe_kuo_initial;
+
+    for (std::uint32_t degree = 1; res.size() < dimensions - 1; ++degree) {
+        assert(degree < _sobol_bits && "Number of dimensions is too large.");
+
+        for (std::uint32_t a = 0; a < (std::uint32_t(1) << (degree - 1)) && res.size() < dimensions - 1; ++a) {
+            const std::uint64_t polynomial = (std::uint64_t(1) << degree) | (std::uint64_t(a) << 1) | 1;
+            if (!_is_primitive_gf2(polynomial, degree)) continue;
+
+            std::vector<std::uint32_t> initial(degree);
+            if (res.size() + 1 < _joe_kuo_dimensions)
+                for (std::uint32_t i = 0; i < degree; ++i) initial[i] = *table++;
+            else
+                for (std::uint32_t i = 0; i < degree; ++i)
+                    initial[i] = static_cast<std::uint32_t>(_uniform_index(gen, std::uint64_t(1) << i)) * 2 + 1;
+
+            res.push_back({degree, a, std::move(initial)});
+        }
+    }
+
+    return res;
+}
+
+[[nodiscard]] constexpr std::uint32_t _parity(std::uint32_t x) noexcept {
+    x ^= x >> 16, x ^= x >> 8, x ^= x >> 4, x ^= x >> 2, x ^= x >> 1;
+    return x & 1;
+}
+
+template <class T = double>
+class SobolSequence {
+    static_assert(std::is_floating_point_v<T>);
+
+    using directions_type = std::array<std::uint32_t, _sobol_bits>;
+
+    std::vector<directions_type> directions; // 'directions[j][k]' is direction number 'v_k' of dimension 'j'
+    std::vector<std::uint32_t>   shift;      // digital shift of each dimension
+    std::vector<std::uint32_t>   state;      // current point as integers
+    std::uint64_t                position = 0;
+
+    void init_directions(const std::vector<SobolParameters>& params) {
+        this->directions.resize(params.size() + 1);
+
+        // first dimension is the van der Corput sequence
+        for (std::size_t k = 0; k < _sobol_bits; ++k) this->directions[0][k] = std::uint32_t(1) << (31 - k);
+
+        for (std::size_t j = 1; j < this->directions.size(); ++j) {
+            const auto& [s, a, m] = params[j - 1];
+            auto&       v         = this->directions[j];
+
+            assert(0 < s && s < _sobol_bits && m.size() == s && "Invalid Sobol parameters.");
+
+            for (std::size_t k = 0; k < std::min<std::size_t>(s, _sobol_bits); ++k) {
+                assert(m[k] % 2 == 1 && m[k] < (std::uint32_t(1) << (k + 1)) && "Invalid Sobol parameters.");
+                v[k] = m[k] << (31 - k);
+            }
+            for (std::size_t k = s; k < _sobol_bits; ++k) {
+                v[k] = v[k - s] ^ (v[k - s] >> s);
+                for (std::size_t i = 1; i < s; ++i)
+                    if ((a >> (s - 1 - i)) & 1) v[k] ^= v[k - i];
+            }
+        }
+    }
+
+public:
+    using result_type = T;
+
+    explicit SobolSequence(std::size_t dimensions, std::uint64_t index = 0)
+        : SobolSequence(_default_sobol_parameters(dimensions), index) {
+        assert(dimensions > 0);
+    }
+
+    // 'params[j]' defines dimension 'j + 1', dimension '0' is always the van der Corput sequence
+    explicit SobolSequence(const std::vector<SobolParameters>& params, std::uint64_t index = 0) {
+        this->init_directions(params);
+        this->shift.assign(this->directions.size(), 0);
+        this->seek(index);
+    }
+
+    void seek(std::uint64_t index) noexcept {
+        assert(index < (std::uint64_t(1) << _sobol_bits) && "Sobol sequence has at most 2^32 points.");
+
+        this->position  = index;
+        const auto gray = index ^ (index >> 1);
+        this->state.resize(this->directions.size());
+
+        for (std::size_t j = 0; j < this->directions.size(); ++j) {
+            std::uint32_t x = this->shift[j];
+            for (std::size_t k = 0; k < _sobol_bits; ++k)
+                if ((gray >> k) & 1) x ^= this->directions[j][k];
+            this->state[j] = x;
+        }
+    }
+
+    void discard(std::uint64_t n) noexcept { this->seek(this->position + n); }
+
+    template <class Gen>
+    void scramble(Gen& gen) {
+        for (std::size_t j = 0; j < this->directions.size(); ++j) {
+            // lower-triangular matrix with unit diagonal, row 'i' is a mask of the digits contributing to digit 'i'
+            std::array<std::uint32_t, _sobol_bits> rows{};
+            for (std::size_t i = 0; i < _sobol_bits; ++i) {
+                const std::uint32_t diagonal = std::uint32_t(1) << (31 - i);
+                const std::uint32_t above    = ~((diagonal << 1) - 1); // more significant digits
+                rows[i] = diagonal | (static_cast<std::uint32_t>(_generate_uint64(gen)) & above);
+            }
+
+            for (auto& v : this->directions[j]) {
+                std::uint32_t scrambled = 0;
+                for (std::size_t i = 0; i < _sobol_bits; ++i) scrambled |= _parity(rows[i] & v) << (31 - i);
+                v = scrambled;
+            }
+
+            this->shift[j] = static_cast<std::uint32_t>(_generate_uint64(gen));
+        }
+
+        this->seek(this->position);
+    }
+
+    template <class OutIt>
+    OutIt next(OutIt out) {
+        for (const auto& x : this->state) *out = _fixed_point_to_unit<T>(std::uint64_t(x) << 32), ++out;
+
+        // Gray code order, next point differs by direction number of the lowest zero bit of the index
+        std::size_t k = 0;
+        while ((this->position >> k) & 1) ++k;
+        ++this->position;
+
+        if (k < _sobol_bits)
+            for (std::size_t j = 0; j < this->state.size(); ++j) this->state[j] ^= this->directions[j][k];
+
+        return out;
+    }
+
+    template <class OutIt>
+    void fill(OutIt first, OutIt last) {
+        _fill_points(*this, first, last);
+    }
+
+    std::vector<T> operator()() {
+        std::vector<T> point(this->dimensions());
+        this->next(point.begin());
+        return point;
+    }
+
+    [[nodiscard]] std::size_t   dimensions() const noexcept { return this->directions.size(); }
+    [[nodiscard]] std::uint64_t index() const noexcept { return this->position; }
+};
+
+// --- Halton sequence ---
+// -----------------------
+
+// Halton sequence, see J. H. Halton "On the efficiency of certain quasi-random sequences of points in evaluating
+// multi-dimensional integrals" (1960).
+//
+// Dimension 'j' is a radical inverse of the point index in base of the 'j'-th prime. Points are generated incrementally
+// by keeping base 'b' digits of the index and the radical inverse as an integer numerator over 'b^m', which makes
+// the values exact and the amortized cost per dimension O(1). Digits are limited so that 'b^m <= 2^53', after 'b^m'
+// points the dimension repeats. Scrambling applies a random permutation of digits in every dimension, which breaks
+// the correlations between the dimensions with large bases (E. Braaten & G. Weller 1979).
+
+[[nodiscard]] inline std::vector<std::uint32_t> _first_primes(std::size_t count) {
+    std::vector<std::uint32_t> primes;
+    primes.reserve(count);
+
+    for (std::uint32_t n = 2; primes.size() < count; ++n) {
+        bool is_prime = true;
+        for (const auto p : primes) {
+            if (p * p > n) break;
+            if (n % p == 0) {
+                is_prime = false;
+                break;
+            }
+        }
+        if (is_prime) primes.push_back(n);
+    }
+
+    return primes;
+}
+
+constexpr std::size_t   _halton_max_digits     = 53;
+constexpr std::uint64_t _halton_max_table_size = 256;
+
+template <class T = double>
+class HaltonSequence {
+    static_assert(std::is_floating_point_v<T>);
+
+    // Lowest digits of the index change on every step, their contributions to the numerator are precomputed
+    // for all combinations, which turns most steps into a table lookup with a well-predicted branch
+    struct dimension {
+        std::uint32_t                                 base;
+        std::size_t                                   digit_count; // 'm'
+        std::size_t                                   table_digits;
+        std::array<std::uint64_t, _halton_max_digits> scale;  // 'b^(m - 1 - k)'
+        std::array<std::uint32_t, _halton_max_digits> digits; // digits of the index, least significant first
+        std::vector<std::uint64_t>                    table;  // contributions of the lowest 'table_digits' digits
+        std::uint64_t                                 low;    // lowest digits of the index as a number
+        std::uint64_t                                 high;   // contribution of the remaining digits
+        double                                        inv_denominator; // '1 / b^m'
+        std::vector<std::uint32_t>                    permutation;     // empty unless scrambled
+    };
+
+    std::vector<dimension> dims;
+    std::uint64_t          position = 0;
+
+    [[nodiscard]] static std::uint64_t permuted(const dimension& dim, std::uint32_t digit) noexcept {
+        return dim.permutation.empty() ? digit : dim.permutation[digit];
+    }
+
+    static void build_table(dimension& dim) {
+        for (std::size_t i = 0; i < dim.table.size(); ++i) {
+            std::uint64_t rest = i, numerator = 0;
+            for (std::size_t k = 0; k < dim.table_digits; ++k, rest /= dim.base)
+                numerator += permuted(dim, static_cast<std::uint32_t>(rest % dim.base)) * dim.scale[k];
+            dim.table[i] = numerator;
+        }
+    }
+
+public:
+    using result_type = T;
+
+    explicit HaltonSequence(std::size_t dimensions, std::uint64_t index = 0) {
+        assert(dimensions > 0);
+
+        for (const auto base : _first_primes(dimensions)) {
+            dimension dim{};
+            dim.base = base;
+
+            std::uint64_t power = 1;
+            while (power <= (std::uint64_t(1) << 53) / base) power *= base, ++dim.digit_count;
+
+            dim.inv_denominator = 1. / static_cast<double>(power);
+            for (std::size_t k = 0; k < dim.digit_count; ++k) power /= base, dim.scale[k] = power;
+
+            std::uint64_t table_size = 1;
+            while (table_size * base <= _halton_max_table_size) table_size *= base, ++dim.table_digits;
+
+            dim.table.resize(table_size);
+            build_table(dim);
+
+            this->dims.push_back(std::move(dim));
+        }
+
+        this->seek(index);
+    }
+
+    void seek(std::uint64_t index) noexcept {
+        this->position = index;
+
+        for (auto& dim : this->dims) {
+            dim.low            = index % dim.table.size();
+            std::uint64_t rest = index / dim.table.size();
+
+            dim.high = 0;
+            for (std::size_t k = dim.table_digits; k < dim.digit_count; ++k, rest /= dim.base) {
+                dim.digits[k] = static_cast<std::uint32_t>(rest % dim.base);
+                dim.high += permuted(dim, dim.digits[k]) * dim.scale[k];
+            }
+        }
+    }
+
+    void discard(std::uint64_t n) noexcept { this->seek(this->position + n); }
+
+    template <class Gen>
+    void scramble(Gen& gen) {
+        for (auto& dim : this->dims) {
+            dim.permutation.resize(dim.base);
+            for (std::uint32_t d = 0; d < dim.base; ++d) dim.permutation[d] = d;
+            shuffle(dim.permutation.begin(), dim.permutation.end(), gen);
+            build_table(dim);
+        }
+
+        this->seek(this->position);
+    }
+
+    template <class OutIt>
+    OutIt next(OutIt out) {
+        constexpr T below_one = T(1) - std::numeric_limits<T>::epsilon() / 2;
+
+        for (auto& dim : this->dims) {
+            // numerator fits into 53 bits, conversion through a signed integer is faster than from an unsigned one
+            const auto numerator = static_cast<std::int64_t>(dim.table[dim.low] + dim.high);
+            const T    value     = static_cast<T>(static_cast<double>(numerator) * dim.inv_denominator);
+            *out                 = std::min(value, below_one), ++out;
+
+            if (++dim.low < dim.table.size()) continue;
+            dim.low = 0;
+
+            // increment remaining digits of the index, the numerator is updated with the difference of each changed
+            // digit, unsigned wraparound of intermediate values is intended
+            for (std::size_t k = dim.table_digits; k < dim.digit_count; ++k) {
+                const std::uint32_t digit = dim.digits[k];
+                const std::uint32_t next  = digit + 1 == dim.base ? 0 : digit + 1;
+
+                dim.high += (permuted(dim, next) - permuted(dim, digit)) * dim.scale[k];
+                dim.digits[k] = next;
+                if (next) break;
+            }
+        }
+
+        ++this->position;
+        return out;
+    }
+
+    template <class OutIt>
+    void fill(OutIt first, OutIt last) {
+        _fill_points(*this, first, last);
+    }
+
+    std::vector<T> operator()() {
+        std::vector<T> point(this->dimensions());
+        this->next(point.begin());
+        return point;
+    }
+
+    [[nodiscard]] std::size_t   dimensions() const noexcept { return this->dims.size(); }
+    [[nodiscard]] std::uint64_t index() const noexcept { return this->position; }
+};
+
+// --- R-sequence ---
+// ------------------
+
+// Additive recurrence based on generalized golden ratio, see M. Roberts "The unreasonable effectiveness of
+// quasirandom sequences" (2018), https://extremelearning.com.au/unreasonable-effectiveness-of-quasirandom-sequences/
+//
+// Point 'n' is 'frac(offset + n * alpha)' where 'alpha_j = phi_d^-(j + 1)' and 'phi_d' is the positive root of
+// 'x^(d + 1) = x + 1'. Values are kept in 64-bit fixed point, which makes the recurrence exact and lets us jump
+// to any index in O(1). Default offset is '0.5' as recommended by the author, scrambling replaces it with
+// a random shift (R. Cranley & T. N. L. Patterson 1976).
+
+template <class T = double>
+class RSequence {
+    static_assert(std::is_floating_point_v<T>);
+
+    std::vector<std::uint64_t> alpha;
+    std::vector<std::uint64_t> offset;
+    std::vector<std::uint64_t> state;
+    std::uint64_t              position = 0;
+
+public:
+    using result_type = T;
+
+    explicit RSequence(std::size_t dimensions, std::uint64_t index = 0)
+        : alpha(dimensions), offset(dimensions, std::uint64_t(1) << 63) {
+        assert(dimensions > 0);
+
+        // fixed-point iteration 'phi <- (1 + phi)^(1 / (d + 1))' converges for any 'd'
+        double phi = 2.;
+        for (int i = 0; i < 64; ++i) phi = _exp(_log(1. + phi) / static_cast<double>(dimensions + 1));
+
+        constexpr double two_pow_64 = 18446744073709551616.;
+
+        double a = 1.;
+        for (auto& e : this->alpha) a /= phi, e = static_cast<std::uint64_t>(a * two_pow_64);
+
+        this->seek(index);
+    }
+
+    void seek(std::uint64_t index) noexcept {
+        this->position = index;
+        this->state.resize(this->alpha.size());
+        for (std::size_t j = 0; j < this->alpha.size(); ++j) this->state[j] = this->offset[j] + index * this->alpha[j];
+    }
+
+    void discard(std::uint64_t n) noexcept { this->seek(this->position + n); }
+
+    template <class Gen>
+    void scramble(Gen& gen) {
+        for (auto& e : this->offset) e = _generate_uint64(gen);
+        this->seek(this->position);
+    }
+
+    template <class OutIt>
+    OutIt next(OutIt out) {
+        for (std::size_t j = 0; j < this->state.size(); ++j) {
+            *out = _fixed_point_to_unit<T>(this->state[j]), ++out;
+            this->state[j] += this->alpha[j];
+        }
+        ++this->position;
+        return out;
+    }
+
+    template <class OutIt>
+    void fill(OutIt first, OutIt last) {
+        _fill_points(*this, first, last);
+    }
+
+    std::vector<T> operator()() {
+        std::vector<T> point(this->dimensions());
+        this->next(point.begin());
+        return point;
+    }
+
+    [[nodiscard]] std::size_t   dimensions() const noexcept { return this->alpha.size(); }
+    [[nodiscard]] std::uint64_t index() const noexcept { return this->position; }
+};
+
 // ========================
 // --- Random Functions ---
 // ========================
@@ -1144,7 +3393,7 @@ constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRe
 // sizeof(std::uniform_real_distribution<double>) == 16
 // sizeof(std::normal_distribution<double>)       == 32
 //
-// and same thing for 'UniformIntDistribution', 'UniformRealDistribution'
+// and same thing for 'UniformIntDistribution', 'UniformRealDistribution', 'NormalDistribution'
 
 // Note 2:
 // No '[[nodiscard]]' since random functions inherently can't be pure due to advancing the generator state.
@@ -1154,36 +3403,36 @@ constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRe
 
 inline int rand_int(int min, int max) noexcept {
     const UniformIntDistribution<int> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
 inline int rand_uint(unsigned int min, unsigned int max) noexcept {
     const UniformIntDistribution<unsigned int> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
-inline float rand_float() noexcept { return generate_canonical<float>(default_generator); }
+inline float rand_float() noexcept { return generate_canonical<float>(thread_generator()); }
 
 inline float rand_float(float min, float max) noexcept {
     const UniformRealDistribution<float> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
-inline float rand_normal_float() {
-    std::normal_distribution<float> distr;
-    return distr(default_generator);
+inline float rand_normal_float() noexcept {
+    const NormalDistribution<float> distr;
+    return distr(thread_generator());
 }
 
-inline double rand_double() noexcept { return generate_canonical<double>(default_generator); }
+inline double rand_double() noexcept { return generate_canonical<double>(thread_generator()); }
 
 inline double rand_double(double min, double max) noexcept {
     const UniformRealDistribution<double> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
-inline double rand_normal_double() {
-    std::normal_distribution<double> distr;
-    return distr(default_generator);
+inline double rand_normal_double() noexcept {
+    const NormalDistribution<double> distr;
+    return distr(thread_generator());
 }
 
 inline bool rand_bool() noexcept { return static_cast<bool>(rand_uint(0, 1)); }
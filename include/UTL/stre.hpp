@@ -15,8 +15,12 @@
 // _______________________ INCLUDES _______________________
 
 #include <algorithm>   // transform()
+#include <array>       // array<>
 #include <cctype>      // tolower(), toupper()
 #include <cstddef>     // size_t
+#include <cstdint>     // uint64_t
+#include <cstring>     // memchr(), memcpy()
+#include <iterator>    // forward_iterator_tag
 #include <exception>   // exception
 #include <iomanip>     // setfill(), setw()
 #include <ostream>     // ostream
@@ -25,7 +29,7 @@
 #include <string>      // string
 #include <string_view> // string_view
 #include <tuple>       // tuple<>, get<>()
-#include <type_traits> // false_type, true_type, void_t<>, is_convertible<>, enable_if_t<>
+#include <type_traits> // false_type, true_type, void_t<>, is_convertible<>, enable_if_t<>, conditional_t<>, ...
 #include <utility>     // declval<>(), index_sequence<>
 #include <vector>      // vector<>
 
@@ -83,11 +87,162 @@
 // # ::pad_with_zeroes() #
 // Pads given integer with zeroes untill a certain lenght.
 // Useful when saving data in files like 'data_0001.txt', 'data_0002.txt', '...' so they get properly sorted.
+//
+// # ::CharSet #
+// Set of chars with O(1) membership test, used as an "any of these chars" delimiter / search target.
+// Searches for small sets are done with SWAR (8 chars per 64-bit word), which is portable and doesn't
+// require any intrinsics, larger sets fall back onto a lookup table.
+//
+// # ::to_lower_ascii(), ::to_upper_ascii() #
+// Locale-independent case conversion that also uses SWAR, modifies r-value strings in place.
+//
+// # ::split_view(), ::for_each_token(), ::split_into() #
+// Non-allocating counterparts of '::split_by_delimiter()'. Tokens are 'std::string_view's into the original string,
+// which are either produced lazily by a forward range, passed to a callback, or assigned into a caller-provided vector
+// so its capacity (and the capacity of its strings) gets reused between calls.
 
 // ____________________ IMPLEMENTATION ____________________
 
 namespace utl::stre {
 
+// ======================
+// --- Character sets ---
+// ======================
+
+// --- SWAR utils ---
+// ------------------
+
+// "SIMD within a register", processing strings 8 chars at a time using plain 64-bit arithmetic.
+// All of the operations below are byte-wise with no carries crossing the byte boundaries,
+// which means they produce the same result regardless of the platform endianness.
+
+constexpr std::size_t   _swar_width     = sizeof(std::uint64_t);
+constexpr std::uint64_t _swar_ones      = 0x0101010101010101; // 0x01 in every byte
+constexpr std::uint64_t _swar_low_bits  = 0x7F7F7F7F7F7F7F7F; // lower 7 bits of every byte
+constexpr std::uint64_t _swar_high_bits = 0x8080808080808080; // highest bit of every byte
+
+[[nodiscard]] inline std::uint64_t _swar_load(const char* ptr) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, ptr, _swar_width); // compiles down to a single unaligned load
+    return word;
+}
+
+inline void _swar_store(char* ptr, std::uint64_t word) noexcept { std::memcpy(ptr, &word, _swar_width); }
+
+// Sets the highest bit of every byte of 'word' that is NOT equal to 'c', lower 7 bits of the result are garbage.
+// Unlike the common "has zero byte" trick this is exact, there are no false positives caused by borrows
+[[nodiscard]] constexpr std::uint64_t _swar_not_equal(std::uint64_t word, char c) noexcept {
+    const std::uint64_t diff = word ^ (_swar_ones * static_cast<unsigned char>(c));
+    return ((diff & _swar_low_bits) + _swar_low_bits) | diff;
+}
+
+// --- Char set ---
+// ----------------
+
+// Sets with a few chars are matched against 8 chars at a time, larger sets fall back onto a lookup table
+constexpr std::size_t _swar_max_set_size = 4;
+
+class CharSet;
+
+template <bool in_set>
+[[nodiscard]] std::size_t _find_first(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+template <bool in_set>
+[[nodiscard]] std::size_t _find_last(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+class CharSet {
+    std::array<bool, 256>                table{};
+    std::array<char, _swar_max_set_size> chars{}; // first few distinct chars, used by the SWAR search
+    std::size_t                          size = 0;
+
+    [[nodiscard]] constexpr bool is_small() const noexcept {
+        return 0 < this->size && this->size <= _swar_max_set_size;
+    }
+
+    // Unused slots of 'chars' are filled with copies of the first char, which lets us always check
+    // a fixed number of chars without branching on the set size
+    // Sets the highest bit of every byte of 'word' that belongs to the set, other bits are cleared
+    [[nodiscard]] constexpr std::uint64_t match_mask(std::uint64_t word) const noexcept {
+        static_assert(_swar_max_set_size == 4);
+        const std::uint64_t mismatches = _swar_not_equal(word, this->chars[0]) & _swar_not_equal(word, this->chars[1]) &
+                                         _swar_not_equal(word, this->chars[2]) & _swar_not_equal(word, this->chars[3]);
+        return ~(mismatches | _swar_low_bits);
+    }
+
+    template <bool in_set>
+    friend std::size_t _find_first(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+    template <bool in_set>
+    friend std::size_t _find_last(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+public:
+    constexpr CharSet() = default;
+
+    constexpr explicit CharSet(std::string_view chars) {
+        for (const char c : chars) {
+            bool& in_set = this->table[static_cast<unsigned char>(c)];
+            if (in_set) continue; // skip duplicates so they don't push us out of the SWAR path
+            if (this->size < _swar_max_set_size) this->chars[this->size] = c;
+            in_set = true;
+            ++this->size;
+        }
+        for (std::size_t i = 1; i < _swar_max_set_size; ++i)
+            if (i >= this->size) this->chars[i] = this->chars[0];
+    }
+
+    [[nodiscard]] constexpr bool contains(char c) const noexcept { return this->table[static_cast<unsigned char>(c)]; }
+};
+
+// Skip whole words that can't contain the target, then pinpoint the exact position with a scalar scan
+template <bool in_set>
+std::size_t _find_first(std::string_view str, const CharSet& set, std::size_t pos) noexcept {
+    if (pos >= str.size()) return std::string_view::npos;
+
+    if (set.is_small())
+        for (; pos + _swar_width <= str.size(); pos += _swar_width) {
+            const std::uint64_t matches = set.match_mask(_swar_load(str.data() + pos));
+            if (in_set ? matches != 0 : matches != _swar_high_bits) break;
+        }
+
+    for (; pos < str.size(); ++pos)
+        if (set.contains(str[pos]) == in_set) return pos;
+    return std::string_view::npos;
+}
+
+template <bool in_set>
+std::size_t _find_last(std::string_view str, const CharSet& set, std::size_t pos) noexcept {
+    std::size_t end = (pos < str.size()) ? pos + 1 : str.size(); // scanning '[0, end)' backwards
+
+    if (set.is_small())
+        for (; end >= _swar_width; end -= _swar_width) {
+            const std::uint64_t matches = set.match_mask(_swar_load(str.data() + end - _swar_width));
+            if (in_set ? matches != 0 : matches != _swar_high_bits) break;
+        }
+
+    while (end--)
+        if (set.contains(str[end]) == in_set) return end;
+    return std::string_view::npos;
+}
+
+[[nodiscard]] inline std::size_t find_first_of(std::string_view str, const CharSet& set, std::size_t pos = 0) noexcept {
+    return _find_first<true>(str, set, pos);
+}
+
+[[nodiscard]] inline std::size_t find_first_not_of(std::string_view str, const CharSet& set,
+                                                   std::size_t pos = 0) noexcept {
+    return _find_first<false>(str, set, pos);
+}
+
+[[nodiscard]] inline std::size_t find_last_of(std::string_view str, const CharSet& set,
+                                              std::size_t pos = std::string_view::npos) noexcept {
+    return _find_last<true>(str, set, pos);
+}
+
+[[nodiscard]] inline std::size_t find_last_not_of(std::string_view str, const CharSet& set,
+                                                  std::size_t pos = std::string_view::npos) noexcept {
+    return _find_last<false>(str, set, pos);
+}
+
 // ================
 // --- Trimming ---
 // ================
@@ -111,6 +266,35 @@ template <class T>
     return trim_right(trim_left(std::forward<T>(str), trimmed_char), trimmed_char);
 }
 
+// Non-owning versions, trimming is just an adjustment of the view bounds so there is nothing to copy
+[[nodiscard]] inline std::string_view trim_left_view(std::string_view str, char trimmed_char = ' ') noexcept {
+    str.remove_prefix(std::min(str.find_first_not_of(trimmed_char), str.size()));
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_right_view(std::string_view str, char trimmed_char = ' ') noexcept {
+    str.remove_suffix(str.size() - (str.find_last_not_of(trimmed_char) + 1)); // 'npos + 1' wraps around to 0
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_view(std::string_view str, char trimmed_char = ' ') noexcept {
+    return trim_right_view(trim_left_view(str, trimmed_char), trimmed_char);
+}
+
+[[nodiscard]] inline std::string_view trim_left_view(std::string_view str, const CharSet& trimmed_chars) noexcept {
+    str.remove_prefix(std::min(find_first_not_of(str, trimmed_chars), str.size()));
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_right_view(std::string_view str, const CharSet& trimmed_chars) noexcept {
+    str.remove_suffix(str.size() - (find_last_not_of(str, trimmed_chars) + 1));
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_view(std::string_view str, const CharSet& trimmed_chars) noexcept {
+    return trim_right_view(trim_left_view(str, trimmed_chars), trimmed_chars);
+}
+
 // ===============
 // --- Padding ---
 // ===============
@@ -184,6 +368,43 @@ template <class T>
     return res;
 }
 
+// ASCII-only versions, they ignore the locale which allows us to flip the case of 8 chars at a time.
+// Non-ASCII bytes (including the UTF-8 multibyte sequences) are always left untouched.
+template <char first, char last>
+[[nodiscard]] constexpr std::uint64_t _swar_flip_case(std::uint64_t word) noexcept {
+    const std::uint64_t low_bits   = word & _swar_low_bits;
+    const std::uint64_t from_first = low_bits + _swar_ones * (0x80 - first); // highest bit set for bytes >= first
+    const std::uint64_t after_last = low_bits + _swar_ones * (0x7F - last);  // highest bit set for bytes >  last
+    const std::uint64_t in_range   = (from_first ^ after_last) & ~word & _swar_high_bits;
+    return word ^ (in_range >> 2); // '0x80 >> 2' is '0x20', the only bit that differs between cases in ASCII
+}
+
+template <char first, char last>
+void _flip_case_ascii(std::string& str) noexcept {
+    char* const       data = str.data();
+    const std::size_t size = str.size();
+
+    std::size_t i = 0;
+    for (; i + _swar_width <= size; i += _swar_width)
+        _swar_store(data + i, _swar_flip_case<first, last>(_swar_load(data + i)));
+    for (; i < size; ++i)
+        if (first <= data[i] && data[i] <= last) data[i] = static_cast<char>(data[i] ^ 0x20);
+}
+
+template <class T>
+[[nodiscard]] std::string to_lower_ascii(T&& str) {
+    std::string res = std::forward<T>(str); // when 'str' is an r-value, conversion happens in place
+    _flip_case_ascii<'A', 'Z'>(res);
+    return res;
+}
+
+template <class T>
+[[nodiscard]] std::string to_upper_ascii(T&& str) {
+    std::string res = std::forward<T>(str);
+    _flip_case_ascii<'a', 'z'>(res);
+    return res;
+}
+
 // ========================
 // --- Substring checks ---
 // ========================
@@ -223,6 +444,156 @@ template <class T>
     return res;
 }
 
+// --- Delimiter search ---
+// ------------------------
+
+// Single char is the most common delimiter, 'std::memchr()' is vectorized by all major standard libraries
+// and lets us skip the substring comparison entirely
+[[nodiscard]] inline std::size_t _find_delimiter(std::string_view str, char delimiter, std::size_t pos) noexcept {
+    if (pos >= str.size()) return std::string_view::npos;
+    const void* match = std::memchr(str.data() + pos, delimiter, str.size() - pos);
+    return match ? static_cast<std::size_t>(static_cast<const char*>(match) - str.data()) : std::string_view::npos;
+}
+
+[[nodiscard]] inline std::size_t _find_delimiter(std::string_view str, std::string_view delimiter,
+                                                 std::size_t pos) noexcept {
+    if (delimiter.empty()) return std::string_view::npos; // empty delimiter doesn't split anything
+    return str.find(delimiter, pos);
+}
+
+[[nodiscard]] inline std::size_t _find_delimiter(std::string_view str, const CharSet& delimiter,
+                                                 std::size_t pos) noexcept {
+    return find_first_of(str, delimiter, pos);
+}
+
+[[nodiscard]] constexpr std::size_t _delimiter_size(char) noexcept { return 1; }
+[[nodiscard]] constexpr std::size_t _delimiter_size(std::string_view delimiter) noexcept { return delimiter.size(); }
+[[nodiscard]] constexpr std::size_t _delimiter_size(const CharSet&) noexcept { return 1; }
+
+// String literals, 'std::string' & etc. are all treated as a substring delimiter
+template <class T>
+using _delimiter_t = std::conditional_t<std::is_same_v<std::decay_t<T>, char>, char,
+                                        std::conditional_t<std::is_same_v<std::decay_t<T>, CharSet>, CharSet,
+                                                           std::string_view>>;
+
+// --- Lazy split ---
+// ------------------
+
+template <class Delimiter>
+class SplitView {
+    std::string_view str;
+    Delimiter        delimiter;
+    bool             keep_empty_tokens;
+
+public:
+    SplitView(std::string_view str, Delimiter delimiter, bool keep_empty_tokens = false)
+        : str(str), delimiter(delimiter), keep_empty_tokens(keep_empty_tokens) {
+        if (_delimiter_size(this->delimiter) == 0) this->keep_empty_tokens = true;
+        // empty delimiter always produces the whole string as a single token, same as '::split_by_delimiter()'
+    }
+
+    // Finds the next token starting from 'cursor', which gets advanced past the following delimiter.
+    // Cursor value of 'str.size() + 1' indicates that the last segment was already consumed.
+    bool next(std::size_t& cursor, std::string_view& token) const noexcept {
+        while (cursor <= this->str.size()) {
+            const std::size_t pos  = _find_delimiter(this->str, this->delimiter, cursor);
+            const std::size_t stop = (pos == std::string_view::npos) ? this->str.size() : pos;
+
+            const std::size_t start = cursor;
+            cursor = (pos == std::string_view::npos) ? this->str.size() + 1 : pos + _delimiter_size(this->delimiter);
+
+            if (this->keep_empty_tokens || start != stop) {
+                token = this->str.substr(start, stop - start);
+                return true;
+            }
+            // don't produce empty tokens in case of leading/trailing/repeated delimiter
+        }
+        return false;
+    }
+
+    class iterator {
+        const SplitView* view   = nullptr;
+        std::size_t      cursor = 0;
+        std::string_view token;
+        bool             done = true;
+
+        friend class SplitView;
+
+        iterator(const SplitView* view) : view(view) { this->done = !this->view->next(this->cursor, this->token); }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view*;
+        using reference         = const std::string_view&;
+
+        iterator() = default;
+
+        reference operator*() const noexcept { return this->token; }
+        pointer   operator->() const noexcept { return &this->token; }
+
+        iterator& operator++() noexcept {
+            this->done = !this->view->next(this->cursor, this->token);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const noexcept {
+            return (this->done && other.done) || (!this->done && !other.done && this->cursor == other.cursor);
+        }
+
+        bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+    };
+
+    [[nodiscard]] iterator begin() const { return iterator(this); }
+    [[nodiscard]] iterator end() const { return iterator(); }
+};
+
+template <class Delimiter>
+[[nodiscard]] SplitView<_delimiter_t<Delimiter>> split_view(std::string_view str, const Delimiter& delimiter,
+                                                             bool keep_empty_tokens = false) {
+    return {str, delimiter, keep_empty_tokens};
+}
+
+// Substring delimiters are stored as a view, temporary strings would leave it dangling
+SplitView<std::string_view> split_view(std::string_view str, std::string&& delimiter,
+                                       bool keep_empty_tokens = false) = delete;
+
+template <class Delimiter, class Func>
+void for_each_token(std::string_view str, const Delimiter& delimiter, Func&& func, bool keep_empty_tokens = false) {
+    const SplitView<_delimiter_t<Delimiter>> view(str, delimiter, keep_empty_tokens);
+
+    std::size_t      cursor = 0;
+    std::string_view token;
+    while (view.next(cursor, token)) func(token);
+}
+
+// Overwrites 'tokens' with the result of the split. Existing elements are assigned rather than recreated, which means
+// both the vector and its strings keep their capacity, repeated splits into the same vector don't allocate at all
+template <class Delimiter, class T>
+void split_into(std::string_view str, const Delimiter& delimiter, std::vector<T>& tokens,
+                bool keep_empty_tokens = false) {
+    static_assert(std::is_assignable_v<T&, std::string_view>, "Token type must be assignable from a string view.");
+
+    std::size_t count = 0;
+    for_each_token(
+        str, delimiter,
+        [&](std::string_view token) {
+            if (count < tokens.size()) tokens[count] = token;
+            else tokens.emplace_back(token);
+            ++count;
+        },
+        keep_empty_tokens);
+
+    tokens.resize(count);
+}
+
 // Note:
 // Most "split by delimer" implementations found online seem to be horrifically inefficient
 // with unnecessary copying/erasure/intermediate tokens, stringstreams and etc.
@@ -232,24 +603,8 @@ template <class T>
 // the vector where it's unavoidable
 [[nodiscard]] inline std::vector<std::string> split_by_delimiter(std::string_view str, std::string_view delimiter,
                                                                  bool keep_empty_tokens = false) {
-    if (delimiter.empty()) return {std::string(str)};
-    // handle empty delimiter explicitly so we can't fall into an infinite loop
-
     std::vector<std::string> tokens;
-    std::size_t              cursor        = 0;
-    std::size_t              segment_start = cursor;
-
-    while ((cursor = str.find(delimiter, cursor)) != std::string_view::npos) {
-        if (keep_empty_tokens || segment_start != cursor)
-            tokens.emplace_back(str.substr(segment_start, cursor - segment_start));
-        // don't emplace empty tokens in case of leading/trailing/repeated delimiter
-        cursor += delimiter.size();
-        segment_start = cursor;
-    }
-
-    if (keep_empty_tokens || segment_start != str.size()) tokens.emplace_back(str.substr(segment_start));
-    // 'cursor' is now at 'npos', so we compare to the size instead
-
+    split_into(str, delimiter, tokens, keep_empty_tokens);
     return tokens;
 }
 
@@ -3548,26 +3548,36 @@ template <class IntType, std::enable_if_t<std::is_integral<IntType>::value, bool
 // _______________________ INCLUDES _______________________
 
 #include <algorithm>        // swap(), find(), count(), is_sorted(), min_element(),
-                            // max_element(), sort(), stable_sort(), min(), max(), remove_if(), copy()
+                            // max_element(), sort(), stable_sort(), min(), max(), remove_if(), copy(), fill_n(),
+                            // lower_bound(), inplace_merge(), find_if(), clamp()
+#include <array>            // array<>
+#include <atomic>           // atomic<>
 #include <cassert>          // assert() // Note: Perhaps temporary
 #include <charconv>         // to_chars()
-#include <cmath>            // isfinite()
+#include <cmath>            // isfinite(), abs(), round(), sqrt(), hypot(), copysign()
 #include <cstddef>          // size_t, ptrdiff_t, nullptr_t
-#include <exception>        // exception
+#include <cstdint>          // uint16_t, uint32_t, uint64_t, int8_t, int32_t
+#include <cstring>          // memcpy()
+#include <exception>        // exception, exception_ptr, current_exception(), rethrow_exception()
 #include <functional>       // reference_wrapper<>, multiplies<>
 #include <initializer_list> // initializer_list<>
 #include <iomanip>          // setw()
 #include <ios>              // right(), boolalpha(), ios::boolalpha
-#include <iterator>         // random_access_iterator_tag, reverse_iterator<>
-#include <memory>           // unique_ptr<>
+#include <iterator>         // random_access_iterator_tag, reverse_iterator<>, make_move_iterator(), prev()
+#include <limits>           // numeric_limits<>
+#include <memory>           // unique_ptr<>, make_unique<>()
+#include <mutex>            // mutex, lock_guard<>
 #include <numeric>          // accumulate()
 #include <ostream>          // ostream
+#include <random>           // seed_seq
 #include <sstream>          // ostringstream
-#include <stdexcept>        // out_of_range, invalid_argument
+#include <stdexcept>        // out_of_range, invalid_argument, runtime_error
 #include <string>           // string
 #include <string_view>      // string_view<>
+#include <thread>           // thread, this_thread::get_id()
 #include <type_traits>      // conditional_t<>, enable_if_t<>, void_t<>, true_type, false_type, remove_reference_t<>
-#include <utility>          // move()
+#include <unordered_set>    // unordered_set<>
+#include <utility>          // move(), pair<>, exchange()
 #include <vector>           // vector<>
 
 // ____________________ DEVELOPER DOCS ____________________
@@ -3918,11 +3928,6 @@ struct default_stringifier {
 template <class FuncType, class Signature>
 using _has_signature_enable_if = std::enable_if_t<std::is_convertible_v<FuncType, std::function<Signature>>, bool>;
 
-template <class T>
-[[nodiscard]] std::unique_ptr<T[]> _make_unique_ptr_array(size_t size) {
-    return std::unique_ptr<T[]>(new T[size]);
-}
-
 // Marker for uncreachable code
 [[noreturn]] inline void _unreachable() {
 // (Implementation from https://en.cppreference.com/w/cpp/utility/unreachable)
@@ -3936,6 +3941,343 @@ template <class T>
 #endif
 }
 
+// ==============================
+// --- Parallelization helper ---
+// ==============================
+
+// Modules are supposed to stay independent, so we can't reuse 'utl::parallel' here. Instead heavier algorithms
+// use a minimal "parallel for" with static chunking over 'std::thread' (a stripped-down analogue of
+// 'parallel::for_loop()'). Each thread gets a single contiguous range of indices, which keeps the mapping between
+// threads and memory the same across calls (good for cache reuse and NUMA first-touch).
+//
+// Spawning threads costs ~tens of microseconds, which is why every algorithm passes a 'min_grain' that prevents
+// splitting work into chunks too small to benefit from it. Exceptions thrown by the workers are rethrown
+// in the calling thread after all workers are joined.
+
+[[nodiscard]] inline std::size_t _max_thread_count() noexcept {
+    const std::size_t detected_threads = std::thread::hardware_concurrency();
+    return detected_threads ? detected_threads : 1;
+}
+
+template <class Func>
+void _parallel_for(std::size_t count, std::size_t min_grain, Func&& func) {
+    // 'func(low, high)' gets called for a set of contiguous ranges covering [0, count)
+    const std::size_t max_chunks   = count / std::max<std::size_t>(min_grain, 1);
+    const std::size_t thread_count = std::min(_max_thread_count(), max_chunks);
+
+    if (thread_count <= 1) {
+        if (count) func(std::size_t(0), count);
+        return;
+    }
+
+    const std::size_t chunk_size = count / thread_count;
+    const std::size_t remainder  = count % thread_count;
+    const auto        chunk_low  = [&](std::size_t t) { return t * chunk_size + std::min(t, remainder); };
+    // first 'remainder' chunks get an extra element, this keeps chunk sizes within 1 element of each other
+
+    std::vector<std::exception_ptr> exceptions(thread_count);
+    std::vector<std::thread>        workers;
+    workers.reserve(thread_count - 1);
+
+    const auto run_chunk = [&](std::size_t t) {
+        try {
+            func(chunk_low(t), chunk_low(t + 1));
+        } catch (...) { exceptions[t] = std::current_exception(); }
+    };
+
+    for (std::size_t t = 1; t < thread_count; ++t) workers.emplace_back(run_chunk, t);
+    run_chunk(0); // calling thread takes the first chunk instead of idling
+
+    for (auto& worker : workers) worker.join();
+    for (const auto& e : exceptions)
+        if (e) std::rethrow_exception(e);
+}
+
+// Minimal grain for '_parallel_for()' over items that take 'operations_per_item' operations each,
+// threads only get spawned once there is enough work to amortize their creation
+[[nodiscard]] constexpr std::size_t _min_grain(std::size_t operations_per_item) noexcept {
+    constexpr std::size_t operations_per_thread = 1 << 16;
+    return std::max<std::size_t>(1, operations_per_thread / std::max<std::size_t>(operations_per_item, 1));
+}
+
+// Tag for container constructors that initialize elements in parallel, regular constructors never spawn threads
+struct ParallelInit {};
+
+constexpr ParallelInit parallel_init{};
+
+// ===================
+// --- Buffer pool ---
+// ===================
+
+// Operators return new containers, so loops like 'for (...) C = A * B + D;' allocate and free buffers of the same
+// size over and over again. When enabled, freed tensor buffers get cached in a thread-local pool instead of being
+// returned to the allocator, and subsequent allocations of a similar size are served from it.
+//
+// Buffers sizes are rounded up to one of 4 size classes per power of 2, which bounds wasted memory by 25%, each class
+// keeps a free list of cached buffers. Pooled buffers remember their capacity in a deleter, which means they can be
+// freed from any thread: buffer gets cached by the pool of that thread (or deleted if pooling is disabled there).
+//
+// Only trivial types are pooled, since reused buffers contain leftover values, which for trivial types is
+// indistinguishable from default-initialization. Pool is opt-in, since cached buffers keep holding memory.
+
+inline thread_local bool        _buffer_pool_enabled   = false;
+inline thread_local bool        _buffer_pool_destroyed = false; // pools can outlive other thread-local objects
+inline thread_local std::size_t _buffer_pool_limit     = std::size_t(256) << 20; // max cached bytes per value type
+
+inline thread_local std::vector<void (*)()> _buffer_pool_clear_functions;
+
+// Larger allocations bypass the pool, this keeps rounded up capacity from overflowing
+constexpr std::size_t _buffer_pool_max_size = std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 2);
+
+struct _buffer_size_class {
+    std::size_t index;
+    std::size_t capacity;
+};
+
+[[nodiscard]] constexpr _buffer_size_class _get_buffer_size_class(std::size_t size) noexcept {
+    if (size <= 8) return {size, size};
+
+    std::size_t power = 4; // 2^(power - 1) < size <= 2^power
+    while ((std::size_t(1) << power) < size) ++power;
+
+    const std::size_t step     = std::size_t(1) << (power - 3);
+    const std::size_t multiple = (size + step - 1) / step; // in [5, 8]
+
+    return {9 + 4 * (power - 4) + (multiple - 5), multiple * step};
+}
+
+template <class T>
+class _buffer_pool {
+    static constexpr std::size_t class_count = _get_buffer_size_class(_buffer_pool_max_size).index + 1;
+
+    std::array<std::vector<T*>, class_count> _free_lists;
+    std::size_t                              _cached_bytes = 0;
+
+public:
+    _buffer_pool() { _buffer_pool_clear_functions.push_back([] { _buffer_pool<T>::instance().clear(); }); }
+
+    _buffer_pool(const _buffer_pool&)            = delete;
+    _buffer_pool& operator=(const _buffer_pool&) = delete;
+
+    ~_buffer_pool() {
+        this->clear();
+        _buffer_pool_destroyed = true;
+    }
+
+    [[nodiscard]] static _buffer_pool& instance() {
+        thread_local _buffer_pool pool;
+        return pool;
+    }
+
+    [[nodiscard]] T* acquire(_buffer_size_class size_class) {
+        auto& free_list = this->_free_lists[size_class.index];
+        if (free_list.empty()) return new T[size_class.capacity];
+
+        T* ptr = free_list.back();
+        free_list.pop_back();
+        this->_cached_bytes -= size_class.capacity * sizeof(T);
+        return ptr;
+    }
+
+    // Returns 'false' if the buffer wasn't cached and should be deleted by the caller
+    [[nodiscard]] bool release(T* ptr, std::size_t capacity) noexcept {
+        const std::size_t bytes = capacity * sizeof(T);
+        if (this->_cached_bytes + bytes > _buffer_pool_limit) return false;
+
+        try {
+            this->_free_lists[_get_buffer_size_class(capacity).index].push_back(ptr);
+        } catch (...) { return false; }
+
+        this->_cached_bytes += bytes;
+        return true;
+    }
+
+    void clear() noexcept {
+        for (auto& free_list : this->_free_lists) {
+            for (T* ptr : free_list) delete[] ptr;
+            free_list.clear();
+        }
+        this->_cached_bytes = 0;
+    }
+};
+
+template <class T>
+struct _pooled_array_deleter {
+    std::size_t capacity = 0; // '0' => buffer was allocated outside of the pool
+
+    void operator()(T* ptr) const noexcept {
+        if (this->capacity && _buffer_pool_enabled && !_buffer_pool_destroyed &&
+            _buffer_pool<T>::instance().release(ptr, this->capacity))
+            return;
+        delete[] ptr;
+    }
+};
+
+template <class T>
+using _unique_array = std::unique_ptr<T[], _pooled_array_deleter<T>>;
+
+template <class T>
+[[nodiscard]] _unique_array<T> _make_unique_ptr_array(std::size_t size) {
+    if constexpr (std::is_trivial_v<T>) {
+        if (_buffer_pool_enabled && !_buffer_pool_destroyed && size && size <= _buffer_pool_max_size) {
+            const auto size_class = _get_buffer_size_class(size);
+            return _unique_array<T>(_buffer_pool<T>::instance().acquire(size_class),
+                                    _pooled_array_deleter<T>{size_class.capacity});
+        }
+    }
+    return _unique_array<T>(new T[size]);
+}
+
+// --- Buffer pool API ---
+// -----------------------
+
+// Enables / disables buffer pool for the current thread
+inline void set_buffer_pool_enabled(bool enabled) noexcept { _buffer_pool_enabled = enabled; }
+
+[[nodiscard]] inline bool buffer_pool_enabled() noexcept { return _buffer_pool_enabled; }
+
+// Sets max amount of bytes cached by the current thread (per value type), buffers above the limit get deleted
+inline void set_buffer_pool_limit(std::size_t bytes) noexcept { _buffer_pool_limit = bytes; }
+
+// Frees all buffers cached by the current thread
+inline void clear_buffer_pool() noexcept {
+    if (_buffer_pool_destroyed) return;
+    for (const auto& clear : _buffer_pool_clear_functions) clear();
+}
+
+// RAII guard that enables buffer pool for the current thread within a scope
+class BufferPoolScope {
+    bool _was_enabled;
+
+public:
+    BufferPoolScope() noexcept : _was_enabled(_buffer_pool_enabled) { _buffer_pool_enabled = true; }
+
+    BufferPoolScope(const BufferPoolScope&)            = delete;
+    BufferPoolScope& operator=(const BufferPoolScope&) = delete;
+
+    ~BufferPoolScope() { _buffer_pool_enabled = this->_was_enabled; }
+};
+
+// ===============================
+// --- Reduced precision types ---
+// ===============================
+
+// Large bandwidth-bound matrices can be stored in 16-bit floats and only widened to 'float' in registers, which
+// halves the memory traffic. Both formats below are software implementations on top of 'std::uint16_t' storage,
+// arithmetic converts operands to 'float', computes and rounds the result back (round-to-nearest-even).
+//
+// Conversions are intentionally 'explicit' in one direction ('float' -> 16-bit) and implicit in the other. This
+// way mixed expressions like 'bfloat16 * float' unambiguously resolve to 'float' arithmetic, while homogeneous
+// expressions use the operators defined below and stay in the 16-bit type.
+
+[[nodiscard]] inline std::uint32_t _float_to_bits(float value) noexcept {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+[[nodiscard]] inline float _bits_to_float(std::uint32_t bits) noexcept {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 'bfloat16' is the upper half of IEEE 754 single precision: 8 exponent bits & 7 mantissa bits. It keeps the range
+// of 'float' at the cost of precision, conversions are just bit shifts.
+struct _bfloat16_format {
+    [[nodiscard]] static std::uint16_t from_float(float value) noexcept {
+        const std::uint32_t bits = _float_to_bits(value);
+        if ((bits & 0x7fffffffu) > 0x7f800000u) return static_cast<std::uint16_t>((bits >> 16) | 0x0040u); // quiet NaN
+        return static_cast<std::uint16_t>((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+    }
+
+    [[nodiscard]] static float to_float(std::uint16_t bits) noexcept {
+        return _bits_to_float(static_cast<std::uint32_t>(bits) << 16);
+    }
+};
+
+// 'float16' is IEEE 754 half precision: 5 exponent bits & 10 mantissa bits, range is '[-65504, 65504]' with
+// subnormals down to '2^-24'. Conversion has to handle rebiasing, subnormals and overflow explicitly.
+struct _float16_format {
+    [[nodiscard]] static std::uint16_t from_float(float value) noexcept {
+        const std::uint32_t bits = _float_to_bits(value);
+        const std::uint32_t sign = (bits >> 16) & 0x8000u;
+        const std::uint32_t abs  = bits & 0x7fffffffu;
+
+        if (abs >= 0x7f800000u) return static_cast<std::uint16_t>(sign | (abs > 0x7f800000u ? 0x7e00u : 0x7c00u));
+        if (abs >= 0x477ff000u) return static_cast<std::uint16_t>(sign | 0x7c00u); // rounds to infinity
+        if (abs <= 0x33000000u) return static_cast<std::uint16_t>(sign);           // rounds to zero
+
+        // Subnormal result, mantissa with an implicit bit gets shifted into place with rounding
+        if (abs < 0x38800000u) {
+            const std::uint32_t mantissa  = (abs & 0x007fffffu) | 0x00800000u;
+            const std::uint32_t shift     = 126u - (abs >> 23);
+            const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const std::uint32_t halfway   = 1u << (shift - 1u);
+            std::uint32_t       result    = mantissa >> shift;
+            if (remainder > halfway || (remainder == halfway && (result & 1u))) ++result;
+            return static_cast<std::uint16_t>(sign | result);
+        }
+
+        // Normal result, rebias exponent & round mantissa from 23 to 10 bits
+        const std::uint32_t rebiased = abs - (112u << 23);
+        return static_cast<std::uint16_t>(sign | ((rebiased + 0x0fffu + ((rebiased >> 13) & 1u)) >> 13));
+    }
+
+    [[nodiscard]] static float to_float(std::uint16_t bits) noexcept {
+        const std::uint32_t sign     = (static_cast<std::uint32_t>(bits) & 0x8000u) << 16;
+        const std::uint32_t exponent = (bits >> 10) & 0x1fu;
+        const std::uint32_t mantissa = bits & 0x03ffu;
+
+        if (exponent == 0x1fu) return _bits_to_float(sign | 0x7f800000u | (mantissa << 13)); // inf & NaN
+        if (exponent == 0) {
+            const float subnormal = static_cast<float>(mantissa) * 5.9604644775390625e-8f; // mantissa * 2^-24
+            return sign ? -subnormal : subnormal;
+        }
+        return _bits_to_float(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    }
+};
+
+template <class Format>
+class _reduced_float {
+    std::uint16_t _bits = 0;
+
+public:
+    constexpr _reduced_float() noexcept = default;
+
+    template <class U, std::enable_if_t<std::is_arithmetic_v<U>, bool> = true>
+    explicit _reduced_float(U value) noexcept : _bits(Format::from_float(static_cast<float>(value))) {}
+
+    operator float() const noexcept { return Format::to_float(this->_bits); }
+
+    [[nodiscard]] static _reduced_float from_bits(std::uint16_t bits) noexcept {
+        _reduced_float res;
+        res._bits = bits;
+        return res;
+    }
+
+    [[nodiscard]] std::uint16_t bits() const noexcept { return this->_bits; }
+
+    // - Arithmetic -
+    _reduced_float& operator+=(float other) noexcept { return *this = _reduced_float(float(*this) + other); }
+    _reduced_float& operator-=(float other) noexcept { return *this = _reduced_float(float(*this) - other); }
+    _reduced_float& operator*=(float other) noexcept { return *this = _reduced_float(float(*this) * other); }
+    _reduced_float& operator/=(float other) noexcept { return *this = _reduced_float(float(*this) / other); }
+
+    friend _reduced_float operator+(_reduced_float l, _reduced_float r) noexcept { return l += r; }
+    friend _reduced_float operator-(_reduced_float l, _reduced_float r) noexcept { return l -= r; }
+    friend _reduced_float operator*(_reduced_float l, _reduced_float r) noexcept { return l *= r; }
+    friend _reduced_float operator/(_reduced_float l, _reduced_float r) noexcept { return l /= r; }
+
+    friend _reduced_float operator+(_reduced_float x) noexcept { return x; }
+    friend _reduced_float operator-(_reduced_float x) noexcept { return from_bits(x._bits ^ 0x8000u); }
+
+    // Comparison goes through implicit conversion to 'float', which gives correct semantics for zeroes & NaNs
+};
+
+using bfloat16 = _reduced_float<_bfloat16_format>;
+using float16  = _reduced_float<_float16_format>;
+
 // =======================
 // --- Utility Classes ---
 // =======================
@@ -4124,10 +4466,10 @@ struct SparseEntry2D {
     constexpr static bool is_sparse_entry_2d = true;
 
     [[nodiscard]] bool operator<(const SparseEntry2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
+        return (this->i < other.i) || (this->i == other.i && this->j < other.j);
     }
     [[nodiscard]] bool operator>(const SparseEntry2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
+        return (this->i > other.i) || (this->i == other.i && this->j > other.j);
     }
 };
 
@@ -4136,10 +4478,10 @@ struct Index2D {
     size_t j;
 
     [[nodiscard]] bool operator<(const Index2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
+        return (this->i < other.i) || (this->i == other.i && this->j < other.j);
     }
     [[nodiscard]] bool operator>(const Index2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
+        return (this->i > other.i) || (this->i == other.i && this->j > other.j);
     }
     [[nodiscard]] bool operator==(const Index2D& other) const noexcept {
         return (this->i == other.i) && (this->j == other.j);
@@ -4308,7 +4650,7 @@ template <utl_mvl_tensor_arg_defs>
 struct _2d_dense_data {
 private:
     using value_type = typename _types<T>::value_type;
-    using _data_t    = _choose_based_on_ownership<_ownership, std::unique_ptr<value_type[]>, _observer_ptr<value_type>,
+    using _data_t    = _choose_based_on_ownership<_ownership, _unique_array<value_type>, _observer_ptr<value_type>,
                                                _observer_ptr<const value_type>>;
 
 public:
@@ -4329,6 +4671,15 @@ struct _2d_sparse_data {
     std::vector<triplet_type> _data;
 };
 
+// Index bounds of lazy views, declared early since tensors create lazy views of themselves
+struct _lazy_bounds {
+    std::size_t row_low;
+    std::size_t row_high;
+    std::size_t col_low;
+    std::size_t col_high;
+    bool        diagonal_only;
+};
+
 // ===================
 // --- Tensor Type ---
 // ===================
@@ -4688,13 +5039,14 @@ class GenericTensor
     utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] size_type
         _search_ij(size_type i, size_type j) const noexcept {
         // Returns this->size() if {i, j} wasn't found.
-        // Linear search for small .size() (more efficient fue to prediction and cache locality)
-        if (true) {
-            for (size_type idx = 0; idx < this->size(); ++idx)
-                if (this->_data[idx].i == i && this->_data[idx].j == j) return idx;
-            return this->size();
-        }
-        // TODO: Binary search for larger .size() (N(log2(size)) instead of N(size) asymptotically)
+        // Triplets are always kept sorted lexicographically, which allows binary search.
+        const auto less = [](const sparse_entry_type& entry, const Index2D& index) -> bool {
+            return (entry.i < index.i) || (entry.i == index.i && entry.j < index.j);
+        };
+
+        const auto it = std::lower_bound(this->_data.begin(), this->_data.end(), Index2D{i, j}, less);
+        if (it == this->_data.end() || it->i != i || it->j != j) return this->size();
+        return static_cast<size_type>(it - this->_data.begin());
     }
 
 public:
@@ -4721,12 +5073,17 @@ class GenericTensor
 
     // --- Reductions ---
     // ------------------
+    // '.for_each()' is used instead of iterators since it has a fast path for strided matrices
     utl_mvl_reqs(_has_binary_op_plus<value_type>::value) [[nodiscard]] value_type sum() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type());
+        value_type res = value_type();
+        this->for_each([&](const_reference elem) { res = std::move(res) + elem; });
+        return res;
     }
 
     utl_mvl_reqs(_has_binary_op_multiplies<value_type>::value) [[nodiscard]] value_type product() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type(), std::multiplies<value_type>());
+        value_type res = value_type(1);
+        this->for_each([&](const_reference elem) { res = std::move(res) * elem; });
+        return res;
     }
 
     utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] value_type min() const {
@@ -4788,29 +5145,77 @@ class GenericTensor
         return !this->true_for_any(inversed_predicate);
     }
 
+    // --- Iteration kernels ---
+    // -------------------------
+private:
+    // Visits elements with flat indices [low, high) in order, calling 'func(elem, idx, i, j)'.
+    //
+    // Dense & strided matrices get traversed one major line (row for RC, column for CR) at a time with plain
+    // pointer increments, this avoids 'idx -> { i, j }' division & modulo on every element. When elements of a
+    // line are contiguous (all dense matrices, blocks and rows of RC matrices, blocks and columns of CR matrices)
+    // the inner loop is a simple linear pass that compilers can vectorize. Sparse tensors just walk their triplets.
+    //
+    // Implemented as a static template so that const & non-const versions can share the code.
+    template <class Self, class Func>
+    static void _for_each_in_range(Self& tensor, size_type low, size_type high, Func&& func) {
+        if constexpr (self::params::type == Type::SPARSE) {
+            for (size_type idx = low; idx < high; ++idx)
+                func(tensor[idx], idx, tensor._data[idx].i, tensor._data[idx].j);
+        } else {
+            constexpr bool is_rc = (self::params::layout == Layout::RC);
+
+            const size_type minor_extent = tensor.extent_minor();
+            if (low >= high || minor_extent == 0) return;
+
+            const size_type minor_step = is_rc ? tensor.col_stride() : tensor.row_stride();
+            const size_type major_skip = is_rc ? tensor.row_stride() : tensor.col_stride();
+            const size_type major_step = minor_extent * minor_step + major_skip;
+            const auto      data       = tensor.data();
+
+            const auto visit = [&](auto& elem, size_type idx, size_type major, size_type minor) {
+                if constexpr (is_rc) func(elem, idx, major, minor);
+                else func(elem, idx, minor, major);
+            };
+
+            size_type major = low / minor_extent;
+            size_type minor = low % minor_extent;
+
+            for (size_type idx = low; idx < high; ++major, minor = 0) {
+                const size_type line_end = std::min(minor_extent, minor + (high - idx));
+                const auto      line     = data + major * major_step;
+
+                if (minor_step == 1) {
+                    for (size_type n = minor; n < line_end; ++n, ++idx) visit(line[n], idx, major, n);
+                } else {
+                    for (size_type n = minor; n < line_end; ++n, ++idx) visit(line[n * minor_step], idx, major, n);
+                }
+            }
+        }
+    }
+
+public:
     // --- Const algorithms ---
     // ------------------------
     template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
     const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](const_reference elem, size_type, size_type, size_type) { func(elem); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
     const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](const_reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
               utl_mvl_require(dimension == Dimension::MATRIX)>
     const self& for_each(FuncType func) const {
-        // Loop over all 2D indices using 1D loop with idx->ij conversion.
-        // This is just as fast and ensures looping only over existing elements in non-dense matrices.
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
-        }
+        // Loop over all 2D indices, for sparse matrices this ensures looping only over existing elements
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](const_reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
         return *this;
     }
 
@@ -4819,24 +5224,24 @@ class GenericTensor
     template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
               utl_mvl_require(ownership != Ownership::CONST_VIEW)>
     self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](reference elem, size_type, size_type, size_type) { func(elem); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
               utl_mvl_require(ownership != Ownership::CONST_VIEW)>
     self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
         return *this;
     }
 
     template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
               utl_mvl_require(dimension == Dimension::MATRIX)>
     self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
-        }
+        _for_each_in_range(*this, 0, this->size(),
+                           [&](reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
         return *this;
     }
 
@@ -4908,6 +5313,116 @@ class GenericTensor
         return *this;
     }
 
+    // --- Parallel algorithms ---
+    // ---------------------------
+
+    // Same as regular algorithms, except the tensor gets split into contiguous chunks of elements that are
+    // processed by different threads (see notes on '_parallel_for()'). 'func' has to be safe to call concurrently.
+    // Since the split is static, repeated calls process the same elements on the same threads, which allows
+    // initializing large tensors with '.parallel_fill()' (or constructing them with 'parallel_init') to take advantage
+    // of NUMA first-touch policy.
+private:
+    constexpr static size_type _parallel_min_grain = 1 << 16;
+
+    template <class Self, class Func>
+    static void _parallel_for_each_in_range(Self& tensor, Func&& func) {
+        _parallel_for(tensor.size(), _parallel_min_grain,
+                      [&](size_type low, size_type high) { _for_each_in_range(tensor, low, high, func); });
+    }
+
+public:
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
+    const self& parallel_for_each(FuncType func) const {
+        _parallel_for_each_in_range(*this, [&](const_reference elem, size_type, size_type, size_type) { func(elem); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
+    const self& parallel_for_each(FuncType func) const {
+        _parallel_for_each_in_range(
+            *this, [&](const_reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    const self& parallel_for_each(FuncType func) const {
+        _parallel_for_each_in_range(
+            *this, [&](const_reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_for_each(FuncType func) {
+        _parallel_for_each_in_range(*this, [&](reference elem, size_type, size_type, size_type) { func(elem); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_for_each(FuncType func) {
+        _parallel_for_each_in_range(*this,
+                                    [&](reference elem, size_type idx, size_type, size_type) { func(elem, idx); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& parallel_for_each(FuncType func) {
+        _parallel_for_each_in_range(*this,
+                                    [&](reference elem, size_type, size_type i, size_type j) { func(elem, i, j); });
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(elem); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& parallel_transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(elem, i); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType,
+              _has_signature_enable_if<FuncType, value_type(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& parallel_transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(elem, i, j); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) self& parallel_fill(const_reference value) {
+        const auto func_wrapper = [&](reference elem) { elem = value; };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type()> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& parallel_fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& parallel_fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(i); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& parallel_fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(i, j); };
+        return this->parallel_for_each(func_wrapper);
+    }
+
     // --- Sparse Subviews ---
     // -----------------------
 
@@ -5139,6 +5654,44 @@ class GenericTensor
         return this->block(0, j, this->rows(), 1);
     }
 
+    // --- Lazy Subviews ---
+    // ---------------------
+
+    // Same as '.filter()', '.diagonal()' and '.block()', but matching elements are found when the view gets
+    // iterated instead of being collected into a triplet array, see 'LazyView' for details
+
+    // - Const views -
+    template <class UnaryPredicate, utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] auto lazy_filter(UnaryPredicate predicate) const {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this)).filter(std::move(predicate));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] auto lazy_diagonal() const {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this, true));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] auto
+        lazy_block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) const {
+        return _make_lazy_view(*this, _lazy_block_bounds(*this, block_i, block_j, block_rows, block_cols));
+    }
+
+    // - Mutable views -
+    template <class UnaryPredicate,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    [[nodiscard]] auto lazy_filter(UnaryPredicate predicate) {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this)).filter(std::move(predicate));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] auto
+        lazy_diagonal() {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this, true));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] auto
+        lazy_block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) {
+        return _make_lazy_view(*this, _lazy_block_bounds(*this, block_i, block_j, block_rows, block_cols));
+    }
+
     // --- Sparse operations ---
     // -------------------------
 
@@ -5161,26 +5714,26 @@ class GenericTensor
 
     utl_mvl_reqs(dimension == Dimension::MATRIX &&
                  type == Type::SPARSE) self& insert_triplets(const std::vector<sparse_entry_type>& triplets) {
-        // Bulk-insert triplets and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
+        // Bulk-insert triplets while keeping them sorted by index. Existing triplets are already sorted,
+        // so we only need to sort the inserted ones and merge both ranges => O(N + K log K) instead of
+        // re-sorting everything on each insertion.
+        const auto old_size = static_cast<difference_type>(this->_data.size());
 
         this->_data.insert(this->_data.end(), triplets.begin(), triplets.end());
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+
+        const auto middle = this->_data.begin() + old_size;
+        if (!std::is_sorted(middle, this->_data.end())) std::sort(middle, this->_data.end());
+        std::inplace_merge(this->_data.begin(), middle, this->_data.end());
 
         return *this;
     }
 
     utl_mvl_reqs(dimension == Dimension::MATRIX &&
                  type == Type::SPARSE) self& rewrite_triplets(std::vector<sparse_entry_type>&& triplets) {
-        // Move-construct all triplets at once and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
-
+        // Move-construct all triplets at once and sort by index (unless they are already sorted,
+        // which is the case for triplets produced by other sparse matrices or 'SparseMatrixBuilder')
         this->_data = std::move(triplets);
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+        if (!std::is_sorted(this->_data.begin(), this->_data.end())) std::sort(this->_data.begin(), this->_data.end());
 
         return *this;
     }
@@ -5189,30 +5742,27 @@ class GenericTensor
                  type == Type::SPARSE) self& erase_triplets(std::vector<Index2D> indices) {
         // Erase triplets with {i, j} from 'indices' using the fact that both
         // 'indices' and triplets are sorted. We can scan through triplets once
-        // while advancing 'cursor' when 'indices[cursor]' gets deleted, which
-        // result in all necessary triplets being marked for erasure in order.
+        // while advancing 'cursor' past indices that are behind the current triplet,
+        // which result in all necessary triplets being marked for erasure in order.
         std::sort(indices.begin(), indices.end());
         std::size_t cursor = 0;
 
         const auto erase_condition = [&](const sparse_entry_type& triplet) -> bool {
+            const Index2D index{triplet.i, triplet.j};
+            while (cursor < indices.size() && indices[cursor] < index) ++cursor;
             /* Stop erasing once all target indices are handled */
             if (cursor == indices.size()) return false;
-            if (indices[cursor].i == triplet.i && indices[cursor].j == triplet.j) {
+            if (indices[cursor] == index) {
                 ++cursor;
                 return true;
             }
             return false;
         };
 
+        // 'std::remove_if()' is stable, triplets stay sorted
         const auto iter = std::remove_if(this->_data.begin(), this->_data.end(), erase_condition);
         this->_data.erase(iter, this->_data.end());
 
-        // Re-sort triplets just in case
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
-
         return *this;
     }
 
@@ -5240,17 +5790,23 @@ class GenericTensor
     // Copy-assignment
     self& operator=(const self& other) {
         // Note: copy-assignment operator CANNOT be templated, it has to be implemented with 'if constexpr'
+        if (this == &other) return *this;
+
+        // Dense containers reuse existing buffer of the same size, copying into preallocated matrices doesn't allocate
+        bool reuse_buffer = false;
+        if constexpr (self::params::type == Type::DENSE) reuse_buffer = this->_data && this->size() == other.size();
+
         this->_rows = other.rows();
         this->_cols = other.cols();
         if constexpr (self::params::type == Type::DENSE) {
-            this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+            if (!reuse_buffer) this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
             std::copy(other.begin(), other.end(), this->begin());
         }
         if constexpr (self::params::type == Type::STRIDED) {
             this->_row_stride = other.row_stride();
             this->_col_stride = other.col_stride();
-            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-            std::copy(other.begin(), other.end(), this->begin());
+            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+            other.for_each([&](const_reference elem, size_type i, size_type j) { this->operator()(i, j) = elem; });
         }
         if constexpr (self::params::type == Type::SPARSE) { this->_data = other._data; }
         return *this;
@@ -5287,12 +5843,12 @@ class GenericTensor
         this->_rows       = other.rows();
         this->_cols       = other.cols();
         this->_row_stride = other.row_stride();
-        this->_col_strude = other.col_stride();
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value_type());
+        this->_col_stride = other.col_stride();
         // Not quite sure whether swapping strides when changing layouts like this is okay,
         // but it seems to be correct
-        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_cols_stride);
+        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_col_stride);
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->fill(value_type());
         other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
         return *this;
         // copying from sparse to strided works, all elements that weren't in the sparse matrix remain
@@ -5386,6 +5942,15 @@ class GenericTensor
         this->fill(value);
     }
 
+    // Init-with-value in parallel, see notes on '.parallel_fill()'
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
+        GenericTensor(size_type rows, size_type cols, const_reference value, ParallelInit) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->parallel_fill(value);
+    }
+
     // Init-with-lambda
     template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
                                               ownership == Ownership::CONTAINER)>
@@ -5483,6 +6048,18 @@ class GenericTensor
         this->fill(value);
     }
 
+    // Init-with-value in parallel, see notes on '.parallel_fill()'
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+        GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                      const_reference value, ParallelInit) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->parallel_fill(value);
+    }
+
     // Init-with-lambda
     template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
                                               ownership == Ownership::CONTAINER)>
@@ -5644,3456 +6221,8467 @@ template <class T, Checking checking = _default_checking>
 using ConstSparseMatrixView =
     GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONST_VIEW, checking, Layout::SPARSE>;
 
-// ==================
-// --- Formatters ---
-// ==================
+// ==============================
+// --- Sparse matrix assembly ---
+// ==============================
 
-namespace format {
+// Compressed sparse row format, a more compact sparse representation that stores column indices
+// and values of each row contiguously, while rows are described by offsets into these arrays:
+//
+//    row 'i' occupies [ row_offsets[i], row_offsets[i + 1] ) range of 'col_indices' and 'values'
+//
+// Unlike 'SparseMatrix' it is not a part of the 'GenericTensor' API and is intended mostly as a
+// format for interop and kernels that benefit from direct access to rows.
+template <class T>
+class CSRMatrix {
+public:
+    using self            = CSRMatrix;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
 
-// --- Implementation ---
-// ----------------------
+private:
+    size_type               _rows        = 0;
+    size_type               _cols        = 0;
+    std::vector<size_type>  _row_offsets = {0};
+    std::vector<size_type>  _col_indices;
+    std::vector<value_type> _values;
 
-// The "header" of all human-readable formats that displays
-// some meta info with tensor type and dimensions.
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    std::string buffer;
+public:
+    CSRMatrix() = default;
+
+    explicit CSRMatrix(size_type rows, size_type cols, std::vector<size_type> row_offsets,
+                       std::vector<size_type> col_indices, std::vector<value_type> values)
+        : _rows(rows), _cols(cols), _row_offsets(std::move(row_offsets)), _col_indices(std::move(col_indices)),
+          _values(std::move(values)) {
+        if (this->_row_offsets.size() != rows + 1)
+            throw std::invalid_argument(stringify("CSR row offsets should have rows + 1 (which is ", rows + 1,
+                                                  ") elements, got ", this->_row_offsets.size(), "."));
+        if (this->_col_indices.size() != this->_values.size() || this->_row_offsets.back() != this->_values.size())
+            throw std::invalid_argument("CSR column indices, values and row offsets don't match in size.");
+    }
+
+    // Conversion from any 2D tensor, dense tensors only keep their non-default-initialized elements
+    template <class Tensor, _is_tensor_enable_if<Tensor> = true>
+    explicit CSRMatrix(const Tensor& tensor) {
+        // Sparse tensors always keep their triplets sorted, other tensors have to be sorted first
+        if constexpr (std::decay_t<Tensor>::params::type == Type::SPARSE) this->_assign_from_sorted(tensor);
+        else this->_assign_from_sorted(SparseMatrix<value_type>(tensor));
+    }
+
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+    [[nodiscard]] size_type size() const noexcept { return this->_values.size(); }
+    [[nodiscard]] bool      empty() const noexcept { return this->size() == 0; }
+
+    [[nodiscard]] const std::vector<size_type>&  row_offsets() const noexcept { return this->_row_offsets; }
+    [[nodiscard]] const std::vector<size_type>&  col_indices() const noexcept { return this->_col_indices; }
+    [[nodiscard]] const std::vector<value_type>& values() const noexcept { return this->_values; }
+    [[nodiscard]] std::vector<value_type>&       values() noexcept { return this->_values; }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type i = 0; i < this->rows(); ++i)
+            for (size_type k = this->_row_offsets[i]; k < this->_row_offsets[i + 1]; ++k)
+                func(this->_values[k], i, this->_col_indices[k]);
+        return *this;
+    }
 
-    if constexpr (_type == Type::DENSE) buffer += "Dense";
-    if constexpr (_type == Type::STRIDED) buffer += "Strided";
-    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
-    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
-    if constexpr (_dimension == Dimension::MATRIX)
-        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
+    [[nodiscard]] SparseMatrix<value_type> to_sparse() const {
+        std::vector<SparseEntry2D<value_type>> triplets;
+        triplets.reserve(this->size());
+        this->for_each([&](const_reference value, size_type i, size_type j) { triplets.push_back({i, j, value}); });
+        return SparseMatrix<value_type>(this->rows(), this->cols(), std::move(triplets));
+    }
 
-    return buffer;
-}
+    // Lazy views only visit rows inside the bounds, see 'LazyView'
+    template <class UnaryPredicate>
+    [[nodiscard]] auto lazy_filter(UnaryPredicate predicate) const {
+        return _make_lazy_view(*this, _lazy_full_bounds(*this)).filter(std::move(predicate));
+    }
 
-// Human-readable formats automatically collapse matrices
-// that are too  large to be reasonably parsed by a human
-constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+    [[nodiscard]] auto lazy_diagonal() const { return _make_lazy_view(*this, _lazy_full_bounds(*this, true)); }
 
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+    [[nodiscard]] auto lazy_block(size_type block_i, size_type block_j, size_type block_rows,
+                                  size_type block_cols) const {
+        return _make_lazy_view(*this, _lazy_block_bounds(*this, block_i, block_j, block_rows, block_cols));
+    }
+
+private:
+    template <class SortedTensor>
+    void _assign_from_sorted(const SortedTensor& tensor) {
+        this->_rows = tensor.rows();
+        this->_cols = tensor.cols();
+        this->_row_offsets.assign(this->rows() + 1, 0);
+        this->_col_indices.clear();
+        this->_values.clear();
+        this->_col_indices.reserve(tensor.size());
+        this->_values.reserve(tensor.size());
+
+        tensor.for_each([&](const_reference value, size_type i, size_type j) {
+            ++this->_row_offsets[i + 1];
+            this->_col_indices.push_back(j);
+            this->_values.push_back(value);
+        });
+
+        for (size_type i = 0; i < this->rows(); ++i) this->_row_offsets[i + 1] += this->_row_offsets[i];
+    }
+};
+
+// LSD radix sort of sparse entries by their linearized index 'i * cols + j', which is the same thing as
+// lexicographic order of { i, j }. Only as many 11-bit digits as needed to represent the largest index get
+// sorted, for a 10^6 x 10^6 matrix that is 4 passes over the data regardless of the entry count.
+//
+// Each pass is parallelized the usual way: every chunk builds a local histogram, histograms get combined
+// into per-chunk offsets (digit-major, chunk-minor, which keeps the sort stable) and then every chunk scatters
+// its entries independently.
+template <class Entry>
+void _radix_sort_sparse_entries(std::vector<Entry>& entries, std::size_t rows, std::size_t cols) {
+    constexpr std::size_t digit_bits = 11;
+    constexpr std::size_t radix      = std::size_t(1) << digit_bits;
+    constexpr std::size_t digit_mask = radix - 1;
+    constexpr std::size_t min_grain  = 1 << 16;
+
+    // Linearized index doesn't fit into 'std::size_t', fallback onto comparison sort
+    if (cols != 0 && rows > std::numeric_limits<std::size_t>::max() / cols) {
+        std::stable_sort(entries.begin(), entries.end());
+        return;
+    }
+
+    const auto key = [&](const Entry& entry) -> std::size_t { return entry.i * cols + entry.j; };
+
+    std::size_t max_key = 0;
+    for (const auto& entry : entries) max_key = std::max(max_key, key(entry));
+
+    std::size_t key_bits = 0;
+    while (key_bits < std::numeric_limits<std::size_t>::digits && (max_key >> key_bits) != 0) ++key_bits;
+
+    const std::size_t passes      = (key_bits + digit_bits - 1) / digit_bits;
+    const std::size_t size        = entries.size();
+    const std::size_t chunk_count = std::clamp<std::size_t>(size / min_grain, 1, _max_thread_count());
+    const auto        chunk_low   = [&](std::size_t c) { return size * c / chunk_count; };
+
+    std::vector<Entry>                          buffer(size);
+    std::vector<std::array<std::size_t, radix>> histograms(chunk_count);
+
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        const std::size_t shift = pass * digit_bits;
+        const auto        digit = [&](const Entry& entry) { return (key(entry) >> shift) & digit_mask; };
+
+        _parallel_for(chunk_count, 1, [&](std::size_t low, std::size_t high) {
+            for (std::size_t c = low; c < high; ++c) {
+                histograms[c].fill(0);
+                for (std::size_t idx = chunk_low(c); idx < chunk_low(c + 1); ++idx)
+                    ++histograms[c][digit(entries[idx])];
+            }
+        });
+
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < radix; ++d) {
+            for (std::size_t c = 0; c < chunk_count; ++c) {
+                const std::size_t count = histograms[c][d];
+                histograms[c][d]        = offset;
+                offset += count;
+            }
+        }
+
+        _parallel_for(chunk_count, 1, [&](std::size_t low, std::size_t high) {
+            for (std::size_t c = low; c < high; ++c)
+                for (std::size_t idx = chunk_low(c); idx < chunk_low(c + 1); ++idx)
+                    buffer[histograms[c][digit(entries[idx])]++] = std::move(entries[idx]);
+        });
+
+        std::swap(entries, buffer);
+    }
 }
 
-// Generic method to do "dense matrix print" with given delimers.
-// Cuts down on repitition since a lot of formats only differ in the delimers used.
-template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
-[[nodiscard]] std::string
-_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,      //
-                      std::string_view                                                              begin,       //
-                      std::string_view                                                              row_begin,   //
-                      std::string_view                                                              col_delimer, //
-                      std::string_view                                                              row_end,     //
-                      std::string_view                                                              row_delimer, //
-                      std::string_view                                                              end,         //
-                      Func                                                                          stringifier  //
-) {
-    if (tensor.empty()) return (std::string() += begin) += end;
+// Builder for assembling large sparse matrices from (possibly duplicate) contributions, a typical case being
+// FEM assembly where each element adds its local matrix into a global one. Contributions get accumulated
+// in per-thread buffers, which means '.add()' can be called concurrently from any number of threads without
+// contention. Once all contributions are added, '.build()' sorts them with a parallel radix sort, sums up
+// duplicates and emits a sorted sparse matrix in a single pass.
+//
+// Per-thread buffers are found through a 'thread_local' cache, so only the first '.add()' from each thread
+// has to lock a mutex. Buffers keep their capacity after '.build()', repeated assembly (like re-assembling
+// the same system every time step) doesn't allocate after the first iteration.
+template <class T>
+class SparseMatrixBuilder {
+public:
+    using self            = SparseMatrixBuilder;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+    using entry_type      = SparseEntry2D<value_type>;
 
-    Matrix<std::string> strings(tensor.rows(), tensor.cols());
+private:
+    using _buffer_type = std::vector<entry_type>;
 
-    // Stringify
-    if constexpr (type == Type::SPARSE) strings.fill("-");
-    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
-    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
-    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
+    size_type     _rows = 0;
+    size_type     _cols = 0;
+    std::uint64_t _id   = 0; // unique id, guards thread-local caches against builders reusing the same address
 
-    // Get column widths - we want matrix to format nice and aligned
-    std::vector<std::size_t> column_widths(strings.cols(), 0);
-    for (std::size_t i = 0; i < strings.rows(); ++i)
-        for (std::size_t j = 0; j < strings.cols(); ++j)
-            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
+    mutable std::mutex                                                     _mutex;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<_buffer_type>>> _buffers;
 
-    // Format with proper alignment
-    std::string buffer(begin);
-    for (std::size_t i = 0; i < strings.rows(); ++i) {
-        buffer += row_begin;
-        for (std::size_t j = 0; j < strings.cols(); ++j) {
-            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
-            buffer += strings(i, j);
-            if (j + 1 < strings.cols()) buffer += col_delimer;
+    inline static std::atomic<std::uint64_t> _id_counter{0};
+
+    [[nodiscard]] _buffer_type& _local_buffer() {
+        thread_local std::uint64_t cached_id     = 0;
+        thread_local _buffer_type* cached_buffer = nullptr;
+
+        if (cached_id == this->_id) return *cached_buffer;
+
+        const std::lock_guard lock(this->_mutex);
+
+        const auto thread_id = std::this_thread::get_id();
+        auto       it        = std::find_if(this->_buffers.begin(), this->_buffers.end(),
+                                            [&](const auto& buffer) { return buffer.first == thread_id; });
+        if (it == this->_buffers.end()) {
+            this->_buffers.emplace_back(thread_id, std::make_unique<_buffer_type>());
+            it = std::prev(this->_buffers.end());
         }
-        buffer += row_end;
-        if (i + 1 < strings.rows()) buffer += row_delimer;
+
+        cached_id     = this->_id;
+        cached_buffer = it->second.get();
+        return *cached_buffer;
     }
-    buffer += end;
 
-    return buffer;
-}
+    [[nodiscard]] std::vector<entry_type> _assemble() {
+        const std::lock_guard lock(this->_mutex);
 
-// --- Human-readable formats ---
-// ------------------------------
+        size_type total_size = 0;
+        for (const auto& buffer : this->_buffers) total_size += buffer.second->size();
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+        std::vector<entry_type> entries;
+        entries.reserve(total_size);
+        for (auto& buffer : this->_buffers) {
+            entries.insert(entries.end(), std::make_move_iterator(buffer.second->begin()),
+                           std::make_move_iterator(buffer.second->end()));
+            buffer.second->clear();
+        }
 
-    std::string buffer = _tensor_meta_string(tensor);
+        _radix_sort_sparse_entries(entries, this->rows(), this->cols());
 
-    buffer += "  { ";
-    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
-        buffer += stringifier(tensor[idx]);
-        if (idx + 1 < tensor.size()) buffer += ", ";
+        // Sum up duplicates, sort is stable so contributions from each thread get summed in the order of addition
+        if (entries.empty()) return entries;
+
+        size_type last = 0;
+        for (size_type idx = 1; idx < entries.size(); ++idx) {
+            if (entries[idx].i == entries[last].i && entries[idx].j == entries[last].j)
+                entries[last].value += entries[idx].value;
+            else entries[++last] = std::move(entries[idx]);
+        }
+        entries.resize(last + 1);
+
+        return entries;
     }
-    buffer += " }\n";
 
-    return buffer;
-}
+public:
+    explicit SparseMatrixBuilder(size_type rows, size_type cols) : _rows(rows), _cols(cols), _id(++_id_counter) {}
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                        Func                                          stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+    SparseMatrixBuilder(const self&)            = delete;
+    SparseMatrixBuilder& operator=(const self&) = delete;
 
-    std::string buffer = _tensor_meta_string(tensor);
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
 
-    if constexpr (_dimension == Dimension::MATRIX) {
-        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
-            buffer += stringify("(", i, ", ", j, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
-    } else {
-        tensor.for_each([&](const T& elem, std::size_t i) {
-            buffer += stringify("(", i, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
+    // Thread-safe
+    self& add(size_type i, size_type j, const_reference value) {
+        utl_mvl_assert(i < this->rows() && j < this->cols());
+        this->_local_buffer().push_back({i, j, value});
+        return *this;
     }
 
-    return buffer;
-}
+    // Thread-safe, reserves space in the buffer of the calling thread
+    self& reserve(size_type count) {
+        this->_local_buffer().reserve(count);
+        return *this;
+    }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+    // Not thread-safe relative to '.add()'
+    [[nodiscard]] size_type contributions() const {
+        const std::lock_guard lock(this->_mutex);
 
-    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
-}
+        size_type total_size = 0;
+        for (const auto& buffer : this->_buffers) total_size += buffer.second->size();
+        return total_size;
+    }
 
-// --- Export formats ---
-// ----------------------
+    self& clear() {
+        const std::lock_guard lock(this->_mutex);
+        for (auto& buffer : this->_buffers) buffer.second->clear();
+        return *this;
+    }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
+    // Not thread-safe relative to '.add()', builder is left empty and can be reused
+    [[nodiscard]] SparseMatrix<value_type> build() {
+        return SparseMatrix<value_type>(this->rows(), this->cols(), this->_assemble());
+        // triplets are already sorted, matrix constructor will only verify it
+    }
+
+    [[nodiscard]] CSRMatrix<value_type> build_csr() { return CSRMatrix<value_type>(this->build()); }
+};
+
+// ======================
+// --- Random tensors ---
+// ======================
+
+// Modules are supposed to stay independent, so instead of depending on 'utl::random' these functions take
+// the generator type & distribution as template parameters, any standard-compatible ones will work.
+//
+// Work is split into fixed blocks of elements (or rows for sparse matrices), every block gets a fresh copy of
+// the distribution & its own generator seeded with a hash of '{ seed, block }'. Results depend only on the seed
+// and not on the number of threads, generators with expensive seeding (like 'std::mt19937') get amortized over
+// the whole block.
+
+constexpr std::size_t _random_block_size       = 1 << 12; // elements per generator
+constexpr std::size_t _random_sparse_block_rows = 1 << 6;  // sparse rows per generator
+constexpr std::size_t _random_sparse_linear_nnz = 1 << 5;  // rows up to this size check picks with a linear scan
+
+// SplitMix64 finalizer over the block index, neighbouring blocks get unrelated seeds
+[[nodiscard]] constexpr std::uint64_t _random_block_seed(std::uint64_t seed, std::uint64_t block) noexcept {
+    std::uint64_t z = seed + (block + 1) * 0x9E3779B97F4A7C15u;
+    z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z               = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
+// Seeding through 'std::seed_seq' passes all 64 bits of the block seed to 32-bit generators as well
+template <class Gen>
+[[nodiscard]] Gen _make_block_generator(std::uint64_t seed, std::uint64_t block) {
+    const std::uint64_t block_seed = _random_block_seed(seed, block);
+    std::seed_seq       seq{static_cast<std::uint32_t>(block_seed), static_cast<std::uint32_t>(block_seed >> 32)};
+    return Gen(seq);
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
+// 'std::uniform_int_distribution<>' uses a different algorithm in every standard library, which would make sparse
+// patterns platform-dependent. Instead we take raw generator output, rejecting values of generators with a range that
+// isn't a power of 2 (like 'std::minstd_rand'), and reduce it to '[0, bound)' with rejection on the remainder.
+template <class Gen>
+[[nodiscard]] constexpr int _random_bits_per_call() noexcept {
+    constexpr auto range = static_cast<std::uint64_t>(Gen::max() - Gen::min());
+    if (range == std::numeric_limits<std::uint64_t>::max()) return 64;
+
+    int bits = 0;
+    while (bits < 63 && (std::uint64_t(2) << bits) - 1 <= range) ++bits;
+    return bits; // largest 'bits' with '2^bits - 1 <= range'
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                         Func                                          stringifier = Func()) {
-    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
+template <class Gen>
+[[nodiscard]] std::uint64_t _random_uint64(Gen& gen) {
+    constexpr int bits = _random_bits_per_call<Gen>();
+    static_assert(bits > 0, "Generator should produce at least 1 random bit per call.");
+
+    if constexpr (bits == 64) {
+        return static_cast<std::uint64_t>(gen() - Gen::min());
+    } else {
+        std::uint64_t res = 0;
+        for (int filled = 0; filled < 64; filled += bits) {
+            std::uint64_t x{};
+            do { x = static_cast<std::uint64_t>(gen() - Gen::min()); } while (x >> bits);
+            res = (res << bits) | x;
+        }
+        return res;
+    }
 }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
-                                 stringifier);
+template <class Gen>
+[[nodiscard]] std::uint64_t _random_index(Gen& gen, std::uint64_t bound) {
+    std::uint64_t x{}, r{};
+    do {
+        x = _random_uint64(gen);
+        r = x % bound;
+    } while (x - r > std::uint64_t(0) - bound); // 'x' fell into the last incomplete group of 'bound' values
+    return r;
 }
 
+// Fills all elements of a tensor with values of 'dist', sparse tensors refill values of their existing entries
+template <class Gen, class Tensor, class Dist, _is_tensor_enable_if<Tensor> = true>
+void fill_random(Tensor&& tensor, const Dist& dist, std::uint64_t seed) {
+    using value_type = typename std::decay_t<Tensor>::value_type;
 
-} // namespace format
+    const std::size_t size   = tensor.size();
+    const std::size_t blocks = (size + _random_block_size - 1) / _random_block_size;
 
-// ================================
-// --- Linear algebra operators ---
-// ================================
+    _parallel_for(blocks, _min_grain(_random_block_size * 8), [&](std::size_t low, std::size_t high) {
+        for (std::size_t b = low; b < high; ++b) {
+            Gen  gen        = _make_block_generator<Gen>(seed, b);
+            Dist block_dist = dist;
 
-// --- Unary operator implementation ----
-// --------------------------------------
+            const std::size_t end = std::min(size, (b + 1) * _random_block_size);
+            for (std::size_t idx = b * _random_block_size; idx < end; ++idx)
+                tensor[idx] = static_cast<value_type>(block_dist(gen));
+        }
+    });
+}
 
-template <class L, class Op,                                                    //
-          _is_tensor_enable_if<L> = true,                                       //
-          class return_type       = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_unary_op(L&& left, Op&& op) {
-    using reference = typename std::decay_t<L>::reference;
+// Random sparse matrix with given number of non-zeros in each row, 'row_nnz(i)' should be deterministic.
+// Columns of each row are chosen with Floyd's algorithm, which takes exactly 'nnz' random numbers & never produces
+// duplicates, triplets get emitted in sorted order directly into their final positions. Floyd's algorithm only needs
+// to know which columns were already picked for the current row: short rows scan their own output, longer rows use
+// a hash set, which keeps the whole thing O(nnz) regardless of the number of columns.
+template <class Gen, class Dist, class RowNnz>
+[[nodiscard]] auto _random_sparse(std::size_t rows, std::size_t cols, RowNnz row_nnz, const Dist& dist,
+                                  std::uint64_t seed) {
+    using value_type = std::decay_t<decltype(std::declval<Dist&>()(std::declval<Gen&>()))>;
+
+    std::vector<std::size_t> offsets(rows + 1, 0);
+    for (std::size_t i = 0; i < rows; ++i) offsets[i + 1] = offsets[i] + row_nnz(i);
+
+    std::vector<SparseEntry2D<value_type>> triplets(offsets.back());
+
+    const std::size_t blocks      = (rows + _random_sparse_block_rows - 1) / _random_sparse_block_rows;
+    const std::size_t row_nnz_avg = offsets.back() / std::max<std::size_t>(rows, 1);
+    const std::size_t grain       = _min_grain(_random_sparse_block_rows * (row_nnz_avg + 1));
+
+    _parallel_for(blocks, grain, [&](std::size_t low, std::size_t high) {
+        std::unordered_set<std::size_t> taken; // only used by long rows, reused between them
+
+        for (std::size_t b = low; b < high; ++b) {
+            Gen  gen        = _make_block_generator<Gen>(seed, b);
+            Dist block_dist = dist;
+
+            const std::size_t end = std::min(rows, (b + 1) * _random_sparse_block_rows);
+            for (std::size_t i = b * _random_sparse_block_rows; i < end; ++i) {
+                const auto first = triplets.begin() + offsets[i], last = triplets.begin() + offsets[i + 1];
+                const auto nnz   = static_cast<std::size_t>(last - first);
+
+                auto       out   = first;
+                const auto floyd = [&](auto&& is_taken, auto&& take) {
+                    for (std::size_t j = cols - nnz; j < cols; ++j) {
+                        const auto        t      = static_cast<std::size_t>(_random_index(gen, j + 1));
+                        const std::size_t chosen = is_taken(t) ? j : t; // 'j' can't be taken yet, picks are below
+                        take(chosen);
+                        out->i = i, out->j = chosen, ++out;
+                    }
+                };
+
+                if (nnz <= _random_sparse_linear_nnz) {
+                    const auto is_taken = [&](std::size_t t) {
+                        return std::any_of(first, out, [&](const auto& entry) { return entry.j == t; });
+                    };
+                    floyd(is_taken, [](std::size_t) {});
+                } else {
+                    taken.clear();
+                    taken.reserve(nnz);
+                    floyd([&](std::size_t t) { return taken.count(t) != 0; }, [&](std::size_t c) { taken.insert(c); });
+                }
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+                std::sort(first, last, [](const auto& l, const auto& r) { return l.j < r.j; });
+                for (auto it = first; it != last; ++it) it->value = block_dist(gen);
+            }
+        }
+    });
 
-    // '.for_each()' takes care of possible sparsity
-    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
+    return SparseMatrix<value_type>(rows, cols, std::move(triplets)); // already sorted, constructor will only verify
+}
 
-    return res;
+// Exactly 'round(density * rows * cols)' non-zeros spread over the rows as evenly as possible
+template <class Gen, class Dist>
+[[nodiscard]] auto random_sparse(std::size_t rows, std::size_t cols, double density, const Dist& dist,
+                                 std::uint64_t seed) {
+    if (!(0. <= density && density <= 1.))
+        throw std::invalid_argument(stringify("Sparse matrix density should be in [0, 1] range, got ", density, "."));
+
+    const auto total = static_cast<std::size_t>(density * double(rows) * double(cols) + 0.5);
+    // Every row gets 'total / rows' non-zeros and the first 'total % rows' rows get one more, unlike interpolating
+    // 'i * total / rows' this can't overflow
+    const std::size_t base = rows ? total / rows : 0, extra = rows ? total % rows : 0;
+
+    return _random_sparse<Gen>(rows, cols, [&](std::size_t i) { return base + (i < extra); }, dist, seed);
 }
 
-// --- Unary operator API ----
-// ---------------------------
+template <class Gen, class Dist>
+[[nodiscard]] auto random_sparse_per_row(std::size_t rows, std::size_t cols, std::size_t nnz_per_row,
+                                         const Dist& dist, std::uint64_t seed) {
+    if (nnz_per_row > cols)
+        throw std::invalid_argument(
+            stringify("Can't place ", nnz_per_row, " non-zeros into a row with ", cols, " columns."));
 
-// std <functional> has function objects for every operator possible,
-// except unary '+' for some reason, which is why we have to implement it ourselves.
-// This is the exact same thing as 'std::negate<>' but for operator '+'.
-template <class T>
-struct _unary_plus_functor {
-    constexpr T operator()(const T& lhs) const { return +lhs; }
-};
-
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left) {
-    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
-}
-
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left) {
-    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
+    return _random_sparse<Gen>(rows, cols, [&](std::size_t) { return nnz_per_row; }, dist, seed);
 }
 
-// --- Binary operator implementation ---
-// --------------------------------------
+// ==================
+// --- Lazy views ---
+// ==================
 
-// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
-// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
-// r-lvalues if possible to avoid allocation. Doing so would effectively change something like this:
-//    res = A + B - C - D + E
-// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
-// all others. This however introduces it's own set of challenges since instead of traditional overloading we
-// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
-//
-// So here are the key points of implementing all of this:
-//
-//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
-//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
-//       correspond to the return type.
-//
-//    2. Binary operators have following return types for different tensors:
-//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
-//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
-//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
-//       - (4) sparse + sparse => sparse      (complexity O(N)  )
-//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
-//       while argument can be anything, including views. To implement the list above efficiently there
-//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+// Sparse subviews ('.filter()', '.diagonal()', '.block()') materialize an array of reference triplets, which takes
+// a full pass over the matrix and an allocation per call, chaining them repeats it for every step. Lazy views
+// instead store a reference to the tensor, index bounds and a predicate, matching elements are found on the fly
+// when the view gets iterated. Chained filters get combined into a single predicate, so the whole chain still
+// costs a single pass with no allocation.
 //
-//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
-//       and specialized with operator functors froms std <functional>. All we need for individual
-//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
-//       will be performed by the 'apply_operator' method.
+// Bounds get pushed down into the traversal:
+//    - dense & strided tensors only iterate over rows & cols inside the bounds (or just the diagonal);
+//    - sparse tensors keep triplets sorted, so the first triplet of each row range can be found with a binary
+//      search, triplets outside of column bounds are skipped with another binary search to the next row;
+//    - CSR matrices jump directly to the rows inside the bounds (CSR views are always const).
 //
-// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
-// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
-// user, so we leave '*' as a matrix product and declate element-wise product as a function 'elementwise_product()'
-// since no existing operators seem suitable for such overload.
+// Lazy views are only valid while the underlying tensor is alive and its sparsity pattern doesn't change.
 
-// (1)  dense +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+struct _lazy_accept_all {
+    template <class T>
+    constexpr bool operator()(const T&, std::size_t, std::size_t) const noexcept {
+        return true;
+    }
+};
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+// 'func(elem, i, j)' gets called for all elements inside the bounds, indices are the indices of the tensor
+template <class Tensor, class Func, _is_tensor_enable_if<Tensor> = true>
+void _lazy_traverse(Tensor& tensor, const _lazy_bounds& bounds, Func&& func) {
+    using tensor_type = std::remove_const_t<Tensor>;
+    using size_type   = typename tensor_type::size_type;
+
+    const size_type row_high = std::min(bounds.row_high, tensor.rows());
+    const size_type col_high = std::min(bounds.col_high, tensor.cols());
+
+    if constexpr (tensor_type::params::type == Type::SPARSE) {
+        const auto& entries = tensor.entries();
+
+        // First triplet with '{ i, j } >= { row, col }' at or after 'from'
+        const auto find = [&](size_type from, size_type row, size_type col) -> size_type {
+            const auto it = std::lower_bound(entries.begin() + from, entries.end(), Index2D{row, col},
+                                             [](const auto& entry, const Index2D& index) {
+                                                 return entry.i < index.i || (entry.i == index.i && entry.j < index.j);
+                                             });
+            return static_cast<size_type>(it - entries.begin());
+        };
 
-    return_type res;
+        if (bounds.diagonal_only) {
+            const size_type low  = std::max(bounds.row_low, bounds.col_low);
+            const size_type high = std::min(row_high, col_high);
+            size_type       pos  = 0;
+            for (size_type k = low; k < high && pos < entries.size(); ++k) {
+                pos = find(pos, k, k);
+                if (pos < entries.size() && entries[pos].i == k && entries[pos].j == k) func(tensor[pos], k, k);
+            }
+            return;
+        }
 
-    // Reuse r-value arguments if possible while preserving the order of operations
-    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<L>(left);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
-    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<R>(right);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
+        size_type pos = find(0, bounds.row_low, bounds.col_low);
+        while (pos < entries.size() && entries[pos].i < row_high) {
+            const size_type i = entries[pos].i, j = entries[pos].j;
+            if (j < bounds.col_low) pos = find(pos, i, bounds.col_low);
+            else if (j >= col_high) pos = find(pos, i + 1, bounds.col_low);
+            else func(tensor[pos++], i, j);
+        }
     } else {
-        res = return_type(left.rows(), left.cols());
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+        if (bounds.diagonal_only) {
+            for (size_type k = std::max(bounds.row_low, bounds.col_low); k < std::min(row_high, col_high); ++k)
+                func(tensor(k, k), k, k);
+        } else if constexpr (tensor_type::params::layout == Layout::CR) {
+            for (size_type j = bounds.col_low; j < col_high; ++j)
+                for (size_type i = bounds.row_low; i < row_high; ++i) func(tensor(i, j), i, j);
+        } else {
+            for (size_type i = bounds.row_low; i < row_high; ++i)
+                for (size_type j = bounds.col_low; j < col_high; ++j) func(tensor(i, j), i, j);
+        }
     }
+}
 
-    return res;
+template <class T, class Func>
+void _lazy_traverse(const CSRMatrix<T>& matrix, const _lazy_bounds& bounds, Func&& func) {
+    // Columns of a row aren't required to be sorted, which is why they are scanned linearly
+    const auto& offsets = matrix.row_offsets();
+    const auto& cols    = matrix.col_indices();
+    const auto& values  = matrix.values();
+
+    const std::size_t row_high = std::min(bounds.row_high, matrix.rows());
+
+    for (std::size_t i = bounds.row_low; i < row_high; ++i) {
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            const std::size_t j      = cols[k];
+            const bool        inside = bounds.diagonal_only ? (j == i && bounds.col_low <= j && j < bounds.col_high)
+                                                            : (bounds.col_low <= j && j < bounds.col_high);
+            if (inside) func(values[k], i, j);
+        }
+    }
 }
 
-// (2)  dense + sparse =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+template <class Tensor, class Predicate>
+class LazyView {
+    using _tensor_type = std::remove_const_t<Tensor>;
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+public:
+    using value_type      = typename _tensor_type::value_type;
+    using size_type       = typename _tensor_type::size_type;
+    using const_reference = typename _tensor_type::const_reference;
+    using reference =
+        std::conditional_t<std::is_const_v<Tensor>, const_reference, typename _tensor_type::reference>;
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+private:
+    Tensor*      _tensor;
+    _lazy_bounds _bounds;
+    Predicate    _predicate; // takes view indices
 
-    // '.for_each()' to only iterate sparse elements
-    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
+public:
+    LazyView(Tensor& tensor, const _lazy_bounds& bounds, Predicate predicate)
+        : _tensor(&tensor), _bounds(bounds), _predicate(std::move(predicate)) {}
+
+    [[nodiscard]] size_type rows() const noexcept { return this->_bounds.row_high - this->_bounds.row_low; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_bounds.col_high - this->_bounds.col_low; }
+
+    // Calls 'func(elem)' or 'func(elem, i, j)' for every matching element, indices are relative to the view
+    template <class FuncType>
+    const LazyView& for_each(FuncType&& func) const {
+        const size_type row_low = this->_bounds.row_low, col_low = this->_bounds.col_low;
+
+        _lazy_traverse(*this->_tensor, this->_bounds, [&](reference elem, size_type i, size_type j) {
+            const size_type view_i = i - row_low, view_j = j - col_low;
+            if (!this->_predicate(static_cast<const_reference>(elem), view_i, view_j)) return;
+            if constexpr (std::is_invocable_v<FuncType&, reference, size_type, size_type>) func(elem, view_i, view_j);
+            else func(elem);
+        });
 
-    return res;
-}
+        return *this;
+    }
 
-// (3) sparse +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<R>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+    // Returns a view with combined predicate, predicate can take '(elem)' or '(elem, i, j)'
+    template <class UnaryPredicate>
+    [[nodiscard]] auto filter(UnaryPredicate predicate) const {
+        auto combined = [first = this->_predicate, second = std::move(predicate)](const_reference elem, size_type i,
+                                                                                  size_type j) -> bool {
+            if (!first(elem, i, j)) return false;
+            if constexpr (std::is_invocable_v<const UnaryPredicate&, const_reference, size_type, size_type>)
+                return second(elem, i, j);
+            else return second(elem);
+        };
+        return LazyView<Tensor, decltype(combined)>(*this->_tensor, this->_bounds, std::move(combined));
+    }
 
-    using reference = typename std::decay_t<R>::reference;
-    using size_type = typename std::decay_t<R>::size_type;
+    [[nodiscard]] size_type count() const {
+        size_type count = 0;
+        this->for_each([&](const_reference) { ++count; });
+        return count;
+    }
 
-    // Reuse r-value if possible
-    return_type res = std::forward<R>(right);
+    [[nodiscard]] value_type sum() const {
+        value_type sum = value_type();
+        this->for_each([&](const_reference elem) { sum += elem; });
+        return sum;
+    }
 
-    // '.for_each()' to only iterate sparse elements
-    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
+    template <class T = Tensor, std::enable_if_t<!std::is_const_v<T>, bool> = true>
+    const LazyView& fill(const value_type& value) const {
+        return this->for_each([&](reference elem) { elem = value; });
+    }
 
-    return res;
+    // Copies matching elements into a sparse matrix
+    [[nodiscard]] SparseMatrix<value_type> to_sparse() const {
+        std::vector<SparseEntry2D<value_type>> triplets;
+        this->for_each([&](const_reference elem, size_type i, size_type j) { triplets.push_back({i, j, elem}); });
+        return SparseMatrix<value_type>(this->rows(), this->cols(), std::move(triplets));
+    }
+};
+
+template <class Tensor>
+[[nodiscard]] LazyView<Tensor, _lazy_accept_all> _make_lazy_view(Tensor& tensor, const _lazy_bounds& bounds) {
+    return LazyView<Tensor, _lazy_accept_all>(tensor, bounds, _lazy_accept_all{});
 }
 
-// (4) sparse + sparse => sparse
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+template <class Tensor>
+[[nodiscard]] _lazy_bounds _lazy_full_bounds(const Tensor& tensor, bool diagonal_only = false) noexcept {
+    return {0, tensor.rows(), 0, tensor.cols(), diagonal_only};
+}
 
-    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
-    using value_type   = typename std::decay_t<L>::value_type;
+// Blocks are validated upfront so the view never reports more rows / cols than its traversal visits
+template <class Tensor>
+[[nodiscard]] _lazy_bounds _lazy_block_bounds(const Tensor& tensor, std::size_t block_i, std::size_t block_j,
+                                              std::size_t block_rows, std::size_t block_cols) {
+    if (block_i > tensor.rows() || block_rows > tensor.rows() - block_i)
+        throw std::out_of_range(stringify("Block rows [", block_i, ", ", block_i + block_rows,
+                                          ") exceed this->rows() (which is ", tensor.rows(), ")"));
+    if (block_j > tensor.cols() || block_cols > tensor.cols() - block_j)
+        throw std::out_of_range(stringify("Block cols [", block_j, ", ", block_j + block_cols,
+                                          ") exceed this->cols() (which is ", tensor.cols(), ")"));
+    return {block_i, block_i + block_rows, block_j, block_j + block_cols, false};
+}
 
-    std::vector<sparse_entry> res_triplets;
-    res_triplets.reserve(std::max(left.size(), right.size()));
-    // not enough when matrices have different sparsity patterns, but good enough for initial guess
+// ==============================
+// --- N-dimensional tensors ---
+// ==============================
 
-    std::size_t i = 0, j = 0;
+// Dense tensors of arbitrary rank, described by an array of extents & an array of strides (in elements):
+//
+//    element(i_0, i_1, ..., i_{N-1}) = data[i_0 * strides[0] + i_1 * strides[1] + ... + i_{N-1} * strides[N-1]]
+//
+// Containers always use compact row-major strides (last axis is contiguous), views can have arbitrary strides,
+// which is what allows slicing, sub-ranges & axis permutations to be just a matter of adjusting extents, strides
+// and the data pointer without any copies. Ownership & bounds checking follow the same 'Ownership' / 'Checking'
+// semantics as 2D tensors.
+//
+// Rank-2 tensors can be viewed as strided matrices with '.matrix_view()', this gives them access to the whole
+// 2D API including formatters.
 
-    // Merge sparsity patterns
-    while (i < left.size() && j < right.size()) {
-        // Entry present only in lhs sparsity pattern
-        if (left._data[i] < right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
-        }
-        // Entry present only in rhs sparsity pattern
-        else if (left._data[i] > right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
-        }
-        // Entry present in both sparsity patterns
-        else {
-            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
-                                                                         std::forward<R>(right)._data[j++], op));
+template <class T, std::size_t rank_, Ownership ownership_ = Ownership::CONTAINER,
+          Checking checking_ = _default_checking>
+class NDTensor {
+    static_assert(rank_ > 0, "Tensor rank should be positive.");
+
+public:
+    using self            = NDTensor;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using index_type      = std::array<size_type, rank_>;
+
+    constexpr static size_type rank      = rank_;
+    constexpr static Ownership ownership = ownership_;
+    constexpr static Checking  checking  = checking_;
+
+    using data_pointer = std::conditional_t<ownership == Ownership::CONST_VIEW, const_pointer, pointer>;
+    using view_type    = NDTensor<value_type, rank, Ownership::VIEW, checking>;
+    using cview_type   = NDTensor<value_type, rank, Ownership::CONST_VIEW, checking>;
+
+private:
+    index_type                _extents{};
+    index_type                _strides{};
+    _unique_array<value_type> _storage; // only used by containers
+    data_pointer              _data = nullptr;
+
+    template <class, std::size_t, Ownership, Checking>
+    friend class NDTensor;
+
+    [[nodiscard]] static index_type _compact_strides(const index_type& extents) noexcept {
+        index_type strides{};
+        size_type  stride = 1;
+        for (size_type axis = rank; axis-- > 0;) {
+            strides[axis] = stride;
+            stride *= extents[axis];
         }
+        return strides;
     }
-    // Copy the rest of lhs (if needed)
-    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
-    // Copy the rest of rhs (if needed)
-    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
 
-    return return_type(left.rows(), left.cols(), std::move(res_triplets));
-}
+    static void _check_axis(size_type axis) {
+        if (axis >= rank)
+            throw std::out_of_range(stringify("axis (which is ", axis, ") >= rank (which is ", rank, ")"));
+    }
 
-// --- Binary operator API ---
-// ---------------------------
+    void _bound_check(const index_type& idx) const {
+        for (size_type axis = 0; axis < rank; ++axis)
+            if (idx[axis] >= this->_extents[axis])
+                throw std::out_of_range(stringify("index (which is ", idx[axis], ") along the axis ", axis,
+                                                  " >= extent (which is ", this->_extents[axis], ")"));
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
-}
+    [[nodiscard]] size_type _offset(const index_type& idx) const noexcept {
+        size_type offset = 0;
+        for (size_type axis = 0; axis < rank; ++axis) offset += idx[axis] * this->_strides[axis];
+        return offset;
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
-}
+    // Calls 'func(elem, idx)' for all elements in row-major index order. Outer axes are advanced like an odometer,
+    // the innermost axis is a plain pointer loop, which is contiguous for containers and most of the views.
+    template <class Self, class Func>
+    static void _for_each_impl(Self& tensor, Func&& func) {
+        if (tensor.empty()) return;
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                                = typename std::decay_t<L>::value_type,
-          _has_binary_op_multiplies_enable_if<value_type> = true>
-auto elementwise_product(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
-}
+        const size_type inner_extent = tensor._extents[rank - 1];
+        const size_type inner_stride = tensor._strides[rank - 1];
 
-// --- Augmented assignment operator API ---
-// -----------------------------------------
+        index_type idx{};
+        for (;;) {
+            const auto line = tensor._data + tensor._offset(idx);
+            if (inner_stride == 1) {
+                for (size_type n = 0; n < inner_extent; ++n) {
+                    idx[rank - 1] = n;
+                    func(line[n], idx);
+                }
+            } else {
+                for (size_type n = 0; n < inner_extent; ++n) {
+                    idx[rank - 1] = n;
+                    func(line[n * inner_stride], idx);
+                }
+            }
+            idx[rank - 1] = 0;
 
-// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
+            for (size_type axis = rank - 1;;) {
+                if (axis == 0) return;
+                --axis;
+                if (++idx[axis] < tensor._extents[axis]) break;
+                idx[axis] = 0;
+            }
+        }
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
-L& operator+=(L&& left, R&& right) {
-    return (left = std::move(left) + right);
-}
+public:
+    // - Constructors -
+    NDTensor() noexcept = default;
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                               = typename std::decay_t<L>::value_type,
-          _has_assignment_op_minus_enable_if<value_type> = true>
-L& operator-=(L&& left, R&& right) {
-    return (left = std::move(left) - right);
-}
+    // Containers
+    template <Ownership o = ownership, std::enable_if_t<o == Ownership::CONTAINER, bool> = true>
+    explicit NDTensor(const index_type& extents, const_reference value = value_type())
+        : _extents(extents), _strides(_compact_strides(extents)) {
+        this->_storage = _make_unique_ptr_array<value_type>(this->size());
+        this->_data    = this->_storage.get();
+        std::fill_n(this->_data, this->size(), value);
+    }
 
-// --- Matrix multiplication ---
-// -----------------------------
+    // Views
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONTAINER, bool> = true>
+    explicit NDTensor(const index_type& extents, const index_type& strides, data_pointer data)
+        : _extents(extents), _strides(strides), _data(data) {}
 
-// Just like with binary operators, we run into the need to have 4 different implementations:
-//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
-//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
-//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
-//    - (4) sparse + sparse => sparse      (complexity O(N)  )
-//
-// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
-// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
-// an afterthought provided here mainly for convenience and not for actual number crunching usage.
-//
-// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
-// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
-
-// (1)  dense +  dense =>  dense
-//
-// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
-// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
-// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
-// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
-// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
-// blocking seems to be worth it.
-//
-// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
-//
-template <class L, class R,                                                                                //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
-          class value_type                                  = typename std::decay_t<L>::value_type,        //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
-          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
-          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
-          >
-return_type operator*(const L& left, const R& right) {
-    utl_mvl_assert(left.cols() == right.rows());
+    // Containers copy elements into a compact storage, views are shallow
+    NDTensor(const self& other) { *this = other; }
 
-    using size_type = typename std::decay_t<L>::size_type;
-
-    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
-    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
+    self& operator=(const self& other) {
+        if (this == &other) return *this;
+        if constexpr (ownership == Ownership::CONTAINER) {
+            this->_extents = other._extents;
+            this->_strides = _compact_strides(other._extents);
+            this->_storage = _make_unique_ptr_array<value_type>(other.size());
+            this->_data    = this->_storage.get();
+            std::copy(other._data, other._data + other.size(), this->_data);
+        } else {
+            this->_extents = other._extents;
+            this->_strides = other._strides;
+            this->_data    = other._data;
+        }
+        return *this;
+    }
 
-    constexpr size_type block_size_kk = 32;
+    // Moved-from tensor is left empty, otherwise a moved-from container would still report its old size
+    // and point into the storage that now belongs to a different tensor
+    NDTensor(self&& other) noexcept { *this = std::move(other); }
 
-    return_type res(N_i, N_j, value_type{});
+    self& operator=(self&& other) noexcept {
+        if (this == &other) return *this;
+        this->_extents = std::exchange(other._extents, index_type{});
+        this->_strides = std::exchange(other._strides, index_type{});
+        this->_storage = std::move(other._storage);
+        this->_data    = std::exchange(other._data, nullptr);
+        return *this;
+    }
 
-    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
-        const size_type k_extent = std::min(N_k, kk + block_size_kk);
-        // needed for matrices that aren't a multiple of block size
-        for (size_type i = 0; i < N_i; ++i) {
-            for (size_type k = kk; k < k_extent; ++k) {
-                const auto& r = left(i, k);
-                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
-            }
-        }
+    // Container from any tensor of the same rank (views get compacted)
+    template <Ownership other_ownership, Checking other_checking, Ownership o = ownership,
+              std::enable_if_t<o == Ownership::CONTAINER, bool> = true>
+    NDTensor(const NDTensor<value_type, rank, other_ownership, other_checking>& other)
+        : NDTensor(other.extents()) {
+        size_type i = 0;
+        other.for_each([&](const_reference elem) { this->_data[i++] = elem; });
     }
 
-    return res;
-}
+    // Const view from a mutable view
+    template <Checking other_checking, Ownership o = ownership,
+              std::enable_if_t<o == Ownership::CONST_VIEW, bool> = true>
+    NDTensor(const NDTensor<value_type, rank, Ownership::VIEW, other_checking>& other)
+        : NDTensor(other.extents(), other.strides(), other.data()) {}
 
-// (2)  dense + sparse =>  dense
+    // - Size & layout -
+    [[nodiscard]] const index_type& extents() const noexcept { return this->_extents; }
+    [[nodiscard]] const index_type& strides() const noexcept { return this->_strides; }
 
-// TODO:
+    [[nodiscard]] size_type extent(size_type axis) const {
+        _check_axis(axis);
+        return this->_extents[axis];
+    }
 
-// (3) sparse +  dense =>  dense
+    [[nodiscard]] size_type stride(size_type axis) const {
+        _check_axis(axis);
+        return this->_strides[axis];
+    }
 
-// TODO:
+    [[nodiscard]] size_type size() const noexcept {
+        size_type size = 1;
+        for (const auto& extent : this->_extents) size *= extent;
+        return size;
+    }
 
-// (4) sparse + sparse => sparse
+    [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
 
-// TODO:
+    [[nodiscard]] bool is_contiguous() const noexcept { return this->_strides == _compact_strides(this->_extents); }
 
-// Clear out internal macros
-#undef utl_mvl_tensor_arg_defs
-#undef utl_mvl_tensor_arg_vals
-#undef utl_mvl_require
-#undef utl_mvl_reqs
+    [[nodiscard]] data_pointer  data() noexcept { return this->_data; }
+    [[nodiscard]] const_pointer data() const noexcept { return this->_data; }
 
-} // namespace utl::mvl
+    // - Element access -
+    template <class... Idx, std::enable_if_t<sizeof...(Idx) == rank, bool> = true>
+    [[nodiscard]] decltype(auto) operator()(Idx... idx) {
+        return this->operator[](index_type{static_cast<size_type>(idx)...});
+    }
 
-#endif
-#endif // module utl::mvl
+    template <class... Idx, std::enable_if_t<sizeof...(Idx) == rank, bool> = true>
+    [[nodiscard]] const_reference operator()(Idx... idx) const {
+        return this->operator[](index_type{static_cast<size_type>(idx)...});
+    }
 
+    [[nodiscard]] std::conditional_t<ownership == Ownership::CONST_VIEW, const_reference, reference>
+    operator[](const index_type& idx) {
+        if constexpr (checking == Checking::BOUNDS) this->_bound_check(idx);
+        return this->_data[this->_offset(idx)];
+    }
 
+    [[nodiscard]] const_reference operator[](const index_type& idx) const {
+        if constexpr (checking == Checking::BOUNDS) this->_bound_check(idx);
+        return this->_data[this->_offset(idx)];
+    }
 
+    // - Views -
+    [[nodiscard]] cview_type cview() const { return cview_type(this->_extents, this->_strides, this->_data); }
+    [[nodiscard]] cview_type view() const { return this->cview(); }
 
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] view_type view() {
+        return view_type(this->_extents, this->_strides, this->_data);
+    }
 
+    // Fixes 'axis' at 'idx', which reduces the rank by one
+    template <std::size_t r = rank, std::enable_if_t<(r > 1), bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::CONST_VIEW, checking> slice(size_type axis,
+                                                                                        size_type idx) const {
+        return this->_slice<Ownership::CONST_VIEW>(axis, idx);
+    }
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::parallel
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_parallel.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    template <std::size_t r = rank, Ownership o = ownership,
+              std::enable_if_t<(r > 1) && o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::VIEW, checking> slice(size_type axis, size_type idx) {
+        return this->_slice<Ownership::VIEW>(axis, idx);
+    }
 
-#include <iterator>
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PARALLEL)
-#ifndef UTLHEADERGUARD_PARALLEL
-#define UTLHEADERGUARD_PARALLEL
+    // Restricts 'axis' to indices '[first, first + count)', rank stays the same
+    [[nodiscard]] cview_type subrange(size_type axis, size_type first, size_type count) const {
+        return this->_subrange<Ownership::CONST_VIEW>(axis, first, count);
+    }
 
-// _______________________ INCLUDES _______________________
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] view_type subrange(size_type axis, size_type first, size_type count) {
+        return this->_subrange<Ownership::VIEW>(axis, first, count);
+    }
 
-#include <condition_variable> // condition_variable
-#include <cstddef>            // size_t
-#include <functional>         // bind()
-#include <future>             // future<>, packaged_task<>
-#include <mutex>              // mutex, recursive_mutex, lock_guard<>, unique_lock<>
-#include <queue>              // queue<>
-#include <thread>             // thread
-#include <type_traits>        // decay_t<>, invoke_result_t<>
-#include <utility>            // forward<>()
-#include <vector>             // vector
+    // Axis 'k' of the result is the axis 'axes[k]' of the original tensor
+    [[nodiscard]] cview_type permute(const index_type& axes) const {
+        return this->_permute<Ownership::CONST_VIEW>(axes);
+    }
 
-// ____________________ DEVELOPER DOCS ____________________
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] view_type permute(const index_type& axes) {
+        return this->_permute<Ownership::VIEW>(axes);
+    }
 
-// In C++20 'std::jthread' can be used to simplify code a bit, no reason not to do so.
-//
-// In C++20 '_unroll<>()' template can be improved to take index as a template-lambda-explicit-argument
-// rather than a regular arg, ensuring its constexpr'ness. This may lead to a slight performance boost
-// as truly manual unrolling seems to be slightly faster than automatic one.
+    // Rank-2 tensors can be viewed as 2D strided matrices, throws if strides can't be expressed in a given layout
+    template <Layout layout = Layout::RC, std::size_t r = rank, std::enable_if_t<r == 2, bool> = true>
+    [[nodiscard]] ConstStridedMatrixView<value_type, checking, layout> matrix_view() const {
+        const auto [row_stride, col_stride] = this->_matrix_strides<layout>();
+        return ConstStridedMatrixView<value_type, checking, layout>(this->_extents[0], this->_extents[1], row_stride,
+                                                                    col_stride, this->_data);
+    }
 
-// ____________________ IMPLEMENTATION ____________________
+    template <Layout layout = Layout::RC, std::size_t r = rank, Ownership o = ownership,
+              std::enable_if_t<r == 2 && o != Ownership::CONST_VIEW, bool> = true>
+    [[nodiscard]] StridedMatrixView<value_type, checking, layout> matrix_view() {
+        const auto [row_stride, col_stride] = this->_matrix_strides<layout>();
+        return StridedMatrixView<value_type, checking, layout>(this->_extents[0], this->_extents[1], row_stride,
+                                                               col_stride, this->_data);
+    }
 
-namespace utl::parallel {
+    template <std::size_t r = rank, std::enable_if_t<r == 2, bool> = true>
+    [[nodiscard]] Matrix<value_type> to_matrix() const {
+        return Matrix<value_type>(this->_extents[0], this->_extents[1],
+                                  [&](size_type i, size_type j) { return this->operator()(i, j); });
+    }
 
-// =============
-// --- Utils ---
-// =============
+    // - Algorithms -
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
+    const self& for_each(FuncType func) const {
+        _for_each_impl(*this, [&](const_reference elem, const index_type&) { func(elem); });
+        return *this;
+    }
 
-template <class T, class Mutex = std::mutex>
-class MutexProtected {
-    T             value;
-    mutable Mutex mutex;
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, const index_type&)> = true>
+    const self& for_each(FuncType func) const {
+        _for_each_impl(*this, func);
+        return *this;
+    }
 
-public:
-    MutexProtected() = default;
-    MutexProtected(const T& value) : value(value), mutex() {}
-    MutexProtected(T&& value) : value(std::move(value)), mutex() {}
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true, Ownership o = ownership,
+              std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& for_each(FuncType func) {
+        _for_each_impl(*this, [&](reference elem, const index_type&) { func(elem); });
+        return *this;
+    }
 
-    template <class Func>
-    decltype(auto) apply(Func&& func) const {
-        const std::lock_guard lock(this->mutex);
-        return std::forward<Func>(func)(this->value);
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, const index_type&)> = true,
+              Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& for_each(FuncType func) {
+        _for_each_impl(*this, func);
+        return *this;
     }
 
-    template <class Func>
-    decltype(auto) apply(Func&& func) {
-        const std::lock_guard lock(this->mutex);
-        return std::forward<Func>(func)(this->value);
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
+              Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& transform(FuncType func) {
+        return this->for_each([&](reference elem) { elem = func(elem); });
     }
 
-    [[nodiscard]] T&& release() { return std::move(this->value); }
-};
+    template <Ownership o = ownership, std::enable_if_t<o != Ownership::CONST_VIEW, bool> = true>
+    self& fill(const_reference value) {
+        return this->for_each([&](reference elem) { elem = value; });
+    }
 
-[[nodiscard]] inline std::size_t max_thread_count() noexcept {
-    const std::size_t detected_threads = std::thread::hardware_concurrency();
-    return detected_threads ? detected_threads : 1;
-    // 'hardware_concurrency()' returns '0' if it can't determine the number of threads,
-    // in this case we reasonably assume there is a single thread available
-}
+    // Reduces 'axis' with a binary 'op', result has rank one less than the original tensor
+    template <class Op, std::size_t r = rank, std::enable_if_t<(r > 1), bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::CONTAINER, checking> reduce(size_type axis,
+                                                                                        const_reference init,
+                                                                                        Op&& op) const {
+        _check_axis(axis);
 
-// No reason to include the entirety of <algorithm> just for 2 one-liner functions,
-// so we implement 'std::size_t' min/max here
-[[nodiscard]] constexpr std::size_t _min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
-[[nodiscard]] constexpr std::size_t _max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
+        NDTensor<value_type, rank - 1, Ownership::CONTAINER, checking> res(_remove_axis(this->_extents, axis), init);
 
-// Template for automatic loop unrolling.
-//
-// It is used in 'parallel::reduce()' to (optionally) speed up a tight loop while leaving the user
-// with ability to easily control that unrolling. By default NO unrolling is used.
-//
-// Benchmarks indicate speedups ~130% to ~400% depending on CPU, compiler and options
-// large unrolling (32) seems to be the best on benchmarks, however it may bloat the binary
-// and take over too many branch predictor slots in case of min/max reductions, 4-8 seems
-// like a reasonable sweetspot for most machines.
-//
-// One may think that it is a job of compiler to perform such optimizations, yet even with
-// GCC '-Ofast -funroll-all-loop' and GCC unroll pragmas it fails to do them reliably.
-//
-// The reason it fails to do so is pretty clear for '-O2' and below - strictly speaking, most binary
-// operations on floats are non-commutative (sum depends on the order of addition, for example), however
-// since reduction is inherently not-order-preserving there is no harm in reordering operations some more
-// and unrolling the loop so compiler will be able to use SIMD if it sees it as possile (which it often does).
-//
-// Why vectorization of simple loops still tends to fail with '-Ofast' which reduces conformance and
-// allows reordering of math operations is unclear, but this is how it happens when actually measured.
-//
-template <class T, T... indeces, class F>
-constexpr void _unroll_impl(std::integer_sequence<T, indeces...>, F&& f) {
-    (f(std::integral_constant<T, indeces>{}), ...);
-}
-template <class T, T count, class F>
-constexpr void _unroll(F&& f) {
-    _unroll_impl(std::make_integer_sequence<T, count>{}, std::forward<F>(f));
-}
+        this->for_each([&](const_reference elem, const index_type& idx) {
+            auto& target = res._data[res._offset(_remove_axis(idx, axis))];
+            target       = op(std::move(target), elem);
+        });
 
-// ===================
-// --- Thread pool ---
-// ===================
+        return res;
+    }
 
-// A simple single-queue task threadpool, uploads of arbitrary callables as tasks,
-// returns optional futures, supports pausing. Work stealing would probably be better
-// in a general case, however it complicates the implementation quite noticeably and
-// doesn't provide much measurable benefit under the API of this module.
+    template <std::size_t r = rank, std::enable_if_t<(r > 1), bool> = true>
+    [[nodiscard]] NDTensor<value_type, rank - 1, Ownership::CONTAINER, checking> sum(size_type axis) const {
+        return this->reduce(axis, value_type(), std::plus<value_type>());
+    }
 
-// Note:
-// We don't use 'MutexProtected' here to make implementation a bit more decoupled, plus such idiom isn't nearly as
-// convenient once we enter the realm of non-trivial syncronization with recursive mutexes and condition variables.
+    [[nodiscard]] value_type sum() const {
+        value_type res = value_type();
+        this->for_each([&](const_reference elem) { res = std::move(res) + elem; });
+        return res;
+    }
 
-class ThreadPool {
 private:
-    std::vector<std::thread>     threads;
-    mutable std::recursive_mutex thread_mutex;
-
-    std::queue<std::packaged_task<void()>> tasks{};
-    mutable std::mutex                     task_mutex;
+    template <std::size_t N>
+    [[nodiscard]] static std::array<size_type, N - 1> _remove_axis(const std::array<size_type, N>& arr,
+                                                                   size_type axis) noexcept {
+        std::array<size_type, N - 1> res{};
+        for (size_type k = 0, out = 0; k < N; ++k)
+            if (k != axis) res[out++] = arr[k];
+        return res;
+    }
 
-    std::condition_variable task_cv;          // used to notify changes to the task queue
-    std::condition_variable task_finished_cv; // used to notify of finished tasks
+    template <Ownership result_ownership>
+    [[nodiscard]] NDTensor<value_type, rank - 1, result_ownership, checking> _slice(size_type axis,
+                                                                                    size_type idx) const {
+        _check_axis(axis);
+        if (idx >= this->_extents[axis])
+            throw std::out_of_range(stringify("slice index (which is ", idx, ") >= extent (which is ",
+                                              this->_extents[axis], ") along the axis ", axis));
 
-    // Signals
-    bool stopping = false; // signal for workers to shut down '.worker_main()'
-    bool paused   = false; // signal for workers to not pull new tasks from the queue
-    bool waiting  = false; // signal for workers that they should notify 'task_finished_cv' when
-                           // finishing a task, which is used to implement 'wait for tasks' methods
+        using result_type = NDTensor<value_type, rank - 1, result_ownership, checking>;
+        return result_type(_remove_axis(this->_extents, axis), _remove_axis(this->_strides, axis),
+                           this->_data + idx * this->_strides[axis]);
+    }
 
-    int tasks_running = 0; // number of tasks currently executed by workers
+    template <Ownership result_ownership>
+    [[nodiscard]] NDTensor<value_type, rank, result_ownership, checking> _subrange(size_type axis, size_type first,
+                                                                                   size_type count) const {
+        _check_axis(axis);
+        // 'first + count' could wrap around, compare against the remaining extent instead
+        if (first > this->_extents[axis] || count > this->_extents[axis] - first)
+            throw std::out_of_range(stringify("subrange of ", count, " elements starting at ", first,
+                                              " exceeds extent (which is ", this->_extents[axis], ") along the axis ",
+                                              axis));
 
-    // Main function for worker threads,
-    // here workers wait for the queue, pull new tasks from it and run them
-    void thread_main() {
-        bool task_was_finished = false;
+        index_type extents = this->_extents;
+        extents[axis]      = count;
 
-        while (true) {
-            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+        using result_type = NDTensor<value_type, rank, result_ownership, checking>;
+        return result_type(extents, this->_strides, this->_data + first * this->_strides[axis]);
+    }
 
-            if (task_was_finished) {
-                --this->tasks_running;
-                if (this->waiting) this->task_finished_cv.notify_all();
-                // no need to set 'task_was_finished' back to 'false',
-                // the only way we get back into this condition is if another task was finished
-            }
+    template <Ownership result_ownership>
+    [[nodiscard]] NDTensor<value_type, rank, result_ownership, checking> _permute(const index_type& axes) const {
+        std::array<bool, rank> used{};
+        for (const auto& axis : axes) {
+            _check_axis(axis);
+            if (used[axis]) throw std::invalid_argument(stringify("axis ", axis, " appears twice in a permutation"));
+            used[axis] = true;
+        }
 
-            // Pool isn't destructing, isn't paused and there are tasks available in the queue
-            //    => continue execution, a new task from the queue and start executing it
-            // otherwise
-            //    => unlock the mutex and wait until a new task is submitted,
-            //       pool is unpaused or destruction is initiated
-            this->task_cv.wait(task_lock, [&] { return this->stopping || (!this->paused && !this->tasks.empty()); });
+        index_type extents{}, strides{};
+        for (size_type k = 0; k < rank; ++k) {
+            extents[k] = this->_extents[axes[k]];
+            strides[k] = this->_strides[axes[k]];
+        }
 
-            if (this->stopping) break; // escape hatch for thread destruction
+        using result_type = NDTensor<value_type, rank, result_ownership, checking>;
+        return result_type(extents, strides, this->_data);
+    }
 
-            // Pull a new task from the queue and start executing it
-            std::packaged_task<void()> task_to_execute = std::move(this->tasks.front());
-            this->tasks.pop();
-            ++this->tasks_running;
-            task_lock.unlock();
+    // Converts element strides into the padding-based strides of 2D strided matrices, see notes on
+    // offsets in '_unchecked_get_ij_of_idx()'
+    template <Layout layout>
+    [[nodiscard]] std::pair<size_type, size_type> _matrix_strides() const {
+        const size_type rows = this->_extents[0], cols = this->_extents[1];
+        const size_type s0 = this->_strides[0], s1 = this->_strides[1];
 
-            task_to_execute(); // NOTE: Should I catch exceptions here?
-            task_was_finished = true;
+        if constexpr (layout == Layout::RC) {
+            if (s0 >= cols * s1) return {s0 - cols * s1, s1};
+        } else {
+            if (s1 >= rows * s0) return {s0, s1 - rows * s0};
         }
+        throw std::invalid_argument(stringify("tensor with strides { ", s0, ", ", s1, " } can't be viewed as a ",
+                                              layout == Layout::RC ? "RC" : "CR", " strided matrix"));
     }
+};
 
-    void start_threads(std::size_t worker_count_increase) {
-        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
-        // the mutex has to be recursive because we call '.start_threads()' inside '.set_num_threads()'
-        // which also locks 'worker_mutex', if mutex wan't recursive we would deadlock trying to lock
-        // it a 2nd time on the same thread.
-
-        // NOTE: It feels like '.start_threads()' can be split into '.start_threads()' and
-        // '._start_threads_assuming_locked()' which would remove the need for recursive mutex
+// - Typedefs -
+template <class T, std::size_t rank, Checking checking = _default_checking>
+using NDTensorView = NDTensor<T, rank, Ownership::VIEW, checking>;
+
+template <class T, std::size_t rank, Checking checking = _default_checking>
+using ConstNDTensorView = NDTensor<T, rank, Ownership::CONST_VIEW, checking>;
+
+// Contracts 'axis_a' of 'A' with 'axis_b' of 'B', result axes are the remaining axes of 'A' followed by the remaining
+// axes of 'B'. Both operands get permuted so that the contracted axis is last / first and compacted, after which
+// contraction is a regular '(I x K) * (K x J)' matrix product with contiguous inner loops, split between threads.
+template <class T, std::size_t rank_a, Ownership ownership_a, Checking checking_a, std::size_t rank_b,
+          Ownership ownership_b, Checking checking_b>
+[[nodiscard]] NDTensor<T, rank_a + rank_b - 2>
+contract(const NDTensor<T, rank_a, ownership_a, checking_a>& A, std::size_t axis_a,
+         const NDTensor<T, rank_b, ownership_b, checking_b>& B, std::size_t axis_b) {
+    static_assert(rank_a + rank_b > 2, "Contraction of two rank-1 tensors is a scalar, use a regular dot product.");
+
+    if (axis_a >= rank_a || axis_b >= rank_b)
+        throw std::out_of_range(stringify("can't contract axes ", axis_a, " & ", axis_b, " of rank-", rank_a,
+                                          " and rank-", rank_b, " tensors"));
+    if (A.extents()[axis_a] != B.extents()[axis_b])
+        throw std::invalid_argument(stringify("can't contract axes with different extents ", A.extents()[axis_a],
+                                              " & ", B.extents()[axis_b]));
+
+    std::array<std::size_t, rank_a> permutation_a{};
+    std::array<std::size_t, rank_b> permutation_b{};
+    for (std::size_t k = 0, out = 0; k < rank_a; ++k)
+        if (k != axis_a) permutation_a[out++] = k;
+    permutation_a[rank_a - 1] = axis_a;
+    permutation_b[0]          = axis_b;
+    for (std::size_t k = 0, out = 1; k < rank_b; ++k)
+        if (k != axis_b) permutation_b[out++] = k;
+
+    const NDTensor<T, rank_a> A_compact(A.permute(permutation_a));
+    const NDTensor<T, rank_b> B_compact(B.permute(permutation_b));
+
+    const std::size_t N_k = A.extents()[axis_a];
+    const std::size_t N_i = N_k ? A.size() / N_k : 0;
+    const std::size_t N_j = N_k ? B.size() / N_k : 0;
+
+    std::array<std::size_t, rank_a + rank_b - 2> extents{};
+    for (std::size_t k = 0; k < rank_a - 1; ++k) extents[k] = A_compact.extents()[k];
+    for (std::size_t k = 1; k < rank_b; ++k) extents[rank_a - 2 + k] = B_compact.extents()[k];
+
+    NDTensor<T, rank_a + rank_b - 2> res(extents);
+
+    const T* a = A_compact.data();
+    const T* b = B_compact.data();
+    T*       c = res.data();
+
+    _parallel_for(N_i, _min_grain(2 * N_k * N_j), [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i)
+            for (std::size_t k = 0; k < N_k; ++k) {
+                const T& a_ik = a[i * N_k + k];
+                for (std::size_t j = 0; j < N_j; ++j) c[i * N_j + j] += a_ik * b[k * N_j + j];
+            }
+    });
 
-        for (std::size_t i = 0; i < worker_count_increase; ++i)
-            this->threads.emplace_back(&ThreadPool::thread_main, this);
-    }
+    return res;
+}
 
-    void stop_all_threads() {
-        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+// ==================
+// --- Formatters ---
+// ==================
 
-        {
-            const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-            this->stopping = true;
-            this->task_cv.notify_all();
-        } // signals to all threads that they should stop running
+namespace format {
 
-        for (auto& worker : this->threads)
-            if (worker.joinable()) worker.join();
-        // 'joinable()' checks in needed so we don't try to join the master thread
+// --- Implementation ---
+// ----------------------
 
-        this->threads.clear();
-    }
+// The "header" of all human-readable formats that displays
+// some meta info with tensor type and dimensions.
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    std::string buffer;
 
-public:
-    // --- Construction ---
-    // --------------------
+    if constexpr (_type == Type::DENSE) buffer += "Dense";
+    if constexpr (_type == Type::STRIDED) buffer += "Strided";
+    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
+    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
+    if constexpr (_dimension == Dimension::MATRIX)
+        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
 
-    ThreadPool() = default;
+    return buffer;
+}
 
-    explicit ThreadPool(std::size_t thread_count) { this->start_threads(thread_count); }
+// Human-readable formats automatically collapse matrices
+// that are too  large to be reasonably parsed by a human
+constexpr std::size_t _max_displayed_flat_size = 30 * 30;
 
-    ~ThreadPool() {
-        this->unpause();
-        this->wait_for_tasks();
-        this->stop_all_threads();
-    }
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+}
 
-    // --- Threads ---
-    // ---------------
+// Generic method to do "dense matrix print" with given delimers.
+// Cuts down on repitition since a lot of formats only differ in the delimers used.
+template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
+[[nodiscard]] std::string
+_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,      //
+                      std::string_view                                                              begin,       //
+                      std::string_view                                                              row_begin,   //
+                      std::string_view                                                              col_delimer, //
+                      std::string_view                                                              row_end,     //
+                      std::string_view                                                              row_delimer, //
+                      std::string_view                                                              end,         //
+                      Func                                                                          stringifier  //
+) {
+    if (tensor.empty()) return (std::string() += begin) += end;
 
-    [[nodiscard]] std::size_t get_thread_count() const {
-        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
-        return this->threads.size();
-    }
+    Matrix<std::string> strings(tensor.rows(), tensor.cols());
 
-    void set_thread_count(std::size_t thread_count) {
-        const std::size_t current_thread_count = this->get_thread_count();
+    // Stringify
+    if constexpr (type == Type::SPARSE) strings.fill("-");
+    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
+    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
+    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
 
-        if (thread_count == current_thread_count) return;
-        // 'quick escape' so we don't experience too much slowdown when the user calls '.set_thread_count()' reapeatedly
+    // Get column widths - we want matrix to format nice and aligned
+    std::vector<std::size_t> column_widths(strings.cols(), 0);
+    for (std::size_t i = 0; i < strings.rows(); ++i)
+        for (std::size_t j = 0; j < strings.cols(); ++j)
+            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
 
-        if (thread_count > current_thread_count) {
-            this->start_threads(thread_count - current_thread_count);
-        } else {
-            this->stop_all_threads();
-            {
-                const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-                this->stopping = false;
-            }
-            this->start_threads(thread_count);
-            // It is possible to improve implementation by making the pool shrink by joining only the necessary amount
-            // of threads instead of recreating the the whole pool, however that task is non-trivial and would likely
-            // require a more granular signaling with one flag per thread instead of a global 'stopping' flag.
+    // Format with proper alignment
+    std::string buffer(begin);
+    for (std::size_t i = 0; i < strings.rows(); ++i) {
+        buffer += row_begin;
+        for (std::size_t j = 0; j < strings.cols(); ++j) {
+            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
+            buffer += strings(i, j);
+            if (j + 1 < strings.cols()) buffer += col_delimer;
         }
+        buffer += row_end;
+        if (i + 1 < strings.rows()) buffer += row_delimer;
     }
+    buffer += end;
 
-    // --- Task queue ---
-    // ------------------
+    return buffer;
+}
 
-    template <class Func, class... Args>
-    void add_task(Func&& func, Args&&... args) {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->tasks.emplace(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        this->task_cv.notify_one(); // wakes up one thread (if possible) so it can pull the new task
-    }
+// --- Human-readable formats ---
+// ------------------------------
 
-    template <class Func, class... Args,
-              class FuncReturnType = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>>
-    [[nodiscard]] std::future<FuncReturnType> add_task_with_future(Func&& func, Args&&... args) {
-#if defined(_MSC_VER) || defined(_MSC_FULL_VER)
-        // MSVC messed up implementation of 'std::packaged_task<>' so it is not movable (which,
-        // according to the standard, it should be) and they can't fix it for 7 (and counting) years
-        // because fixing the bug would change the ABI. See this thread about the bug report:
-        // https://developercommunity.visualstudio.com/t/unable-to-move-stdpackaged-task-into-any-stl-conta/108672
-        // As a workaround we wrap the packaged task into a shared pointer and add another layer of packaging.
-        auto new_task = std::make_shared<std::packaged_task<FuncReturnType()>>(
-            std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        this->add_task([new_task] { (*new_task)(); }); // horrible
-        return new_task->get_future();
-#else
-        std::packaged_task<FuncReturnType()> new_task(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        auto                                 future = new_task.get_future();
-        this->add_task(std::move(new_task));
-        return future;
-#endif
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-    void wait_for_tasks() {
-        std::unique_lock<std::mutex> task_lock(this->task_mutex);
-        this->waiting = true;
-        this->task_finished_cv.wait(task_lock, [&] { return this->tasks.empty() && this->tasks_running == 0; });
-        this->waiting = false;
-    }
+    std::string buffer = _tensor_meta_string(tensor);
 
-    void clear_task_queue() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->tasks = {}; // for some reason 'std::queue' has no '.clear()', complexity O(N)
+    buffer += "  { ";
+    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
+        buffer += stringifier(tensor[idx]);
+        if (idx + 1 < tensor.size()) buffer += ", ";
     }
+    buffer += " }\n";
 
-    // --- Pausing ---
-    // ---------------
+    return buffer;
+}
 
-    void pause() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->paused = true;
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                        Func                                          stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-    void unpause() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->paused = false;
-        this->task_cv.notify_all();
-    }
+    std::string buffer = _tensor_meta_string(tensor);
 
-    [[nodiscard]] bool is_paused() const {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        return this->paused;
+    if constexpr (_dimension == Dimension::MATRIX) {
+        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
+            buffer += stringify("(", i, ", ", j, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
+    } else {
+        tensor.for_each([&](const T& elem, std::size_t i) {
+            buffer += stringify("(", i, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
     }
-};
-
-// =====================================
-// --- Static thread pool operations ---
-// =====================================
 
-inline ThreadPool& static_thread_pool() {
-    // no '[nodiscard]' since a call to this function might be used to initialize a threadpool
-    static ThreadPool pool(max_thread_count());
-    return pool;
+    return buffer;
 }
 
-[[nodiscard]] inline std::size_t get_thread_count() { return static_thread_pool().get_thread_count(); }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-inline void set_thread_count(std::size_t thread_count) { static_thread_pool().set_thread_count(thread_count); }
+    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
+}
 
-// ================
-// --- Task API ---
-// ================
+// --- Export formats ---
+// ----------------------
 
-template <class Func, class... Args>
-void task(Func&& func, Args&&... args) {
-    static_thread_pool().add_task(std::forward<Func>(func), std::forward<Args>(args)...);
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
 }
 
-template <class Func, class... Args>
-auto task_with_future(Func&& func, Args&&... args)
-    -> std::future<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> {
-    return static_thread_pool().add_task_with_future(std::forward<Func>(func), std::forward<Args>(args)...);
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
 }
 
-inline void wait_for_tasks() { static_thread_pool().wait_for_tasks(); }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
+}
 
-// =======================
-// --- Parallel ranges ---
-// =======================
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                         Func                                          stringifier = Func()) {
+    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
+}
 
-constexpr std::size_t default_grains_per_thread = 4;
-// by default we distribute 4 tasks per thread, this number is purely empirical.
-// We don't want to split up work into too many tasks (like with 'grain_size = 1')
-// yet we want it to be a bit more granular than doing 1 task per thread since
-// that would be horrible if tasks are noticeably uneven.
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
+                                 stringifier);
+}
 
-// Note:
-// In range constructors we intentionally allow some possibly narrowing conversions like 'it1 - it2' to 'size_t'
-// for better compatibility with containers that can use large ints as their difference type
-
-template <class Idx>
-struct IndexRange {
-    Idx         first;
-    Idx         last;
-    std::size_t grain_size;
 
-    IndexRange() = delete;
-    constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
-        : first(first), last(last), grain_size(grain_size) {}
-    IndexRange(Idx first, Idx last)
-        : IndexRange(first, last, _max_size(1, (last - first) / (get_thread_count() * default_grains_per_thread))){};
-};
+} // namespace format
 
-template <class Iter>
-struct Range {
-    Iter        begin;
-    Iter        end;
-    std::size_t grain_size;
+// ================================
+// --- Linear algebra operators ---
+// ================================
 
-    Range() = delete;
-    constexpr Range(Iter begin, Iter end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
-    Range(Iter begin, Iter end)
-        : Range(begin, end, _max_size(1, (end - begin) / (get_thread_count() * default_grains_per_thread))) {}
+// --- Unary operator implementation ----
+// --------------------------------------
 
+template <class L, class Op,                                                    //
+          _is_tensor_enable_if<L> = true,                                       //
+          class return_type       = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_unary_op(L&& left, Op&& op) {
+    using reference = typename std::decay_t<L>::reference;
 
-    template <class Container>
-    Range(const Container& container) : Range(container.begin(), container.end()) {}
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
 
-    template <class Container>
-    Range(Container& container) : Range(container.begin(), container.end()) {}
-};// requires random-access iterator, but no good way to express that before C++20 concepts
+    // '.for_each()' takes care of possible sparsity
+    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
 
-// User-defined deduction guides
-//
-// By default, template constructors cannot deduce template argument 'Iter',
-// however it is possible to define a custom deduction guide and achieve what we want
-//
-// See: https://en.cppreference.com/w/cpp/language/class_template_argument_deduction#User-defined_deduction_guides
-template <class Container>
-Range(const Container& container) -> Range<typename Container::const_iterator>;
+    return res;
+}
 
-template <class Container>
-Range(Container& container) -> Range<typename Container::iterator>;
+// --- Unary operator API ----
+// ---------------------------
 
-// ==========================
-// --- 'Parallel for' API ---
-// ==========================
+// std <functional> has function objects for every operator possible,
+// except unary '+' for some reason, which is why we have to implement it ourselves.
+// This is the exact same thing as 'std::negate<>' but for operator '+'.
+template <class T>
+struct _unary_plus_functor {
+    constexpr T operator()(const T& lhs) const { return +lhs; }
+};
 
-template <class Idx, class Func>
-void for_loop(IndexRange<Idx> range, Func&& func) {
-    for (Idx i = range.first; i < range.last; i += range.grain_size)
-        task(std::forward<Func>(func), i, _min_size(i + range.grain_size, range.last));
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left) {
+    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
+}
 
-    wait_for_tasks();
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left) {
+    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
 }
 
-template <class Iter, class Func>
-void for_loop(Range<Iter> range, Func&& func) {
-    for (Iter i = range.begin; i < range.end; i += range.grain_size)
-        task(std::forward<Func>(func), i, i + _min_size(range.grain_size, range.end - i));
+// --- Binary operator implementation ---
+// --------------------------------------
 
-    wait_for_tasks();
-}
+// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
+// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
+// r-lvalues if possible to avoid allocation. Doing so would effectively change something like this:
+//    res = A + B - C - D + E
+// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
+// all others. This however introduces it's own set of challenges since instead of traditional overloading we
+// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
+//
+// So here are the key points of implementing all of this:
+//
+//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
+//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
+//       correspond to the return type.
+//
+//    2. Binary operators have following return types for different tensors:
+//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
+//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
+//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
+//       - (4) sparse + sparse => sparse      (complexity O(N)  )
+//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
+//       while argument can be anything, including views. To implement the list above efficiently there
+//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+//
+//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
+//       and specialized with operator functors froms std <functional>. All we need for individual
+//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
+//       will be performed by the 'apply_operator' method.
+//
+// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
+// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
+// user, so we leave '*' as a matrix product and declate element-wise product as a function 'elementwise_product()'
+// since no existing operators seem suitable for such overload.
 
-template <class Container, class Func>
-void for_loop(Container&& container, Func&& func) {
-    for_loop(Range{std::forward<Container>(container)}, std::forward<Func>(func));
-}
-// couldn't figure out how to make it work perfect-forwared 'Container&&',
-// for some reason it would always cause template deduction to fail
+// (1)  dense +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-// =============================
-// --- 'Parallel reduce' API ---
-// =============================
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
 
-constexpr std::size_t default_unroll = 1;
+    return_type res;
 
-template <std::size_t unroll = default_unroll, class BinaryOp, class Iter, class T = typename Iter::value_type>
-auto reduce(Range<Iter> range, BinaryOp&& op) -> T {
+    // Reuse r-value arguments if possible while preserving the order of operations
+    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<L>(left);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
+    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<R>(right);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
+    } else {
+        res = return_type(left.rows(), left.cols());
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+    }
 
-    MutexProtected<T> result = *range.begin;
-    // we have to start from the 1st element and not 'T{}' because there is no guarantee
-    // than doing so would be correct for some non-trivial 'T' and 'op'
+    return res;
+}
 
-    for_loop(Range<Iter>{range.begin + 1, range.end, range.grain_size}, [&](Iter low, Iter high) {
-        const std::size_t range_size = high - low;
+// (2)  dense + sparse =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-        // Execute unrolled loop if unrolling is enabled and the range is sufficiently large
-        if constexpr (unroll > 1)
-            if (range_size > unroll) {
-                // (parallel section) Compute partial result (unrolled for SIMD)
-                // Reduce unrollable part
-                std::array<T, unroll> partial_results;
-                _unroll<std::size_t, unroll>([&](std::size_t j) { partial_results[j] = *(low + j); });
-                Iter it = low + unroll;
-                for (; it < high - unroll; it += unroll)
-                    _unroll<std::size_t, unroll>(
-                        [&, it](std::size_t j) { partial_results[j] = op(partial_results[j], *(it + j)); });
-                // Reduce remaining elements
-                for (; it < high; ++it) partial_results[0] = op(partial_results[0], *it);
-                // Collect the result
-                for (std::size_t i = 1; i < partial_results.size(); ++i)
-                    partial_results[0] = op(partial_results[0], partial_results[i]);
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
 
-                // (critical section) Add partial result to the global one
-                result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_results[0]); });
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
 
-                return; // skip the non-unrolled version
-            }
+    // '.for_each()' to only iterate sparse elements
+    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
 
-        // Fallback onto a regular reduction loop otherwise
-        // (parallel section) Compute partial result
-        T partial_result = *low;
-        for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, *it);
+    return res;
+}
 
-        // (critical section) Add partial result to the global one
-        result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_result); });
-    });
+// (3) sparse +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<R>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-    // Note 1:
-    // We could also collect results into an array of partial results and then reduce it on the
-    // main thread at the end, but that leads to a much less clean implementation and doesn't
-    // seem to be measurably faster.
+    using reference = typename std::decay_t<R>::reference;
+    using size_type = typename std::decay_t<R>::size_type;
 
-    // Note 2:
-    // 'if constexpr (unroll > 1)' ensures that unrolling logic will have no effect
-    //  whatsoever on the non-unrolled version of the template, it will not even compile.
+    // Reuse r-value if possible
+    return_type res = std::forward<R>(right);
 
-    return result.release();
-}
+    // '.for_each()' to only iterate sparse elements
+    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
 
-template <std::size_t unroll = default_unroll, class BinaryOp, class Container>
-auto reduce(Container&& container, BinaryOp&& op) -> typename std::decay_t<Container>::value_type {
-    return reduce<unroll>(Range{std::forward<Container>(container)}, std::forward<BinaryOp>(op));
+    return res;
 }
 
-// --- Pre-defined binary ops ---
-// ------------------------------
+// (4) sparse + sparse => sparse
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-// Note 1:
-// Defining binary operations as free-standing functions has a huge negative
-// effect on parallel::reduce performance, for example on 4 threads:
-//    binary op is 'sum'        => speedup ~90%-180%
-//    binary op is 'struct sum' => speedup ~370%
-// This is caused by failed inlining and seems to be the reason why standard library implements
-// 'std::plus' as a functor class and not a free-standing function. I spent 2 hours of my life
-// and 4 rewrites of 'parallel::reduce()' on this.
-
-// Note 2:
-// 'sum' & 'prod' can are just aliases for standard functors, 'min' & 'max' on the other hand
-// require custom, implementation. Note the '<void>' specialization for transparent functors,
-// see https://en.cppreference.com/w/cpp/utility/functional
-
-template <class... Args>
-using sum = std::plus<Args...>; // without variadic 'Args...' we wouldn't be able to alias 'std::plus<>'
+    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
+    using value_type   = typename std::decay_t<L>::value_type;
 
-template <class... Args>
-using prod = std::multiplies<Args...>;
+    std::vector<sparse_entry> res_triplets;
+    res_triplets.reserve(std::max(left.size(), right.size()));
+    // not enough when matrices have different sparsity patterns, but good enough for initial guess
 
-template <class T>
-struct min {
-    constexpr const T& operator()(const T& lhs, const T& rhs) const noexcept(noexcept((lhs < rhs) ? lhs : rhs)) {
-        return (lhs < rhs) ? lhs : rhs;
-    }
-};
+    std::size_t i = 0, j = 0;
 
-template <>
-struct min<void> {
-    template <class T1, class T2>
-    constexpr auto operator()(T1&& lhs, T2&& rhs) const
-        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T1>(lhs) : std::forward<T2>(rhs)))
-            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T1>(lhs) : std::forward<T2>(rhs)) {
-        return std::less<>{}(lhs, rhs) ? std::forward<T1>(lhs) : std::forward<T2>(rhs);
+    // Merge sparsity patterns
+    while (i < left.size() && j < right.size()) {
+        // Entry present only in lhs sparsity pattern
+        if (left._data[i] < right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
+        }
+        // Entry present only in rhs sparsity pattern
+        else if (left._data[i] > right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
+        }
+        // Entry present in both sparsity patterns
+        else {
+            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
+                                                                         std::forward<R>(right)._data[j++], op));
+        }
     }
+    // Copy the rest of lhs (if needed)
+    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
+    // Copy the rest of rhs (if needed)
+    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
 
-    using is_transparent = std::less<>::is_transparent;
-};
+    return return_type(left.rows(), left.cols(), std::move(res_triplets));
+}
 
-template <class T>
-struct max {
-    constexpr const T& operator()(const T& lhs, const T& rhs) const noexcept(noexcept((lhs < rhs) ? rhs : lhs)) {
-        return (lhs < rhs) ? rhs : lhs;
-    }
-};
+// --- Binary operator API ---
+// ---------------------------
 
-template <>
-struct max<void> {
-    template <class T1, class T2>
-    constexpr auto operator()(T1&& lhs, T2&& rhs) const
-        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)))
-            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)) {
-        return std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs);
-    }
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
+}
 
-    using is_transparent = std::less<>::is_transparent;
-};
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
+}
 
-} // namespace utl::parallel
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                                = typename std::decay_t<L>::value_type,
+          _has_binary_op_multiplies_enable_if<value_type> = true>
+auto elementwise_product(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
+}
 
-#endif
-#endif // module utl::parallel
+// --- Augmented assignment operator API ---
+// -----------------------------------------
 
+// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
 
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
+L& operator+=(L&& left, R&& right) {
+    return (left = std::move(left) + right);
+}
 
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                               = typename std::decay_t<L>::value_type,
+          _has_assignment_op_minus_enable_if<value_type> = true>
+L& operator-=(L&& left, R&& right) {
+    return (left = std::move(left) - right);
+}
 
+// --- Matrix multiplication ---
+// -----------------------------
 
+// Just like with binary operators, we run into the need to have 4 different implementations:
+//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
+//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
+//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
+//    - (4) sparse + sparse => sparse      (complexity O(N)  )
+//
+// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
+// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
+// an afterthought provided here mainly for convenience and not for actual number crunching usage.
+//
+// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
+// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// (1)  dense +  dense =>  dense
 //
-// Module:        utl::predef
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_predef.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
+// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
+// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
+// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
+// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
+// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
+// blocking seems to be worth it.
 //
-// This project is licensed under the MIT License
+// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
 //
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class Res, class L, class R>
+void _dense_matmul_accumulate(Res& res, const L& left, const R& right) {
+    // res += left * right
+    using size_type = typename std::decay_t<L>::size_type;
 
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PREDEF)
-#ifndef UTLHEADERGUARD_PREDEF
-#define UTLHEADERGUARD_PREDEF
+    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
+    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
 
-// _______________________ INCLUDES _______________________
+    constexpr size_type block_size_kk = 32;
 
-#include <algorithm>   // fill_n()
-#include <cctype>      // isspace()
-#include <cstdlib>     // exit()
-#include <iostream>    // cerr
-#include <iterator>    // ostreambuf_iterator<>
-#include <new>         // hardware_destructive_interference_size, hardware_constructive_interference_size
-#include <ostream>     // endl
-#include <sstream>     // istringstream
-#include <string>      // string, getline()
-#include <string_view> // string_view
-#include <utility>     // declval<>()
+    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
+        const size_type k_extent = std::min(N_k, kk + block_size_kk);
+        // needed for matrices that aren't a multiple of block size
+        for (size_type i = 0; i < N_i; ++i) {
+            for (size_type k = kk; k < k_extent; ++k) {
+                const auto& r = left(i, k);
+                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
+            }
+        }
+    }
+}
 
-// ____________________ DEVELOPER DOCS ____________________
+template <class L, class R,                                                                                //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
+          class value_type                                  = typename std::decay_t<L>::value_type,        //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
+          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
+          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
+          >
+return_type operator*(const L& left, const R& right) {
+    utl_mvl_assert(left.cols() == right.rows());
 
-// Macros that provide a nicer way of querying some platform-specific stuff such as:
-// compiler, platform, architecture, compilation info and etc.
-//
-// Boost Predef (https://www.boost.org/doc/libs/1_55_0/libs/predef/doc/html/index.html) provides
-// a more complete package when it comes to supporing some esoteric platforms & compilers,
-// but has a rather (in my opinion) ugly API.
-//
-// In addition utl::predef also provides some miscellaneous macros for automatic codegen, such as:
-//    UTL_PREDEF_VA_ARGS_COUNT(args...)
-//    UTL_PREDEF_ENUM_WITH_STRING_CONVERSION(enum_name, enum_values...)
-//    UTL_PREDEF_IS_FUNCTION_DEFINED() - a nightmare of implementation, but it works
-// some implementations may be rather sketchy due to trying to achieve things that weren't really
-// meant to be achieved, but at the end of the day everything is standard-compliant.
+    return_type res(left.rows(), right.cols(), value_type{});
+    _dense_matmul_accumulate(res, left, right);
 
-// ____________________ IMPLEMENTATION ____________________
+    return res;
+}
 
-namespace utl::predef {
+// (2)  dense + sparse =>  dense
+
+// TODO:
+
+// (3) sparse +  dense =>  dense
+
+// TODO:
+
+// (4) sparse + sparse => sparse
+
+// TODO:
+
+// --- Operators with preallocated output ---
+// ------------------------------------------
+
+// Operators above always return a new container. Loops that recompute results of the same shape over and over
+// (time stepping, iterative solvers) can instead write them into an existing container or a view into external
+// memory, which doesn't allocate at all. Element-wise functions allow 'dest' to be one of the arguments, since
+// every element is read before the corresponding element of 'dest' is written.
+
+template <class Dest, class Src>
+void _check_output_dimensions(const Dest& dest, const Src& src, const char* function) {
+    if (dest.rows() != src.rows() || dest.cols() != src.cols())
+        throw std::invalid_argument(stringify(function, "(): output dimensions ", dest.rows(), "x", dest.cols(),
+                                              " don't match the expected ", src.rows(), "x", src.cols(), "."));
+}
+
+// Dense & strided tensors occupy memory between their first and last element
+template <class A, class B>
+[[nodiscard]] bool _memory_overlaps(const A& a, const B& b) {
+    if (a.empty() || b.empty()) return false;
+
+    const auto* a_low  = &a(0, 0);
+    const auto* a_high = &a(a.rows() - 1, a.cols() - 1);
+    const auto* b_low  = &b(0, 0);
+    const auto* b_high = &b(b.rows() - 1, b.cols() - 1);
+
+    return !(std::less<>{}(a_high, b_low) || std::less<>{}(b_high, a_low));
+}
+
+template <class Dest, class Src, _is_tensor_enable_if<Dest> = true, _is_tensor_enable_if<Src> = true,
+          _is_nonsparse_tensor_enable_if<Dest> = true>
+Dest&& assign_into(Dest&& dest, const Src& src) {
+    using reference  = typename std::decay_t<Dest>::reference;
+    using value_type = typename std::decay_t<Dest>::value_type;
+    using size_type  = typename std::decay_t<Dest>::size_type;
+
+    _check_output_dimensions(dest, src, "assign_into");
+
+    if constexpr (std::decay_t<Src>::params::type == Type::SPARSE) {
+        dest.fill(value_type());
+        src.for_each([&](const value_type& elem, size_type i, size_type j) { dest(i, j) = elem; });
+    } else {
+        dest.for_each([&](reference elem, size_type i, size_type j) { elem = src(i, j); });
+    }
+
+    return std::forward<Dest>(dest);
+}
+
+template <class Dest, class L, class Op, _is_tensor_enable_if<Dest> = true, _is_tensor_enable_if<L> = true,
+          _is_nonsparse_tensor_enable_if<Dest> = true, _is_nonsparse_tensor_enable_if<L> = true>
+Dest&& apply_unary_op_into(Dest&& dest, const L& left, Op&& op) {
+    using reference = typename std::decay_t<Dest>::reference;
+    using size_type = typename std::decay_t<Dest>::size_type;
+
+    _check_output_dimensions(dest, left, "apply_unary_op_into");
+
+    dest.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j)); });
+
+    return std::forward<Dest>(dest);
+}
+
+template <class Dest, class L, class R, class Op, _is_tensor_enable_if<Dest> = true,
+          _are_tensors_with_same_value_type_enable_if<L, R> = true, _is_nonsparse_tensor_enable_if<Dest> = true,
+          _is_nonsparse_tensor_enable_if<L> = true, _is_nonsparse_tensor_enable_if<R> = true>
+Dest&& apply_binary_op_into(Dest&& dest, const L& left, const R& right, Op&& op) {
+    using reference = typename std::decay_t<Dest>::reference;
+    using size_type = typename std::decay_t<Dest>::size_type;
+
+    _check_output_dimensions(dest, left, "apply_binary_op_into");
+    _check_output_dimensions(dest, right, "apply_binary_op_into");
+
+    dest.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+
+    return std::forward<Dest>(dest);
+}
+
+// Matrix product can't be computed in-place, 'dest' must not overlap with the arguments
+template <class Dest, class L, class R, _is_tensor_enable_if<Dest> = true,
+          _are_tensors_with_same_value_type_enable_if<L, R> = true, _is_nonsparse_tensor_enable_if<Dest> = true,
+          _is_nonsparse_tensor_enable_if<L> = true, _is_nonsparse_tensor_enable_if<R> = true>
+Dest&& multiply_into(Dest&& dest, const L& left, const R& right) {
+    using value_type = typename std::decay_t<Dest>::value_type;
+
+    if (left.cols() != right.rows())
+        throw std::invalid_argument(stringify("multiply_into(): can't multiply ", left.rows(), "x", left.cols(),
+                                              " matrix by a ", right.rows(), "x", right.cols(), " matrix."));
+    if (dest.rows() != left.rows() || dest.cols() != right.cols())
+        throw std::invalid_argument(stringify("multiply_into(): output dimensions ", dest.rows(), "x", dest.cols(),
+                                              " don't match the expected ", left.rows(), "x", right.cols(), "."));
+    if (_memory_overlaps(dest, left) || _memory_overlaps(dest, right))
+        throw std::invalid_argument("multiply_into(): output can't overlap with the arguments.");
+
+    dest.fill(value_type{});
+    _dense_matmul_accumulate(dest, left, right);
+
+    return std::forward<Dest>(dest);
+}
 
 // ================================
-// --- Compiler Detection Macro ---
+// --- Matrix-vector operations ---
 // ================================
 
-#if defined(_MSC_VER)
-#define UTL_PREDEF_COMPILER_IS_MSVC
-#elif defined(__GNUC__) || defined(__GNUC_MINOR__) || defined(__GNUC_PATCHLEVEL__)
-#define UTL_PREDEF_COMPILER_IS_GCC
-#elif defined(__clang__) || defined(__clang_major__) || defined(__clang_minor__) || defined(__clang_patchlevel__)
-#define UTL_PREDEF_COMPILER_IS_CLANG
-#elif defined(__llvm__)
-#define UTL_PREDEF_COMPILER_IS_LLVM
-#elif defined(__INTEL_COMPILER) || defined(__ICL) || defined(__ICC) || defined(__ECC)
-#define UTL_PREDEF_COMPILER_IS_ICC
-#elif defined(__PGI) || defined(__PGIC__) || defined(__PGIC_MINOR__) || defined(__PGIC_PATCHLEVEL__)
-#define UTL_PREDEF_COMPILER_IS_PGI
-#elif defined(__IBMCPP__) || defined(__xlC__) || defined(__xlc__)
-#define UTL_PREDEF_COMPILER_IS_IBMCPP
-#elif defined(__NVCC__) || defined(__CUDACC__)
-#define UTL_PREDEF_COMPILER_IS_NVCC
-#else
-#define UTL_PREDEF_COMPILER_IS_UNKNOWN
-#endif
+// BLAS-like level 1 & 2 kernels that write into an existing output instead of allocating a new tensor, which is
+// what iterative methods need when they do thousands of matrix-vector products per solve. Vectors can be any type
+// with contiguous '.data()' and '.size()' ('std::vector<>', 'std::array<>', single-column matrices and etc.).
+//
+// Dense & strided matrices are handled uniformly through "element steps", with 'A(i, j)' located at
+// 'A.data()[i * row_step + j * col_step]'. Depending on which step is smaller the kernels either:
+//    - compute dot products of rows with 'x' (RC-like matrices), using several independent accumulators
+//      so that compiler can vectorize the reduction without reassociating floating point math;
+//    - compute 'y += x[j] * A(:, j)' column by column (CR-like matrices), in which case each thread owns
+//      a contiguous block of 'y' so no synchronization is needed.
+
+// Aliases that keep scalar arguments from participating in template deduction,
+// otherwise 'gemv(1, A, x, 0, y)' would deduce 'value_type' as 'int' for a matrix of doubles
+template <class Tensor>
+using _value_type_t = typename std::decay_t<Tensor>::value_type;
+
+template <class Vector>
+using _vector_value_t = std::decay_t<decltype(*std::declval<Vector&>().data())>;
+
+template <class Tensor>
+[[nodiscard]] std::pair<std::size_t, std::size_t> _element_steps(const Tensor& A) noexcept {
+    if constexpr (std::decay_t<Tensor>::params::layout == Layout::RC)
+        return {A.cols() * A.col_stride() + A.row_stride(), A.col_stride()};
+    else return {A.row_stride(), A.rows() * A.row_stride() + A.col_stride()};
+}
 
-constexpr std::string_view compiler_name =
-#if defined(UTL_PREDEF_COMPILER_IS_MSVC)
-    "MSVC"
-#elif defined(UTL_PREDEF_COMPILER_IS_GCC)
-    "GCC"
-#elif defined(UTL_PREDEF_COMPILER_IS_CLANG)
-    "clang"
-#elif defined(UTL_PREDEF_COMPILER_IS_LLVM)
-    "LLVM"
-#elif defined(UTL_PREDEF_COMPILER_IS_ICC)
-    "ICC"
-#elif defined(UTL_PREDEF_COMPILER_IS_PGI)
-    "PGI"
-#elif defined(UTL_PREDEF_COMPILER_IS_IBMCPP)
-    "IBMCPP"
-#elif defined(UTL_PREDEF_COMPILER_IS_NVCC)
-    "NVCC"
-#else
-    "<unknown>"
-#endif
-    ;
+template <class T>
+[[nodiscard]] T _strided_dot(const T* a, std::size_t a_step, const T* x, std::size_t n) {
+    constexpr std::size_t lanes = 8;
 
-constexpr std::string_view compiler_full_name =
-#if defined(UTL_PREDEF_COMPILER_IS_MSVC)
-    "Microsoft Visual C++ Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_GCC)
-    "GNU C/C++ Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_CLANG)
-    "Clang Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_LLVM)
-    "LLVM Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_ICC)
-    "Inter C/C++ Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_PGI)
-    "Portland Group C/C++ Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_IBMCPP)
-    "IBM XL C/C++ Compiler"
-#elif defined(UTL_PREDEF_COMPILER_IS_NVCC)
-    "Nvidia Cuda Compiler Driver"
-#else
-    "<unknown>"
-#endif
-    ;
+    std::array<T, lanes> acc{};
+    const std::size_t    n_lanes = n - n % lanes;
 
-// ================================
-// --- Platform Detection Macro ---
-// ================================
+    if (a_step == 1) {
+        for (std::size_t k = 0; k < n_lanes; k += lanes)
+            for (std::size_t l = 0; l < lanes; ++l) acc[l] += a[k + l] * x[k + l];
+    } else {
+        for (std::size_t k = 0; k < n_lanes; k += lanes)
+            for (std::size_t l = 0; l < lanes; ++l) acc[l] += a[(k + l) * a_step] * x[k + l];
+    }
+    for (std::size_t k = n_lanes; k < n; ++k) acc[0] += a[k * a_step] * x[k];
 
-#if defined(_WIN64) // _WIN64 implies _WIN32 so it should be first
-#define UTL_PREDEF_PLATFORM_IS_WINDOWS_X64
-#elif defined(_WIN32)
-#define UTL_PREDEF_PLATFORM_IS_WINDOWS_X32
-#elif defined(__CYGWIN__) && !defined(_WIN32) // Cygwin POSIX under Microsoft Window
-#define UTL_PREDEF_PLATFORM_IS_CYGWIN
-#elif defined(__ANDROID__) // __ANDROID__ implies __linux__ so it should be first
-#define UTL_PREDEF_PLATFORM_IS_ANDROID
-#elif defined(linux) || defined(__linux__) || defined(__linux)
-#define UTL_PREDEF_PLATFORM_IS_LINUX
-#elif defined(unix) || defined(__unix__) || defined(__unix)
-#define UTL_PREDEF_PLATFORM_IS_UNIX
-#elif defined(__APPLE__) && defined(__MACH__)
-#define UTL_PREDEF_PLATFORM_IS_MACOS
-#else
-#define UTL_PREDEF_PLATFORM_IS_UNKNOWN
-#endif
+    T res = T();
+    for (const auto& e : acc) res += e;
+    return res;
+}
 
-constexpr std::string_view platform_name =
-#if defined(UTL_PREDEF_PLATFORM_IS_WINDOWS_X64)
-    "Windows64"
-#elif defined(UTL_PREDEF_PLATFORM_IS_WINDOWS_X32)
-    "Windows32"
-#elif defined(UTL_PREDEF_PLATFORM_IS_CYGWIN)
-    "Windows (CYGWIN)"
-#elif defined(UTL_PREDEF_PLATFORM_IS_ANDROID)
-    "Android"
-#elif defined(UTL_PREDEF_PLATFORM_IS_LINUX)
-    "Linux"
-#elif defined(UTL_PREDEF_PLATFORM_IS_UNIX)
-    "Unix-like OS"
-#elif defined(UTL_PREDEF_PLATFORM_IS_MACOS)
-    "MacOS" // Apple OSX and iOS (Darwin)
-#else
-    "<unknown>"
-#endif
-    ;
+// y = alpha * A * x + beta * y, when 'beta' is zero 'y' doesn't have to be initialized
+template <class Tensor, class VectorX, class VectorY, _is_tensor_enable_if<Tensor> = true,
+          _is_nonsparse_tensor_enable_if<Tensor> = true, class value_type = typename std::decay_t<Tensor>::value_type>
+void gemv(const _value_type_t<Tensor>& alpha, const Tensor& A, const VectorX& x, const _value_type_t<Tensor>& beta,
+          VectorY& y) {
+    if (x.size() != A.cols() || y.size() != A.rows())
+        throw std::invalid_argument(stringify("Can't compute GEMV for a ", A.rows(), "x", A.cols(), " matrix, ",
+                                              x.size(), "-element 'x' and ", y.size(), "-element 'y'."));
+    if (static_cast<const void*>(x.data()) == static_cast<const void*>(y.data()) && x.size() != 0)
+        throw std::invalid_argument("GEMV can't be computed with 'x' and 'y' aliasing the same data.");
+
+    const std::size_t N_i = A.rows(), N_j = A.cols();
+    const auto [row_step, col_step] = _element_steps(A);
+
+    const value_type* a  = A.data();
+    const value_type* xp = x.data();
+    value_type*       yp = y.data();
+
+    const bool overwrite_y = (beta == value_type());
+
+    if (col_step <= row_step) {
+        _parallel_for(N_i, _min_grain(2 * N_j), [&](std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) {
+                const value_type dot = alpha * _strided_dot(a + i * row_step, col_step, xp, N_j);
+                yp[i]                = overwrite_y ? dot : dot + beta * yp[i];
+            }
+        });
+    } else {
+        _parallel_for(N_i, _min_grain(2 * N_j), [&](std::size_t low, std::size_t high) {
+            value_type* y_block = yp + low;
+            if (overwrite_y) std::fill(y_block, yp + high, value_type());
+            else
+                for (std::size_t i = 0; i < high - low; ++i) y_block[i] *= beta;
+
+            for (std::size_t j = 0; j < N_j; ++j) {
+                const value_type  s   = alpha * xp[j];
+                const value_type* col = a + j * col_step + low * row_step;
+                if (row_step == 1)
+                    for (std::size_t i = 0; i < high - low; ++i) y_block[i] += s * col[i];
+                else
+                    for (std::size_t i = 0; i < high - low; ++i) y_block[i] += s * col[i * row_step];
+            }
+        });
+    }
+}
 
+// A += alpha * x * y^T
+template <class VectorX, class VectorY, class Tensor, _is_tensor_enable_if<Tensor> = true,
+          _is_nonsparse_tensor_enable_if<Tensor> = true, class value_type = typename std::decay_t<Tensor>::value_type>
+void ger(const _value_type_t<Tensor>& alpha, const VectorX& x, const VectorY& y, Tensor&& A) {
+    static_assert(std::decay_t<Tensor>::params::ownership != Ownership::CONST_VIEW,
+                  "Rank-1 update can't be applied to a const view.");
+
+    if (x.size() != A.rows() || y.size() != A.cols())
+        throw std::invalid_argument(stringify("Can't compute rank-1 update of a ", A.rows(), "x", A.cols(),
+                                              " matrix with ", x.size(), "-element 'x' and ", y.size(),
+                                              "-element 'y'."));
+
+    const std::size_t N_i = A.rows(), N_j = A.cols();
+    const auto [row_step, col_step] = _element_steps(A);
+
+    value_type*       a  = A.data();
+    const value_type* xp = x.data();
+    const value_type* yp = y.data();
+
+    // Same as 'axpy' over each contiguous line of 'A'
+    const auto update_lines = [&](const value_type* scales, const value_type* v, std::size_t line_count,
+                                  std::size_t line_size, std::size_t line_step, std::size_t elem_step) {
+        _parallel_for(line_count, _min_grain(2 * line_size), [&](std::size_t low, std::size_t high) {
+            for (std::size_t line = low; line < high; ++line) {
+                const value_type s = alpha * scales[line];
+                value_type*      p = a + line * line_step;
+                if (elem_step == 1)
+                    for (std::size_t k = 0; k < line_size; ++k) p[k] += s * v[k];
+                else
+                    for (std::size_t k = 0; k < line_size; ++k) p[k * elem_step] += s * v[k];
+            }
+        });
+    };
 
-// ====================================
-// --- Architecture Detection Macro ---
-// ====================================
+    if (col_step <= row_step) update_lines(xp, yp, N_i, N_j, row_step, col_step);
+    else update_lines(yp, xp, N_j, N_i, col_step, row_step);
+}
 
-#if defined(__x86_64) || defined(__x86_64__) || defined(__amd64__) || defined(__amd64) || defined(_M_X64)
-#define UTL_PREDEF_ARCHITECTURE_IS_X86_64
-#elif defined(i386) || defined(__i386__) || defined(__i486__) || defined(__i586__) || defined(__i686__) ||             \
-    defined(__i386) || defined(_M_IX86) || defined(_X86_) || defined(__THW_INTEL__) || defined(__I86__) ||             \
-    defined(__INTEL__) || defined(__I86__) || defined(_M_IX86) || defined(__i686__) || defined(__i586__) ||            \
-    defined(__i486__) || defined(__i386__)
-#define UTL_PREDEF_ARCHITECTURE_IS_X86_32
-#elif defined(__arm__) || defined(__thumb__) || defined(__TARGET_ARCH_ARM) || defined(__TARGET_ARCH_THUMB) ||          \
-    defined(__TARGET_ARCH_ARM) || defined(__TARGET_ARCH_THUMB)
-#define UTL_PREDEF_ARCHITECTURE_IS_ARM
-#else
-#define UTL_PREDEF_ARCHITECTURE_IS_UNKNOWN
-#endif
+// y += alpha * x
+template <class VectorX, class VectorY, class value_type = _vector_value_t<VectorY>>
+void axpy(const _vector_value_t<VectorY>& alpha, const VectorX& x, VectorY& y) {
+    if (x.size() != y.size())
+        throw std::invalid_argument(stringify("Can't compute AXPY for ", x.size(), "-element 'x' and ", y.size(),
+                                              "-element 'y'."));
 
-constexpr std::string_view architecture_name =
-#if defined(UTL_PREDEF_ARCHITECTURE_IS_X86_64)
-    "x86-64"
-#elif defined(UTL_PREDEF_ARCHITECTURE_IS_X86_32)
-    "x86-32"
-#elif defined(UTL_PREDEF_ARCHITECTURE_IS_ARM)
-    "ARM"
-#else
-    "<unknown>"
-#endif
-    ;
+    const auto  xp = x.data();
+    value_type* yp = y.data();
 
-// =========================================
-// --- Language Standard Detection Macro ---
-// =========================================
+    _parallel_for(y.size(), _min_grain(2), [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) yp[i] += alpha * xp[i];
+    });
+}
 
-#if defined(UTL_PREDEF_COMPILER_IS_MSVC)
-#define UTL_PREDEF_CPP_VERSION _MSVC_LANG
-#else
-#define UTL_PREDEF_CPP_VERSION __cplusplus
-#endif
-// Note 1:
-// MSVC '__cplusplus' is defined, but stuck at '199711L'. It uses '_MSVC_LANG' instead.
+// ================================
+// --- Batched small matrices ---
+// ================================
+
+// Large batches of tiny matrices (3x3 rotations, 6x6 stiffness blocks and etc.) get very little out of regular
+// matrix kernels: loop overhead dominates and a single matrix doesn't have enough work to fill vector registers.
+// The usual solution (also used by batched BLAS implementations) is to interleave the batch so that the same
+// element of several consecutive matrices is stored contiguously:
 //
-// Note 2:
-// '__cplusplus' is defined by the standard, it's only Microsoft who think standards are for other people.
+//    [ A0(0,0) A1(0,0) ... A7(0,0) ][ A0(0,1) A1(0,1) ... A7(0,1) ] ... [ A8(0,0) A9(0,0) ... A15(0,0) ] ...
+//      <-------- 'lanes' -------->
+//      <------------------------ block of 'lanes' matrices ------------------------>
 //
-// Note 3:
-// MSVC has a flag '/Zc:__cplusplus' that enables standard behaviour for '__cplusplus'
+// after which every kernel becomes a plain scalar algorithm where each "scalar" operation is a loop over 'lanes'
+// independent matrices. Such loops have a compile-time trip count, no dependencies and contiguous access, which
+// is exactly what compilers need to emit SIMD without resorting to platform-specific intrinsics. For the same
+// reason pivoting in 'batched_solve()' is done with per-lane selects rather than branches.
 
-#if (UTL_PREDEF_CPP_VERSION >= 202302L)
-#define UTL_PREDEF_STANDARD_IS_23_PLUS
-#elif (UTL_PREDEF_CPP_VERSION >= 202002L)
-#define UTL_PREDEF_STANDARD_IS_20_PLUS
-#elif (UTL_PREDEF_CPP_VERSION >= 201703L)
-#define UTL_PREDEF_STANDARD_IS_17_PLUS
-#elif (UTL_PREDEF_CPP_VERSION >= 201402L)
-#define UTL_PREDEF_STANDARD_IS_14_PLUS
-#elif (UTL_PREDEF_CPP_VERSION >= 201103L)
-#define UTL_PREDEF_STANDARD_IS_11_PLUS
-#else // everything below C++11 has the same value of '199711L'
-#define UTL_PREDEF_STANDARD_IS_UNKNOWN
-#endif
-// Note:
-// There should be no feasible way to fall below the 'UTL_PREDEF_STANDARD_IS_17_PLUS' since this library itself
-// requires C++17 to compile, but might as well have a complete implementation for future reference.
+constexpr std::size_t _default_batch_lanes = 8;
 
-constexpr std::string_view standard_name =
-#if defined(UTL_PREDEF_STANDARD_IS_23_PLUS)
-    "C++23"
-#elif defined(UTL_PREDEF_STANDARD_IS_20_PLUS)
-    "C++20"
-#elif defined(UTL_PREDEF_STANDARD_IS_17_PLUS)
-    "C++17"
-#elif defined(UTL_PREDEF_STANDARD_IS_14_PLUS)
-    "C++14"
-#elif defined(UTL_PREDEF_STANDARD_IS_11_PLUS)
-    "C++11"
-#else
-    "<unknown>"
-#endif
-    ;
+template <class T, std::size_t lanes_ = _default_batch_lanes>
+class MatrixBatch {
+public:
+    using self            = MatrixBatch;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
 
-// ========================================
-// --- Compilation Mode Detection Macro ---
-// ========================================
+    constexpr static size_type lanes = lanes_;
 
-#if defined(_DEBUG)
-#define UTL_PREDEF_MODE_IS_DEBUG
-#endif
+    static_assert(lanes > 0, "Batch should have at least one lane.");
 
-constexpr bool debug =
-#if defined(UTL_PREDEF_MODE_IS_DEBUG)
-    true
-#else
-    false
-#endif
-    ;
+private:
+    size_type               _size = 0;
+    size_type               _rows = 0;
+    size_type               _cols = 0;
+    std::vector<value_type> _data;
 
-// ===========================
-// --- Optimization macros ---
-// ===========================
+    [[nodiscard]] size_type _offset(size_type b, size_type i, size_type j) const noexcept {
+        return (b / lanes) * this->block_size() + (i * this->cols() + j) * lanes + b % lanes;
+    }
 
-// Note:
-// These are mainly valuable as a reference implementation for portable optimization built-ins,
-// which is why they are made to independent of other macros in this module.
+public:
+    MatrixBatch() = default;
 
-// Force inline
-// (requires regular 'inline' after the macro)
-#if defined(_MSC_VER)
-#define UTL_PREDEF_FORCE_INLINE __forceinline
-#elif defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
-#define UTL_PREDEF_FORCE_INLINE __attribute__((always_inline))
-#else
-#define UTL_PREDEF_FORCE_INLINE
-#endif
+    explicit MatrixBatch(size_type size, size_type rows, size_type cols, const_reference value = value_type())
+        : _size(size), _rows(rows), _cols(cols), _data(((size + lanes - 1) / lanes) * rows * cols * lanes, value) {}
+    // the last block gets padded up to a full number of lanes, padding is never visible through the public API
 
-// Force noinline
-#if defined(_MSC_VER)
-#define UTL_PREDEF_FORCE_NOINLINE __declspec((noinline))
-#elif defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
-#define UTL_PREDEF_FORCE_NOINLINE __attribute__((noinline))
-#endif
+    [[nodiscard]] size_type size() const noexcept { return this->_size; }
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+    [[nodiscard]] bool      empty() const noexcept { return this->size() == 0; }
 
-// Branch prediction hints
-// (legacy, use '[[likely]]', '[[unlikely]] in C++20 and on)
-#if defined(__GNUC__) || defined(__clang__)
-#define UTL_PREDEF_LEGACY_LIKELY(x) __builtin_expect(!!(x), 1)
-#else
-#define UTL_PREDEF_LEGACY_LIKELY(x) (x)
-#endif
+    [[nodiscard]] size_type blocks() const noexcept { return (this->size() + lanes - 1) / lanes; }
+    [[nodiscard]] size_type block_size() const noexcept { return this->rows() * this->cols() * lanes; }
 
-#if defined(__GNUC__) || defined(__clang__)
-#define UTL_PREDEF_LEGACY_UNLIKELY(x) __builtin_expect(!!(x), 0)
-#else
-#define UTL_PREDEF_LEGACY_UNLIKELY(x) (x)
-#endif
+    [[nodiscard]] pointer       data() noexcept { return this->_data.data(); }
+    [[nodiscard]] const_pointer data() const noexcept { return this->_data.data(); }
 
-// Assume condition
-#if defined(UTL_PREDEF_STANDARD_IS_23_PLUS)
-#define UTL_PREDEF_ASSUME(...) [[assume(__VA_ARGS__))]]
-#elif defined(UTL_PREDEF_COMPILER_IS_MSVC)
-#define UTL_PREDEF_ASSUME(...) __assume(__VA_ARGS__)
-#elif defined(UTL_PREDEF_COMPILER_IS_CLANG)
-#define UTL_PREDEF_ASSUME(...) __builtin_assume(__VA_ARGS__)
-#else // no equivalent GCC built-in
-#define UTL_PREDEF_ASSUME(...) __VA_ARGS__
-#endif
+    [[nodiscard]] reference operator()(size_type b, size_type i, size_type j) {
+        return this->_data[this->_offset(b, i, j)];
+    }
 
-[[noreturn]] inline void unreachable() {
-#if defined(UTL_PREDEF_STANDARD_IS_23_PLUS)
-    std::unreachable();
-#elif defined(UTL_PREDEF_COMPILER_IS_MSVC)
-    __assume(false);
-#elif defined(UTL_PREDEF_COMPILER_IS_GCC) || defined(UTL_PREDEF_COMPILER_IS_CLANG)
-    __builtin_unreachable();
-#endif
-}
+    [[nodiscard]] const_reference operator()(size_type b, size_type i, size_type j) const {
+        return this->_data[this->_offset(b, i, j)];
+    }
 
-// ===================
-// --- Other Utils ---
-// ===================
+    template <class Tensor, _is_tensor_enable_if<Tensor> = true>
+    self& set(size_type b, const Tensor& matrix) {
+        if (matrix.rows() != this->rows() || matrix.cols() != this->cols())
+            throw std::invalid_argument(stringify("Matrix of size ", matrix.rows(), "x", matrix.cols(),
+                                                  " doesn't fit into a batch of ", this->rows(), "x", this->cols(),
+                                                  " matrices."));
+        matrix.for_each([&](const value_type& elem, size_type i, size_type j) { this->operator()(b, i, j) = elem; });
+        return *this;
+    }
 
-[[nodiscard]] inline std::string compilation_summary() {
-    std::string buffer;
+    [[nodiscard]] Matrix<value_type> get(size_type b) const {
+        return Matrix<value_type>(this->rows(), this->cols(),
+                                  [&](size_type i, size_type j) { return this->operator()(b, i, j); });
+    }
+};
 
-    buffer += "Compiler:          ";
-    buffer += compiler_full_name;
-    buffer += '\n';
+template <class T, std::size_t lanes>
+void _batched_conditional_swap(T* a, T* b, const std::array<std::size_t, lanes>& pivot, std::size_t row) {
+    for (std::size_t l = 0; l < lanes; ++l) {
+        const bool swap = (pivot[l] == row);
+        const T    lo = a[l], hi = b[l];
+        a[l]          = swap ? hi : lo;
+        b[l]          = swap ? lo : hi;
+    }
+}
 
-    buffer += "Platform:          ";
-    buffer += platform_name;
-    buffer += '\n';
+// Gauss-Jordan elimination with partial pivoting for a block of interleaved matrices,
+// 'a' holds (n x n) systems, 'x' holds (n x m) right-hand sides and gets overwritten with the solution
+template <class T, std::size_t lanes>
+void _batched_gauss_jordan(T* a, T* x, std::size_t n, std::size_t m) {
+    const auto A = [&](std::size_t i, std::size_t j) { return a + (i * n + j) * lanes; };
+    const auto X = [&](std::size_t i, std::size_t j) { return x + (i * m + j) * lanes; };
+
+    for (std::size_t k = 0; k < n; ++k) {
+        // Every lane picks its own pivot row
+        std::array<std::size_t, lanes> pivot;
+        std::array<T, lanes>           pivot_abs;
+        for (std::size_t l = 0; l < lanes; ++l) pivot[l] = k, pivot_abs[l] = std::abs(A(k, k)[l]);
+
+        for (std::size_t r = k + 1; r < n; ++r) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                const T    value   = std::abs(A(r, k)[l]);
+                const bool greater = value > pivot_abs[l];
+                pivot_abs[l]       = greater ? value : pivot_abs[l];
+                pivot[l]           = greater ? r : pivot[l];
+            }
+        }
 
-    buffer += "Architecture:      ";
-    buffer += architecture_name;
-    buffer += '\n';
-    
-    #ifdef __cpp_lib_hardware_interference_size
-    buffer += "L1 cache line (D):  ";
-    buffer += std::to_string(std::hardware_destructive_interference_size);
-    buffer += '\n';
-    
-    buffer += "L1 cache line (C):  ";
-    buffer += std::to_string(std::hardware_constructive_interference_size);
-    buffer += '\n';
-    #endif // not (currently) implemented in GCC / clang despite being a C++17 feature
+        // Swap rows through selects, lanes that don't need a swap keep their values
+        for (std::size_t r = k + 1; r < n; ++r) {
+            if (std::find(pivot.begin(), pivot.end(), r) == pivot.end()) continue;
+            for (std::size_t c = k; c < n; ++c) _batched_conditional_swap<T, lanes>(A(k, c), A(r, c), pivot, r);
+            for (std::size_t c = 0; c < m; ++c) _batched_conditional_swap<T, lanes>(X(k, c), X(r, c), pivot, r);
+        }
 
-    buffer += "Compiled in DEBUG: ";
-    buffer += debug ? "true" : "false";
-    buffer += '\n';
+        // Normalize the pivot row
+        std::array<T, lanes> inv_pivot;
+        for (std::size_t l = 0; l < lanes; ++l) inv_pivot[l] = T(1) / A(k, k)[l];
 
-    buffer += "Compiled under OS: ";
-    buffer += __STDC_HOSTED__ ? "true" : "false";
-    buffer += '\n';
+        for (std::size_t c = k + 1; c < n; ++c)
+            for (std::size_t l = 0; l < lanes; ++l) A(k, c)[l] *= inv_pivot[l];
+        for (std::size_t c = 0; c < m; ++c)
+            for (std::size_t l = 0; l < lanes; ++l) X(k, c)[l] *= inv_pivot[l];
 
-    buffer += "Compilation date:  ";
-    buffer += __DATE__;
-    buffer += ' ';
-    buffer += __TIME__;
-    buffer += '\n';
+        // Eliminate column 'k' from all other rows
+        for (std::size_t r = 0; r < n; ++r) {
+            if (r == k) continue;
 
-    return buffer;
-}
+            std::array<T, lanes> factor;
+            for (std::size_t l = 0; l < lanes; ++l) factor[l] = A(r, k)[l];
 
-// ===================
-// --- Macro Utils ---
-// ===================
+            for (std::size_t c = k + 1; c < n; ++c)
+                for (std::size_t l = 0; l < lanes; ++l) A(r, c)[l] -= factor[l] * A(k, c)[l];
+            for (std::size_t c = 0; c < m; ++c)
+                for (std::size_t l = 0; l < lanes; ++l) X(r, c)[l] -= factor[l] * X(k, c)[l];
+        }
+    }
+}
 
-// --- Size of __VA_ARGS__ in variadic macros ---
-// ----------------------------------------------
+// C[b] = A[b] * B[b] for every matrix in the batch, 'C' gets resized if necessary.
+// Product can't be computed in-place, since every output element reads a whole row & column of the inputs.
+template <class T, std::size_t lanes>
+void batched_gemm(const MatrixBatch<T, lanes>& A, const MatrixBatch<T, lanes>& B, MatrixBatch<T, lanes>& C) {
+    if (&C == &A || &C == &B)
+        throw std::invalid_argument("Output batch of 'batched_gemm()' can't alias its inputs.");
+
+    if (A.size() != B.size() || A.cols() != B.rows())
+        throw std::invalid_argument(stringify("Can't multiply batches of ", A.size(), " (", A.rows(), "x", A.cols(),
+                                              ") and ", B.size(), " (", B.rows(), "x", B.cols(), ") matrices."));
+
+    if (C.size() != A.size() || C.rows() != A.rows() || C.cols() != B.cols())
+        C = MatrixBatch<T, lanes>(A.size(), A.rows(), B.cols());
+
+    const std::size_t N_i = A.rows(), N_k = A.cols(), N_j = B.cols();
+
+    const auto multiply_blocks = [&](std::size_t low, std::size_t high) {
+        for (std::size_t block = low; block < high; ++block) {
+            const T* a = A.data() + block * A.block_size();
+            const T* b = B.data() + block * B.block_size();
+            T*       c = C.data() + block * C.block_size();
+
+            for (std::size_t i = 0; i < N_i; ++i) {
+                for (std::size_t j = 0; j < N_j; ++j) {
+                    std::array<T, lanes> acc{};
+                    for (std::size_t k = 0; k < N_k; ++k) {
+                        const T* a_ik = a + (i * N_k + k) * lanes;
+                        const T* b_kj = b + (k * N_j + j) * lanes;
+                        for (std::size_t l = 0; l < lanes; ++l) acc[l] += a_ik[l] * b_kj[l];
+                    }
+                    std::copy(acc.begin(), acc.end(), c + (i * N_j + j) * lanes);
+                }
+            }
+        }
+    };
 
-#define utl_predef_expand_va_args(x_) x_ // a fix for MSVC bug not expanding __VA_ARGS__ properly
+    _parallel_for(A.blocks(), _min_grain(2 * N_i * N_j * N_k * lanes), multiply_blocks);
+}
 
-#define utl_predef_va_args_count_impl(x01_, x02_, x03_, x04_, x05_, x06_, x07_, x08_, x09_, x10_, x11_, x12_, x13_,    \
-                                      x14_, x15_, x16_, x17_, x18_, x19_, x20_, x21_, x22_, x23_, x24_, x25_, x26_,    \
-                                      x27_, x28_, x29_, x30_, x31_, x32_, x33_, x34_, x35_, x36_, x37_, x38_, x39_,    \
-                                      x40_, x41_, x42_, x43_, x44_, x45_, x46_, x47_, x48_, x49_, N_, ...)             \
-    N_
+// Solves A[b] * X[b] = B[b] for every system in the batch, 'X' gets resized if necessary.
+// Singular systems don't throw (that would require a branch per lane), their solutions come out non-finite.
+template <class T, std::size_t lanes>
+void batched_solve(const MatrixBatch<T, lanes>& A, const MatrixBatch<T, lanes>& B, MatrixBatch<T, lanes>& X) {
+    static_assert(std::is_floating_point_v<T>, "Batched solver requires a floating point type.");
 
-#define UTL_PREDEF_VA_ARGS_COUNT(...)                                                                                  \
-    utl_predef_expand_va_args(utl_predef_va_args_count_impl(                                                           \
-        __VA_ARGS__, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26,   \
-        25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+    if (A.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't solve systems with non-square ", A.rows(), "x", A.cols(),
+                                              " matrices."));
+    if (A.size() != B.size() || A.rows() != B.rows())
+        throw std::invalid_argument(stringify("Batch of ", B.size(), " (", B.rows(), "x", B.cols(),
+                                              ") right-hand sides doesn't match a batch of ", A.size(), " (",
+                                              A.rows(), "x", A.cols(), ") systems."));
 
-// --- Map function macro to __VA_ARGS__ ---
-// -----------------------------------------
+    if (&X != &B && (X.size() != B.size() || X.rows() != B.rows() || X.cols() != B.cols()))
+        X = MatrixBatch<T, lanes>(B.size(), B.rows(), B.cols());
 
-#define utl_predef_map_eval_0(...) __VA_ARGS__
-#define utl_predef_map_eval_1(...) utl_predef_map_eval_0(utl_predef_map_eval_0(utl_predef_map_eval_0(__VA_ARGS__)))
-#define utl_predef_map_eval_2(...) utl_predef_map_eval_1(utl_predef_map_eval_1(utl_predef_map_eval_1(__VA_ARGS__)))
-#define utl_predef_map_eval_3(...) utl_predef_map_eval_2(utl_predef_map_eval_2(utl_predef_map_eval_2(__VA_ARGS__)))
-#define utl_predef_map_eval_4(...) utl_predef_map_eval_3(utl_predef_map_eval_3(utl_predef_map_eval_3(__VA_ARGS__)))
-#define utl_predef_map_eval(...) utl_predef_map_eval_4(utl_predef_map_eval_4(utl_predef_map_eval_4(__VA_ARGS__)))
+    const std::size_t n = A.rows(), m = B.cols();
 
-#define utl_predef_map_end(...)
-#define utl_predef_map_out
-#define utl_predef_map_comma ,
+    const auto solve_blocks = [&](std::size_t low, std::size_t high) {
+        std::vector<T> workspace(A.block_size());
 
-#define utl_predef_map_get_end_2() 0, utl_predef_map_end
-#define utl_predef_map_get_end_1(...) utl_predef_map_get_end2
-#define utl_predef_map_get_end(...) utl_predef_map_get_end_1
-#define utl_predef_map_next_0(test, next, ...) next utl_predef_map_out
-#define utl_predef_map_next_1(test, next) utl_predef_map_next_0(test, next, 0)
-#define utl_predef_map_next(test, next) utl_predef_map_next_1(utl_predef_map_get_end test, next)
+        for (std::size_t block = low; block < high; ++block) {
+            const T* a = A.data() + block * A.block_size();
+            const T* b = B.data() + block * B.block_size();
+            T*       x = X.data() + block * X.block_size();
 
-#define utl_predef_map_0(f, x, peek, ...) f(x) utl_predef_map_next(peek, utl_predef_map_1)(f, peek, __VA_ARGS__)
-#define utl_predef_map_1(f, x, peek, ...) f(x) utl_predef_map_next(peek, utl_predef_map_0)(f, peek, __VA_ARGS__)
+            std::copy(a, a + A.block_size(), workspace.begin());
+            if (x != b) std::copy(b, b + B.block_size(), x);
 
-#define utl_predef_map_list_next_1(test, next) utl_predef_map_next_0(test, utl_predef_map_comma next, 0)
-#define utl_predef_map_list_next(test, next) utl_predef_map_list_next_1(utl_predef_map_get_end test, next)
+            // Padding lanes of the last block get an identity matrix so they don't produce NaNs
+            for (std::size_t l = A.size() - block * lanes; l < lanes; ++l)
+                for (std::size_t i = 0; i < n; ++i)
+                    for (std::size_t j = 0; j < n; ++j) workspace[(i * n + j) * lanes + l] = T(i == j);
 
-#define utl_predef_map_list_0(f, x, peek, ...)                                                                         \
-    f(x) utl_predef_map_list_next(peek, utl_predef_map_list_1)(f, peek, __VA_ARGS__)
-#define utl_predef_map_list_1(f, x, peek, ...)                                                                         \
-    f(x) utl_predef_map_list_next(peek, utl_predef_map_list_0)(f, peek, __VA_ARGS__)
+            _batched_gauss_jordan<T, lanes>(workspace.data(), x, n, m);
+        }
+    };
 
-// Applies the function macro `f` to each of the remaining parameters.
-#define UTL_PREDEF_MAP(f, ...) utl_predef_map_eval(utl_predef_map_1(f, __VA_ARGS__, ()()(), ()()(), ()()(), 0))
+    _parallel_for(A.blocks(), _min_grain(n * n * (n + m) * lanes), solve_blocks);
+}
 
-// Applies the function macro `f` to each of the remaining parameters and
-// inserts commas between the results.
-#define UTL_PREDEF_MAP_LIST(f, ...)                                                                                    \
-    utl_predef_map_eval(utl_predef_map_list_1(f, __VA_ARGS__, ()()(), ()()(), ()()(), 0))
+// A_inv[b] = inverse(A[b]) for every matrix in the batch, 'A_inv' gets resized if necessary
+template <class T, std::size_t lanes>
+void batched_inverse(const MatrixBatch<T, lanes>& A, MatrixBatch<T, lanes>& A_inv) {
+    MatrixBatch<T, lanes> identity(A.size(), A.rows(), A.rows());
+    for (std::size_t block = 0; block < identity.blocks(); ++block)
+        for (std::size_t i = 0; i < A.rows(); ++i)
+            std::fill_n(identity.data() + block * identity.block_size() + (i * A.rows() + i) * lanes, lanes, T(1));
 
-// ===============
-// --- Codegen ---
-// ===============
+    batched_solve(A, identity, identity); // solution overwrites the identity in-place, 'A' stays untouched
+    A_inv = std::move(identity);
+}
 
-// --- Type trait generation ---
-// -----------------------------
+// ============================
+// --- Block sparse matrices ---
+// ============================
 
-// This macro generates a type trait 'trait_name_' that returns 'true' for any 'T'
-// such that 'T'-dependent expression passed into '...' compiles.
+// Matrices coming from multi-physics discretizations (elasticity, coupled PDEs and etc.) usually consist of small
+// dense 'block_size x block_size' tiles, one per coupled pair of nodes. Storing every such scalar as a COO triplet
+// wastes 2 indices per value and scatters neighbouring values across memory. Block compressed sparse row (BSR)
+// format stores a single column index per tile and keeps tile values contiguous:
 //
-// Also generates as helper-constant 'trait_name_##_v` like the one all standard traits provide.
+//    block_row_offsets = [ 0, 2, 3 ]           <- tiles of block row 'I' are [ offsets[I], offsets[I + 1] )
+//    block_col_indices = [ 0, 3, 1 ]           <- block column of each tile
+//    values            = [ T0 ][ T1 ][ T2 ]    <- 'block_size * block_size' values per tile, row-major
 //
-// Also generates as shortcut for 'enable_if' based on that trait.
+// Since tile size is a compile-time constant, all tile kernels below have fixed trip counts and get fully unrolled
+// & vectorized by the compiler without any platform-specific intrinsics.
 //
-// This macro saves MASSIVE amount of boilerplate in some cases, making for a much more expressive "trait definitions".
+// Matrix dimensions have to be divisible by the block size, this keeps the kernels free of edge cases.
 
-#define UTL_PREDEF_TYPE_TRAIT(trait_name_, ...)                                                                        \
-    template <class T, class = void>                                                                                   \
-    struct trait_name_ : std::false_type {};                                                                           \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+template <class T, std::size_t block_size_>
+class BSRMatrix {
+    static_assert(block_size_ > 0, "Block size should be positive.");
 
-// Shortcuts for different types of requirements
-#define UTL_PREDEF_TYPE_TRAIT_HAS_BINARY_OP(trait_name_, op_)                                                          \
-    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<std::decay_t<T>>() op_ std::declval<std::decay_t<T>>())
+public:
+    using self            = BSRMatrix;
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = const T&;
 
-#define UTL_PREDEF_TYPE_TRAIT_HAS_ASSIGNMENT_OP(trait_name_, op_)                                                      \
-    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<std::decay_t<T>&>() op_ std::declval<std::decay_t<T>>())
-// for operators like '+=' lhs should be a reference
+    constexpr static size_type block_size = block_size_;
+    constexpr static size_type block_area = block_size * block_size;
 
-#define UTL_PREDEF_TYPE_TRAIT_HAS_UNARY_OP(trait_name_, op_)                                                           \
-    UTL_PREDEF_TYPE_TRAIT(trait_name_, op_ std::declval<std::decay_t<T>>())
+private:
+    size_type               _rows              = 0;
+    size_type               _cols              = 0;
+    std::vector<size_type>  _block_row_offsets = {0};
+    std::vector<size_type>  _block_col_indices;
+    std::vector<value_type> _values;
 
-#define UTL_PREDEF_TYPE_TRAIT_HAS_MEMBER(trait_name_, member_)                                                         \
-    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<std::decay_t<T>>().member_)
+    static void _check_dimensions(size_type rows, size_type cols) {
+        if (rows % block_size != 0 || cols % block_size != 0)
+            throw std::invalid_argument(stringify("BSR matrix dimensions ", rows, "x", cols,
+                                                  " are not divisible by the block size ", block_size, "."));
+    }
 
-#define UTL_PREDEF_TYPE_TRAIT_HAS_MEMBER_TYPE(trait_name_, member_)                                                    \
-    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<typename std::decay_t<T>::member_>())
+public:
+    BSRMatrix() = default;
+
+    explicit BSRMatrix(size_type rows, size_type cols, std::vector<size_type> block_row_offsets,
+                       std::vector<size_type> block_col_indices, std::vector<value_type> values)
+        : _rows(rows), _cols(cols), _block_row_offsets(std::move(block_row_offsets)),
+          _block_col_indices(std::move(block_col_indices)), _values(std::move(values)) {
+        _check_dimensions(rows, cols);
+        if (this->_block_row_offsets.size() != this->block_rows() + 1)
+            throw std::invalid_argument(stringify("BSR block row offsets should have block_rows + 1 (which is ",
+                                                  this->block_rows() + 1, ") elements, got ",
+                                                  this->_block_row_offsets.size(), "."));
+        if (this->_values.size() != this->_block_col_indices.size() * block_area ||
+            this->_block_row_offsets.back() != this->_block_col_indices.size())
+            throw std::invalid_argument("BSR block column indices, values and block row offsets don't match in size.");
+        for (const auto& J : this->_block_col_indices)
+            if (J >= this->block_cols())
+                throw std::out_of_range(stringify("BSR block column index ", J, " is out of range for ",
+                                                  this->block_cols(), " block columns."));
+    }
+
+    // Conversion from any 2D tensor, every tile containing at least one non-default-initialized element gets stored
+    template <class Tensor, _is_tensor_enable_if<Tensor> = true>
+    explicit BSRMatrix(const Tensor& tensor) {
+        // Sparse tensors always keep their triplets sorted, other tensors have to be converted first
+        if constexpr (std::decay_t<Tensor>::params::type == Type::SPARSE) this->_assign_from_sorted(tensor);
+        else this->_assign_from_sorted(SparseMatrix<value_type>(tensor));
+    }
+
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+    [[nodiscard]] size_type block_rows() const noexcept { return this->_rows / block_size; }
+    [[nodiscard]] size_type block_cols() const noexcept { return this->_cols / block_size; }
+    [[nodiscard]] size_type blocks() const noexcept { return this->_block_col_indices.size(); }
+    [[nodiscard]] size_type size() const noexcept { return this->_values.size(); }
+    [[nodiscard]] bool      empty() const noexcept { return this->size() == 0; }
+
+    [[nodiscard]] const std::vector<size_type>&  block_row_offsets() const noexcept { return this->_block_row_offsets; }
+    [[nodiscard]] const std::vector<size_type>&  block_col_indices() const noexcept { return this->_block_col_indices; }
+    [[nodiscard]] const std::vector<value_type>& values() const noexcept { return this->_values; }
+    [[nodiscard]] std::vector<value_type>&       values() noexcept { return this->_values; }
+
+    // Row-major 'block_size x block_size' tile number 'k'
+    [[nodiscard]] const value_type* block_data(size_type k) const noexcept {
+        return this->_values.data() + k * block_area;
+    }
+    [[nodiscard]] value_type* block_data(size_type k) noexcept { return this->_values.data() + k * block_area; }
+
+    // Iterates all stored values, including zeroes that pad the tiles
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type I = 0; I < this->block_rows(); ++I)
+            for (size_type k = this->_block_row_offsets[I]; k < this->_block_row_offsets[I + 1]; ++k) {
+                const size_type J    = this->_block_col_indices[k];
+                const auto      tile = this->block_data(k);
+                for (size_type r = 0; r < block_size; ++r)
+                    for (size_type c = 0; c < block_size; ++c)
+                        func(tile[r * block_size + c], I * block_size + r, J * block_size + c);
+            }
+        return *this;
+    }
 
-// --- Enum with string conversion ---
-// -----------------------------------
+    // Only non-default-initialized values become triplets, tile padding gets dropped
+    [[nodiscard]] SparseMatrix<value_type> to_sparse() const {
+        std::vector<SparseEntry2D<value_type>> triplets;
+        triplets.reserve(this->size());
+        this->for_each([&](const_reference value, size_type i, size_type j) {
+            if (value != value_type()) triplets.push_back({i, j, value});
+        });
+        return SparseMatrix<value_type>(this->rows(), this->cols(), std::move(triplets));
+    }
 
-[[nodiscard]] inline std::string _trim_enum_string(const std::string& str) {
-    std::string::const_iterator left_it = str.begin();
-    while (left_it != str.end() && std::isspace(*left_it)) ++left_it;
+private:
+    template <class SortedTensor>
+    void _assign_from_sorted(const SortedTensor& tensor) {
+        _check_dimensions(tensor.rows(), tensor.cols());
+
+        this->_rows = tensor.rows();
+        this->_cols = tensor.cols();
+        this->_block_row_offsets.assign(this->block_rows() + 1, 0);
+        this->_block_col_indices.clear();
+        this->_values.clear();
+
+        // Triplets are sorted by { i, j }, which means block rows come one after another. First pass collects
+        // unique block columns of each block row as it ends, second pass scatters values into zero-initialized tiles.
+        std::vector<size_type> row_block_cols;
+        size_type              current_I = 0;
+
+        const auto finish_block_rows_until = [&](size_type I) {
+            for (; current_I < I; ++current_I) {
+                std::sort(row_block_cols.begin(), row_block_cols.end());
+                row_block_cols.erase(std::unique(row_block_cols.begin(), row_block_cols.end()), row_block_cols.end());
+                this->_block_col_indices.insert(this->_block_col_indices.end(), row_block_cols.begin(),
+                                                row_block_cols.end());
+                this->_block_row_offsets[current_I + 1] = this->_block_col_indices.size();
+                row_block_cols.clear();
+            }
+        };
 
-    std::string::const_reverse_iterator right_it = str.rbegin();
-    while (right_it.base() != left_it && std::isspace(*right_it)) ++right_it;
+        tensor.for_each([&](const_reference, size_type i, size_type j) {
+            finish_block_rows_until(i / block_size);
+            row_block_cols.push_back(j / block_size);
+        });
+        finish_block_rows_until(this->block_rows());
 
-    return std::string(left_it, right_it.base()); // return string with whitespaces trimmed at both sides
+        this->_values.assign(this->blocks() * block_area, value_type());
+
+        tensor.for_each([&](const_reference value, size_type i, size_type j) {
+            const auto row_first = this->_block_col_indices.begin() + this->_block_row_offsets[i / block_size];
+            const auto row_last  = this->_block_col_indices.begin() + this->_block_row_offsets[i / block_size + 1];
+            const auto k         = static_cast<size_type>(std::lower_bound(row_first, row_last, j / block_size) -
+                                                  this->_block_col_indices.begin());
+            this->block_data(k)[(i % block_size) * block_size + j % block_size] = value;
+        });
+    }
+};
+
+// y = A * x, 'x' should have 'A.cols()' elements, 'y' gets resized to 'A.rows()' if necessary
+template <class T, std::size_t block_size>
+void spmv(const BSRMatrix<T, block_size>& A, const std::vector<T>& x, std::vector<T>& y) {
+    if (x.size() != A.cols())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " BSR matrix by a vector of ",
+                                              x.size(), " elements."));
+    if (&x == &y) throw std::invalid_argument("BSR matrix-vector product can't be computed in-place.");
+
+    y.resize(A.rows());
+
+    const auto& offsets = A.block_row_offsets();
+    const auto& indices = A.block_col_indices();
+
+    const auto multiply_block_rows = [&](std::size_t low, std::size_t high) {
+        for (std::size_t I = low; I < high; ++I) {
+            std::array<T, block_size> acc{};
+
+            for (std::size_t k = offsets[I]; k < offsets[I + 1]; ++k) {
+                const T* a = A.block_data(k);
+                const T* b = x.data() + indices[k] * block_size;
+                for (std::size_t r = 0; r < block_size; ++r)
+                    for (std::size_t c = 0; c < block_size; ++c) acc[r] += a[r * block_size + c] * b[c];
+            }
+
+            std::copy(acc.begin(), acc.end(), y.data() + I * block_size);
+        }
+    };
+
+    const std::size_t average_blocks = A.blocks() / std::max<std::size_t>(A.block_rows(), 1) + 1;
+    _parallel_for(A.block_rows(), _min_grain(2 * average_blocks * A.block_area), multiply_block_rows);
 }
 
-inline void _split_enum_args(const char* va_args, std::string* strings, int count) {
-    std::istringstream ss(va_args);
-    std::string        buffer;
+// Y = A * X for a dense 'X', 'Y' gets resized if necessary.
+// Each tile value multiplies a contiguous row of 'X', which turns the innermost loop into a vectorizable axpy.
+template <class T, std::size_t block_size, Checking checking_x, Checking checking_y>
+void spmm(const BSRMatrix<T, block_size>& A, const Matrix<T, checking_x>& X, Matrix<T, checking_y>& Y) {
+    if (X.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " BSR matrix by a ", X.rows(),
+                                              "x", X.cols(), " matrix."));
+    if (static_cast<const void*>(&X) == static_cast<const void*>(&Y))
+        throw std::invalid_argument("BSR matrix-matrix product can't be computed in-place.");
+
+    if (Y.rows() != A.rows() || Y.cols() != X.cols()) Y = Matrix<T, checking_y>(A.rows(), X.cols());
+
+    const std::size_t n = X.cols();
+
+    const auto& offsets = A.block_row_offsets();
+    const auto& indices = A.block_col_indices();
+
+    const auto multiply_block_rows = [&](std::size_t low, std::size_t high) {
+        for (std::size_t I = low; I < high; ++I) {
+            T* y = Y.data() + I * block_size * n;
+            std::fill_n(y, block_size * n, T());
+
+            for (std::size_t k = offsets[I]; k < offsets[I + 1]; ++k) {
+                const T* a = A.block_data(k);
+                const T* b = X.data() + indices[k] * block_size * n;
+                for (std::size_t r = 0; r < block_size; ++r)
+                    for (std::size_t c = 0; c < block_size; ++c) {
+                        const T  a_rc  = a[r * block_size + c];
+                        const T* b_row = b + c * n;
+                        T*       y_row = y + r * n;
+                        for (std::size_t j = 0; j < n; ++j) y_row[j] += a_rc * b_row[j];
+                    }
+            }
+        }
+    };
 
-    for (int i = 0; ss.good() && (i < count); ++i) {
-        std::getline(ss, buffer, ',');
-        strings[i] = _trim_enum_string(buffer);
+    const std::size_t average_blocks = A.blocks() / std::max<std::size_t>(A.block_rows(), 1) + 1;
+    _parallel_for(A.block_rows(), _min_grain(2 * average_blocks * A.block_area * n), multiply_block_rows);
+}
+
+// ================
+// --- Stencils ---
+// ================
+
+// Stencil sweeps are computed as 'out(i, j) = sum_{a, b} w(a, b) * in(i + a - ry, j + b - rx)' where 'ry' & 'rx'
+// are kernel radii. Since such sweeps are memory-bound, the kernels below are organized around memory access:
+//
+//    1. Interior rows are computed "tap-by-tap": for each kernel weight 'w' we do 'out_row += w * shifted_in_row'
+//       over a tile of columns. This is a simple contiguous axpy that compilers vectorize, column tiles are
+//       small enough for the output tile to stay in L1 across all of the taps.
+//    2. Only the elements within kernel radius of the matrix edge go through a slow path with boundary handling.
+//    3. Row ranges get split between threads.
+//    4. Repeated sweeps use temporal blocking: matrix is split into row bands, each band gets extended with
+//       a halo of 'steps * ry' rows and all of the steps are done on that band while it's hot in cache. Halo rows
+//       get recomputed by neighbouring bands, which is cheap compared to 'steps' passes over the whole matrix.
+//       Periodic boundaries would require halo to wrap around the matrix, in that case we fall back to plain sweeps.
+
+enum class Boundary { ZERO, CLAMP, PERIODIC };
+
+// Compile-time kernel, weights are stored row-major, dimensions should be odd so that the kernel has a center
+template <class T, std::size_t rows_, std::size_t cols_ = rows_>
+struct Stencil {
+    static_assert(rows_ % 2 == 1 && cols_ % 2 == 1, "Stencil dimensions should be odd.");
+
+    std::array<T, rows_ * cols_> weights;
+
+    [[nodiscard]] constexpr static std::size_t rows() noexcept { return rows_; }
+    [[nodiscard]] constexpr static std::size_t cols() noexcept { return cols_; }
+
+    [[nodiscard]] constexpr const T& operator()(std::size_t i, std::size_t j) const { return weights[i * cols_ + j]; }
+    [[nodiscard]] constexpr T&       operator()(std::size_t i, std::size_t j) { return weights[i * cols_ + j]; }
+};
+
+// Internal kernel representation, '0' static dimensions mean the dimensions are only known at runtime.
+// Static dimensions turn all of the tap loops into fixed-count loops that get fully unrolled.
+template <class T, std::size_t static_rows, std::size_t static_cols>
+struct _stencil_kernel {
+    const T*    weights;
+    std::size_t runtime_rows;
+    std::size_t runtime_cols;
+
+    [[nodiscard]] constexpr std::size_t rows() const noexcept { return static_rows ? static_rows : runtime_rows; }
+    [[nodiscard]] constexpr std::size_t cols() const noexcept { return static_cols ? static_cols : runtime_cols; }
+    [[nodiscard]] constexpr const T&    operator()(std::size_t i, std::size_t j) const noexcept {
+        return weights[i * this->cols() + j];
     }
 };
 
-#define UTL_PREDEF_ENUM_WITH_STRING_CONVERSION(enum_name_, ...)                                                        \
-    namespace enum_name_ {                                                                                             \
-    enum enum_name_ { __VA_ARGS__, _count };                                                                           \
-                                                                                                                       \
-    inline std::string _strings[_count];                                                                               \
-                                                                                                                       \
-    inline std::string to_string(enum_name_ enum_val) {                                                                \
-        if (_strings[0].empty()) { utl::predef::_split_enum_args(#__VA_ARGS__, _strings, _count); }                    \
-        return _strings[enum_val];                                                                                     \
-    }                                                                                                                  \
-                                                                                                                       \
-    inline enum_name_ from_string(const std::string& enum_str) {                                                       \
-        if (_strings[0].empty()) { utl::predef::_split_enum_args(#__VA_ARGS__, _strings, _count); }                    \
-        for (int i = 0; i < _count; ++i) {                                                                             \
-            if (_strings[i] == enum_str) { return static_cast<enum_name_>(i); }                                        \
-        }                                                                                                              \
-        return _count;                                                                                                 \
-    }                                                                                                                  \
+constexpr std::size_t _stencil_tile_cols   = 512;     // output tile width used by interior sweeps
+constexpr std::size_t _stencil_cache_bytes = 1 << 20; // rough size of L2, used to select temporal band height
+
+// Maps possibly out-of-range index into '[0, size)', returns 'false' if element should be treated as zero
+[[nodiscard]] inline bool _stencil_map_index(std::ptrdiff_t& idx, std::size_t size, Boundary boundary) noexcept {
+    const auto n = static_cast<std::ptrdiff_t>(size);
+    if (idx >= 0 && idx < n) return true;
+    if (boundary == Boundary::ZERO) return false;
+    if (boundary == Boundary::CLAMP) idx = std::clamp<std::ptrdiff_t>(idx, 0, n - 1);
+    if (boundary == Boundary::PERIODIC) idx = (idx % n + n) % n;
+    return true;
+}
+
+// Computes rows '[low, high)' of a single sweep over 'rows x cols' row-major grid
+template <class T, class Kernel>
+void _stencil_sweep(const T* in, T* out, std::size_t rows, std::size_t cols, std::size_t low, std::size_t high,
+                    const Kernel& kernel, Boundary boundary) {
+    const std::size_t kr = kernel.rows(), kc = kernel.cols();
+    const std::size_t ry = kr / 2, rx = kc / 2;
+
+    const auto edge_value = [&](std::size_t i, std::size_t j) {
+        T acc = T();
+        for (std::size_t a = 0; a < kr; ++a) {
+            auto ii = static_cast<std::ptrdiff_t>(i + a) - static_cast<std::ptrdiff_t>(ry);
+            if (!_stencil_map_index(ii, rows, boundary)) continue;
+            for (std::size_t b = 0; b < kc; ++b) {
+                auto jj = static_cast<std::ptrdiff_t>(j + b) - static_cast<std::ptrdiff_t>(rx);
+                if (!_stencil_map_index(jj, cols, boundary)) continue;
+                acc += kernel(a, b) * in[static_cast<std::size_t>(ii) * cols + static_cast<std::size_t>(jj)];
+            }
+        }
+        return acc;
+    };
+
+    const bool has_interior_cols = (cols > 2 * rx);
+
+    for (std::size_t i = low; i < high; ++i) {
+        T* out_row = out + i * cols;
+
+        // Slow path, whole row is within kernel radius of the top / bottom edge
+        if (i < ry || i + ry >= rows || !has_interior_cols) {
+            for (std::size_t j = 0; j < cols; ++j) out_row[j] = edge_value(i, j);
+            continue;
+        }
+
+        // Fast path, tap-by-tap accumulation over column tiles
+        for (std::size_t j_low = rx; j_low < cols - rx; j_low += _stencil_tile_cols) {
+            const std::size_t j_high = std::min(j_low + _stencil_tile_cols, cols - rx);
+
+            std::fill(out_row + j_low, out_row + j_high, T());
+
+            for (std::size_t a = 0; a < kr; ++a) {
+                const T* in_row = in + (i + a - ry) * cols;
+                for (std::size_t b = 0; b < kc; ++b) {
+                    const T  w       = kernel(a, b);
+                    const T* shifted = in_row + b;
+                    for (std::size_t j = j_low; j < j_high; ++j) out_row[j] += w * shifted[j - rx];
+                }
+            }
+        }
+
+        // Slow path for the left & right edges
+        for (std::size_t j = 0; j < rx; ++j) out_row[j] = edge_value(i, j);
+        for (std::size_t j = cols - rx; j < cols; ++j) out_row[j] = edge_value(i, j);
     }
-    // We declare namespace with enum inside to simulate enum-class while having '_strings' array
-    // and 'to_string()', 'from_string()' methods bundled with it.
-    //
-    // To count number of enum elements we add fake '_count' value at the end, which ends up being enum size
-    //
-    // '_strings' is declared compile-time, but gets filled through lazy evaluation upon first
-    // 'to_string()' or 'from_string()' call. To fill it we interpret #__VA_ARGS__ as a single string
-    // with some comma-separated identifiers. Those identifiers get split by commas, trimmed from
-    // whitespaces and added to '_strings'
-    //
-    // Upon further calls (enum -> string) conversion is done though taking '_strings[enum_val]',
-    // while (string -> enum) conversion requires searching through '_strings' to find enum index
+}
 
-#define UTL_PREDEF_IS_FUNCTION_DEFINED(function_name_, return_type_, ...)                                              \
-    template <class ReturnType, class... ArgTypes>                                                                     \
-    class utl_is_function_defined_impl_##function_name_ {                                                              \
-    private:                                                                                                           \
-        typedef char no[sizeof(ReturnType) + 1];                                                                       \
-                                                                                                                       \
-        template <class... C>                                                                                          \
-        static auto test(C... arg) -> decltype(function_name_(arg...));                                                \
-                                                                                                                       \
-        template <class... C>                                                                                          \
-        static no& test(...);                                                                                          \
-                                                                                                                       \
-    public:                                                                                                            \
-        enum { value = (sizeof(test<ArgTypes...>(std::declval<ArgTypes>()...)) == sizeof(ReturnType)) };               \
-    };                                                                                                                 \
-                                                                                                                       \
-    using is_function_defined_##function_name_ =                                                                       \
-        utl_is_function_defined_impl_##function_name_<return_type_, __VA_ARGS__>;
-// TASK:
-// We need to detect at compile time if function FUNC(ARGS...) exists.
-// FUNC identifier isn't guaranteed to be declared.
-//
-// Ideal method would look like UTL_FUNC_EXISTS(FUNC, RETURN_TYPE, ARG_TYPES...) -> true/false
-// This does not seem to be possible, we have to declare integral constant instead, see explanation below.
-//
-// WHY IS IT SO HARD:
-// (1) Can this be done through preprocessor macros?
-// No, preprocessor has no way to tell whether C++ identifier is defined or not.
-//
-// (2) Is there a compiler-specific way to do it?
-// Doesn't seem to be the case.
-//
-// (3) Why not use some sort of template with FUNC as a parameter?
-// Essentially we have to evaluate undeclared identifier, while compiler exits with error upon
-// encountering anything undeclared. The only way to detect whether undeclared identifier exists
-// or not seems to be through SFINAE.
-//
-// IMPLEMENTATION COMMENTS:
-// We declate integral constant class with 2 functions 'test()', first one takes priority during overload
-// resolution and compiles if FUNC(ARGS...) is defined, otherwise it's {Substitution Failure} which is
-// {Is Not An Error} and second function compiles.
-//
-// To resolve which overload of 'test()' was selected we check the sizeof() return type, 2nd overload
-// has a return type 'char[sizeof(ReturnType) + 1]' so it's always different from 1st overload.
-// Resolution result (true/false) gets stored to '::value'.
-//
-// Note that we can't pass 'ReturnType' and 'ArgTypes' directly through '__VA_ARGS__' because
-// to call function 'test(ARGS...)' in general case we have to 'std::declval<>()' all 'ARGS...'.
-// To do so we can use variadic template syntax and then just forward '__VA_ARGS__' to the template
-// through 'using is_function_present = is_function_present_impl<ReturnType, __VA_ARGS__>'.
-//
-// ALTERNATIVES: Perhaps some sort of tricky inline SFINAE can be done through C++14 generic lambdas.
-//
-// NOTE 1: Some versions of 'clangd' give a 'bugprone-sizeof-expression' warning for sizeof(*A),
-// this is a false alarm.
-//
-// NOTE 2: Frankly, the usefullness of this is rather dubious since constructs like
-//     if constexpr (is_function_defined_windown_specific) { <call the windows-specific function> }
-//     else { <call the linux-specific function> }
-// are still illegal due to 'if constexpr' requiting both branches to have defined identifiers,
-// but since this arcane concept is already implemented why not keep it.
-
-} // namespace utl::predef
+template <class T, class Kernel>
+void _apply_stencil(const T* src, T* dst, std::size_t rows, std::size_t cols, const Kernel& kernel,
+                    Boundary boundary, std::size_t steps) {
+    if (steps == 0 || rows == 0 || cols == 0) {
+        std::copy(src, src + rows * cols, dst);
+        return;
+    }
 
-#endif
-#endif // module utl::predef
+    const std::size_t ry        = kernel.rows() / 2;
+    const std::size_t halo      = steps * ry;
+    const std::size_t row_grain = _min_grain(2 * cols * kernel.rows() * kernel.cols());
 
+    // Temporal blocking is only worth it when bands fitting into cache are substantially taller than the halo
+    const std::size_t cache_rows  = std::max<std::size_t>(_stencil_cache_bytes / (2 * sizeof(T) * cols), 1);
+    const bool        use_bands   = steps > 1 && boundary != Boundary::PERIODIC && 4 * halo <= cache_rows;
+    const std::size_t thread_rows = (rows + _max_thread_count() - 1) / _max_thread_count();
 
+    // Plain sweeps, ping-pong between 'dst' and a buffer so that the last sweep ends up in 'dst'
+    if (!use_bands || cache_rows - 2 * halo >= rows) {
+        std::vector<T> buffer(steps > 1 ? rows * cols : 0);
 
+        const T* in = src;
+        for (std::size_t s = 0; s < steps; ++s) {
+            T* out = ((steps - s) % 2 == 1) ? dst : buffer.data();
+            _parallel_for(rows, row_grain, [&](std::size_t low, std::size_t high) {
+                _stencil_sweep(in, out, rows, cols, low, high, kernel, boundary);
+            });
+            in = out;
+        }
+        return;
+    }
 
+    // Temporally blocked sweeps
+    const std::size_t band_rows  = std::max(std::min(cache_rows - 2 * halo, thread_rows), halo);
+    const std::size_t band_count = (rows + band_rows - 1) / band_rows;
 
+    _parallel_for(band_count, 1, [&](std::size_t band_low, std::size_t band_high) {
+        std::vector<T> current, next;
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::profiler
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_profiler.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+        for (std::size_t band = band_low; band < band_high; ++band) {
+            const std::size_t r_low  = band * band_rows;
+            const std::size_t r_high = std::min(r_low + band_rows, rows);
+            const std::size_t g_low  = (r_low >= halo) ? r_low - halo : 0;
+            const std::size_t g_high = std::min(r_high + halo, rows);
+            const std::size_t extent = g_high - g_low;
 
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PROFILER)
-#ifndef UTLHEADERGUARD_PROFILER
-#define UTLHEADERGUARD_PROFILER
+            current.assign(src + g_low * cols, src + g_high * cols);
+            next.resize(current.size());
 
-// _______________________ INCLUDES _______________________
+            // Valid part of the band shrinks by 'ry' rows per step at the edges that aren't real matrix edges,
+            // real matrix edges get regular boundary handling
+            for (std::size_t s = 1; s <= steps; ++s) {
+                const std::size_t low  = (g_low == 0) ? 0 : s * ry;
+                const std::size_t high = (g_high == rows) ? extent : extent - s * ry;
+                _stencil_sweep(current.data(), next.data(), extent, cols, low, high, kernel, boundary);
+                std::swap(current, next);
+            }
 
-#include <algorithm>   // sort()
-#include <chrono>      // chrono::steady_clock, chrono::duration_cast<>, std::chrono::milliseconds
-#include <cstdlib>     // atexit()
-#include <fstream>     // ofstream
-#include <iomanip>     // setprecision(), setw()
-#include <ios>         // streamsize, fixed,
-#include <iostream>    // cout
-#include <ostream>     // ostream
-#include <sstream>     // ostringstream
-#include <string>      // string
-#include <string_view> // string_view
-#include <vector>      // vector<>
+            std::copy(current.begin() + (r_low - g_low) * cols, current.begin() + (r_high - g_low) * cols,
+                      dst + r_low * cols);
+        }
+    });
+}
 
-// ____________________ DEVELOPER DOCS ____________________
+template <class T, Checking checking, class Kernel>
+void _apply_stencil_to_matrix(const T* src, std::size_t rows, std::size_t cols, const Kernel& kernel,
+                              Matrix<T, checking>& dst, Boundary boundary, std::size_t steps) {
+    // Sweeps can't be done in-place, aliased source has to be copied
+    if (src == dst.data() && rows * cols > 0) {
+        const std::vector<T> src_copy(src, src + rows * cols);
+        _apply_stencil(src_copy.data(), dst.data(), rows, cols, kernel, boundary, steps);
+        return;
+    }
+    if (dst.rows() != rows || dst.cols() != cols) dst = Matrix<T, checking>(rows, cols);
+    _apply_stencil(src, dst.data(), rows, cols, kernel, boundary, steps);
+}
 
-// Macros for quick code profiling.
-// Trivially simple, yet effective way of finding bottlenecks without any tooling.
-//
-// Can also be used to benchmark stuff "quick & dirty" due to doing all the time measuring
-// and table formatting one would usually implement in their benchmarks. A proper bechmark
-// suite of course would include support for automatic reruns and gather statistical data,
-// but in prototying this is often not necessary.
-//
-// Resolving time recording inside recursion took some thinking, but ended up being quite simple in
-// implementation. See the docs for more details on that.
-//
-// Currently, the overhead of profiling is barely different to the overhead of just time measurement,
-// this also took a bit of thinking but in the end there is a nice solution that uses static variables
-// to offload things that can only be done once to their initialization, and then links local variables
-// to 'static' markers of the callsite recording. See 'UTL_PROFILE' macro for some more details.
+// dst = 'stencil' applied to 'src' 'steps' times, 'dst' gets resized if necessary and can be the same as 'src'
+template <class T, std::size_t kernel_rows, std::size_t kernel_cols, Checking checking_src, Checking checking_dst>
+void apply_stencil(const Matrix<T, checking_src>& src, const Stencil<T, kernel_rows, kernel_cols>& stencil,
+                   Matrix<T, checking_dst>& dst, Boundary boundary = Boundary::ZERO, std::size_t steps = 1) {
+    const _stencil_kernel<T, kernel_rows, kernel_cols> kernel{stencil.weights.data(), kernel_rows, kernel_cols};
+    _apply_stencil_to_matrix(src.data(), src.rows(), src.cols(), kernel, dst, boundary, steps);
+}
 
-// ____________________ IMPLEMENTATION ____________________
+template <class T, Checking checking_src, Checking checking_kernel, Checking checking_dst>
+void apply_stencil(const Matrix<T, checking_src>& src, const Matrix<T, checking_kernel>& stencil,
+                   Matrix<T, checking_dst>& dst, Boundary boundary = Boundary::ZERO, std::size_t steps = 1) {
+    if (stencil.rows() % 2 == 0 || stencil.cols() % 2 == 0)
+        throw std::invalid_argument(stringify("Stencil dimensions should be odd, got ", stencil.rows(), "x",
+                                              stencil.cols(), "."));
+    // Kernel can alias 'dst' too, in which case it has to be preserved
+    const std::vector<T>           weights(stencil.data(), stencil.data() + stencil.size());
+    const _stencil_kernel<T, 0, 0> kernel{weights.data(), stencil.rows(), stencil.cols()};
+    _apply_stencil_to_matrix(src.data(), src.rows(), src.cols(), kernel, dst, boundary, steps);
+}
 
-namespace utl::profiler {
+// 2D convolution, same as applying a stencil with a flipped kernel
+template <class T, Checking checking_src, Checking checking_kernel, Checking checking_dst>
+void convolve(const Matrix<T, checking_src>& src, const Matrix<T, checking_kernel>& kernel,
+              Matrix<T, checking_dst>& dst, Boundary boundary = Boundary::ZERO) {
+    const Matrix<T> flipped(kernel.rows(), kernel.cols(), [&](std::size_t i, std::size_t j) {
+        return kernel(kernel.rows() - 1 - i, kernel.cols() - 1 - j);
+    });
+    apply_stencil(src, flipped, dst, boundary);
+}
 
-// ==========================
-// --- Profiler Internals ---
-// ==========================
+// ==================================
+// --- Reduced precision kernels ---
+// ==================================
 
-inline std::string _format_call_site(std::string_view file, int line, std::string_view func) {
-    const std::string_view filename = file.substr(file.find_last_of("/\\") + 1);
+// Kernels below take tensors of any element type and accumulate in a "widened" type: 16-bit floats get widened
+// to 'float' and 'int8' to 'int32', other types are accumulated as-is. Since conversions happen in registers
+// right after the load, memory traffic stays proportional to the storage type.
 
-    return (std::ostringstream() << filename << ":" << line << ", " << func << "()").str();
-}
+template <class T>
+struct _widened {
+    using type = T;
+};
 
-#if !defined(UTL_PROFILER_OPTION_USE_x86_INTRINSICS_FOR_FREQUENCY)
-using clock = std::chrono::steady_clock;
-#else
-struct clock {
-    using rep                   = unsigned long long int;
-    using period                = std::ratio<1, UTL_PROFILER_OPTION_USE_x86_INTRINSICS_FOR_FREQUENCY>;
-    using duration              = std::chrono::duration<rep, period>;
-    using time_point            = std::chrono::time_point<clock>;
-    static const bool is_steady = true;
+template <class Format>
+struct _widened<_reduced_float<Format>> {
+    using type = float;
+};
 
-    static time_point now() noexcept {
-        unsigned int low, high;
-        asm volatile("rdtsc" : "=a"(low), "=d"(high)); // GCC/clang asm intrinsic, MSVC uses __asm() with more overhead
-        return time_point(duration(static_cast<rep>(high) << 32 | low));
-    }
+template <>
+struct _widened<std::int8_t> {
+    using type = std::int32_t;
 };
-#endif
 
-using duration   = clock::duration;
-using time_point = clock::time_point;
+template <class T>
+using widened_t = typename _widened<T>::type;
 
-inline const time_point _program_entry_time_point = clock::now();
+template <class L, class R>
+using _widened_product_t = decltype(std::declval<widened_t<L>>() * std::declval<widened_t<R>>());
 
-struct _record {
-    const char* file;
-    int         line;
-    const char* func;
-    const char* label;
-    duration    accumulated_time;
-};
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] widened_t<value_type> widened_sum(const Tensor& tensor) {
+    widened_t<value_type> res = widened_t<value_type>();
+    tensor.for_each([&](const value_type& elem) { res += static_cast<widened_t<value_type>>(elem); });
+    return res;
+}
 
-inline void _utl_profiler_atexit(); // predeclaration, implementation has circular dependency with 'RecordManager'
+// y = A * x
+template <class Tensor, class T, _is_tensor_enable_if<Tensor> = true, _is_nonsparse_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type,
+          class acc_type   = _widened_product_t<value_type, T>>
+[[nodiscard]] std::vector<acc_type> widened_gemv(const Tensor& A, const std::vector<T>& x) {
+    if (A.cols() != x.size())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " matrix by a vector of ",
+                                              x.size(), " elements."));
+
+    std::vector<acc_type> x_widened(x.size());
+    for (std::size_t k = 0; k < x.size(); ++k) x_widened[k] = static_cast<acc_type>(static_cast<widened_t<T>>(x[k]));
+
+    std::vector<acc_type> y(A.rows());
+
+    _parallel_for(A.rows(), _min_grain(2 * A.cols()), [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) {
+            acc_type acc = acc_type();
+            for (std::size_t k = 0; k < A.cols(); ++k)
+                acc += static_cast<acc_type>(static_cast<widened_t<value_type>>(A(i, k))) * x_widened[k];
+            y[i] = acc;
+        }
+    });
 
-// =========================
-// --- Profiler Classess ---
-// =========================
+    return y;
+}
 
-class _record_manager {
-private:
-    _record data;
+// C = A * B, blocked the same way as regular matrix multiplication. Each thread widens blocks of 'B' rows
+// into a small buffer once and reuses them for all of its rows of 'A'.
+template <class L, class R, _is_tensor_enable_if<L> = true, _is_tensor_enable_if<R> = true,
+          _is_nonsparse_tensor_enable_if<L> = true, _is_nonsparse_tensor_enable_if<R> = true,
+          class value_type_l = typename std::decay_t<L>::value_type,
+          class value_type_r = typename std::decay_t<R>::value_type,
+          class acc_type     = _widened_product_t<value_type_l, value_type_r>>
+[[nodiscard]] Matrix<acc_type> widened_gemm(const L& A, const R& B) {
+    if (A.cols() != B.rows())
+        throw std::invalid_argument(stringify("Can't multiply ", A.rows(), "x", A.cols(), " and ", B.rows(), "x",
+                                              B.cols(), " matrices."));
 
-public:
-    inline static std::vector<_record> records;
-    inline static int                  exclusive_recursion{};
-    int                                recursion{};
+    constexpr std::size_t block_size_kk = 32;
 
-    void add_time(duration time) noexcept { this->data.accumulated_time += time; }
+    const std::size_t N_i = A.rows(), N_k = A.cols(), N_j = B.cols();
 
-    _record_manager() = delete;
+    Matrix<acc_type> C(N_i, N_j, acc_type());
 
-    _record_manager(const char* file, int line, const char* func, const char* label)
-        : data({file, line, func, label, duration(0)}) {
-        // 'file', 'func', 'label' are guaranteed to be string literals, since we want to
-        // have as little overhead as possible during runtime, we can just save raw pointers
-        // and convert them to nicer types like 'std::string_view' later in the formatting stage
+    _parallel_for(N_i, _min_grain(2 * N_k * N_j), [&](std::size_t low, std::size_t high) {
+        std::vector<acc_type> panel(block_size_kk * N_j);
 
-        // Profiler ever gets called => register result output at 'std::exit()'
-        static bool first_call = true;
-        if (first_call) {
-            std::atexit(_utl_profiler_atexit);
-            first_call = false;
-        }
-    }
+        for (std::size_t kk = 0; kk < N_k; kk += block_size_kk) {
+            const std::size_t k_extent = std::min(N_k, kk + block_size_kk);
 
-    ~_record_manager() { records.emplace_back(this->data); }
-};
+            for (std::size_t k = kk; k < k_extent; ++k)
+                for (std::size_t j = 0; j < N_j; ++j)
+                    panel[(k - kk) * N_j + j] = static_cast<acc_type>(static_cast<widened_t<value_type_r>>(B(k, j)));
 
-// We need 4 slightly different timer classes, so might as well deduplicate some code by moving it into a base class
-struct _timer_base {
-protected:
-    time_point       start;
-    _record_manager* record_manager;
-    // we could use 'std::optional<std::reference_wrapper<RecordManager>>',
-    // but that would inctroduce more dependencies for no real reason
-public:
-    constexpr operator bool() const noexcept { return true; }
+            for (std::size_t i = low; i < high; ++i) {
+                acc_type* c_row = C.data() + i * N_j;
+                for (std::size_t k = kk; k < k_extent; ++k) {
+                    const acc_type  a     = static_cast<acc_type>(static_cast<widened_t<value_type_l>>(A(i, k)));
+                    const acc_type* b_row = panel.data() + (k - kk) * N_j;
+                    for (std::size_t j = 0; j < N_j; ++j) c_row[j] += a * b_row[j];
+                }
+            }
+        }
+    });
 
-    _timer_base(_record_manager* manager) : record_manager(manager) {}
-};
+    return C;
+}
 
-// Simple class that records the time of its creation and destruction and records it into the connected 'RecordManager'
-struct _scope_timer : public _timer_base {
-    _scope_timer(_record_manager* manager) : _timer_base(manager) {
-        if (this->record_manager->recursion++ == 0) this->start = clock::now();
-        // this check prevent timer from double-counting time spent inside
-        // of it's own scope due to recursive calls
-    }
+// Symmetric per-matrix 'int8' quantization: 'value ~ scale * q' where 'q' is in '[-127, 127]'
+struct QuantizedMatrix {
+    Matrix<std::int8_t> values;
+    float               scale = 1.f;
 
-    ~_scope_timer() {
-        if (--this->record_manager->recursion == 0) this->record_manager->add_time(clock::now() - this->start);
+    [[nodiscard]] Matrix<float> dequantize() const {
+        return Matrix<float>(this->values.rows(), this->values.cols(), [&](std::size_t i, std::size_t j) {
+            return this->scale * static_cast<float>(this->values(i, j));
+        });
     }
 };
 
-// Same thing as '_scope_timer' except it uses global static 'exclusive_recursion' instead of regular 'recursion' that
-// is specific to each '_record_manager'. This effecively means no '_exclusive_scope_timer''s will count time as long a
-// single instance of another exclusive timer exists. This allows us to resolve som tricky situations such as recursion
-struct _exclusive_scope_timer : public _timer_base {
-    _exclusive_scope_timer(_record_manager* manager) : _timer_base(manager) {
-        if (this->record_manager->exclusive_recursion++ == 0) this->start = clock::now();
-    }
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] QuantizedMatrix quantize(const Tensor& tensor) {
+    float max_abs = 0.f;
+    tensor.for_each([&](const value_type& elem) { max_abs = std::max(max_abs, std::abs(static_cast<float>(elem))); });
 
-    ~_exclusive_scope_timer() {
-        if (--this->record_manager->exclusive_recursion == 0)
-            this->record_manager->add_time(clock::now() - this->start);
-    }
-};
+    QuantizedMatrix res;
+    res.scale  = (max_abs > 0.f) ? max_abs / 127.f : 1.f;
+    res.values = Matrix<std::int8_t>(tensor.rows(), tensor.cols(), std::int8_t(0));
 
-// Same thing as '_scope_timer', except instead of destructor it uses an explicitly called method to record time.
-// We need it to implement code-segment profiling with 'UTL_PROFILER_BEGIN' and 'UTL_PROFILER_END'
-struct _segment_timer : public _timer_base {
-    _segment_timer(_record_manager* manager) : _timer_base(manager) {
-        if (this->record_manager->recursion++ == 0) this->start = clock::now();
-    }
+    tensor.for_each([&](const value_type& elem, std::size_t i, std::size_t j) {
+        const float q    = std::clamp(std::round(static_cast<float>(elem) / res.scale), -127.f, 127.f);
+        res.values(i, j) = static_cast<std::int8_t>(q);
+    });
 
-    void finish() {
-        if (--this->record_manager->recursion == 0) this->record_manager->add_time(clock::now() - this->start);
-    }
-};
+    return res;
+}
 
-struct _exclusive_segment_timer : public _timer_base {
-    _exclusive_segment_timer(_record_manager* manager) : _timer_base(manager) {
-        if (this->record_manager->exclusive_recursion++ == 0) this->start = clock::now();
-    }
+// y = A * x with 'int8' matrix values widened to 'float' in registers
+template <class T>
+[[nodiscard]] std::vector<float> widened_gemv(const QuantizedMatrix& A, const std::vector<T>& x) {
+    const auto y = widened_gemv(A.values, x);
 
-    void finish() {
-        if (--this->record_manager->exclusive_recursion == 0)
-            this->record_manager->add_time(clock::now() - this->start);
-    }
-};
+    std::vector<float> res(y.size());
+    for (std::size_t i = 0; i < y.size(); ++i) res[i] = A.scale * static_cast<float>(y[i]);
+    return res;
+}
 
-// ==================================
-// --- Profiler Exit & Formatting ---
-// ==================================
+// ====================
+// --- Eigensolvers ---
+// ====================
 
-inline void _utl_profiler_atexit() {
-    // NOTE:
-    // Lots of ugly formatting stuff here, but it works, so a nicer rewrite is low-priority.
-    // Would make a lot more sense to format all the stuff into a `matrix` of strings first,
-    // and then do all the sorting/column width adjustment and etc. Should be faster (which
-    // doesn't really matter here) and more concise too.
+// Dense symmetric eigendecomposition follows the classic 2-stage approach:
+//    1. Householder reflections reduce 'A' to a tridiagonal 'T = Q^T A Q'. Reflection 'H = I - 2 v v^T' acts on the
+//       trailing submatrix as a symmetric rank-2 update 'A -= v w^T + w v^T' where 'w = 2 (p - (v^T p) v)' and
+//       'p = A v'. Reduction is blocked the same way as LAPACK 'sytrd()': reflectors of a panel of columns are
+//       computed with their updates kept aside as 'V' & 'W', the current column and 'p' get corrected on the fly,
+//       and the whole trailing submatrix is updated once per panel as 'A -= V W^T + W V^T'. This halves the number
+//       of passes over 'A' (one matrix-vector product per column + one update per panel instead of both for every
+//       column). Matrix-vector products and panel updates are split between threads by rows.
+//    2. Implicit QL with Wilkinson shifts diagonalizes 'T'. Each QL sweep is a chain of Givens rotations, which
+//       have to be computed sequentially, but their application to eigenvectors is independent for every row of
+//       the eigenvector matrix. Rotations of consecutive sweeps get recorded and then applied to all rows in one
+//       parallel pass once enough of them are accumulated, so threads aren't spawned for every single sweep.
+//
+// Sparse eigenvalues use the Lanczos method, which builds an orthonormal basis 'V' of a Krylov subspace together
+// with a tridiagonal projection 'T = V^T A V' using nothing but matrix-vector products. Extremal eigenvalues of
+// 'T' (Ritz values) converge to extremal eigenvalues of 'A' long before the subspace grows to the full size.
+// In finite precision Lanczos vectors lose orthogonality, which leads to spurious copies of eigenvalues. The
+// simplest robust fix is full reorthogonalization against the whole basis (done twice, "twice is enough"),
+// which costs 'O(n m)' per step but keeps the method reliable for a modest number of requested eigenpairs.
 
-    const auto total_runtime = clock::now() - _program_entry_time_point;
+template <class T>
+struct SymmetricEigen {
+    std::vector<T> values;
+    Matrix<T>      vectors; // column 'k' is an eigenvector corresponding to 'values[k]'
+};
 
-    std::ostream* os = &std::cout;
+enum class EigenTarget { LARGEST, SMALLEST, LARGEST_MAGNITUDE };
 
-    // Convenience functions
-    const auto duration_to_sec = [](duration duration) -> double {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1e9;
-    };
+constexpr std::size_t _tridiagonal_panel_size = 32;      // columns reduced before each trailing update
+constexpr std::size_t _ql_rotation_batch       = 1 << 14; // Givens rotations applied to eigenvectors at once
 
-    const auto duration_percentage = [&](double duration_sec) -> double {
-        const double total_runtime_sec = duration_to_sec(total_runtime);
-        return (duration_sec / total_runtime_sec) * 100.;
+// Diagonalizes symmetric tridiagonal matrix with diagonal 'd' and sub-diagonal 'e' ('e[i]' couples 'i' and 'i + 1')
+// by implicit QL, rotations get accumulated into the columns of 'Z'. 'd' is overwritten by eigenvalues.
+template <class T>
+void _tridiagonal_ql(std::vector<T>& d, std::vector<T>& e, Matrix<T>& Z) {
+    constexpr std::size_t max_iterations = 60;
+
+    const std::size_t n = d.size();
+    if (n == 0) return;
+    e.resize(n);
+    e[n - 1] = T(0);
+
+    // Off-diagonal elements get neglected relative to the norm of 'T', which keeps the result backward stable
+    // even for (nearly) zero eigenvalues where a purely local criterion would never be satisfied
+    T norm = T(0);
+    for (std::size_t i = 0; i < n; ++i) norm = std::max(norm, std::abs(d[i]) + std::abs(e[i]));
+    const T negligible = std::numeric_limits<T>::epsilon() * norm;
+
+    // Rotations are only needed for the eigenvectors, which makes it possible to record several sweeps and apply
+    // them together, rows of 'Z' stay in cache while the whole batch gets applied to them
+    const std::size_t                                batch_size = std::max<std::size_t>(n, _ql_rotation_batch);
+    std::vector<std::pair<T, T>>                     rotations; // (c, s) in order of application
+    std::vector<std::pair<std::size_t, std::size_t>> sweeps;    // (first column, rotation count)
+    rotations.reserve(batch_size + n);
+
+    // Rotation 'r' of a sweep acts on columns 'first - r' and 'first - r + 1', the new value of column 'first - r'
+    // is carried to the next rotation in a register. Every rotation depends on the previous one, so several rows
+    // get processed at once to have independent operations to overlap.
+    const auto apply_rotations_to_rows = [&](auto row_count, std::size_t k) {
+        constexpr std::size_t rows = decltype(row_count)::value;
+
+        std::array<T*, rows> row;
+        for (std::size_t q = 0; q < rows; ++q) row[q] = Z.data() + (k + q) * Z.cols();
+
+        const std::pair<T, T>* rotation = rotations.data();
+        for (const auto& [first, count] : sweeps) {
+            std::array<T, rows> f;
+            for (std::size_t q = 0; q < rows; ++q) f[q] = row[q][first + 1];
+            for (std::size_t r = 0; r < count; ++r, ++rotation) {
+                const auto [c, s] = *rotation;
+                for (std::size_t q = 0; q < rows; ++q) {
+                    const T g             = row[q][first - r];
+                    row[q][first - r + 1] = s * g + c * f[q];
+                    f[q]                  = c * g - s * f[q];
+                }
+            }
+            for (std::size_t q = 0; q < rows; ++q) row[q][first - count + 1] = f[q];
+        }
     };
 
-    const auto float_printed_size = [](double value, std::streamsize precision, decltype(std::fixed) format,
-                                       std::string_view postfix) -> std::streamsize {
-        std::ostringstream ss;
-        ss << std::setprecision(precision) << format << value << postfix;
-        return ss.str().size(); // can be done faster but we don't really care here
+    const auto apply_rotations = [&] {
+        _parallel_for(Z.rows(), _min_grain(6 * rotations.size()), [&](std::size_t low, std::size_t high) {
+            std::size_t k = low;
+            for (; k + 4 <= high; k += 4) apply_rotations_to_rows(std::integral_constant<std::size_t, 4>{}, k);
+            for (; k < high; ++k) apply_rotations_to_rows(std::integral_constant<std::size_t, 1>{}, k);
+        });
+        rotations.clear();
+        sweeps.clear();
     };
 
-    const auto repeat_hline_symbol = [](std::streamsize repeats) -> std::string {
-        return std::string(static_cast<size_t>(repeats), '-');
-    };
+    for (std::size_t l = 0; l < n; ++l) {
+        for (std::size_t iteration = 0;; ++iteration) {
+            std::size_t m = l;
+            for (; m + 1 < n; ++m) {
+                if (std::abs(e[m]) <= negligible) break;
+            }
+            if (m == l) break;
+
+            if (iteration == max_iterations)
+                throw std::runtime_error("Symmetric tridiagonal QL failed to converge.");
+
+            // Wilkinson shift
+            T g = (d[l + 1] - d[l]) / (T(2) * e[l]);
+            T r = std::hypot(g, T(1));
+            g   = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+
+            T    s = T(1), c = T(1), p = T(0);
+            bool deflated = false;
+
+            const std::size_t rotations_before = rotations.size();
+            for (std::size_t i = m; i-- > l;) {
+                const T f = s * e[i];
+                const T b = c * e[i];
+                r         = std::hypot(f, g);
+                e[i + 1]  = r;
+                if (r == T(0)) { // underflow, deflate and restart
+                    d[i + 1] -= p;
+                    e[m]     = T(0);
+                    deflated = true;
+                    break;
+                }
+                s        = f / r;
+                c        = g / r;
+                g        = d[i + 1] - p;
+                r        = (d[i] - g) * s + T(2) * c * b;
+                p        = s * r;
+                d[i + 1] = g + p;
+                g        = c * r - b;
+                rotations.emplace_back(c, s);
+            }
+            sweeps.emplace_back(m - 1, rotations.size() - rotations_before);
+            if (rotations.size() >= batch_size) apply_rotations();
 
-    constexpr std::streamsize  duration_precision = 2;
-    constexpr auto             duration_format    = std::fixed;
-    constexpr std::string_view duration_postfix   = " s";
+            if (deflated) continue;
+            d[l] -= p;
+            e[l] = g;
+            e[m] = T(0);
+        }
+    }
+    apply_rotations();
+}
 
-    constexpr std::streamsize  percentage_precision = 1;
-    constexpr auto             percentage_format    = std::fixed;
-    constexpr std::string_view percentage_postfix   = "%";
+// Sorts eigenpairs in ascending order of eigenvalues
+template <class T>
+[[nodiscard]] SymmetricEigen<T> _sorted_eigenpairs(const std::vector<T>& values, const Matrix<T>& vectors) {
+    std::vector<std::size_t> order(values.size());
+    for (std::size_t k = 0; k < order.size(); ++k) order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+
+    SymmetricEigen<T> res;
+    res.values.resize(values.size());
+    res.vectors = Matrix<T>(vectors.rows(), values.size());
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        res.values[k] = values[order[k]];
+        for (std::size_t i = 0; i < vectors.rows(); ++i) res.vectors(i, k) = vectors(i, order[k]);
+    }
+    return res;
+}
 
-    // Sort records by their accumulated time
-    std::sort(_record_manager::records.begin(), _record_manager::records.end(),
-              [](const _record& l, const _record& r) { return l.accumulated_time > r.accumulated_time; });
+// Full eigendecomposition of a dense symmetric matrix, eigenvalues are sorted in ascending order
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] SymmetricEigen<value_type> symmetric_eigen(const Tensor& tensor) {
+    static_assert(std::is_floating_point_v<value_type>, "Eigensolver requires a floating point type.");
+    using T = value_type;
 
-    // Collect max length of each column (for proper formatting)
-    constexpr std::string_view column_name_call_site  = "Call Site";
-    constexpr std::string_view column_name_label      = "Label";
-    constexpr std::string_view column_name_duration   = "Time";
-    constexpr std::string_view column_name_percentage = "Time %";
+    if (tensor.rows() != tensor.cols())
+        throw std::invalid_argument(stringify("Can't compute eigendecomposition of a non-square ", tensor.rows(), "x",
+                                              tensor.cols(), " matrix."));
 
-    std::streamsize max_length_call_site  = column_name_call_site.size();
-    std::streamsize max_length_label      = column_name_label.size();
-    std::streamsize max_length_duration   = column_name_duration.size();
-    std::streamsize max_length_percentage = column_name_percentage.size();
+    const std::size_t n = tensor.rows();
 
-    for (const auto& record : _record_manager::records) {
-        const std::string call_site    = _format_call_site(record.file, record.line, record.func);
-        const std::string label        = record.label;
-        const double      duration_sec = duration_to_sec(record.accumulated_time);
+    Matrix<T> A(n, n, T(0));
+    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { A(i, j) = elem; });
 
-        // 'Call Site' column
-        const std::streamsize length_call_site = call_site.size();
-        if (max_length_call_site < length_call_site) max_length_call_site = length_call_site;
+    // 1. Blocked Householder tridiagonalization, reflector 'k' is stored in 'reflectors[k]' (acting on rows 'k + 1...')
+    std::vector<std::vector<T>> reflectors(n > 2 ? n - 2 : 0);
+    std::vector<T>              d(n), e(n), x(n), p(n);
 
-        // 'Label' column
-        const std::streamsize length_label = label.size();
-        if (max_length_label < length_label) max_length_label = length_label;
+    for (std::size_t panel = 0; panel + 2 < n; panel += _tridiagonal_panel_size) {
+        const std::size_t panel_end = std::min(panel + _tridiagonal_panel_size, n - 2);
 
-        // 'Time' column
-        const std::streamsize length_duration =
-            float_printed_size(duration_sec, duration_precision, duration_format, duration_postfix);
-        if (max_length_duration < length_duration) max_length_duration = length_duration;
+        // Reflectors & their 'w' vectors of the current panel, padded with zeros to the full length 'n'.
+        // 'A' doesn't include their updates yet, the current matrix is 'A - V W^T - W V^T'.
+        std::vector<std::vector<T>> V, W;
 
-        // 'Time %' column
-        const auto            percentage = duration_percentage(duration_sec);
-        const std::streamsize length_percentage =
-            float_printed_size(percentage, percentage_precision, percentage_format, percentage_postfix);
-        if (max_length_percentage < length_percentage) max_length_percentage = length_percentage;
-    }
+        for (std::size_t k = panel; k < panel_end; ++k) {
+            const std::size_t size = n - k - 1;
 
-    // Print formatted profiler header
-    constexpr std::string_view HEADER_TEXT = " UTL PROFILING RESULTS ";
+            // Column 'k' of the current matrix
+            d[k] = A(k, k);
+            for (std::size_t r = k + 1; r < n; ++r) x[r] = A(r, k);
+            for (std::size_t j = 0; j < V.size(); ++j) {
+                const T v_k = V[j][k], w_k = W[j][k];
+                d[k] -= T(2) * v_k * w_k;
+                for (std::size_t r = k + 1; r < n; ++r) x[r] -= V[j][r] * w_k + W[j][r] * v_k;
+            }
 
-    const std::streamsize total_table_length = sizeof("| ") - 1 + max_length_call_site + sizeof(" | ") - 1 +
-                                               max_length_label + sizeof(" | ") - 1 + max_length_duration +
-                                               sizeof(" | ") - 1 + max_length_percentage + sizeof(" |") -
-                                               1; // -1 because sizeof(char[]) accounts for invisible '\0' at the end
+            T norm = T(0);
+            for (std::size_t r = k + 1; r < n; ++r) norm += x[r] * x[r];
+            norm = std::sqrt(norm);
 
-    const std::streamsize header_text_length = HEADER_TEXT.size();
-    const std::streamsize header_left_pad    = (total_table_length - header_text_length) / 2;
-    const std::streamsize header_right_pad   = total_table_length - header_text_length - header_left_pad;
+            const T alpha = (x[k + 1] > T(0)) ? -norm : norm;
+            e[k]          = alpha;
 
-    *os << "\n"
-        << repeat_hline_symbol(header_left_pad + 1) << HEADER_TEXT << repeat_hline_symbol(header_right_pad + 1)
-        << '\n'
-        // + 1 makes header hline extend 1 character past the table on both sides
-        << "\n"
-        << " Total runtime -> " << std::setprecision(duration_precision) << duration_format
-        << duration_to_sec(total_runtime) << " sec\n"
-        << "\n";
+            std::vector<T> v(n, T(0));
+            for (std::size_t r = k + 1; r < n; ++r) v[r] = x[r];
+            v[k + 1] -= alpha;
 
-    // Print formatted table header
-    *os << " | " << std::setw(max_length_call_site) << column_name_call_site << " | " << std::setw(max_length_label)
-        << column_name_label << " | " << std::setw(max_length_duration) << column_name_duration << " | "
-        << std::setw(max_length_percentage) << column_name_percentage << " |\n";
+            T v_norm = T(0);
+            for (const auto& elem : v) v_norm += elem * elem;
+            v_norm = std::sqrt(v_norm);
 
-    *os << " |"
-        << repeat_hline_symbol(max_length_call_site + 2) // add 2 to account for delimers not having spaces in hline
-        << "|" << repeat_hline_symbol(max_length_label + 2) << "|" << repeat_hline_symbol(max_length_duration + 2)
-        << "|" << repeat_hline_symbol(max_length_percentage + 2) << "|\n";
+            if (v_norm == T(0)) { // column is already reduced
+                reflectors[k].assign(size, T(0));
+                continue;
+            }
+            for (auto& elem : v) elem /= v_norm;
 
-    *os << std::setfill(' '); // reset the fill so we don't mess with table contents
+            // p = A_sub * v, corrected by the pending updates of the panel
+            _parallel_for(size, _min_grain(2 * size), [&](std::size_t low, std::size_t high) {
+                for (std::size_t r = low; r < high; ++r)
+                    p[k + 1 + r] = _strided_dot(&A(k + 1 + r, k + 1), 1, v.data() + k + 1, size);
+            });
+            for (std::size_t j = 0; j < V.size(); ++j) {
+                const T wv = _strided_dot(W[j].data() + k + 1, 1, v.data() + k + 1, size);
+                const T vv = _strided_dot(V[j].data() + k + 1, 1, v.data() + k + 1, size);
+                for (std::size_t r = k + 1; r < n; ++r) p[r] -= V[j][r] * wv + W[j][r] * vv;
+            }
 
+            // w = 2 (p - (v^T p) v)
+            const T        vp = _strided_dot(v.data() + k + 1, 1, p.data() + k + 1, size);
+            std::vector<T> w(n, T(0));
+            for (std::size_t r = k + 1; r < n; ++r) w[r] = T(2) * (p[r] - vp * v[r]);
 
-    // Print formatted table contents
-    for (const auto& record : _record_manager::records) {
-        const std::string call_site    = _format_call_site(record.file, record.line, record.func);
-        const std::string label        = record.label;
-        const double      duration_sec = duration_to_sec(record.accumulated_time);
-        const double      percentage   = duration_percentage(duration_sec);
+            reflectors[k].assign(v.begin() + k + 1, v.end());
+            V.push_back(std::move(v));
+            W.push_back(std::move(w));
+        }
 
-        // Join floats with their postfixes into a single string so they are properly handled by std::setw()
-        // (which only affects the first value leading to a table misaligned by postfix size)
-        std::ostringstream ss_duration;
-        ss_duration << std::setprecision(duration_precision) << duration_format << duration_sec << duration_postfix;
+        // A_sub -= V W^T + W V^T, a single pass over the trailing submatrix for the whole panel
+        const std::size_t size = n - panel_end;
+        _parallel_for(size, _min_grain(4 * size * V.size()), [&](std::size_t low, std::size_t high) {
+            for (std::size_t r = low; r < high; ++r) {
+                T* row = &A(panel_end + r, panel_end);
+                for (std::size_t j = 0; j < V.size(); ++j) {
+                    const T  v_r = V[j][panel_end + r], w_r = W[j][panel_end + r];
+                    const T* v_j = V[j].data() + panel_end;
+                    const T* w_j = W[j].data() + panel_end;
+                    for (std::size_t c = 0; c < size; ++c) row[c] -= v_r * w_j[c] + w_r * v_j[c];
+                }
+            }
+        });
+    }
 
-        std::ostringstream ss_percentage;
-        ss_percentage << std::setprecision(percentage_precision) << percentage_format << percentage
-                      << percentage_postfix;
+    // Last 2x2 block is left as is by the reduction
+    if (n >= 1) d[n - 1] = A(n - 1, n - 1);
+    if (n >= 2) d[n - 2] = A(n - 2, n - 2), e[n - 2] = A(n - 1, n - 2);
 
-        *os << " | " << std::setw(max_length_call_site) << call_site << " | " << std::setw(max_length_label) << label
-            << " | " << std::setw(max_length_duration) << ss_duration.str() << " | " << std::setw(max_length_percentage)
-            << ss_percentage.str() << " |\n";
+    // Q = H_0 H_1 ... H_{n-3}, accumulated backwards so that each reflector only touches the trailing rows
+    Matrix<T> Z(n, n, T(0));
+    for (std::size_t i = 0; i < n; ++i) Z(i, i) = T(1);
+
+    for (std::size_t k = reflectors.size(); k-- > 0;) {
+        const auto&       v    = reflectors[k];
+        const std::size_t size = v.size();
+
+        _parallel_for(n, _min_grain(4 * size), [&](std::size_t low, std::size_t high) {
+            std::vector<T> t(high - low, T(0)); // t = v^T Z_sub for columns '[low, high)'
+            for (std::size_t r = 0; r < size; ++r) {
+                const T* row = &Z(k + 1 + r, low);
+                for (std::size_t c = 0; c < high - low; ++c) t[c] += v[r] * row[c];
+            }
+            for (std::size_t r = 0; r < size; ++r) {
+                T*      row = &Z(k + 1 + r, low);
+                const T v_r = T(2) * v[r];
+                for (std::size_t c = 0; c < high - low; ++c) row[c] -= v_r * t[c];
+            }
+        });
     }
+
+    // 2. Implicit QL on the tridiagonal matrix, rotations get accumulated into 'Q'
+    _tridiagonal_ql(d, e, Z);
+
+    return _sorted_eigenpairs(d, Z);
 }
 
-// ========================
-// --- Profiler Codegen ---
-// ========================
+// Dot products of 'w' with every vector of the 'basis', summed over fixed-size blocks of elements so that
+// the result doesn't depend on the number of threads
+template <class T>
+void _project_onto_basis(const std::vector<std::vector<T>>& basis, const std::vector<T>& w, std::vector<T>& h) {
+    constexpr std::size_t block_size = 4096;
 
-#define _utl_profiler_concat_tokens(a, b) a##b
-#define _utl_profiler_concat_tokens_wrapper(a, b) _utl_profiler_concat_tokens(a, b)
-#define _utl_profiler_add_uuid(varname_) _utl_profiler_concat_tokens_wrapper(varname_, __LINE__)
-// This macro creates token 'varname_##__LINE__' from 'varname_'.
-//
-// The reason we can't just write it as is, is that function-macros only expands their macro-arguments
-// if neither the stringizing operator # nor the token-pasting operator ## are applied to the arguments
-// inside the macro body.
-//
-// Which means in a simple 'varname_##__LINE__' macro '__LINE__' doesn't expand to it's value.
-//
-// We can get around this fact by introducing indirection,
-// '__LINE__' gets expanded in '_utl_profiler_concat_tokens_wrapper()'
-// and then tokenized and concatenated in '_utl_profiler_concat_tokens()'
+    const std::size_t n      = w.size();
+    const std::size_t m      = basis.size();
+    const std::size_t blocks = (n + block_size - 1) / block_size;
 
-// --- Scope profiling ---
-// -----------------------
+    std::vector<T> partial(blocks * m, T(0));
 
-#define UTL_PROFILER(label_)                                                                                           \
-    constexpr bool _utl_profiler_add_uuid(utl_profiler_macro_guard_) = true;                                           \
-                                                                                                                       \
-    static_assert(_utl_profiler_add_uuid(utl_profiler_macro_guard_), "UTL_PROFILE is a multi-line macro.");            \
-                                                                                                                       \
-    static utl::profiler::_record_manager _utl_profiler_add_uuid(utl_profiler_record_manager_)(__FILE__, __LINE__,     \
-                                                                                               __func__, label_);      \
-                                                                                                                       \
-    if constexpr (const utl::profiler::_scope_timer _utl_profiler_add_uuid(utl_profiler_scope_timer_){                 \
-                      &_utl_profiler_add_uuid(utl_profiler_record_manager_)})
-// Note 1:
-//
-//    constexpr bool ... = true;
-//    static_assert(..., "UTL_PROFILE is a multi-line macro.");
-//
-// is reponsible for preventing accidental errors caused by using macro like this:
-//
-//    for (...) UTL_PROFILER("") function(); // will only loop the first line of the multi-line macro
-//
-// If someone tries to write it like this, the constexpr bool variable will be "pulled" into a narrower scope,
-// causing 'static_assert()' to fail due to using undeclared identifier. Since the line with undeclared identifier
-// gets expanded, the user will be able to see the assert message.
-//
-// Note 2:
-//
-// By separating "record management" into a static variable and "actual timing" into a non-static one,
-// we can avoid additional overhead from having to locate the record, corresponding to the profiled source location.
-// (an operation that requires a non-trivial vector/map lookup with string comparisons)
-//
-// Static variable initializes its record once and timer does the bare minimum of work - 2 calls to 'now()' to get
-// timing, one addition to accumulated time and a check for recursion (so it can skip time appropriately).
-//
-//  Note 3:
-//
-// _utl_profiler_add_uuid(...) ensures no identifier collisions when several profilers exist in a single scope.
-// Since in this context 'uuid' is a line number, the only case in which ids can collide is when multiple profilers
-// are declated on the same line, which I assume no sane person would do. And even if they would, that would simply
-// lead to a compiler error. Can't really do better than that without resorting to non-standard macros like
-// '__COUNTER__' for 'uuid' creation
+    _parallel_for(blocks, _min_grain(2 * block_size * m), [&](std::size_t low, std::size_t high) {
+        for (std::size_t b = low; b < high; ++b) {
+            const std::size_t first = b * block_size, last = std::min(first + block_size, n);
+            for (std::size_t j = 0; j < m; ++j)
+                partial[b * m + j] = _strided_dot(basis[j].data() + first, 1, w.data() + first, last - first);
+        }
+    });
 
-#define UTL_PROFILER_EXCLUSIVE(label_)                                                                                 \
-    constexpr bool _utl_profiler_add_uuid(utl_profiler_macro_guard_) = true;                                           \
-                                                                                                                       \
-    static_assert(_utl_profiler_add_uuid(utl_profiler_macro_guard_), "UTL_PROFILER_EXCLUSIVE is a multi-line macro."); \
-                                                                                                                       \
-    static utl::profiler::_record_manager _utl_profiler_add_uuid(utl_profiler_record_manager_)(__FILE__, __LINE__,     \
-                                                                                               __func__, label_);      \
-                                                                                                                       \
-    if constexpr (const utl::profiler::_exclusive_scope_timer _utl_profiler_add_uuid(utl_profiler_scope_timer_){       \
-                      &_utl_profiler_add_uuid(utl_profiler_record_manager_)})
-// Note:
-//
-// Exact same thing as a regular UTL_PROFILER() but uses '_exclusive_scope_timer' instead.
-// The reason we need this for recursion is nicely explained in the docs.
+    h.assign(m, T(0));
+    for (std::size_t b = 0; b < blocks; ++b)
+        for (std::size_t j = 0; j < m; ++j) h[j] += partial[b * m + j];
+}
 
-// --- Segment profiling ---
-// -------------------------
+// w -= V h
+template <class T>
+void _subtract_basis_combination(const std::vector<std::vector<T>>& basis, const std::vector<T>& h,
+                                 std::vector<T>& w) {
+    _parallel_for(w.size(), _min_grain(2 * basis.size()), [&](std::size_t low, std::size_t high) {
+        for (std::size_t j = 0; j < basis.size(); ++j) {
+            const T* v = basis[j].data();
+            for (std::size_t i = low; i < high; ++i) w[i] -= h[j] * v[i];
+        }
+    });
+}
 
-#define UTL_PROFILER_BEGIN(segment_label_, label_)                                                                     \
-    static utl::profiler::_record_manager utl_profiler_record_manager_##segment_label_(__FILE__, __LINE__, __func__,   \
-                                                                                       label_);                        \
-    utl::profiler::_segment_timer         utl_profiler_segment_timer_##segment_label_(                                 \
-        &utl_profiler_record_manager_##segment_label_)
+// Finds 'count' extremal eigenpairs of a symmetric 'n x n' operator given by 'matvec(x, y)' which computes 'y = A x'.
+// Eigenpairs are ordered from the most extremal one. Throws if eigenpairs don't converge with Krylov subspace of
+// 'max_dimension' vectors ('0' selects a default dimension).
+template <class T, class MatVec>
+[[nodiscard]] SymmetricEigen<T> lanczos(std::size_t n, MatVec&& matvec, std::size_t count,
+                                        EigenTarget target = EigenTarget::LARGEST, T tolerance = T(1e-10),
+                                        std::size_t max_dimension = 0) {
+    static_assert(std::is_floating_point_v<T>, "Eigensolver requires a floating point type.");
+
+    if (count == 0 || count > n)
+        throw std::invalid_argument(stringify("Can't find ", count, " eigenpairs of a ", n, "x", n, " operator."));
+
+    if (max_dimension == 0) max_dimension = std::max<std::size_t>(16 * count, 128);
+    max_dimension = std::clamp<std::size_t>(max_dimension, count, n);
+
+    // Deterministic pseudo-random starting vectors, any vector with non-zero projections onto the wanted
+    // eigenvectors works, a "random" one is unlikely to be orthogonal to any of them
+    std::uint64_t state       = 0x9E3779B97F4A7C15u;
+    const auto    next_random = [&]() {
+        state += 0x9E3779B97F4A7C15u;
+        std::uint64_t z = state;
+        z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+        z               = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+        return T(z >> 11) * T(0x1.0p-53) - T(0.5);
+    };
 
-#define UTL_PROFILER_END(segment_label_) utl_profiler_segment_timer_##segment_label_.finish()
-// Note 1:
-//
-// Last semicolon is intentiomally skipped so macro requires it at the end and
-// doesn't mess up auto code formatters that have a dislike for statement macros.
-//
-// Note 2:
-//
-// The idea here exactly the same as with scope profiles, except instead of '_scope_timer' we use '_segment_timer'
-// that records time on a '.finish()' call instead of destructor. We can put this call inside the END macro
-// and have a nice 2-macro API for profiling segments without creating a scope.
+    std::vector<std::vector<T>> basis;
+    std::vector<T>              alpha, beta; // diagonal & sub-diagonal of the projection
+    std::vector<T>              w(n), h, h_pass;
+
+    // Orthogonalizes 'v' against the basis and returns its remaining norm, 'h' accumulates the projections
+    const auto orthogonalize = [&](std::vector<T>& v) -> T {
+        h.assign(basis.size(), T(0));
+        for (int pass = 0; pass < 2; ++pass) {
+            _project_onto_basis(basis, v, h_pass);
+            _subtract_basis_combination(basis, h_pass, v);
+            for (std::size_t j = 0; j < h.size(); ++j) h[j] += h_pass[j];
+        }
+        T norm = T(0);
+        for (const auto& e : v) norm += e * e;
+        return std::sqrt(norm);
+    };
 
-#define UTL_PROFILER_EXCLUSIVE_BEGIN(segment_label_, label_)                                                           \
-    static utl::profiler::_record_manager   utl_profiler_record_manager_##segment_label_(__FILE__, __LINE__, __func__, \
-                                                                                         label_);                      \
-    utl::profiler::_exclusive_segment_timer utl_profiler_segment_timer_##segment_label_(                               \
-        &utl_profiler_record_manager_##segment_label_)
+    const auto restart_vector = [&]() {
+        std::vector<T> v(n);
+        for (auto& e : v) e = next_random();
+        T norm = orthogonalize(v);
+        if (norm == T(0)) throw std::runtime_error("Lanczos failed to generate a new basis vector.");
+        for (auto& e : v) e /= norm;
+        return v;
+    };
 
-#define UTL_PROFILER_EXCLUSIVE_END(segment_label_) utl_profiler_segment_timer_##segment_label_.finish()
+    basis.reserve(max_dimension);
+    basis.push_back(restart_vector());
+
+    std::vector<T>           ritz_values;
+    Matrix<T>                ritz_vectors;
+    std::vector<std::size_t> selection;
+    T                        scale = T(0);
+
+    const auto compute_ritz_pairs = [&]() {
+        const std::size_t m = alpha.size();
+        ritz_values         = alpha;
+        std::vector<T> e(beta.begin(), beta.begin() + (m - 1));
+        ritz_vectors = Matrix<T>(m, m, T(0));
+        for (std::size_t i = 0; i < m; ++i) ritz_vectors(i, i) = T(1);
+        _tridiagonal_ql(ritz_values, e, ritz_vectors);
+
+        selection.resize(m);
+        for (std::size_t k = 0; k < m; ++k) selection[k] = k;
+        std::stable_sort(selection.begin(), selection.end(), [&](std::size_t a, std::size_t b) {
+            if (target == EigenTarget::LARGEST) return ritz_values[a] > ritz_values[b];
+            if (target == EigenTarget::SMALLEST) return ritz_values[a] < ritz_values[b];
+            return std::abs(ritz_values[a]) > std::abs(ritz_values[b]);
+        });
 
-} // namespace utl::profiler
+        for (const auto& value : ritz_values) scale = std::max(scale, std::abs(value));
+    };
 
-#endif
-#endif // macro-module UTL_PROFILER
+    // Residual of a Ritz pair 'k' is '|beta_m * (last component of the k-th eigenvector of T)|'
+    const auto converged = [&](T last_beta) {
+        if (alpha.size() < count) return false;
+        for (std::size_t k = 0; k < count; ++k) {
+            const T residual = std::abs(last_beta * ritz_vectors(alpha.size() - 1, selection[k]));
+            if (residual > tolerance * std::max(scale, T(1))) return false;
+        }
+        return true;
+    };
 
+    for (;;) {
+        const std::size_t j = basis.size() - 1;
 
+        std::fill(w.begin(), w.end(), T(0));
+        matvec(basis[j], w);
 
+        // Full reorthogonalization, projection onto the last vector is the diagonal element
+        T norm = orthogonalize(w);
+        alpha.push_back(h[j]);
 
+        const bool basis_is_full = (basis.size() == max_dimension);
+        const bool check = basis_is_full || norm <= tolerance * std::max(scale, T(1)) ||
+                           (alpha.size() >= count && alpha.size() % 8 == 0);
 
+        if (check) {
+            compute_ritz_pairs();
+            // Invariant subspace was found, Ritz pairs are exact
+            if (norm <= std::numeric_limits<T>::epsilon() * std::max(scale, T(1)) * T(n)) norm = T(0);
+            if (converged(norm)) break;
+            if (basis_is_full)
+                throw std::runtime_error(stringify("Lanczos failed to converge ", count, " eigenpairs with ",
+                                                   max_dimension, " basis vectors."));
+        }
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::progressbar
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_progressbar.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PROGRESSBAR)
-#ifndef UTLHEADERGUARD_PROGRESSBAR
-#define UTLHEADERGUARD_PROGRESSBAR
-
-// _______________________ INCLUDES _______________________
-
-#include <algorithm> // fill_n
-#include <chrono>    // chrono::steady_clock, chrono::time_point<>, chrono::duration_cast<>, chrono::seconds
-#include <cmath>     // floor()
-#include <cstddef>   // size_t
-#include <iomanip>   // setprecision()
-#include <ios>       // fixed
-#include <iostream>  // cout
-#include <iterator>  // ostreambuf_iterator<>
-#include <ostream>   // ostream
-#include <sstream>   // ostringstream
-#include <string>    // string
-
-// ____________________ DEVELOPER DOCS ____________________
+        beta.push_back(norm);
+        if (norm == T(0)) basis.push_back(restart_vector()); // decoupled block of 'T'
+        else {
+            for (auto& e : w) e /= norm;
+            basis.push_back(w);
+        }
+    }
 
-// Simple progress bars for terminal applications. Rendered in ASCII on the main thread with manual updates
-// for maximal compatibility. Perhaps can be extended with some fancier async options that display animations.
-//
-// # ::set_ostream() #
-// Sets ostream used for progress bars.
-//
-// # ::Percentage #
-// Proper progress bar, uses carriage return escape sequence (\r) to render new states in the same spot.
-// Shows an estimate of remaining time.
-//
-// # ::Ruler #
-// Primitive & lightweight progress bar, useful when terminal has no proper support for escape sequences.
+    // Eigenvectors are 'V s_k' for the selected Ritz vectors 's_k'
+    SymmetricEigen<T> res;
+    res.values.resize(count);
+    res.vectors = Matrix<T>(n, count, T(0));
 
-// ____________________ IMPLEMENTATION ____________________
+    for (std::size_t k = 0; k < count; ++k) {
+        res.values[k] = ritz_values[selection[k]];
+        for (std::size_t j = 0; j < alpha.size(); ++j) {
+            const T coef = ritz_vectors(j, selection[k]);
+            for (std::size_t i = 0; i < n; ++i) res.vectors(i, k) += coef * basis[j][i];
+        }
+    }
 
-namespace utl::progressbar {
+    return res;
+}
 
-inline std::ostream* _output_stream = &std::cout;
+// Lanczos for any 2D tensor (usually a 'SparseMatrix'), matrix-vector product goes over its stored elements
+template <class Tensor, _is_tensor_enable_if<Tensor> = true,
+          class value_type = typename std::decay_t<Tensor>::value_type>
+[[nodiscard]] SymmetricEigen<value_type> lanczos(const Tensor& A, std::size_t count,
+                                                 EigenTarget target = EigenTarget::LARGEST,
+                                                 value_type tolerance = value_type(1e-10),
+                                                 std::size_t max_dimension = 0) {
+    if (A.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't compute eigenpairs of a non-square ", A.rows(), "x", A.cols(),
+                                              " matrix."));
+
+    const auto matvec = [&](const std::vector<value_type>& x, std::vector<value_type>& y) {
+        if constexpr (std::decay_t<Tensor>::params::type == Type::SPARSE)
+            A.for_each([&](const value_type& elem, std::size_t i, std::size_t j) { y[i] += elem * x[j]; });
+        else gemv(value_type(1), A, x, value_type(0), y);
+    };
 
-inline void set_ostream(std::ostream& new_ostream) { _output_stream = &new_ostream; }
+    return lanczos<value_type>(A.rows(), matvec, count, target, tolerance, max_dimension);
+}
 
-class Percentage {
-private:
-    char done_char;
-    char not_done_char;
-    bool show_time_estimate;
+template <class T, std::size_t block_size>
+[[nodiscard]] SymmetricEigen<T> lanczos(const BSRMatrix<T, block_size>& A, std::size_t count,
+                                        EigenTarget target = EigenTarget::LARGEST, T tolerance = T(1e-10),
+                                        std::size_t max_dimension = 0) {
+    if (A.rows() != A.cols())
+        throw std::invalid_argument(stringify("Can't compute eigenpairs of a non-square ", A.rows(), "x", A.cols(),
+                                              " matrix."));
 
-    std::size_t length_total;   // full   bar length
-    std::size_t length_current; // filled bar length
+    const auto matvec = [&](const std::vector<T>& x, std::vector<T>& y) { spmv(A, x, y); };
+    return lanczos<T>(A.rows(), matvec, count, target, tolerance, max_dimension);
+}
 
-    double last_update_percentage;
-    double update_rate;
+// Clear out internal macros
+#undef utl_mvl_tensor_arg_defs
+#undef utl_mvl_tensor_arg_vals
+#undef utl_mvl_require
+#undef utl_mvl_reqs
 
-    using Clock     = std::chrono::steady_clock;
-    using TimePoint = std::chrono::time_point<Clock>;
+} // namespace utl::mvl
 
-    TimePoint timepoint_start; // used to estimate remaining time
-    TimePoint timepoint_current;
+#endif
+#endif // module utl::mvl
 
-    int previous_string_length; // used to properly return the carriage when dealing with changed string size
 
-    void draw_progressbar(double percentage) {
-        const auto displayed_percentage = this->update_rate * std::floor(percentage / this->update_rate);
-        // floor percentage to a closest multiple of 'update_rate' for nicer display
-        // since actual updates are only required to happen no more ofter than 'update_rate'
-        // and don't have to correspond to exact multiples of it
 
-        // Estimate remaining time (linearly) and format it min + sec
-        const auto time_elapsed       = this->timepoint_current - this->timepoint_start;
-        const auto estimate_full      = time_elapsed / percentage;
-        const auto estimate_remaining = estimate_full - time_elapsed;
 
-        const auto estimate_remaining_sec = std::chrono::duration_cast<std::chrono::seconds>(estimate_remaining);
 
-        const auto displayed_min = (estimate_remaining_sec / 60ll).count();
-        const auto displayed_sec = (estimate_remaining_sec % 60ll).count();
 
-        const bool show_min  = (displayed_min != 0);
-        const bool show_sec  = (displayed_sec != 0) && !show_min;
-        const bool show_time = (estimate_remaining_sec.count() > 0);
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::parallel
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_parallel.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-        std::ostringstream ss;
+#include <iterator>
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PARALLEL)
+#ifndef UTLHEADERGUARD_PARALLEL
+#define UTLHEADERGUARD_PARALLEL
 
-        // Print bar
-        ss << '[';
-        std::fill_n(std::ostreambuf_iterator<char>(ss), this->length_current, this->done_char);
-        std::fill_n(std::ostreambuf_iterator<char>(ss), this->length_total - this->length_current, this->not_done_char);
-        ss << ']';
+// _______________________ INCLUDES _______________________
 
-        // Print percentage
-        ss << ' ' << std::fixed << std::setprecision(2) << 100. * displayed_percentage << '%';
+#include <condition_variable> // condition_variable
+#include <cstddef>            // size_t
+#include <functional>         // bind()
+#include <future>             // future<>, packaged_task<>
+#include <mutex>              // mutex, recursive_mutex, lock_guard<>, unique_lock<>
+#include <queue>              // queue<>
+#include <thread>             // thread
+#include <type_traits>        // decay_t<>, invoke_result_t<>
+#include <utility>            // forward<>()
+#include <vector>             // vector
 
-        // Print time estimate
-        if (this->show_time_estimate && show_time) {
-            ss << " (remaining:";
-            if (show_min) ss << ' ' << displayed_min << " min";
-            if (show_sec) ss << ' ' << displayed_sec << " sec";
-            ss << ')';
-        }
+// ____________________ DEVELOPER DOCS ____________________
 
-        const std::string bar_string = ss.str();
+// In C++20 'std::jthread' can be used to simplify code a bit, no reason not to do so.
+//
+// In C++20 '_unroll<>()' template can be improved to take index as a template-lambda-explicit-argument
+// rather than a regular arg, ensuring its constexpr'ness. This may lead to a slight performance boost
+// as truly manual unrolling seems to be slightly faster than automatic one.
 
-        // Add spaces at the end to overwrite the previous string if it was longer that current
-        const int current_string_length = static_cast<int>(bar_string.length());
-        const int string_length_diff    = this->previous_string_length - current_string_length;
+// ____________________ IMPLEMENTATION ____________________
 
-        if (string_length_diff > 0) { std::fill_n(std::ostreambuf_iterator<char>(ss), string_length_diff, ' '); }
+namespace utl::parallel {
 
-        this->previous_string_length = current_string_length;
+// =============
+// --- Utils ---
+// =============
 
-        // Return the carriage
-        (*_output_stream) << ss.str(); // don't reuse 'bar_string', now 'ss' can also contain spaces at the end
-        (*_output_stream) << '\r';
-        (*_output_stream).flush();
-        // '\r' returns cursor to the beginning of the line => most sensible consoles will
-        // render render new lines over the last one. Otherwise every update produces a
-        // bar on a new line, which looks worse but isn't critical for the purpose.
-    }
+template <class T, class Mutex = std::mutex>
+class MutexProtected {
+    T             value;
+    mutable Mutex mutex;
 
 public:
-    Percentage(char done_char = '#', char not_done_char = '.', std::size_t bar_length = 30, double update_rate = 1e-2,
-               bool show_time_estimate = true)
-        : done_char(done_char), not_done_char(not_done_char), show_time_estimate(show_time_estimate),
-          length_total(bar_length), length_current(0), last_update_percentage(0), update_rate(update_rate),
-          timepoint_start(Clock::now()), previous_string_length(static_cast<int>(bar_length) + sizeof("[] 100.00%")) {}
+    MutexProtected() = default;
+    MutexProtected(const T& value) : value(value), mutex() {}
+    MutexProtected(T&& value) : value(std::move(value)), mutex() {}
 
-    void start() {
-        this->last_update_percentage = 0.;
-        this->length_current         = 0;
-        this->timepoint_start        = Clock::now();
-        (*_output_stream) << '\n';
+    template <class Func>
+    decltype(auto) apply(Func&& func) const {
+        const std::lock_guard lock(this->mutex);
+        return std::forward<Func>(func)(this->value);
     }
 
-    void set_progress(double percentage) {
-        if (percentage - this->last_update_percentage <= this->update_rate) return;
-
-        this->last_update_percentage = percentage;
-        this->length_current         = static_cast<std::size_t>(percentage * static_cast<double>(this->length_total));
-        this->timepoint_current      = Clock::now();
-        this->draw_progressbar(percentage);
+    template <class Func>
+    decltype(auto) apply(Func&& func) {
+        const std::lock_guard lock(this->mutex);
+        return std::forward<Func>(func)(this->value);
     }
 
-    void finish() {
-        this->last_update_percentage = 1.;
-        this->length_current         = this->length_total;
-        this->draw_progressbar(1.);
-        (*_output_stream) << '\n';
-    }
+    [[nodiscard]] T&& release() { return std::move(this->value); }
 };
 
-class Ruler {
-private:
-    char done_char;
-
-    std::size_t length_total;
-    std::size_t length_current;
+[[nodiscard]] inline std::size_t max_thread_count() noexcept {
+    const std::size_t detected_threads = std::thread::hardware_concurrency();
+    return detected_threads ? detected_threads : 1;
+    // 'hardware_concurrency()' returns '0' if it can't determine the number of threads,
+    // in this case we reasonably assume there is a single thread available
+}
 
-public:
-    Ruler(char done_char = '#') : done_char(done_char), length_total(51), length_current(0) {}
+// No reason to include the entirety of <algorithm> just for 2 one-liner functions,
+// so we implement 'std::size_t' min/max here
+[[nodiscard]] constexpr std::size_t _min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
+[[nodiscard]] constexpr std::size_t _max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
 
-    void start() {
-        this->length_current = 0;
+// Template for automatic loop unrolling.
+//
+// It is used in 'parallel::reduce()' to (optionally) speed up a tight loop while leaving the user
+// with ability to easily control that unrolling. By default NO unrolling is used.
+//
+// Benchmarks indicate speedups ~130% to ~400% depending on CPU, compiler and options
+// large unrolling (32) seems to be the best on benchmarks, however it may bloat the binary
+// and take over too many branch predictor slots in case of min/max reductions, 4-8 seems
+// like a reasonable sweetspot for most machines.
+//
+// One may think that it is a job of compiler to perform such optimizations, yet even with
+// GCC '-Ofast -funroll-all-loop' and GCC unroll pragmas it fails to do them reliably.
+//
+// The reason it fails to do so is pretty clear for '-O2' and below - strictly speaking, most binary
+// operations on floats are non-commutative (sum depends on the order of addition, for example), however
+// since reduction is inherently not-order-preserving there is no harm in reordering operations some more
+// and unrolling the loop so compiler will be able to use SIMD if it sees it as possile (which it often does).
+//
+// Why vectorization of simple loops still tends to fail with '-Ofast' which reduces conformance and
+// allows reordering of math operations is unclear, but this is how it happens when actually measured.
+//
+template <class T, T... indeces, class F>
+constexpr void _unroll_impl(std::integer_sequence<T, indeces...>, F&& f) {
+    (f(std::integral_constant<T, indeces>{}), ...);
+}
+template <class T, T count, class F>
+constexpr void _unroll(F&& f) {
+    _unroll_impl(std::make_integer_sequence<T, count>{}, std::forward<F>(f));
+}
 
-        (*_output_stream) << '\n'
-                          << " 0    10   20   30   40   50   60   70   80   90   100%\n"
-                          << " |----|----|----|----|----|----|----|----|----|----|\n"
-                          << ' ';
-    }
+// ===================
+// --- Thread pool ---
+// ===================
 
-    void set_progress(double percentage) {
-        const std::size_t length_new = static_cast<std::size_t>(percentage * static_cast<double>(this->length_total));
+// A simple single-queue task threadpool, uploads of arbitrary callables as tasks,
+// returns optional futures, supports pausing. Work stealing would probably be better
+// in a general case, however it complicates the implementation quite noticeably and
+// doesn't provide much measurable benefit under the API of this module.
 
-        if (length_new > length_current) {
-            const auto chars_to_add = length_new - this->length_current;
-            std::fill_n(std::ostreambuf_iterator<char>(*_output_stream), chars_to_add, this->done_char);
-        }
-
-        this->length_current = length_new;
-    }
-
-    void finish() {
-        if (this->length_total > this->length_current) {
-            const auto chars_to_add = this->length_total - this->length_current;
-            std::fill_n(std::ostreambuf_iterator<char>(*_output_stream), chars_to_add, this->done_char);
-        }
+// Note:
+// We don't use 'MutexProtected' here to make implementation a bit more decoupled, plus such idiom isn't nearly as
+// convenient once we enter the realm of non-trivial syncronization with recursive mutexes and condition variables.
 
-        this->length_current = this->length_total;
+class ThreadPool {
+private:
+    std::vector<std::thread>     threads;
+    mutable std::recursive_mutex thread_mutex;
 
-        (*_output_stream) << '\n';
-    }
-};
+    std::queue<std::packaged_task<void()>> tasks{};
+    mutable std::mutex                     task_mutex;
 
-} // namespace utl::progressbar
+    std::condition_variable task_cv;          // used to notify changes to the task queue
+    std::condition_variable task_finished_cv; // used to notify of finished tasks
 
-#endif
-#endif // module utl::progressbar
+    // Signals
+    bool stopping = false; // signal for workers to shut down '.worker_main()'
+    bool paused   = false; // signal for workers to not pull new tasks from the queue
+    bool waiting  = false; // signal for workers that they should notify 'task_finished_cv' when
+                           // finishing a task, which is used to implement 'wait for tasks' methods
 
+    int tasks_running = 0; // number of tasks currently executed by workers
 
+    // Main function for worker threads,
+    // here workers wait for the queue, pull new tasks from it and run them
+    void thread_main() {
+        bool task_was_finished = false;
 
+        while (true) {
+            std::unique_lock<std::mutex> task_lock(this->task_mutex);
 
+            if (task_was_finished) {
+                --this->tasks_running;
+                if (this->waiting) this->task_finished_cv.notify_all();
+                // no need to set 'task_was_finished' back to 'false',
+                // the only way we get back into this condition is if another task was finished
+            }
 
+            // Pool isn't destructing, isn't paused and there are tasks available in the queue
+            //    => continue execution, a new task from the queue and start executing it
+            // otherwise
+            //    => unlock the mutex and wait until a new task is submitted,
+            //       pool is unpaused or destruction is initiated
+            this->task_cv.wait(task_lock, [&] { return this->stopping || (!this->paused && !this->tasks.empty()); });
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::random
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_random.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+            if (this->stopping) break; // escape hatch for thread destruction
 
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_RANDOM)
-#ifndef UTLHEADERGUARD_RANDOM
-#define UTLHEADERGUARD_RANDOM
+            // Pull a new task from the queue and start executing it
+            std::packaged_task<void()> task_to_execute = std::move(this->tasks.front());
+            this->tasks.pop();
+            ++this->tasks_running;
+            task_lock.unlock();
 
-// _______________________ INCLUDES _______________________
+            task_to_execute(); // NOTE: Should I catch exceptions here?
+            task_was_finished = true;
+        }
+    }
 
-#include <array>            // array<>
-#include <cassert>          // assert()
-#include <chrono>           // high_resolution_clock
-#include <cstdint>          // uint64_t
-#include <initializer_list> // initializer_list<>
-#include <limits>           // numeric_limits<>::digits, numeric_limits<>::min(), numeric_limits<>::max()
-#include <mutex>            // mutex, lock_guard<>
-#include <random>           // random_device, std::uniform_int_distribution<>,
-                            // std::uniform_real_distribution<>, generate_canonical<>
-#include <type_traits>      // is_integral_v<>
-#include <utility>          // declval<>()
-#include <vector>           // vector<>, hash<>
+    void start_threads(std::size_t worker_count_increase) {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        // the mutex has to be recursive because we call '.start_threads()' inside '.set_num_threads()'
+        // which also locks 'worker_mutex', if mutex wan't recursive we would deadlock trying to lock
+        // it a 2nd time on the same thread.
 
-// ____________________ DEVELOPER DOCS ____________________
+        // NOTE: It feels like '.start_threads()' can be split into '.start_threads()' and
+        // '._start_threads_assuming_locked()' which would remove the need for recursive mutex
 
-// Implements a proper modern PRNG engine, compatible with std <random>.
-// Adds 'sensible std <random> wrappers' for people who aren't fond of writing
-// 3 lines code just to get a simple rand value.
-//
-// # XorShift64StarGenerator #
-// Random 'std::uint64_t' generator that satisfies uniform random number generator requirements
-// from '<random>' (see https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator).
-// Implementation "XorShift64* suggested by Marsaglia G. in 2003 "Journal of Statistical Software"
-// (see https://www.jstatsoft.org/article/view/v008i14).
-// Slightly faster than 'std::rand()', while providing higher quality random.
-// Significantly faster than 'std::mt19937'.
-// State consists of a single 'std::uint64_t', requires seed >= 1.
-//
-// # xorshift64star #
-// Global instance of XorShift64StarGenerator.
-//
-// # ::seed(), ::seed_with_time(), ::seed_with_random_device() #
-// Seeds random with value/current_time/random_device.
-// Random device is a better source of entropy, however it's more expensive to initialize
-// than just taking current time with <ctime>, in some cases a "worse by lightweigh" can
-// be prefered.
-//
-// # ::rand_int(), ::rand_uint(), ::rand_float(), ::rand_double() #
-// Random value in [min, max] range.
-// Floats with no parameters assume range [0, 1].
-//
-// # ::rand_bool() #
-// Randomly chooses 0 or 1.
-//
-// # ::rand_choice() #
-// Randomly chooses a value from initializer list.
-//
-// # ::rand_linear_combination() #
-// Produces "c A + (1-c) B" with random "0 < c < 1" assuming objects "A", "B" support arithmetic operations.
-// Useful for vector and color operations.
+        for (std::size_t i = 0; i < worker_count_increase; ++i)
+            this->threads.emplace_back(&ThreadPool::thread_main, this);
+    }
 
-// ____________________ IMPLEMENTATION ____________________
+    void stop_all_threads() {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
 
-// ======================================
-// --- Ugly platform-specific entropy ---
-// ======================================
+        {
+            const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+            this->stopping = true;
+            this->task_cv.notify_all();
+        } // signals to all threads that they should stop running
 
-// MSVC
-#if defined(UTL_RANDOM_USE_INTRINSICS) && !defined(utl_random_cpu_counter) && defined(_MSC_VER)
-#if defined(_M_IX86)
-#include <intrin.h>
-#define utl_random_cpu_counter __rdtsc()
-#endif
-#endif
+        for (auto& worker : this->threads)
+            if (worker.joinable()) worker.join();
+        // 'joinable()' checks in needed so we don't try to join the master thread
 
-// GCC
-#if defined(UTL_RANDOM_USE_INTRINSICS) && !defined(utl_random_cpu_counter) && defined(__GNUC__)
-#if __has_builtin(__builtin_ia32_rdtsc)
-#define utl_random_cpu_counter __builtin_ia32_rdtsc()
-#endif
-#endif
+        this->threads.clear();
+    }
 
-// clang
-#if defined(UTL_RANDOM_USE_INTRINSICS) && !defined(utl_random_cpu_counter) && !defined(__GNUC__) && defined(__clang__)
-#if __has_builtin(__builtin_readcyclecounter) && __has_include(<xmmintrin.h>)
-#include <xmmintrin.h>
-#define utl_random_cpu_counter __builtin_readcyclecounter()
-#endif
-#endif
+public:
+    // --- Construction ---
+    // --------------------
 
-// Fallback onto a constant that changes with each compilation,
-// not good, but better than nothing
-#if !defined(utl_random_cpu_counter)
-#include <string>
-#define utl_random_cpu_counter std::hash<std::string>{}(std::string(__TIME__))
-#endif
+    ThreadPool() = default;
 
-namespace utl::random {
+    explicit ThreadPool(std::size_t thread_count) { this->start_threads(thread_count); }
 
-// ============================
-// --- Implementation utils ---
-// ============================
+    ~ThreadPool() {
+        this->unpause();
+        this->wait_for_tasks();
+        this->stop_all_threads();
+    }
 
+    // --- Threads ---
+    // ---------------
 
-// --- Type traits ---
-// -------------------
+    [[nodiscard]] std::size_t get_thread_count() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->threads.size();
+    }
 
-#define utl_random_define_trait(trait_name_, ...)                                                                      \
-    template <class T, class = void>                                                                                   \
-    struct trait_name_ : std::false_type {};                                                                           \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+    void set_thread_count(std::size_t thread_count) {
+        const std::size_t current_thread_count = this->get_thread_count();
 
+        if (thread_count == current_thread_count) return;
+        // 'quick escape' so we don't experience too much slowdown when the user calls '.set_thread_count()' reapeatedly
 
-utl_random_define_trait(_is_seed_seq,
-                        std::declval<T>().generate(std::declval<std::uint32_t*>(), std::declval<std::uint32_t*>()));
-// this type trait is necessary to restrict template constructors & seed function that take 'SeedSeq&& seq', otherwise
-// they will get pick instead of regular seeding methods for even for integer conversions. This is how standard library
-// seems to do it (based on GCC implementation) so we follow their API.
+        if (thread_count > current_thread_count) {
+            this->start_threads(thread_count - current_thread_count);
+        } else {
+            this->stop_all_threads();
+            {
+                const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+                this->stopping = false;
+            }
+            this->start_threads(thread_count);
+            // It is possible to improve implementation by making the pool shrink by joining only the necessary amount
+            // of threads instead of recreating the the whole pool, however that task is non-trivial and would likely
+            // require a more granular signaling with one flag per thread instead of a global 'stopping' flag.
+        }
+    }
 
-#undef utl_random_define_trait
+    // --- Task queue ---
+    // ------------------
 
-template <class>
-constexpr bool _always_false_v = false;
+    template <class Func, class... Args>
+    void add_task(Func&& func, Args&&... args) {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        this->tasks.emplace(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+        this->task_cv.notify_one(); // wakes up one thread (if possible) so it can pull the new task
+    }
 
-template <bool Cond>
-using _require = std::enable_if_t<Cond, bool>; // makes SFINAE a bit less cumbersome
+    template <class Func, class... Args,
+              class FuncReturnType = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>>
+    [[nodiscard]] std::future<FuncReturnType> add_task_with_future(Func&& func, Args&&... args) {
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER)
+        // MSVC messed up implementation of 'std::packaged_task<>' so it is not movable (which,
+        // according to the standard, it should be) and they can't fix it for 7 (and counting) years
+        // because fixing the bug would change the ABI. See this thread about the bug report:
+        // https://developercommunity.visualstudio.com/t/unable-to-move-stdpackaged-task-into-any-stl-conta/108672
+        // As a workaround we wrap the packaged task into a shared pointer and add another layer of packaging.
+        auto new_task = std::make_shared<std::packaged_task<FuncReturnType()>>(
+            std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+        this->add_task([new_task] { (*new_task)(); }); // horrible
+        return new_task->get_future();
+#else
+        std::packaged_task<FuncReturnType()> new_task(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+        auto                                 future = new_task.get_future();
+        this->add_task(std::move(new_task));
+        return future;
+#endif
+    }
+
+    void wait_for_tasks() {
+        std::unique_lock<std::mutex> task_lock(this->task_mutex);
+        this->waiting = true;
+        this->task_finished_cv.wait(task_lock, [&] { return this->tasks.empty() && this->tasks_running == 0; });
+        this->waiting = false;
+    }
+
+    void clear_task_queue() {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        this->tasks = {}; // for some reason 'std::queue' has no '.clear()', complexity O(N)
+    }
+
+    // --- Pausing ---
+    // ---------------
+
+    void pause() {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        this->paused = true;
+    }
+
+    void unpause() {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        this->paused = false;
+        this->task_cv.notify_all();
+    }
+
+    [[nodiscard]] bool is_paused() const {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        return this->paused;
+    }
+};
+
+// =====================================
+// --- Static thread pool operations ---
+// =====================================
+
+inline ThreadPool& static_thread_pool() {
+    // no '[nodiscard]' since a call to this function might be used to initialize a threadpool
+    static ThreadPool pool(max_thread_count());
+    return pool;
+}
+
+[[nodiscard]] inline std::size_t get_thread_count() { return static_thread_pool().get_thread_count(); }
+
+inline void set_thread_count(std::size_t thread_count) { static_thread_pool().set_thread_count(thread_count); }
+
+// ================
+// --- Task API ---
+// ================
+
+template <class Func, class... Args>
+void task(Func&& func, Args&&... args) {
+    static_thread_pool().add_task(std::forward<Func>(func), std::forward<Args>(args)...);
+}
+
+template <class Func, class... Args>
+auto task_with_future(Func&& func, Args&&... args)
+    -> std::future<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> {
+    return static_thread_pool().add_task_with_future(std::forward<Func>(func), std::forward<Args>(args)...);
+}
+
+inline void wait_for_tasks() { static_thread_pool().wait_for_tasks(); }
+
+// =======================
+// --- Parallel ranges ---
+// =======================
+
+constexpr std::size_t default_grains_per_thread = 4;
+// by default we distribute 4 tasks per thread, this number is purely empirical.
+// We don't want to split up work into too many tasks (like with 'grain_size = 1')
+// yet we want it to be a bit more granular than doing 1 task per thread since
+// that would be horrible if tasks are noticeably uneven.
+
+// Note:
+// In range constructors we intentionally allow some possibly narrowing conversions like 'it1 - it2' to 'size_t'
+// for better compatibility with containers that can use large ints as their difference type
+
+template <class Idx>
+struct IndexRange {
+    Idx         first;
+    Idx         last;
+    std::size_t grain_size;
+
+    IndexRange() = delete;
+    constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
+        : first(first), last(last), grain_size(grain_size) {}
+    IndexRange(Idx first, Idx last)
+        : IndexRange(first, last, _max_size(1, (last - first) / (get_thread_count() * default_grains_per_thread))){};
+};
+
+template <class Iter>
+struct Range {
+    Iter        begin;
+    Iter        end;
+    std::size_t grain_size;
+
+    Range() = delete;
+    constexpr Range(Iter begin, Iter end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
+    Range(Iter begin, Iter end)
+        : Range(begin, end, _max_size(1, (end - begin) / (get_thread_count() * default_grains_per_thread))) {}
+
+
+    template <class Container>
+    Range(const Container& container) : Range(container.begin(), container.end()) {}
+
+    template <class Container>
+    Range(Container& container) : Range(container.begin(), container.end()) {}
+};// requires random-access iterator, but no good way to express that before C++20 concepts
+
+// User-defined deduction guides
+//
+// By default, template constructors cannot deduce template argument 'Iter',
+// however it is possible to define a custom deduction guide and achieve what we want
+//
+// See: https://en.cppreference.com/w/cpp/language/class_template_argument_deduction#User-defined_deduction_guides
+template <class Container>
+Range(const Container& container) -> Range<typename Container::const_iterator>;
+
+template <class Container>
+Range(Container& container) -> Range<typename Container::iterator>;
+
+// ==========================
+// --- 'Parallel for' API ---
+// ==========================
+
+template <class Idx, class Func>
+void for_loop(IndexRange<Idx> range, Func&& func) {
+    for (Idx i = range.first; i < range.last; i += range.grain_size)
+        task(std::forward<Func>(func), i, _min_size(i + range.grain_size, range.last));
+
+    wait_for_tasks();
+}
+
+template <class Iter, class Func>
+void for_loop(Range<Iter> range, Func&& func) {
+    for (Iter i = range.begin; i < range.end; i += range.grain_size)
+        task(std::forward<Func>(func), i, i + _min_size(range.grain_size, range.end - i));
+
+    wait_for_tasks();
+}
+
+template <class Container, class Func>
+void for_loop(Container&& container, Func&& func) {
+    for_loop(Range{std::forward<Container>(container)}, std::forward<Func>(func));
+}
+// couldn't figure out how to make it work perfect-forwared 'Container&&',
+// for some reason it would always cause template deduction to fail
+
+// =============================
+// --- 'Parallel reduce' API ---
+// =============================
+
+constexpr std::size_t default_unroll = 1;
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class Iter, class T = typename Iter::value_type>
+auto reduce(Range<Iter> range, BinaryOp&& op) -> T {
+
+    MutexProtected<T> result = *range.begin;
+    // we have to start from the 1st element and not 'T{}' because there is no guarantee
+    // than doing so would be correct for some non-trivial 'T' and 'op'
+
+    for_loop(Range<Iter>{range.begin + 1, range.end, range.grain_size}, [&](Iter low, Iter high) {
+        const std::size_t range_size = high - low;
+
+        // Execute unrolled loop if unrolling is enabled and the range is sufficiently large
+        if constexpr (unroll > 1)
+            if (range_size > unroll) {
+                // (parallel section) Compute partial result (unrolled for SIMD)
+                // Reduce unrollable part
+                std::array<T, unroll> partial_results;
+                _unroll<std::size_t, unroll>([&](std::size_t j) { partial_results[j] = *(low + j); });
+                Iter it = low + unroll;
+                for (; it < high - unroll; it += unroll)
+                    _unroll<std::size_t, unroll>(
+                        [&, it](std::size_t j) { partial_results[j] = op(partial_results[j], *(it + j)); });
+                // Reduce remaining elements
+                for (; it < high; ++it) partial_results[0] = op(partial_results[0], *it);
+                // Collect the result
+                for (std::size_t i = 1; i < partial_results.size(); ++i)
+                    partial_results[0] = op(partial_results[0], partial_results[i]);
+
+                // (critical section) Add partial result to the global one
+                result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_results[0]); });
+
+                return; // skip the non-unrolled version
+            }
+
+        // Fallback onto a regular reduction loop otherwise
+        // (parallel section) Compute partial result
+        T partial_result = *low;
+        for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, *it);
+
+        // (critical section) Add partial result to the global one
+        result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_result); });
+    });
+
+    // Note 1:
+    // We could also collect results into an array of partial results and then reduce it on the
+    // main thread at the end, but that leads to a much less clean implementation and doesn't
+    // seem to be measurably faster.
+
+    // Note 2:
+    // 'if constexpr (unroll > 1)' ensures that unrolling logic will have no effect
+    //  whatsoever on the non-unrolled version of the template, it will not even compile.
+
+    return result.release();
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class Container>
+auto reduce(Container&& container, BinaryOp&& op) -> typename std::decay_t<Container>::value_type {
+    return reduce<unroll>(Range{std::forward<Container>(container)}, std::forward<BinaryOp>(op));
+}
+
+// --- Pre-defined binary ops ---
+// ------------------------------
+
+// Note 1:
+// Defining binary operations as free-standing functions has a huge negative
+// effect on parallel::reduce performance, for example on 4 threads:
+//    binary op is 'sum'        => speedup ~90%-180%
+//    binary op is 'struct sum' => speedup ~370%
+// This is caused by failed inlining and seems to be the reason why standard library implements
+// 'std::plus' as a functor class and not a free-standing function. I spent 2 hours of my life
+// and 4 rewrites of 'parallel::reduce()' on this.
+
+// Note 2:
+// 'sum' & 'prod' can are just aliases for standard functors, 'min' & 'max' on the other hand
+// require custom, implementation. Note the '<void>' specialization for transparent functors,
+// see https://en.cppreference.com/w/cpp/utility/functional
+
+template <class... Args>
+using sum = std::plus<Args...>; // without variadic 'Args...' we wouldn't be able to alias 'std::plus<>'
+
+template <class... Args>
+using prod = std::multiplies<Args...>;
+
+template <class T>
+struct min {
+    constexpr const T& operator()(const T& lhs, const T& rhs) const noexcept(noexcept((lhs < rhs) ? lhs : rhs)) {
+        return (lhs < rhs) ? lhs : rhs;
+    }
+};
+
+template <>
+struct min<void> {
+    template <class T1, class T2>
+    constexpr auto operator()(T1&& lhs, T2&& rhs) const
+        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T1>(lhs) : std::forward<T2>(rhs)))
+            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T1>(lhs) : std::forward<T2>(rhs)) {
+        return std::less<>{}(lhs, rhs) ? std::forward<T1>(lhs) : std::forward<T2>(rhs);
+    }
+
+    using is_transparent = std::less<>::is_transparent;
+};
+
+template <class T>
+struct max {
+    constexpr const T& operator()(const T& lhs, const T& rhs) const noexcept(noexcept((lhs < rhs) ? rhs : lhs)) {
+        return (lhs < rhs) ? rhs : lhs;
+    }
+};
+
+template <>
+struct max<void> {
+    template <class T1, class T2>
+    constexpr auto operator()(T1&& lhs, T2&& rhs) const
+        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)))
+            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)) {
+        return std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs);
+    }
+
+    using is_transparent = std::less<>::is_transparent;
+};
+
+} // namespace utl::parallel
+
+#endif
+#endif // module utl::parallel
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::predef
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_predef.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PREDEF)
+#ifndef UTLHEADERGUARD_PREDEF
+#define UTLHEADERGUARD_PREDEF
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>   // fill_n()
+#include <cctype>      // isspace()
+#include <cstdlib>     // exit()
+#include <iostream>    // cerr
+#include <iterator>    // ostreambuf_iterator<>
+#include <new>         // hardware_destructive_interference_size, hardware_constructive_interference_size
+#include <ostream>     // endl
+#include <sstream>     // istringstream
+#include <string>      // string, getline()
+#include <string_view> // string_view
+#include <utility>     // declval<>()
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// Macros that provide a nicer way of querying some platform-specific stuff such as:
+// compiler, platform, architecture, compilation info and etc.
+//
+// Boost Predef (https://www.boost.org/doc/libs/1_55_0/libs/predef/doc/html/index.html) provides
+// a more complete package when it comes to supporing some esoteric platforms & compilers,
+// but has a rather (in my opinion) ugly API.
+//
+// In addition utl::predef also provides some miscellaneous macros for automatic codegen, such as:
+//    UTL_PREDEF_VA_ARGS_COUNT(args...)
+//    UTL_PREDEF_ENUM_WITH_STRING_CONVERSION(enum_name, enum_values...)
+//    UTL_PREDEF_IS_FUNCTION_DEFINED() - a nightmare of implementation, but it works
+// some implementations may be rather sketchy due to trying to achieve things that weren't really
+// meant to be achieved, but at the end of the day everything is standard-compliant.
+
+// ____________________ IMPLEMENTATION ____________________
+
+namespace utl::predef {
+
+// ================================
+// --- Compiler Detection Macro ---
+// ================================
+
+#if defined(_MSC_VER)
+#define UTL_PREDEF_COMPILER_IS_MSVC
+#elif defined(__GNUC__) || defined(__GNUC_MINOR__) || defined(__GNUC_PATCHLEVEL__)
+#define UTL_PREDEF_COMPILER_IS_GCC
+#elif defined(__clang__) || defined(__clang_major__) || defined(__clang_minor__) || defined(__clang_patchlevel__)
+#define UTL_PREDEF_COMPILER_IS_CLANG
+#elif defined(__llvm__)
+#define UTL_PREDEF_COMPILER_IS_LLVM
+#elif defined(__INTEL_COMPILER) || defined(__ICL) || defined(__ICC) || defined(__ECC)
+#define UTL_PREDEF_COMPILER_IS_ICC
+#elif defined(__PGI) || defined(__PGIC__) || defined(__PGIC_MINOR__) || defined(__PGIC_PATCHLEVEL__)
+#define UTL_PREDEF_COMPILER_IS_PGI
+#elif defined(__IBMCPP__) || defined(__xlC__) || defined(__xlc__)
+#define UTL_PREDEF_COMPILER_IS_IBMCPP
+#elif defined(__NVCC__) || defined(__CUDACC__)
+#define UTL_PREDEF_COMPILER_IS_NVCC
+#else
+#define UTL_PREDEF_COMPILER_IS_UNKNOWN
+#endif
+
+constexpr std::string_view compiler_name =
+#if defined(UTL_PREDEF_COMPILER_IS_MSVC)
+    "MSVC"
+#elif defined(UTL_PREDEF_COMPILER_IS_GCC)
+    "GCC"
+#elif defined(UTL_PREDEF_COMPILER_IS_CLANG)
+    "clang"
+#elif defined(UTL_PREDEF_COMPILER_IS_LLVM)
+    "LLVM"
+#elif defined(UTL_PREDEF_COMPILER_IS_ICC)
+    "ICC"
+#elif defined(UTL_PREDEF_COMPILER_IS_PGI)
+    "PGI"
+#elif defined(UTL_PREDEF_COMPILER_IS_IBMCPP)
+    "IBMCPP"
+#elif defined(UTL_PREDEF_COMPILER_IS_NVCC)
+    "NVCC"
+#else
+    "<unknown>"
+#endif
+    ;
+
+constexpr std::string_view compiler_full_name =
+#if defined(UTL_PREDEF_COMPILER_IS_MSVC)
+    "Microsoft Visual C++ Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_GCC)
+    "GNU C/C++ Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_CLANG)
+    "Clang Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_LLVM)
+    "LLVM Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_ICC)
+    "Inter C/C++ Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_PGI)
+    "Portland Group C/C++ Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_IBMCPP)
+    "IBM XL C/C++ Compiler"
+#elif defined(UTL_PREDEF_COMPILER_IS_NVCC)
+    "Nvidia Cuda Compiler Driver"
+#else
+    "<unknown>"
+#endif
+    ;
+
+// ================================
+// --- Platform Detection Macro ---
+// ================================
+
+#if defined(_WIN64) // _WIN64 implies _WIN32 so it should be first
+#define UTL_PREDEF_PLATFORM_IS_WINDOWS_X64
+#elif defined(_WIN32)
+#define UTL_PREDEF_PLATFORM_IS_WINDOWS_X32
+#elif defined(__CYGWIN__) && !defined(_WIN32) // Cygwin POSIX under Microsoft Window
+#define UTL_PREDEF_PLATFORM_IS_CYGWIN
+#elif defined(__ANDROID__) // __ANDROID__ implies __linux__ so it should be first
+#define UTL_PREDEF_PLATFORM_IS_ANDROID
+#elif defined(linux) || defined(__linux__) || defined(__linux)
+#define UTL_PREDEF_PLATFORM_IS_LINUX
+#elif defined(unix) || defined(__unix__) || defined(__unix)
+#define UTL_PREDEF_PLATFORM_IS_UNIX
+#elif defined(__APPLE__) && defined(__MACH__)
+#define UTL_PREDEF_PLATFORM_IS_MACOS
+#else
+#define UTL_PREDEF_PLATFORM_IS_UNKNOWN
+#endif
+
+constexpr std::string_view platform_name =
+#if defined(UTL_PREDEF_PLATFORM_IS_WINDOWS_X64)
+    "Windows64"
+#elif defined(UTL_PREDEF_PLATFORM_IS_WINDOWS_X32)
+    "Windows32"
+#elif defined(UTL_PREDEF_PLATFORM_IS_CYGWIN)
+    "Windows (CYGWIN)"
+#elif defined(UTL_PREDEF_PLATFORM_IS_ANDROID)
+    "Android"
+#elif defined(UTL_PREDEF_PLATFORM_IS_LINUX)
+    "Linux"
+#elif defined(UTL_PREDEF_PLATFORM_IS_UNIX)
+    "Unix-like OS"
+#elif defined(UTL_PREDEF_PLATFORM_IS_MACOS)
+    "MacOS" // Apple OSX and iOS (Darwin)
+#else
+    "<unknown>"
+#endif
+    ;
+
+
+// ====================================
+// --- Architecture Detection Macro ---
+// ====================================
+
+#if defined(__x86_64) || defined(__x86_64__) || defined(__amd64__) || defined(__amd64) || defined(_M_X64)
+#define UTL_PREDEF_ARCHITECTURE_IS_X86_64
+#elif defined(i386) || defined(__i386__) || defined(__i486__) || defined(__i586__) || defined(__i686__) ||             \
+    defined(__i386) || defined(_M_IX86) || defined(_X86_) || defined(__THW_INTEL__) || defined(__I86__) ||             \
+    defined(__INTEL__) || defined(__I86__) || defined(_M_IX86) || defined(__i686__) || defined(__i586__) ||            \
+    defined(__i486__) || defined(__i386__)
+#define UTL_PREDEF_ARCHITECTURE_IS_X86_32
+#elif defined(__arm__) || defined(__thumb__) || defined(__TARGET_ARCH_ARM) || defined(__TARGET_ARCH_THUMB) ||          \
+    defined(__TARGET_ARCH_ARM) || defined(__TARGET_ARCH_THUMB)
+#define UTL_PREDEF_ARCHITECTURE_IS_ARM
+#else
+#define UTL_PREDEF_ARCHITECTURE_IS_UNKNOWN
+#endif
+
+constexpr std::string_view architecture_name =
+#if defined(UTL_PREDEF_ARCHITECTURE_IS_X86_64)
+    "x86-64"
+#elif defined(UTL_PREDEF_ARCHITECTURE_IS_X86_32)
+    "x86-32"
+#elif defined(UTL_PREDEF_ARCHITECTURE_IS_ARM)
+    "ARM"
+#else
+    "<unknown>"
+#endif
+    ;
+
+// =========================================
+// --- Language Standard Detection Macro ---
+// =========================================
+
+#if defined(UTL_PREDEF_COMPILER_IS_MSVC)
+#define UTL_PREDEF_CPP_VERSION _MSVC_LANG
+#else
+#define UTL_PREDEF_CPP_VERSION __cplusplus
+#endif
+// Note 1:
+// MSVC '__cplusplus' is defined, but stuck at '199711L'. It uses '_MSVC_LANG' instead.
+//
+// Note 2:
+// '__cplusplus' is defined by the standard, it's only Microsoft who think standards are for other people.
+//
+// Note 3:
+// MSVC has a flag '/Zc:__cplusplus' that enables standard behaviour for '__cplusplus'
+
+#if (UTL_PREDEF_CPP_VERSION >= 202302L)
+#define UTL_PREDEF_STANDARD_IS_23_PLUS
+#elif (UTL_PREDEF_CPP_VERSION >= 202002L)
+#define UTL_PREDEF_STANDARD_IS_20_PLUS
+#elif (UTL_PREDEF_CPP_VERSION >= 201703L)
+#define UTL_PREDEF_STANDARD_IS_17_PLUS
+#elif (UTL_PREDEF_CPP_VERSION >= 201402L)
+#define UTL_PREDEF_STANDARD_IS_14_PLUS
+#elif (UTL_PREDEF_CPP_VERSION >= 201103L)
+#define UTL_PREDEF_STANDARD_IS_11_PLUS
+#else // everything below C++11 has the same value of '199711L'
+#define UTL_PREDEF_STANDARD_IS_UNKNOWN
+#endif
+// Note:
+// There should be no feasible way to fall below the 'UTL_PREDEF_STANDARD_IS_17_PLUS' since this library itself
+// requires C++17 to compile, but might as well have a complete implementation for future reference.
+
+constexpr std::string_view standard_name =
+#if defined(UTL_PREDEF_STANDARD_IS_23_PLUS)
+    "C++23"
+#elif defined(UTL_PREDEF_STANDARD_IS_20_PLUS)
+    "C++20"
+#elif defined(UTL_PREDEF_STANDARD_IS_17_PLUS)
+    "C++17"
+#elif defined(UTL_PREDEF_STANDARD_IS_14_PLUS)
+    "C++14"
+#elif defined(UTL_PREDEF_STANDARD_IS_11_PLUS)
+    "C++11"
+#else
+    "<unknown>"
+#endif
+    ;
+
+// ========================================
+// --- Compilation Mode Detection Macro ---
+// ========================================
+
+#if defined(_DEBUG)
+#define UTL_PREDEF_MODE_IS_DEBUG
+#endif
+
+constexpr bool debug =
+#if defined(UTL_PREDEF_MODE_IS_DEBUG)
+    true
+#else
+    false
+#endif
+    ;
+
+// ===========================
+// --- Optimization macros ---
+// ===========================
+
+// Note:
+// These are mainly valuable as a reference implementation for portable optimization built-ins,
+// which is why they are made to independent of other macros in this module.
+
+// Force inline
+// (requires regular 'inline' after the macro)
+#if defined(_MSC_VER)
+#define UTL_PREDEF_FORCE_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#define UTL_PREDEF_FORCE_INLINE __attribute__((always_inline))
+#else
+#define UTL_PREDEF_FORCE_INLINE
+#endif
+
+// Force noinline
+#if defined(_MSC_VER)
+#define UTL_PREDEF_FORCE_NOINLINE __declspec((noinline))
+#elif defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#define UTL_PREDEF_FORCE_NOINLINE __attribute__((noinline))
+#endif
+
+// Branch prediction hints
+// (legacy, use '[[likely]]', '[[unlikely]] in C++20 and on)
+#if defined(__GNUC__) || defined(__clang__)
+#define UTL_PREDEF_LEGACY_LIKELY(x) __builtin_expect(!!(x), 1)
+#else
+#define UTL_PREDEF_LEGACY_LIKELY(x) (x)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UTL_PREDEF_LEGACY_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define UTL_PREDEF_LEGACY_UNLIKELY(x) (x)
+#endif
+
+// Assume condition
+#if defined(UTL_PREDEF_STANDARD_IS_23_PLUS)
+#define UTL_PREDEF_ASSUME(...) [[assume(__VA_ARGS__))]]
+#elif defined(UTL_PREDEF_COMPILER_IS_MSVC)
+#define UTL_PREDEF_ASSUME(...) __assume(__VA_ARGS__)
+#elif defined(UTL_PREDEF_COMPILER_IS_CLANG)
+#define UTL_PREDEF_ASSUME(...) __builtin_assume(__VA_ARGS__)
+#else // no equivalent GCC built-in
+#define UTL_PREDEF_ASSUME(...) __VA_ARGS__
+#endif
+
+[[noreturn]] inline void unreachable() {
+#if defined(UTL_PREDEF_STANDARD_IS_23_PLUS)
+    std::unreachable();
+#elif defined(UTL_PREDEF_COMPILER_IS_MSVC)
+    __assume(false);
+#elif defined(UTL_PREDEF_COMPILER_IS_GCC) || defined(UTL_PREDEF_COMPILER_IS_CLANG)
+    __builtin_unreachable();
+#endif
+}
+
+// ===================
+// --- Other Utils ---
+// ===================
+
+[[nodiscard]] inline std::string compilation_summary() {
+    std::string buffer;
+
+    buffer += "Compiler:          ";
+    buffer += compiler_full_name;
+    buffer += '\n';
+
+    buffer += "Platform:          ";
+    buffer += platform_name;
+    buffer += '\n';
+
+    buffer += "Architecture:      ";
+    buffer += architecture_name;
+    buffer += '\n';
+    
+    #ifdef __cpp_lib_hardware_interference_size
+    buffer += "L1 cache line (D):  ";
+    buffer += std::to_string(std::hardware_destructive_interference_size);
+    buffer += '\n';
+    
+    buffer += "L1 cache line (C):  ";
+    buffer += std::to_string(std::hardware_constructive_interference_size);
+    buffer += '\n';
+    #endif // not (currently) implemented in GCC / clang despite being a C++17 feature
+
+    buffer += "Compiled in DEBUG: ";
+    buffer += debug ? "true" : "false";
+    buffer += '\n';
+
+    buffer += "Compiled under OS: ";
+    buffer += __STDC_HOSTED__ ? "true" : "false";
+    buffer += '\n';
+
+    buffer += "Compilation date:  ";
+    buffer += __DATE__;
+    buffer += ' ';
+    buffer += __TIME__;
+    buffer += '\n';
+
+    return buffer;
+}
+
+// ===================
+// --- Macro Utils ---
+// ===================
+
+// --- Size of __VA_ARGS__ in variadic macros ---
+// ----------------------------------------------
+
+#define utl_predef_expand_va_args(x_) x_ // a fix for MSVC bug not expanding __VA_ARGS__ properly
+
+#define utl_predef_va_args_count_impl(x01_, x02_, x03_, x04_, x05_, x06_, x07_, x08_, x09_, x10_, x11_, x12_, x13_,    \
+                                      x14_, x15_, x16_, x17_, x18_, x19_, x20_, x21_, x22_, x23_, x24_, x25_, x26_,    \
+                                      x27_, x28_, x29_, x30_, x31_, x32_, x33_, x34_, x35_, x36_, x37_, x38_, x39_,    \
+                                      x40_, x41_, x42_, x43_, x44_, x45_, x46_, x47_, x48_, x49_, N_, ...)             \
+    N_
+
+#define UTL_PREDEF_VA_ARGS_COUNT(...)                                                                                  \
+    utl_predef_expand_va_args(utl_predef_va_args_count_impl(                                                           \
+        __VA_ARGS__, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26,   \
+        25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+
+// --- Map function macro to __VA_ARGS__ ---
+// -----------------------------------------
+
+#define utl_predef_map_eval_0(...) __VA_ARGS__
+#define utl_predef_map_eval_1(...) utl_predef_map_eval_0(utl_predef_map_eval_0(utl_predef_map_eval_0(__VA_ARGS__)))
+#define utl_predef_map_eval_2(...) utl_predef_map_eval_1(utl_predef_map_eval_1(utl_predef_map_eval_1(__VA_ARGS__)))
+#define utl_predef_map_eval_3(...) utl_predef_map_eval_2(utl_predef_map_eval_2(utl_predef_map_eval_2(__VA_ARGS__)))
+#define utl_predef_map_eval_4(...) utl_predef_map_eval_3(utl_predef_map_eval_3(utl_predef_map_eval_3(__VA_ARGS__)))
+#define utl_predef_map_eval(...) utl_predef_map_eval_4(utl_predef_map_eval_4(utl_predef_map_eval_4(__VA_ARGS__)))
+
+#define utl_predef_map_end(...)
+#define utl_predef_map_out
+#define utl_predef_map_comma ,
+
+#define utl_predef_map_get_end_2() 0, utl_predef_map_end
+#define utl_predef_map_get_end_1(...) utl_predef_map_get_end2
+#define utl_predef_map_get_end(...) utl_predef_map_get_end_1
+#define utl_predef_map_next_0(test, next, ...) next utl_predef_map_out
+#define utl_predef_map_next_1(test, next) utl_predef_map_next_0(test, next, 0)
+#define utl_predef_map_next(test, next) utl_predef_map_next_1(utl_predef_map_get_end test, next)
+
+#define utl_predef_map_0(f, x, peek, ...) f(x) utl_predef_map_next(peek, utl_predef_map_1)(f, peek, __VA_ARGS__)
+#define utl_predef_map_1(f, x, peek, ...) f(x) utl_predef_map_next(peek, utl_predef_map_0)(f, peek, __VA_ARGS__)
+
+#define utl_predef_map_list_next_1(test, next) utl_predef_map_next_0(test, utl_predef_map_comma next, 0)
+#define utl_predef_map_list_next(test, next) utl_predef_map_list_next_1(utl_predef_map_get_end test, next)
+
+#define utl_predef_map_list_0(f, x, peek, ...)                                                                         \
+    f(x) utl_predef_map_list_next(peek, utl_predef_map_list_1)(f, peek, __VA_ARGS__)
+#define utl_predef_map_list_1(f, x, peek, ...)                                                                         \
+    f(x) utl_predef_map_list_next(peek, utl_predef_map_list_0)(f, peek, __VA_ARGS__)
+
+// Applies the function macro `f` to each of the remaining parameters.
+#define UTL_PREDEF_MAP(f, ...) utl_predef_map_eval(utl_predef_map_1(f, __VA_ARGS__, ()()(), ()()(), ()()(), 0))
+
+// Applies the function macro `f` to each of the remaining parameters and
+// inserts commas between the results.
+#define UTL_PREDEF_MAP_LIST(f, ...)                                                                                    \
+    utl_predef_map_eval(utl_predef_map_list_1(f, __VA_ARGS__, ()()(), ()()(), ()()(), 0))
+
+// ===============
+// --- Codegen ---
+// ===============
+
+// --- Type trait generation ---
+// -----------------------------
+
+// This macro generates a type trait 'trait_name_' that returns 'true' for any 'T'
+// such that 'T'-dependent expression passed into '...' compiles.
+//
+// Also generates as helper-constant 'trait_name_##_v` like the one all standard traits provide.
+//
+// Also generates as shortcut for 'enable_if' based on that trait.
+//
+// This macro saves MASSIVE amount of boilerplate in some cases, making for a much more expressive "trait definitions".
+
+#define UTL_PREDEF_TYPE_TRAIT(trait_name_, ...)                                                                        \
+    template <class T, class = void>                                                                                   \
+    struct trait_name_ : std::false_type {};                                                                           \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+
+// Shortcuts for different types of requirements
+#define UTL_PREDEF_TYPE_TRAIT_HAS_BINARY_OP(trait_name_, op_)                                                          \
+    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<std::decay_t<T>>() op_ std::declval<std::decay_t<T>>())
+
+#define UTL_PREDEF_TYPE_TRAIT_HAS_ASSIGNMENT_OP(trait_name_, op_)                                                      \
+    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<std::decay_t<T>&>() op_ std::declval<std::decay_t<T>>())
+// for operators like '+=' lhs should be a reference
+
+#define UTL_PREDEF_TYPE_TRAIT_HAS_UNARY_OP(trait_name_, op_)                                                           \
+    UTL_PREDEF_TYPE_TRAIT(trait_name_, op_ std::declval<std::decay_t<T>>())
+
+#define UTL_PREDEF_TYPE_TRAIT_HAS_MEMBER(trait_name_, member_)                                                         \
+    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<std::decay_t<T>>().member_)
+
+#define UTL_PREDEF_TYPE_TRAIT_HAS_MEMBER_TYPE(trait_name_, member_)                                                    \
+    UTL_PREDEF_TYPE_TRAIT(trait_name_, std::declval<typename std::decay_t<T>::member_>())
+
+// --- Enum with string conversion ---
+// -----------------------------------
+
+[[nodiscard]] inline std::string _trim_enum_string(const std::string& str) {
+    std::string::const_iterator left_it = str.begin();
+    while (left_it != str.end() && std::isspace(*left_it)) ++left_it;
+
+    std::string::const_reverse_iterator right_it = str.rbegin();
+    while (right_it.base() != left_it && std::isspace(*right_it)) ++right_it;
+
+    return std::string(left_it, right_it.base()); // return string with whitespaces trimmed at both sides
+}
+
+inline void _split_enum_args(const char* va_args, std::string* strings, int count) {
+    std::istringstream ss(va_args);
+    std::string        buffer;
+
+    for (int i = 0; ss.good() && (i < count); ++i) {
+        std::getline(ss, buffer, ',');
+        strings[i] = _trim_enum_string(buffer);
+    }
+};
+
+#define UTL_PREDEF_ENUM_WITH_STRING_CONVERSION(enum_name_, ...)                                                        \
+    namespace enum_name_ {                                                                                             \
+    enum enum_name_ { __VA_ARGS__, _count };                                                                           \
+                                                                                                                       \
+    inline std::string _strings[_count];                                                                               \
+                                                                                                                       \
+    inline std::string to_string(enum_name_ enum_val) {                                                                \
+        if (_strings[0].empty()) { utl::predef::_split_enum_args(#__VA_ARGS__, _strings, _count); }                    \
+        return _strings[enum_val];                                                                                     \
+    }                                                                                                                  \
+                                                                                                                       \
+    inline enum_name_ from_string(const std::string& enum_str) {                                                       \
+        if (_strings[0].empty()) { utl::predef::_split_enum_args(#__VA_ARGS__, _strings, _count); }                    \
+        for (int i = 0; i < _count; ++i) {                                                                             \
+            if (_strings[i] == enum_str) { return static_cast<enum_name_>(i); }                                        \
+        }                                                                                                              \
+        return _count;                                                                                                 \
+    }                                                                                                                  \
+    }
+    // We declare namespace with enum inside to simulate enum-class while having '_strings' array
+    // and 'to_string()', 'from_string()' methods bundled with it.
+    //
+    // To count number of enum elements we add fake '_count' value at the end, which ends up being enum size
+    //
+    // '_strings' is declared compile-time, but gets filled through lazy evaluation upon first
+    // 'to_string()' or 'from_string()' call. To fill it we interpret #__VA_ARGS__ as a single string
+    // with some comma-separated identifiers. Those identifiers get split by commas, trimmed from
+    // whitespaces and added to '_strings'
+    //
+    // Upon further calls (enum -> string) conversion is done though taking '_strings[enum_val]',
+    // while (string -> enum) conversion requires searching through '_strings' to find enum index
+
+#define UTL_PREDEF_IS_FUNCTION_DEFINED(function_name_, return_type_, ...)                                              \
+    template <class ReturnType, class... ArgTypes>                                                                     \
+    class utl_is_function_defined_impl_##function_name_ {                                                              \
+    private:                                                                                                           \
+        typedef char no[sizeof(ReturnType) + 1];                                                                       \
+                                                                                                                       \
+        template <class... C>                                                                                          \
+        static auto test(C... arg) -> decltype(function_name_(arg...));                                                \
+                                                                                                                       \
+        template <class... C>                                                                                          \
+        static no& test(...);                                                                                          \
+                                                                                                                       \
+    public:                                                                                                            \
+        enum { value = (sizeof(test<ArgTypes...>(std::declval<ArgTypes>()...)) == sizeof(ReturnType)) };               \
+    };                                                                                                                 \
+                                                                                                                       \
+    using is_function_defined_##function_name_ =                                                                       \
+        utl_is_function_defined_impl_##function_name_<return_type_, __VA_ARGS__>;
+// TASK:
+// We need to detect at compile time if function FUNC(ARGS...) exists.
+// FUNC identifier isn't guaranteed to be declared.
+//
+// Ideal method would look like UTL_FUNC_EXISTS(FUNC, RETURN_TYPE, ARG_TYPES...) -> true/false
+// This does not seem to be possible, we have to declare integral constant instead, see explanation below.
+//
+// WHY IS IT SO HARD:
+// (1) Can this be done through preprocessor macros?
+// No, preprocessor has no way to tell whether C++ identifier is defined or not.
+//
+// (2) Is there a compiler-specific way to do it?
+// Doesn't seem to be the case.
+//
+// (3) Why not use some sort of template with FUNC as a parameter?
+// Essentially we have to evaluate undeclared identifier, while compiler exits with error upon
+// encountering anything undeclared. The only way to detect whether undeclared identifier exists
+// or not seems to be through SFINAE.
+//
+// IMPLEMENTATION COMMENTS:
+// We declate integral constant class with 2 functions 'test()', first one takes priority during overload
+// resolution and compiles if FUNC(ARGS...) is defined, otherwise it's {Substitution Failure} which is
+// {Is Not An Error} and second function compiles.
+//
+// To resolve which overload of 'test()' was selected we check the sizeof() return type, 2nd overload
+// has a return type 'char[sizeof(ReturnType) + 1]' so it's always different from 1st overload.
+// Resolution result (true/false) gets stored to '::value'.
+//
+// Note that we can't pass 'ReturnType' and 'ArgTypes' directly through '__VA_ARGS__' because
+// to call function 'test(ARGS...)' in general case we have to 'std::declval<>()' all 'ARGS...'.
+// To do so we can use variadic template syntax and then just forward '__VA_ARGS__' to the template
+// through 'using is_function_present = is_function_present_impl<ReturnType, __VA_ARGS__>'.
+//
+// ALTERNATIVES: Perhaps some sort of tricky inline SFINAE can be done through C++14 generic lambdas.
+//
+// NOTE 1: Some versions of 'clangd' give a 'bugprone-sizeof-expression' warning for sizeof(*A),
+// this is a false alarm.
+//
+// NOTE 2: Frankly, the usefullness of this is rather dubious since constructs like
+//     if constexpr (is_function_defined_windown_specific) { <call the windows-specific function> }
+//     else { <call the linux-specific function> }
+// are still illegal due to 'if constexpr' requiting both branches to have defined identifiers,
+// but since this arcane concept is already implemented why not keep it.
+
+} // namespace utl::predef
+
+#endif
+#endif // module utl::predef
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::profiler
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_profiler.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PROFILER)
+#ifndef UTLHEADERGUARD_PROFILER
+#define UTLHEADERGUARD_PROFILER
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>   // sort()
+#include <chrono>      // chrono::steady_clock, chrono::duration_cast<>, std::chrono::milliseconds
+#include <cstdlib>     // atexit()
+#include <fstream>     // ofstream
+#include <iomanip>     // setprecision(), setw()
+#include <ios>         // streamsize, fixed,
+#include <iostream>    // cout
+#include <ostream>     // ostream
+#include <sstream>     // ostringstream
+#include <string>      // string
+#include <string_view> // string_view
+#include <vector>      // vector<>
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// Macros for quick code profiling.
+// Trivially simple, yet effective way of finding bottlenecks without any tooling.
+//
+// Can also be used to benchmark stuff "quick & dirty" due to doing all the time measuring
+// and table formatting one would usually implement in their benchmarks. A proper bechmark
+// suite of course would include support for automatic reruns and gather statistical data,
+// but in prototying this is often not necessary.
+//
+// Resolving time recording inside recursion took some thinking, but ended up being quite simple in
+// implementation. See the docs for more details on that.
+//
+// Currently, the overhead of profiling is barely different to the overhead of just time measurement,
+// this also took a bit of thinking but in the end there is a nice solution that uses static variables
+// to offload things that can only be done once to their initialization, and then links local variables
+// to 'static' markers of the callsite recording. See 'UTL_PROFILE' macro for some more details.
+
+// ____________________ IMPLEMENTATION ____________________
+
+namespace utl::profiler {
+
+// ==========================
+// --- Profiler Internals ---
+// ==========================
+
+inline std::string _format_call_site(std::string_view file, int line, std::string_view func) {
+    const std::string_view filename = file.substr(file.find_last_of("/\\") + 1);
+
+    return (std::ostringstream() << filename << ":" << line << ", " << func << "()").str();
+}
+
+#if !defined(UTL_PROFILER_OPTION_USE_x86_INTRINSICS_FOR_FREQUENCY)
+using clock = std::chrono::steady_clock;
+#else
+struct clock {
+    using rep                   = unsigned long long int;
+    using period                = std::ratio<1, UTL_PROFILER_OPTION_USE_x86_INTRINSICS_FOR_FREQUENCY>;
+    using duration              = std::chrono::duration<rep, period>;
+    using time_point            = std::chrono::time_point<clock>;
+    static const bool is_steady = true;
+
+    static time_point now() noexcept {
+        unsigned int low, high;
+        asm volatile("rdtsc" : "=a"(low), "=d"(high)); // GCC/clang asm intrinsic, MSVC uses __asm() with more overhead
+        return time_point(duration(static_cast<rep>(high) << 32 | low));
+    }
+};
+#endif
+
+using duration   = clock::duration;
+using time_point = clock::time_point;
+
+inline const time_point _program_entry_time_point = clock::now();
+
+struct _record {
+    const char* file;
+    int         line;
+    const char* func;
+    const char* label;
+    duration    accumulated_time;
+};
+
+inline void _utl_profiler_atexit(); // predeclaration, implementation has circular dependency with 'RecordManager'
+
+// =========================
+// --- Profiler Classess ---
+// =========================
+
+class _record_manager {
+private:
+    _record data;
+
+public:
+    inline static std::vector<_record> records;
+    inline static int                  exclusive_recursion{};
+    int                                recursion{};
+
+    void add_time(duration time) noexcept { this->data.accumulated_time += time; }
+
+    _record_manager() = delete;
+
+    _record_manager(const char* file, int line, const char* func, const char* label)
+        : data({file, line, func, label, duration(0)}) {
+        // 'file', 'func', 'label' are guaranteed to be string literals, since we want to
+        // have as little overhead as possible during runtime, we can just save raw pointers
+        // and convert them to nicer types like 'std::string_view' later in the formatting stage
+
+        // Profiler ever gets called => register result output at 'std::exit()'
+        static bool first_call = true;
+        if (first_call) {
+            std::atexit(_utl_profiler_atexit);
+            first_call = false;
+        }
+    }
+
+    ~_record_manager() { records.emplace_back(this->data); }
+};
+
+// We need 4 slightly different timer classes, so might as well deduplicate some code by moving it into a base class
+struct _timer_base {
+protected:
+    time_point       start;
+    _record_manager* record_manager;
+    // we could use 'std::optional<std::reference_wrapper<RecordManager>>',
+    // but that would inctroduce more dependencies for no real reason
+public:
+    constexpr operator bool() const noexcept { return true; }
+
+    _timer_base(_record_manager* manager) : record_manager(manager) {}
+};
+
+// Simple class that records the time of its creation and destruction and records it into the connected 'RecordManager'
+struct _scope_timer : public _timer_base {
+    _scope_timer(_record_manager* manager) : _timer_base(manager) {
+        if (this->record_manager->recursion++ == 0) this->start = clock::now();
+        // this check prevent timer from double-counting time spent inside
+        // of it's own scope due to recursive calls
+    }
+
+    ~_scope_timer() {
+        if (--this->record_manager->recursion == 0) this->record_manager->add_time(clock::now() - this->start);
+    }
+};
+
+// Same thing as '_scope_timer' except it uses global static 'exclusive_recursion' instead of regular 'recursion' that
+// is specific to each '_record_manager'. This effecively means no '_exclusive_scope_timer''s will count time as long a
+// single instance of another exclusive timer exists. This allows us to resolve som tricky situations such as recursion
+struct _exclusive_scope_timer : public _timer_base {
+    _exclusive_scope_timer(_record_manager* manager) : _timer_base(manager) {
+        if (this->record_manager->exclusive_recursion++ == 0) this->start = clock::now();
+    }
+
+    ~_exclusive_scope_timer() {
+        if (--this->record_manager->exclusive_recursion == 0)
+            this->record_manager->add_time(clock::now() - this->start);
+    }
+};
+
+// Same thing as '_scope_timer', except instead of destructor it uses an explicitly called method to record time.
+// We need it to implement code-segment profiling with 'UTL_PROFILER_BEGIN' and 'UTL_PROFILER_END'
+struct _segment_timer : public _timer_base {
+    _segment_timer(_record_manager* manager) : _timer_base(manager) {
+        if (this->record_manager->recursion++ == 0) this->start = clock::now();
+    }
+
+    void finish() {
+        if (--this->record_manager->recursion == 0) this->record_manager->add_time(clock::now() - this->start);
+    }
+};
+
+struct _exclusive_segment_timer : public _timer_base {
+    _exclusive_segment_timer(_record_manager* manager) : _timer_base(manager) {
+        if (this->record_manager->exclusive_recursion++ == 0) this->start = clock::now();
+    }
+
+    void finish() {
+        if (--this->record_manager->exclusive_recursion == 0)
+            this->record_manager->add_time(clock::now() - this->start);
+    }
+};
+
+// ==================================
+// --- Profiler Exit & Formatting ---
+// ==================================
+
+inline void _utl_profiler_atexit() {
+    // NOTE:
+    // Lots of ugly formatting stuff here, but it works, so a nicer rewrite is low-priority.
+    // Would make a lot more sense to format all the stuff into a `matrix` of strings first,
+    // and then do all the sorting/column width adjustment and etc. Should be faster (which
+    // doesn't really matter here) and more concise too.
+
+    const auto total_runtime = clock::now() - _program_entry_time_point;
+
+    std::ostream* os = &std::cout;
+
+    // Convenience functions
+    const auto duration_to_sec = [](duration duration) -> double {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1e9;
+    };
+
+    const auto duration_percentage = [&](double duration_sec) -> double {
+        const double total_runtime_sec = duration_to_sec(total_runtime);
+        return (duration_sec / total_runtime_sec) * 100.;
+    };
+
+    const auto float_printed_size = [](double value, std::streamsize precision, decltype(std::fixed) format,
+                                       std::string_view postfix) -> std::streamsize {
+        std::ostringstream ss;
+        ss << std::setprecision(precision) << format << value << postfix;
+        return ss.str().size(); // can be done faster but we don't really care here
+    };
+
+    const auto repeat_hline_symbol = [](std::streamsize repeats) -> std::string {
+        return std::string(static_cast<size_t>(repeats), '-');
+    };
+
+    constexpr std::streamsize  duration_precision = 2;
+    constexpr auto             duration_format    = std::fixed;
+    constexpr std::string_view duration_postfix   = " s";
+
+    constexpr std::streamsize  percentage_precision = 1;
+    constexpr auto             percentage_format    = std::fixed;
+    constexpr std::string_view percentage_postfix   = "%";
+
+    // Sort records by their accumulated time
+    std::sort(_record_manager::records.begin(), _record_manager::records.end(),
+              [](const _record& l, const _record& r) { return l.accumulated_time > r.accumulated_time; });
+
+    // Collect max length of each column (for proper formatting)
+    constexpr std::string_view column_name_call_site  = "Call Site";
+    constexpr std::string_view column_name_label      = "Label";
+    constexpr std::string_view column_name_duration   = "Time";
+    constexpr std::string_view column_name_percentage = "Time %";
+
+    std::streamsize max_length_call_site  = column_name_call_site.size();
+    std::streamsize max_length_label      = column_name_label.size();
+    std::streamsize max_length_duration   = column_name_duration.size();
+    std::streamsize max_length_percentage = column_name_percentage.size();
+
+    for (const auto& record : _record_manager::records) {
+        const std::string call_site    = _format_call_site(record.file, record.line, record.func);
+        const std::string label        = record.label;
+        const double      duration_sec = duration_to_sec(record.accumulated_time);
+
+        // 'Call Site' column
+        const std::streamsize length_call_site = call_site.size();
+        if (max_length_call_site < length_call_site) max_length_call_site = length_call_site;
+
+        // 'Label' column
+        const std::streamsize length_label = label.size();
+        if (max_length_label < length_label) max_length_label = length_label;
+
+        // 'Time' column
+        const std::streamsize length_duration =
+            float_printed_size(duration_sec, duration_precision, duration_format, duration_postfix);
+        if (max_length_duration < length_duration) max_length_duration = length_duration;
+
+        // 'Time %' column
+        const auto            percentage = duration_percentage(duration_sec);
+        const std::streamsize length_percentage =
+            float_printed_size(percentage, percentage_precision, percentage_format, percentage_postfix);
+        if (max_length_percentage < length_percentage) max_length_percentage = length_percentage;
+    }
+
+    // Print formatted profiler header
+    constexpr std::string_view HEADER_TEXT = " UTL PROFILING RESULTS ";
+
+    const std::streamsize total_table_length = sizeof("| ") - 1 + max_length_call_site + sizeof(" | ") - 1 +
+                                               max_length_label + sizeof(" | ") - 1 + max_length_duration +
+                                               sizeof(" | ") - 1 + max_length_percentage + sizeof(" |") -
+                                               1; // -1 because sizeof(char[]) accounts for invisible '\0' at the end
+
+    const std::streamsize header_text_length = HEADER_TEXT.size();
+    const std::streamsize header_left_pad    = (total_table_length - header_text_length) / 2;
+    const std::streamsize header_right_pad   = total_table_length - header_text_length - header_left_pad;
+
+    *os << "\n"
+        << repeat_hline_symbol(header_left_pad + 1) << HEADER_TEXT << repeat_hline_symbol(header_right_pad + 1)
+        << '\n'
+        // + 1 makes header hline extend 1 character past the table on both sides
+        << "\n"
+        << " Total runtime -> " << std::setprecision(duration_precision) << duration_format
+        << duration_to_sec(total_runtime) << " sec\n"
+        << "\n";
+
+    // Print formatted table header
+    *os << " | " << std::setw(max_length_call_site) << column_name_call_site << " | " << std::setw(max_length_label)
+        << column_name_label << " | " << std::setw(max_length_duration) << column_name_duration << " | "
+        << std::setw(max_length_percentage) << column_name_percentage << " |\n";
+
+    *os << " |"
+        << repeat_hline_symbol(max_length_call_site + 2) // add 2 to account for delimers not having spaces in hline
+        << "|" << repeat_hline_symbol(max_length_label + 2) << "|" << repeat_hline_symbol(max_length_duration + 2)
+        << "|" << repeat_hline_symbol(max_length_percentage + 2) << "|\n";
+
+    *os << std::setfill(' '); // reset the fill so we don't mess with table contents
+
+
+    // Print formatted table contents
+    for (const auto& record : _record_manager::records) {
+        const std::string call_site    = _format_call_site(record.file, record.line, record.func);
+        const std::string label        = record.label;
+        const double      duration_sec = duration_to_sec(record.accumulated_time);
+        const double      percentage   = duration_percentage(duration_sec);
+
+        // Join floats with their postfixes into a single string so they are properly handled by std::setw()
+        // (which only affects the first value leading to a table misaligned by postfix size)
+        std::ostringstream ss_duration;
+        ss_duration << std::setprecision(duration_precision) << duration_format << duration_sec << duration_postfix;
+
+        std::ostringstream ss_percentage;
+        ss_percentage << std::setprecision(percentage_precision) << percentage_format << percentage
+                      << percentage_postfix;
+
+        *os << " | " << std::setw(max_length_call_site) << call_site << " | " << std::setw(max_length_label) << label
+            << " | " << std::setw(max_length_duration) << ss_duration.str() << " | " << std::setw(max_length_percentage)
+            << ss_percentage.str() << " |\n";
+    }
+}
+
+// ========================
+// --- Profiler Codegen ---
+// ========================
+
+#define _utl_profiler_concat_tokens(a, b) a##b
+#define _utl_profiler_concat_tokens_wrapper(a, b) _utl_profiler_concat_tokens(a, b)
+#define _utl_profiler_add_uuid(varname_) _utl_profiler_concat_tokens_wrapper(varname_, __LINE__)
+// This macro creates token 'varname_##__LINE__' from 'varname_'.
+//
+// The reason we can't just write it as is, is that function-macros only expands their macro-arguments
+// if neither the stringizing operator # nor the token-pasting operator ## are applied to the arguments
+// inside the macro body.
+//
+// Which means in a simple 'varname_##__LINE__' macro '__LINE__' doesn't expand to it's value.
+//
+// We can get around this fact by introducing indirection,
+// '__LINE__' gets expanded in '_utl_profiler_concat_tokens_wrapper()'
+// and then tokenized and concatenated in '_utl_profiler_concat_tokens()'
+
+// --- Scope profiling ---
+// -----------------------
+
+#define UTL_PROFILER(label_)                                                                                           \
+    constexpr bool _utl_profiler_add_uuid(utl_profiler_macro_guard_) = true;                                           \
+                                                                                                                       \
+    static_assert(_utl_profiler_add_uuid(utl_profiler_macro_guard_), "UTL_PROFILE is a multi-line macro.");            \
+                                                                                                                       \
+    static utl::profiler::_record_manager _utl_profiler_add_uuid(utl_profiler_record_manager_)(__FILE__, __LINE__,     \
+                                                                                               __func__, label_);      \
+                                                                                                                       \
+    if constexpr (const utl::profiler::_scope_timer _utl_profiler_add_uuid(utl_profiler_scope_timer_){                 \
+                      &_utl_profiler_add_uuid(utl_profiler_record_manager_)})
+// Note 1:
+//
+//    constexpr bool ... = true;
+//    static_assert(..., "UTL_PROFILE is a multi-line macro.");
+//
+// is reponsible for preventing accidental errors caused by using macro like this:
+//
+//    for (...) UTL_PROFILER("") function(); // will only loop the first line of the multi-line macro
+//
+// If someone tries to write it like this, the constexpr bool variable will be "pulled" into a narrower scope,
+// causing 'static_assert()' to fail due to using undeclared identifier. Since the line with undeclared identifier
+// gets expanded, the user will be able to see the assert message.
+//
+// Note 2:
+//
+// By separating "record management" into a static variable and "actual timing" into a non-static one,
+// we can avoid additional overhead from having to locate the record, corresponding to the profiled source location.
+// (an operation that requires a non-trivial vector/map lookup with string comparisons)
+//
+// Static variable initializes its record once and timer does the bare minimum of work - 2 calls to 'now()' to get
+// timing, one addition to accumulated time and a check for recursion (so it can skip time appropriately).
+//
+//  Note 3:
+//
+// _utl_profiler_add_uuid(...) ensures no identifier collisions when several profilers exist in a single scope.
+// Since in this context 'uuid' is a line number, the only case in which ids can collide is when multiple profilers
+// are declated on the same line, which I assume no sane person would do. And even if they would, that would simply
+// lead to a compiler error. Can't really do better than that without resorting to non-standard macros like
+// '__COUNTER__' for 'uuid' creation
+
+#define UTL_PROFILER_EXCLUSIVE(label_)                                                                                 \
+    constexpr bool _utl_profiler_add_uuid(utl_profiler_macro_guard_) = true;                                           \
+                                                                                                                       \
+    static_assert(_utl_profiler_add_uuid(utl_profiler_macro_guard_), "UTL_PROFILER_EXCLUSIVE is a multi-line macro."); \
+                                                                                                                       \
+    static utl::profiler::_record_manager _utl_profiler_add_uuid(utl_profiler_record_manager_)(__FILE__, __LINE__,     \
+                                                                                               __func__, label_);      \
+                                                                                                                       \
+    if constexpr (const utl::profiler::_exclusive_scope_timer _utl_profiler_add_uuid(utl_profiler_scope_timer_){       \
+                      &_utl_profiler_add_uuid(utl_profiler_record_manager_)})
+// Note:
+//
+// Exact same thing as a regular UTL_PROFILER() but uses '_exclusive_scope_timer' instead.
+// The reason we need this for recursion is nicely explained in the docs.
+
+// --- Segment profiling ---
+// -------------------------
+
+#define UTL_PROFILER_BEGIN(segment_label_, label_)                                                                     \
+    static utl::profiler::_record_manager utl_profiler_record_manager_##segment_label_(__FILE__, __LINE__, __func__,   \
+                                                                                       label_);                        \
+    utl::profiler::_segment_timer         utl_profiler_segment_timer_##segment_label_(                                 \
+        &utl_profiler_record_manager_##segment_label_)
+
+#define UTL_PROFILER_END(segment_label_) utl_profiler_segment_timer_##segment_label_.finish()
+// Note 1:
+//
+// Last semicolon is intentiomally skipped so macro requires it at the end and
+// doesn't mess up auto code formatters that have a dislike for statement macros.
+//
+// Note 2:
+//
+// The idea here exactly the same as with scope profiles, except instead of '_scope_timer' we use '_segment_timer'
+// that records time on a '.finish()' call instead of destructor. We can put this call inside the END macro
+// and have a nice 2-macro API for profiling segments without creating a scope.
+
+#define UTL_PROFILER_EXCLUSIVE_BEGIN(segment_label_, label_)                                                           \
+    static utl::profiler::_record_manager   utl_profiler_record_manager_##segment_label_(__FILE__, __LINE__, __func__, \
+                                                                                         label_);                      \
+    utl::profiler::_exclusive_segment_timer utl_profiler_segment_timer_##segment_label_(                               \
+        &utl_profiler_record_manager_##segment_label_)
+
+#define UTL_PROFILER_EXCLUSIVE_END(segment_label_) utl_profiler_segment_timer_##segment_label_.finish()
+
+} // namespace utl::profiler
+
+#endif
+#endif // macro-module UTL_PROFILER
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::progressbar
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_progressbar.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PROGRESSBAR)
+#ifndef UTLHEADERGUARD_PROGRESSBAR
+#define UTLHEADERGUARD_PROGRESSBAR
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // fill_n
+#include <chrono>    // chrono::steady_clock, chrono::time_point<>, chrono::duration_cast<>, chrono::seconds
+#include <cmath>     // floor()
+#include <cstddef>   // size_t
+#include <iomanip>   // setprecision()
+#include <ios>       // fixed
+#include <iostream>  // cout
+#include <iterator>  // ostreambuf_iterator<>
+#include <ostream>   // ostream
+#include <sstream>   // ostringstream
+#include <string>    // string
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// Simple progress bars for terminal applications. Rendered in ASCII on the main thread with manual updates
+// for maximal compatibility. Perhaps can be extended with some fancier async options that display animations.
+//
+// # ::set_ostream() #
+// Sets ostream used for progress bars.
+//
+// # ::Percentage #
+// Proper progress bar, uses carriage return escape sequence (\r) to render new states in the same spot.
+// Shows an estimate of remaining time.
+//
+// # ::Ruler #
+// Primitive & lightweight progress bar, useful when terminal has no proper support for escape sequences.
+
+// ____________________ IMPLEMENTATION ____________________
+
+namespace utl::progressbar {
+
+inline std::ostream* _output_stream = &std::cout;
+
+inline void set_ostream(std::ostream& new_ostream) { _output_stream = &new_ostream; }
+
+class Percentage {
+private:
+    char done_char;
+    char not_done_char;
+    bool show_time_estimate;
+
+    std::size_t length_total;   // full   bar length
+    std::size_t length_current; // filled bar length
+
+    double last_update_percentage;
+    double update_rate;
+
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = std::chrono::time_point<Clock>;
+
+    TimePoint timepoint_start; // used to estimate remaining time
+    TimePoint timepoint_current;
+
+    int previous_string_length; // used to properly return the carriage when dealing with changed string size
+
+    void draw_progressbar(double percentage) {
+        const auto displayed_percentage = this->update_rate * std::floor(percentage / this->update_rate);
+        // floor percentage to a closest multiple of 'update_rate' for nicer display
+        // since actual updates are only required to happen no more ofter than 'update_rate'
+        // and don't have to correspond to exact multiples of it
+
+        // Estimate remaining time (linearly) and format it min + sec
+        const auto time_elapsed       = this->timepoint_current - this->timepoint_start;
+        const auto estimate_full      = time_elapsed / percentage;
+        const auto estimate_remaining = estimate_full - time_elapsed;
+
+        const auto estimate_remaining_sec = std::chrono::duration_cast<std::chrono::seconds>(estimate_remaining);
+
+        const auto displayed_min = (estimate_remaining_sec / 60ll).count();
+        const auto displayed_sec = (estimate_remaining_sec % 60ll).count();
+
+        const bool show_min  = (displayed_min != 0);
+        const bool show_sec  = (displayed_sec != 0) && !show_min;
+        const bool show_time = (estimate_remaining_sec.count() > 0);
+
+        std::ostringstream ss;
+
+        // Print bar
+        ss << '[';
+        std::fill_n(std::ostreambuf_iterator<char>(ss), this->length_current, this->done_char);
+        std::fill_n(std::ostreambuf_iterator<char>(ss), this->length_total - this->length_current, this->not_done_char);
+        ss << ']';
+
+        // Print percentage
+        ss << ' ' << std::fixed << std::setprecision(2) << 100. * displayed_percentage << '%';
+
+        // Print time estimate
+        if (this->show_time_estimate && show_time) {
+            ss << " (remaining:";
+            if (show_min) ss << ' ' << displayed_min << " min";
+            if (show_sec) ss << ' ' << displayed_sec << " sec";
+            ss << ')';
+        }
+
+        const std::string bar_string = ss.str();
+
+        // Add spaces at the end to overwrite the previous string if it was longer that current
+        const int current_string_length = static_cast<int>(bar_string.length());
+        const int string_length_diff    = this->previous_string_length - current_string_length;
+
+        if (string_length_diff > 0) { std::fill_n(std::ostreambuf_iterator<char>(ss), string_length_diff, ' '); }
+
+        this->previous_string_length = current_string_length;
+
+        // Return the carriage
+        (*_output_stream) << ss.str(); // don't reuse 'bar_string', now 'ss' can also contain spaces at the end
+        (*_output_stream) << '\r';
+        (*_output_stream).flush();
+        // '\r' returns cursor to the beginning of the line => most sensible consoles will
+        // render render new lines over the last one. Otherwise every update produces a
+        // bar on a new line, which looks worse but isn't critical for the purpose.
+    }
+
+public:
+    Percentage(char done_char = '#', char not_done_char = '.', std::size_t bar_length = 30, double update_rate = 1e-2,
+               bool show_time_estimate = true)
+        : done_char(done_char), not_done_char(not_done_char), show_time_estimate(show_time_estimate),
+          length_total(bar_length), length_current(0), last_update_percentage(0), update_rate(update_rate),
+          timepoint_start(Clock::now()), previous_string_length(static_cast<int>(bar_length) + sizeof("[] 100.00%")) {}
+
+    void start() {
+        this->last_update_percentage = 0.;
+        this->length_current         = 0;
+        this->timepoint_start        = Clock::now();
+        (*_output_stream) << '\n';
+    }
+
+    void set_progress(double percentage) {
+        if (percentage - this->last_update_percentage <= this->update_rate) return;
+
+        this->last_update_percentage = percentage;
+        this->length_current         = static_cast<std::size_t>(percentage * static_cast<double>(this->length_total));
+        this->timepoint_current      = Clock::now();
+        this->draw_progressbar(percentage);
+    }
+
+    void finish() {
+        this->last_update_percentage = 1.;
+        this->length_current         = this->length_total;
+        this->draw_progressbar(1.);
+        (*_output_stream) << '\n';
+    }
+};
+
+class Ruler {
+private:
+    char done_char;
+
+    std::size_t length_total;
+    std::size_t length_current;
+
+public:
+    Ruler(char done_char = '#') : done_char(done_char), length_total(51), length_current(0) {}
+
+    void start() {
+        this->length_current = 0;
+
+        (*_output_stream) << '\n'
+                          << " 0    10   20   30   40   50   60   70   80   90   100%\n"
+                          << " |----|----|----|----|----|----|----|----|----|----|\n"
+                          << ' ';
+    }
+
+    void set_progress(double percentage) {
+        const std::size_t length_new = static_cast<std::size_t>(percentage * static_cast<double>(this->length_total));
+
+        if (length_new > length_current) {
+            const auto chars_to_add = length_new - this->length_current;
+            std::fill_n(std::ostreambuf_iterator<char>(*_output_stream), chars_to_add, this->done_char);
+        }
+
+        this->length_current = length_new;
+    }
+
+    void finish() {
+        if (this->length_total > this->length_current) {
+            const auto chars_to_add = this->length_total - this->length_current;
+            std::fill_n(std::ostreambuf_iterator<char>(*_output_stream), chars_to_add, this->done_char);
+        }
+
+        this->length_current = this->length_total;
+
+        (*_output_stream) << '\n';
+    }
+};
+
+} // namespace utl::progressbar
+
+#endif
+#endif // module utl::progressbar
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::random
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_random.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_RANDOM)
+#ifndef UTLHEADERGUARD_RANDOM
+#define UTLHEADERGUARD_RANDOM
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>        // min(), max(), iter_swap(), sort(), push_heap(), pop_heap()
+#include <array>            // array<>
+#include <atomic>           // atomic<>
+#include <cassert>          // assert()
+#include <chrono>           // high_resolution_clock
+#include <cstdint>          // uint64_t
+#include <exception>        // exception_ptr, current_exception(), rethrow_exception()
+#include <initializer_list> // initializer_list<>
+#include <iterator>         // distance(), next(), advance()
+#include <limits>           // numeric_limits<>::digits, numeric_limits<>::min(), numeric_limits<>::max()
+#include <mutex>            // mutex, lock_guard<>
+#include <random>           // random_device, std::uniform_int_distribution<>,
+                            // std::uniform_real_distribution<>, generate_canonical<>
+#include <thread>           // this_thread::get_id(), thread::id, thread, thread::hardware_concurrency()
+#include <type_traits>      // is_integral_v<>
+#include <unordered_set>    // unordered_set<>
+#include <utility>          // declval<>()
+#include <vector>           // vector<>, hash<>
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// Implements a proper modern PRNG engine, compatible with std <random>.
+// Adds 'sensible std <random> wrappers' for people who aren't fond of writing
+// 3 lines code just to get a simple rand value.
+//
+// # XorShift64StarGenerator #
+// Random 'std::uint64_t' generator that satisfies uniform random number generator requirements
+// from '<random>' (see https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator).
+// Implementation "XorShift64* suggested by Marsaglia G. in 2003 "Journal of Statistical Software"
+// (see https://www.jstatsoft.org/article/view/v008i14).
+// Slightly faster than 'std::rand()', while providing higher quality random.
+// Significantly faster than 'std::mt19937'.
+// State consists of a single 'std::uint64_t', requires seed >= 1.
+//
+// # xorshift64star #
+// Global instance of XorShift64StarGenerator.
+//
+// # ::seed(), ::seed_with_time(), ::seed_with_random_device() #
+// Seeds random with value/current_time/random_device.
+// Random device is a better source of entropy, however it's more expensive to initialize
+// than just taking current time with <ctime>, in some cases a "worse by lightweigh" can
+// be prefered.
+//
+// # ::rand_int(), ::rand_uint(), ::rand_float(), ::rand_double() #
+// Random value in [min, max] range.
+// Floats with no parameters assume range [0, 1].
+//
+// # ::rand_bool() #
+// Randomly chooses 0 or 1.
+//
+// # ::rand_choice() #
+// Randomly chooses a value from initializer list.
+//
+// # ::rand_linear_combination() #
+// Produces "c A + (1-c) B" with random "0 < c < 1" assuming objects "A", "B" support arithmetic operations.
+// Useful for vector and color operations.
+
+// ____________________ IMPLEMENTATION ____________________
+
+// ======================================
+// --- Ugly platform-specific entropy ---
+// ======================================
+
+// MSVC
+#if defined(UTL_RANDOM_USE_INTRINSICS) && !defined(utl_random_cpu_counter) && defined(_MSC_VER)
+#if defined(_M_IX86)
+#include <intrin.h>
+#define utl_random_cpu_counter __rdtsc()
+#endif
+#endif
+
+// GCC
+#if defined(UTL_RANDOM_USE_INTRINSICS) && !defined(utl_random_cpu_counter) && defined(__GNUC__)
+#if __has_builtin(__builtin_ia32_rdtsc)
+#define utl_random_cpu_counter __builtin_ia32_rdtsc()
+#endif
+#endif
+
+// clang
+#if defined(UTL_RANDOM_USE_INTRINSICS) && !defined(utl_random_cpu_counter) && !defined(__GNUC__) && defined(__clang__)
+#if __has_builtin(__builtin_readcyclecounter) && __has_include(<xmmintrin.h>)
+#include <xmmintrin.h>
+#define utl_random_cpu_counter __builtin_readcyclecounter()
+#endif
+#endif
+
+// Fallback onto a constant that changes with each compilation,
+// not good, but better than nothing
+#if !defined(utl_random_cpu_counter)
+#include <string>
+#define utl_random_cpu_counter std::hash<std::string>{}(std::string(__TIME__))
+#endif
+
+namespace utl::random {
+
+// ============================
+// --- Implementation utils ---
+// ============================
+
+
+// --- Type traits ---
+// -------------------
+
+#define utl_random_define_trait(trait_name_, ...)                                                                      \
+    template <class T, class = void>                                                                                   \
+    struct trait_name_ : std::false_type {};                                                                           \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+
+
+utl_random_define_trait(_is_seed_seq,
+                        std::declval<T>().generate(std::declval<std::uint32_t*>(), std::declval<std::uint32_t*>()));
+// this type trait is necessary to restrict template constructors & seed function that take 'SeedSeq&& seq', otherwise
+// they will get pick instead of regular seeding methods for even for integer conversions. This is how standard library
+// seems to do it (based on GCC implementation) so we follow their API.
+
+utl_random_define_trait(_has_jump, std::declval<T&>().jump());
+utl_random_define_trait(_has_nonce, std::declval<T&>().set_nonce(std::declval<T&>().get_nonce()));
+utl_random_define_trait(_has_counter, std::declval<T&>().set_counter(std::declval<T&>().get_counter()));
+// used to pick a way of splitting generators into independent streams
+
+utl_random_define_trait(_has_fill, std::declval<T&>().fill(std::declval<typename T::result_type*>(),
+                                                           std::declval<typename T::result_type*>()));
+// generators with a specialized bulk generation
+
+utl_random_define_trait(_has_distribution_fill,
+                        std::declval<const T&>().fill(std::declval<std::minstd_rand&>(),
+                                                      std::declval<typename T::result_type*>(),
+                                                      std::declval<typename T::result_type*>()));
+// distributions with a bulk generation, signature of 'fill()' doesn't depend on the generator type
+
+#undef utl_random_define_trait
+
+template <class>
+constexpr bool _always_false_v = false;
+
+template <bool Cond>
+using _require = std::enable_if_t<Cond, bool>; // makes SFINAE a bit less cumbersome
+
+// clang-format off
+template<class T> struct _wider { static_assert(_always_false_v<T>, "Missing specialization."); };
+
+template<> struct _wider<std::uint8_t > { using type = std::uint16_t; };
+template<> struct _wider<std::uint16_t> { using type = std::uint32_t; };
+template<> struct _wider<std::uint32_t> { using type = std::uint64_t; };
+template<> struct _wider<std::uint64_t> { using type = void; };
+
+template<class T> using _wider_t = typename _wider<T>::type;
+
+template <class T> constexpr bool _has_wider = !std::is_void_v<_wider_t<T>>;
+// clang-format on
+
+// --- Bit twiddling utils ---
+// ---------------------------
+
+// Merging integers into the bits of a larger one
+[[nodiscard]] constexpr std::uint64_t _merge_uint32_into_uint64(std::uint32_t a, std::uint32_t b) {
+    return static_cast<std::uint64_t>(a) | (static_cast<std::uint64_t>(b) << 32);
+}
+
+// Helper method to crush large uints to uint32_t,
+// inspired by Melissa E. O'Neil's randutils https://gist.github.com/imneme/540829265469e673d045
+template <class T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) <= 8, bool> = true>
+[[nodiscard]] constexpr std::uint32_t _crush_to_uint32(T value) {
+    if constexpr (sizeof(value) <= 4) {
+        return std::uint32_t(value);
+    } else {
+        std::uint64_t res = value;
+        res *= 0xbc2ad017d719504d;
+        return static_cast<std::uint32_t>(res ^ (res >> 32));
+    }
+}
+
+// Seed sequence helpers
+template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+std::uint32_t _seed_seq_to_uint32(SeedSeq&& seq) {
+    std::array<std::uint32_t, 1> temp;
+    seq.generate(temp.begin(), temp.end());
+    return temp[0];
+}
+
+template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+std::uint64_t _seed_seq_to_uint64(SeedSeq&& seq) {
+    std::array<std::uint32_t, 2> temp;
+    seq.generate(temp.begin(), temp.end());
+    return _merge_uint32_into_uint64(temp[0], temp[1]);
+}
+
+// 'std::rotl()' from C++20, used by many PRNGs,
+// have to use long name because platform-specific includes declare '_rotl' as a macro
+template <class T>
+[[nodiscard]] constexpr T _rotl_value(T x, int k) noexcept {
+    return (x << k) | (x >> (std::numeric_limits<T>::digits - k));
+}
+
+// Some generators shouldn't be zero initialized, in a perfect world the user would never
+// do that, but in case they happened to do so regardless we can remap 0 to some "weird"
+// value that isn't like to intersect with any other seeds generated by the user. Rejecting
+// zero seeds completely wouldn't be appropriate for compatibility reasons.
+template <class T, std::size_t N>
+[[nodiscard]] constexpr bool _is_zero_state(const std::array<T, N>& state) {
+    for (const auto& e : state)
+        if (e != 0) return false;
+    return true;
+}
+
+template <class T>
+constexpr T _default_seed = std::numeric_limits<T>::max() / 2 + 1;
+// an "overall decent" default seed - doesn't gave too many zeroes,
+// unlikely to accidentaly match with a user-defined seed
+
+// Jump function of Xoshiro family, advances 'gen' with state 's' by a number of steps encoded in the
+// 'polynomial', this is equivalent to (but much faster than) calling 'gen()' that many times
+template <class Gen, class T>
+constexpr void _xoshiro_jump(Gen& gen, std::array<T, 4>& s, const std::array<T, 4>& polynomial) noexcept {
+    std::array<T, 4> res{};
+
+    for (const T word : polynomial) {
+        for (int b = 0; b < std::numeric_limits<T>::digits; ++b) {
+            if (word & (T(1) << b))
+                for (std::size_t i = 0; i < res.size(); ++i) res[i] ^= s[i];
+            gen();
+        }
+    }
+
+    s = res;
+}
+
+// Multi-word addition for counters & nonces stored as arrays of 32/64-bit words, least significant word first
+template <class T, std::size_t N>
+constexpr void _add_to_counter(std::array<T, N>& counter, std::uint64_t value, std::size_t first_word = 0) noexcept {
+    static_assert(std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint64_t>);
+
+    for (std::size_t i = first_word; i < N && value; ++i) {
+        if constexpr (std::is_same_v<T, std::uint64_t>) {
+            counter[i] += value;
+            value = counter[i] < value; // carry
+        } else {
+            const std::uint64_t sum = std::uint64_t(counter[i]) + (value & 0xffffffff);
+            counter[i]              = static_cast<std::uint32_t>(sum);
+            value                   = (value >> 32) + (sum >> 32);
+        }
+    }
+}
+
+// --- Constexpr math ---
+// ----------------------
+
+// 'std::exp()', 'std::log()' & 'std::sqrt()' aren't 'constexpr' and their last bit may differ between standard
+// libraries, Ziggurat tables & rare branches of distributions use these instead so generated sequences stay the
+// same on every platform. Accuracy is within a few ULP in the ranges used by distributions.
+
+constexpr double _ln2    = 0.693147180559945309417232121458176568;
+constexpr double _ln2_hi = 6.93147180369123816490e-01; // 'ln(2)' split into exact high part and a low remainder,
+constexpr double _ln2_lo = 1.90821492927058770002e-10; // 'x - k * ln(2)' stays precise for large 'k'
+
+[[nodiscard]] constexpr double _abs(double x) noexcept { return x < 0 ? -x : x; }
+
+[[nodiscard]] constexpr double _exp(double x) noexcept {
+    if (x < -745.) return 0.;
+    if (x > 709.) return std::numeric_limits<double>::infinity();
+
+    // x = k * ln(2) + r, |r| <= ln(2) / 2  =>  exp(x) = 2^k * exp(r)
+    const int    k = static_cast<int>(x / _ln2 + (x < 0 ? -0.5 : 0.5));
+    const double r = (x - k * _ln2_hi) - k * _ln2_lo;
+
+    double term = 1., sum = 1.;
+    for (int n = 1; n < 20; ++n) sum += (term *= r / n); // Taylor series, converges to full precision for |r| < 0.35
+
+    for (int i = 0; i < k; ++i) sum *= 2.;
+    for (int i = 0; i > k; --i) sum *= 0.5;
+    return sum;
+}
+
+[[nodiscard]] constexpr double _log(double x) noexcept {
+    if (x <= 0.) return -std::numeric_limits<double>::infinity();
+
+    // x = m * 2^e, m in [sqrt(2) / 2, sqrt(2))
+    int e = 0;
+    while (x > 1.4142135623730951) x *= 0.5, ++e;
+    while (x < 0.7071067811865476) x *= 2., --e;
+
+    // log(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+    const double s = (x - 1.) / (x + 1.), s2 = s * s;
+
+    double term = s, sum = 0.;
+    for (int n = 1; n < 40; n += 2, term *= s2) sum += term / n;
+
+    return 2. * sum + e * _ln2;
+}
+
+// 'log(1 + x)' that stays precise for tiny 'x', where '1 + x' would round away most (or all) of its bits.
+// Dividing by the rounded 'u - 1' cancels the rounding error of 'u' to first order (D. Goldberg, 1991).
+[[nodiscard]] constexpr double _log1p(double x) noexcept {
+    const double u = 1. + x;
+    if (u == 1.) return x;
+    return _log(u) * (x / (u - 1.));
+}
+
+[[nodiscard]] constexpr double _sqrt(double x) noexcept {
+    if (x <= 0.) return 0.;
+
+    double res = x > 1. ? x : 1.;
+    for (int i = 0; i < 1100; ++i) {
+        const double next = 0.5 * (res + x / res);
+        if (next >= res) break; // Newton iterations decrease monotonically until they converge
+        res = next;
+    }
+    return res;
+}
+
+
+// =========================
+// --- Random Generators ---
+// =========================
+
+// Implementation of several "good" PRNGS.
+//
+// All generators meets uniform random number generator requirements
+// (C++17 and below, see https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator)
+// (C++20 and above, see https://en.cppreference.com/w/cpp/numeric/random/uniform_random_bit_generator)
+
+// Note:
+// Here PRNGs take 'SeedSeq' as a forwaring reference 'SeedSeq&&', while standard PRNGS take 'SeedSeq&',
+// this is how it should've been done in the standard too, but for some reason they only standardized
+// l-value references, perfect forwarding probably just wasn't in use at the time.
+
+namespace generators {
+
+template <class Scalar, std::size_t lanes, int shift, int state_rotation, int result_rotation>
+class _xoshiro_lanes; // multi-lane Xoshiro, defined at the end of the namespace, needs access to the scalar state
+
+// --- 16-bit PRNGs ---
+// --------------------
+
+// Implementation of 16-bit Romu Mono engine from paper by "Mark A. Overton",
+// see https://www.romu-random.org/
+//     https://www.romu-random.org/romupaper.pdf
+//
+// Performance: Excellent
+// Quality:     2/5
+// State:       4 bytes
+//
+// Romu family provides extemely fast non-linear PRNGs, "RomuMono16" is the fastest 16-bit option available
+// that still provides some resemblance of quality. There has been some concerns over the math used
+// in its original paper (see https://news.ycombinator.com/item?id=22447848), however I'd yet to find
+// a faster 16-bit PRNG, so if speed is needed at all cost this one provides it.
+//
+class RomuMono16 {
+public:
+    using result_type = std::uint16_t;
+
+private:
+    std::uint32_t s{}; // notice 32-bit value as a state rather than two 16-bit ints
+
+public:
+    constexpr explicit RomuMono16(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit RomuMono16(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        this->s = (seed & 0x1fffffffu) + 1156979152u; // accepts 29 seed-bits
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->s = _seed_seq_to_uint32(seq);
+
+        if (this->s == 0) this->seed(_default_seed<result_type>);
+    }
+
+    constexpr result_type operator()() noexcept {
+        const result_type result = this->s >> 16;
+        this->s *= 3611795771u;
+        this->s = _rotl_value(this->s, 12);
+        return result;
+    }
+};
+
+// --- 32-bit PRNGs ---
+// --------------------
+
+// Implementation of 32-bit splitmix adopted from MurmurHash3, based on paper by Guy L. Steele,
+// Doug Lea, and Christine H. Flood. 2014. "Fast splittable pseudorandom number generators"
+// see http://marc-b-reynolds.github.io/shf/2017/09/27/LPRNS.html
+//     https://gee.cs.oswego.edu/dl/papers/oopsla14.pdf
+//     https://github.com/umireon/my-random-stuff/blob/e7b17f992955f4dbb02d4016682113b48b2f6ec1/xorshift/splitmix32.c
+//
+// Performance: Excellent
+// Quality:     3/5
+// State:       4 bytes
+//
+// One of the fastest 32-bit generators that requires only a single 'std::uint32_t' of state,
+// making it the smallest state available. Some other PRNGs recommend using it for seeding their state.
+// 32-bit version is somewhat lacking in terms of quality estimate data (relative to the widely used
+// 64-bit version), however it still seems to be quite decent.
+//
+class SplitMix32 {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    result_type s{};
+
+public:
+    constexpr explicit SplitMix32(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit SplitMix32(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept { this->s = seed; }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->s = _seed_seq_to_uint32(seq);
+    }
+
+    constexpr result_type operator()() noexcept {
+        result_type result = (this->s += 0x9e3779b9);
+        result             = (result ^ (result >> 16)) * 0x21f0aaad;
+        result             = (result ^ (result >> 15)) * 0x735a2d97;
+        return result ^ (result >> 15);
+    }
+};
+
+// Implementation of Xoshiro128++ suggested by David Blackman and Sebastiano Vigna,
+// see https://prng.di.unimi.it/
+//     https://prng.di.unimi.it/xoshiro256plusplus.c
+//
+// Performance: Good
+// Quality:     4/5
+// State:       16 bytes
+//
+// Excellent choice as a general purpose 32-bit PRNG.
+// Battle-tested and provides a good statistical quality at an excellent speed.
+//
+class Xoshiro128PP {
+public:
+    using result_type = std::uint32_t;
+
+private:
+    std::array<result_type, 4> s{};
+
+    template <class, std::size_t, int, int, int>
+    friend class _xoshiro_lanes;
+
+public:
+    constexpr explicit Xoshiro128PP(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit Xoshiro128PP(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    // while zero-state is considered invalid, PRNG can still produce 0 as a result
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        SplitMix32 splitmix{seed};
+        this->s[0] = splitmix(); // Xoshiro family recommends using
+        this->s[1] = splitmix(); // splitmix to initialize its state
+        this->s[2] = splitmix();
+        this->s[3] = splitmix();
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        seq.generate(this->s.begin(), this->s.end());
+
+        // ensure we don't hit an invalid all-zero state
+        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+    }
+
+    constexpr result_type operator()() noexcept {
+        const result_type result = _rotl_value(this->s[0] + this->s[3], 7) + this->s[0];
+        const result_type t      = s[1] << 9;
+        this->s[2] ^= this->s[0];
+        this->s[3] ^= this->s[1];
+        this->s[1] ^= this->s[2];
+        this->s[0] ^= this->s[3];
+        this->s[2] ^= t;
+        this->s[3] = _rotl_value(this->s[3], 11);
+        return result;
+    }
+    // Equivalent to 2^64 calls to 'operator()', can be used to generate 2^64 non-overlapping subsequences
+    constexpr void jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
+
+    // Equivalent to 2^96 calls to 'operator()', can be used to generate 2^32 starting points,
+    // from each of which 'jump()' will generate 2^32 non-overlapping subsequences
+    constexpr void long_jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
+};
+
+// Implementation of 32-bit Romu Trio engine from paper by "Mark A. Overton",
+// see https://www.romu-random.org/
+//     https://www.romu-random.org/romupaper.pdf
+//
+// Performance: Excellent
+// Quality:     2/5
+// State:       12 bytes
+//
+// Romu family provides extemely fast non-linear PRNGs, "RomuTrio" is the fastest 32-bit option available
+// that still provides some resemblance of quality. There has been some concerns over the math used
+// in its original paper (see https://news.ycombinator.com/item?id=22447848), however I'd yet to find
+// a faster 32-bit PRNG, so if speed is needed at all cost this one provides it.
+//
+class RomuTrio32 {
+public:
+    using result_type = std::uint32_t;
+
+private:
+    std::array<result_type, 3> s{};
+
+public:
+    constexpr explicit RomuTrio32(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit RomuTrio32(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        SplitMix32 splitmix{seed};
+        this->s[0] = splitmix(); // Like Xoshiro, Romu recommends
+        this->s[1] = splitmix(); // using SplitMix32 to initialize its state
+        this->s[2] = splitmix();
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        seq.generate(this->s.begin(), this->s.end());
+
+        // ensure we don't hit an invalid all-zero state
+        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+    }
+
+    constexpr result_type operator()() noexcept {
+        const result_type xp = this->s[0], yp = this->s[1], zp = this->s[2];
+        this->s[0] = 3323815723u * zp;
+        this->s[1] = yp - xp;
+        this->s[1] = _rotl_value(this->s[1], 6);
+        this->s[2] = zp - yp;
+        this->s[2] = _rotl_value(this->s[2], 22);
+        return xp;
+    }
+};
+
+// --- 64-bit PRNGs ---
+// --------------------
+
+// Implementation of fixed-increment version of Java 8's SplittableRandom generator SplitMix64,
+// see http://dx.doi.org/10.1145/2714064.2660195
+//     http://docs.oracle.com/javase/8/docs/api/java/util/SplittableRandom.html
+//     https://rosettacode.org/wiki/Pseudo-random_numbers/Splitmix64
+//
+// Performance: Excellent
+// Quality:     4/5
+// State:       8 bytes
+//
+// One of the fastest generators passing BigCrush that requires only a single 'std::uint64_t' of state,
+// making it the smallest state available. Some other PRNGs recommend using it for seeding their state.
+//
+class SplitMix64 {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    result_type s{};
+
+public:
+    constexpr explicit SplitMix64(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit SplitMix64(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept { this->s = seed; }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->s = _seed_seq_to_uint64(seq);
+    }
+
+    constexpr result_type operator()() noexcept {
+        std::uint64_t result = (this->s += 0x9E3779B97f4A7C15);
+        result               = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
+        result               = (result ^ (result >> 27)) * 0x94D049BB133111EB;
+        return result ^ (result >> 31);
+    }
+};
+
+// Implementation of Xoshiro256++ suggested by David Blackman and Sebastiano Vigna,
+// see https://prng.di.unimi.it/
+//     https://prng.di.unimi.it/xoshiro256plusplus.c
+//
+// Performance: Good
+// Quality:     4/5
+// State:       32 bytes
+//
+// Excellent choice as a general purpose PRNG.
+// Used by several modern languages as their default.
+//
+class Xoshiro256PP {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    std::array<result_type, 4> s{};
+
+    template <class, std::size_t, int, int, int>
+    friend class _xoshiro_lanes;
+
+public:
+    constexpr explicit Xoshiro256PP(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit Xoshiro256PP(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    // while zero-state is considered invalid, PRNG can still produce 0 as a result
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        SplitMix64 splitmix{seed};
+        this->s[0] = splitmix(); // Xoshiro family recommends using
+        this->s[1] = splitmix(); // splitmix to initialize its state
+        this->s[2] = splitmix();
+        this->s[3] = splitmix();
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->s[0] = _seed_seq_to_uint64(seq); // since seed_seq produces 32-bit ints,
+        this->s[1] = _seed_seq_to_uint64(seq); // we have to generate multiple and then
+        this->s[2] = _seed_seq_to_uint64(seq); // join them into std::uint64_t's to
+        this->s[3] = _seed_seq_to_uint64(seq); // properly initialize the entire state
+
+        // ensure we don't hit an invalid all-zero state
+        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+    }
+
+    constexpr result_type operator()() noexcept {
+        const result_type result = _rotl_value(this->s[0] + this->s[3], 23) + this->s[0];
+        const result_type t      = this->s[1] << 17;
+        this->s[2] ^= this->s[0];
+        this->s[3] ^= this->s[1];
+        this->s[1] ^= this->s[2];
+        this->s[0] ^= this->s[3];
+        this->s[2] ^= t;
+        this->s[3] = _rotl_value(this->s[3], 45);
+        return result;
+    }
+    // Equivalent to 2^128 calls to 'operator()', can be used to generate 2^128 non-overlapping subsequences
+    constexpr void jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+                                                           0x39abdc4529b1661c};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
+
+    // Equivalent to 2^192 calls to 'operator()', can be used to generate 2^64 starting points,
+    // from each of which 'jump()' will generate 2^64 non-overlapping subsequences
+    constexpr void long_jump() noexcept {
+        constexpr std::array<result_type, 4> polynomial = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241,
+                                                           0x39109bb02acbe635};
+        _xoshiro_jump(*this, this->s, polynomial);
+    }
+};
+
+// Implementation of Romu DuoJr engine from paper by "Mark A. Overton",
+// see https://www.romu-random.org/
+//     https://www.romu-random.org/romupaper.pdf
+//
+// Performance: Excellent
+// Quality:     2/5
+// State:       16 bytes
+//
+// Romu family provides extemely fast non-linear PRNGs, "DuoJr" is the fastest 64-bit option available
+// that still provides some resemblance of quality. There has been some concerns over the math used
+// in its original paper (see https://news.ycombinator.com/item?id=22447848), however I'd yet to find
+// a faster 64-bit PRNG, so if speed is needed at all cost this one provides it.
+//
+class RomuDuoJr64 {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    std::array<result_type, 2> s{};
+
+public:
+    constexpr explicit RomuDuoJr64(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit RomuDuoJr64(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        SplitMix64 splitmix{seed};
+        this->s[0] = splitmix(); // Like Xoshiro, Romu recommends
+        this->s[1] = splitmix(); // using SplitMix64 to initialize its state
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->s[0] = _seed_seq_to_uint64(seq); // seed_seq returns 32-bit ints, we have to generate
+        this->s[1] = _seed_seq_to_uint64(seq); // multiple to initialize full state of 64-bit values
+
+        // ensure we don't hit an invalid all-zero state
+        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+    }
+
+    constexpr result_type operator()() noexcept {
+        const result_type res = this->s[0];
+        this->s[0]            = 15241094284759029579u * this->s[1];
+        this->s[1]            = this->s[1] - res;
+        this->s[1]            = _rotl_value(this->s[1], 27);
+        return res;
+    }
+};
+
+// --- CSPRNGs ---
+// ---------------
+
+// Implementation of ChaCha20 CPRNG conforming to RFC 7539 standard
+// see https://datatracker.ietf.org/doc/html/rfc7539
+//     https://www.rfc-editor.org/rfc/rfc7539#section-2.4
+//     https://en.wikipedia.org/wiki/Salsa20
+
+// Quarted-round operation for ChaCha20 stream cipher
+constexpr void _quarter_round(std::uint32_t& a, std::uint32_t& b, std::uint32_t& c, std::uint32_t& d) {
+    a += b, d ^= a, d = _rotl_value(d, 16);
+    c += d, b ^= c, b = _rotl_value(b, 12);
+    a += b, d ^= a, d = _rotl_value(d, 8);
+    c += d, b ^= c, b = _rotl_value(b, 7);
+}
+
+template <std::size_t rounds>
+[[nodiscard]] constexpr std::array<std::uint32_t, 16> _chacha_rounds(const std::array<std::uint32_t, 16>& input) {
+    auto state = input;
+
+    static_assert(rounds % 2 == 0, "ChaCha rounds happen in pairs, total number should be divisible by 2.");
+
+    constexpr std::size_t alternating_round_pairs = rounds / 2;
+    // standard number of ChaCha rounds as per RFC 7539 is 20 (ChaCha20 variation),
+    // however there is a strong case for ChaCha12 being a more sensible default,
+    // at the moment the upper bound of what seems "crackable" is somewhere around 7 rounds,
+    // which is why ChaCha8 is also widely used whenever speed is necessary.
+
+    for (std::size_t i = 0; i < alternating_round_pairs; ++i) {
+        // Column rounds
+        _quarter_round(state[0], state[4], state[8], state[12]);
+        _quarter_round(state[1], state[5], state[9], state[13]);
+        _quarter_round(state[2], state[6], state[10], state[14]);
+        _quarter_round(state[3], state[7], state[11], state[15]);
+
+        // Diagonal rounds
+        _quarter_round(state[0], state[5], state[10], state[15]);
+        _quarter_round(state[1], state[6], state[11], state[12]);
+        _quarter_round(state[2], state[7], state[8], state[13]);
+        _quarter_round(state[3], state[4], state[9], state[14]);
+    }
+
+    for (std::size_t i = 0; i < state.size(); ++i) state[i] += input[i];
+    return state;
+}
+
+// Same rounds applied to several blocks at once, each word of the state is stored as an array over blocks
+// so every quarter-round becomes a set of element-wise operations that can be vectorized
+template <std::size_t rounds, std::size_t blocks>
+[[nodiscard]] constexpr std::array<std::array<std::uint32_t, blocks>, 16>
+_chacha_rounds_multi(const std::array<std::array<std::uint32_t, blocks>, 16>& input) noexcept {
+    auto state = input;
+
+    const auto quarter_round = [&](std::size_t a, std::size_t b, std::size_t c, std::size_t d) {
+        for (std::size_t k = 0; k < blocks; ++k) _quarter_round(state[a][k], state[b][k], state[c][k], state[d][k]);
+    };
+
+    for (std::size_t i = 0; i < rounds / 2; ++i) {
+        quarter_round(0, 4, 8, 12);
+        quarter_round(1, 5, 9, 13);
+        quarter_round(2, 6, 10, 14);
+        quarter_round(3, 7, 11, 15);
+
+        quarter_round(0, 5, 10, 15);
+        quarter_round(1, 6, 11, 12);
+        quarter_round(2, 7, 8, 13);
+        quarter_round(3, 4, 9, 14);
+    }
+
+    for (std::size_t i = 0; i < state.size(); ++i)
+        for (std::size_t k = 0; k < blocks; ++k) state[i][k] += input[i][k];
+    return state;
+}
+
+template <std::size_t rounds>
+class ChaCha {
+public:
+    using result_type = std::uint32_t;
+
+private:
+    // Initial state components
+    std::array<result_type, 8> key{};     // 256-bit key
+    std::array<result_type, 3> nonce{};   // 96-bit nonce
+    std::uint32_t              counter{}; // 32-bit counter
+
+    // Block
+    std::array<result_type, 16> block{};    // holds next 16 random numbers
+    std::size_t                 position{}; // current position in the block
+
+    constexpr static std::array<result_type, 4> constant = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+    // "Magic constants" for ChaCha20 are defined through bit representations of the following char arrays:
+    // { "expa", "nd 3", "2-by", "te k" },
+    // what we have here is exactly that except written as 'std::uint32_t'
+
+    constexpr void generate_new_block() {
+        // Set ChaCha20 initial state as per RFC 7539
+        //
+        //          [ const   const const const ]
+        // State    [ key     key   key   key   ]
+        // matrix = [ key     key   key   key   ]
+        //          [ counter nonce nonce nonce ]
+        //
+        const std::array<std::uint32_t, 16> input = {
+            this->constant[0], this->constant[1], this->constant[2], this->constant[3], //
+            this->key[0],      this->key[1],      this->key[2],      this->key[3],      //
+            this->key[4],      this->key[5],      this->key[6],      this->key[7],      //
+            this->counter,     this->nonce[0],    this->nonce[1],    this->nonce[2]     //
+        };
+
+        // Fill new block
+        this->block = _chacha_rounds<rounds>(input);
+        ++this->counter;
+    }
+
+public:
+    constexpr explicit ChaCha(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit ChaCha(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) {
+        // Use some other PRNG to setup initial state
+        SplitMix32 splitmix{seed};
+        for (auto& e : this->key) e = splitmix();
+        for (auto& e : this->nonce) e = splitmix();
+        this->counter  = 0; // counter can be set to any number, but usually 0 or 1 is used
+        this->position = 0;
+
+        this->generate_new_block();
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        // Seed sequence allows user to introduce more entropy into the state
+
+        seq.generate(this->key.begin(), this->key.end());
+        seq.generate(this->nonce.begin(), this->nonce.end());
+
+        this->counter  = 0; // counter can be set to any number, but usually 0 or 1 is used
+        this->position = 0;
+
+        this->generate_new_block();
+    }
+
+    constexpr result_type operator()() noexcept {
+        // Generate new block if necessary
+        if (this->position >= 16) {
+            this->generate_new_block();
+            this->position = 0;
+        }
+
+        // Get random value from the block and advance position cursor
+        return this->block[this->position++];
+    }
+    // Block counter & nonce can be used to split the keystream into independent parts: generators with the same key
+    // and different nonces produce unrelated streams of 2^32 blocks, while setting the counter skips to a given block
+    [[nodiscard]] constexpr std::uint32_t get_counter() const noexcept {
+        return this->position >= 16 ? this->counter : this->counter - 1;
+    } // index of the current block, 'this->counter' always points to the next one
+
+    [[nodiscard]] constexpr std::array<std::uint32_t, 3> get_nonce() const noexcept { return this->nonce; }
+
+    constexpr void set_counter(std::uint32_t counter) noexcept {
+        this->counter  = counter;
+        this->position = 0;
+
+        this->generate_new_block();
+    } // discards the rest of the current block
+
+    constexpr void set_nonce(const std::array<std::uint32_t, 3>& nonce) noexcept {
+        this->nonce = nonce;
+        this->set_counter(0);
+    } // restarts the keystream from the first block
+
+    // Same as calling 'operator()' for each element, but computes 'blocks' keystream blocks at a time
+    template <std::size_t blocks = 8, class It>
+    void fill(It first, It last) {
+        static_assert(blocks > 0, "Block count should be positive.");
+
+        auto remaining = static_cast<std::size_t>(std::distance(first, last));
+
+        // Finish the current block
+        for (; remaining && this->position < 16; --remaining, ++first) *first = this->block[this->position++];
+
+        // Generate full groups of blocks, 'this->counter' points to the next block
+        std::array<std::array<std::uint32_t, blocks>, 16> input{};
+        for (std::size_t w = 0; w < 4; ++w) input[w].fill(this->constant[w]);
+        for (std::size_t w = 0; w < 8; ++w) input[4 + w].fill(this->key[w]);
+        for (std::size_t w = 0; w < 3; ++w) input[13 + w].fill(this->nonce[w]);
+
+        for (; remaining >= 16 * blocks; remaining -= 16 * blocks) {
+            for (std::size_t k = 0; k < blocks; ++k) input[12][k] = this->counter + static_cast<std::uint32_t>(k);
+
+            const auto output = _chacha_rounds_multi<rounds>(input);
+            for (std::size_t k = 0; k < blocks; ++k)
+                for (std::size_t w = 0; w < 16; ++w, ++first) *first = output[w][k];
+
+            this->counter += static_cast<std::uint32_t>(blocks);
+        }
+
+        // Leftover values
+        for (; remaining; --remaining, ++first) *first = (*this)();
+    }
+};
+
+using ChaCha8  = ChaCha<8>;
+using ChaCha12 = ChaCha<12>;
+using ChaCha20 = ChaCha<20>;
+
+// --- Counter-based PRNGs ---
+// ---------------------------
+
+// Implementation of Philox & Threefry counter-based PRNGs suggested by J. K. Salmon, M. A. Moraes, R. O. Dror
+// and D. E. Shaw, see https://www.thesalmons.org/john/random123/papers/random123sc11.pdf
+//                     https://github.com/DEShawResearch/random123
+//
+// Performance: Good
+// Quality:     4/5
+// State:       48 / 56 bytes
+//
+// Output is a bijection 'block = f(key, counter)' of a 128-bit counter, which means any position of the
+// sequence can be reached in O(1) by 'set_counter()' / 'discard()'. Generators with different keys or counters
+// can be created for each unit of work (like '{ seed }' + '{ 0, 0, particle_id, step }'), this makes parallel
+// computation bit-reproducible regardless of how the work gets scheduled. Both pass BigCrush with a wide margin.
+//
+// Lower counter words count blocks, 'make_stream()' offsets the upper 64 bits to get independent streams.
+
+// 32x32 -> 64 bit multiplication split into high & low halves
+[[nodiscard]] constexpr std::uint32_t _mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi) noexcept {
+    const std::uint64_t product = std::uint64_t(a) * b;
+    hi                          = static_cast<std::uint32_t>(product >> 32);
+    return static_cast<std::uint32_t>(product);
+}
+
+template <std::size_t rounds>
+[[nodiscard]] constexpr std::array<std::uint32_t, 4>
+_philox4x32_rounds(const std::array<std::uint32_t, 4>& counter, const std::array<std::uint32_t, 2>& key) noexcept {
+    constexpr std::uint32_t multiplier_0 = 0xD2511F53, multiplier_1 = 0xCD9E8D57;
+    constexpr std::uint32_t weyl_0 = 0x9E3779B9, weyl_1 = 0xBB67AE85; // key schedule, golden ratio & sqrt(3) - 1
+
+    // plain locals instead of array elements, this lets compilers keep the whole state in registers
+    std::uint32_t c_0 = counter[0], c_1 = counter[1], c_2 = counter[2], c_3 = counter[3];
+    std::uint32_t k_0 = key[0], k_1 = key[1];
+
+    for (std::size_t i = 0; i < rounds; ++i) {
+        std::uint32_t hi_0 = 0, hi_1 = 0;
+        const auto    lo_0 = _mulhilo(multiplier_0, c_0, hi_0);
+        const auto    lo_1 = _mulhilo(multiplier_1, c_2, hi_1);
+
+        c_0 = hi_1 ^ c_1 ^ k_0, c_1 = lo_1, c_2 = hi_0 ^ c_3 ^ k_1, c_3 = lo_0;
+        k_0 += weyl_0, k_1 += weyl_1;
+    }
+
+    return {c_0, c_1, c_2, c_3};
+}
+
+template <std::size_t rounds>
+[[nodiscard]] constexpr std::array<std::uint64_t, 2> _threefry2x64_rounds(std::array<std::uint64_t, 2> counter,
+                                                                         std::array<std::uint64_t, 2> key) noexcept {
+    static_assert(rounds % 4 == 0, "Threefry injects the key every 4 rounds, total number should be divisible by 4.");
+
+    const std::array<std::uint64_t, 3> schedule = {key[0], key[1], 0x1BD11BDAA9FC1A22 ^ key[0] ^ key[1]};
+
+    const auto mix = [&](int rotation) {
+        counter[0] += counter[1];
+        counter[1] = _rotl_value(counter[1], rotation);
+        counter[1] ^= counter[0];
+    };
+    const auto inject = [&](std::size_t injection) {
+        counter[0] += schedule[injection % 3];
+        counter[1] += schedule[(injection + 1) % 3] + injection;
+    };
+
+    inject(0);
+    for (std::size_t i = 0; i < rounds / 8; ++i) { // rotation constants repeat every 8 rounds
+        mix(16), mix(42), mix(12), mix(31), inject(2 * i + 1);
+        mix(16), mix(32), mix(24), mix(21), inject(2 * i + 2);
+    }
+    if constexpr (rounds % 8) mix(16), mix(42), mix(12), mix(31), inject(rounds / 4);
+
+    return counter;
+}
+
+// Common part of counter-based generators, 'Derived' provides a 'static block_type compute(counter, key)'
+template <class Derived, class T, std::size_t counter_words, std::size_t key_words, std::size_t block_size>
+class _counter_based_generator {
+public:
+    using result_type  = T;
+    using counter_type = std::array<result_type, counter_words>;
+    using key_type     = std::array<result_type, key_words>;
+
+private:
+    key_type                            key{};
+    counter_type                        counter{};  // index of the current block
+    std::array<result_type, block_size> block{};    // holds next 'block_size' random numbers
+    std::size_t                         position{}; // current position in the block
+
+    constexpr void generate_block() noexcept { this->block = Derived::compute(this->counter, this->key); }
+
+public:
+    constexpr explicit _counter_based_generator(result_type seed = _default_seed<result_type>) noexcept {
+        this->seed(seed);
+    }
+
+    constexpr explicit _counter_based_generator(const key_type& key, const counter_type& counter = {}) noexcept
+        : key(key), counter(counter) {
+        this->generate_block();
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit _counter_based_generator(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept {
+        // Use some other PRNG to setup the key
+        if constexpr (sizeof(result_type) == 4) {
+            SplitMix32 splitmix{seed};
+            for (auto& e : this->key) e = splitmix();
+        } else {
+            SplitMix64 splitmix{seed};
+            for (auto& e : this->key) e = splitmix();
+        }
+        this->set_counter({});
+    }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        // Seed sequence allows user to introduce more entropy into the key
+        std::array<std::uint32_t, sizeof(key_type) / 4> temp{};
+        seq.generate(temp.begin(), temp.end());
+
+        if constexpr (sizeof(result_type) == 4) {
+            for (std::size_t i = 0; i < key_words; ++i) this->key[i] = temp[i];
+        } else {
+            for (std::size_t i = 0; i < key_words; ++i)
+                this->key[i] = _merge_uint32_into_uint64(temp[2 * i], temp[2 * i + 1]);
+        }
+        this->set_counter({});
+    }
+
+    constexpr result_type operator()() noexcept {
+        // Generate new block if necessary
+        if (this->position >= block_size) {
+            _add_to_counter(this->counter, 1);
+            this->generate_block();
+            this->position = 0;
+        }
+
+        // Get random value from the block and advance position cursor
+        return this->block[this->position++];
+    }
+
+    // Random access, all of these are O(1)
+    [[nodiscard]] constexpr const key_type& get_key() const noexcept { return this->key; }
+
+    [[nodiscard]] constexpr counter_type get_counter() const noexcept {
+        auto res = this->counter;
+        if (this->position >= block_size) _add_to_counter(res, 1);
+        return res;
+    } // index of the block next value comes from
+
+    constexpr void set_key(const key_type& key) noexcept {
+        this->key = key;
+        this->set_counter({});
+    } // restarts the sequence from the first block
+
+    constexpr void set_counter(const counter_type& counter) noexcept {
+        this->counter  = counter;
+        this->position = 0;
+
+        this->generate_block();
+    } // next value is the first one of the block 'counter'
+
+    constexpr void discard(unsigned long long n) noexcept {
+        std::uint64_t blocks = n / block_size;
+        this->position += n % block_size;
+        if (this->position >= block_size) this->position -= block_size, ++blocks;
+
+        if (!blocks) return;
+        _add_to_counter(this->counter, blocks);
+        this->generate_block();
+    } // same as calling 'operator()' 'n' times
+
+    // Same as calling 'operator()' for each element, but whole blocks are written directly to the output
+    template <class It>
+    void fill(It first, It last) {
+        auto remaining = static_cast<std::size_t>(std::distance(first, last));
+
+        // Finish the current block
+        for (; remaining && this->position < block_size; --remaining, ++first) *first = this->block[this->position++];
+
+        // Generate full blocks, block stored in the state stays consumed
+        for (; remaining >= block_size; remaining -= block_size) {
+            _add_to_counter(this->counter, 1);
+            for (const auto& e : Derived::compute(this->counter, this->key)) *first = e, ++first;
+        }
+
+        // Leftover values
+        for (; remaining; --remaining, ++first) *first = (*this)();
+    }
+};
+
+template <std::size_t rounds>
+class Philox4x32R : public _counter_based_generator<Philox4x32R<rounds>, std::uint32_t, 4, 2, 4> {
+public:
+    using _counter_based_generator<Philox4x32R<rounds>, std::uint32_t, 4, 2, 4>::_counter_based_generator;
+
+    [[nodiscard]] static constexpr std::array<std::uint32_t, 4> compute(const std::array<std::uint32_t, 4>& counter,
+                                                                        const std::array<std::uint32_t, 2>& key) {
+        return _philox4x32_rounds<rounds>(counter, key);
+    }
+};
+
+template <std::size_t rounds>
+class Threefry2x64R : public _counter_based_generator<Threefry2x64R<rounds>, std::uint64_t, 2, 2, 2> {
+public:
+    using _counter_based_generator<Threefry2x64R<rounds>, std::uint64_t, 2, 2, 2>::_counter_based_generator;
+
+    [[nodiscard]] static constexpr std::array<std::uint64_t, 2> compute(const std::array<std::uint64_t, 2>& counter,
+                                                                        const std::array<std::uint64_t, 2>& key) {
+        return _threefry2x64_rounds<rounds>(counter, key);
+    }
+};
+
+using Philox4x32   = Philox4x32R<10>;
+using Threefry2x64 = Threefry2x64R<20>;
+
+// --- Multi-lane PRNGs ---
+// ------------------------
+
+// Several Xoshiro generators stepped in lockstep, state is stored lane-by-lane ("structure of arrays") so each step
+// is a handful of element-wise operations over 'lanes' values, which compilers turn into SIMD instructions.
+//
+// Lane 'k' produces the same sequence as 'make_stream(Scalar{seed}, k)', values are returned interleaved
+// '{ lane_0[0], lane_1[0], ..., lane_0[1], lane_1[1], ... }'. Speedup comes from bulk generation with 'fill()',
+// single values are served from a buffer of 'lanes' values.
+//
+template <class Scalar, std::size_t lanes, int shift, int state_rotation, int result_rotation>
+class _xoshiro_lanes {
+public:
+    using result_type = typename Scalar::result_type;
+
+private:
+    using lane_array = std::array<result_type, lanes>;
+
+    std::array<lane_array, 4> s{};
+    lane_array                block{};          // holds next 'lanes' random numbers
+    std::size_t               position = lanes; // current position in the block
+
+    constexpr void seed_lanes(Scalar master) noexcept {
+        for (std::size_t k = 0; k < lanes; ++k, master.jump())
+            for (std::size_t i = 0; i < 4; ++i) this->s[i][k] = master.s[i];
+        this->position = lanes;
+    }
+
+    static constexpr void step(std::array<lane_array, 4>& state, lane_array& result) noexcept {
+        for (std::size_t k = 0; k < lanes; ++k)
+            result[k] = _rotl_value(state[0][k] + state[3][k], result_rotation) + state[0][k];
+
+        for (std::size_t k = 0; k < lanes; ++k) {
+            const result_type t = state[1][k] << shift;
+            state[2][k] ^= state[0][k];
+            state[3][k] ^= state[1][k];
+            state[1][k] ^= state[2][k];
+            state[0][k] ^= state[3][k];
+            state[2][k] ^= t;
+            state[3][k] = _rotl_value(state[3][k], state_rotation);
+        }
+    } // takes state explicitly so bulk generation can keep a local copy in registers
+
+public:
+    static_assert(lanes > 0, "Lane count should be positive.");
+
+    constexpr explicit _xoshiro_lanes(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    explicit _xoshiro_lanes(SeedSeq&& seq) {
+        this->seed(seq);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr void seed(result_type seed) noexcept { this->seed_lanes(Scalar{seed}); }
+
+    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
+    void seed(SeedSeq&& seq) {
+        this->seed_lanes(Scalar{seq});
+    }
+
+    constexpr result_type operator()() noexcept {
+        if (this->position >= lanes) {
+            step(this->s, this->block);
+            this->position = 0;
+        }
+        return this->block[this->position++];
+    }
+
+    // Same as calling 'operator()' for each element
+    template <class It>
+    constexpr void fill(It first, It last) noexcept {
+        // Finish the current block
+        for (; first != last && this->position < lanes; ++first) *first = this->block[this->position++];
+
+        // Full blocks
+        auto       remaining = static_cast<std::size_t>(std::distance(first, last));
+        auto       state     = this->s;
+        lane_array result{};
+        for (; remaining >= lanes; remaining -= lanes) {
+            step(state, result);
+            for (std::size_t k = 0; k < lanes; ++k, ++first) *first = result[k];
+        }
+        this->s = state;
+
+        // Leftover values
+        for (; remaining; --remaining, ++first) *first = (*this)();
+    }
+};
+
+template <std::size_t lanes>
+using Xoshiro128PPLanes = _xoshiro_lanes<Xoshiro128PP, lanes, 9, 11, 7>;
+template <std::size_t lanes>
+using Xoshiro256PPLanes = _xoshiro_lanes<Xoshiro256PP, lanes, 17, 45, 23>;
+
+using Xoshiro128PPx4 = Xoshiro128PPLanes<4>;
+using Xoshiro128PPx8 = Xoshiro128PPLanes<8>;
+using Xoshiro256PPx4 = Xoshiro256PPLanes<4>;
+using Xoshiro256PPx8 = Xoshiro256PPLanes<8>;
+
+
+} // namespace generators
+
+// ===========================
+// --- Default global PRNG ---
+// ===========================
+
+using default_generator_type = generators::Xoshiro256PP;
+using default_result_type    = default_generator_type::result_type;
+
+inline default_generator_type default_generator;
+
+// --- Parallel streams ---
+// ------------------------
+
+// Splits 'master' into independent streams, stream '0' is the 'master' itself:
+//    - Xoshiro generators advance by 'index' jumps, streams don't overlap for the first 2^128 / 2^64 values;
+//    - ChaCha generators keep the key and offset the 96-bit nonce by 'index', streams are unrelated keystreams;
+//    - counter-based generators keep the key and offset the upper 64 bits of the counter by 'index', each stream
+//      has 2^64 blocks.
+// Jumps are O(index), which is fine for a per-thread (or per-task) split.
+template <class Gen>
+[[nodiscard]] constexpr Gen make_stream(Gen master, std::uint64_t index) noexcept {
+    if constexpr (_has_jump_v<Gen>) {
+        for (; index; --index) master.jump();
+    } else if constexpr (_has_nonce_v<Gen>) {
+        if (!index) return master;
+        auto nonce = master.get_nonce();
+        _add_to_counter(nonce, index);
+        master.set_nonce(nonce);
+    } else if constexpr (_has_counter_v<Gen>) {
+        if (!index) return master;
+        auto counter = master.get_counter();
+        _add_to_counter(counter, index, counter.size() / 2);
+        master.set_counter(counter);
+    } else {
+        static_assert(_always_false_v<Gen>, "Generator doesn't support splitting into independent streams.");
+    }
+    return master;
+}
+
+// Thread-local generators: the main thread keeps using 'default_generator' directly (stream 0), other threads
+// get their own generators derived from the state 'default_generator' had at the last 'random::seed()' call.
+// Stream indices are either given out in order of the first use (after each seeding) or set explicitly with
+// 'set_thread_stream()', the latter gives reproducible per-thread sequences for a given seed.
+struct _stream_state {
+    default_generator_type     master;
+    std::atomic<std::uint64_t> epoch{1};      // incremented by each seeding, makes threads re-derive their streams
+    std::atomic<std::uint64_t> next_index{1}; // stream 0 is reserved for the main thread
+};
+
+struct _thread_stream {
+    default_generator_type  generator;
+    default_generator_type* active      = nullptr;
+    std::uint64_t           epoch       = 0; // 0 => needs to be derived on the next use
+    std::uint64_t           index       = 0;
+    bool                    fixed_index = false;
+};
+
+inline _stream_state               _streams;
+inline thread_local _thread_stream _this_thread_stream;
+inline const std::thread::id       _main_thread_id = std::this_thread::get_id();
+
+inline void _start_stream_epoch() noexcept {
+    _streams.master = default_generator;
+    _streams.next_index.store(1, std::memory_order_relaxed);
+    _streams.epoch.fetch_add(1, std::memory_order_release);
+}
+
+inline void _derive_thread_stream(_thread_stream& stream, std::uint64_t epoch) noexcept {
+    const bool is_main_thread = (std::this_thread::get_id() == _main_thread_id);
+
+    if (!stream.fixed_index)
+        stream.index = is_main_thread ? 0 : _streams.next_index.fetch_add(1, std::memory_order_relaxed);
+
+    // Only the main thread may use 'default_generator' directly, other threads asking for stream 0 get a copy
+    if (stream.index || !is_main_thread) {
+        stream.generator = make_stream(_streams.master, stream.index);
+        stream.active    = &stream.generator;
+    } else {
+        stream.active = &default_generator;
+    }
+
+    stream.epoch = epoch;
+}
+
+inline default_generator_type& thread_generator() noexcept {
+    _thread_stream&     stream = _this_thread_stream;
+    const std::uint64_t epoch  = _streams.epoch.load(std::memory_order_acquire);
+    if (stream.epoch != epoch) _derive_thread_stream(stream, epoch);
+    return *stream.active;
+}
+
+inline void set_thread_stream(std::uint64_t index) noexcept {
+    _this_thread_stream.index       = index;
+    _this_thread_stream.fixed_index = true;
+    _this_thread_stream.epoch       = 0;
+}
+
+[[nodiscard]] inline std::uint64_t thread_stream_index() noexcept {
+    thread_generator(); // ensures the index was assigned
+    return _this_thread_stream.index;
+}
+
+// --- Entropy & seeding ---
+// -------------------------
+
+inline std::seed_seq entropy_seq() {
+    // Ensure thread safery of our entropy source, it should generally work fine even without
+    // it, but with this we can be sure things never race
+    static std::mutex     entropy_mutex;
+    const std::lock_guard entropy_guard(entropy_mutex);
+
+    // Hardware entropy (if implemented),
+    // some platfroms (mainly MinGW) implements random device as a regular PRNG that
+    // doesn't change from run to run, this is horrible, but we can somewhat improve
+    // things by mixing other sources of entropy. Since hardware entropy is a rather
+    // limited resource we only call it once.
+    static std::uint32_t          seed_rd = std::random_device{}();
+    // after that we just scramble it with a regular PRNG
+    static generators::SplitMix32 splitmix{seed_rd};
+    seed_rd = splitmix();
+
+    // Time in nanoseconds (on some platforms microseconds)
+    const auto seed_time = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+    // Heap address (tends to be random each run on most platforms)
+    std::vector<std::uint32_t> dummy_vec(1, seed_rd);
+    const std::size_t          heap_address_hash = std::hash<std::uint32_t*>{}(dummy_vec.data());
+
+    // Stack address (also tends to be random)
+    const std::size_t stack_address_hash = std::hash<decltype(heap_address_hash)*>{}(&heap_address_hash);
+
+    // CPU counter (if available, hashed compilation time otherwise)
+    const auto cpu_counter = static_cast<std::uint64_t>(utl_random_cpu_counter);
+
+    // Note:
+    // There are other sources of entropy, such as function adresses,
+    // but those can be rather "constant" on some platforms
+
+    return {seed_rd, _crush_to_uint32(seed_time), _crush_to_uint32(heap_address_hash),
+            _crush_to_uint32(stack_address_hash), _crush_to_uint32(cpu_counter)};
+}
+
+inline std::uint32_t entropy() {
+    auto seq = entropy_seq();
+    return _seed_seq_to_uint32(seq);
+    // returns 'std::uint32_t' to mimic the return type of 'std::random_device', if we return uint64_t
+    // brace-initializers will complain about narrowing conversion on some generators. If someone want
+    // more entropy than that they can always use the whole sequence as a generic solution.
+    // Also having one 'random::entropy()' is much nicer than 'random::entropy_32()' & 'random::entropy_64()'.
+}
+
+// Seeding also resets thread-local streams, this shouldn't be done concurrently with generating values
+inline void seed(default_result_type random_seed) noexcept {
+    default_generator.seed(random_seed);
+    _start_stream_epoch();
+}
+
+inline void seed_with_entropy() {
+    auto seq = entropy_seq();
+    default_generator.seed(seq);
+    // for some god-forsaken reason seeding sequence constructors std:: generators take only l-value sequences
+    _start_stream_epoch();
+}
+
+// =====================
+// --- Distributions ---
+// =====================
+
+// --- Bulk generation ---
+// -----------------------
+
+// Fills '[first, last)' with raw generator output, same as calling 'gen()' for each element,
+// multi-lane & ChaCha generators provide faster specialized implementations
+template <class Gen, class It>
+void fill(Gen& gen, It first, It last) {
+    if constexpr (_has_fill_v<Gen>) {
+        gen.fill(first, last);
+    } else {
+        Gen local = gen;
+        for (; first != last; ++first) *first = local();
+        gen = local;
+    } // output can alias generator state as far as the compiler knows, a local copy lets it stay in registers
+}
+
+// Generator adaptor that serves values of 'gen' from a buffer filled in bulk. Every output of a distribution
+// takes at least one value, so refilling the buffer with no more values than there are outputs left never
+// takes values that the repeated 'dist(gen)' wouldn't, distributions using this produce the exact same sequence
+// and leave 'gen' in the same state.
+template <class Gen, std::size_t capacity = 256>
+class _bulk_source {
+public:
+    using result_type = typename Gen::result_type;
+
+private:
+    Gen&                              gen;
+    std::array<result_type, capacity> buffer;
+    std::size_t                       cursor = 0;
+    std::size_t                       size   = 0;
+    std::size_t                       outputs_left;
+
+public:
+    _bulk_source(Gen& gen, std::size_t outputs) noexcept : gen(gen), outputs_left(outputs) {}
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return Gen::min(); }
+    [[nodiscard]] static constexpr result_type max() noexcept { return Gen::max(); }
+
+    result_type operator()() {
+        if (this->cursor == this->size) {
+            this->size   = std::min(capacity, this->outputs_left);
+            this->cursor = 0;
+            random::fill(this->gen, this->buffer.begin(), this->buffer.begin() + this->size);
+        }
+        return this->buffer[this->cursor++];
+    }
+
+    void next_output() noexcept { --this->outputs_left; }
+};
+
+template <class Dist, class Gen, class It>
+void _fill_with_distribution(const Dist& dist, Gen& gen, It first, It last) {
+    _bulk_source<Gen> source(gen, static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first, source.next_output()) *first = dist(source);
+}
+
+// Distributions that always take exactly one generator value per output can be applied to a buffer
+// of raw values in a separate loop, this keeps both loops simple enough to vectorize
+template <class Gen>
+struct _single_value_source {
+    using result_type = typename Gen::result_type;
+
+    result_type value;
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return Gen::min(); }
+    [[nodiscard]] static constexpr result_type max() noexcept { return Gen::max(); }
+
+    constexpr result_type operator()() const noexcept { return this->value; }
+};
+
+template <class Dist, class Gen, class It>
+void _fill_with_single_value_distribution(const Dist& dist, Gen& gen, It first, It last) {
+    constexpr std::size_t capacity = 256;
+
+    std::array<typename Gen::result_type, capacity> buffer;
+
+    for (auto remaining = static_cast<std::size_t>(std::distance(first, last)); remaining;) {
+        const std::size_t size = std::min(capacity, remaining);
+        random::fill(gen, buffer.begin(), buffer.begin() + size);
+
+        for (std::size_t i = 0; i < size; ++i, ++first) {
+            _single_value_source<Gen> source{buffer[i]};
+            *first = dist(source);
+        }
+        remaining -= size;
+    }
+}
+
+// --- Uniform int distribution ---
+// --------------------------------
+
+template <class T, class Gen, _require<std::is_integral_v<T> && std::is_unsigned_v<T>> = true>
+constexpr T _uniform_uint_lemier(Gen& gen, T range) noexcept(noexcept(gen())) {
+    using W = _wider_t<T>;
+
+    W product = W(gen()) * W(range);
+    T low     = T(product);
+    if (low < range) {
+        while (low < -range % range) {
+            product = W(gen()) * W(range);
+            low     = T(product);
+        }
+    }
+    return product >> std::numeric_limits<T>::digits;
+}
+
+template <class T, class Gen, _require<std::is_integral_v<T> && std::is_unsigned_v<T>> = true>
+constexpr T _uniform_uint_modx1(Gen& gen, T range) noexcept(noexcept(gen())) {
+    T x{}, r{};
+    do {
+        x = gen();
+        r = x % range;
+    } while (x - r > T(-range));
+    return r;
+} // slightly slower than lemier, but doesn't require a wider type
+
+// Reimplementation of libc++ `std::uniform_int_distribution<>` except
+// - constexpr
+// - const-qualified (relative to distribution parameters)
+// - noexcept as long as 'Gen::operator()' is noexcept, which is true for all generators in this module
+// - supports `std::uint8_t`, `std::int8_t`, `char`
+// - produces the same sequence on each platform
+// Performance is exactly the same a libc++ version of `std::uniform_int_distribution<>`,
+// in fact, it is likely to return the exact same sequence for all types except 64-bit integers
+template <class T, class Gen, _require<std::is_integral_v<T>> = true>
+constexpr T _generate_uniform_int(Gen& gen, T min, T max) noexcept {
+    using result_type    = T;
+    using unsigned_type  = std::make_unsigned_t<result_type>;
+    using generated_type = typename Gen::result_type;
+    using common_type    = std::common_type_t<unsigned_type, generated_type>;
+
+    constexpr common_type prng_min = Gen::min();
+    constexpr common_type prng_max = Gen::max();
+
+    static_assert(prng_min < prng_max, "UniformRandomBitGenerator requires 'min() < max()'");
+
+    constexpr common_type prng_range = prng_max - prng_min;
+    constexpr common_type type_range = std::numeric_limits<common_type>::max();
+    const common_type     range      = common_type(max) - common_type(min);
+
+    common_type res{};
+
+    // PRNG has enough state for the range
+    if (prng_range > range) {
+        const common_type ext_range = range + 1; // range can be zero
+
+        // PRNG uses all 'common_type' bits uniformly
+        // => use Lemier's algorithm if possible, fallback onto modx1 otherwise,
+        //    libc++ uses conditionally compiled lemier's with 128-bit ints intead of doing a fallback,
+        //    this is slightly faster, but leads to platforms-dependant sequences
+        if constexpr (prng_range == type_range) {
+            if constexpr (_has_wider<common_type>) res = _uniform_uint_lemier(gen, ext_range);
+            else res = _uniform_uint_modx1(gen, ext_range);
+        }
+        // PRNG doesn't use all bits uniformly (usually because 'prng_min' is '1')
+        // => fallback onto a 2-division algorithm
+        else {
+            const common_type scaling = prng_range / ext_range;
+            const common_type past    = ext_range * scaling;
+
+            do { res = common_type(gen()) - prng_min; } while (res >= past);
+            res /= scaling;
+        }
+    }
+    // PRNG needs several invocations to aquire enough state for the range
+    else if (prng_range < range) {
+        common_type temp{};
+        do {
+            constexpr common_type ext_prng_range = (prng_range < type_range) ? prng_range + 1 : type_range;
+            temp = ext_prng_range * _generate_uniform_int<common_type>(gen, 0, range / ext_prng_range);
+            res  = temp + (common_type(gen()) - prng_min);
+        } while (res >= range || res < temp);
+    } else {
+        res = common_type(gen()) - prng_min;
+    }
+
+    return min + res;
+
+    // Note 1:
+    // 'static_cast<>()' preserves bit pattern of signed/unsigned integers of the same size as long as
+    // those integers are two-complement (see https://en.wikipedia.org/wiki/Two's_complement), this is
+    // true for most platforms and is in fact guaranteed for standard fixed-width types like 'uint32_t'
+    // on any platform (see https://en.cppreference.com/w/cpp/types/integer)
+    //
+    // This means signed integer distribution can simply use unsigned algorithm and reinterpret the result internally.
+    // This would be a bit nicer semantically with C++20 `std::bit_cast<>`, but not ultimately any different.
+
+    // Note 2:
+    // 'ext_prng_range' has a ternary purely to silence a false compiler warning from about division by zero due to
+    // 'prng_range + 1' overflowing into '0' when 'prng_range' is equal to 'type_range'. Falling into this runtime
+    // branch requires 'prng_range < range <= type_range' making such situation impossible, here we simply clamp the
+    // value to 'type_range' so it doesn't overflow and trip the compiler when analyzing constexpr for potential UB.
+}
+
+// 'static_cast<>()' preserves bit pattern of signed/unsigned integers of the same size as long as
+// those integers are two-complement (see https://en.wikipedia.org/wiki/Two's_complement), this is
+// true for most platforms and is in fact guaranteed for standard fixed-width types like 'uint32_t'
+// on any platform (see https://en.cppreference.com/w/cpp/types/integer)
+//
+// This means signed integer distribution can simply use unsigned algorithm and reinterpret the result internally.
+// This would be a bit nicer semantically with C++20 `std::bit_cast<>`, but not ultimately any different.
+template <class T = int, _require<std::is_integral_v<T>> = true>
+struct UniformIntDistribution {
+    using result_type = T;
+
+    struct param_type {
+        result_type min = 0;
+        result_type max = std::numeric_limits<result_type>::max();
+    };
+
+    constexpr UniformIntDistribution() = default;
+    constexpr UniformIntDistribution(T min, T max) noexcept : pars({min, max}) { assert(min < max); }
+    constexpr UniformIntDistribution(const param_type& p) noexcept : pars(p) { assert(p.min < p.max); }
+
+    template <class Gen>
+    constexpr T operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        return _generate_uniform_int<result_type>(gen, this->pars.min, this->pars.max);
+    }
+
+    template <class Gen>
+    constexpr T operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
+        assert(p.min < p.max);
+        return _generate_uniform_int<result_type>(gen, p.min, p.max);
+    } // for std-compatibility
+
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
+    }
+
+    constexpr result_type               reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
+    constexpr void                      params(const param_type& p) noexcept { *this = UniformIntDistribution(p); }
+    [[nodiscard]] constexpr result_type a() const noexcept { return this->pars.min; }
+    [[nodiscard]] constexpr result_type b() const noexcept { return this->pars.max; }
+    [[nodiscard]] constexpr result_type min() const noexcept { return this->pars.min; }
+    [[nodiscard]] constexpr result_type max() const noexcept { return this->pars.max; }
+
+private:
+    param_type pars{};
+};
+
+template <class T>
+constexpr bool operator==(const UniformIntDistribution<T>& lhs, const UniformIntDistribution<T>& rhs) noexcept {
+    return lhs.a() == rhs.a() && lhs.b() == rhs.b();
+}
+
+// --- Uniform real distribution ---
+// ---------------------------------
+
+// Can't really make things work without making some reasonable assumptions about the size of primitive types,
+// this should be satisfied for the vast majority of platforms. Esoteric architectures can manually adapt the
+// algorithm if that is necessary.
+static_assert(std::numeric_limits<double>::digits == 53, "Platform not supported, 'float' is expected to be 32-bit.");
+static_assert(std::numeric_limits<float>::digits == 24, "Platform not supported, 'double' is expected to be 64-bit.");
+
+template <class T>
+constexpr int _bit_width(T value) noexcept {
+    int width = 0;
+    while (value >>= 1) ++width;
+    return width;
+}
+
+// Constexpr reimplementation of 'std::generate_canonical<>()'
+template <class T, class Gen>
+constexpr T _generate_canonical_generic(Gen& gen) noexcept(noexcept(gen())) {
+    using float_type     = T;
+    using generated_type = typename Gen::result_type;
+
+    constexpr int float_bits = std::numeric_limits<float_type>::digits;
+    // always produce enough bits of randomness for the whole mantissa
 
-// clang-format off
-template<class T> struct _wider { static_assert(_always_false_v<T>, "Missing specialization."); };
+    constexpr generated_type prng_max = Gen::max();
+    constexpr generated_type prng_min = Gen::min();
 
-template<> struct _wider<std::uint8_t > { using type = std::uint16_t; };
-template<> struct _wider<std::uint16_t> { using type = std::uint32_t; };
-template<> struct _wider<std::uint32_t> { using type = std::uint64_t; };
-template<> struct _wider<std::uint64_t> { using type = void; };
+    constexpr generated_type prng_range = prng_max - prng_min;
+    constexpr generated_type type_range = std::numeric_limits<generated_type>::max();
 
-template<class T> using _wider_t = typename _wider<T>::type;
+    constexpr int prng_bits = (prng_range < type_range) ? _bit_width(prng_range + 1) : 1 + _bit_width(prng_range);
+    // how many full bits of randomness PRNG produces on each invocation, prng_bits == floor(log2(prng_range + 1)),
+    // ternary handles the case that would overflow when (prng_range == type_range)
 
-template <class T> constexpr bool _has_wider = !std::is_void_v<_wider_t<T>>;
-// clang-format on
+    constexpr int invocations_needed = [&]() {
+        int count = 0;
+        for (int generated_bits = 0; generated_bits < float_bits; generated_bits += prng_bits) ++count;
+        return count;
+    }();
+    // GCC and MSVC use runtime conversion to floating point and std::ceil() & std::log() to obtain
+    // this value, in MSVC for example we have something like this:
+    //    > invocations_needed = std::ceil( float_type(float_bits) / std::log2( float_type(prng_range) + 1 ) )
+    // which is not constexpr due to math functions, we can do a similar thing much easier by just counting bits
+    // generated per each invocation. This returns the same thing for any sane PRNG, except since it only counts
+    // "full bits" esoteric ranges such as [1, 3] which technically have 1.5 bits of randomness will be counted
+    // as 1 bit of randomness, thus overestimating the invocations a little. In practice this makes 0 difference
+    // since its only matters for exceedingly small 'prng_range' and such PRNGs simply don't exist in nature, and
+    // even if they are theoretically used they will simply use a few more invocation to produce a proper result
 
-// --- Bit twiddling utils ---
-// ---------------------------
+    constexpr float_type prng_float_max   = static_cast<float_type>(prng_max);
+    constexpr float_type prng_float_min   = static_cast<float_type>(prng_min);
+    constexpr float_type prng_float_range = (prng_float_max - prng_float_min) + float_type(1);
 
-// Merging integers into the bits of a larger one
-[[nodiscard]] constexpr std::uint64_t _merge_uint32_into_uint64(std::uint32_t a, std::uint32_t b) {
-    return static_cast<std::uint64_t>(a) | (static_cast<std::uint64_t>(b) << 32);
-}
+    float_type res    = float_type(0);
+    float_type factor = float_type(1);
 
-// Helper method to crush large uints to uint32_t,
-// inspired by Melissa E. O'Neil's randutils https://gist.github.com/imneme/540829265469e673d045
-template <class T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) <= 8, bool> = true>
-[[nodiscard]] constexpr std::uint32_t _crush_to_uint32(T value) {
-    if constexpr (sizeof(value) <= 4) {
-        return std::uint32_t(value);
-    } else {
-        std::uint64_t res = value;
-        res *= 0xbc2ad017d719504d;
-        return static_cast<std::uint32_t>(res ^ (res >> 32));
-    }
-}
+    for (int i = 0; i < invocations_needed; ++i) {
+        res += (static_cast<float_type>(gen()) - static_cast<float_type>(prng_min)) * factor;
+        factor *= prng_float_range;
+    } // same algorithm is used by 'std::generate_canonical<>' in all major compilers as of 2025
 
-// Seed sequence helpers
-template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-std::uint32_t _seed_seq_to_uint32(SeedSeq&& seq) {
-    std::array<std::uint32_t, 1> temp;
-    seq.generate(temp.begin(), temp.end());
-    return temp[0];
+    return res / factor;
 }
 
-template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-std::uint64_t _seed_seq_to_uint64(SeedSeq&& seq) {
-    std::array<std::uint32_t, 2> temp;
-    seq.generate(temp.begin(), temp.end());
-    return _merge_uint32_into_uint64(temp[0], temp[1]);
-}
+// Whether 'generate_canonical<T>()' below takes exactly one value of 'Gen', which is true for the bit-uniform
+// special cases, except for 64-bit floats made from 32-bit values
+template <class T, class Gen>
+constexpr bool _canonical_takes_single_value = (Gen::max() - Gen::min() ==
+                                                std::numeric_limits<typename Gen::result_type>::max()) &&
+                                               (sizeof(T) == 4 || sizeof(T) == 8) &&
+                                               (sizeof(typename Gen::result_type) == 8 ||
+                                                (sizeof(typename Gen::result_type) == 4 && sizeof(T) == 4));
 
-// 'std::rotl()' from C++20, used by many PRNGs,
-// have to use long name because platform-specific includes declare '_rotl' as a macro
-template <class T>
-[[nodiscard]] constexpr T _rotl_value(T x, int k) noexcept {
-    return (x << k) | (x >> (std::numeric_limits<T>::digits - k));
-}
+// Wrapper that adds special case optimizations for `_generate_canonical_generic<>()'
+template <class T, class Gen>
+constexpr T generate_canonical(Gen& gen) noexcept(noexcept(gen())) {
+    using float_type     = T;
+    using generated_type = typename Gen::result_type;
 
-// Some generators shouldn't be zero initialized, in a perfect world the user would never
-// do that, but in case they happened to do so regardless we can remap 0 to some "weird"
-// value that isn't like to intersect with any other seeds generated by the user. Rejecting
-// zero seeds completely wouldn't be appropriate for compatibility reasons.
-template <class T, std::size_t N>
-[[nodiscard]] constexpr bool _is_zero_state(const std::array<T, N>& state) {
-    for (const auto& e : state)
-        if (e != 0) return false;
-    return true;
-}
+    constexpr generated_type prng_min = Gen::min();
+    constexpr generated_type prng_max = Gen::max();
 
-template <class T>
-constexpr T _default_seed = std::numeric_limits<T>::max() / 2 + 1;
-// an "overall decent" default seed - doesn't gave too many zeroes,
-// unlikely to accidentaly match with a user-defined seed
+    static_assert(prng_min < prng_max, "UniformRandomBitGenerator requires 'min() < max()'");
 
+    constexpr generated_type prng_range          = prng_max - prng_min;
+    constexpr generated_type type_range          = std::numeric_limits<generated_type>::max();
+    constexpr bool           prng_is_bit_uniform = (prng_range == type_range);
 
-// =========================
-// --- Random Generators ---
-// =========================
+    constexpr int exponent_bits_64 = 11;
+    constexpr int exponent_bits_32 = 8;
 
-// Implementation of several "good" PRNGS.
-//
-// All generators meets uniform random number generator requirements
-// (C++17 and below, see https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator)
-// (C++20 and above, see https://en.cppreference.com/w/cpp/numeric/random/uniform_random_bit_generator)
+    constexpr double mantissa_hex_64 = 0x1.0p-53;  // == 2^-53, corresponds to 53 significant bits of double
+    constexpr float  mantissa_hex_32 = 0x1.0p-24f; // == 2^-24, corresponds to 24 significant bits of float
 
-// Note:
-// Here PRNGs take 'SeedSeq' as a forwaring reference 'SeedSeq&&', while standard PRNGS take 'SeedSeq&',
-// this is how it should've been done in the standard too, but for some reason they only standardized
-// l-value references, perfect forwarding probably just wasn't in use at the time.
+    constexpr double pow2_minus_64 = 0x1.0p-64; // == 2^-64
+    constexpr double pow2_minus_32 = 0x1.0p-32; // == 2^-32
 
-namespace generators {
+    // Note 1: Note hexadecimal float literals, 'p' separates hex-base from the exponent
+    // Note 2: Floats have 'mantissa_size + 1' significant bits due to having a sign bit
 
-// --- 16-bit PRNGs ---
-// --------------------
+    // Bit-uniform PRNGs can be simply bitmasked & shifted to obtain mantissa
+    // 64-bit float, 64-bit uniform PRNG
+    // => multiplication algorithm, see [https://prng.di.unimi.it/]
+    if constexpr (prng_is_bit_uniform && sizeof(float_type) == 8 && sizeof(generated_type) == 8) {
+        return (gen() >> exponent_bits_64) * mantissa_hex_64;
+    }
+    // 64-bit float, 32-bit uniform PRNG
+    // => "low-high" algorithm, see [https://www.doornik.com/research/randomdouble.pdf]
+    else if constexpr (prng_is_bit_uniform && sizeof(T) == 8 && sizeof(generated_type) == 4) {
+        return (gen() * pow2_minus_64) + (gen() * pow2_minus_32);
+    }
+    // 32-bit float, 64-bit uniform PRNG
+    // => discard bits + multiplication algorithm
+    else if constexpr (prng_is_bit_uniform && sizeof(T) == 4 && sizeof(generated_type) == 8) {
+        return (static_cast<std::uint32_t>(gen()) >> exponent_bits_32) * mantissa_hex_32;
+    }
+    // 32-bit float, 32-bit uniform PRNG
+    // => multiplication algorithm tweaked for 32-bit
+    else if constexpr (prng_is_bit_uniform && sizeof(T) == 4 && sizeof(generated_type) == 4) {
+        return (gen() >> exponent_bits_32) * mantissa_hex_32;
+    }
+    // Generic case, no particular optimizations can be made
+    else {
+        return _generate_canonical_generic<T>(gen);
+    }
+}
 
-// Implementation of 16-bit Romu Mono engine from paper by "Mark A. Overton",
-// see https://www.romu-random.org/
-//     https://www.romu-random.org/romupaper.pdf
-//
-// Performance: Excellent
-// Quality:     2/5
-// State:       4 bytes
-//
-// Romu family provides extemely fast non-linear PRNGs, "RomuMono16" is the fastest 16-bit option available
-// that still provides some resemblance of quality. There has been some concerns over the math used
-// in its original paper (see https://news.ycombinator.com/item?id=22447848), however I'd yet to find
-// a faster 16-bit PRNG, so if speed is needed at all cost this one provides it.
-//
-class RomuMono16 {
-public:
-    using result_type = std::uint16_t;
+template <class T = double, _require<std::is_floating_point_v<T>> = true>
+struct UniformRealDistribution {
+    using result_type = T;
 
-private:
-    std::uint32_t s{}; // notice 32-bit value as a state rather than two 16-bit ints
+    struct param_type {
+        result_type min = 0;
+        result_type max = std::numeric_limits<result_type>::max();
+    } pars{};
 
-public:
-    constexpr explicit RomuMono16(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+    constexpr UniformRealDistribution() = default;
+    constexpr UniformRealDistribution(T min, T max) noexcept : pars({min, max}) { assert(min < max); }
+    constexpr UniformRealDistribution(const param_type& p) noexcept : pars(p) { assert(p.min < p.max); }
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit RomuMono16(SeedSeq&& seq) {
-        this->seed(seq);
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        return this->pars.min + generate_canonical<result_type>(gen) * (this->pars.max - this->pars.min);
     }
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+    template <class Gen>
+    constexpr T operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
+        assert(p.min < p.max);
+        return p.min + generate_canonical<result_type>(gen) * (p.max - p.min);
+    } // for std-compatibility
 
-    constexpr void seed(result_type seed) noexcept {
-        this->s = (seed & 0x1fffffffu) + 1156979152u; // accepts 29 seed-bits
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        if constexpr (_canonical_takes_single_value<result_type, Gen>)
+            _fill_with_single_value_distribution(*this, gen, first, last);
+        else _fill_with_distribution(*this, gen, first, last);
     }
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        this->s = _seed_seq_to_uint32(seq);
+    constexpr result_type reset() const noexcept {} // there is nothing to reset, provided for std-API compatibility
+    constexpr param_type  params() const noexcept { return this->pars; }
+    constexpr void        params(const param_type& p) noexcept { *this = UniformRealDistribution(p); }
+    constexpr result_type a() const noexcept { return this->pars.min; }
+    constexpr result_type b() const noexcept { return this->pars.max; }
+    constexpr result_type min() const noexcept { return this->pars.min; }
+    constexpr result_type max() const noexcept { return this->pars.max; }
+};
 
-        if (this->s == 0) this->seed(_default_seed<result_type>);
-    }
+template <class T>
+constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRealDistribution<T>& rhs) noexcept {
+    return lhs.a() == rhs.a() && lhs.b() == rhs.b();
+}
 
-    constexpr result_type operator()() noexcept {
-        const result_type result = this->s >> 16;
-        this->s *= 3611795771u;
-        this->s = _rotl_value(this->s, 12);
-        return result;
-    }
+// --- Ziggurat method ---
+// -----------------------
+
+// Ziggurat method by G. Marsaglia & W. W. Tsang in the ZIGNOR form suggested by J. A. Doornik,
+// see https://www.jstatsoft.org/article/view/v005i08
+//     https://www.doornik.com/research/ziggurat.pdf
+//
+// Area under the density 'f(x)' is covered by 'layers' horizontal layers of equal area 'v', the bottom one also
+// includes the tail past 'r'. Layer 'i' spans 'f(x[i]) <= y < f(x[i + 1])', 'x' decreases from 'x[0] = v / f(r)'
+// and 'x[1] = r' to 'x[layers] = 0'. A sample picks a random layer and a random point 'u * x[i]' inside of it,
+// which is accepted right away in ~99% of cases ('u < x[i + 1] / x[i]'), otherwise it either falls into the tail
+// or gets accepted/rejected based on 'f(x)'.
+//
+// Tables are computed at compile-time, common path takes a single 64-bit generator value: top 53 bits give 'u',
+// low bits give the layer index.
+template <std::size_t layers>
+struct _ziggurat_table {
+    std::array<double, layers + 1> x{}; // layer widths
+    std::array<double, layers + 1> f{}; // density at 'x[i]'
+    std::array<double, layers>     r{}; // x[i + 1] / x[i]
 };
 
-// --- 32-bit PRNGs ---
-// --------------------
+template <std::size_t layers, class Density, class InverseDensity>
+[[nodiscard]] constexpr _ziggurat_table<layers> _make_ziggurat_table(double r, double v, Density density,
+                                                                     InverseDensity inverse_density) noexcept {
+    _ziggurat_table<layers> table;
 
-// Implementation of 32-bit splitmix adopted from MurmurHash3, based on paper by Guy L. Steele,
-// Doug Lea, and Christine H. Flood. 2014. "Fast splittable pseudorandom number generators"
-// see http://marc-b-reynolds.github.io/shf/2017/09/27/LPRNS.html
-//     https://gee.cs.oswego.edu/dl/papers/oopsla14.pdf
-//     https://github.com/umireon/my-random-stuff/blob/e7b17f992955f4dbb02d4016682113b48b2f6ec1/xorshift/splitmix32.c
-//
-// Performance: Excellent
-// Quality:     3/5
-// State:       4 bytes
-//
-// One of the fastest 32-bit generators that requires only a single 'std::uint32_t' of state,
-// making it the smallest state available. Some other PRNGs recommend using it for seeding their state.
-// 32-bit version is somewhat lacking in terms of quality estimate data (relative to the widely used
-// 64-bit version), however it still seems to be quite decent.
-//
-class SplitMix32 {
-public:
-    using result_type = std::uint64_t;
+    table.x[0]      = v / density(r);
+    table.x[1]      = r;
+    table.x[layers] = 0.;
+    for (std::size_t i = 2; i < layers; ++i) table.x[i] = inverse_density(v / table.x[i - 1] + density(table.x[i - 1]));
 
-private:
-    result_type s{};
+    for (std::size_t i = 0; i <= layers; ++i) table.f[i] = density(table.x[i]);
+    for (std::size_t i = 0; i < layers; ++i) table.r[i] = table.x[i + 1] / table.x[i];
 
-public:
-    constexpr explicit SplitMix32(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+    return table;
+}
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit SplitMix32(SeedSeq&& seq) {
-        this->seed(seq);
+// Normal: f(x) = exp(-x^2 / 2) (unnormalized), 128 layers
+constexpr double _ziggurat_normal_r = 3.442619855899;
+constexpr double _ziggurat_normal_v = 9.91256303526217e-3;
+
+constexpr auto _ziggurat_normal = _make_ziggurat_table<128>(
+    _ziggurat_normal_r, _ziggurat_normal_v, [](double x) { return _exp(-0.5 * x * x); },
+    [](double y) { return _sqrt(-2. * _log(y)); });
+
+// Exponential: f(x) = exp(-x), 256 layers
+constexpr double _ziggurat_exponential_r = 7.69711747013104972;
+constexpr double _ziggurat_exponential_v = 3.949659822581572e-3;
+
+constexpr auto _ziggurat_exponential = _make_ziggurat_table<256>(
+    _ziggurat_exponential_r, _ziggurat_exponential_v, [](double x) { return _exp(-x); },
+    [](double y) { return -_log(y); });
+
+// 64 uniformly distributed bits in a platform-independent way
+template <class Gen>
+constexpr std::uint64_t _generate_uint64(Gen& gen) noexcept(noexcept(gen())) {
+    using generated_type = typename Gen::result_type;
+
+    constexpr bool prng_is_bit_uniform = (Gen::max() - Gen::min() == std::numeric_limits<generated_type>::max());
+
+    if constexpr (prng_is_bit_uniform && sizeof(generated_type) == 8) {
+        return gen();
+    } else if constexpr (prng_is_bit_uniform && sizeof(generated_type) == 4) {
+        const std::uint32_t low = gen();
+        return _merge_uint32_into_uint64(low, gen());
+    } else {
+        return _generate_uniform_int<std::uint64_t>(gen, 0, std::numeric_limits<std::uint64_t>::max());
     }
+}
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+// Open interval (0, 1], used to take logarithms
+template <class Gen>
+constexpr double _generate_open_canonical(Gen& gen) noexcept(noexcept(gen())) {
+    return 1. - generate_canonical<double>(gen);
+}
 
-    constexpr void seed(result_type seed) noexcept { this->s = seed; }
+// Standard normal variate N(0, 1)
+template <class Gen>
+constexpr double _generate_normal_ziggurat(Gen& gen) noexcept(noexcept(gen())) {
+    constexpr auto&  table = _ziggurat_normal;
+    constexpr double r     = _ziggurat_normal_r;
+
+    while (true) {
+        const std::uint64_t bits = _generate_uint64(gen);
+        const double        u    = 2. * ((bits >> 11) * 0x1.0p-53) - 1.; // [-1, 1)
+        const std::size_t   i    = bits & 0x7f;                           // [0, 128)
+
+        // Inside the rectangle
+        if (_abs(u) < table.r[i]) return u * table.x[i];
+
+        // Tail, see G. Marsaglia "Generating a variable from the tail of the normal distribution" (1964)
+        if (i == 0) {
+            double x = 0., y = 0.;
+            do {
+                x = -_log(_generate_open_canonical(gen)) / r;
+                y = -_log(_generate_open_canonical(gen));
+            } while (2. * y < x * x);
+            return u < 0. ? -(r + x) : r + x;
+        }
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        this->s = _seed_seq_to_uint32(seq);
+        // Wedge
+        const double x = u * table.x[i];
+        const double y = table.f[i] + generate_canonical<double>(gen) * (table.f[i + 1] - table.f[i]);
+        if (y < _exp(-0.5 * x * x)) return x;
     }
+}
 
-    constexpr result_type operator()() noexcept {
-        result_type result = (this->s += 0x9e3779b9);
-        result             = (result ^ (result >> 16)) * 0x21f0aaad;
-        result             = (result ^ (result >> 15)) * 0x735a2d97;
-        return result ^ (result >> 15);
-    }
-};
+// Standard exponential variate Exp(1)
+template <class Gen>
+constexpr double _generate_exponential_ziggurat(Gen& gen) noexcept(noexcept(gen())) {
+    constexpr auto&  table = _ziggurat_exponential;
+    constexpr double r     = _ziggurat_exponential_r;
 
-// Implementation of Xoshiro128++ suggested by David Blackman and Sebastiano Vigna,
-// see https://prng.di.unimi.it/
-//     https://prng.di.unimi.it/xoshiro256plusplus.c
-//
-// Performance: Good
-// Quality:     4/5
-// State:       16 bytes
-//
-// Excellent choice as a general purpose 32-bit PRNG.
-// Battle-tested and provides a good statistical quality at an excellent speed.
-//
-class Xoshiro128PP {
-public:
-    using result_type = std::uint32_t;
+    double offset = 0.; // exponential distribution is memoryless, tail is just another sample shifted by 'r'
 
-private:
-    std::array<result_type, 4> s{};
+    while (true) {
+        const std::uint64_t bits = _generate_uint64(gen);
+        const double        u    = (bits >> 11) * 0x1.0p-53; // [0, 1)
+        const std::size_t   i    = bits & 0xff;              // [0, 256)
 
-public:
-    constexpr explicit Xoshiro128PP(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+        // Inside the rectangle
+        if (u < table.r[i]) return offset + u * table.x[i];
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit Xoshiro128PP(SeedSeq&& seq) {
-        this->seed(seq);
+        // Tail
+        if (i == 0) {
+            offset += r;
+            continue;
+        }
+
+        // Wedge
+        const double x = u * table.x[i];
+        const double y = table.f[i] + generate_canonical<double>(gen) * (table.f[i + 1] - table.f[i]);
+        if (y < _exp(-x)) return offset + x;
     }
+}
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    // while zero-state is considered invalid, PRNG can still produce 0 as a result
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+// --- Normal distribution ---
+// ---------------------------
 
-    constexpr void seed(result_type seed) noexcept {
-        SplitMix32 splitmix{seed};
-        this->s[0] = splitmix(); // Xoshiro family recommends using
-        this->s[1] = splitmix(); // splitmix to initialize its state
-        this->s[2] = splitmix();
-        this->s[3] = splitmix();
-    }
+template <class T = double, _require<std::is_floating_point_v<T>> = true>
+struct NormalDistribution {
+    using result_type = T;
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        seq.generate(this->s.begin(), this->s.end());
+    struct param_type {
+        result_type mean   = 0;
+        result_type stddev = 1;
+    };
 
-        // ensure we don't hit an invalid all-zero state
-        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+    constexpr NormalDistribution() = default;
+    constexpr NormalDistribution(T mean, T stddev) noexcept : pars({mean, stddev}) { assert(stddev > 0); }
+    constexpr NormalDistribution(const param_type& p) noexcept : pars(p) { assert(p.stddev > 0); }
+
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        return (*this)(gen, this->pars);
     }
 
-    constexpr result_type operator()() noexcept {
-        const result_type result = _rotl_value(this->s[0] + this->s[3], 7) + this->s[0];
-        const result_type t      = s[1] << 9;
-        this->s[2] ^= this->s[0];
-        this->s[3] ^= this->s[1];
-        this->s[1] ^= this->s[2];
-        this->s[0] ^= this->s[3];
-        this->s[2] ^= t;
-        this->s[3] = _rotl_value(this->s[3], 11);
-        return result;
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
+        return p.mean + p.stddev * static_cast<result_type>(_generate_normal_ziggurat(gen));
+    } // for std-compatibility
+
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
     }
-};
 
-// Implementation of 32-bit Romu Trio engine from paper by "Mark A. Overton",
-// see https://www.romu-random.org/
-//     https://www.romu-random.org/romupaper.pdf
-//
-// Performance: Excellent
-// Quality:     2/5
-// State:       12 bytes
-//
-// Romu family provides extemely fast non-linear PRNGs, "RomuTrio" is the fastest 32-bit option available
-// that still provides some resemblance of quality. There has been some concerns over the math used
-// in its original paper (see https://news.ycombinator.com/item?id=22447848), however I'd yet to find
-// a faster 32-bit PRNG, so if speed is needed at all cost this one provides it.
-//
-class RomuTrio32 {
-public:
-    using result_type = std::uint32_t;
+    constexpr void                      reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
+    constexpr void                      params(const param_type& p) noexcept { *this = NormalDistribution(p); }
+    [[nodiscard]] constexpr param_type  param() const noexcept { return this->pars; } // for std-compatibility
+    constexpr void                      param(const param_type& p) noexcept { this->params(p); }
+    [[nodiscard]] constexpr result_type mean() const noexcept { return this->pars.mean; }
+    [[nodiscard]] constexpr result_type stddev() const noexcept { return this->pars.stddev; }
+    [[nodiscard]] constexpr result_type min() const noexcept { return std::numeric_limits<result_type>::lowest(); }
+    [[nodiscard]] constexpr result_type max() const noexcept { return std::numeric_limits<result_type>::max(); }
 
 private:
-    std::array<result_type, 3> s{};
+    param_type pars{};
+};
 
-public:
-    constexpr explicit RomuTrio32(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+template <class T>
+constexpr bool operator==(const NormalDistribution<T>& lhs, const NormalDistribution<T>& rhs) noexcept {
+    return lhs.mean() == rhs.mean() && lhs.stddev() == rhs.stddev();
+}
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit RomuTrio32(SeedSeq&& seq) {
-        this->seed(seq);
-    }
+// --- Exponential distribution ---
+// --------------------------------
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+template <class T = double, _require<std::is_floating_point_v<T>> = true>
+struct ExponentialDistribution {
+    using result_type = T;
 
-    constexpr void seed(result_type seed) noexcept {
-        SplitMix32 splitmix{seed};
-        this->s[0] = splitmix(); // Like Xoshiro, Romu recommends
-        this->s[1] = splitmix(); // using SplitMix32 to initialize its state
-        this->s[2] = splitmix();
-    }
+    struct param_type {
+        result_type lambda = 1;
+    };
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        seq.generate(this->s.begin(), this->s.end());
+    constexpr ExponentialDistribution() = default;
+    constexpr explicit ExponentialDistribution(T lambda) noexcept : pars({lambda}) { assert(lambda > 0); }
+    constexpr ExponentialDistribution(const param_type& p) noexcept : pars(p) { assert(p.lambda > 0); }
 
-        // ensure we don't hit an invalid all-zero state
-        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        return (*this)(gen, this->pars);
     }
 
-    constexpr result_type operator()() noexcept {
-        const result_type xp = this->s[0], yp = this->s[1], zp = this->s[2];
-        this->s[0] = 3323815723u * zp;
-        this->s[1] = yp - xp;
-        this->s[1] = _rotl_value(this->s[1], 6);
-        this->s[2] = zp - yp;
-        this->s[2] = _rotl_value(this->s[2], 22);
-        return xp;
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
+        return static_cast<result_type>(_generate_exponential_ziggurat(gen)) / p.lambda;
+    } // for std-compatibility
+
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
     }
+
+    constexpr void                      reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
+    constexpr void                      params(const param_type& p) noexcept { *this = ExponentialDistribution(p); }
+    [[nodiscard]] constexpr param_type  param() const noexcept { return this->pars; } // for std-compatibility
+    constexpr void                      param(const param_type& p) noexcept { this->params(p); }
+    [[nodiscard]] constexpr result_type lambda() const noexcept { return this->pars.lambda; }
+    [[nodiscard]] constexpr result_type min() const noexcept { return 0; }
+    [[nodiscard]] constexpr result_type max() const noexcept { return std::numeric_limits<result_type>::max(); }
+
+private:
+    param_type pars{};
 };
 
-// --- 64-bit PRNGs ---
-// --------------------
+template <class T>
+constexpr bool operator==(const ExponentialDistribution<T>& lhs, const ExponentialDistribution<T>& rhs) noexcept {
+    return lhs.lambda() == rhs.lambda();
+}
 
-// Implementation of fixed-increment version of Java 8's SplittableRandom generator SplitMix64,
-// see http://dx.doi.org/10.1145/2714064.2660195
-//     http://docs.oracle.com/javase/8/docs/api/java/util/SplittableRandom.html
-//     https://rosettacode.org/wiki/Pseudo-random_numbers/Splitmix64
-//
-// Performance: Excellent
-// Quality:     4/5
-// State:       8 bytes
-//
-// One of the fastest generators passing BigCrush that requires only a single 'std::uint64_t' of state,
-// making it the smallest state available. Some other PRNGs recommend using it for seeding their state.
+// --- Discrete distribution ---
+// -----------------------------
+
+// Alias method by A. J. Walker with the numerically stable construction by M. D. Vose,
+// see https://www.keithschwarz.com/darts-dice-coins/
 //
-class SplitMix64 {
-public:
-    using result_type = std::uint64_t;
+// Every category 'i' gets a bucket of equal probability '1 / n' that holds either only 'i' or 'i' with probability
+// 'threshold' and its 'alias' otherwise. Buckets are built by distributing excess mass of "large" categories into
+// "small" ones in O(n), after that sampling a value takes one uniform integer and one uniform real regardless of 'n'.
+template <class T>
+struct _alias_bucket {
+    double threshold; // stored together with the alias so sampling touches a single cache line
+    T      alias;
+};
 
-private:
-    result_type s{};
+template <class T = int, _require<std::is_integral_v<T>> = true>
+struct DiscreteDistribution {
+    using result_type = T;
 
-public:
-    constexpr explicit SplitMix64(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+    struct param_type {
+        std::vector<double> weights;
+    };
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit SplitMix64(SeedSeq&& seq) {
-        this->seed(seq);
+    DiscreteDistribution() : DiscreteDistribution({1.}) {}
+
+    template <class It>
+    DiscreteDistribution(It first, It last) : pars{std::vector<double>(first, last)} {
+        this->rebuild();
     }
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+    DiscreteDistribution(std::initializer_list<double> weights)
+        : DiscreteDistribution(weights.begin(), weights.end()) {}
 
-    constexpr void seed(result_type seed) noexcept { this->s = seed; }
+    DiscreteDistribution(const param_type& p) : pars(p) { this->rebuild(); }
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        this->s = _seed_seq_to_uint64(seq);
+    template <class Gen>
+    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
+        assert(!this->outdated && "Weights were changed without a 'rebuild()'");
+
+        const auto  index  = _generate_uniform_int<std::size_t>(gen, 0, this->buckets.size() - 1);
+        const auto& bucket = this->buckets[index];
+        return generate_canonical<double>(gen) < bucket.threshold ? static_cast<result_type>(index) : bucket.alias;
     }
 
-    constexpr result_type operator()() noexcept {
-        std::uint64_t result = (this->s += 0x9E3779B97f4A7C15);
-        result               = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
-        result               = (result ^ (result >> 27)) * 0x94D049BB133111EB;
-        return result ^ (result >> 31);
+    // Same as calling 'operator()' for each element, but takes generator output in bulk
+    template <class Gen, class It>
+    void fill(Gen& gen, It first, It last) const {
+        _fill_with_distribution(*this, gen, first, last);
     }
-};
 
-// Implementation of Xoshiro256++ suggested by David Blackman and Sebastiano Vigna,
-// see https://prng.di.unimi.it/
-//     https://prng.di.unimi.it/xoshiro256plusplus.c
-//
-// Performance: Good
-// Quality:     4/5
-// State:       32 bytes
-//
-// Excellent choice as a general purpose PRNG.
-// Used by several modern languages as their default.
-//
-class Xoshiro256PP {
-public:
-    using result_type = std::uint64_t;
+    // Changes a single weight, several weights can be changed before rebuilding the table once
+    void set_weight(std::size_t index, double weight) noexcept {
+        assert(index < this->pars.weights.size());
+        assert(weight >= 0);
 
-private:
-    std::array<result_type, 4> s{};
+        this->pars.weights[index] = weight;
+        this->outdated            = true;
+    }
 
-public:
-    constexpr explicit Xoshiro256PP(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+    // Rebuilds the table in O(n) reusing existing storage, must be called after 'set_weight()'
+    void rebuild() {
+        const std::size_t n = this->pars.weights.size();
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit Xoshiro256PP(SeedSeq&& seq) {
-        this->seed(seq);
-    }
+        assert(n > 0);
+        assert(n - 1 <= static_cast<std::size_t>(std::numeric_limits<result_type>::max()));
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    // while zero-state is considered invalid, PRNG can still produce 0 as a result
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+        double sum = 0;
+        for (const auto& weight : this->pars.weights) {
+            assert(weight >= 0);
+            sum += weight;
+        }
+        assert(sum > 0);
 
-    constexpr void seed(result_type seed) noexcept {
-        SplitMix64 splitmix{seed};
-        this->s[0] = splitmix(); // Xoshiro family recommends using
-        this->s[1] = splitmix(); // splitmix to initialize its state
-        this->s[2] = splitmix();
-        this->s[3] = splitmix();
-    }
+        // Scaled probabilities 'n * p[i]' have an average of 1, categories below it are "small", rest are "large"
+        this->buckets.resize(n);
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        this->s[0] = _seed_seq_to_uint64(seq); // since seed_seq produces 32-bit ints,
-        this->s[1] = _seed_seq_to_uint64(seq); // we have to generate multiple and then
-        this->s[2] = _seed_seq_to_uint64(seq); // join them into std::uint64_t's to
-        this->s[3] = _seed_seq_to_uint64(seq); // properly initialize the entire state
+        const double scale = n / sum;
+        for (std::size_t i = 0; i < n; ++i) this->buckets[i] = {this->pars.weights[i] * scale, static_cast<T>(i)};
 
-        // ensure we don't hit an invalid all-zero state
-        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
+        // Instead of keeping worklists we sweep the table with two cursors, one for small & one for large categories.
+        // This gives the same O(n) complexity, but mostly sequential memory access, which matters for large tables.
+        const auto next = [&](std::size_t i, bool small) {
+            while (i < n && (this->buckets[i].threshold < 1.) != small) ++i;
+            return i;
+        };
+
+        std::size_t small = next(0, true), large = next(0, false), current = small;
+
+        while (current < n && large < n) {
+            this->buckets[current].alias = static_cast<result_type>(large);
+
+            // large category donates the mass missing from the small bucket and possibly becomes small itself
+            double& remaining = this->buckets[large].threshold;
+            remaining         = (remaining + this->buckets[current].threshold) - 1.;
+
+            if (remaining < 1. && large < small) { // small cursor has already passed it, fill this bucket right away
+                current = large;
+                large   = next(large + 1, false);
+                continue;
+            }
+            if (remaining < 1.) large = next(large + 1, false);
+            current = small = next(small + 1, true);
+        }
+
+        // leftover categories have probabilities of '1' up to rounding errors
+        for (std::size_t i = 0; i < n; ++i)
+            if (this->buckets[i].alias == static_cast<result_type>(i)) this->buckets[i].threshold = 1.;
+
+        this->outdated = false;
     }
 
-    constexpr result_type operator()() noexcept {
-        const result_type result = _rotl_value(this->s[0] + this->s[3], 23) + this->s[0];
-        const result_type t      = this->s[1] << 17;
-        this->s[2] ^= this->s[0];
-        this->s[3] ^= this->s[1];
-        this->s[1] ^= this->s[2];
-        this->s[0] ^= this->s[3];
-        this->s[2] ^= t;
-        this->s[3] = _rotl_value(this->s[3], 45);
-        return result;
+    template <class It>
+    void rebuild(It first, It last) {
+        this->pars.weights.assign(first, last);
+        this->rebuild();
+    }
+
+    [[nodiscard]] std::vector<double> probabilities() const {
+        double sum = 0;
+        for (const auto& weight : this->pars.weights) sum += weight;
+
+        std::vector<double> res = this->pars.weights;
+        for (auto& e : res) e /= sum;
+        return res;
     }
+
+    constexpr void                  reset() const noexcept {} // nothing to reset, provided for std-compatibility
+    [[nodiscard]] const param_type& params() const noexcept { return this->pars; }
+    void                            params(const param_type& p) { this->rebuild(p.weights.begin(), p.weights.end()); }
+    [[nodiscard]] std::size_t       size() const noexcept { return this->pars.weights.size(); }
+    [[nodiscard]] result_type       min() const noexcept { return 0; }
+    [[nodiscard]] result_type       max() const noexcept { return static_cast<result_type>(this->size() - 1); }
+
+private:
+    param_type                    pars;
+    std::vector<_alias_bucket<T>> buckets;
+    bool                          outdated = false;
 };
 
-// Implementation of Romu DuoJr engine from paper by "Mark A. Overton",
-// see https://www.romu-random.org/
-//     https://www.romu-random.org/romupaper.pdf
-//
-// Performance: Excellent
-// Quality:     2/5
-// State:       16 bytes
+template <class T>
+bool operator==(const DiscreteDistribution<T>& lhs, const DiscreteDistribution<T>& rhs) {
+    return lhs.probabilities() == rhs.probabilities();
+}
+
+// ===========================
+// --- Parallel generation ---
+// ===========================
+
+// Output is split into blocks of a fixed size, block 'b' gets generated by 'make_stream(master, b)' with a fresh
+// copy of the distribution. Values depend only on their position in the output, so any partitioning between
+// threads (or between separate 'fill_chunk()' calls) produces the same result.
 //
-// Romu family provides extemely fast non-linear PRNGs, "DuoJr" is the fastest 64-bit option available
-// that still provides some resemblance of quality. There has been some concerns over the math used
-// in its original paper (see https://news.ycombinator.com/item?id=22447848), however I'd yet to find
-// a faster 64-bit PRNG, so if speed is needed at all cost this one provides it.
+// Streams have to be O(1) to derive, which leaves counter-based & ChaCha generators. Seed-based overloads use
+// 'Philox4x32' with the 64-bit seed as a key.
 //
-class RomuDuoJr64 {
-public:
-    using result_type = std::uint64_t;
+// Modules are supposed to stay independent, so we can't reuse 'utl::parallel' here, 'parallel_fill()' uses a minimal
+// static split over 'std::thread', while 'fill_chunk()' is a building block for other schedulers (like tasks of
+// 'utl::parallel'). Exceptions thrown by the workers are rethrown in the calling thread after all workers are joined.
 
-private:
-    std::array<result_type, 2> s{};
+constexpr std::size_t _parallel_fill_block_size = 1024;
 
-public:
-    constexpr explicit RomuDuoJr64(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+template <class Gen>
+constexpr bool _has_constant_time_streams_v = _has_counter_v<Gen> || _has_nonce_v<Gen>;
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit RomuDuoJr64(SeedSeq&& seq) {
-        this->seed(seq);
-    }
+[[nodiscard]] constexpr generators::Philox4x32 _parallel_master(std::uint64_t seed) noexcept {
+    return generators::Philox4x32({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+}
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+template <class Func>
+void _parallel_for(std::size_t count, std::size_t min_grain, std::size_t thread_count, Func&& func) {
+    // 'func(low, high)' gets called for a set of contiguous ranges covering [0, count)
+    if (!thread_count) thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    thread_count = std::max<std::size_t>(std::min(thread_count, count / std::max<std::size_t>(min_grain, 1)), 1);
 
-    constexpr void seed(result_type seed) noexcept {
-        SplitMix64 splitmix{seed};
-        this->s[0] = splitmix(); // Like Xoshiro, Romu recommends
-        this->s[1] = splitmix(); // using SplitMix64 to initialize its state
+    if (thread_count == 1) {
+        if (count) func(std::size_t(0), count);
+        return;
     }
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        this->s[0] = _seed_seq_to_uint64(seq); // seed_seq returns 32-bit ints, we have to generate
-        this->s[1] = _seed_seq_to_uint64(seq); // multiple to initialize full state of 64-bit values
+    const auto chunk_low = [&](std::size_t t) { return count * t / thread_count; };
+    // keeps chunk sizes within 1 element of each other
 
-        // ensure we don't hit an invalid all-zero state
-        if (_is_zero_state(this->s)) this->seed(_default_seed<result_type>);
-    }
+    std::vector<std::exception_ptr> exceptions(thread_count);
+    std::vector<std::thread>        workers;
+    workers.reserve(thread_count - 1);
 
-    constexpr result_type operator()() noexcept {
-        const result_type res = this->s[0];
-        this->s[0]            = 15241094284759029579u * this->s[1];
-        this->s[1]            = this->s[1] - res;
-        this->s[1]            = _rotl_value(this->s[1], 27);
-        return res;
+    const auto run_chunk = [&](std::size_t t) {
+        try {
+            func(chunk_low(t), chunk_low(t + 1));
+        } catch (...) { exceptions[t] = std::current_exception(); }
+    };
+
+    for (std::size_t t = 1; t < thread_count; ++t) workers.emplace_back(run_chunk, t);
+    run_chunk(0); // calling thread takes the first chunk instead of idling
+
+    for (auto& worker : workers) worker.join();
+    for (const auto& e : exceptions)
+        if (e) std::rethrow_exception(e);
+}
+
+// Fills elements '[offset, offset + count)' of the output sequence, 'first' points to the element 'offset'
+template <class It, class Dist, class Gen>
+void _fill_blocks(It first, std::size_t offset, std::size_t count, const Dist& dist, const Gen& master) {
+    constexpr std::size_t block_size = _parallel_fill_block_size;
+
+    for (std::size_t i = offset, end = offset + count; i < end;) {
+        const std::size_t block      = i / block_size;
+        const std::size_t block_last = std::min((block + 1) * block_size, end);
+
+        Gen  gen        = make_stream(master, block);
+        Dist block_dist = dist; // standard distributions may cache values, each block starts from a clean copy
+
+        for (std::size_t skipped = block * block_size; skipped < i; ++skipped) static_cast<void>(block_dist(gen));
+
+        if constexpr (_has_distribution_fill_v<Dist>) {
+            const auto block_first = first;
+            std::advance(first, block_last - i);
+            block_dist.fill(gen, block_first, first);
+        } else {
+            for (std::size_t j = i; j < block_last; ++j, ++first) *first = block_dist(gen);
+        }
+        i = block_last;
     }
-};
+}
 
-// --- CSPRNGs ---
+template <class It, class Dist, class Gen, _require<_has_constant_time_streams_v<Gen>> = true>
+void fill_chunk(It first, It last, const Dist& dist, const Gen& master, std::size_t offset) {
+    _fill_blocks(first, offset, static_cast<std::size_t>(std::distance(first, last)), dist, master);
+}
+
+template <class It, class Dist>
+void fill_chunk(It first, It last, const Dist& dist, std::uint64_t seed, std::size_t offset) {
+    fill_chunk(first, last, dist, _parallel_master(seed), offset);
+}
+
+template <class It, class Dist, class Gen, _require<_has_constant_time_streams_v<Gen>> = true>
+void parallel_fill(It first, It last, const Dist& dist, const Gen& master, std::size_t thread_count = 0) {
+    constexpr std::size_t block_size = _parallel_fill_block_size;
+
+    const auto        count  = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t blocks = (count + block_size - 1) / block_size;
+
+    // threads get contiguous ranges of whole blocks, splitting further than a few blocks isn't worth it
+    _parallel_for(blocks, 16, thread_count, [&](std::size_t block_low, std::size_t block_high) {
+        const std::size_t low = block_low * block_size, high = std::min(block_high * block_size, count);
+        _fill_blocks(std::next(first, low), low, high - low, dist, master);
+    });
+}
+
+template <class It, class Dist>
+void parallel_fill(It first, It last, const Dist& dist, std::uint64_t seed, std::size_t thread_count = 0) {
+    parallel_fill(first, last, dist, _parallel_master(seed), thread_count);
+}
+
+// ================
+// --- Sampling ---
+// ================
+
+// --- Shuffle ---
 // ---------------
 
-// Implementation of ChaCha20 CPRNG conforming to RFC 7539 standard
-// see https://datatracker.ietf.org/doc/html/rfc7539
-//     https://www.rfc-editor.org/rfc/rfc7539#section-2.4
-//     https://en.wikipedia.org/wiki/Salsa20
+// Fisher-Yates shuffle with batched random indices by N. Brackett-Rozinsky & D. Lemire,
+// see https://arxiv.org/abs/2408.06213
+//
+// Lemire's method maps a 64-bit random value 'r' to '[0, b)' as the upper half of 128-bit product 'r * b', the lower
+// half is still uniformly distributed and can be reused for the next bound. As long as the product of bounds 'P'
+// fits into 64 bits, a single generator value produces several indices, rejection is needed only if the final low
+// half is below '2^64 mod P', which is rare for 'P' much smaller than '2^64'. Sequences are the same on every
+// platform, unlike 'std::shuffle()' which is implementation-defined.
 
-// Quarted-round operation for ChaCha20 stream cipher
-constexpr void _quarter_round(std::uint32_t& a, std::uint32_t& b, std::uint32_t& c, std::uint32_t& d) {
-    a += b, d ^= a, d = _rotl_value(d, 16);
-    c += d, b ^= c, b = _rotl_value(b, 12);
-    a += b, d ^= a, d = _rotl_value(d, 8);
-    c += d, b ^= c, b = _rotl_value(b, 7);
+// 64x64 -> 128 bit multiplication split into high & low halves
+[[nodiscard]] constexpr std::uint64_t _mulhilo(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128; // '__extension__' silences pedantic warnings about '__int128'
+
+    const uint128 product = uint128(a) * b;
+    hi                    = static_cast<std::uint64_t>(product >> 64);
+    return static_cast<std::uint64_t>(product);
+#else
+    const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+    const std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+
+    const std::uint64_t lo_lo = a_lo * b_lo, lo_hi = a_lo * b_hi, hi_lo = a_hi * b_lo, hi_hi = a_hi * b_hi;
+    const std::uint64_t cross = (lo_lo >> 32) + (lo_hi & 0xffffffff) + (hi_lo & 0xffffffff);
+
+    hi = hi_hi + (lo_hi >> 32) + (hi_lo >> 32) + (cross >> 32);
+    return a * b;
+#endif
 }
 
-template <std::size_t rounds>
-[[nodiscard]] constexpr std::array<std::uint32_t, 16> _chacha_rounds(const std::array<std::uint32_t, 16>& input) {
-    auto state = input;
+constexpr std::size_t _max_index_batch = 6;
 
-    static_assert(rounds % 2 == 0, "ChaCha rounds happen in pairs, total number should be divisible by 2.");
+// Fills 'indices[i]' with uniform values in '[0, bound - i)' for 'i < batch'
+template <std::size_t batch, class Gen>
+constexpr void _generate_index_batch(Gen& gen, std::uint64_t bound,
+                                     std::array<std::uint64_t, _max_index_batch>& indices) noexcept(noexcept(gen())) {
+    static_assert(0 < batch && batch <= _max_index_batch);
 
-    constexpr std::size_t alternating_round_pairs = rounds / 2;
-    // standard number of ChaCha rounds as per RFC 7539 is 20 (ChaCha20 variation),
-    // however there is a strong case for ChaCha12 being a more sensible default,
-    // at the moment the upper bound of what seems "crackable" is somewhere around 7 rounds,
-    // which is why ChaCha8 is also widely used whenever speed is necessary.
+    std::uint64_t product = bound;
+    for (std::size_t i = 1; i < batch; ++i) product *= bound - i;
 
-    for (std::size_t i = 0; i < alternating_round_pairs; ++i) {
-        // Column rounds
-        _quarter_round(state[0], state[4], state[8], state[12]);
-        _quarter_round(state[1], state[5], state[9], state[13]);
-        _quarter_round(state[2], state[6], state[10], state[14]);
-        _quarter_round(state[3], state[7], state[11], state[15]);
+    while (true) {
+        std::uint64_t low = _generate_uint64(gen);
+        for (std::size_t i = 0; i < batch; ++i) low = _mulhilo(low, bound - i, indices[i]);
 
-        // Diagonal rounds
-        _quarter_round(state[0], state[5], state[10], state[15]);
-        _quarter_round(state[1], state[6], state[11], state[12]);
-        _quarter_round(state[2], state[7], state[8], state[13]);
-        _quarter_round(state[3], state[4], state[9], state[14]);
+        if (low >= product || low >= (0 - product) % product) return; // '(0 - P) % P' is '2^64 mod P'
     }
+}
 
-    for (std::size_t i = 0; i < state.size(); ++i) state[i] += input[i];
-    return state;
+// Swaps elements 'i - 1', 'i - 2', ..., 'i - batch' with random elements preceding them
+template <std::size_t batch, class RandomIt, class Gen>
+void _shuffle_batch(RandomIt first, std::uint64_t i, Gen& gen) {
+    std::array<std::uint64_t, _max_index_batch> indices{};
+    _generate_index_batch<batch>(gen, i, indices);
+    for (std::size_t k = 0; k < batch; ++k) std::iter_swap(first + (i - 1 - k), first + indices[k]);
 }
 
-template <std::size_t rounds>
-class ChaCha {
-public:
-    using result_type = std::uint32_t;
+// Uniform index in '[0, bound)'
+template <class Gen>
+constexpr std::uint64_t _uniform_index(Gen& gen, std::uint64_t bound) noexcept(noexcept(gen())) {
+    std::array<std::uint64_t, _max_index_batch> indices{};
+    _generate_index_batch<1>(gen, bound, indices);
+    return indices[0];
+}
 
-private:
-    // Initial state components
-    std::array<result_type, 8> key{};     // 256-bit key
-    std::array<result_type, 3> nonce{};   // 96-bit nonce
-    std::uint32_t              counter{}; // 32-bit counter
+template <class RandomIt, class Gen>
+void shuffle(RandomIt first, RandomIt last, Gen& gen) {
+    auto i = static_cast<std::uint64_t>(std::distance(first, last));
+
+    // huge ranges take one generator value per index
+    for (; i > (std::uint64_t(1) << 30); --i) std::iter_swap(first + (i - 1), first + _uniform_index(gen, i));
+
+    // smaller bounds allow larger batches while keeping the product below 2^64,
+    // batch sizes are compile-time constants so the inner loops get fully unrolled
+    for (; i > (1 << 19); i -= 2) _shuffle_batch<2>(first, i, gen);
+    for (; i > (1 << 14); i -= 3) _shuffle_batch<3>(first, i, gen);
+    for (; i > (1 << 11); i -= 4) _shuffle_batch<4>(first, i, gen);
+    for (; i > (1 << 9); i -= 5) _shuffle_batch<5>(first, i, gen);
+    for (; i > 6; i -= 6) _shuffle_batch<6>(first, i, gen);
+    for (; i > 1; --i) _shuffle_batch<1>(first, i, gen);
+}
 
-    // Block
-    std::array<result_type, 16> block{};    // holds next 16 random numbers
-    std::size_t                 position{}; // current position in the block
+// --- Sampling without replacement ---
+// ------------------------------------
+
+// Floyd's algorithm, see J. Bentley & B. Floyd "Programming pearls: a sample of brilliance" (1987).
+// Takes exactly 'k' generator calls regardless of 'n', sparse samples use a hash set to track taken indices,
+// dense samples use a bitmap.
+template <class Gen>
+std::vector<std::size_t> sample_indices(std::size_t n, std::size_t k, Gen& gen) {
+    assert(k <= n);
+
+    std::vector<std::size_t> res;
+    res.reserve(k);
+
+    const auto floyd = [&](auto&& is_taken, auto&& take) {
+        for (std::size_t j = n - k; j < n; ++j) {
+            const std::size_t t      = _uniform_index(gen, j + 1);
+            const std::size_t chosen = is_taken(t) ? j : t; // 'j' can't be taken yet, all previous picks are below it
+            take(chosen);
+            res.push_back(chosen);
+        }
+    };
 
-    constexpr static std::array<result_type, 4> constant = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
-    // "Magic constants" for ChaCha20 are defined through bit representations of the following char arrays:
-    // { "expa", "nd 3", "2-by", "te k" },
-    // what we have here is exactly that except written as 'std::uint32_t'
+    if (k > n / 16) {
+        std::vector<bool> taken(n);
+        floyd([&](std::size_t i) { return bool(taken[i]); }, [&](std::size_t i) { taken[i] = true; });
+    } else {
+        std::unordered_set<std::size_t> taken;
+        taken.reserve(k);
+        floyd([&](std::size_t i) { return taken.count(i) != 0; }, [&](std::size_t i) { taken.insert(i); });
+    }
 
-    constexpr void generate_new_block() {
-        // Set ChaCha20 initial state as per RFC 7539
-        //
-        //          [ const   const const const ]
-        // State    [ key     key   key   key   ]
-        // matrix = [ key     key   key   key   ]
-        //          [ counter nonce nonce nonce ]
-        //
-        const std::array<std::uint32_t, 16> input = {
-            this->constant[0], this->constant[1], this->constant[2], this->constant[3], //
-            this->key[0],      this->key[1],      this->key[2],      this->key[3],      //
-            this->key[4],      this->key[5],      this->key[6],      this->key[7],      //
-            this->counter,     this->nonce[0],    this->nonce[1],    this->nonce[2]     //
-        };
+    return res;
+} // each k-subset is equally likely, order of the indices isn't random
 
-        // Fill new block
-        this->block = _chacha_rounds<rounds>(input);
-        ++this->counter;
-    }
+template <class RandomIt, class OutIt, class Gen>
+OutIt sample(RandomIt first, RandomIt last, OutIt out, std::size_t k, Gen& gen) {
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
 
-public:
-    constexpr explicit ChaCha(result_type seed = _default_seed<result_type>) noexcept { this->seed(seed); }
+    auto indices = sample_indices(n, std::min(k, n), gen);
+    std::sort(indices.begin(), indices.end()); // preserve relative order like 'std::sample()' does
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    explicit ChaCha(SeedSeq&& seq) {
-        this->seed(seq);
+    for (const auto& index : indices) *out = first[index], ++out;
+    return out;
+}
+
+// --- Reservoir sampling ---
+// --------------------------
+
+// Number of values Algorithm L skips before the next replacement, 'u' is uniform in (0, 1). For tiny 'w' the skip
+// is huge, so 'log(1 - w)' has to be computed without rounding '1 - w' to 1. Skips that don't fit (including
+// non-finite ones after 'w' underflows to 0) saturate to 'limit'.
+[[nodiscard]] constexpr std::uint64_t _reservoir_skip(double u, double w, std::uint64_t limit) noexcept {
+    const double gap = _log(u) / _log1p(-w);
+    if (!(gap >= 0. && gap < 0x1p64)) return limit; // also catches NaN
+    return std::min(static_cast<std::uint64_t>(gap), limit);
+}
+
+// Algorithm L by K.-H. Li, see https://dl.acm.org/doi/10.1145/198429.198435
+//
+// Keeps a uniform sample of 'size' values out of a stream of unknown length. Instead of drawing a random number
+// for every value it computes how many values to skip until the next replacement, which takes O(k (1 + log(n / k)))
+// generator calls in total. Logarithms use 'constexpr' implementations to stay platform-independent.
+template <class T>
+class ReservoirSampler {
+    std::size_t    size;
+    std::vector<T> reservoir;
+    std::uint64_t  seen = 0;
+    std::uint64_t  next = 0; // index of the next value that replaces something in the reservoir
+    double         w    = 1;
+
+    template <class Gen>
+    void advance_w(Gen& gen) {
+        this->w *= _exp(_log(_generate_open_canonical(gen)) / this->size);
     }
 
-    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
-    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+    template <class Gen>
+    void schedule_next(Gen& gen) {
+        const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() - this->seen - 1;
+        this->next                = this->seen + 1 + _reservoir_skip(_generate_open_canonical(gen), this->w, limit);
+    }
 
-    constexpr void seed(result_type seed) {
-        // Use some other PRNG to setup initial state
-        SplitMix32 splitmix{seed};
-        for (auto& e : this->key) e = splitmix();
-        for (auto& e : this->nonce) e = splitmix();
-        this->counter  = 0; // counter can be set to any number, but usually 0 or 1 is used
-        this->position = 0;
+public:
+    explicit ReservoirSampler(std::size_t size) : size(size) {
+        assert(size > 0);
+        this->reservoir.reserve(size);
+    }
 
-        this->generate_new_block();
+    template <class Gen>
+    void push(const T& value, Gen& gen) {
+        if (this->reservoir.size() < this->size) {
+            this->reservoir.push_back(value);
+            if (this->reservoir.size() == this->size) this->advance_w(gen), this->schedule_next(gen);
+        } else if (this->seen == this->next) {
+            this->reservoir[_uniform_index(gen, this->size)] = value;
+            this->advance_w(gen), this->schedule_next(gen);
+        }
+        ++this->seen;
     }
 
-    template <class SeedSeq, _is_seed_seq_enable_if<SeedSeq> = true>
-    void seed(SeedSeq&& seq) {
-        // Seed sequence allows user to introduce more entropy into the state
+    [[nodiscard]] const std::vector<T>& values() const noexcept { return this->reservoir; }
+    [[nodiscard]] std::uint64_t         count() const noexcept { return this->seen; }
+};
 
-        seq.generate(this->key.begin(), this->key.end());
-        seq.generate(this->nonce.begin(), this->nonce.end());
+// Algorithm A-Res by P. S. Efraimidis & P. G. Spirakis, see https://doi.org/10.1016/j.ipl.2005.11.003
+//
+// Every value gets a key 'u^(1 / weight)', the sample consists of 'size' values with the largest keys, which are
+// kept in a min-heap. Keys are stored as logarithms 'log(u) / weight' to avoid underflow for large weights.
+template <class T>
+class WeightedReservoirSampler {
+    struct entry {
+        double key;
+        T      value;
+    };
 
-        this->counter  = 0; // counter can be set to any number, but usually 0 or 1 is used
-        this->position = 0;
+    std::size_t        size;
+    std::vector<entry> heap;
+    std::uint64_t      seen = 0;
 
-        this->generate_new_block();
+    static bool greater_key(const entry& lhs, const entry& rhs) noexcept { return lhs.key > rhs.key; }
+
+public:
+    explicit WeightedReservoirSampler(std::size_t size) : size(size) {
+        assert(size > 0);
+        this->heap.reserve(size);
     }
 
-    constexpr result_type operator()() noexcept {
-        // Generate new block if necessary
-        if (this->position >= 16) {
-            this->generate_new_block();
-            this->position = 0;
+    template <class Gen>
+    void push(const T& value, double weight, Gen& gen) {
+        assert(weight >= 0);
+
+        ++this->seen;
+        if (weight == 0) return; // values with zero weight are never selected
+
+        const double key = _log(_generate_open_canonical(gen)) / weight;
+
+        if (this->heap.size() < this->size) {
+            this->heap.push_back({key, value});
+            std::push_heap(this->heap.begin(), this->heap.end(), greater_key);
+        } else if (key > this->heap.front().key) {
+            std::pop_heap(this->heap.begin(), this->heap.end(), greater_key);
+            this->heap.back() = {key, value};
+            std::push_heap(this->heap.begin(), this->heap.end(), greater_key);
         }
+    }
 
-        // Get random value from the block and advance position cursor
-        return this->block[this->position++];
+    [[nodiscard]] std::vector<T> values() const {
+        std::vector<T> res;
+        res.reserve(this->heap.size());
+        for (const auto& e : this->heap) res.push_back(e.value);
+        return res;
     }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return this->seen; }
 };
 
-using ChaCha8  = ChaCha<8>;
-using ChaCha12 = ChaCha<12>;
-using ChaCha20 = ChaCha<20>;
+// --- Parallel shuffle ---
+// ------------------------
 
+// MergeShuffle by A. Bacher, O. Bodini, A. Hollender & J. Lumbroso, see https://arxiv.org/abs/1508.03167
+//
+// Blocks of the range are shuffled independently, after which neighbouring shuffled blocks get merged level by level:
+// merge takes elements from the left or right part based on random bits, once one part runs out the rest is inserted
+// with Fisher-Yates steps. Every block & merge uses its own stream derived from its position in the merge tree,
+// so the result doesn't depend on the number of threads.
 
-} // namespace generators
+constexpr std::size_t _merge_shuffle_block_size = std::size_t(1) << 16;
 
-// ===========================
-// --- Default global PRNG ---
-// ===========================
+template <class RandomIt, class Gen>
+void _merge_shuffled(RandomIt first, RandomIt middle, RandomIt last, Gen& gen) {
+    RandomIt i = first, j = middle;
 
-using default_generator_type = generators::Xoshiro256PP;
-using default_result_type    = default_generator_type::result_type;
+    std::uint64_t bits      = 0;
+    std::size_t   bits_left = 0;
 
-inline default_generator_type default_generator;
+    while (true) {
+        if (!bits_left) bits = _generate_uint64(gen), bits_left = 64;
+        const bool take_right = bits & 1;
+        bits >>= 1, --bits_left;
+
+        if (take_right) {
+            if (j == last) break;
+            std::iter_swap(i, j);
+            ++j;
+        } else if (i == j) break;
+        ++i;
+    }
+
+    for (; i != last; ++i) {
+        const auto position = static_cast<std::uint64_t>(i - first);
+        std::iter_swap(i, first + _uniform_index(gen, position + 1));
+    }
+}
+
+template <class RandomIt, class Gen>
+void _merge_shuffle(RandomIt first, RandomIt last, const Gen& master, std::size_t thread_count,
+                    std::size_t block_size) {
+    const auto        n      = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t blocks = (n + block_size - 1) / block_size;
+
+    _parallel_for(blocks, 1, thread_count, [&](std::size_t low, std::size_t high) {
+        for (std::size_t b = low; b < high; ++b) {
+            Gen gen = make_stream(master, b);
+            shuffle(first + b * block_size, first + std::min((b + 1) * block_size, n), gen);
+        }
+    });
+
+    std::uint64_t stream_offset = blocks; // merges use streams after the ones of the blocks
+    for (std::size_t width = block_size; width < n; width *= 2) {
+        const std::size_t merges = (n + 2 * width - 1) / (2 * width);
+
+        _parallel_for(merges, 1, thread_count, [&](std::size_t low, std::size_t high) {
+            for (std::size_t m = low; m < high; ++m) {
+                const std::size_t lo = m * 2 * width, mid = std::min(lo + width, n), hi = std::min(lo + 2 * width, n);
+                if (mid == hi) continue;
+
+                Gen gen = make_stream(master, stream_offset + m);
+                _merge_shuffled(first + lo, first + mid, first + hi, gen);
+            }
+        });
+
+        stream_offset += merges;
+    }
+}
+
+template <class RandomIt, class Gen, _require<_has_constant_time_streams_v<Gen>> = true>
+void parallel_shuffle(RandomIt first, RandomIt last, const Gen& master, std::size_t thread_count = 0) {
+    _merge_shuffle(first, last, master, thread_count, _merge_shuffle_block_size);
+}
+
+template <class RandomIt>
+void parallel_shuffle(RandomIt first, RandomIt last, std::uint64_t seed, std::size_t thread_count = 0) {
+    parallel_shuffle(first, last, _parallel_master(seed), thread_count);
+}
+
+// ==============================
+// --- Quasi-random sequences ---
+// ==============================
 
-inline std::seed_seq entropy_seq() {
-    // Ensure thread safery of our entropy source, it should generally work fine even without
-    // it, but with this we can be sure things never race
-    static std::mutex     entropy_mutex;
-    const std::lock_guard entropy_guard(entropy_mutex);
+// Low-discrepancy sequences fill '[0, 1)^d' much more evenly than independent random points, which makes
+// quasi-Monte Carlo integration converge close to O(1 / N) instead of O(1 / sqrt(N)) for smooth enough integrands.
+// All sequences share the same interface:
+//    > 'next(out)' writes a single 'd'-dimensional point
+//    > 'fill(first, last)' writes several points contiguously, point after point
+//    > 'seek(index)' & 'discard(n)' jump to arbitrary index, which allows splitting the sequence between threads
+//    > 'scramble(gen)' applies a randomization that preserves the low-discrepancy structure
 
-    // Hardware entropy (if implemented),
-    // some platfroms (mainly MinGW) implements random device as a regular PRNG that
-    // doesn't change from run to run, this is horrible, but we can somewhat improve
-    // things by mixing other sources of entropy. Since hardware entropy is a rather
-    // limited resource we only call it once.
-    static std::uint32_t          seed_rd = std::random_device{}();
-    // after that we just scramble it with a regular PRNG
-    static generators::SplitMix32 splitmix{seed_rd};
-    seed_rd = splitmix();
+// Converts fixed-point fraction '[0, 2^64)' to '[0, 1)', rounds down to avoid producing '1'
+template <class T>
+[[nodiscard]] constexpr T _fixed_point_to_unit(std::uint64_t x) noexcept {
+    constexpr int bits = std::numeric_limits<T>::digits;
+    return static_cast<T>(x >> (64 - bits)) * (T(1) / static_cast<T>(std::uint64_t(1) << bits));
+}
 
-    // Time in nanoseconds (on some platforms microseconds)
-    const auto seed_time = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+template <class Sequence, class OutIt>
+void _fill_points(Sequence& sequence, OutIt first, OutIt last) {
+    assert(std::distance(first, last) % sequence.dimensions() == 0);
+    while (first != last) first = sequence.next(first);
+}
 
-    // Heap address (tends to be random each run on most platforms)
-    std::vector<std::uint32_t> dummy_vec(1, seed_rd);
-    const std::size_t          heap_address_hash = std::hash<std::uint32_t*>{}(dummy_vec.data());
+// --- Sobol sequence ---
+// ----------------------
 
-    // Stack address (also tends to be random)
-    const std::size_t stack_address_hash = std::hash<decltype(heap_address_hash)*>{}(&heap_address_hash);
+// Sobol sequence in base 2, see I. M. Sobol "On the distribution of points in a cube and the approximate evaluation of
+// integrals" (1967) & S. Joe, F. Y. Kuo "Constructing Sobol sequences with better two-dimensional projections" (2008).
+//
+// Dimension 'j' is defined by a primitive polynomial over GF(2) and its initial direction numbers, points are generated
+// in Gray code order where every next point is a single XOR of a direction number per dimension. Jumping to index 'n'
+// XORs direction numbers of set bits of 'gray(n)', which takes at most 32 operations per dimension.
+//
+// Default parameters use primitive polynomials in order of increasing degree (same order as the Joe-Kuo tables).
+// First 481 dimensions (all polynomials up to degree 12) take their initial direction numbers from the
+// 'new-joe-kuo-6.21201' table, which has optimized 2D projections & matches reference implementations.
+// Dimensions past the table fall back onto direction numbers drawn from a fixed-seed generator, custom tables
+// can be passed through 'SobolParameters'. Scrambling applies a random linear matrix scramble (J. Matousek 1998)
+// followed by a random digital shift, both preserve the (t, s)-net properties of the sequence.
 
-    // CPU counter (if available, hashed compilation time otherwise)
-    const auto cpu_counter = static_cast<std::uint64_t>(utl_random_cpu_counter);
+struct SobolParameters {
+    std::uint32_t              degree;       // 's' in Joe-Kuo tables
+    std::uint32_t              coefficients; // 'a' in Joe-Kuo tables, inner coefficients of the polynomial
+    std::vector<std::uint32_t> initial;      // 'm_i' in Joe-Kuo tables, 'degree' odd values with 'm_i < 2^i'
+};
 
-    // Note:
-    // There are other sources of entropy, such as function adresses,
-    // but those can be rather "constant" on some platforms
+constexpr std::size_t _sobol_bits = 32;
 
-    return {seed_rd, _crush_to_uint32(seed_time), _crush_to_uint32(heap_address_hash),
-            _crush_to_uint32(stack_address_hash), _crush_to_uint32(cpu_counter)};
+// Multiplication of polynomials over GF(2) modulo 'modulus' of the given degree
+[[nodiscard]] constexpr std::uint64_t _gf2_mulmod(std::uint64_t a, std::uint64_t b, std::uint64_t modulus,
+                                                  std::uint32_t degree) noexcept {
+    std::uint64_t res = 0;
+    for (; b; b >>= 1) {
+        if (b & 1) res ^= a;
+        a <<= 1;
+        if (a >> degree) a ^= modulus;
+    }
+    return res;
 }
 
-inline std::uint32_t entropy() {
-    auto seq = entropy_seq();
-    return _seed_seq_to_uint32(seq);
-    // returns 'std::uint32_t' to mimic the return type of 'std::random_device', if we return uint64_t
-    // brace-initializers will complain about narrowing conversion on some generators. If someone want
-    // more entropy than that they can always use the whole sequence as a generic solution.
-    // Also having one 'random::entropy()' is much nicer than 'random::entropy_32()' & 'random::entropy_64()'.
+[[nodiscard]] constexpr std::uint64_t _gf2_powmod(std::uint64_t power, std::uint64_t modulus,
+                                                  std::uint32_t degree) noexcept {
+    std::uint64_t res = 1, base = 2; // 'base' is polynomial 'x'
+    for (; power; power >>= 1) {
+        if (power & 1) res = _gf2_mulmod(res, base, modulus, degree);
+        base = _gf2_mulmod(base, base, modulus, degree);
+    }
+    return res;
 }
 
-inline void seed(default_result_type random_seed) noexcept { default_generator.seed(random_seed); }
+// Polynomial of degree 's' is primitive when 'x' has multiplicative order '2^s - 1' modulo it
+[[nodiscard]] constexpr bool _is_primitive_gf2(std::uint64_t polynomial, std::uint32_t degree) noexcept {
+    const std::uint64_t order = (std::uint64_t(1) << degree) - 1;
+    if (_gf2_powmod(order, polynomial, degree) != 1) return false;
 
-inline void seed_with_entropy() {
-    auto seq = entropy_seq();
-    default_generator.seed(seq);
-    // for some god-forsaken reason seeding sequence constructors std:: generators take only l-value sequences
+    std::uint64_t rest = order;
+    for (std::uint64_t q = 2; q * q <= rest; ++q) {
+        if (rest % q) continue;
+        if (_gf2_powmod(order / q, polynomial, degree) == 1) return false;
+        while (rest % q == 0) rest /= q;
+    }
+    return rest == 1 || _gf2_powmod(order / rest, polynomial, degree) != 1;
 }
 
-// =====================
-// --- Distributions ---
-// =====================
+// Initial direction numbers 'm_i' of dimensions 2 to 481 from the 'new-joe-kuo-6.21201' table, stored back to back.
+// Polynomials aren't stored since they follow the enumeration order below, degree of each entry is known from it.
+constexpr std::size_t _joe_kuo_dimensions = 481;
+
+constexpr std::uint16_t _joe_kuo_initial[] = {
+    1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, 3, 3, 1, 3, 5, 13, 1, 1, 5, 5, 17, 1, 1, 5, 5, 5, 1, 1, 7, 11, 19, 1, 1, 5, 1, 1,
+    1, 1, 1, 3, 11, 1, 3, 5, 5, 31, 1, 3, 3, 9, 7, 49, 1, 1, 1, 15, 21, 21, 1, 3, 1, 13, 27, 49, 1, 1, 1, 15, 7, 5, 1,
+    3, 1, 15, 13, 25, 1, 1, 5, 5, 19, 61, 1, 3, 7, 11, 23, 15, 103, 1, 3, 7, 13, 13, 15, 69, 1, 1, 3, 13, 7, 35, 63, 1,
+    3, 5, 9, 1, 25, 53, 1, 3, 1, 13, 9, 35, 107, 1, 3, 1, 5, 27, 61, 31, 1, 1, 5, 11, 19, 41, 61, 1, 3, 5, 3, 3, 13, 69,
+    1, 1, 7, 13, 1, 19, 1, 1, 3, 7, 5, 13, 19, 59, 1, 1, 3, 9, 25, 29, 41, 1, 3, 5, 13, 23, 1, 55, 1, 3, 7, 3, 13, 59,
+    17, 1, 3, 1, 3, 5, 53, 69, 1, 1, 5, 5, 23, 33, 13, 1, 1, 7, 7, 1, 61, 123, 1, 1, 7, 9, 13, 61, 49, 1, 3, 3, 5, 3,
+    55, 33, 1, 3, 1, 15, 31, 13, 49, 245, 1, 3, 5, 15, 31, 59, 63, 97, 1, 3, 1, 11, 11, 11, 77, 249, 1, 3, 1, 11, 27,
+    43, 71, 9, 1, 1, 7, 15, 21, 11, 81, 45, 1, 3, 7, 3, 25, 31, 65, 79, 1, 3, 1, 1, 19, 11, 3, 205, 1, 1, 5, 9, 19, 21,
+    29, 157, 1, 3, 7, 11, 1, 33, 89, 185, 1, 3, 3, 3, 15, 9, 79, 71, 1, 3, 7, 11, 15, 39, 119, 27, 1, 1, 3, 1, 11, 31,
+    97, 225, 1, 1, 1, 3, 23, 43, 57, 177, 1, 3, 7, 7, 17, 17, 37, 71, 1, 3, 1, 5, 27, 63, 123, 213, 1, 1, 3, 5, 11, 43,
+    53, 133, 1, 3, 5, 5, 29, 17, 47, 173, 479, 1, 3, 3, 11, 3, 1, 109, 9, 69, 1, 1, 1, 5, 17, 39, 23, 5, 343, 1, 3, 1,
+    5, 25, 15, 31, 103, 499, 1, 1, 1, 11, 11, 17, 63, 105, 183, 1, 1, 5, 11, 9, 29, 97, 231, 363, 1, 1, 5, 15, 19, 45,
+    41, 7, 383, 1, 3, 7, 7, 31, 19, 83, 137, 221, 1, 1, 1, 3, 23, 15, 111, 223, 83, 1, 1, 5, 13, 31, 15, 55, 25, 161, 1,
+    1, 3, 13, 25, 47, 39, 87, 257, 1, 1, 1, 11, 21, 53, 125, 249, 293, 1, 1, 7, 11, 11, 7, 57, 79, 323, 1, 1, 5, 5, 17,
+    13, 81, 3, 131, 1, 1, 7, 13, 23, 7, 65, 251, 475, 1, 3, 5, 1, 9, 43, 3, 149, 11, 1, 1, 3, 13, 31, 13, 13, 255, 487,
+    1, 3, 3, 1, 5, 63, 89, 91, 127, 1, 1, 3, 3, 1, 19, 123, 127, 237, 1, 1, 5, 7, 23, 31, 37, 243, 289, 1, 1, 5, 11, 17,
+    53, 117, 183, 491, 1, 1, 1, 5, 1, 13, 13, 209, 345, 1, 1, 3, 15, 1, 57, 115, 7, 33, 1, 3, 1, 11, 7, 43, 81, 207,
+    175, 1, 3, 1, 1, 15, 27, 63, 255, 49, 1, 3, 5, 3, 27, 61, 105, 171, 305, 1, 1, 5, 3, 1, 3, 57, 249, 149, 1, 1, 3, 5,
+    5, 57, 15, 13, 159, 1, 1, 1, 11, 7, 11, 105, 141, 225, 1, 3, 3, 5, 27, 59, 121, 101, 271, 1, 3, 5, 9, 11, 49, 51,
+    59, 115, 1, 1, 7, 1, 23, 45, 125, 71, 419, 1, 1, 3, 5, 23, 5, 105, 109, 75, 1, 1, 7, 15, 7, 11, 67, 121, 453, 1, 3,
+    7, 3, 9, 13, 31, 27, 449, 1, 3, 1, 15, 19, 39, 39, 89, 15, 1, 1, 1, 1, 1, 33, 73, 145, 379, 1, 3, 1, 15, 15, 43, 29,
+    13, 483, 1, 1, 7, 3, 19, 27, 85, 131, 431, 1, 3, 3, 3, 5, 35, 23, 195, 349, 1, 3, 3, 7, 9, 27, 39, 59, 297, 1, 1, 3,
+    9, 11, 17, 13, 241, 157, 1, 3, 7, 15, 25, 57, 33, 189, 213, 1, 1, 7, 1, 9, 55, 73, 83, 217, 1, 3, 3, 13, 19, 27, 23,
+    113, 249, 1, 3, 5, 3, 23, 43, 3, 253, 479, 1, 1, 5, 5, 11, 5, 45, 117, 217, 1, 3, 3, 7, 29, 37, 33, 123, 147, 1, 3,
+    1, 15, 5, 5, 37, 227, 223, 459, 1, 1, 7, 5, 5, 39, 63, 255, 135, 487, 1, 3, 1, 7, 9, 7, 87, 249, 217, 599, 1, 1, 3,
+    13, 9, 47, 7, 225, 363, 247, 1, 3, 7, 13, 19, 13, 9, 67, 9, 737, 1, 3, 5, 5, 19, 59, 7, 41, 319, 677, 1, 1, 5, 3,
+    31, 63, 15, 43, 207, 789, 1, 1, 7, 9, 13, 39, 3, 47, 497, 169, 1, 3, 1, 7, 21, 17, 97, 19, 415, 905, 1, 3, 7, 1, 3,
+    31, 71, 111, 165, 127, 1, 1, 5, 11, 1, 61, 83, 119, 203, 847, 1, 3, 3, 13, 9, 61, 19, 97, 47, 35, 1, 1, 7, 7, 15,
+    29, 63, 95, 417, 469, 1, 3, 1, 9, 25, 9, 71, 57, 213, 385, 1, 3, 5, 13, 31, 47, 101, 57, 39, 341, 1, 1, 3, 3, 31,
+    57, 125, 173, 365, 551, 1, 3, 7, 1, 13, 57, 67, 157, 451, 707, 1, 1, 1, 7, 21, 13, 105, 89, 429, 965, 1, 1, 5, 9,
+    17, 51, 45, 119, 157, 141, 1, 3, 7, 7, 13, 45, 91, 9, 129, 741, 1, 3, 7, 1, 23, 57, 67, 141, 151, 571, 1, 1, 3, 11,
+    17, 47, 93, 107, 375, 157, 1, 3, 3, 5, 11, 21, 43, 51, 169, 915, 1, 1, 5, 3, 15, 55, 101, 67, 455, 625, 1, 3, 5, 9,
+    1, 23, 29, 47, 345, 595, 1, 3, 7, 7, 5, 49, 29, 155, 323, 589, 1, 3, 3, 7, 5, 41, 127, 61, 261, 717, 1, 3, 7, 7, 17,
+    23, 117, 67, 129, 1009, 1, 1, 3, 13, 11, 39, 21, 207, 123, 305, 1, 1, 3, 9, 29, 3, 95, 47, 231, 73, 1, 3, 1, 9, 1,
+    29, 117, 21, 441, 259, 1, 3, 1, 13, 21, 39, 125, 211, 439, 723, 1, 1, 7, 3, 17, 63, 115, 89, 49, 773, 1, 3, 7, 13,
+    11, 33, 101, 107, 63, 73, 1, 1, 5, 5, 13, 57, 63, 135, 437, 177, 1, 1, 3, 7, 27, 63, 93, 47, 417, 483, 1, 1, 3, 1,
+    23, 29, 1, 191, 49, 23, 1, 1, 3, 15, 25, 55, 9, 101, 219, 607, 1, 3, 1, 7, 7, 19, 51, 251, 393, 307, 1, 3, 3, 3, 25,
+    55, 17, 75, 337, 3, 1, 1, 1, 13, 25, 17, 65, 45, 479, 413, 1, 1, 7, 7, 27, 49, 99, 161, 213, 727, 1, 3, 5, 1, 23, 5,
+    43, 41, 251, 857, 1, 3, 3, 7, 11, 61, 39, 87, 383, 835, 1, 1, 3, 15, 13, 7, 29, 7, 505, 923, 1, 3, 7, 1, 5, 31, 47,
+    157, 445, 501, 1, 1, 3, 7, 1, 43, 9, 147, 115, 605, 1, 3, 3, 13, 5, 1, 119, 211, 455, 1001, 1, 1, 3, 5, 13, 19, 3,
+    243, 75, 843, 1, 3, 7, 7, 1, 19, 91, 249, 357, 589, 1, 1, 1, 9, 1, 25, 109, 197, 279, 411, 1, 3, 1, 15, 23, 57, 59,
+    135, 191, 75, 1, 1, 5, 15, 29, 21, 39, 253, 383, 349, 1, 3, 3, 5, 19, 45, 61, 151, 199, 981, 1, 3, 5, 13, 9, 61,
+    107, 141, 141, 1, 1, 3, 1, 11, 27, 25, 85, 105, 309, 979, 1, 3, 3, 11, 19, 7, 115, 223, 349, 43, 1, 1, 7, 9, 21, 39,
+    123, 21, 275, 927, 1, 1, 7, 13, 15, 41, 47, 243, 303, 437, 1, 1, 1, 7, 7, 3, 15, 99, 409, 719, 1, 3, 3, 15, 27, 49,
+    113, 123, 113, 67, 469, 1, 3, 7, 11, 3, 23, 87, 169, 119, 483, 199, 1, 1, 5, 15, 7, 17, 109, 229, 179, 213, 741, 1,
+    1, 5, 13, 11, 17, 25, 135, 403, 557, 1433, 1, 3, 1, 1, 1, 61, 67, 215, 189, 945, 1243, 1, 1, 7, 13, 17, 33, 9, 221,
+    429, 217, 1679, 1, 1, 3, 11, 27, 3, 15, 93, 93, 865, 1049, 1, 3, 7, 7, 25, 41, 121, 35, 373, 379, 1547, 1, 3, 3, 9,
+    11, 35, 45, 205, 241, 9, 59, 1, 3, 1, 7, 3, 51, 7, 177, 53, 975, 89, 1, 1, 3, 5, 27, 1, 113, 231, 299, 759, 861, 1,
+    3, 3, 15, 25, 29, 5, 255, 139, 891, 2031, 1, 3, 1, 1, 13, 9, 109, 193, 419, 95, 17, 1, 1, 7, 9, 3, 7, 29, 41, 135,
+    839, 867, 1, 1, 7, 9, 25, 49, 123, 217, 113, 909, 215, 1, 1, 7, 3, 23, 15, 43, 133, 217, 327, 901, 1, 1, 3, 3, 13,
+    53, 63, 123, 477, 711, 1387, 1, 1, 3, 15, 7, 29, 75, 119, 181, 957, 247, 1, 1, 1, 11, 27, 25, 109, 151, 267, 99,
+    1461, 1, 3, 7, 15, 5, 5, 53, 145, 11, 725, 1501, 1, 3, 7, 1, 9, 43, 71, 229, 157, 607, 1835, 1, 3, 3, 13, 25, 1, 5,
+    27, 471, 349, 127, 1, 1, 1, 1, 23, 37, 9, 221, 269, 897, 1685, 1, 1, 3, 3, 31, 29, 51, 19, 311, 553, 1969, 1, 3, 7,
+    5, 5, 55, 17, 39, 475, 671, 1529, 1, 1, 7, 1, 1, 35, 47, 27, 437, 395, 1635, 1, 1, 7, 3, 13, 23, 43, 135, 327, 139,
+    389, 1, 3, 7, 3, 9, 25, 91, 25, 429, 219, 513, 1, 1, 3, 5, 13, 29, 119, 201, 277, 157, 2043, 1, 3, 5, 3, 29, 57, 13,
+    17, 167, 739, 1031, 1, 3, 3, 5, 29, 21, 95, 27, 255, 679, 1531, 1, 3, 7, 15, 9, 5, 21, 71, 61, 961, 1201, 1, 3, 5,
+    13, 15, 57, 33, 93, 459, 867, 223, 1, 1, 1, 15, 17, 43, 127, 191, 67, 177, 1073, 1, 1, 1, 15, 23, 7, 21, 199, 75,
+    293, 1611, 1, 3, 7, 13, 15, 39, 21, 149, 65, 741, 319, 1, 3, 7, 11, 23, 13, 101, 89, 277, 519, 711, 1, 3, 7, 15, 19,
+    27, 85, 203, 441, 97, 1895, 1, 3, 1, 3, 29, 25, 21, 155, 11, 191, 197, 1, 1, 7, 5, 27, 11, 81, 101, 457, 675, 1687,
+    1, 3, 1, 5, 25, 5, 65, 193, 41, 567, 781, 1, 3, 1, 5, 11, 15, 113, 77, 411, 695, 1111, 1, 1, 3, 9, 11, 53, 119, 171,
+    55, 297, 509, 1, 1, 1, 1, 11, 39, 113, 139, 165, 347, 595, 1, 3, 7, 11, 9, 17, 101, 13, 81, 325, 1733, 1, 3, 1, 1,
+    21, 43, 115, 9, 113, 907, 645, 1, 1, 7, 3, 9, 25, 117, 197, 159, 471, 475, 1, 3, 1, 9, 11, 21, 57, 207, 485, 613,
+    1661, 1, 1, 7, 7, 27, 55, 49, 223, 89, 85, 1523, 1, 1, 5, 3, 19, 41, 45, 51, 447, 299, 1355, 1, 3, 1, 13, 1, 33,
+    117, 143, 313, 187, 1073, 1, 1, 7, 7, 5, 11, 65, 97, 377, 377, 1501, 1, 3, 1, 1, 21, 35, 95, 65, 99, 23, 1239, 1, 1,
+    5, 9, 3, 37, 95, 167, 115, 425, 867, 1, 3, 3, 13, 1, 37, 27, 189, 81, 679, 773, 1, 1, 3, 11, 1, 61, 99, 233, 429,
+    969, 49, 1, 1, 1, 7, 25, 63, 99, 165, 245, 793, 1143, 1, 1, 5, 11, 11, 43, 55, 65, 71, 283, 273, 1, 1, 5, 5, 9, 3,
+    101, 251, 355, 379, 1611, 1, 1, 1, 15, 21, 63, 85, 99, 49, 749, 1335, 1, 1, 5, 13, 27, 9, 121, 43, 255, 715, 289, 1,
+    3, 1, 5, 27, 19, 17, 223, 77, 571, 1415, 1, 1, 5, 3, 13, 59, 125, 251, 195, 551, 1737, 1, 3, 3, 15, 13, 27, 49, 105,
+    389, 971, 755, 1, 3, 5, 15, 23, 43, 35, 107, 447, 763, 253, 1, 3, 5, 11, 21, 3, 17, 39, 497, 407, 611, 1, 1, 7, 13,
+    15, 31, 113, 17, 23, 507, 1995, 1, 1, 7, 15, 3, 15, 31, 153, 423, 79, 503, 1, 1, 7, 9, 19, 25, 23, 171, 505, 923,
+    1989, 1, 1, 5, 9, 21, 27, 121, 223, 133, 87, 697, 1, 1, 5, 5, 9, 19, 107, 99, 319, 765, 1461, 1, 1, 3, 3, 19, 25, 3,
+    101, 171, 729, 187, 1, 1, 3, 1, 13, 23, 85, 93, 291, 209, 37, 1, 1, 1, 15, 25, 25, 77, 253, 333, 947, 1073, 1, 1, 3,
+    9, 17, 29, 55, 47, 255, 305, 2037, 1, 3, 3, 9, 29, 63, 9, 103, 489, 939, 1523, 1, 3, 7, 15, 7, 31, 89, 175, 369,
+    339, 595, 1, 3, 7, 13, 25, 5, 71, 207, 251, 367, 665, 1, 3, 3, 3, 21, 25, 75, 35, 31, 321, 1603, 1, 1, 1, 9, 11, 1,
+    65, 5, 11, 329, 535, 1, 1, 5, 3, 19, 13, 17, 43, 379, 485, 383, 1, 3, 5, 13, 13, 9, 85, 147, 489, 787, 1133, 1, 3,
+    1, 1, 5, 51, 37, 129, 195, 297, 1783, 1, 1, 3, 15, 19, 57, 59, 181, 455, 697, 2033, 1, 3, 7, 1, 27, 9, 65, 145, 325,
+    189, 201, 1, 3, 1, 15, 31, 23, 19, 5, 485, 581, 539, 1, 1, 7, 13, 11, 15, 65, 83, 185, 847, 831, 1, 3, 5, 7, 7, 55,
+    73, 15, 303, 511, 1905, 1, 3, 5, 9, 7, 21, 45, 15, 397, 385, 597, 1, 3, 7, 3, 23, 13, 73, 221, 511, 883, 1265, 1, 1,
+    3, 11, 1, 51, 73, 185, 33, 975, 1441, 1, 3, 3, 9, 19, 59, 21, 39, 339, 37, 143, 1, 1, 7, 1, 31, 33, 19, 167, 117,
+    635, 639, 1, 1, 1, 3, 5, 13, 59, 83, 355, 349, 1967, 1, 1, 1, 5, 19, 3, 53, 133, 97, 863, 983, 1, 3, 1, 13, 9, 41,
+    91, 105, 173, 97, 625, 1, 1, 5, 3, 7, 49, 115, 133, 71, 231, 1063, 1, 1, 7, 5, 17, 43, 47, 45, 497, 547, 757, 1, 3,
+    5, 15, 21, 61, 123, 191, 249, 31, 631, 1, 3, 7, 9, 17, 7, 11, 185, 127, 169, 1951, 1, 1, 5, 13, 11, 11, 9, 49, 29,
+    125, 791, 1, 1, 1, 15, 31, 41, 13, 167, 273, 429, 57, 1, 3, 5, 3, 27, 7, 35, 209, 65, 265, 1393, 1, 3, 1, 13, 31,
+    19, 53, 143, 135, 9, 1021, 1, 1, 7, 13, 31, 5, 115, 153, 143, 957, 623, 1, 1, 5, 11, 25, 19, 29, 31, 297, 943, 443,
+    1, 3, 3, 5, 21, 11, 127, 81, 479, 25, 699, 1, 1, 3, 11, 25, 31, 97, 19, 195, 781, 705, 1, 1, 5, 5, 31, 11, 75, 207,
+    197, 885, 2037, 1, 1, 1, 11, 9, 23, 29, 231, 307, 17, 1497, 1, 1, 5, 11, 11, 43, 111, 233, 307, 523, 1259, 1, 1, 7,
+    5, 1, 21, 107, 229, 343, 933, 217, 1, 1, 1, 11, 3, 21, 125, 131, 405, 599, 1469, 1, 3, 5, 5, 9, 39, 33, 81, 389,
+    151, 811, 1, 1, 7, 7, 7, 1, 59, 223, 265, 529, 2021, 1, 3, 1, 3, 9, 23, 85, 181, 47, 265, 49, 1, 3, 5, 11, 19, 23,
+    9, 7, 157, 299, 1983, 1, 3, 1, 5, 15, 5, 21, 105, 29, 339, 1041, 1, 1, 1, 1, 5, 33, 65, 85, 111, 705, 479, 1, 1, 1,
+    7, 9, 35, 77, 87, 151, 321, 101, 1, 1, 5, 7, 17, 1, 51, 197, 175, 811, 1229, 1, 3, 3, 15, 23, 37, 85, 185, 239, 543,
+    731, 1, 3, 1, 7, 7, 55, 111, 109, 289, 439, 243, 1, 1, 7, 11, 17, 53, 35, 217, 259, 853, 1667, 1, 3, 1, 9, 1, 63,
+    87, 17, 73, 565, 1091, 1, 1, 3, 3, 11, 41, 1, 57, 295, 263, 1029, 1, 1, 5, 1, 27, 45, 109, 161, 411, 421, 1395, 1,
+    3, 5, 11, 25, 35, 47, 191, 339, 417, 1727, 1, 1, 5, 15, 21, 1, 93, 251, 351, 217, 1767, 1, 3, 3, 11, 3, 7, 75, 155,
+    313, 211, 491, 1, 3, 3, 5, 11, 9, 101, 161, 453, 913, 1067, 1, 1, 3, 1, 15, 45, 127, 141, 163, 727, 1597, 1, 3, 3,
+    7, 1, 33, 63, 73, 73, 341, 1691, 1, 3, 5, 13, 15, 39, 53, 235, 77, 99, 949, 1, 1, 5, 13, 31, 17, 97, 13, 215, 301,
+    1927, 1, 1, 7, 1, 1, 37, 91, 93, 441, 251, 1131, 1, 3, 7, 9, 25, 5, 105, 69, 81, 943, 1459, 1, 3, 7, 11, 31, 43, 13,
+    209, 27, 1017, 501, 1, 1, 7, 15, 1, 33, 31, 233, 161, 507, 387, 1, 3, 3, 5, 5, 53, 33, 177, 503, 627, 1927, 1, 1, 7,
+    11, 7, 61, 119, 31, 457, 229, 1875, 1, 1, 5, 15, 19, 5, 53, 201, 157, 885, 1057, 1, 3, 7, 9, 1, 35, 51, 113, 249,
+    425, 1009, 1, 3, 5, 7, 21, 53, 37, 155, 119, 345, 631, 1, 3, 5, 7, 15, 31, 109, 69, 503, 595, 1879, 1, 3, 3, 1, 25,
+    35, 65, 131, 403, 705, 503, 1, 3, 7, 7, 19, 33, 11, 153, 45, 633, 499, 1, 3, 3, 5, 11, 3, 29, 93, 487, 33, 703, 1,
+    1, 3, 15, 21, 53, 107, 179, 387, 927, 1757, 1, 1, 3, 7, 21, 45, 51, 147, 175, 317, 361, 1, 1, 1, 7, 7, 13, 15, 243,
+    269, 795, 1965, 1, 1, 3, 5, 19, 33, 57, 115, 443, 537, 627, 1, 3, 3, 9, 3, 39, 25, 61, 185, 717, 1049, 1, 3, 7, 3,
+    7, 37, 107, 153, 7, 269, 1581, 1, 1, 7, 3, 7, 41, 91, 41, 145, 489, 1245, 1, 1, 5, 9, 7, 7, 105, 81, 403, 407, 283,
+    1, 1, 7, 9, 27, 55, 29, 77, 193, 963, 949, 1, 1, 5, 3, 25, 51, 107, 63, 403, 917, 815, 1, 1, 7, 3, 7, 61, 19, 51,
+    457, 599, 535, 1, 3, 7, 1, 23, 51, 105, 153, 239, 215, 1847, 1, 1, 3, 5, 27, 23, 79, 49, 495, 45, 1935, 1, 1, 1, 11,
+    11, 47, 55, 133, 495, 999, 1461, 1, 1, 3, 15, 27, 51, 93, 17, 355, 763, 1675, 1, 3, 1, 3, 1, 3, 79, 119, 499, 17,
+    995, 1, 1, 1, 1, 15, 43, 45, 17, 167, 973, 799, 1, 1, 1, 3, 27, 49, 89, 29, 483, 913, 2023, 1, 1, 3, 3, 5, 11, 75,
+    7, 41, 851, 611, 1, 3, 1, 3, 7, 57, 39, 123, 257, 283, 507, 1, 3, 3, 11, 27, 23, 113, 229, 187, 299, 133, 1, 1, 3,
+    13, 9, 63, 101, 77, 451, 169, 337, 1, 3, 7, 3, 3, 59, 45, 195, 229, 415, 409, 1, 3, 5, 3, 11, 19, 71, 93, 43, 857,
+    369, 1, 3, 7, 9, 19, 33, 115, 19, 241, 703, 247, 1, 3, 5, 11, 5, 35, 21, 155, 463, 1005, 1073, 1, 3, 7, 3, 25, 15,
+    109, 83, 93, 69, 1189, 1, 3, 5, 7, 5, 21, 93, 133, 135, 167, 903, 1, 1, 7, 7, 3, 59, 121, 161, 285, 815, 1769, 3705,
+    1, 3, 1, 1, 3, 47, 103, 171, 381, 609, 185, 373, 1, 3, 3, 15, 23, 33, 107, 131, 441, 445, 689, 2059, 1, 3, 3, 11, 7,
+    53, 101, 167, 435, 803, 1255, 3781, 1, 1, 5, 11, 15, 59, 41, 19, 135, 835, 1263, 505, 1, 1, 7, 11, 21, 49, 23, 219,
+    127, 961, 1065, 385, 1, 3, 5, 15, 7, 47, 117, 217, 45, 731, 1639, 733, 1, 1, 7, 11, 27, 57, 91, 87, 81, 35, 1269,
+    1007, 1, 1, 3, 11, 15, 37, 53, 219, 193, 937, 1899, 3733, 1, 3, 5, 3, 13, 11, 27, 19, 199, 393, 965, 2195, 1, 3, 1,
+    3, 5, 1, 37, 173, 413, 1023, 553, 409, 1, 3, 1, 7, 15, 29, 123, 95, 255, 373, 1799, 3841, 1, 3, 5, 13, 21, 57, 51,
+    17, 511, 195, 1157, 1831, 1, 1, 1, 15, 29, 19, 7, 73, 295, 519, 587, 3523, 1, 1, 5, 13, 13, 35, 115, 191, 123, 535,
+    717, 1661, 1, 3, 3, 5, 23, 21, 47, 251, 379, 921, 1119, 297, 1, 3, 3, 9, 29, 53, 121, 201, 135, 193, 523, 2943, 1,
+    1, 1, 7, 29, 45, 125, 9, 99, 867, 425, 601, 1, 3, 1, 9, 13, 15, 67, 181, 109, 293, 1305, 3079, 1, 3, 3, 9, 5, 35,
+    15, 209, 305, 87, 767, 2795, 1, 3, 3, 11, 27, 57, 113, 123, 179, 643, 149, 523, 1, 1, 3, 15, 11, 17, 67, 223, 63,
+    657, 335, 3309, 1, 1, 1, 9, 25, 29, 109, 159, 39, 513, 571, 1761, 1, 1, 3, 1, 5, 63, 75, 19, 455, 601, 123, 691, 1,
+    1, 1, 3, 21, 5, 45, 169, 377, 513, 1951, 2565, 1, 1, 3, 11, 3, 33, 119, 69, 253, 907, 805, 1449, 1, 1, 5, 13, 31,
+    15, 17, 7, 499, 61, 687, 1867, 1, 3, 7, 11, 17, 33, 73, 77, 299, 243, 641, 2345, 1, 1, 7, 11, 9, 35, 31, 235, 359,
+    647, 379, 1161, 1, 3, 3, 15, 31, 25, 5, 67, 33, 45, 437, 4067, 1, 1, 3, 11, 7, 17, 37, 87, 333, 253, 1517, 2921, 1,
+    1, 7, 15, 7, 15, 107, 189, 153, 769, 1521, 3427, 1, 3, 5, 13, 5, 61, 113, 37, 293, 393, 113, 43, 1, 1, 1, 15, 29,
+    43, 107, 31, 167, 147, 301, 1021, 1, 1, 1, 13, 3, 1, 35, 93, 195, 181, 2027, 1491, 1, 3, 3, 3, 13, 33, 77, 199, 153,
+    221, 1699, 3671, 1, 3, 5, 13, 7, 49, 123, 155, 495, 681, 819, 809, 1, 3, 5, 15, 27, 61, 117, 189, 183, 887, 617,
+    4053, 1, 1, 1, 7, 31, 59, 125, 235, 389, 369, 447, 1039, 1, 3, 5, 1, 5, 39, 115, 89, 249, 377, 431, 3747, 1, 1, 1,
+    5, 7, 47, 59, 157, 77, 445, 699, 3439, 1, 1, 3, 5, 11, 21, 19, 75, 11, 599, 1575, 735, 1, 3, 5, 3, 19, 13, 41, 69,
+    199, 143, 1761, 3215, 1, 3, 5, 7, 19, 43, 25, 41, 41, 11, 1647, 2783, 1, 3, 1, 9, 19, 45, 111, 97, 405, 399, 457,
+    3219, 1, 1, 3, 1, 23, 15, 65, 121, 59, 985, 829, 2259, 1, 1, 3, 7, 17, 13, 107, 229, 75, 551, 1299, 2363, 1, 1, 5,
+    5, 21, 57, 23, 199, 509, 139, 2007, 3875, 1, 3, 1, 11, 19, 53, 15, 229, 215, 741, 695, 823, 1, 3, 7, 1, 29, 3, 17,
+    163, 417, 559, 549, 319, 1, 3, 1, 13, 17, 9, 47, 133, 365, 7, 1937, 1071, 1, 3, 5, 7, 19, 37, 55, 163, 301, 249,
+    689, 2327, 1, 3, 5, 13, 11, 23, 61, 205, 257, 377, 615, 1457, 1, 3, 5, 1, 23, 37, 13, 75, 331, 495, 579, 3367, 1, 1,
+    1, 9, 1, 23, 49, 129, 475, 543, 883, 2531, 1, 3, 1, 5, 23, 59, 51, 35, 343, 695, 219, 369, 1, 3, 3, 1, 27, 17, 63,
+    97, 71, 507, 1929, 613, 1, 1, 5, 1, 21, 31, 11, 109, 247, 409, 1817, 2173, 1, 1, 3, 15, 23, 9, 7, 209, 301, 23, 147,
+    1691, 1, 1, 7, 5, 5, 19, 37, 229, 249, 277, 1115, 2309, 1, 1, 1, 5, 5, 63, 5, 249, 285, 431, 343, 2467, 1, 1, 1, 11,
+    7, 45, 35, 75, 505, 537, 29, 2919, 1, 3, 5, 15, 11, 39, 15, 63, 263, 9, 199, 445, 1, 3, 3, 3, 27, 63, 53, 171, 227,
+    63, 1049, 827, 1, 1, 3, 13, 7, 11, 115, 183, 179, 937, 1785, 381, 1, 3, 1, 11, 13, 15, 107, 81, 53, 295, 1785, 3757,
+    1, 3, 3, 13, 11, 5, 109, 243, 3, 505, 323, 1373, 1, 3, 3, 11, 21, 51, 17, 177, 381, 937, 1263, 3889, 1, 3, 5, 9, 27,
+    25, 85, 193, 143, 573, 1189, 2995, 1, 3, 5, 11, 13, 9, 81, 21, 159, 953, 91, 1751, 1, 1, 3, 3, 27, 61, 11, 253, 391,
+    333, 1105, 635, 1, 3, 3, 15, 9, 57, 95, 81, 419, 735, 251, 1141, 1, 1, 5, 9, 31, 39, 59, 13, 319, 807, 1241, 2433,
+    1, 3, 3, 5, 27, 13, 107, 141, 423, 937, 2027, 3233, 1, 3, 3, 9, 9, 25, 125, 23, 443, 835, 1245, 847, 1, 1, 7, 15,
+    17, 17, 83, 107, 411, 285, 847, 1571, 1, 1, 3, 13, 29, 61, 37, 81, 349, 727, 1453, 1957, 1, 3, 7, 11, 31, 13, 59,
+    77, 273, 591, 1265, 1533, 1, 1, 7, 7, 13, 17, 25, 25, 187, 329, 347, 1473, 1, 3, 7, 7, 5, 51, 37, 99, 221, 153, 503,
+    2583, 1, 3, 1, 13, 19, 27, 11, 69, 181, 479, 1183, 3229, 1, 3, 3, 13, 23, 21, 103, 147, 323, 909, 947, 315, 1, 3, 1,
+    3, 23, 1, 31, 59, 93, 513, 45, 2271, 1, 3, 5, 1, 7, 43, 109, 59, 231, 41, 1515, 2385, 1, 3, 1, 5, 31, 57, 49, 223,
+    283, 1013, 11, 701, 1, 1, 5, 1, 19, 53, 55, 31, 31, 299, 495, 693, 1, 3, 3, 9, 5, 33, 77, 253, 427, 791, 731, 1019,
+    1, 3, 7, 11, 1, 9, 119, 203, 53, 877, 1707, 3499, 1, 1, 3, 7, 13, 39, 55, 159, 423, 113, 1653, 3455, 1, 1, 3, 5, 21,
+    47, 51, 59, 55, 411, 931, 251, 1, 3, 7, 3, 31, 25, 81, 115, 405, 239, 741, 455, 1, 1, 5, 1, 31, 3, 101, 83, 479,
+    491, 1779, 2225, 1, 3, 3, 3, 9, 37, 107, 161, 203, 503, 767, 3435, 1, 3, 7, 9, 1, 27, 61, 119, 233, 39, 1375, 4089,
+    1, 1, 5, 9, 1, 31, 45, 51, 369, 587, 383, 2813, 1, 3, 7, 5, 31, 7, 49, 119, 487, 591, 1627, 53, 1, 1, 7, 1, 9, 47,
+    1, 223, 369, 711, 1603, 1917, 1, 3, 5, 3, 21, 37, 111, 17, 483, 739, 1193, 2775, 1, 3, 3, 7, 17, 11, 51, 117, 455,
+    191, 1493, 3821, 1, 1, 5, 9, 23, 39, 99, 181, 343, 485, 99, 1931, 1, 3, 1, 7, 29, 49, 31, 71, 489, 527, 1763, 2909,
+    1, 1, 5, 11, 5, 5, 73, 189, 321, 57, 1191, 3685, 1, 1, 5, 15, 13, 45, 125, 207, 371, 415, 315, 983, 1, 3, 3, 5, 25,
+    59, 33, 31, 239, 919, 1859, 2709, 1, 3, 5, 13, 27, 61, 23, 115, 61, 413, 1275, 3559, 1, 3, 7, 15, 5, 59, 101, 81,
+    47, 967, 809, 3189, 1, 1, 5, 11, 31, 15, 39, 25, 173, 505, 809, 2677, 1, 1, 5, 9, 19, 13, 95, 89, 511, 127, 1395,
+    2935, 1, 1, 5, 5, 31, 45, 9, 57, 91, 303, 1295, 3215, 1, 3, 3, 3, 19, 15, 113, 187, 217, 489, 1285, 1803, 1, 1, 3,
+    1, 13, 29, 57, 139, 255, 197, 537, 2183, 1, 3, 1, 15, 11, 7, 53, 255, 467, 9, 757, 3167, 1, 3, 3, 15, 21, 13, 9,
+    189, 359, 323, 49, 333, 1, 3, 7, 11, 7, 37, 21, 119, 401, 157, 1659, 1069, 1, 1, 5, 7, 17, 33, 115, 229, 149, 151,
+    2027, 279, 1, 1, 5, 15, 5, 49, 77, 155, 383, 385, 1985, 945, 1, 3, 7, 3, 7, 55, 85, 41, 357, 527, 1715, 1619, 1, 1,
+    3, 1, 21, 45, 115, 21, 199, 967, 1581, 3807, 1, 1, 3, 7, 21, 39, 117, 191, 169, 73, 413, 3417, 1, 1, 1, 13, 1, 31,
+    57, 195, 231, 321, 367, 1027, 1, 3, 7, 3, 11, 29, 47, 161, 71, 419, 1721, 437, 1, 1, 7, 3, 11, 9, 43, 65, 157, 1,
+    1851, 823, 1, 1, 1, 5, 21, 15, 31, 101, 293, 299, 127, 1321, 1, 1, 7, 1, 27, 1, 11, 229, 241, 705, 43, 1475, 1, 3,
+    7, 1, 5, 15, 73, 183, 193, 55, 1345, 49, 1, 3, 3, 3, 19, 3, 55, 21, 169, 663, 1675, 137, 1, 1, 1, 13, 7, 21, 69, 67,
+    373, 965, 1273, 2279, 1, 1, 7, 7, 21, 23, 17, 43, 341, 845, 465, 3355, 1, 3, 5, 5, 25, 5, 81, 101, 233, 139, 359,
+    2057, 1, 1, 3, 11, 15, 39, 55, 3, 471, 765, 1143, 3941, 1, 1, 7, 15, 9, 57, 81, 79, 215, 433, 333, 3855, 1, 1, 5, 5,
+    19, 45, 83, 31, 209, 363, 701, 1303, 1, 3, 7, 5, 1, 13, 55, 163, 435, 807, 287, 2031, 1, 3, 3, 7, 3, 3, 17, 197, 39,
+    169, 489, 1769, 1, 1, 3, 5, 29, 43, 87, 161, 289, 339, 1233, 2353, 1, 3, 3, 9, 21, 9, 77, 1, 453, 167, 1643, 2227,
+    1, 1, 7, 1, 15, 7, 67, 33, 193, 241, 1031, 2339, 1, 3, 1, 11, 1, 63, 45, 65, 265, 661, 849, 1979, 1, 3, 1, 13, 19,
+    49, 3, 11, 159, 213, 659, 2839, 1, 3, 5, 11, 9, 29, 27, 227, 253, 449, 1403, 3427, 1, 1, 3, 1, 7, 3, 77, 143, 277,
+    779, 1499, 475, 1, 1, 1, 5, 11, 23, 87, 131, 393, 849, 193, 3189, 1, 3, 5, 11, 3, 3, 89, 9, 449, 243, 1501, 1739, 1,
+    3, 1, 9, 29, 29, 113, 15, 65, 611, 135, 3687
+};
 
-// --- Uniform int distribution ---
-// --------------------------------
+[[nodiscard]] inline std::vector<SobolParameters> _default_sobol_parameters(std::size_t dimensions) {
+    std::vector<SobolParameters> res;
+    if (dimensions < 2) return res;
+    res.reserve(dimensions - 1);
 
-template <class T, class Gen, _require<std::is_integral_v<T> && std::is_unsigned_v<T>> = true>
-constexpr T _uniform_uint_lemier(Gen& gen, T range) noexcept(noexcept(gen())) {
-    using W = _wider_t<T>;
+    generators::SplitMix64 gen{0x50b01}; // fixed seed for dimensions past the table
+    const std::uint16_t*   table = _joe_kuo_initial;
 
-    W product = W(gen()) * W(range);
-    T low     = T(product);
-    if (low < range) {
-        while (low < -range % range) {
-            product = W(gen()) * W(range);
-            low     = T(product);
+    for (std::uint32_t degree = 1; res.size() < dimensions - 1; ++degree) {
+        assert(degree < _sobol_bits && "Number of dimensions is too large.");
+
+        for (std::uint32_t a = 0; a < (std::uint32_t(1) << (degree - 1)) && res.size() < dimensions - 1; ++a) {
+            const std::uint64_t polynomial = (std::uint64_t(1) << degree) | (std::uint64_t(a) << 1) | 1;
+            if (!_is_primitive_gf2(polynomial, degree)) continue;
+
+            std::vector<std::uint32_t> initial(degree);
+            if (res.size() + 1 < _joe_kuo_dimensions)
+                for (std::uint32_t i = 0; i < degree; ++i) initial[i] = *table++;
+            else
+                for (std::uint32_t i = 0; i < degree; ++i)
+                    initial[i] = static_cast<std::uint32_t>(_uniform_index(gen, std::uint64_t(1) << i)) * 2 + 1;
+
+            res.push_back({degree, a, std::move(initial)});
         }
     }
-    return product >> std::numeric_limits<T>::digits;
+
+    return res;
 }
 
-template <class T, class Gen, _require<std::is_integral_v<T> && std::is_unsigned_v<T>> = true>
-constexpr T _uniform_uint_modx1(Gen& gen, T range) noexcept(noexcept(gen())) {
-    T x{}, r{};
-    do {
-        x = gen();
-        r = x % range;
-    } while (x - r > T(-range));
-    return r;
-} // slightly slower than lemier, but doesn't require a wider type
+[[nodiscard]] constexpr std::uint32_t _parity(std::uint32_t x) noexcept {
+    x ^= x >> 16, x ^= x >> 8, x ^= x >> 4, x ^= x >> 2, x ^= x >> 1;
+    return x & 1;
+}
 
-// Reimplementation of libc++ `std::uniform_int_distribution<>` except
-// - constexpr
-// - const-qualified (relative to distribution parameters)
-// - noexcept as long as 'Gen::operator()' is noexcept, which is true for all generators in this module
-// - supports `std::uint8_t`, `std::int8_t`, `char`
-// - produces the same sequence on each platform
-// Performance is exactly the same a libc++ version of `std::uniform_int_distribution<>`,
-// in fact, it is likely to return the exact same sequence for all types except 64-bit integers
-template <class T, class Gen, _require<std::is_integral_v<T>> = true>
-constexpr T _generate_uniform_int(Gen& gen, T min, T max) noexcept {
-    using result_type    = T;
-    using unsigned_type  = std::make_unsigned_t<result_type>;
-    using generated_type = typename Gen::result_type;
-    using common_type    = std::common_type_t<unsigned_type, generated_type>;
+template <class T = double>
+class SobolSequence {
+    static_assert(std::is_floating_point_v<T>);
 
-    constexpr common_type prng_min = Gen::min();
-    constexpr common_type prng_max = Gen::max();
+    using directions_type = std::array<std::uint32_t, _sobol_bits>;
 
-    static_assert(prng_min < prng_max, "UniformRandomBitGenerator requires 'min() < max()'");
+    std::vector<directions_type> directions; // 'directions[j][k]' is direction number 'v_k' of dimension 'j'
+    std::vector<std::uint32_t>   shift;      // digital shift of each dimension
+    std::vector<std::uint32_t>   state;      // current point as integers
+    std::uint64_t                position = 0;
 
-    constexpr common_type prng_range = prng_max - prng_min;
-    constexpr common_type type_range = std::numeric_limits<common_type>::max();
-    const common_type     range      = common_type(max) - common_type(min);
+    void init_directions(const std::vector<SobolParameters>& params) {
+        this->directions.resize(params.size() + 1);
 
-    common_type res{};
+        // first dimension is the van der Corput sequence
+        for (std::size_t k = 0; k < _sobol_bits; ++k) this->directions[0][k] = std::uint32_t(1) << (31 - k);
 
-    // PRNG has enough state for the range
-    if (prng_range > range) {
-        const common_type ext_range = range + 1; // range can be zero
+        for (std::size_t j = 1; j < this->directions.size(); ++j) {
+            const auto& [s, a, m] = params[j - 1];
+            auto&       v         = this->directions[j];
 
-        // PRNG uses all 'common_type' bits uniformly
-        // => use Lemier's algorithm if possible, fallback onto modx1 otherwise,
-        //    libc++ uses conditionally compiled lemier's with 128-bit ints intead of doing a fallback,
-        //    this is slightly faster, but leads to platforms-dependant sequences
-        if constexpr (prng_range == type_range) {
-            if constexpr (_has_wider<common_type>) res = _uniform_uint_lemier(gen, ext_range);
-            else res = _uniform_uint_modx1(gen, ext_range);
-        }
-        // PRNG doesn't use all bits uniformly (usually because 'prng_min' is '1')
-        // => fallback onto a 2-division algorithm
-        else {
-            const common_type scaling = prng_range / ext_range;
-            const common_type past    = ext_range * scaling;
+            assert(0 < s && s < _sobol_bits && m.size() == s && "Invalid Sobol parameters.");
 
-            do { res = common_type(gen()) - prng_min; } while (res >= past);
-            res /= scaling;
+            for (std::size_t k = 0; k < std::min<std::size_t>(s, _sobol_bits); ++k) {
+                assert(m[k] % 2 == 1 && m[k] < (std::uint32_t(1) << (k + 1)) && "Invalid Sobol parameters.");
+                v[k] = m[k] << (31 - k);
+            }
+            for (std::size_t k = s; k < _sobol_bits; ++k) {
+                v[k] = v[k - s] ^ (v[k - s] >> s);
+                for (std::size_t i = 1; i < s; ++i)
+                    if ((a >> (s - 1 - i)) & 1) v[k] ^= v[k - i];
+            }
         }
     }
-    // PRNG needs several invocations to aquire enough state for the range
-    else if (prng_range < range) {
-        common_type temp{};
-        do {
-            constexpr common_type ext_prng_range = (prng_range < type_range) ? prng_range + 1 : type_range;
-            temp = ext_prng_range * _generate_uniform_int<common_type>(gen, 0, range / ext_prng_range);
-            res  = temp + (common_type(gen()) - prng_min);
-        } while (res >= range || res < temp);
-    } else {
-        res = common_type(gen()) - prng_min;
-    }
 
-    return min + res;
+public:
+    using result_type = T;
 
-    // Note 1:
-    // 'static_cast<>()' preserves bit pattern of signed/unsigned integers of the same size as long as
-    // those integers are two-complement (see https://en.wikipedia.org/wiki/Two's_complement), this is
-    // true for most platforms and is in fact guaranteed for standard fixed-width types like 'uint32_t'
-    // on any platform (see https://en.cppreference.com/w/cpp/types/integer)
-    //
-    // This means signed integer distribution can simply use unsigned algorithm and reinterpret the result internally.
-    // This would be a bit nicer semantically with C++20 `std::bit_cast<>`, but not ultimately any different.
+    explicit SobolSequence(std::size_t dimensions, std::uint64_t index = 0)
+        : SobolSequence(_default_sobol_parameters(dimensions), index) {
+        assert(dimensions > 0);
+    }
 
-    // Note 2:
-    // 'ext_prng_range' has a ternary purely to silence a false compiler warning from about division by zero due to
-    // 'prng_range + 1' overflowing into '0' when 'prng_range' is equal to 'type_range'. Falling into this runtime
-    // branch requires 'prng_range < range <= type_range' making such situation impossible, here we simply clamp the
-    // value to 'type_range' so it doesn't overflow and trip the compiler when analyzing constexpr for potential UB.
-}
+    // 'params[j]' defines dimension 'j + 1', dimension '0' is always the van der Corput sequence
+    explicit SobolSequence(const std::vector<SobolParameters>& params, std::uint64_t index = 0) {
+        this->init_directions(params);
+        this->shift.assign(this->directions.size(), 0);
+        this->seek(index);
+    }
 
-// 'static_cast<>()' preserves bit pattern of signed/unsigned integers of the same size as long as
-// those integers are two-complement (see https://en.wikipedia.org/wiki/Two's_complement), this is
-// true for most platforms and is in fact guaranteed for standard fixed-width types like 'uint32_t'
-// on any platform (see https://en.cppreference.com/w/cpp/types/integer)
-//
-// This means signed integer distribution can simply use unsigned algorithm and reinterpret the result internally.
-// This would be a bit nicer semantically with C++20 `std::bit_cast<>`, but not ultimately any different.
-template <class T = int, _require<std::is_integral_v<T>> = true>
-struct UniformIntDistribution {
-    using result_type = T;
+    void seek(std::uint64_t index) noexcept {
+        assert(index < (std::uint64_t(1) << _sobol_bits) && "Sobol sequence has at most 2^32 points.");
 
-    struct param_type {
-        result_type min = 0;
-        result_type max = std::numeric_limits<result_type>::max();
-    };
+        this->position  = index;
+        const auto gray = index ^ (index >> 1);
+        this->state.resize(this->directions.size());
 
-    constexpr UniformIntDistribution() = default;
-    constexpr UniformIntDistribution(T min, T max) noexcept : pars({min, max}) { assert(min < max); }
-    constexpr UniformIntDistribution(const param_type& p) noexcept : pars(p) { assert(p.min < p.max); }
+        for (std::size_t j = 0; j < this->directions.size(); ++j) {
+            std::uint32_t x = this->shift[j];
+            for (std::size_t k = 0; k < _sobol_bits; ++k)
+                if ((gray >> k) & 1) x ^= this->directions[j][k];
+            this->state[j] = x;
+        }
+    }
+
+    void discard(std::uint64_t n) noexcept { this->seek(this->position + n); }
 
     template <class Gen>
-    constexpr T operator()(Gen& gen) const noexcept(noexcept(gen())) {
-        return _generate_uniform_int<result_type>(gen, this->pars.min, this->pars.max);
+    void scramble(Gen& gen) {
+        for (std::size_t j = 0; j < this->directions.size(); ++j) {
+            // lower-triangular matrix with unit diagonal, row 'i' is a mask of the digits contributing to digit 'i'
+            std::array<std::uint32_t, _sobol_bits> rows{};
+            for (std::size_t i = 0; i < _sobol_bits; ++i) {
+                const std::uint32_t diagonal = std::uint32_t(1) << (31 - i);
+                const std::uint32_t above    = ~((diagonal << 1) - 1); // more significant digits
+                rows[i] = diagonal | (static_cast<std::uint32_t>(_generate_uint64(gen)) & above);
+            }
+
+            for (auto& v : this->directions[j]) {
+                std::uint32_t scrambled = 0;
+                for (std::size_t i = 0; i < _sobol_bits; ++i) scrambled |= _parity(rows[i] & v) << (31 - i);
+                v = scrambled;
+            }
+
+            this->shift[j] = static_cast<std::uint32_t>(_generate_uint64(gen));
+        }
+
+        this->seek(this->position);
     }
 
-    template <class Gen>
-    constexpr T operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
-        assert(p.min < p.max);
-        return _generate_uniform_int<result_type>(gen, p.min, p.max);
-    } // for std-compatibility
+    template <class OutIt>
+    OutIt next(OutIt out) {
+        for (const auto& x : this->state) *out = _fixed_point_to_unit<T>(std::uint64_t(x) << 32), ++out;
 
-    constexpr result_type               reset() const noexcept {} // nothing to reset, provided for std-compatibility
-    [[nodiscard]] constexpr param_type  params() const noexcept { return this->pars; }
-    constexpr void                      params(const param_type& p) noexcept { *this = UniformIntDistribution(p); }
-    [[nodiscard]] constexpr result_type a() const noexcept { return this->pars.min; }
-    [[nodiscard]] constexpr result_type b() const noexcept { return this->pars.max; }
-    [[nodiscard]] constexpr result_type min() const noexcept { return this->pars.min; }
-    [[nodiscard]] constexpr result_type max() const noexcept { return this->pars.max; }
+        // Gray code order, next point differs by direction number of the lowest zero bit of the index
+        std::size_t k = 0;
+        while ((this->position >> k) & 1) ++k;
+        ++this->position;
 
-private:
-    param_type pars{};
-};
+        if (k < _sobol_bits)
+            for (std::size_t j = 0; j < this->state.size(); ++j) this->state[j] ^= this->directions[j][k];
 
-template <class T>
-constexpr bool operator==(const UniformIntDistribution<T>& lhs, const UniformIntDistribution<T>& rhs) noexcept {
-    return lhs.a() == rhs.a() && lhs.b() == rhs.b();
-}
+        return out;
+    }
 
-// --- Uniform real distribution ---
-// ---------------------------------
+    template <class OutIt>
+    void fill(OutIt first, OutIt last) {
+        _fill_points(*this, first, last);
+    }
 
-// Can't really make things work without making some reasonable assumptions about the size of primitive types,
-// this should be satisfied for the vast majority of platforms. Esoteric architectures can manually adapt the
-// algorithm if that is necessary.
-static_assert(std::numeric_limits<double>::digits == 53, "Platform not supported, 'float' is expected to be 32-bit.");
-static_assert(std::numeric_limits<float>::digits == 24, "Platform not supported, 'double' is expected to be 64-bit.");
+    std::vector<T> operator()() {
+        std::vector<T> point(this->dimensions());
+        this->next(point.begin());
+        return point;
+    }
 
-template <class T>
-constexpr int _bit_width(T value) noexcept {
-    int width = 0;
-    while (value >>= 1) ++width;
-    return width;
-}
+    [[nodiscard]] std::size_t   dimensions() const noexcept { return this->directions.size(); }
+    [[nodiscard]] std::uint64_t index() const noexcept { return this->position; }
+};
 
-// Constexpr reimplementation of 'std::generate_canonical<>()'
-template <class T, class Gen>
-constexpr T _generate_canonical_generic(Gen& gen) noexcept(noexcept(gen())) {
-    using float_type     = T;
-    using generated_type = typename Gen::result_type;
+// --- Halton sequence ---
+// -----------------------
 
-    constexpr int float_bits = std::numeric_limits<float_type>::digits;
-    // always produce enough bits of randomness for the whole mantissa
+// Halton sequence, see J. H. Halton "On the efficiency of certain quasi-random sequences of points in evaluating
+// multi-dimensional integrals" (1960).
+//
+// Dimension 'j' is a radical inverse of the point index in base of the 'j'-th prime. Points are generated incrementally
+// by keeping base 'b' digits of the index and the radical inverse as an integer numerator over 'b^m', which makes
+// the values exact and the amortized cost per dimension O(1). Digits are limited so that 'b^m <= 2^53', after 'b^m'
+// points the dimension repeats. Scrambling applies a random permutation of digits in every dimension, which breaks
+// the correlations between the dimensions with large bases (E. Braaten & G. Weller 1979).
+
+[[nodiscard]] inline std::vector<std::uint32_t> _first_primes(std::size_t count) {
+    std::vector<std::uint32_t> primes;
+    primes.reserve(count);
+
+    for (std::uint32_t n = 2; primes.size() < count; ++n) {
+        bool is_prime = true;
+        for (const auto p : primes) {
+            if (p * p > n) break;
+            if (n % p == 0) {
+                is_prime = false;
+                break;
+            }
+        }
+        if (is_prime) primes.push_back(n);
+    }
 
-    constexpr generated_type prng_max = Gen::max();
-    constexpr generated_type prng_min = Gen::min();
+    return primes;
+}
 
-    constexpr generated_type prng_range = prng_max - prng_min;
-    constexpr generated_type type_range = std::numeric_limits<generated_type>::max();
+constexpr std::size_t   _halton_max_digits     = 53;
+constexpr std::uint64_t _halton_max_table_size = 256;
+
+template <class T = double>
+class HaltonSequence {
+    static_assert(std::is_floating_point_v<T>);
+
+    // Lowest digits of the index change on every step, their contributions to the numerator are precomputed
+    // for all combinations, which turns most steps into a table lookup with a well-predicted branch
+    struct dimension {
+        std::uint32_t                                 base;
+        std::size_t                                   digit_count; // 'm'
+        std::size_t                                   table_digits;
+        std::array<std::uint64_t, _halton_max_digits> scale;  // 'b^(m - 1 - k)'
+        std::array<std::uint32_t, _halton_max_digits> digits; // digits of the index, least significant first
+        std::vector<std::uint64_t>                    table;  // contributions of the lowest 'table_digits' digits
+        std::uint64_t                                 low;    // lowest digits of the index as a number
+        std::uint64_t                                 high;   // contribution of the remaining digits
+        double                                        inv_denominator; // '1 / b^m'
+        std::vector<std::uint32_t>                    permutation;     // empty unless scrambled
+    };
 
-    constexpr int prng_bits = (prng_range < type_range) ? _bit_width(prng_range + 1) : 1 + _bit_width(prng_range);
-    // how many full bits of randomness PRNG produces on each invocation, prng_bits == floor(log2(prng_range + 1)),
-    // ternary handles the case that would overflow when (prng_range == type_range)
+    std::vector<dimension> dims;
+    std::uint64_t          position = 0;
 
-    constexpr int invocations_needed = [&]() {
-        int count = 0;
-        for (int generated_bits = 0; generated_bits < float_bits; generated_bits += prng_bits) ++count;
-        return count;
-    }();
-    // GCC and MSVC use runtime conversion to floating point and std::ceil() & std::log() to obtain
-    // this value, in MSVC for example we have something like this:
-    //    > invocations_needed = std::ceil( float_type(float_bits) / std::log2( float_type(prng_range) + 1 ) )
-    // which is not constexpr due to math functions, we can do a similar thing much easier by just counting bits
-    // generated per each invocation. This returns the same thing for any sane PRNG, except since it only counts
-    // "full bits" esoteric ranges such as [1, 3] which technically have 1.5 bits of randomness will be counted
-    // as 1 bit of randomness, thus overestimating the invocations a little. In practice this makes 0 difference
-    // since its only matters for exceedingly small 'prng_range' and such PRNGs simply don't exist in nature, and
-    // even if they are theoretically used they will simply use a few more invocation to produce a proper result
+    [[nodiscard]] static std::uint64_t permuted(const dimension& dim, std::uint32_t digit) noexcept {
+        return dim.permutation.empty() ? digit : dim.permutation[digit];
+    }
 
-    constexpr float_type prng_float_max   = static_cast<float_type>(prng_max);
-    constexpr float_type prng_float_min   = static_cast<float_type>(prng_min);
-    constexpr float_type prng_float_range = (prng_float_max - prng_float_min) + float_type(1);
+    static void build_table(dimension& dim) {
+        for (std::size_t i = 0; i < dim.table.size(); ++i) {
+            std::uint64_t rest = i, numerator = 0;
+            for (std::size_t k = 0; k < dim.table_digits; ++k, rest /= dim.base)
+                numerator += permuted(dim, static_cast<std::uint32_t>(rest % dim.base)) * dim.scale[k];
+            dim.table[i] = numerator;
+        }
+    }
 
-    float_type res    = float_type(0);
-    float_type factor = float_type(1);
+public:
+    using result_type = T;
 
-    for (int i = 0; i < invocations_needed; ++i) {
-        res += (static_cast<float_type>(gen()) - static_cast<float_type>(prng_min)) * factor;
-        factor *= prng_float_range;
-    } // same algorithm is used by 'std::generate_canonical<>' in all major compilers as of 2025
+    explicit HaltonSequence(std::size_t dimensions, std::uint64_t index = 0) {
+        assert(dimensions > 0);
 
-    return res / factor;
-}
+        for (const auto base : _first_primes(dimensions)) {
+            dimension dim{};
+            dim.base = base;
 
-// Wrapper that adds special case optimizations for `_generate_canonical_generic<>()'
-template <class T, class Gen>
-constexpr T generate_canonical(Gen& gen) noexcept(noexcept(gen())) {
-    using float_type     = T;
-    using generated_type = typename Gen::result_type;
+            std::uint64_t power = 1;
+            while (power <= (std::uint64_t(1) << 53) / base) power *= base, ++dim.digit_count;
 
-    constexpr generated_type prng_min = Gen::min();
-    constexpr generated_type prng_max = Gen::max();
+            dim.inv_denominator = 1. / static_cast<double>(power);
+            for (std::size_t k = 0; k < dim.digit_count; ++k) power /= base, dim.scale[k] = power;
 
-    static_assert(prng_min < prng_max, "UniformRandomBitGenerator requires 'min() < max()'");
+            std::uint64_t table_size = 1;
+            while (table_size * base <= _halton_max_table_size) table_size *= base, ++dim.table_digits;
 
-    constexpr generated_type prng_range          = prng_max - prng_min;
-    constexpr generated_type type_range          = std::numeric_limits<generated_type>::max();
-    constexpr bool           prng_is_bit_uniform = (prng_range == type_range);
+            dim.table.resize(table_size);
+            build_table(dim);
 
-    constexpr int exponent_bits_64 = 11;
-    constexpr int exponent_bits_32 = 8;
+            this->dims.push_back(std::move(dim));
+        }
 
-    constexpr double mantissa_hex_64 = 0x1.0p-53;  // == 2^-53, corresponds to 53 significant bits of double
-    constexpr float  mantissa_hex_32 = 0x1.0p-24f; // == 2^-24, corresponds to 24 significant bits of float
+        this->seek(index);
+    }
 
-    constexpr double pow2_minus_64 = 0x1.0p-64; // == 2^-64
-    constexpr double pow2_minus_32 = 0x1.0p-32; // == 2^-32
+    void seek(std::uint64_t index) noexcept {
+        this->position = index;
 
-    // Note 1: Note hexadecimal float literals, 'p' separates hex-base from the exponent
-    // Note 2: Floats have 'mantissa_size + 1' significant bits due to having a sign bit
+        for (auto& dim : this->dims) {
+            dim.low            = index % dim.table.size();
+            std::uint64_t rest = index / dim.table.size();
 
-    // Bit-uniform PRNGs can be simply bitmasked & shifted to obtain mantissa
-    // 64-bit float, 64-bit uniform PRNG
-    // => multiplication algorithm, see [https://prng.di.unimi.it/]
-    if constexpr (prng_is_bit_uniform && sizeof(float_type) == 8 && sizeof(generated_type) == 8) {
-        return (gen() >> exponent_bits_64) * mantissa_hex_64;
+            dim.high = 0;
+            for (std::size_t k = dim.table_digits; k < dim.digit_count; ++k, rest /= dim.base) {
+                dim.digits[k] = static_cast<std::uint32_t>(rest % dim.base);
+                dim.high += permuted(dim, dim.digits[k]) * dim.scale[k];
+            }
+        }
     }
-    // 64-bit float, 32-bit uniform PRNG
-    // => "low-high" algorithm, see [https://www.doornik.com/research/randomdouble.pdf]
-    else if constexpr (prng_is_bit_uniform && sizeof(T) == 8 && sizeof(generated_type) == 4) {
-        return (gen() * pow2_minus_64) + (gen() * pow2_minus_32);
+
+    void discard(std::uint64_t n) noexcept { this->seek(this->position + n); }
+
+    template <class Gen>
+    void scramble(Gen& gen) {
+        for (auto& dim : this->dims) {
+            dim.permutation.resize(dim.base);
+            for (std::uint32_t d = 0; d < dim.base; ++d) dim.permutation[d] = d;
+            shuffle(dim.permutation.begin(), dim.permutation.end(), gen);
+            build_table(dim);
+        }
+
+        this->seek(this->position);
     }
-    // 32-bit float, 64-bit uniform PRNG
-    // => discard bits + multiplication algorithm
-    else if constexpr (prng_is_bit_uniform && sizeof(T) == 4 && sizeof(generated_type) == 8) {
-        return (static_cast<std::uint32_t>(gen()) >> exponent_bits_32) * mantissa_hex_32;
+
+    template <class OutIt>
+    OutIt next(OutIt out) {
+        constexpr T below_one = T(1) - std::numeric_limits<T>::epsilon() / 2;
+
+        for (auto& dim : this->dims) {
+            // numerator fits into 53 bits, conversion through a signed integer is faster than from an unsigned one
+            const auto numerator = static_cast<std::int64_t>(dim.table[dim.low] + dim.high);
+            const T    value     = static_cast<T>(static_cast<double>(numerator) * dim.inv_denominator);
+            *out                 = std::min(value, below_one), ++out;
+
+            if (++dim.low < dim.table.size()) continue;
+            dim.low = 0;
+
+            // increment remaining digits of the index, the numerator is updated with the difference of each changed
+            // digit, unsigned wraparound of intermediate values is intended
+            for (std::size_t k = dim.table_digits; k < dim.digit_count; ++k) {
+                const std::uint32_t digit = dim.digits[k];
+                const std::uint32_t next  = digit + 1 == dim.base ? 0 : digit + 1;
+
+                dim.high += (permuted(dim, next) - permuted(dim, digit)) * dim.scale[k];
+                dim.digits[k] = next;
+                if (next) break;
+            }
+        }
+
+        ++this->position;
+        return out;
     }
-    // 32-bit float, 32-bit uniform PRNG
-    // => multiplication algorithm tweaked for 32-bit
-    else if constexpr (prng_is_bit_uniform && sizeof(T) == 4 && sizeof(generated_type) == 4) {
-        return (gen() >> exponent_bits_32) * mantissa_hex_32;
+
+    template <class OutIt>
+    void fill(OutIt first, OutIt last) {
+        _fill_points(*this, first, last);
     }
-    // Generic case, no particular optimizations can be made
-    else {
-        return _generate_canonical_generic<T>(gen);
+
+    std::vector<T> operator()() {
+        std::vector<T> point(this->dimensions());
+        this->next(point.begin());
+        return point;
     }
-}
 
-template <class T = double, _require<std::is_floating_point_v<T>> = true>
-struct UniformRealDistribution {
+    [[nodiscard]] std::size_t   dimensions() const noexcept { return this->dims.size(); }
+    [[nodiscard]] std::uint64_t index() const noexcept { return this->position; }
+};
+
+// --- R-sequence ---
+// ------------------
+
+// Additive recurrence based on generalized golden ratio, see M. Roberts "The unreasonable effectiveness of
+// quasirandom sequences" (2018), https://extremelearning.com.au/unreasonable-effectiveness-of-quasirandom-sequences/
+//
+// Point 'n' is 'frac(offset + n * alpha)' where 'alpha_j = phi_d^-(j + 1)' and 'phi_d' is the positive root of
+// 'x^(d + 1) = x + 1'. Values are kept in 64-bit fixed point, which makes the recurrence exact and lets us jump
+// to any index in O(1). Default offset is '0.5' as recommended by the author, scrambling replaces it with
+// a random shift (R. Cranley & T. N. L. Patterson 1976).
+
+template <class T = double>
+class RSequence {
+    static_assert(std::is_floating_point_v<T>);
+
+    std::vector<std::uint64_t> alpha;
+    std::vector<std::uint64_t> offset;
+    std::vector<std::uint64_t> state;
+    std::uint64_t              position = 0;
+
+public:
     using result_type = T;
 
-    struct param_type {
-        result_type min = 0;
-        result_type max = std::numeric_limits<result_type>::max();
-    } pars{};
+    explicit RSequence(std::size_t dimensions, std::uint64_t index = 0)
+        : alpha(dimensions), offset(dimensions, std::uint64_t(1) << 63) {
+        assert(dimensions > 0);
 
-    constexpr UniformRealDistribution() = default;
-    constexpr UniformRealDistribution(T min, T max) noexcept : pars({min, max}) { assert(min < max); }
-    constexpr UniformRealDistribution(const param_type& p) noexcept : pars(p) { assert(p.min < p.max); }
+        // fixed-point iteration 'phi <- (1 + phi)^(1 / (d + 1))' converges for any 'd'
+        double phi = 2.;
+        for (int i = 0; i < 64; ++i) phi = _exp(_log(1. + phi) / static_cast<double>(dimensions + 1));
 
-    template <class Gen>
-    constexpr result_type operator()(Gen& gen) const noexcept(noexcept(gen())) {
-        return this->pars.min + generate_canonical<result_type>(gen) * (this->pars.max - this->pars.min);
+        constexpr double two_pow_64 = 18446744073709551616.;
+
+        double a = 1.;
+        for (auto& e : this->alpha) a /= phi, e = static_cast<std::uint64_t>(a * two_pow_64);
+
+        this->seek(index);
+    }
+
+    void seek(std::uint64_t index) noexcept {
+        this->position = index;
+        this->state.resize(this->alpha.size());
+        for (std::size_t j = 0; j < this->alpha.size(); ++j) this->state[j] = this->offset[j] + index * this->alpha[j];
     }
 
+    void discard(std::uint64_t n) noexcept { this->seek(this->position + n); }
+
     template <class Gen>
-    constexpr T operator()(Gen& gen, const param_type& p) const noexcept(noexcept(gen())) {
-        assert(p.min < p.max);
-        return p.min + generate_canonical<result_type>(gen) * (p.max - p.min);
-    } // for std-compatibility
+    void scramble(Gen& gen) {
+        for (auto& e : this->offset) e = _generate_uint64(gen);
+        this->seek(this->position);
+    }
 
-    constexpr result_type reset() const noexcept {} // there is nothing to reset, provided for std-API compatibility
-    constexpr param_type  params() const noexcept { return this->pars; }
-    constexpr void        params(const param_type& p) noexcept { *this = UniformRealDistribution(p); }
-    constexpr result_type a() const noexcept { return this->pars.min; }
-    constexpr result_type b() const noexcept { return this->pars.max; }
-    constexpr result_type min() const noexcept { return this->pars.min; }
-    constexpr result_type max() const noexcept { return this->pars.max; }
-};
+    template <class OutIt>
+    OutIt next(OutIt out) {
+        for (std::size_t j = 0; j < this->state.size(); ++j) {
+            *out = _fixed_point_to_unit<T>(this->state[j]), ++out;
+            this->state[j] += this->alpha[j];
+        }
+        ++this->position;
+        return out;
+    }
 
-template <class T>
-constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRealDistribution<T>& rhs) noexcept {
-    return lhs.a() == rhs.a() && lhs.b() == rhs.b();
-}
+    template <class OutIt>
+    void fill(OutIt first, OutIt last) {
+        _fill_points(*this, first, last);
+    }
+
+    std::vector<T> operator()() {
+        std::vector<T> point(this->dimensions());
+        this->next(point.begin());
+        return point;
+    }
+
+    [[nodiscard]] std::size_t   dimensions() const noexcept { return this->alpha.size(); }
+    [[nodiscard]] std::uint64_t index() const noexcept { return this->position; }
+};
 
 // ========================
 // --- Random Functions ---
@@ -9107,7 +14695,7 @@ constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRe
 // sizeof(std::uniform_real_distribution<double>) == 16
 // sizeof(std::normal_distribution<double>)       == 32
 //
-// and same thing for 'UniformIntDistribution', 'UniformRealDistribution'
+// and same thing for 'UniformIntDistribution', 'UniformRealDistribution', 'NormalDistribution'
 
 // Note 2:
 // No '[[nodiscard]]' since random functions inherently can't be pure due to advancing the generator state.
@@ -9117,36 +14705,36 @@ constexpr bool operator==(const UniformRealDistribution<T>& lhs, const UniformRe
 
 inline int rand_int(int min, int max) noexcept {
     const UniformIntDistribution<int> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
 inline int rand_uint(unsigned int min, unsigned int max) noexcept {
     const UniformIntDistribution<unsigned int> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
-inline float rand_float() noexcept { return generate_canonical<float>(default_generator); }
+inline float rand_float() noexcept { return generate_canonical<float>(thread_generator()); }
 
 inline float rand_float(float min, float max) noexcept {
     const UniformRealDistribution<float> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
-inline float rand_normal_float() {
-    std::normal_distribution<float> distr;
-    return distr(default_generator);
+inline float rand_normal_float() noexcept {
+    const NormalDistribution<float> distr;
+    return distr(thread_generator());
 }
 
-inline double rand_double() noexcept { return generate_canonical<double>(default_generator); }
+inline double rand_double() noexcept { return generate_canonical<double>(thread_generator()); }
 
 inline double rand_double(double min, double max) noexcept {
     const UniformRealDistribution<double> distr{min, max};
-    return distr(default_generator);
+    return distr(thread_generator());
 }
 
-inline double rand_normal_double() {
-    std::normal_distribution<double> distr;
-    return distr(default_generator);
+inline double rand_normal_double() noexcept {
+    const NormalDistribution<double> distr;
+    return distr(thread_generator());
 }
 
 inline bool rand_bool() noexcept { return static_cast<bool>(rand_uint(0, 1)); }
@@ -9504,8 +15092,12 @@ inline void system(double ms) { std::this_thread::sleep_for(_chrono_ns(static_ca
 // _______________________ INCLUDES _______________________
 
 #include <algorithm>   // transform()
+#include <array>       // array<>
 #include <cctype>      // tolower(), toupper()
 #include <cstddef>     // size_t
+#include <cstdint>     // uint64_t
+#include <cstring>     // memchr(), memcpy()
+#include <iterator>    // forward_iterator_tag
 #include <exception>   // exception
 #include <iomanip>     // setfill(), setw()
 #include <ostream>     // ostream
@@ -9514,7 +15106,7 @@ inline void system(double ms) { std::this_thread::sleep_for(_chrono_ns(static_ca
 #include <string>      // string
 #include <string_view> // string_view
 #include <tuple>       // tuple<>, get<>()
-#include <type_traits> // false_type, true_type, void_t<>, is_convertible<>, enable_if_t<>
+#include <type_traits> // false_type, true_type, void_t<>, is_convertible<>, enable_if_t<>, conditional_t<>, ...
 #include <utility>     // declval<>(), index_sequence<>
 #include <vector>      // vector<>
 
@@ -9572,11 +15164,162 @@ inline void system(double ms) { std::this_thread::sleep_for(_chrono_ns(static_ca
 // # ::pad_with_zeroes() #
 // Pads given integer with zeroes untill a certain lenght.
 // Useful when saving data in files like 'data_0001.txt', 'data_0002.txt', '...' so they get properly sorted.
+//
+// # ::CharSet #
+// Set of chars with O(1) membership test, used as an "any of these chars" delimiter / search target.
+// Searches for small sets are done with SWAR (8 chars per 64-bit word), which is portable and doesn't
+// require any intrinsics, larger sets fall back onto a lookup table.
+//
+// # ::to_lower_ascii(), ::to_upper_ascii() #
+// Locale-independent case conversion that also uses SWAR, modifies r-value strings in place.
+//
+// # ::split_view(), ::for_each_token(), ::split_into() #
+// Non-allocating counterparts of '::split_by_delimiter()'. Tokens are 'std::string_view's into the original string,
+// which are either produced lazily by a forward range, passed to a callback, or assigned into a caller-provided vector
+// so its capacity (and the capacity of its strings) gets reused between calls.
 
 // ____________________ IMPLEMENTATION ____________________
 
 namespace utl::stre {
 
+// ======================
+// --- Character sets ---
+// ======================
+
+// --- SWAR utils ---
+// ------------------
+
+// "SIMD within a register", processing strings 8 chars at a time using plain 64-bit arithmetic.
+// All of the operations below are byte-wise with no carries crossing the byte boundaries,
+// which means they produce the same result regardless of the platform endianness.
+
+constexpr std::size_t   _swar_width     = sizeof(std::uint64_t);
+constexpr std::uint64_t _swar_ones      = 0x0101010101010101; // 0x01 in every byte
+constexpr std::uint64_t _swar_low_bits  = 0x7F7F7F7F7F7F7F7F; // lower 7 bits of every byte
+constexpr std::uint64_t _swar_high_bits = 0x8080808080808080; // highest bit of every byte
+
+[[nodiscard]] inline std::uint64_t _swar_load(const char* ptr) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, ptr, _swar_width); // compiles down to a single unaligned load
+    return word;
+}
+
+inline void _swar_store(char* ptr, std::uint64_t word) noexcept { std::memcpy(ptr, &word, _swar_width); }
+
+// Sets the highest bit of every byte of 'word' that is NOT equal to 'c', lower 7 bits of the result are garbage.
+// Unlike the common "has zero byte" trick this is exact, there are no false positives caused by borrows
+[[nodiscard]] constexpr std::uint64_t _swar_not_equal(std::uint64_t word, char c) noexcept {
+    const std::uint64_t diff = word ^ (_swar_ones * static_cast<unsigned char>(c));
+    return ((diff & _swar_low_bits) + _swar_low_bits) | diff;
+}
+
+// --- Char set ---
+// ----------------
+
+// Sets with a few chars are matched against 8 chars at a time, larger sets fall back onto a lookup table
+constexpr std::size_t _swar_max_set_size = 4;
+
+class CharSet;
+
+template <bool in_set>
+[[nodiscard]] std::size_t _find_first(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+template <bool in_set>
+[[nodiscard]] std::size_t _find_last(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+class CharSet {
+    std::array<bool, 256>                table{};
+    std::array<char, _swar_max_set_size> chars{}; // first few distinct chars, used by the SWAR search
+    std::size_t                          size = 0;
+
+    [[nodiscard]] constexpr bool is_small() const noexcept {
+        return 0 < this->size && this->size <= _swar_max_set_size;
+    }
+
+    // Unused slots of 'chars' are filled with copies of the first char, which lets us always check
+    // a fixed number of chars without branching on the set size
+    // Sets the highest bit of every byte of 'word' that belongs to the set, other bits are cleared
+    [[nodiscard]] constexpr std::uint64_t match_mask(std::uint64_t word) const noexcept {
+        static_assert(_swar_max_set_size == 4);
+        const std::uint64_t mismatches = _swar_not_equal(word, this->chars[0]) & _swar_not_equal(word, this->chars[1]) &
+                                         _swar_not_equal(word, this->chars[2]) & _swar_not_equal(word, this->chars[3]);
+        return ~(mismatches | _swar_low_bits);
+    }
+
+    template <bool in_set>
+    friend std::size_t _find_first(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+    template <bool in_set>
+    friend std::size_t _find_last(std::string_view str, const CharSet& set, std::size_t pos) noexcept;
+
+public:
+    constexpr CharSet() = default;
+
+    constexpr explicit CharSet(std::string_view chars) {
+        for (const char c : chars) {
+            bool& in_set = this->table[static_cast<unsigned char>(c)];
+            if (in_set) continue; // skip duplicates so they don't push us out of the SWAR path
+            if (this->size < _swar_max_set_size) this->chars[this->size] = c;
+            in_set = true;
+            ++this->size;
+        }
+        for (std::size_t i = 1; i < _swar_max_set_size; ++i)
+            if (i >= this->size) this->chars[i] = this->chars[0];
+    }
+
+    [[nodiscard]] constexpr bool contains(char c) const noexcept { return this->table[static_cast<unsigned char>(c)]; }
+};
+
+// Skip whole words that can't contain the target, then pinpoint the exact position with a scalar scan
+template <bool in_set>
+std::size_t _find_first(std::string_view str, const CharSet& set, std::size_t pos) noexcept {
+    if (pos >= str.size()) return std::string_view::npos;
+
+    if (set.is_small())
+        for (; pos + _swar_width <= str.size(); pos += _swar_width) {
+            const std::uint64_t matches = set.match_mask(_swar_load(str.data() + pos));
+            if (in_set ? matches != 0 : matches != _swar_high_bits) break;
+        }
+
+    for (; pos < str.size(); ++pos)
+        if (set.contains(str[pos]) == in_set) return pos;
+    return std::string_view::npos;
+}
+
+template <bool in_set>
+std::size_t _find_last(std::string_view str, const CharSet& set, std::size_t pos) noexcept {
+    std::size_t end = (pos < str.size()) ? pos + 1 : str.size(); // scanning '[0, end)' backwards
+
+    if (set.is_small())
+        for (; end >= _swar_width; end -= _swar_width) {
+            const std::uint64_t matches = set.match_mask(_swar_load(str.data() + end - _swar_width));
+            if (in_set ? matches != 0 : matches != _swar_high_bits) break;
+        }
+
+    while (end--)
+        if (set.contains(str[end]) == in_set) return end;
+    return std::string_view::npos;
+}
+
+[[nodiscard]] inline std::size_t find_first_of(std::string_view str, const CharSet& set, std::size_t pos = 0) noexcept {
+    return _find_first<true>(str, set, pos);
+}
+
+[[nodiscard]] inline std::size_t find_first_not_of(std::string_view str, const CharSet& set,
+                                                   std::size_t pos = 0) noexcept {
+    return _find_first<false>(str, set, pos);
+}
+
+[[nodiscard]] inline std::size_t find_last_of(std::string_view str, const CharSet& set,
+                                              std::size_t pos = std::string_view::npos) noexcept {
+    return _find_last<true>(str, set, pos);
+}
+
+[[nodiscard]] inline std::size_t find_last_not_of(std::string_view str, const CharSet& set,
+                                                  std::size_t pos = std::string_view::npos) noexcept {
+    return _find_last<false>(str, set, pos);
+}
+
 // ================
 // --- Trimming ---
 // ================
@@ -9600,6 +15343,35 @@ template <class T>
     return trim_right(trim_left(std::forward<T>(str), trimmed_char), trimmed_char);
 }
 
+// Non-owning versions, trimming is just an adjustment of the view bounds so there is nothing to copy
+[[nodiscard]] inline std::string_view trim_left_view(std::string_view str, char trimmed_char = ' ') noexcept {
+    str.remove_prefix(std::min(str.find_first_not_of(trimmed_char), str.size()));
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_right_view(std::string_view str, char trimmed_char = ' ') noexcept {
+    str.remove_suffix(str.size() - (str.find_last_not_of(trimmed_char) + 1)); // 'npos + 1' wraps around to 0
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_view(std::string_view str, char trimmed_char = ' ') noexcept {
+    return trim_right_view(trim_left_view(str, trimmed_char), trimmed_char);
+}
+
+[[nodiscard]] inline std::string_view trim_left_view(std::string_view str, const CharSet& trimmed_chars) noexcept {
+    str.remove_prefix(std::min(find_first_not_of(str, trimmed_chars), str.size()));
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_right_view(std::string_view str, const CharSet& trimmed_chars) noexcept {
+    str.remove_suffix(str.size() - (find_last_not_of(str, trimmed_chars) + 1));
+    return str;
+}
+
+[[nodiscard]] inline std::string_view trim_view(std::string_view str, const CharSet& trimmed_chars) noexcept {
+    return trim_right_view(trim_left_view(str, trimmed_chars), trimmed_chars);
+}
+
 // ===============
 // --- Padding ---
 // ===============
@@ -9673,6 +15445,43 @@ template <class T>
     return res;
 }
 
+// ASCII-only versions, they ignore the locale which allows us to flip the case of 8 chars at a time.
+// Non-ASCII bytes (including the UTF-8 multibyte sequences) are always left untouched.
+template <char first, char last>
+[[nodiscard]] constexpr std::uint64_t _swar_flip_case(std::uint64_t word) noexcept {
+    const std::uint64_t low_bits   = word & _swar_low_bits;
+    const std::uint64_t from_first = low_bits + _swar_ones * (0x80 - first); // highest bit set for bytes >= first
+    const std::uint64_t after_last = low_bits + _swar_ones * (0x7F - last);  // highest bit set for bytes >  last
+    const std::uint64_t in_range   = (from_first ^ after_last) & ~word & _swar_high_bits;
+    return word ^ (in_range >> 2); // '0x80 >> 2' is '0x20', the only bit that differs between cases in ASCII
+}
+
+template <char first, char last>
+void _flip_case_ascii(std::string& str) noexcept {
+    char* const       data = str.data();
+    const std::size_t size = str.size();
+
+    std::size_t i = 0;
+    for (; i + _swar_width <= size; i += _swar_width)
+        _swar_store(data + i, _swar_flip_case<first, last>(_swar_load(data + i)));
+    for (; i < size; ++i)
+        if (first <= data[i] && data[i] <= last) data[i] = static_cast<char>(data[i] ^ 0x20);
+}
+
+template <class T>
+[[nodiscard]] std::string to_lower_ascii(T&& str) {
+    std::string res = std::forward<T>(str); // when 'str' is an r-value, conversion happens in place
+    _flip_case_ascii<'A', 'Z'>(res);
+    return res;
+}
+
+template <class T>
+[[nodiscard]] std::string to_upper_ascii(T&& str) {
+    std::string res = std::forward<T>(str);
+    _flip_case_ascii<'a', 'z'>(res);
+    return res;
+}
+
 // ========================
 // --- Substring checks ---
 // ========================
@@ -9712,6 +15521,156 @@ template <class T>
     return res;
 }
 
+// --- Delimiter search ---
+// ------------------------
+
+// Single char is the most common delimiter, 'std::memchr()' is vectorized by all major standard libraries
+// and lets us skip the substring comparison entirely
+[[nodiscard]] inline std::size_t _find_delimiter(std::string_view str, char delimiter, std::size_t pos) noexcept {
+    if (pos >= str.size()) return std::string_view::npos;
+    const void* match = std::memchr(str.data() + pos, delimiter, str.size() - pos);
+    return match ? static_cast<std::size_t>(static_cast<const char*>(match) - str.data()) : std::string_view::npos;
+}
+
+[[nodiscard]] inline std::size_t _find_delimiter(std::string_view str, std::string_view delimiter,
+                                                 std::size_t pos) noexcept {
+    if (delimiter.empty()) return std::string_view::npos; // empty delimiter doesn't split anything
+    return str.find(delimiter, pos);
+}
+
+[[nodiscard]] inline std::size_t _find_delimiter(std::string_view str, const CharSet& delimiter,
+                                                 std::size_t pos) noexcept {
+    return find_first_of(str, delimiter, pos);
+}
+
+[[nodiscard]] constexpr std::size_t _delimiter_size(char) noexcept { return 1; }
+[[nodiscard]] constexpr std::size_t _delimiter_size(std::string_view delimiter) noexcept { return delimiter.size(); }
+[[nodiscard]] constexpr std::size_t _delimiter_size(const CharSet&) noexcept { return 1; }
+
+// String literals, 'std::string' & etc. are all treated as a substring delimiter
+template <class T>
+using _delimiter_t = std::conditional_t<std::is_same_v<std::decay_t<T>, char>, char,
+                                        std::conditional_t<std::is_same_v<std::decay_t<T>, CharSet>, CharSet,
+                                                           std::string_view>>;
+
+// --- Lazy split ---
+// ------------------
+
+template <class Delimiter>
+class SplitView {
+    std::string_view str;
+    Delimiter        delimiter;
+    bool             keep_empty_tokens;
+
+public:
+    SplitView(std::string_view str, Delimiter delimiter, bool keep_empty_tokens = false)
+        : str(str), delimiter(delimiter), keep_empty_tokens(keep_empty_tokens) {
+        if (_delimiter_size(this->delimiter) == 0) this->keep_empty_tokens = true;
+        // empty delimiter always produces the whole string as a single token, same as '::split_by_delimiter()'
+    }
+
+    // Finds the next token starting from 'cursor', which gets advanced past the following delimiter.
+    // Cursor value of 'str.size() + 1' indicates that the last segment was already consumed.
+    bool next(std::size_t& cursor, std::string_view& token) const noexcept {
+        while (cursor <= this->str.size()) {
+            const std::size_t pos  = _find_delimiter(this->str, this->delimiter, cursor);
+            const std::size_t stop = (pos == std::string_view::npos) ? this->str.size() : pos;
+
+            const std::size_t start = cursor;
+            cursor = (pos == std::string_view::npos) ? this->str.size() + 1 : pos + _delimiter_size(this->delimiter);
+
+            if (this->keep_empty_tokens || start != stop) {
+                token = this->str.substr(start, stop - start);
+                return true;
+            }
+            // don't produce empty tokens in case of leading/trailing/repeated delimiter
+        }
+        return false;
+    }
+
+    class iterator {
+        const SplitView* view   = nullptr;
+        std::size_t      cursor = 0;
+        std::string_view token;
+        bool             done = true;
+
+        friend class SplitView;
+
+        iterator(const SplitView* view) : view(view) { this->done = !this->view->next(this->cursor, this->token); }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view*;
+        using reference         = const std::string_view&;
+
+        iterator() = default;
+
+        reference operator*() const noexcept { return this->token; }
+        pointer   operator->() const noexcept { return &this->token; }
+
+        iterator& operator++() noexcept {
+            this->done = !this->view->next(this->cursor, this->token);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const noexcept {
+            return (this->done && other.done) || (!this->done && !other.done && this->cursor == other.cursor);
+        }
+
+        bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+    };
+
+    [[nodiscard]] iterator begin() const { return iterator(this); }
+    [[nodiscard]] iterator end() const { return iterator(); }
+};
+
+template <class Delimiter>
+[[nodiscard]] SplitView<_delimiter_t<Delimiter>> split_view(std::string_view str, const Delimiter& delimiter,
+                                                             bool keep_empty_tokens = false) {
+    return {str, delimiter, keep_empty_tokens};
+}
+
+// Substring delimiters are stored as a view, temporary strings would leave it dangling
+SplitView<std::string_view> split_view(std::string_view str, std::string&& delimiter,
+                                       bool keep_empty_tokens = false) = delete;
+
+template <class Delimiter, class Func>
+void for_each_token(std::string_view str, const Delimiter& delimiter, Func&& func, bool keep_empty_tokens = false) {
+    const SplitView<_delimiter_t<Delimiter>> view(str, delimiter, keep_empty_tokens);
+
+    std::size_t      cursor = 0;
+    std::string_view token;
+    while (view.next(cursor, token)) func(token);
+}
+
+// Overwrites 'tokens' with the result of the split. Existing elements are assigned rather than recreated, which means
+// both the vector and its strings keep their capacity, repeated splits into the same vector don't allocate at all
+template <class Delimiter, class T>
+void split_into(std::string_view str, const Delimiter& delimiter, std::vector<T>& tokens,
+                bool keep_empty_tokens = false) {
+    static_assert(std::is_assignable_v<T&, std::string_view>, "Token type must be assignable from a string view.");
+
+    std::size_t count = 0;
+    for_each_token(
+        str, delimiter,
+        [&](std::string_view token) {
+            if (count < tokens.size()) tokens[count] = token;
+            else tokens.emplace_back(token);
+            ++count;
+        },
+        keep_empty_tokens);
+
+    tokens.resize(count);
+}
+
 // Note:
 // Most "split by delimer" implementations found online seem to be horrifically inefficient
 // with unnecessary copying/erasure/intermediate tokens, stringstreams and etc.
@@ -9721,24 +15680,8 @@ template <class T>
 // the vector where it's unavoidable
 [[nodiscard]] inline std::vector<std::string> split_by_delimiter(std::string_view str, std::string_view delimiter,
                                                                  bool keep_empty_tokens = false) {
-    if (delimiter.empty()) return {std::string(str)};
-    // handle empty delimiter explicitly so we can't fall into an infinite loop
-
     std::vector<std::string> tokens;
-    std::size_t              cursor        = 0;
-    std::size_t              segment_start = cursor;
-
-    while ((cursor = str.find(delimiter, cursor)) != std::string_view::npos) {
-        if (keep_empty_tokens || segment_start != cursor)
-            tokens.emplace_back(str.substr(segment_start, cursor - segment_start));
-        // don't emplace empty tokens in case of leading/trailing/repeated delimiter
-        cursor += delimiter.size();
-        segment_start = cursor;
-    }
-
-    if (keep_empty_tokens || segment_start != str.size()) tokens.emplace_back(str.substr(segment_start));
-    // 'cursor' is now at 'npos', so we compare to the size instead
-
+    split_into(str, delimiter, tokens, keep_empty_tokens);
     return tokens;
 }
 
@@ -11,13 +11,21 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <execution>
 #include <functional>
 #include <numeric>
+#include <random>
+#include <set>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 // ____________________ DEVELOPER DOCS ____________________
@@ -824,4 +832,846 @@ TEST_CASE("Testing algebraic operations") {
                             {36, 16, 8},
                             { 0,  0, 0}
     });
-}
\ No newline at end of file
+}
+
+TEST_CASE("Batched small matrix operations") {
+    constexpr std::size_t batch_size = 13; // not a multiple of lane count, last block has padding
+    constexpr std::size_t n          = 3;
+
+    mvl::MatrixBatch<double> A(batch_size, n, n);
+    mvl::MatrixBatch<double> B(batch_size, n, 2);
+
+    for (std::size_t b = 0; b < batch_size; ++b) {
+        // Even matrices have a zero on the diagonal and can only be solved with pivoting
+        A.set(b, mvl::Matrix<double>{
+                     {b % 2 ? 4. + b : 0., 1.,      2.},
+                     {1.,                  5.,      1.},
+                     {3.,                  1., 6. + b}
+        });
+        B.set(b, mvl::Matrix<double>{
+                     {1., 2. * b},
+                     {2.,     -1.},
+                     {3. + b,  0.}
+        });
+    }
+
+    const auto close = [](const mvl::Matrix<double>& l, const mvl::Matrix<double>& r) {
+        const auto equal = [&](const double& e, std::size_t i, std::size_t j) { return std::abs(e - r(i, j)) < 1e-9; };
+        return l.rows() == r.rows() && l.cols() == r.cols() && l.true_for_all(equal);
+    };
+
+    // GEMM matches a regular matrix product
+    mvl::MatrixBatch<double> C;
+    mvl::batched_gemm(A, B, C);
+    CHECK(C.size() == batch_size);
+    for (std::size_t b = 0; b < batch_size; ++b) CHECK(close(C.get(b), A.get(b) * B.get(b)));
+
+    // Solution satisfies the system
+    mvl::MatrixBatch<double> X;
+    mvl::batched_solve(A, B, X);
+    for (std::size_t b = 0; b < batch_size; ++b) CHECK(close(A.get(b) * X.get(b), B.get(b)));
+
+    // Inverse gives an identity
+    const mvl::Matrix<double> I = {
+        {1., 0., 0.},
+        {0., 1., 0.},
+        {0., 0., 1.}
+    };
+    mvl::MatrixBatch<double> A_inv;
+    mvl::batched_inverse(A, A_inv);
+    for (std::size_t b = 0; b < batch_size; ++b) CHECK(close(A.get(b) * A_inv.get(b), I));
+
+    // Mismatched dimensions throw
+    CHECK(check_if_throws([&] { mvl::batched_gemm(B, B, C); }));
+
+    // Aliased output throws instead of silently overwriting the inputs
+    CHECK_THROWS_AS(mvl::batched_gemm(A, C, C), std::invalid_argument);
+    CHECK_THROWS_AS(mvl::batched_gemm(C, B, C), std::invalid_argument);
+}
+
+TEST_CASE("Sparse matrix builder") {
+    // Assemble a 1D Laplacian from 2x2 "element" contributions, inner nodes get duplicate contributions
+    constexpr std::size_t n = 1000;
+
+    mvl::SparseMatrixBuilder<int> builder(n, n);
+
+    const auto assemble_elements = [&](std::size_t low, std::size_t high) {
+        for (std::size_t e = low; e < high; ++e) {
+            builder.add(e, e, 1).add(e, e + 1, -1);
+            builder.add(e + 1, e, -1).add(e + 1, e + 1, 1);
+        }
+    };
+
+    // Contributions come from several threads at once
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 4; ++t) threads.emplace_back(assemble_elements, t * (n - 1) / 4, (t + 1) * (n - 1) / 4);
+    for (auto& thread : threads) thread.join();
+
+    CHECK(builder.contributions() == 4 * (n - 1));
+
+    const mvl::SparseMatrix<int> A = builder.build();
+
+    CHECK(builder.contributions() == 0);
+    CHECK(A.size() == 3 * n - 2);
+    CHECK(std::is_sorted(A.entries().begin(), A.entries().end()));
+    CHECK(A(0, 0) == 1);
+    CHECK(A(1, 1) == 2);
+    CHECK(A(1, 0) == -1);
+    CHECK(A(n - 1, n - 1) == 1);
+    CHECK(A.contains_index(n - 1, 0) == false);
+    CHECK(A.sum() == 0);
+
+    // CSR output is consistent with the sparse matrix
+    mvl::SparseMatrixBuilder<int> small_builder(3, 3);
+    small_builder.add(2, 1, 5).add(0, 2, 7).add(2, 1, 1);
+    const mvl::CSRMatrix<int> csr = small_builder.build_csr();
+
+    CHECK(csr.size() == 2);
+    CHECK(csr.row_offsets() == std::vector<std::size_t>{0, 1, 1, 2});
+    CHECK(csr.col_indices() == std::vector<std::size_t>{2, 1});
+    CHECK(csr.values() == std::vector<int>{7, 6});
+    CHECK(csr.to_sparse()(2, 1) == 6);
+}
+
+TEST_CASE("Random tensors") {
+    const std::uniform_real_distribution<double> dist(0., 1.);
+
+    // Dense fill is reproducible & spans several generator blocks
+    mvl::Matrix<double> A(300, 200), B(300, 200);
+    mvl::fill_random<std::mt19937_64>(A, dist, 42);
+    mvl::fill_random<std::mt19937_64>(B, dist, 42);
+
+    CHECK(std::equal(A.begin(), A.end(), B.begin()));
+    CHECK(std::all_of(A.begin(), A.end(), [](double e) { return 0. <= e && e < 1.; }));
+    CHECK(A.sum() / A.size() == doctest::Approx(0.5).epsilon(0.01));
+
+    mvl::fill_random<std::mt19937_64>(B, dist, 43);
+    CHECK(!std::equal(A.begin(), A.end(), B.begin()));
+
+    // Views only fill their own elements
+    mvl::Matrix<int> C(10, 10, 0);
+    mvl::fill_random<std::minstd_rand>(C.block(2, 2, 3, 3), std::uniform_int_distribution<int>(1, 9), 7);
+    C.for_each([](int e, std::size_t i, std::size_t j) {
+        const bool inside = 2 <= i && i < 5 && 2 <= j && j < 5;
+        CHECK((inside ? e != 0 : e == 0));
+    });
+
+    // Sparse matrices with given density have exact number of non-zeros, sorted with no duplicates
+    const auto S = mvl::random_sparse<std::mt19937>(1000, 500, 0.01, dist, 42);
+    const auto T = mvl::random_sparse<std::mt19937>(1000, 500, 0.01, dist, 42);
+
+    const auto& entries = S.entries();
+    CHECK(S.size() == 5000);
+    CHECK(std::adjacent_find(entries.begin(), entries.end(), [](const auto& l, const auto& r) { return !(l < r); }) ==
+          entries.end());
+    CHECK(std::equal(entries.begin(), entries.end(), T.entries().begin(), [](const auto& l, const auto& r) {
+        return l.i == r.i && l.j == r.j && l.value == r.value;
+    }));
+
+    std::vector<std::size_t> row_nnz(S.rows()), col_nnz(S.cols());
+    for (const auto& e : entries) ++row_nnz[e.i], ++col_nnz[e.j];
+    CHECK(std::all_of(row_nnz.begin(), row_nnz.end(), [](std::size_t nnz) { return nnz == 5; }));
+    CHECK(*std::max_element(col_nnz.begin(), col_nnz.end()) < 30); // expected 10 per column
+
+    // Fixed number of non-zeros per row, including completely filled rows
+    const auto P = mvl::random_sparse_per_row<std::mt19937_64>(100, 20, 20, dist, 1);
+    CHECK(P.size() == 2000);
+    CHECK(P.contains_index(99, 19));
+
+    const auto Q = mvl::random_sparse_per_row<std::mt19937_64>(10'000, 1'000'000, 3, dist, 1);
+    CHECK(Q.size() == 30'000);
+    CHECK(std::is_sorted(Q.entries().begin(), Q.entries().end()));
+
+    // Work doesn't depend on the number of columns, both short rows & rows long enough to use a hash set
+    constexpr std::size_t huge_cols = std::size_t(1) << 50;
+    for (const std::size_t nnz : {3, 100}) {
+        const auto H = mvl::random_sparse_per_row<std::mt19937_64>(200, huge_cols, nnz, dist, 7);
+        CHECK(H.size() == 200 * nnz);
+        CHECK(std::adjacent_find(H.entries().begin(), H.entries().end(),
+                                 [](const auto& l, const auto& r) { return !(l < r); }) == H.entries().end());
+        CHECK(std::all_of(H.entries().begin(), H.entries().end(), [&](const auto& e) { return e.j < huge_cols; }));
+    }
+
+    const auto F = mvl::random_sparse_per_row<std::mt19937_64>(10, 100, 100, dist, 1); // full rows via hash set
+    CHECK(F.size() == 1000);
+    CHECK(F.contains_index(9, 99));
+
+    // Sparsity pattern doesn't depend on the standard library, 32-bit generators see all bits of the seed
+    const auto R = mvl::random_sparse_per_row<std::mt19937>(2, 1000, 4, dist, 42);
+    const std::vector<std::pair<std::size_t, std::size_t>> expected_pattern = {
+        {0,   6},
+        {0, 132},
+        {0, 445},
+        {0, 601},
+        {1, 237},
+        {1, 371},
+        {1, 817},
+        {1, 942}
+    };
+    CHECK(std::equal(R.entries().begin(), R.entries().end(), expected_pattern.begin(), expected_pattern.end(),
+                     [](const auto& e, const auto& p) { return e.i == p.first && e.j == p.second; }));
+
+    const auto R_high = mvl::random_sparse_per_row<std::mt19937>(2, 1000, 4, dist, 42 + (std::uint64_t(1) << 32));
+    CHECK(!std::equal(R.entries().begin(), R.entries().end(), R_high.entries().begin(),
+                      [](const auto& l, const auto& r) { return l.j == r.j; }));
+
+    // Index reduction stays uniform for generators with a range that isn't a power of 2
+    std::minstd_rand         gen(3);
+    std::vector<std::size_t> counts(7);
+    for (std::size_t i = 0; i < 70'000; ++i) ++counts.at(mvl::_random_index(gen, 7));
+    CHECK(std::all_of(counts.begin(), counts.end(), [](std::size_t c) { return 9'500 < c && c < 10'500; }));
+
+    CHECK_THROWS_AS((void)mvl::random_sparse_per_row<std::mt19937>(10, 5, 6, dist, 1), std::invalid_argument);
+    CHECK_THROWS_AS((void)mvl::random_sparse<std::mt19937>(10, 5, 1.5, dist, 1), std::invalid_argument);
+}
+
+TEST_CASE("Sparse triplets stay sorted") {
+    mvl::SparseMatrix<int> mat(4, 4,
+                               {
+                                   {3, 0, 1},
+                                   {0, 3, 2},
+                                   {1, 1, 3}
+    });
+
+    mat.insert_triplets({
+        {2, 2, 4},
+        {0, 0, 5}
+    });
+
+    CHECK(std::is_sorted(mat.entries().begin(), mat.entries().end()));
+    CHECK(mat[0] == 5);
+    CHECK(mat[1] == 2);
+    CHECK(mat(3, 0) == 1);
+
+    // Erasing indices that aren't present doesn't prevent erasure of the others
+    mat.erase_triplets({
+        {0, 1},
+        {1, 1},
+        {3, 0}
+    });
+
+    CHECK(mat.size() == 3);
+    CHECK(mat.contains_index(1, 1) == false);
+    CHECK(mat.contains_index(3, 0) == false);
+    CHECK(mat(2, 2) == 4);
+}
+
+TEST_CASE("Parallel algorithms match sequential ones") {
+    constexpr std::size_t rows = 300, cols = 500;
+
+    mvl::Matrix<int> A(rows, cols), B(rows, cols);
+
+    A.parallel_fill([](std::size_t i, std::size_t j) { return int(i * cols + j); });
+    B.fill([](std::size_t i, std::size_t j) { return int(i * cols + j); });
+    CHECK(A.compare_contents(B));
+
+    A.parallel_transform([](const int& elem) { return 2 * elem; });
+    B.transform([](const int& elem) { return 2 * elem; });
+    CHECK(A.compare_contents(B));
+
+    // Strided views
+    A.block(10, 20, 100, 200).parallel_fill(-1);
+    B.block(10, 20, 100, 200).fill(-1);
+    CHECK(A.compare_contents(B));
+
+    std::atomic<long long> sum = 0;
+    A.col(3).parallel_for_each([&](const int& elem, std::size_t i, std::size_t j) { sum += elem + int(i) - int(j); });
+    long long expected_sum = 0;
+    B.col(3).for_each([&](const int& elem, std::size_t i, std::size_t j) { expected_sum += elem + int(i) - int(j); });
+    CHECK(sum == expected_sum);
+
+    // Sparse matrices
+    mvl::SparseMatrix<int> S = B;
+    S.parallel_transform([](const int& elem, std::size_t i, std::size_t j) { return elem + int(i + j); });
+    CHECK(S(1, 1) == 2 * int(cols + 1) + 2);
+
+    // Parallel initialization is opt-in
+    const mvl::Matrix<int>        C(rows, cols, 7, mvl::parallel_init);
+    const mvl::StridedMatrix<int> D(rows, cols, 2, 3, 7, mvl::parallel_init);
+    CHECK(C.compare_contents(mvl::Matrix<int>(rows, cols, 7)));
+    CHECK(D.compare_contents(C));
+}
+
+template <mvl::Layout layout>
+void check_strided_view_iteration() {
+    constexpr std::size_t rows = 7, cols = 9;
+
+    mvl::Matrix<int, mvl::Checking::NONE, layout> A(rows, cols);
+    A.fill([](std::size_t i, std::size_t j) { return int(i * cols + j); });
+
+    // Iteration order & indices of a block view
+    auto                     block = A.block(2, 3, 4, 5);
+    std::vector<int>         visited;
+    std::vector<std::size_t> visited_idx;
+    block.for_each([&](const int& elem, std::size_t idx) {
+        visited.push_back(elem);
+        visited_idx.push_back(idx);
+    });
+    REQUIRE(visited.size() == block.size());
+    for (std::size_t idx = 0; idx < block.size(); ++idx) {
+        CHECK(visited[idx] == block[idx]);
+        CHECK(visited_idx[idx] == idx);
+    }
+    block.for_each([&](const int& elem, std::size_t i, std::size_t j) { CHECK(elem == int((i + 2) * cols + j + 3)); });
+
+    // Reductions, copies & arithmetic
+    int expected_sum = 0;
+    for (std::size_t i = 2; i < 6; ++i)
+        for (std::size_t j = 3; j < 8; ++j) expected_sum += A(i, j);
+    CHECK(block.sum() == expected_sum);
+    CHECK(A.block(0, 1, 2, 2).product() == 1 * 2 * 10 * 11);
+    CHECK(A.block(0, 0, 2, 2).product() == 0);
+
+    mvl::Matrix<int, mvl::Checking::NONE, layout> copy = block;
+    CHECK(copy.compare_contents(block));
+    copy += block;
+    copy.for_each([&](const int& elem, std::size_t i, std::size_t j) { CHECK(elem == 2 * block(i, j)); });
+
+    // Mutation through rows & columns
+    A.row(1).transform([](const int& elem) { return -elem; });
+    A.col(4).fill(0);
+    for (std::size_t j = 0; j < cols; ++j) CHECK(A(1, j) == (j == 4 ? 0 : -int(cols + j)));
+    for (std::size_t i = 0; i < rows; ++i) CHECK(A(i, 4) == 0);
+    CHECK(A(0, 0) == 0);
+    CHECK(A(6, 8) == int(6 * cols + 8));
+}
+
+TEST_CASE("Strided views iterate correctly in both layouts") {
+    check_strided_view_iteration<mvl::Layout::RC>();
+    check_strided_view_iteration<mvl::Layout::CR>();
+}
+
+TEST_CASE("Block sparse matrices") {
+    // 6x9 matrix made of 3x3 tiles, tile (0, 1) is empty
+    mvl::SparseMatrix<double> S(6, 9,
+                                {
+                                    {0, 0, 1.},
+                                    {1, 2, 2.},
+                                    {2, 7, 3.},
+                                    {4, 3, 4.},
+                                    {5, 0, 5.},
+                                    {3, 8, 6.}
+    });
+
+    mvl::BSRMatrix<double, 3> B(S);
+    CHECK(B.block_rows() == 2);
+    CHECK(B.block_cols() == 3);
+    CHECK(B.blocks() == 5);
+    CHECK(B.block_row_offsets() == std::vector<std::size_t>{0, 2, 5});
+    CHECK(B.block_col_indices() == std::vector<std::size_t>{0, 2, 0, 1, 2});
+    CHECK(B.to_sparse().compare_contents(S));
+
+    // SpMV
+    std::vector<double> x(9), y;
+    for (std::size_t j = 0; j < x.size(); ++j) x[j] = double(j + 1);
+    mvl::spmv(B, x, y);
+    REQUIRE(y.size() == 6);
+    std::vector<double> expected_y(6, 0.);
+    S.for_each([&](const double& elem, std::size_t i, std::size_t j) { expected_y[i] += elem * x[j]; });
+    CHECK(y == expected_y);
+
+    // SpMM
+    mvl::Matrix<double> X(9, 4, [](std::size_t i, std::size_t j) { return double(i * 4 + j); });
+    mvl::Matrix<double> Y;
+    mvl::spmm(B, X, Y);
+    const mvl::Matrix<double> expected_Y = mvl::Matrix<double>(S) * X;
+    CHECK(Y.compare_contents(expected_Y));
+
+    // Invalid dimensions
+    using BSRMatrix2 = mvl::BSRMatrix<double, 2>;
+    CHECK_THROWS_AS(BSRMatrix2{S}, std::invalid_argument);
+    std::vector<double> short_x(3);
+    CHECK_THROWS_AS(mvl::spmv(B, short_x, y), std::invalid_argument);
+}
+
+template <class Kernel>
+mvl::Matrix<int> naive_stencil_sweep(const mvl::Matrix<int>& src, const Kernel& kernel, mvl::Boundary boundary) {
+    const auto rows = std::ptrdiff_t(src.rows()), cols = std::ptrdiff_t(src.cols());
+    const auto ry = std::ptrdiff_t(kernel.rows() / 2), rx = std::ptrdiff_t(kernel.cols() / 2);
+
+    const auto map = [&](std::ptrdiff_t idx, std::ptrdiff_t size) -> std::ptrdiff_t {
+        if (idx >= 0 && idx < size) return idx;
+        if (boundary == mvl::Boundary::CLAMP) return std::clamp<std::ptrdiff_t>(idx, 0, size - 1);
+        if (boundary == mvl::Boundary::PERIODIC) return (idx % size + size) % size;
+        return -1;
+    };
+
+    mvl::Matrix<int> res(src.rows(), src.cols(), 0);
+    res.for_each([&](int& elem, std::size_t i, std::size_t j) {
+        for (std::ptrdiff_t a = 0; a < std::ptrdiff_t(kernel.rows()); ++a)
+            for (std::ptrdiff_t b = 0; b < std::ptrdiff_t(kernel.cols()); ++b) {
+                const auto ii = map(std::ptrdiff_t(i) + a - ry, rows), jj = map(std::ptrdiff_t(j) + b - rx, cols);
+                if (ii >= 0 && jj >= 0) elem += kernel(a, b) * src(ii, jj);
+            }
+    });
+    return res;
+}
+
+TEST_CASE("Stencils match naive implementation") {
+    const mvl::Stencil<int, 3> laplace   = {{0, 1, 0, 1, -4, 1, 0, 1, 0}};
+    const mvl::Matrix<int>     wide_blur = {
+        {1, 2, 1, 2, 1},
+        {0, 1, 3, 1, 0},
+        {1, 2, 1, 2, 1}
+    };
+
+    for (auto boundary : {mvl::Boundary::ZERO, mvl::Boundary::CLAMP, mvl::Boundary::PERIODIC}) {
+        // Tall enough to get split into several temporal blocking bands
+        const mvl::Matrix<int> src(2000, 67, [](std::size_t i, std::size_t j) { return int((i * 7 + j * 13) % 5); });
+
+        mvl::Matrix<int> res, expected = src;
+        mvl::apply_stencil(src, laplace, res, boundary, 3);
+        for (int s = 0; s < 3; ++s) expected = naive_stencil_sweep(expected, laplace, boundary);
+        CHECK(res.compare_contents(expected));
+
+        mvl::apply_stencil(src, wide_blur, res, boundary);
+        CHECK(res.compare_contents(naive_stencil_sweep(src, wide_blur, boundary)));
+
+        // Matrices smaller than the kernel only go through the boundary handling
+        mvl::Matrix<int> tiny = {
+            {1, 2},
+            {3, 4}
+        };
+        const mvl::Matrix<int> tiny_expected = naive_stencil_sweep(tiny, wide_blur, boundary);
+        mvl::apply_stencil(tiny, wide_blur, tiny, boundary); // in-place
+        CHECK(tiny.compare_contents(tiny_expected));
+    }
+
+    // Convolution flips the kernel
+    const mvl::Matrix<int> impulse(5, 5, [](std::size_t i, std::size_t j) { return int(i == 2 && j == 2); });
+    const mvl::Matrix<int> kernel = {
+        {1, 2, 3},
+        {4, 5, 6},
+        {7, 8, 9}
+    };
+    mvl::Matrix<int> res;
+    mvl::convolve(impulse, kernel, res);
+    CHECK(res.block(1, 1, 3, 3).compare_contents(kernel));
+
+    CHECK_THROWS_AS(mvl::apply_stencil(impulse, mvl::Matrix<int>(2, 3), res), std::invalid_argument);
+}
+
+TEST_CASE("Reduced precision types") {
+    // Exactly representable values survive conversion
+    for (float value : {0.f, 1.f, -2.5f, 0.15625f, 1024.f, -4096.f}) {
+        CHECK(float(mvl::float16(value)) == value);
+        CHECK(float(mvl::bfloat16(value)) == value);
+    }
+
+    // Rounding, overflow & special values
+    CHECK(mvl::float16(1.f + 1.f / 4096).bits() == mvl::float16(1.f).bits()); // ties round to even
+    CHECK(mvl::float16(65520.f).bits() == 0x7c00);                             // overflows to infinity
+    CHECK(float(mvl::float16(std::ldexp(1.f, -24))) == std::ldexp(1.f, -24));  // smallest subnormal
+    CHECK(mvl::float16(std::ldexp(1.f, -26)).bits() == 0);                     // underflows to zero
+    CHECK(std::isnan(float(mvl::float16(std::numeric_limits<float>::quiet_NaN()))));
+    CHECK(std::isnan(float(mvl::bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+    CHECK(mvl::bfloat16(1.f + 1.f / 256).bits() == mvl::bfloat16(1.f).bits());
+    CHECK(float(mvl::bfloat16(3e38f)) == doctest::Approx(3e38f).epsilon(0.01));
+
+    // Arithmetic
+    const mvl::bfloat16 a(1.5f), b(2.f);
+    CHECK(float(a + b) == 3.5f);
+    CHECK(float(a * b) == 3.f);
+    CHECK(float(-a) == -1.5f);
+    CHECK(a < b);
+    CHECK(a * 2.f == 3.f);
+
+    // Matrices of reduced precision types with widened kernels
+    mvl::Matrix<mvl::float16>  A(3, 40, [](std::size_t i, std::size_t j) { return mvl::float16(float(i + j) / 8); });
+    mvl::Matrix<mvl::bfloat16> B(40, 2, [](std::size_t i, std::size_t j) { return mvl::bfloat16(float(i) - j); });
+    mvl::Matrix<float>         A_f(3, 40, [&](std::size_t i, std::size_t j) { return float(A(i, j)); });
+    mvl::Matrix<float>         B_f(40, 2, [&](std::size_t i, std::size_t j) { return float(B(i, j)); });
+
+    CHECK(mvl::widened_sum(A) == doctest::Approx(A_f.sum()));
+    CHECK(mvl::widened_gemm(A, B).compare_contents(A_f * B_f));
+
+    const std::vector<float> x(40, 0.5f);
+    const auto               y = mvl::widened_gemv(A, x);
+    for (std::size_t i = 0; i < 3; ++i) CHECK(y[i] == doctest::Approx(A_f.row(i).sum() * 0.5f));
+
+    // Quantization
+    const mvl::Matrix<float> M = {
+        {1.f,  -2.f, 0.5f},
+        {0.f, 1.27f, 2.5f}
+    };
+    const auto Q = mvl::quantize(M);
+    CHECK(Q.scale == doctest::Approx(2.5f / 127));
+    CHECK(Q.values(1, 2) == 127);
+    CHECK(Q.values(0, 1) == -102);
+    Q.dequantize().for_each([&](const float& elem, std::size_t i, std::size_t j) {
+        CHECK(std::abs(elem - M(i, j)) <= Q.scale / 2);
+    });
+
+    const auto y_q = mvl::widened_gemv(Q, std::vector<float>{1.f, 1.f, 1.f});
+    CHECK(y_q[0] == doctest::Approx(-0.5f).epsilon(0.05));
+    CHECK(y_q[1] == doctest::Approx(3.77f).epsilon(0.05));
+}
+
+TEST_CASE("N-dimensional tensors") {
+    // 2x3x4 volume with elements encoding their own indices
+    mvl::NDTensor<int, 3> V({2, 3, 4});
+    V.for_each([](int& elem, const std::array<std::size_t, 3>& idx) {
+        elem = int(100 * idx[0] + 10 * idx[1] + idx[2]);
+    });
+    CHECK(V.size() == 24);
+    CHECK(V.strides() == std::array<std::size_t, 3>{12, 4, 1});
+    CHECK(V(1, 2, 3) == 123);
+
+    // Slices & subranges are views
+    auto plane = V.slice(1, 2); // fixes the middle index
+    CHECK(plane.extents() == std::array<std::size_t, 2>{2, 4});
+    CHECK(plane(1, 3) == 123);
+    plane(0, 0) = -1;
+    CHECK(V(0, 2, 0) == -1);
+
+    const auto sub = V.subrange(2, 1, 2);
+    CHECK(sub.extents() == std::array<std::size_t, 3>{2, 3, 2});
+    CHECK(sub(1, 1, 0) == 111);
+    CHECK(!sub.is_contiguous());
+
+    // Permutation doesn't copy
+    auto P = V.permute({2, 0, 1});
+    CHECK(P.extents() == std::array<std::size_t, 3>{4, 2, 3});
+    CHECK(P(3, 1, 2) == 123);
+    CHECK(P.data() == V.data());
+    std::vector<int> visited;
+    P.slice(0, 1).for_each([&](const int& elem) { visited.push_back(elem); });
+    CHECK(visited == std::vector<int>{1, 11, 21, 101, 111, 121});
+
+    // Reductions
+    const auto S = V.sum(0);
+    CHECK(S.extents() == std::array<std::size_t, 2>{3, 4});
+    CHECK(S(1, 2) == 12 + 112);
+    CHECK(V.reduce(2, 0, [](int l, int r) { return std::max(l, r); })(1, 1) == 113);
+
+    // Contraction matches matrix multiplication
+    mvl::NDTensor<double, 2> A({3, 5}), B({5, 2});
+    A.for_each([](double& elem, const std::array<std::size_t, 2>& idx) { elem = double(idx[0] + 2 * idx[1]); });
+    B.for_each([](double& elem, const std::array<std::size_t, 2>& idx) { elem = double(idx[0]) - double(idx[1]); });
+    const auto C = mvl::contract(A, 1, B, 0);
+    CHECK(C.to_matrix().compare_contents(A.to_matrix() * B.to_matrix()));
+
+    // Contraction of higher rank tensors, 'B' contracted along its second axis
+    mvl::NDTensor<int, 2> W({5, 3});
+    W.for_each([](int& elem, const std::array<std::size_t, 2>& idx) { elem = int(idx[0] * idx[1]) - 1; });
+    const auto D = mvl::contract(V, 1, W, 1); // (2x3x4) x (5x3) => 2x4x5
+    CHECK(D.extents() == std::array<std::size_t, 3>{2, 4, 5});
+    int expected = 0;
+    for (std::size_t k = 0; k < 3; ++k) expected += V(1, k, 3) * W(4, k);
+    CHECK(D(1, 3, 4) == expected);
+
+    // Rank-2 tensors can reuse the 2D API
+    CHECK(plane.matrix_view().compare_contents(plane.to_matrix()));
+    CHECK(A.permute({1, 0}).matrix_view<mvl::Layout::CR>()(4, 2) == A(2, 4));
+    CHECK_THROWS_AS((void)A.permute({1, 0}).matrix_view(), std::invalid_argument);
+    CHECK(mvl::format::as_matrix(A.matrix_view()).find("[ 2 4 6 8 10 ]") != std::string::npos);
+
+    // Argument validation
+    CHECK_THROWS_AS((void)V.slice(3, 0), std::out_of_range);
+    CHECK_THROWS_AS((void)V.subrange(0, 1, 2), std::out_of_range);
+    CHECK_THROWS_AS((void)V.subrange(0, 1, std::size_t(-1)), std::out_of_range); // 'first + count' wraps around
+    CHECK_THROWS_AS((void)V.subrange(0, 3, 0), std::out_of_range);
+    CHECK_THROWS_AS((void)V.permute({0, 0, 1}), std::invalid_argument);
+    CHECK_THROWS_AS((void)mvl::contract(A, 0, B, 0), std::invalid_argument);
+
+    mvl::NDTensor<int, 2, mvl::Ownership::CONTAINER, mvl::Checking::BOUNDS> checked({2, 2});
+    CHECK_THROWS_AS((void)checked(2, 0), std::out_of_range);
+
+    // Moved-from containers are left empty
+    const int* storage = V.data();
+    auto       moved   = std::move(V);
+    CHECK(moved.data() == storage);
+    CHECK(moved(1, 2, 3) == 123);
+    CHECK(V.empty());
+    CHECK(V.size() == 0);
+    CHECK(V.data() == nullptr);
+
+    V = std::move(moved);
+    CHECK(V(1, 2, 3) == 123);
+    CHECK(moved.empty());
+    CHECK(moved.data() == nullptr);
+}
+
+template <class Tensor>
+void check_gemv_and_ger(Tensor&& A) {
+    const std::size_t rows = A.rows(), cols = A.cols();
+
+    std::vector<double> x(cols), y(rows, std::numeric_limits<double>::quiet_NaN());
+    for (std::size_t j = 0; j < cols; ++j) x[j] = double(j % 7) - 3.;
+
+    const auto expected_Ax = [&](std::size_t i) {
+        double sum = 0.;
+        for (std::size_t j = 0; j < cols; ++j) sum += A(i, j) * x[j];
+        return sum;
+    };
+
+    // 'beta == 0' should overwrite 'y' even if it contains NaNs
+    mvl::gemv(2, A, x, 0, y);
+    for (std::size_t i = 0; i < rows; ++i) CHECK(y[i] == 2 * expected_Ax(i));
+
+    std::vector<double> y_old = y;
+    mvl::gemv(1, A, x, -1, y);
+    for (std::size_t i = 0; i < rows; ++i) CHECK(y[i] == expected_Ax(i) - y_old[i]);
+
+    // Rank-1 update
+    const mvl::Matrix<double> A_old(rows, cols, [&](std::size_t i, std::size_t j) { return A(i, j); });
+    std::vector<double>       u(rows);
+    for (std::size_t i = 0; i < rows; ++i) u[i] = double(i);
+    mvl::ger(0.5, u, x, A);
+    for (std::size_t i = 0; i < rows; ++i)
+        for (std::size_t j = 0; j < cols; ++j) CHECK(A(i, j) == A_old(i, j) + 0.5 * u[i] * x[j]);
+}
+
+TEST_CASE("Matrix-vector operations") {
+    const auto init = [](std::size_t i, std::size_t j) { return double((i * 31 + j * 17) % 11); };
+
+    mvl::Matrix<double>                                      A_rc(37, 45, init);
+    mvl::Matrix<double, mvl::Checking::NONE, mvl::Layout::CR> A_cr(37, 45, init);
+    check_gemv_and_ger(A_rc);
+    check_gemv_and_ger(A_cr);
+    check_gemv_and_ger(A_rc.block(3, 5, 20, 30));
+    check_gemv_and_ger(A_cr.block(3, 5, 20, 30));
+
+    // Single-column matrices can be used as vectors
+    mvl::Matrix<double> x(45, 1, 1.), y(37, 1);
+    mvl::gemv(1, A_rc, x, 0, y);
+    CHECK(y(0, 0) == A_rc.row(0).sum());
+
+    std::vector<double> a = {1., 2., 3.}, b = {1., 1., 1.};
+    mvl::axpy(2, a, b);
+    CHECK(b == std::vector<double>{3., 5., 7.});
+
+    std::vector<double> short_vector(2);
+    CHECK_THROWS_AS(mvl::gemv(1, A_rc, short_vector, 0, y), std::invalid_argument);
+    CHECK_THROWS_AS(mvl::axpy(1, a, short_vector), std::invalid_argument);
+}
+
+template <class Tensor>
+void check_eigenpairs(const Tensor& A, const mvl::SymmetricEigen<double>& eigen, double tolerance) {
+    const std::size_t n = A.rows(), count = eigen.values.size();
+
+    for (std::size_t k = 0; k < count; ++k) {
+        // A v = lambda v
+        for (std::size_t i = 0; i < n; ++i) {
+            double Av = 0.;
+            for (std::size_t j = 0; j < n; ++j) Av += A(i, j) * eigen.vectors(j, k);
+            CHECK(Av == doctest::Approx(eigen.values[k] * eigen.vectors(i, k)).epsilon(tolerance).scale(1.));
+        }
+        // V^T V = I
+        for (std::size_t l = 0; l < count; ++l) {
+            double dot = 0.;
+            for (std::size_t i = 0; i < n; ++i) dot += eigen.vectors(i, k) * eigen.vectors(i, l);
+            CHECK(dot == doctest::Approx(k == l ? 1. : 0.).epsilon(tolerance).scale(1.));
+        }
+    }
+}
+
+TEST_CASE("Eigensolvers") {
+    // Dense symmetric matrix
+    const std::size_t   n = 70;
+    mvl::Matrix<double> A(n, n, [](std::size_t i, std::size_t j) {
+        const std::size_t a = std::min(i, j), b = std::max(i, j);
+        return double((a * 37 + b * 11) % 13) - 6.;
+    });
+
+    const auto eigen = mvl::symmetric_eigen(A);
+    REQUIRE(eigen.values.size() == n);
+    CHECK(std::is_sorted(eigen.values.begin(), eigen.values.end()));
+    check_eigenpairs(A, eigen, 1e-9);
+
+    double trace = 0., eigen_sum = 0.;
+    for (std::size_t i = 0; i < n; ++i) trace += A(i, i), eigen_sum += eigen.values[i];
+    CHECK(eigen_sum == doctest::Approx(trace));
+
+    // Several reduction panels with some columns that are already reduced (all zeros below the diagonal)
+    const std::size_t   m = 100;
+    mvl::Matrix<double> P(m, m, [](std::size_t i, std::size_t j) {
+        if (i % 7 == 0 || j % 7 == 0) return i == j ? 2. : 0.;
+        const std::size_t a = std::min(i, j), b = std::max(i, j);
+        return double((a * 17 + b * 5) % 11) - 5.;
+    });
+    check_eigenpairs(P, mvl::symmetric_eigen(P), 1e-9);
+
+    // Diagonal & tiny matrices shouldn't need special handling
+    CHECK(mvl::symmetric_eigen(mvl::Matrix<double>{{3., 0.}, {0., -1.}}).values == std::vector<double>{-1., 3.});
+    CHECK(mvl::symmetric_eigen(mvl::Matrix<double>{{5.}}).values == std::vector<double>{5.});
+
+    // Sparse symmetric matrix with well separated extremal eigenvalues
+    const std::size_t                       N = 300;
+    std::vector<mvl::SparseEntry2D<double>> triplets;
+    for (std::size_t i = 0; i < N; ++i) {
+        triplets.push_back({i, i, double(i) * double(i) / double(N)});
+        if (i + 1 < N) triplets.push_back({i, i + 1, 1.}), triplets.push_back({i + 1, i, 1.});
+    }
+    mvl::SparseMatrix<double> S(N, N, std::move(triplets));
+    mvl::Matrix<double>       S_dense(N, N, 0.);
+    S.for_each([&](double value, std::size_t i, std::size_t j) { S_dense(i, j) = value; });
+
+    const auto reference = mvl::symmetric_eigen(S_dense);
+
+    const auto largest = mvl::lanczos(S, 4);
+    for (std::size_t k = 0; k < 4; ++k) CHECK(largest.values[k] == doctest::Approx(reference.values[N - 1 - k]));
+    check_eigenpairs(S_dense, largest, 1e-8);
+
+    const auto smallest = mvl::lanczos(S_dense, 3, mvl::EigenTarget::SMALLEST, 1e-10, N);
+    for (std::size_t k = 0; k < 3; ++k) CHECK(smallest.values[k] == doctest::Approx(reference.values[k]));
+
+    // Arbitrary operators can be passed as a callable
+    const auto diagonal = mvl::lanczos<double>(N, [](const std::vector<double>& x, std::vector<double>& y) {
+        for (std::size_t i = 0; i < x.size(); ++i) y[i] = double(i) * x[i];
+    }, 2);
+    CHECK(diagonal.values[0] == doctest::Approx(N - 1.));
+    CHECK(diagonal.values[1] == doctest::Approx(N - 2.));
+
+    const mvl::BSRMatrix<double, 2> B(S);
+    CHECK(mvl::lanczos(B, 4).values[0] == doctest::Approx(largest.values[0]));
+
+    CHECK_THROWS_AS((void)mvl::symmetric_eigen(mvl::Matrix<double>(2, 3)), std::invalid_argument);
+    CHECK_THROWS_AS((void)mvl::lanczos(S, N + 1), std::invalid_argument);
+}
+
+TEST_CASE("Buffer pool & preallocated outputs") {
+    const auto init = [](std::size_t i, std::size_t j) { return double(i * 7 + j * 3) / 10.; };
+
+    const mvl::Matrix<double> A(40, 30, init), B(40, 30, 1.), M(30, 20, init);
+
+    // Freed buffers get reused by allocations of the same size class
+    {
+        mvl::BufferPoolScope scope;
+
+        const double* freed = nullptr;
+        {
+            mvl::Matrix<double> temp(40, 30);
+            freed = temp.data();
+        }
+        mvl::Matrix<double> reused(40, 30, 2.);
+        CHECK(reused.data() == freed);
+        CHECK(reused.sum() == 2. * 40 * 30);
+
+        // Time-stepping loop only alternates between pooled buffers
+        mvl::Matrix<double>      C = A + B;
+        std::set<const double*> buffers;
+        for (int step = 0; step < 10; ++step) {
+            C = C + B;
+            buffers.insert(C.data());
+        }
+        CHECK(buffers.size() <= 2);
+        CHECK(C(3, 4) == A(3, 4) + 11.);
+
+        // Non-trivial types are never pooled, default-initialization is preserved
+        { mvl::Matrix<std::string> strings(2, 2, "text"); }
+        CHECK(mvl::Matrix<std::string>(2, 2)(0, 0).empty());
+
+        // Pooled buffers can be freed on other threads
+        mvl::Matrix<double> moved(40, 30, 1.);
+        std::thread([m = std::move(moved)]() mutable { m = mvl::Matrix<double>(); }).join();
+
+        mvl::clear_buffer_pool();
+    }
+    CHECK_FALSE(mvl::buffer_pool_enabled());
+
+    // Copying into a matrix of the same size reuses its buffer
+    mvl::Matrix<double> copy(40, 30);
+    const double*       copy_data = copy.data();
+    copy                          = A;
+    CHECK(copy.data() == copy_data);
+    CHECK(copy.compare_contents(A));
+
+    // Writing into preallocated outputs
+    mvl::Matrix<double> out(40, 30);
+    mvl::assign_into(out, A);
+    CHECK(out.compare_contents(A));
+
+    mvl::apply_unary_op_into(out, A, [](double x) { return 2. * x; });
+    CHECK(out(5, 6) == 2. * A(5, 6));
+
+    mvl::apply_binary_op_into(out, out, B, std::plus<>()); // output can alias element-wise arguments
+    CHECK(out(5, 6) == 2. * A(5, 6) + 1.);
+
+    std::vector<double> external(40 * 20);
+    mvl::multiply_into(mvl::MatrixView<double>(40, 20, external.data()), A, M);
+    CHECK(mvl::MatrixView<double>(40, 20, external.data()).compare_contents(A * M));
+
+    mvl::Matrix<double> wrong_size(3, 3), square(30, 30, init);
+    CHECK_THROWS_AS(mvl::assign_into(wrong_size, A), std::invalid_argument);
+    CHECK_THROWS_AS(mvl::multiply_into(wrong_size, A, M), std::invalid_argument);
+    CHECK_THROWS_AS(mvl::multiply_into(square, square, square), std::invalid_argument);
+}
+
+template <class View>
+std::vector<std::tuple<std::size_t, std::size_t, int>> collect_elements(const View& view) {
+    std::vector<std::tuple<std::size_t, std::size_t, int>> elements;
+    view.for_each([&](const int& elem, std::size_t i, std::size_t j) { elements.emplace_back(i, j, elem); });
+    std::sort(elements.begin(), elements.end());
+    return elements;
+}
+
+template <class Tensor>
+void check_lazy_views(Tensor& tensor) {
+    const auto even       = [](const int& elem) { return elem % 2 == 0; };
+    const auto upper      = [](const int&, std::size_t i, std::size_t j) { return i <= j; };
+    const auto even_upper = [&](const int& elem, std::size_t i, std::size_t j) {
+        return even(elem) && upper(elem, i, j);
+    };
+
+    CHECK(collect_elements(tensor.lazy_filter(even)) == collect_elements(tensor.filter(even)));
+    CHECK(collect_elements(tensor.lazy_filter(even).filter(upper)) == collect_elements(tensor.filter(even_upper)));
+    CHECK(collect_elements(tensor.lazy_diagonal()) == collect_elements(tensor.diagonal()));
+    CHECK(collect_elements(tensor.lazy_block(2, 1, 4, 3)) == collect_elements(tensor.block(2, 1, 4, 3)));
+    CHECK(collect_elements(tensor.lazy_block(1, 2, 5, 4).filter(even)) ==
+          collect_elements(tensor.block(1, 2, 5, 4).filter(even)));
+
+    CHECK(tensor.lazy_filter(even).count() == tensor.filter(even).size());
+    CHECK(tensor.lazy_diagonal().sum() == tensor.diagonal().sum());
+    CHECK(tensor.lazy_block(2, 1, 4, 3).rows() == 4);
+    CHECK(tensor.lazy_block(2, 1, 4, 3).cols() == 3);
+
+    // Blocks that don't fit into the tensor are rejected
+    CHECK(tensor.lazy_block(0, 0, tensor.rows(), tensor.cols()).count() == tensor.size());
+    CHECK_THROWS_AS((void)tensor.lazy_block(4, 0, tensor.rows(), 1), std::out_of_range);
+    CHECK_THROWS_AS((void)tensor.lazy_block(0, 1, 1, tensor.cols()), std::out_of_range);
+    CHECK_THROWS_AS((void)tensor.lazy_block(tensor.rows() + 1, 0, 0, 0), std::out_of_range);
+
+    // Mutable views write into the original tensor
+    tensor.lazy_block(1, 1, 3, 3).filter(even).fill(-1);
+    CHECK(tensor.block(1, 1, 3, 3).filter(even).size() == 0);
+}
+
+TEST_CASE("Lazy views") {
+    const auto init = [](std::size_t i, std::size_t j) { return int((i * 5 + j * 3) % 7); };
+
+    mvl::Matrix<int>                                      dense_rc(7, 6, init);
+    mvl::Matrix<int, mvl::Checking::NONE, mvl::Layout::CR> dense_cr(7, 6, init);
+    mvl::Matrix<int>                                      parent(9, 8, init);
+    auto                                                  strided = parent.block(1, 1, 7, 6);
+
+    std::vector<mvl::SparseEntry2D<int>> triplets;
+    for (std::size_t i = 0; i < 7; ++i)
+        for (std::size_t j = 0; j < 6; ++j)
+            if ((i + 2 * j) % 3 != 0) triplets.push_back({i, j, init(i, j) + 1});
+    mvl::SparseMatrix<int> sparse(7, 6, triplets);
+
+    check_lazy_views(dense_rc);
+    check_lazy_views(dense_cr);
+    check_lazy_views(strided);
+    check_lazy_views(sparse);
+
+    // Views of views & const views
+    const mvl::SparseMatrix<int> const_sparse(7, 6, triplets);
+    CHECK(collect_elements(const_sparse.lazy_block(1, 1, 4, 4)) == collect_elements(const_sparse.block(1, 1, 4, 4)));
+    CHECK(collect_elements(sparse.filter([](const int&) { return true; }).lazy_diagonal()) ==
+          collect_elements(sparse.diagonal()));
+
+    // CSR matrices only visit rows inside the bounds
+    const mvl::CSRMatrix<int> csr(const_sparse);
+    CHECK(collect_elements(csr.lazy_block(2, 1, 4, 3)) == collect_elements(const_sparse.block(2, 1, 4, 3)));
+    CHECK(collect_elements(csr.lazy_diagonal()) == collect_elements(const_sparse.diagonal()));
+    CHECK_THROWS_AS((void)csr.lazy_block(2, 1, 6, 3), std::out_of_range);
+    CHECK(collect_elements(csr.lazy_filter([](const int& elem) { return elem > 3; })) ==
+          collect_elements(const_sparse.filter([](const int& elem) { return elem > 3; })));
+
+    // Materialization
+    const auto copy = sparse.lazy_block(0, 0, 3, 3).to_sparse();
+    CHECK(copy.rows() == 3);
+    CHECK(collect_elements(copy) == collect_elements(sparse.block(0, 0, 3, 3)));
+}
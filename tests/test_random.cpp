@@ -11,10 +11,15 @@
 
 #include <algorithm>   // PRNG sanity tests
 #include <array>       // PRNG sanity tests
+#include <cmath>       // bulk generation tests, quasi-random sequence tests
 #include <cstddef>     // PRNG sanity tests
 #include <cstdint>     // PRNG sanity tests
+#include <limits>      // sampling tests
+#include <map>         // sampling tests
 #include <numeric>     // PRNG sanity tests
 #include <random>      // PRNG sanity tests
+#include <thread>      // parallel stream tests
+#include <tuple>       // ziggurat tests
 #include <type_traits> // PRNG sanity tests
 #include <vector>      // PRNG sanity tests
 
@@ -156,7 +161,9 @@ TEST_CASE_TEMPLATE("Uniform int distribution covers whole interval for every PRN
                    random::generators::Xoshiro128PP,                                     //
                    random::generators::RomuDuoJr64,                                      //
                    random::generators::SplitMix64,                                       //
-                   random::generators::Xoshiro256PP                                      //
+                   random::generators::Xoshiro256PP,                                     //
+                   random::generators::Philox4x32,                                       //
+                   random::generators::Threefry2x64                                      //
 ) {
     random::generators::SplitMix32 gen;
 
@@ -236,4 +243,825 @@ TEST_CASE("Uniform distribution mean/min/max are sensible for every generator")
     // a "good" PRNG would be expected to pass (or at least mostly pass) TestU01 Big Crush,
     // however it is a task for PRNG designers, here we merely implement well known algorithms
     // and check that their implementation wasn't accidentaly broken.
-}
\ No newline at end of file
+}
+
+// ========================
+// --- Parallel streams ---
+// ========================
+
+TEST_CASE("Xoshiro jumps match known values") {
+    // reference values were computed independently by raising the state transition matrix over GF(2)
+    // to the power of 2^128 / 2^192 (2^64 / 2^96 for 'Xoshiro128PP') and applying it to the seeded state
+    random::generators::Xoshiro256PP gen_256{42};
+    gen_256.jump();
+    CHECK(gen_256() == 0xc0b6f4be293b1ae5);
+    CHECK(gen_256() == 0x5db3dd9683e7bb33);
+
+    gen_256.seed(42);
+    gen_256.long_jump();
+    CHECK(gen_256() == 0x02019a87bfc0bb07);
+
+    random::generators::Xoshiro128PP gen_128{42};
+    gen_128.jump();
+    CHECK(gen_128() == 0x3053bfb2);
+    CHECK(gen_128() == 0xbbadc2ee);
+
+    gen_128.seed(42);
+    gen_128.long_jump();
+    CHECK(gen_128() == 0x4a1cb820);
+
+    // jumps should commute with regular generation
+    random::generators::Xoshiro256PP jump_first{17}, jump_last{17};
+    jump_first.jump();
+    for (int i = 0; i < 100; ++i) jump_first(), jump_last();
+    jump_last.jump();
+    CHECK(jump_first() == jump_last());
+}
+
+TEST_CASE("ChaCha counter & nonce") {
+    random::generators::ChaCha20 reference{42}, gen{42};
+
+    // setting the counter skips whole blocks
+    for (int i = 0; i < 16 * 5; ++i) reference();
+    gen.set_counter(5);
+    CHECK(gen.get_counter() == 5);
+    for (int i = 0; i < 40; ++i) FAST_CHECK(gen() == reference());
+
+    // different nonces produce unrelated streams, same nonce restarts the stream
+    random::generators::ChaCha20 first{42}, second{42};
+    const auto                   first_value = first();
+    second.set_nonce(first.get_nonce());
+    CHECK(second() == first_value);
+    auto nonce = second.get_nonce();
+    ++nonce[0];
+    second.set_nonce(nonce);
+    CHECK(second() != first_value);
+
+    // streams of ChaCha offset the nonce
+    const auto stream = random::make_stream(random::generators::ChaCha20{42}, 3);
+    CHECK(stream.get_nonce()[0] == random::generators::ChaCha20{42}.get_nonce()[0] + 3);
+}
+
+TEST_CASE("Counter-based generators match known values") {
+    using namespace random::generators;
+
+    // Known-answer tests from the reference implementation (Random123)
+    Philox4x32 philox_zero({0, 0}, {0, 0, 0, 0});
+    CHECK(philox_zero() == 0x6627e8d5);
+    CHECK(philox_zero() == 0xe169c58d);
+    CHECK(philox_zero() == 0xbc57ac4c);
+    CHECK(philox_zero() == 0x9b00dbd8);
+
+    Philox4x32 philox_ones({0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff});
+    CHECK(philox_ones() == 0x408f276d);
+    CHECK(philox_ones() == 0x41c83b0e);
+    CHECK(philox_ones() == 0xa20bc7c6);
+    CHECK(philox_ones() == 0x6d5451fd);
+
+    Philox4x32 philox_pi({0xa4093822, 0x299f31d0}, {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344});
+    CHECK(philox_pi() == 0xd16cfe09);
+    CHECK(philox_pi() == 0x94fdcceb);
+    CHECK(philox_pi() == 0x5001e420);
+    CHECK(philox_pi() == 0x24126ea1);
+
+    Threefry2x64 threefry_zero({0, 0}, {0, 0});
+    CHECK(threefry_zero() == 0xc2b6e3a8c2c69865);
+    CHECK(threefry_zero() == 0x6f81ed42f350084d);
+
+    Threefry2x64 threefry_pi({0xa4093822299f31d0, 0x082efa98ec4e6c89}, {0x243f6a8885a308d3, 0x13198a2e03707344});
+    CHECK(threefry_pi() == 0x263c7d30bb0f0af1);
+    CHECK(threefry_pi() == 0x56be8361d3311526);
+
+    // key constructors are explicit, same as seed constructors
+    static_assert(!std::is_convertible_v<Philox4x32::key_type, Philox4x32>);
+    static_assert(!std::is_convertible_v<Threefry2x64::key_type, Threefry2x64>);
+}
+
+template <class Gen>
+void check_random_access(Gen gen) {
+    Gen reference = gen;
+
+    // 'discard()' is the same as repeated calls, including partial blocks and carries across counter words
+    for (unsigned long long n : {0ull, 1ull, 2ull, 3ull, 7ull, 100ull, 12345ull}) {
+        for (unsigned long long i = 0; i < n; ++i) reference();
+        gen.discard(n);
+        CHECK(gen.get_counter() == reference.get_counter());
+        CHECK(gen() == reference());
+    }
+
+    // counter can be moved anywhere, moving it back reproduces the sequence
+    auto counter = gen.get_counter();
+    counter[0]   = nlim<typename Gen::result_type>::max() - 1; // soon carries into the second word
+    gen.set_counter(counter);
+    const auto first = gen(), second = gen();
+    for (int i = 0; i < 10; ++i) gen();
+    gen.set_counter(counter);
+    CHECK(gen() == first);
+    CHECK(gen() == second);
+
+    // streams offset the upper half of the counter
+    const auto stream = random::make_stream(Gen{42}, 3);
+    CHECK(stream.get_key() == Gen{42}.get_key());
+    CHECK(stream.get_counter()[stream.get_counter().size() / 2] == 3);
+}
+
+TEST_CASE("Counter-based generators allow random access") {
+    check_random_access(random::generators::Philox4x32{17});
+    check_random_access(random::generators::Threefry2x64{17});
+
+    // derive a stream from (seed, particle, step) without any sequential state
+    random::generators::Philox4x32 gen(random::generators::Philox4x32{42}.get_key(), {0, 0, 17, 5});
+    random::generators::Philox4x32 same(gen.get_key(), {0, 0, 17, 5}), other(gen.get_key(), {0, 0, 17, 6});
+    const auto value = gen();
+    CHECK(same() == value);
+    CHECK(other() != value);
+}
+
+TEST_CASE("Thread-local streams are reproducible") {
+    using gen_type = random::default_generator_type;
+
+    constexpr std::uint64_t seed         = 123;
+    constexpr std::size_t   thread_count = 4;
+    constexpr std::size_t   sample       = 1000;
+
+    // main thread behaves exactly like 'default_generator' seeded the old way
+    random::seed(seed);
+    gen_type                                  reference{seed};
+    const random::UniformIntDistribution<int> dist{0, 1000};
+    for (std::size_t i = 0; i < sample; ++i) FAST_CHECK(random::rand_int(0, 1000) == dist(reference));
+    CHECK(random::thread_stream_index() == 0);
+
+    // other threads get independent streams with explicitly set indices
+    const auto run_threads = [&] {
+        random::seed(seed);
+        std::vector<std::vector<gen_type::result_type>> results(thread_count);
+        std::vector<std::thread>                        threads;
+        for (std::size_t t = 0; t < thread_count; ++t)
+            threads.emplace_back([&, t] {
+                random::set_thread_stream(t + 1);
+                for (std::size_t i = 0; i < sample; ++i) results[t].push_back(random::thread_generator()());
+            });
+        for (auto& thread : threads) thread.join();
+        return results;
+    };
+
+    const auto first  = run_threads();
+    const auto second = run_threads();
+    CHECK(first == second);
+
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        auto stream = random::make_stream(gen_type{seed}, t + 1);
+        for (std::size_t i = 0; i < sample; ++i) FAST_CHECK(first[t][i] == stream());
+    }
+    CHECK(first[0] != first[1]);
+
+    // stream 0 on a worker thread is a private copy, 'default_generator' of the main thread stays untouched
+    random::seed(seed);
+    std::vector<gen_type::result_type> worker_values;
+    std::thread                        worker([&] {
+        random::set_thread_stream(0);
+        for (std::size_t i = 0; i < sample; ++i) worker_values.push_back(random::thread_generator()());
+        FAST_CHECK(&random::thread_generator() != &random::default_generator);
+    });
+    worker.join();
+    gen_type copy{seed};
+    for (std::size_t i = 0; i < sample; ++i) FAST_CHECK(worker_values[i] == copy());
+    CHECK(random::default_generator() == worker_values.front());
+
+    // threads without explicit indices get unique ones
+    std::vector<std::uint64_t> indices(thread_count);
+    std::vector<std::thread>   threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+        threads.emplace_back([&, t] { indices[t] = random::thread_stream_index(); });
+    for (auto& thread : threads) thread.join();
+    std::sort(indices.begin(), indices.end());
+    CHECK(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+    CHECK(indices.front() > 0);
+}
+
+// =======================
+// --- Bulk generation ---
+// =======================
+
+template <class Gen>
+void check_fill_matches_repeated_calls(Gen gen) {
+    Gen reference = gen;
+
+    // odd sizes leave partially used blocks behind, which should be continued properly
+    for (std::size_t size : {3, 1, 0, 77, 16, 129, 1000, 5}) {
+        std::vector<typename Gen::result_type> bulk(size);
+        random::fill(gen, bulk.begin(), bulk.end());
+        for (const auto& value : bulk) FAST_CHECK(value == reference());
+    }
+    CHECK(gen() == reference());
+}
+
+TEST_CASE_TEMPLATE("Bulk generation matches repeated calls", Gen, //
+                   random::generators::SplitMix64,                //
+                   random::generators::Xoshiro128PPx4,            //
+                   random::generators::Xoshiro128PPx8,            //
+                   random::generators::Xoshiro256PPx4,            //
+                   random::generators::Xoshiro256PPx8,            //
+                   random::generators::ChaCha8,                   //
+                   random::generators::ChaCha20,                  //
+                   random::generators::Philox4x32,                //
+                   random::generators::Threefry2x64               //
+) {
+    check_fill_matches_repeated_calls(Gen{17});
+}
+
+TEST_CASE("Multi-block ChaCha matches scalar generation for any block count") {
+    random::generators::ChaCha12 reference{5}, gen_1{5}, gen_3{5}, gen_8{5};
+    std::vector<std::uint32_t>   values_1(500), values_3(500), values_8(500);
+    reference();
+    gen_1(), gen_3(), gen_8(); // start from the middle of a block
+    gen_1.fill<1>(values_1.begin(), values_1.end());
+    gen_3.fill<3>(values_3.begin(), values_3.end());
+    gen_8.fill<8>(values_8.begin(), values_8.end());
+    for (std::size_t i = 0; i < values_1.size(); ++i) {
+        const auto expected = reference();
+        FAST_CHECK(values_1[i] == expected);
+        FAST_CHECK(values_3[i] == expected);
+        FAST_CHECK(values_8[i] == expected);
+    }
+}
+
+TEST_CASE_TEMPLATE("Lanes of multi-lane generators are independent streams", Gen, //
+                   random::generators::Xoshiro128PPx4,                            //
+                   random::generators::Xoshiro256PPx8                             //
+) {
+    using scalar_type = std::conditional_t<std::is_same_v<typename Gen::result_type, std::uint32_t>,
+                                           random::generators::Xoshiro128PP, random::generators::Xoshiro256PP>;
+    constexpr std::size_t lanes = std::is_same_v<Gen, random::generators::Xoshiro128PPx4> ? 4 : 8;
+
+    Gen                      gen{42};
+    std::vector<scalar_type> streams;
+    for (std::size_t k = 0; k < lanes; ++k) streams.push_back(random::make_stream(scalar_type{42}, k));
+
+    for (std::size_t i = 0; i < 100; ++i)
+        for (auto& stream : streams) FAST_CHECK(gen() == stream());
+}
+
+template <class Dist, class Gen>
+void check_distribution_fill(const Dist& dist, Gen gen) {
+    Gen reference = gen;
+
+    std::vector<typename Dist::result_type> bulk(1000);
+    dist.fill(gen, bulk.begin(), bulk.end());
+    for (const auto& value : bulk) FAST_CHECK(value == dist(reference));
+    CHECK(gen() == reference()); // same amount of generator output was used
+}
+
+TEST_CASE("Bulk distributions match repeated calls") {
+    using namespace random::generators;
+
+    check_distribution_fill(random::UniformIntDistribution<int>{-7, 1000}, Xoshiro256PPx4{1});
+    check_distribution_fill(random::UniformIntDistribution<std::uint64_t>{3, (1ull << 63) + 5}, Xoshiro256PP{2});
+    check_distribution_fill(random::UniformIntDistribution<std::uint64_t>{0, 1ull << 40}, Xoshiro128PPx8{3});
+    check_distribution_fill(random::UniformIntDistribution<std::int8_t>{-100, 100}, ChaCha8{4});
+    check_distribution_fill(random::UniformRealDistribution<double>{-2., 3.}, Xoshiro256PPx8{5});
+    check_distribution_fill(random::UniformRealDistribution<double>{0., 1.}, Xoshiro128PPx4{6});
+    check_distribution_fill(random::UniformRealDistribution<float>{-1.f, 1.f}, RomuTrio32{7});
+    check_distribution_fill(random::NormalDistribution<double>{2., 3.}, Xoshiro256PPx8{8});
+    check_distribution_fill(random::NormalDistribution<float>{}, Xoshiro128PP{9});
+    check_distribution_fill(random::ExponentialDistribution<double>{0.5}, ChaCha12{10});
+    check_distribution_fill(random::DiscreteDistribution<int>{1., 0., 3., 2., 4.}, Xoshiro256PPx4{11});
+}
+
+// --- Ziggurat distributions ---
+// -------------------------------
+
+TEST_CASE("Constexpr math matches <cmath>") {
+    static_assert(random::_exp(0.) == 1.);
+    static_assert(random::_log(1.) == 0.);
+    static_assert(random::_sqrt(4.) == 2.);
+
+    for (double x = -740.; x < 700.; x += 0.37)
+        FAST_CHECK(random::_exp(x) == doctest::Approx(std::exp(x)).epsilon(1e-14));
+    for (double x = 1e-300; x < 1e300; x *= 3.7)
+        FAST_CHECK(random::_log(x) == doctest::Approx(std::log(x)).epsilon(1e-14));
+    for (double x = 1e-300; x < 1e300; x *= 3.7)
+        FAST_CHECK(random::_sqrt(x) == doctest::Approx(std::sqrt(x)).epsilon(1e-15));
+    for (double x = 1e-300; x < 0.5; x *= 3.7) {
+        FAST_CHECK(random::_log1p(x) == doctest::Approx(std::log1p(x)).epsilon(1e-14));
+        FAST_CHECK(random::_log1p(-x) == doctest::Approx(std::log1p(-x)).epsilon(1e-14));
+    }
+}
+
+template <class Table, class Density>
+void check_ziggurat_table(const Table& table, double r, double v, Density density) {
+    constexpr std::size_t layers = std::tuple_size_v<decltype(table.r)>;
+
+    CHECK(table.x[1] == r);
+    CHECK(table.x[layers] == 0.);
+    CHECK(std::is_sorted(table.x.rbegin(), table.x.rend()));
+
+    // every layer above the base has the same area 'v', the last one closes the ziggurat at the peak
+    for (std::size_t i = 1; i < layers; ++i)
+        FAST_CHECK(table.x[i] * (density(table.x[i + 1]) - density(table.x[i])) == doctest::Approx(v).epsilon(1e-6));
+}
+
+TEST_CASE("Ziggurat tables are consistent") {
+    check_ziggurat_table(random::_ziggurat_normal, random::_ziggurat_normal_r, random::_ziggurat_normal_v,
+                         [](double x) { return std::exp(-0.5 * x * x); });
+    check_ziggurat_table(random::_ziggurat_exponential, random::_ziggurat_exponential_r,
+                         random::_ziggurat_exponential_v, [](double x) { return std::exp(-x); });
+}
+
+// Kolmogorov-Smirnov statistic, for 'n > 35' and 1% significance level critical value is '1.63 / sqrt(n)'
+template <class Cdf>
+double ks_statistic(std::vector<double> values, Cdf cdf) {
+    std::sort(values.begin(), values.end());
+
+    const double n = values.size();
+    double       d = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const double f = cdf(values[i]);
+        d              = std::max({d, f - i / n, (i + 1) / n - f});
+    }
+    return d;
+}
+
+TEST_CASE("Ziggurat normal distribution") {
+    random::generators::Xoshiro256PPx8 gen{8};
+
+    const random::NormalDistribution<double> dist{2., 3.};
+    std::vector<double>                      values(200'000);
+    dist.fill(gen, values.begin(), values.end());
+
+    const double mean     = vec_mean(values);
+    double       variance = 0;
+    for (const auto& e : values) variance += (e - mean) * (e - mean);
+    variance /= values.size();
+
+    CHECK(mean == doctest::Approx(2.).epsilon(2e-2));
+    CHECK(variance == doctest::Approx(9.).epsilon(2e-2));
+    CHECK(std::all_of(values.begin(), values.end(), [](double e) { return std::isfinite(e); }));
+
+    const auto cdf = [](double x) { return 0.5 * std::erfc(-(x - 2.) / (3. * std::sqrt(2.))); };
+    CHECK(ks_statistic(values, cdf) < 1.63 / std::sqrt(values.size()));
+
+    // tails past 'r' standard deviations are expected to hold ~0.0576% of the samples
+    const auto tail_count = std::count_if(values.begin(), values.end(), [&](double e) {
+        return std::abs(e - 2.) > 3. * random::_ziggurat_normal_r;
+    });
+    CHECK(tail_count > 70);
+    CHECK(tail_count < 160);
+
+    // parameters are only accessible through 'params()' / 'param()'
+    random::NormalDistribution<double> other;
+    other.param(dist.params());
+    CHECK(other == dist);
+    CHECK(other.param().stddev == 3.);
+}
+
+TEST_CASE("Ziggurat exponential distribution") {
+    random::generators::Xoshiro256PP gen{9};
+
+    const random::ExponentialDistribution<double> dist{4.};
+    std::vector<double>                           values(200'000);
+    dist.fill(gen, values.begin(), values.end());
+
+    CHECK(vec_mean(values) == doctest::Approx(0.25).epsilon(2e-2));
+    CHECK(std::all_of(values.begin(), values.end(), [](double e) { return e >= 0. && std::isfinite(e); }));
+
+    const auto cdf = [](double x) { return 1. - std::exp(-4. * x); };
+    CHECK(ks_statistic(values, cdf) < 1.63 / std::sqrt(values.size()));
+
+    // tail past 'r / lambda' is expected to hold ~0.0454% of the samples
+    const auto tail_count = std::count_if(values.begin(), values.end(), [&](double e) {
+        return e > random::_ziggurat_exponential_r / 4.;
+    });
+    CHECK(tail_count > 50);
+    CHECK(tail_count < 150);
+
+    random::ExponentialDistribution<double> other;
+    other.param(dist.params());
+    CHECK(other == dist);
+    CHECK(other.param().lambda == 4.);
+}
+
+TEST_CASE("Ziggurat distributions produce same sequences on every platform") {
+    random::generators::Xoshiro256PP gen{42};
+
+    const random::NormalDistribution<double>      normal;
+    const random::ExponentialDistribution<double> exponential;
+
+    CHECK(normal(gen) == 1.2845786662803249);
+    CHECK(normal(gen) == -0.85729222837161301);
+    CHECK(exponential(gen) == 1.4997507741445306);
+    CHECK(exponential(gen) == 0.72593717039127648);
+}
+
+// --- Discrete distribution ---
+// -----------------------------
+
+TEST_CASE("Discrete distribution matches its weights") {
+    random::generators::Xoshiro256PP gen{10};
+
+    const std::vector<double>               weights = {1., 0., 3., 2., 4., 0.5};
+    const random::DiscreteDistribution<int> dist(weights.begin(), weights.end());
+
+    CHECK(dist.min() == 0);
+    CHECK(dist.max() == 5);
+
+    constexpr std::size_t    n = 1'000'000;
+    std::vector<std::size_t> counts(weights.size());
+    for (std::size_t i = 0; i < n; ++i) ++counts.at(dist(gen));
+
+    const auto probabilities = dist.probabilities();
+    CHECK(counts[1] == 0);
+    for (std::size_t i = 0; i < weights.size(); ++i)
+        CHECK(static_cast<double>(counts[i]) / n == doctest::Approx(probabilities[i]).epsilon(1e-2));
+}
+
+TEST_CASE("Discrete distribution handles many categories") {
+    random::generators::Xoshiro256PP gen{11};
+
+    // weights 'i + 1' have a known mean index of '(2n + 1) / 3 - 1'
+    constexpr std::size_t categories = 100'000;
+    std::vector<double>   weights(categories);
+    for (std::size_t i = 0; i < categories; ++i) weights[i] = i + 1.;
+
+    const random::DiscreteDistribution<int> dist(weights.begin(), weights.end());
+
+    std::vector<double> values(1'000'000);
+    dist.fill(gen, values.begin(), values.end());
+
+    CHECK(vec_mean(values) == doctest::Approx((2. * categories + 1.) / 3. - 1.).epsilon(1e-2));
+    CHECK(*std::min_element(values.begin(), values.end()) >= 0);
+    CHECK(*std::max_element(values.begin(), values.end()) < categories);
+}
+
+TEST_CASE("Discrete distribution rebuild matches fresh construction") {
+    random::DiscreteDistribution<int> dist{1., 2., 3., 4.};
+
+    dist.set_weight(0, 5.);
+    dist.set_weight(3, 0.);
+    dist.rebuild();
+    CHECK(dist == random::DiscreteDistribution<int>{5., 2., 3., 0.});
+
+    random::generators::Xoshiro256PP        gen{12}, reference{12};
+    const random::DiscreteDistribution<int> fresh{5., 2., 3., 0.};
+    for (int i = 0; i < 1000; ++i) FAST_CHECK(dist(gen) == fresh(reference));
+
+    const std::vector<double> weights = {0., 0., 1.};
+    dist.rebuild(weights.begin(), weights.end());
+    CHECK(dist.size() == 3);
+    for (int i = 0; i < 1000; ++i) FAST_CHECK(dist(gen) == 2);
+}
+
+// --- Parallel generation ---
+// ---------------------------
+
+TEST_CASE("Parallel fill doesn't depend on the number of threads") {
+    const random::NormalDistribution<double> dist{1., 2.};
+
+    std::vector<double> reference(100'000);
+    random::parallel_fill(reference.begin(), reference.end(), dist, 42, 1);
+
+    for (std::size_t threads : {2, 3, 7, 16}) {
+        std::vector<double> values(reference.size());
+        random::parallel_fill(values.begin(), values.end(), dist, 42, threads);
+        CHECK(values == reference);
+    }
+
+    // chunks of arbitrary size & alignment
+    std::vector<double> values(reference.size());
+    for (std::size_t low = 0, size = 1; low < values.size(); low += size, size = size * 3 + 1) {
+        const std::size_t high = std::min(low + size, values.size());
+        random::fill_chunk(values.begin() + low, values.begin() + high, dist, 42, low);
+    }
+    CHECK(values == reference);
+
+    // different seeds give different values
+    random::parallel_fill(values.begin(), values.end(), dist, 43);
+    CHECK(values != reference);
+}
+
+TEST_CASE("Parallel fill works with any O(1)-splittable generator & distribution") {
+    const auto check = [](const auto& dist, const auto& master) {
+        using value_type = typename std::decay_t<decltype(dist)>::result_type;
+
+        std::vector<value_type> reference(20'000), values(reference.size());
+        random::parallel_fill(reference.begin(), reference.end(), dist, master, 1);
+        random::parallel_fill(values.begin(), values.end(), dist, master, 5);
+        CHECK(values == reference);
+
+        random::fill_chunk(values.begin(), values.begin() + 5000, dist, master, 0);
+        random::fill_chunk(values.begin() + 5000, values.end(), dist, master, 5000);
+        CHECK(values == reference);
+    };
+
+    check(random::UniformIntDistribution<int>{0, 100}, random::generators::ChaCha8{1});
+    check(random::ExponentialDistribution<float>{2.f}, random::generators::Threefry2x64{2});
+    check(std::normal_distribution<double>{}, random::generators::Philox4x32{3}); // caches every other value
+}
+
+// --- Sampling ---
+// ----------------
+
+template <class Shuffle>
+void check_shuffle_is_uniform(Shuffle&& shuffle) {
+    // all 24 permutations of 4 elements should be equally likely
+    constexpr int trials = 240'000;
+
+    std::map<std::vector<int>, int> counts;
+    for (int i = 0; i < trials; ++i) {
+        std::vector<int> values = {0, 1, 2, 3};
+        shuffle(values, i);
+        ++counts[values];
+    }
+
+    CHECK(counts.size() == 24);
+    for (const auto& [permutation, count] : counts) CHECK(count == doctest::Approx(trials / 24).epsilon(0.05));
+}
+
+TEST_CASE("Shuffle produces uniformly distributed permutations") {
+    random::generators::Xoshiro256PP gen{13};
+    check_shuffle_is_uniform([&](std::vector<int>& values, int) {
+        random::shuffle(values.begin(), values.end(), gen);
+    });
+
+    // every batch size is used for larger ranges
+    std::vector<std::uint32_t> values(1'000'000);
+    std::iota(values.begin(), values.end(), 0);
+    random::shuffle(values.begin(), values.end(), gen);
+    CHECK(!std::is_sorted(values.begin(), values.end()));
+    std::sort(values.begin(), values.end());
+    for (std::size_t i = 0; i < values.size(); ++i) FAST_CHECK(values[i] == i);
+}
+
+TEST_CASE("Parallel shuffle doesn't depend on the number of threads") {
+    // merge steps are uniform too, tiny blocks make sure they get exercised
+    const random::generators::Philox4x32 master{14};
+    check_shuffle_is_uniform([&](std::vector<int>& values, int i) {
+        random::_merge_shuffle(values.begin(), values.end(), random::make_stream(master, 1000 * i), 1, 1);
+    });
+
+    std::vector<std::uint32_t> reference(300'000);
+    std::iota(reference.begin(), reference.end(), 0);
+    random::parallel_shuffle(reference.begin(), reference.end(), 42, 1);
+
+    for (std::size_t threads : {2, 3, 8}) {
+        std::vector<std::uint32_t> values(reference.size());
+        std::iota(values.begin(), values.end(), 0);
+        random::parallel_shuffle(values.begin(), values.end(), 42, threads);
+        CHECK(values == reference);
+    }
+
+    std::sort(reference.begin(), reference.end());
+    for (std::size_t i = 0; i < reference.size(); ++i) FAST_CHECK(reference[i] == i);
+}
+
+TEST_CASE("Sampling without replacement") {
+    random::generators::Xoshiro256PP gen{15};
+
+    // both sparse (hash set) and dense (bitmap) paths give distinct indices, each equally likely to be included
+    for (std::size_t k : {3, 30}) {
+        constexpr std::size_t n = 40, trials = 20'000;
+
+        std::vector<std::size_t> counts(n);
+        for (std::size_t i = 0; i < trials; ++i) {
+            auto indices = random::sample_indices(n, k, gen);
+            FAST_CHECK(indices.size() == k);
+
+            std::sort(indices.begin(), indices.end());
+            FAST_CHECK(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+            for (const auto& index : indices) ++counts.at(index);
+        }
+
+        for (const auto& count : counts) CHECK(count == doctest::Approx(double(trials) * k / n).epsilon(0.1));
+    }
+
+    // 'sample()' preserves relative order of the elements
+    std::vector<int> values(1000), sample(100);
+    std::iota(values.begin(), values.end(), 0);
+    CHECK(random::sample(values.begin(), values.end(), sample.begin(), 100, gen) == sample.end());
+    CHECK(std::is_sorted(sample.begin(), sample.end()));
+    CHECK(std::adjacent_find(sample.begin(), sample.end()) == sample.end());
+}
+
+TEST_CASE("Reservoir sampling") {
+    random::generators::Xoshiro256PP gen{16};
+
+    constexpr int n = 50, k = 5, trials = 40'000;
+
+    std::vector<int> counts(n), weighted_counts(n);
+    for (int i = 0; i < trials; ++i) {
+        random::ReservoirSampler<int> sampler(k);
+        for (int value = 0; value < n; ++value) sampler.push(value, gen);
+        for (const auto& value : sampler.values()) ++counts.at(value);
+
+        // with a single slot weighted sampling picks values proportionally to their weights
+        random::WeightedReservoirSampler<int> weighted_sampler(1);
+        for (int value = 0; value < n; ++value) weighted_sampler.push(value, value + 1., gen);
+        for (const auto& value : weighted_sampler.values()) ++weighted_counts.at(value);
+
+        FAST_CHECK(sampler.count() == n);
+    }
+
+    for (const auto& count : counts) CHECK(count == doctest::Approx(double(trials) * k / n).epsilon(0.1));
+
+    const double total_weight = n * (n + 1) / 2.;
+    for (int value = n / 2; value < n; ++value)
+        CHECK(weighted_counts[value] == doctest::Approx(trials * (value + 1) / total_weight).epsilon(0.2));
+
+    // long streams only draw random numbers for the replacements
+    random::ReservoirSampler<int> sampler(10);
+    for (int value = 0; value < 1'000'000; ++value) sampler.push(value, gen);
+    CHECK(sampler.values().size() == 10);
+    CHECK(*std::max_element(sampler.values().begin(), sampler.values().end()) > 100'000);
+
+    // tiny 'w' (very long streams) gives huge but finite skips, '1 - w' rounding to 1 used to make them infinite
+    constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    CHECK(random::_reservoir_skip(0.25, 0.5, max) == 2);
+    CHECK(double(random::_reservoir_skip(0.5, 1e-17, max)) == doctest::Approx(std::log(2.) * 1e17).epsilon(1e-12));
+    CHECK(random::_reservoir_skip(0.5, 1e-17, 1000) == 1000);
+    CHECK(random::_reservoir_skip(0.5, 1e-300, max) == max);
+    CHECK(random::_reservoir_skip(0.5, 0., max) == max);
+}
+
+// --- Quasi-random sequences ---
+// ------------------------------
+
+// Whether first 'b^k' points of every dimension fall into different intervals '[i / b^k, (i + 1) / b^k)'
+template <class Sequence>
+bool is_stratified(Sequence sequence, std::size_t base, std::size_t k) {
+    std::size_t intervals = 1;
+    for (std::size_t i = 0; i < k; ++i) intervals *= base;
+
+    const std::size_t   d = sequence.dimensions();
+    std::vector<double> points(intervals * d);
+    sequence.fill(points.begin(), points.end());
+
+    for (std::size_t j = 0; j < d; ++j) {
+        std::vector<bool> taken(intervals);
+        for (std::size_t i = 0; i < intervals; ++i) {
+            const auto interval = static_cast<std::size_t>(points[i * d + j] * intervals);
+            if (taken.at(interval)) return false;
+            taken[interval] = true;
+        }
+    }
+    return true;
+}
+
+template <class Sequence>
+void check_sequence_random_access(Sequence sequence) {
+    const std::size_t d = sequence.dimensions();
+
+    std::vector<double> expected(100 * d), chunk(30 * d), point(d);
+    sequence.fill(expected.begin(), expected.end());
+    FAST_CHECK(sequence.index() == 100);
+
+    sequence.seek(50);
+    sequence.fill(chunk.begin(), chunk.end());
+    FAST_CHECK(std::equal(chunk.begin(), chunk.end(), expected.begin() + 50 * d));
+
+    sequence.seek(3);
+    sequence.discard(70);
+    sequence.next(point.begin());
+    FAST_CHECK(std::equal(point.begin(), point.end(), expected.begin() + 73 * d));
+    FAST_CHECK(sequence() == std::vector<double>(expected.begin() + 74 * d, expected.begin() + 75 * d));
+
+    for (const auto& e : expected) FAST_CHECK((0 <= e && e < 1));
+}
+
+TEST_CASE("Sobol sequence") {
+    // parameters from the 'new-joe-kuo-6.21201' table
+    const std::vector<random::SobolParameters> joe_kuo = {{1, 0, {1}}, {2, 1, {1, 3}}};
+
+    const std::vector<double> expected = {0.,    0.,    0.,    0.5,   0.5,   0.5,   0.75,  0.25,  0.25,
+                                          0.25,  0.75,  0.75,  0.375, 0.375, 0.625, 0.875, 0.875, 0.125,
+                                          0.625, 0.125, 0.875, 0.125, 0.625, 0.375};
+    std::vector<double>       points(expected.size());
+    random::SobolSequence<>(joe_kuo).fill(points.begin(), points.end());
+    CHECK(points == expected);
+
+    // default parameters follow the same table, reference points were generated with 'scipy.stats.qmc.Sobol'
+    const std::vector<double> expected_8d = {
+        0.,    0.,    0.,    0.,    0.,    0.,    0.,    0.,    0.5,   0.5,   0.5,   0.5,   0.5,   0.5,   0.5,   0.5,
+        0.75,  0.25,  0.25,  0.25,  0.75,  0.75,  0.25,  0.75,  0.25,  0.75,  0.75,  0.75,  0.25,  0.25,  0.75,  0.25,
+        0.375, 0.375, 0.625, 0.875, 0.375, 0.125, 0.375, 0.875, 0.875, 0.875, 0.125, 0.375, 0.875, 0.625, 0.875, 0.375,
+        0.625, 0.125, 0.875, 0.625, 0.625, 0.875, 0.125, 0.125, 0.125, 0.625, 0.375, 0.125, 0.125, 0.375, 0.625, 0.625};
+    std::vector<double> points_8d(expected_8d.size());
+    random::SobolSequence<>(8).fill(points_8d.begin(), points_8d.end());
+    CHECK(points_8d == expected_8d);
+
+    random::SobolSequence<> sobol_481(481, 1000);
+    const auto              point_1000 = sobol_481();
+    CHECK(point_1000[3] == 0.6767578125);
+    CHECK(point_1000[100] == 0.7685546875);
+    CHECK(point_1000[250] == 0.7060546875);
+    CHECK(point_1000[479] == 0.2060546875);
+    CHECK(point_1000[480] == 0.7529296875);
+    sobol_481.seek(12345);
+    const auto point_12345 = sobol_481();
+    CHECK(point_12345[3] == 0.52679443359375);
+    CHECK(point_12345[100] == 0.53948974609375);
+    CHECK(point_12345[250] == 0.15631103515625);
+    CHECK(point_12345[479] == 0.10821533203125);
+    CHECK(point_12345[480] == 0.90802001953125);
+
+    // dimensions past the table fall back onto generated parameters
+    random::SobolSequence<> sobol(600);
+    CHECK(sobol.dimensions() == 600);
+    CHECK(is_stratified(sobol, 2, 10));
+
+    // first 2 dimensions form a (0, m, 2)-net, every elementary box '2^-a x 2^-(m - a)' holds exactly 1 point
+    constexpr std::size_t m = 8;
+    std::vector<double>   net(2 * (1 << m));
+    random::SobolSequence<>(2).fill(net.begin(), net.end());
+    for (std::size_t a = 0; a <= m; ++a) {
+        std::vector<int> boxes(1 << m);
+        for (std::size_t i = 0; i < net.size(); i += 2)
+            ++boxes[(std::size_t(net[i] * (1 << a)) << (m - a)) + std::size_t(net[i + 1] * (1 << (m - a)))];
+        CHECK(std::all_of(boxes.begin(), boxes.end(), [](int count) { return count == 1; }));
+    }
+
+    check_sequence_random_access(sobol);
+
+    random::generators::Xoshiro256PP gen{17};
+    sobol.scramble(gen);
+    CHECK(is_stratified(sobol, 2, 10));
+    check_sequence_random_access(sobol);
+}
+
+TEST_CASE("Halton sequence") {
+    random::HaltonSequence<> halton(3);
+
+    const std::vector<double> expected = {0.,     0.,     0.,     1. / 2, 1. / 3, 1. / 5,
+                                          1. / 4, 2. / 3, 2. / 5, 3. / 4, 1. / 9, 3. / 5};
+    for (std::size_t i = 0; i < expected.size(); i += 3) {
+        const auto point = halton();
+        for (std::size_t j = 0; j < 3; ++j) CHECK(point[j] == doctest::Approx(expected[i + j]).epsilon(1e-15));
+    }
+
+    CHECK(is_stratified(random::HaltonSequence<>(1), 2, 12));
+    check_sequence_random_access(halton);
+
+    // index that needs all 53 binary digits still produces exact values
+    halton.seek((std::uint64_t(1) << 52) + 1);
+    CHECK(halton()[0] == 0.5 + std::ldexp(1., -53));
+
+    random::generators::Xoshiro256PP gen{18};
+    random::HaltonSequence<>         scrambled(50);
+    scrambled.scramble(gen);
+    check_sequence_random_access(scrambled);
+
+    check_sequence_random_access(random::HaltonSequence<>(60)); // bases above 256 don't use digit tables
+
+    random::HaltonSequence<> scrambled_1d(1);
+    scrambled_1d.scramble(gen);
+    CHECK(is_stratified(scrambled_1d, 2, 12));
+}
+
+TEST_CASE("R-sequence") {
+    random::RSequence<> r2(2);
+
+    // 'alpha' for 2 dimensions is '1 / 1.32471795724474602596', 'phi' being the plastic number
+    const auto first = r2(), second = r2();
+    CHECK(first == std::vector<double>{0.5, 0.5});
+    CHECK(second[0] == doctest::Approx(0.5 + 0.75487766624669276005 - 1).epsilon(1e-15));
+    CHECK(second[1] == doctest::Approx(0.5 + 0.56984029099805326591 - 1).epsilon(1e-15));
+
+    check_sequence_random_access(r2);
+
+    // O(1) jumps to huge indices
+    r2.seek(std::uint64_t(1) << 62);
+    const auto far = r2();
+    CHECK((0 <= far[0] && far[0] < 1));
+
+    random::generators::Xoshiro256PP gen{19};
+    random::RSequence<>              scrambled(10);
+    scrambled.scramble(gen);
+    check_sequence_random_access(scrambled);
+}
+
+TEST_CASE_TEMPLATE("Quasi-random sequences integrate better than random points", Sequence, //
+                   random::SobolSequence<>, random::HaltonSequence<>, random::RSequence<>) {
+    constexpr std::size_t d = 6, n = 16384;
+    constexpr double      pi = 3.14159265358979323846;
+
+    // integral of 'prod(pi / 2 * sin(pi * x_j))' over the unit cube is '1', Monte Carlo error would be around '0.012'
+    const auto integrate = [&](Sequence& sequence) {
+        std::vector<double> points(n * d);
+        sequence.fill(points.begin(), points.end());
+
+        double sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            double f = 1;
+            for (std::size_t j = 0; j < d; ++j) f *= pi / 2 * std::sin(pi * points[i * d + j]);
+            sum += f;
+        }
+        return sum / n;
+    };
+
+    Sequence sequence(d);
+    CHECK(integrate(sequence) == doctest::Approx(1).epsilon(2e-3));
+
+    random::generators::Xoshiro256PP gen{20};
+    Sequence                         scrambled(d);
+    scrambled.scramble(gen);
+    CHECK(integrate(scrambled) == doctest::Approx(1).epsilon(2e-3));
+}
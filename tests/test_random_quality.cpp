@@ -0,0 +1,261 @@
+// _______________ TEST FRAMEWORK & MODULE  _______________
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "thirdparty/doctest.h"
+
+#include "test.hpp"
+
+#include "UTL/random.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>   // sort(), min(), max()
+#include <array>       // array<>
+#include <chrono>      // steady_clock
+#include <cmath>       // erfc(), sqrt(), cbrt(), pow()
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t, uint64_t
+#include <cstdlib>     // getenv(), strtoull()
+#include <cstring>     // memcpy()
+#include <iomanip>     // setw(), setprecision()
+#include <iostream>    // cout
+#include <string>      // string
+#include <vector>      // vector<>
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// Lightweight statistical battery for the generators of 'utl::random', inspired by the classic DIEHARD tests and
+// the frequency / serial tests of PractRand. It is nowhere near as thorough as the real thing and only exists to catch
+// obviously broken generators & regressions, for serious evaluation pipe the output into PractRand or TestU01.
+//
+// Every generator produces the same volume of raw output, which is interpreted as a stream of 32-bit words.
+// Each test computes a statistic with a known distribution and converts it into a p-value, test fails when p-value
+// lands in one of the extreme tails. Tests are cheap enough to run as a part of the regular test suite, output
+// volume can be increased with 'UTL_RANDOM_QUALITY_MB' environment variable (4 MB by default).
+//
+// Along the test results every generator reports its bulk generation throughput in ns/value & GB/s.
+
+// ____________________ IMPLEMENTATION ____________________
+
+// =======================
+// --- Statistic utils ---
+// =======================
+
+constexpr double fail_threshold = 1e-7; // p-values below it or above '1 - fail_threshold' are failures
+
+std::size_t output_volume() {
+    const char* env = std::getenv("UTL_RANDOM_QUALITY_MB");
+    const auto  mb  = env ? std::strtoull(env, nullptr, 10) : 0;
+    return (mb ? mb : 4) << 20;
+}
+
+double normal_cdf(double z) { return 0.5 * std::erfc(-z / std::sqrt(2.)); }
+
+// Wilson-Hilferty approximation, accurate enough for 'df >= 30' which is the case for all tests below
+double chi_squared_cdf(double x, double df) {
+    const double z = (std::cbrt(x / df) - (1. - 2. / (9. * df))) / std::sqrt(2. / (9. * df));
+    return normal_cdf(z);
+}
+
+double chi_squared(const std::vector<std::uint64_t>& observed, const std::vector<double>& expected) {
+    double res = 0;
+    for (std::size_t i = 0; i < observed.size(); ++i) {
+        const double diff = double(observed[i]) - expected[i];
+        res += diff * diff / expected[i];
+    }
+    return res;
+}
+
+// p-value of a histogram of uniformly distributed values
+double uniform_histogram_p(const std::vector<std::uint64_t>& observed) {
+    std::uint64_t total = 0;
+    for (const auto& e : observed) total += e;
+
+    const std::vector<double> expected(observed.size(), double(total) / observed.size());
+    return chi_squared_cdf(chi_squared(observed, expected), double(observed.size() - 1));
+}
+
+// Sum of 'n' Poisson(lambda) variables is Poisson(n * lambda), which is close to normal for large means
+double poisson_sum_p(std::uint64_t observed, double mean) {
+    return normal_cdf((double(observed) - mean) / std::sqrt(mean));
+}
+
+bool is_pass(double p) { return fail_threshold < p && p < 1. - fail_threshold; }
+
+// =============
+// --- Tests ---
+// =============
+
+// Byte frequency, catches biased bits
+double frequency_test(const std::vector<std::uint32_t>& words) {
+    std::vector<std::uint64_t> counts(256);
+    for (const auto& w : words)
+        for (int shift = 0; shift < 32; shift += 8) ++counts[(w >> shift) & 0xff];
+    return uniform_histogram_p(counts);
+}
+
+// Non-overlapping pairs of bytes taken from the same position of consecutive words, catches correlations
+// between neighbouring outputs, checking lowest & highest byte separately to catch weak low bits
+double serial_test(const std::vector<std::uint32_t>& words, int shift) {
+    std::vector<std::uint64_t> counts(1 << 16);
+    for (std::size_t i = 0; i + 1 < words.size(); i += 2)
+        ++counts[(((words[i] >> shift) & 0xff) << 8) | ((words[i + 1] >> shift) & 0xff)];
+    return uniform_histogram_p(counts);
+}
+
+// Distances between words that have 4 selected bits set to zero should be geometrically distributed
+double gap_test(const std::vector<std::uint32_t>& words, int shift) {
+    constexpr std::size_t max_gap = 64;
+    constexpr double      p       = 1. / 16;
+
+    std::vector<std::uint64_t> counts(max_gap + 1);
+    std::size_t                gap = 0;
+    bool                       hit = false; // start counting after the first hit
+    for (const auto& w : words) {
+        if ((w >> shift) & 0xf) {
+            ++gap;
+            continue;
+        }
+        if (hit) ++counts[std::min(gap, max_gap)];
+        hit = true, gap = 0;
+    }
+
+    std::uint64_t total = 0;
+    for (const auto& e : counts) total += e;
+
+    std::vector<double> expected(max_gap + 1);
+    for (std::size_t g = 0; g < max_gap; ++g) expected[g] = total * p * std::pow(1. - p, double(g));
+    expected[max_gap] = total * std::pow(1. - p, double(max_gap));
+
+    return chi_squared_cdf(chi_squared(counts, expected), double(max_gap));
+}
+
+// Marsaglia's birthday spacings: 'm' birthdays in a year of 'n = 2^bits' days, sorted spacings between birthdays
+// have Poisson(m^3 / (4 n)) repeated values. Generators with lattice structure (LCGs, lagged Fibonacci) fail it.
+double birthday_spacings_test(const std::vector<std::uint32_t>& words, int bits, std::size_t m) {
+    const double lambda = double(m) * m * m / (4. * std::pow(2., bits));
+    const auto   mask   = std::uint32_t((std::uint64_t(1) << bits) - 1);
+
+    std::vector<std::uint32_t> birthdays(m), spacings(m);
+    std::uint64_t              repeats = 0;
+    std::size_t                samples = 0;
+
+    for (std::size_t i = 0; i + m <= words.size(); i += m, ++samples) {
+        for (std::size_t k = 0; k < m; ++k) birthdays[k] = words[i + k] & mask;
+        std::sort(birthdays.begin(), birthdays.end());
+
+        spacings[0] = birthdays[0];
+        for (std::size_t k = 1; k < m; ++k) spacings[k] = birthdays[k] - birthdays[k - 1];
+        std::sort(spacings.begin(), spacings.end());
+
+        for (std::size_t k = 1; k < m; ++k) repeats += (spacings[k] == spacings[k - 1]);
+    }
+
+    return poisson_sum_p(repeats, lambda * samples);
+}
+
+// ===============
+// --- Harness ---
+// ===============
+
+struct battery_result {
+    double ns_per_value;
+    double gb_per_second;
+
+    std::array<double, 7> p;
+};
+
+constexpr std::array<const char*, 7> test_names = {
+    "Frequency", "Serial (lo)", "Serial (hi)", "Gap (lo)", "Gap (hi)", "Birthday (32)", "Birthday (lo 24)",
+};
+
+template <class Gen>
+battery_result run_battery(Gen gen) {
+    using value_type = typename Gen::result_type;
+
+    const std::size_t volume = output_volume();
+
+    std::vector<value_type> values(volume / sizeof(value_type));
+
+    const auto start = std::chrono::steady_clock::now();
+    random::fill(gen, values.begin(), values.end());
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::vector<std::uint32_t> words(volume / sizeof(std::uint32_t));
+    std::memcpy(words.data(), values.data(), volume); // raw byte stream, same as piping output into PractRand
+
+    return {ns / values.size(),
+            volume / ns,
+            {frequency_test(words), serial_test(words, 0), serial_test(words, 24), gap_test(words, 0),
+             gap_test(words, 28), birthday_spacings_test(words, 32, 4096), birthday_spacings_test(words, 24, 512)}};
+}
+
+template <class Gen>
+void check_generator(const std::string& name) {
+    const auto res = run_battery(Gen{42});
+
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << res.ns_per_value << " ns/value" << std::setw(8) << res.gb_per_second << " GB/s";
+    for (std::size_t i = 0; i < test_names.size(); ++i) {
+        std::cout << " | " << test_names[i] << (is_pass(res.p[i]) ? " ok" : " FAIL");
+    }
+    std::cout << '\n' << std::flush;
+
+    for (std::size_t i = 0; i < test_names.size(); ++i) {
+        INFO("Generator: ", name, ", test: ", test_names[i], ", p = ", res.p[i]);
+        CHECK(is_pass(res.p[i]));
+    }
+}
+
+// Intentionally bad generator, lowest bits of a power-of-2 modulus LCG have tiny periods
+struct BadLcg {
+    using result_type = std::uint32_t;
+
+    std::uint32_t state;
+
+    explicit BadLcg(std::uint32_t seed) : state(seed) {}
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return 0xffffffff; }
+
+    result_type operator()() noexcept { return this->state = this->state * 69069 + 1; }
+};
+
+// ======================
+// --- Test execution ---
+// ======================
+
+TEST_CASE("Statistical battery detects bad generators") {
+    const auto res = run_battery(BadLcg{42});
+
+    CHECK(!is_pass(res.p[1])); // serial test of the low byte
+    CHECK(!is_pass(res.p[3])); // gap test of the low bits
+    CHECK(!is_pass(res.p[6])); // birthday spacings of the low bits
+}
+
+TEST_CASE("Statistical battery & throughput of all generators") {
+    using namespace random::generators;
+
+    std::cout << "\nOutput volume: " << (output_volume() >> 20) << " MB per generator\n\n";
+
+    check_generator<RomuMono16>("RomuMono16");
+    check_generator<SplitMix32>("SplitMix32");
+    check_generator<Xoshiro128PP>("Xoshiro128PP");
+    check_generator<RomuTrio32>("RomuTrio32");
+    check_generator<SplitMix64>("SplitMix64");
+    check_generator<Xoshiro256PP>("Xoshiro256PP");
+    check_generator<RomuDuoJr64>("RomuDuoJr64");
+    check_generator<ChaCha8>("ChaCha8");
+    check_generator<ChaCha12>("ChaCha12");
+    check_generator<ChaCha20>("ChaCha20");
+    check_generator<Philox4x32>("Philox4x32");
+    check_generator<Threefry2x64>("Threefry2x64");
+    check_generator<Xoshiro128PPx4>("Xoshiro128PPx4");
+    check_generator<Xoshiro128PPx8>("Xoshiro128PPx8");
+    check_generator<Xoshiro256PPx4>("Xoshiro256PPx4");
+    check_generator<Xoshiro256PPx8>("Xoshiro256PPx8");
+
+    std::cout << '\n';
+}
@@ -9,7 +9,12 @@
 
 // _______________________ INCLUDES _______________________
 
-// NOTE: STD INCLUDES
+#include <iterator>    // lazy splitting tests
+#include <string>      // splitting tests
+#include <string_view> // lazy splitting tests
+#include <type_traits> // lazy splitting tests
+#include <utility>     // lazy splitting tests
+#include <vector>      // splitting tests
 
 // ____________________ DEVELOPER DOCS ____________________
 
@@ -48,6 +53,32 @@ TEST_CASE("Trimming") {
     CHECK(stre::trim("00000010001000000", '0') == "10001");
 }
 
+TEST_CASE("Trimming views") {
+    CHECK(stre::trim_left_view("   XXX   ") == "XXX   ");
+    CHECK(stre::trim_right_view("   XXX   ") == "   XXX");
+    CHECK(stre::trim_view("   XXX   ") == "XXX");
+    CHECK(stre::trim_view("XXX") == "XXX");
+    CHECK(stre::trim_view("      ") == "");
+    CHECK(stre::trim_view("") == "");
+    CHECK(stre::trim_view("00000010001000000", '0') == "10001");
+
+    const stre::CharSet whitespace(" \t\r\n");
+
+    CHECK(stre::trim_left_view(" \t\n XXX \r\n", whitespace) == "XXX \r\n");
+    CHECK(stre::trim_right_view(" \t\n XXX \r\n", whitespace) == " \t\n XXX");
+    CHECK(stre::trim_view(" \t\n XXX \r\n", whitespace) == "XXX");
+    CHECK(stre::trim_view("\r\n\r\n\r\n\r\n\r\n\r\n", whitespace) == "");
+    CHECK(stre::trim_view("", whitespace) == "");
+
+    // long runs go through the SWAR path, large sets through the lookup table
+    const std::string padded = std::string(37, ' ') + "lorem ipsum" + std::string(29, '\t');
+    CHECK(stre::trim_view(padded, whitespace) == "lorem ipsum");
+    CHECK(stre::trim_view(padded, stre::CharSet(" \t\r\n\f\v")) == "lorem ipsum");
+
+    // views point into the original string
+    CHECK(stre::trim_view(padded, whitespace).data() == padded.data() + 37);
+}
+
 TEST_CASE("Padding") {
     CHECK(stre::pad_left("XXX", 6) == "   XXX");
     CHECK(stre::pad_left("XXX", 3) == "XXX");
@@ -76,6 +107,30 @@ TEST_CASE("Case conversions") {
     CHECK(stre::to_upper("some \t\n\r very \17 strange text -=14") == "SOME \t\n\r VERY \17 STRANGE TEXT -=14");
 }
 
+TEST_CASE("Case conversions (ASCII)") {
+    CHECK(stre::to_lower_ascii("Lorem Ipsum") == "lorem ipsum");
+    CHECK(stre::to_upper_ascii("lorem ipsum") == "LOREM IPSUM");
+    CHECK(stre::to_lower_ascii("") == "");
+
+    // all possible chars at all possible offsets within a word, should match
+    // locale-dependent conversion in the default "C" locale
+    std::string all_chars;
+    for (int c = 0; c < 256; ++c) all_chars += static_cast<char>(c);
+
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        const std::string str = all_chars.substr(offset);
+        CHECK(stre::to_lower_ascii(str) == stre::to_lower(str));
+        CHECK(stre::to_upper_ascii(str) == stre::to_upper(str));
+    }
+
+    // r-values get converted in place
+    std::string str    = "SOME STRING THAT IS TOO LONG FOR SMALL STRING OPTIMIZATION";
+    const auto  buffer = str.data();
+    const auto  res    = stre::to_lower_ascii(std::move(str));
+    CHECK(res == "some string that is too long for small string optimization");
+    CHECK(res.data() == buffer);
+}
+
 TEST_CASE("Substring checks") {
     CHECK(stre::starts_with("Lorem Ipsum", "Lorem"));
     CHECK(!stre::starts_with("Lorem Ipsum", "Ipsum"));
@@ -221,6 +276,144 @@ TEST_CASE("Splitting string by delimiter (keep_empty_tokens = true)") {
     }
 }
 
+std::vector<std::string> collect_tokens(std::string_view str, std::string_view delimiter, bool keep_empty_tokens) {
+    std::vector<std::string> tokens;
+    for (auto token : stre::split_view(str, delimiter, keep_empty_tokens)) tokens.emplace_back(token);
+    return tokens;
+}
+
+template <class Delimiter, class = void>
+struct can_split_view_by : std::false_type {};
+
+template <class Delimiter>
+struct can_split_view_by<Delimiter,
+                         std::void_t<decltype(stre::split_view(std::string_view{}, std::declval<Delimiter>()))>>
+    : std::true_type {};
+
+// delimiter is stored in the view, temporary strings would dangle
+static_assert(can_split_view_by<const std::string&>::value);
+static_assert(can_split_view_by<std::string_view>::value);
+static_assert(can_split_view_by<const char*>::value);
+static_assert(can_split_view_by<char>::value);
+static_assert(!can_split_view_by<std::string>::value);
+
+TEST_CASE("Lazy splitting matches 'split_by_delimiter()'") {
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"aaa,bbb,ccc",            ","    },
+        {"(---)lorem(---)ipsum",   "(---)"},
+        {"___lorem_________ipsum", "___"  },
+        {"xxAxxxxxBxCxDxxEx",      "x"    },
+        {",,",                     ",,,"  },
+        {".........",              "..."  },
+        {"",                       "..."  },
+        {"text",                   ""     },
+        {"",                       ""     },
+        {",",                      ","    },
+    };
+
+    for (const auto& [str, delimiter] : cases) {
+        for (const bool keep_empty_tokens : {false, true}) {
+            const auto expected = stre::split_by_delimiter(str, delimiter, keep_empty_tokens);
+
+            CHECK(collect_tokens(str, delimiter, keep_empty_tokens) == expected);
+
+            std::vector<std::string> visited;
+            stre::for_each_token(
+                str, delimiter, [&](std::string_view token) { visited.emplace_back(token); }, keep_empty_tokens);
+            CHECK(visited == expected);
+
+            if (delimiter.size() != 1) continue;
+
+            // single char delimiter goes through a separate 'memchr()' path
+            std::vector<std::string> chars;
+            for (auto token : stre::split_view(str, delimiter.front(), keep_empty_tokens)) chars.emplace_back(token);
+            CHECK(chars == expected);
+        }
+    }
+}
+
+TEST_CASE("Splitting by a set of delimiters") {
+    const stre::CharSet whitespace(" \t\n");
+
+    CHECK(whitespace.contains(' '));
+    CHECK(whitespace.contains('\n'));
+    CHECK(!whitespace.contains('x'));
+    CHECK(!stre::CharSet{}.contains('\0'));
+
+    CHECK(stre::find_first_of("lorem ipsum", whitespace) == 5);
+    CHECK(stre::find_first_of("lorem ipsum", whitespace, 6) == std::string_view::npos);
+
+    std::vector<std::string_view> tokens;
+    stre::split_into(" lorem\t ipsum\n\ndolor ", whitespace, tokens);
+    CHECK(tokens == std::vector<std::string_view>{"lorem", "ipsum", "dolor"});
+
+    stre::split_into(" lorem\t ipsum\n\ndolor ", whitespace, tokens, true);
+    CHECK(tokens == std::vector<std::string_view>{"", "lorem", "", "ipsum", "", "dolor", ""});
+
+    // non-ASCII chars must not be confused with anything
+    CHECK(stre::split_by_delimiter("a\xff" "z", "\xff") == std::vector<std::string>{"a", "z"});
+    CHECK(stre::split_view("z\xff" "z\x7f", stre::CharSet("\xff\x7f")).begin()->size() == 1);
+}
+
+TEST_CASE("Character set search matches 'std::string_view'") {
+    // sets of all sizes around the SWAR threshold, including duplicates and non-ASCII chars
+    const std::vector<std::string> sets = {"",         " ",     "ab",           " \t\n",     "abcd",
+                                           "aabbccdd", "abcde", "\x80\xff\x7f", "0123456789"};
+
+    std::string str;
+    for (std::size_t i = 0; i < 100; ++i) str += "ab cd\t\n\x80\xffz0123456789"[(i * i + 7 * i) % 18];
+    const std::string_view view = str;
+
+    for (const auto& chars : sets) {
+        const stre::CharSet set(chars);
+        for (std::size_t pos = 0; pos <= str.size() + 1; ++pos) {
+            INFO("set = ", stre::escape_control_chars(chars), ", pos = ", pos);
+            CHECK(stre::find_first_of(str, set, pos) == view.find_first_of(chars, pos));
+            CHECK(stre::find_first_not_of(str, set, pos) == view.find_first_not_of(chars, pos));
+            CHECK(stre::find_last_of(str, set, pos) == view.find_last_of(chars, pos));
+            CHECK(stre::find_last_not_of(str, set, pos) == view.find_last_not_of(chars, pos));
+        }
+        CHECK(stre::find_last_of(str, set) == view.find_last_of(chars));
+        CHECK(stre::find_last_not_of(str, set) == view.find_last_not_of(chars));
+    }
+}
+
+TEST_CASE("Splitting into an existing vector") {
+    std::vector<std::string> tokens = {"some long string that should keep its capacity around", "x", "y", "z", "w"};
+
+    const auto capacity = tokens.capacity();
+    const auto buffer   = tokens.front().data();
+
+    stre::split_into("aaa,bbb,ccc", ',', tokens);
+    CHECK(tokens == std::vector<std::string>{"aaa", "bbb", "ccc"});
+    CHECK(tokens.capacity() == capacity);
+    CHECK(tokens.front().data() == buffer); // string got reassigned rather than recreated
+
+    stre::split_into("lorem ipsum dolor sit amet consectetur", " ", tokens);
+    CHECK(tokens.size() == 6);
+    CHECK(tokens.back() == "consectetur");
+
+    stre::split_into("", ",", tokens);
+    CHECK(tokens.empty());
+
+    // tokens point into the original string
+    const std::string             str = "key=value";
+    std::vector<std::string_view> views;
+    stre::split_into(str, '=', views);
+    REQUIRE(views.size() == 2);
+    CHECK(views[1].data() == str.data() + 4);
+
+    // iterators satisfy basic forward iterator requirements
+    const auto view = stre::split_view("a b c", ' ');
+    CHECK(std::distance(view.begin(), view.end()) == 3);
+    auto it = view.begin();
+    CHECK(*it++ == "a");
+    CHECK(*it == "b");
+    CHECK(it != view.begin());
+    CHECK(++it != view.end());
+    CHECK(++it == view.end());
+}
+
 TEST_CASE("Other utils") {
     CHECK(stre::replace_all_occurences("xxxAAxxxAAxxx", "AA", "BBB") == "xxxBBBxxxBBBxxx");
     CHECK(stre::replace_all_occurences("Some very very cool text ending with very", "very", "really") ==